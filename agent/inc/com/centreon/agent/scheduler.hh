@@ -53,19 +53,54 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
   unsigned _active_check = 0;
   bool _alive = true;
 
-  // request that will be sent to engine
-  std::shared_ptr<MessageFromAgent> _current_request;
-
-  // pointers in this struct point to _current_request
+  // pointers in this struct point to export_request::request
   struct scope_metric_request {
+    ::opentelemetry::proto::metrics::v1::ResourceMetrics* resource_metric;
     ::opentelemetry::proto::metrics::v1::ScopeMetrics* scope_metric;
-    std::unordered_map<std::string /*metric name*/,
-                       ::opentelemetry::proto::metrics::v1::Metric*>
+    absl::flat_hash_map<std::string /*metric name*/,
+                        ::opentelemetry::proto::metrics::v1::Metric*>
         metrics;
   };
 
-  // one serv => one scope_metric => several metrics
-  std::unordered_map<std::string, scope_metric_request> _serv_to_scope_metrics;
+  /**
+   * @brief request sent to engine allocated on its own arena
+   * Once released by the sender, it's reused: data points are cleared but
+   * resources with their attributes and metrics with their names are kept, so
+   * steady state exports only fill data points.
+   */
+  struct export_request {
+    google::protobuf::Arena arena;
+    MessageFromAgent* request;
+    // one serv => one scope_metric => several metrics
+    absl::flat_hash_map<std::string, scope_metric_request>
+        serv_to_scope_metrics;
+
+    export_request();
+    void clear_data_points();
+    unsigned remove_empty_resources();
+  };
+
+  // request that will be sent to engine
+  std::shared_ptr<export_request> _current_request;
+  // last sent request, reused once sender has released it
+  std::shared_ptr<export_request> _spare_request;
+
+  /**
+   * @brief last exported result of a service, used in delta export mode
+   */
+  struct last_export {
+    time_point export_time;
+    unsigned status;
+    std::list<com::centreon::common::perfdata> perfdata;
+    std::list<std::string> outputs;
+  };
+
+  absl::flat_hash_map<std::string /*service*/, last_export> _last_exports;
+
+  // export statistics of the current request
+  unsigned _nb_stored_results = 0;
+  unsigned _nb_skipped_results = 0;
+  duration _store_duration = duration::zero();
 
   std::shared_ptr<asio::io_context> _io_context;
   std::shared_ptr<spdlog::logger> _logger;
@@ -90,6 +125,11 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
   void _check_timer_handler(const boost::system::error_code& err);
 
   void _init_export_request();
+  bool _is_unchanged_since_last_export(
+      const check::pointer& check,
+      unsigned status,
+      const std::list<com::centreon::common::perfdata>& perfdata,
+      const std::list<std::string>& outputs);
   void _start_check(const check::pointer& check);
   void _check_handler(
       const check::pointer& check,
@@ -20,6 +20,8 @@
 #define CENTREON_AGENT_CHECK_CPU_HH
 
 #include "native_check_cpu_base.hh"
+#include "proc_sampler.hh"
+
 namespace com::centreon::agent {
 
 namespace check_cpu_detail {
@@ -59,11 +61,15 @@ class per_cpu_time : public per_cpu_time_base<nb_field> {
  *
  */
 class proc_stat_file : public cpu_time_snapshot<nb_field> {
+  void _parse(const std::string_view& content);
+
  public:
   proc_stat_file(size_t nb_to_reserve)
       : proc_stat_file("/proc/stat", nb_to_reserve) {}
 
   proc_stat_file(const char* proc_file, size_t nb_to_reserve);
+
+  proc_stat_file(const proc_sample& sample, size_t nb_to_reserve);
 };
 
 };  // namespace check_cpu_detail
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_CHECK_MEMORY_HH
+#define CENTREON_AGENT_CHECK_MEMORY_HH
+
+#include "proc_sampler.hh"
+
+namespace com::centreon::agent {
+
+/**
+ * @brief native linux memory and swap checks, values come from /proc/meminfo
+ * used memory is MemTotal - MemAvailable, used swap is SwapTotal - SwapFree
+ *
+ */
+class check_memory : public proc_sample_check {
+  bool _swap;
+  // thresholds in bytes
+  double _warning;
+  double _critical;
+  // thresholds in percent
+  double _warning_prct;
+  double _critical_prct;
+
+ public:
+  check_memory(const std::shared_ptr<asio::io_context>& io_context,
+               const std::shared_ptr<spdlog::logger>& logger,
+               time_point first_start_expected,
+               duration check_interval,
+               const std::string& serv,
+               const std::string& cmd_name,
+               const std::string& cmd_line,
+               const rapidjson::Value& args,
+               const engine_to_agent_request_ptr& cnf,
+               check::completion_handler&& handler,
+               bool swap);
+
+  static void help(std::ostream& help_stream);
+
+  e_status compute(const proc_sample& sample,
+                   std::string* output,
+                   std::list<common::perfdata>* perfs) override;
+};
+
+}  // namespace com::centreon::agent
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_CHECK_NETWORK_HH
+#define CENTREON_AGENT_CHECK_NETWORK_HH
+
+#include "proc_sampler.hh"
+
+namespace com::centreon::agent {
+
+/**
+ * @brief native linux network traffic check, counters come from /proc/net/dev
+ * Traffic is computed between the sample of the previous check and the
+ * current one, so the first check only stores counters.
+ *
+ */
+class check_network : public proc_sample_check {
+  proc_sampler_detail::name_filter _filter;
+  // thresholds in bits per second
+  double _warning_in;
+  double _critical_in;
+  double _warning_out;
+  double _critical_out;
+
+  absl::flat_hash_map<std::string, proc_sampler_detail::net_dev_stat>
+      _previous;
+  std::chrono::steady_clock::time_point _previous_time;
+
+ public:
+  check_network(const std::shared_ptr<asio::io_context>& io_context,
+                const std::shared_ptr<spdlog::logger>& logger,
+                time_point first_start_expected,
+                duration check_interval,
+                const std::string& serv,
+                const std::string& cmd_name,
+                const std::string& cmd_line,
+                const rapidjson::Value& args,
+                const engine_to_agent_request_ptr& cnf,
+                check::completion_handler&& handler);
+
+  static void help(std::ostream& help_stream);
+
+  e_status compute(const proc_sample& sample,
+                   std::string* output,
+                   std::list<common::perfdata>* perfs) override;
+};
+
+}  // namespace com::centreon::agent
+
+#endif
@@ -0,0 +1,246 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_PROC_SAMPLER_HH
+#define CENTREON_AGENT_PROC_SAMPLER_HH
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "check.hh"
+#include "re2/re2.h"
+
+namespace com::centreon::agent {
+
+namespace proc_sampler_detail {
+
+/**
+ * @brief files read by the sampler, used as bit index of
+ * proc_sample::is_read
+ *
+ */
+enum e_proc_file : unsigned {
+  stat = 0,
+  meminfo,
+  net_dev,
+  diskstats,
+  loadavg,
+  nb_proc_file
+};
+
+/**
+ * @brief useful values of /proc/meminfo, in bytes
+ *
+ */
+struct mem_info {
+  uint64_t mem_total = 0;
+  uint64_t mem_free = 0;
+  uint64_t mem_available = 0;
+  uint64_t buffers = 0;
+  uint64_t cached = 0;
+  uint64_t swap_total = 0;
+  uint64_t swap_free = 0;
+};
+
+/**
+ * @brief content of /proc/loadavg
+ *
+ */
+struct load_avg {
+  double load1 = 0;
+  double load5 = 0;
+  double load15 = 0;
+  unsigned running = 0;
+  unsigned total = 0;
+};
+
+/**
+ * @brief counters of an interface in /proc/net/dev
+ *
+ */
+struct net_dev_stat {
+  std::string name;
+  uint64_t rx_bytes = 0;
+  uint64_t rx_packets = 0;
+  uint64_t rx_errors = 0;
+  uint64_t rx_drops = 0;
+  uint64_t tx_bytes = 0;
+  uint64_t tx_packets = 0;
+  uint64_t tx_errors = 0;
+  uint64_t tx_drops = 0;
+};
+
+/**
+ * @brief counters of a block device in /proc/diskstats
+ * sectors are always 512 bytes long in this file
+ *
+ */
+struct disk_stat {
+  std::string name;
+  uint64_t reads = 0;
+  uint64_t sectors_read = 0;
+  uint64_t read_ms = 0;
+  uint64_t writes = 0;
+  uint64_t sectors_written = 0;
+  uint64_t write_ms = 0;
+  uint64_t io_ms = 0;
+};
+
+/*
+ * These parsers neither allocate nor throw, vectors elements are reused from
+ * one call to another.
+ */
+void parse_meminfo(const std::string_view& content, mem_info* info);
+void parse_loadavg(const std::string_view& content, load_avg* load);
+void parse_net_dev(const std::string_view& content,
+                   std::vector<net_dev_stat>* devs);
+void parse_diskstats(const std::string_view& content,
+                     std::vector<disk_stat>* disks);
+
+std::string_view status_label(e_status status);
+
+void append_scaled(std::string* output,
+                   double value,
+                   double base,
+                   const std::string_view& unit);
+
+/**
+ * @brief include and exclude regular expressions applied to interface or
+ * device names, an empty filter allows everything
+ *
+ */
+class name_filter {
+  std::unique_ptr<re2::RE2> _filter;
+  std::unique_ptr<re2::RE2> _exclude;
+
+ public:
+  name_filter(const rapidjson::Value& args,
+              const char* filter_field,
+              const char* exclude_field,
+              const char* default_exclude);
+
+  bool is_allowed(const std::string_view& name) const;
+};
+
+}  // namespace proc_sampler_detail
+
+/**
+ * @brief snapshot of /proc files taken at the same time
+ * /proc/stat content is kept as is as it's parsed by check_cpu
+ *
+ */
+class proc_sample {
+  friend class proc_sampler;
+
+  std::chrono::steady_clock::time_point _time;
+  unsigned _read_flags = 0;
+  std::string _stat;
+  proc_sampler_detail::mem_info _mem_info;
+  proc_sampler_detail::load_avg _load_avg;
+  std::vector<proc_sampler_detail::net_dev_stat> _net_devs;
+  std::vector<proc_sampler_detail::disk_stat> _disks;
+
+ public:
+  std::chrono::steady_clock::time_point get_time() const { return _time; }
+
+  bool is_read(proc_sampler_detail::e_proc_file file) const {
+    return _read_flags & (1U << file);
+  }
+
+  const std::string& get_stat() const { return _stat; }
+  const proc_sampler_detail::mem_info& get_mem_info() const {
+    return _mem_info;
+  }
+  const proc_sampler_detail::load_avg& get_load_avg() const {
+    return _load_avg;
+  }
+  const std::vector<proc_sampler_detail::net_dev_stat>& get_net_devs() const {
+    return _net_devs;
+  }
+  const std::vector<proc_sampler_detail::disk_stat>& get_disks() const {
+    return _disks;
+  }
+};
+
+/**
+ * @brief reads /proc/stat, /proc/meminfo, /proc/net/dev, /proc/diskstats and
+ * /proc/loadavg at most once per tick for all native checks
+ * A sample is shared by all checks started during a tick. The previous sample
+ * is recycled when no check uses it anymore, so that in steady state, reading
+ * and parsing don't allocate anything.
+ *
+ */
+class proc_sampler {
+  std::array<std::string, proc_sampler_detail::nb_proc_file> _paths;
+  const std::chrono::steady_clock::duration _tick;
+
+  absl::Mutex _protect;
+  std::shared_ptr<proc_sample> _last ABSL_GUARDED_BY(_protect);
+  std::shared_ptr<proc_sample> _spare ABSL_GUARDED_BY(_protect);
+  std::string _buffer ABSL_GUARDED_BY(_protect);
+
+  bool _read_file(proc_sampler_detail::e_proc_file file, std::string* content);
+  void _fill(proc_sample& sample) ABSL_EXCLUSIVE_LOCKS_REQUIRED(_protect);
+
+ public:
+  proc_sampler(const std::string_view& proc_dir,
+               std::chrono::steady_clock::duration tick);
+
+  proc_sampler(const proc_sampler&) = delete;
+  proc_sampler& operator=(const proc_sampler&) = delete;
+
+  static proc_sampler& instance();
+
+  std::shared_ptr<const proc_sample> get_sample(
+      std::chrono::steady_clock::duration max_age);
+
+  std::shared_ptr<const proc_sample> get_sample() { return get_sample(_tick); }
+};
+
+/**
+ * @brief base class of native checks that only need a proc_sample
+ * start_check gets the current sample and calls compute synchronously
+ *
+ */
+class proc_sample_check : public check {
+ protected:
+  static e_status _get_status(double value, double warning, double critical);
+
+  static double _get_threshold(const rapidjson::Value& args,
+                               const char* field_name);
+
+ public:
+  proc_sample_check(const std::shared_ptr<asio::io_context>& io_context,
+                    const std::shared_ptr<spdlog::logger>& logger,
+                    time_point first_start_expected,
+                    duration check_interval,
+                    const std::string& serv,
+                    const std::string& cmd_name,
+                    const std::string& cmd_line,
+                    const engine_to_agent_request_ptr& cnf,
+                    check::completion_handler&& handler);
+
+  void start_check(const duration& timeout) override;
+
+  virtual e_status compute(const proc_sample& sample,
+                           std::string* output,
+                           std::list<common::perfdata>* perfs) = 0;
+};
+
+}  // namespace com::centreon::agent
+
+#endif
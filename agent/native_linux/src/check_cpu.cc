@@ -79,12 +79,40 @@ per_cpu_time::per_cpu_time(const std::string_view& line) {
 proc_stat_file::proc_stat_file(const char* proc_file, size_t nb_to_reserve) {
   _data.reserve(nb_to_reserve + 1);
   std::ifstream proc_stat(proc_file);
-  char line_buff[1024];
-  while (1) {
+  std::string content((std::istreambuf_iterator<char>(proc_stat)),
+                      std::istreambuf_iterator<char>());
+  _parse(content);
+}
+
+/**
+ * @brief Construct a new proc stat file::proc stat file object from the
+ * /proc/stat content read by the sampler
+ *
+ * @param sample /proc sample
+ * @param nb_to_reserve nb host cores
+ */
+proc_stat_file::proc_stat_file(const proc_sample& sample,
+                               size_t nb_to_reserve) {
+  if (!sample.is_read(proc_sampler_detail::e_proc_file::stat)) {
+    throw std::invalid_argument("fail to read /proc/stat");
+  }
+  _data.reserve(nb_to_reserve + 1);
+  _parse(sample.get_stat());
+}
+
+/**
+ * @brief parse cpu lines of /proc/stat, parsing stops at the first line that
+ * is not a cpu one
+ *
+ * @param content /proc/stat content
+ */
+void proc_stat_file::_parse(const std::string_view& content) {
+  for (std::string_view line : absl::StrSplit(content, '\n')) {
+    if (line.substr(0, 3) != "cpu") {
+      return;
+    }
     try {
-      proc_stat.getline(line_buff, sizeof(line_buff));
-      line_buff[1023] = 0;
-      per_cpu_time to_ins(line_buff);
+      per_cpu_time to_ins(line);
       _data.emplace(to_ins.get_cpu_index(), to_ins);
     } catch (const std::exception&) {
       return;
@@ -248,8 +276,14 @@ check_cpu::check_cpu(const std::shared_ptr<asio::io_context>& io_context,
 
 std::unique_ptr<
     check_cpu_detail::cpu_time_snapshot<e_proc_stat_index::nb_field>>
-check_cpu::get_cpu_time_snapshot([[maybe_unused]] bool first_measure) {
-  return std::make_unique<check_cpu_detail::proc_stat_file>(_nb_core);
+check_cpu::get_cpu_time_snapshot(bool first_measure) {
+  // the first measure can use the shared sample of the current tick, the
+  // second one must be taken at the end of the measure period
+  std::shared_ptr<const proc_sample> sample =
+      first_measure ? proc_sampler::instance().get_sample()
+                    : proc_sampler::instance().get_sample(
+                          std::chrono::steady_clock::duration::zero());
+  return std::make_unique<check_cpu_detail::proc_stat_file>(*sample, _nb_core);
 }
 
 constexpr std::array<std::string_view, e_proc_stat_index::nb_field>
@@ -0,0 +1,228 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_disk_io.hh"
+
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::proc_sampler_detail;
+
+// /proc/diskstats sectors are always 512 bytes long
+constexpr double _sector_size = 512;
+
+/**
+ * @brief Construct a new check disk io::check disk io object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected start expected
+ * @param check_interval check interval between two checks (not only this but
+ * also others)
+ * @param serv service
+ * @param cmd_name
+ * @param cmd_line
+ * @param args native plugin arguments
+ * @param cnf engine configuration received object
+ * @param handler called at measure completion
+ */
+check_disk_io::check_disk_io(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point first_start_expected,
+    duration check_interval,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const rapidjson::Value& args,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler)
+    : proc_sample_check(io_context,
+                        logger,
+                        first_start_expected,
+                        check_interval,
+                        serv,
+                        cmd_name,
+                        cmd_line,
+                        cnf,
+                        std::move(handler)),
+      _filter(args, "filter-disk", "exclude-disk", "(loop|ram)\\d+"),
+      _warning_read(0),
+      _critical_read(0),
+      _warning_write(0),
+      _critical_write(0),
+      _warning_utilization(0),
+      _critical_utilization(0) {
+  try {
+    if (args.IsObject()) {
+      _warning_read = _get_threshold(args, "warning-read");
+      _critical_read = _get_threshold(args, "critical-read");
+      _warning_write = _get_threshold(args, "warning-write");
+      _critical_write = _get_threshold(args, "critical-write");
+      _warning_utilization = _get_threshold(args, "warning-utilization");
+      _critical_utilization = _get_threshold(args, "critical-utilization");
+    }
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "check_disk_io, fail to parse arguments: {}",
+                        e.what());
+    throw;
+  }
+}
+
+/**
+ * @brief add a perfdata with its thresholds
+ *
+ */
+static void add_perfdata(std::list<common::perfdata>* perfs,
+                         const std::string_view& disk,
+                         const std::string_view& label,
+                         const char* unit,
+                         double value,
+                         double warning,
+                         double critical) {
+  common::perfdata& perf = perfs->emplace_back();
+  perf.name(absl::StrCat(disk, "#", label));
+  perf.unit(unit);
+  perf.value(value);
+  perf.min(0);
+  if (warning > 0) {
+    perf.warning_low(0);
+    perf.warning(warning);
+  }
+  if (critical > 0) {
+    perf.critical_low(0);
+    perf.critical(critical);
+  }
+}
+
+/**
+ * @brief compute read and write rates and utilization of each device between
+ * the previous sample and this one
+ *
+ * @param sample current /proc sample
+ * @param output out plugin output
+ * @param perfs out perfdatas
+ * @return e_status
+ */
+e_status check_disk_io::compute(const proc_sample& sample,
+                                std::string* output,
+                                std::list<common::perfdata>* perfs) {
+  if (!sample.is_read(e_proc_file::diskstats)) {
+    throw exceptions::msg_fmt("fail to read /proc/diskstats");
+  }
+
+  double elapsed =
+      std::chrono::duration<double>(sample.get_time() - _previous_time)
+          .count();
+  bool first_measure =
+      _previous_time == std::chrono::steady_clock::time_point();
+  _previous_time = sample.get_time();
+
+  e_status status = e_status::ok;
+  std::string detail;
+  unsigned nb_disks = 0;
+  unsigned nb_computed = 0;
+  for (const disk_stat& disk : sample.get_disks()) {
+    if (!_filter.is_allowed(disk.name)) {
+      continue;
+    }
+    ++nb_disks;
+    auto previous = _previous.find(disk.name);
+    if (previous == _previous.end()) {
+      _previous.emplace(disk.name, disk);
+      continue;
+    }
+    const disk_stat& prev = previous->second;
+    // counters reset or same sample as the previous check
+    if (first_measure || elapsed <= 0 ||
+        disk.sectors_read < prev.sectors_read ||
+        disk.sectors_written < prev.sectors_written ||
+        disk.io_ms < prev.io_ms) {
+      previous->second = disk;
+      continue;
+    }
+    double read_rate =
+        (disk.sectors_read - prev.sectors_read) * _sector_size / elapsed;
+    double write_rate =
+        (disk.sectors_written - prev.sectors_written) * _sector_size / elapsed;
+    double utilization =
+        std::min((disk.io_ms - prev.io_ms) / (elapsed * 10), 100.0);
+    previous->second = disk;
+    ++nb_computed;
+
+    status = std::max(
+        {status, _get_status(read_rate, _warning_read, _critical_read),
+         _get_status(write_rate, _warning_write, _critical_write),
+         _get_status(utilization, _warning_utilization,
+                     _critical_utilization)});
+
+    if (!detail.empty()) {
+      detail.append(", ");
+    }
+    absl::StrAppend(&detail, "Disk '", disk.name, "' Read: ");
+    append_scaled(&detail, read_rate, 1024, "B/s");
+    detail.append(" Write: ");
+    append_scaled(&detail, write_rate, 1024, "B/s");
+    fmt::format_to(std::back_inserter(detail), " Utilization: {:.2f}%",
+                   utilization);
+
+    add_perfdata(perfs, disk.name, "read", "B/s", read_rate, _warning_read,
+                 _critical_read);
+    add_perfdata(perfs, disk.name, "write", "B/s", write_rate, _warning_write,
+                 _critical_write);
+    add_perfdata(perfs, disk.name, "utilization", "%", utilization,
+                 _warning_utilization, _critical_utilization);
+  }
+
+  if (!nb_disks) {
+    throw exceptions::msg_fmt("No disk found");
+  }
+  if (!nb_computed) {
+    *output = absl::StrCat(status_label(e_status::ok), "Buffer creation...");
+    return e_status::ok;
+  }
+  *output = absl::StrCat(status_label(status), detail);
+  return status;
+}
+
+/**
+ * @brief print check arguments
+ *
+ * @param help_stream
+ */
+void check_disk_io::help(std::ostream& help_stream) {
+  help_stream << R"(
+- disk_io params:
+    filter-disk: regex of devices to check, all by default
+    exclude-disk: regex of devices to ignore, (loop|ram)\d+ by default
+    warning-read, critical-read: read thresholds in bytes per second
+    warning-write, critical-write: write thresholds in bytes per second
+    warning-utilization, critical-utilization: thresholds of time spent doing
+      io in percent
+  An example of configuration:
+  {
+    "check": "disk_io",
+    "args": {
+      "filter-disk": "sd[a-z]",
+      "warning-utilization": 80,
+      "critical-utilization": 95
+    }
+  }
+)";
+}
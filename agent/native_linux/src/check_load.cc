@@ -0,0 +1,160 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_load.hh"
+
+#include "com/centreon/common/rapidjson_helper.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::proc_sampler_detail;
+
+constexpr std::array<std::string_view, 3> _load_labels = {"load1", "load5",
+                                                          "load15"};
+
+/**
+ * @brief Construct a new check load::check load object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected start expected
+ * @param check_interval check interval between two checks (not only this but
+ * also others)
+ * @param serv service
+ * @param cmd_name
+ * @param cmd_line
+ * @param args native plugin arguments
+ * @param cnf engine configuration received object
+ * @param handler called at measure completion
+ */
+check_load::check_load(const std::shared_ptr<asio::io_context>& io_context,
+                       const std::shared_ptr<spdlog::logger>& logger,
+                       time_point first_start_expected,
+                       duration check_interval,
+                       const std::string& serv,
+                       const std::string& cmd_name,
+                       const std::string& cmd_line,
+                       const rapidjson::Value& args,
+                       const engine_to_agent_request_ptr& cnf,
+                       check::completion_handler&& handler)
+    : proc_sample_check(io_context,
+                        logger,
+                        first_start_expected,
+                        check_interval,
+                        serv,
+                        cmd_name,
+                        cmd_line,
+                        cnf,
+                        std::move(handler)),
+      _warning{0, 0, 0},
+      _critical{0, 0, 0},
+      _per_core(false),
+      _nb_core(std::max(std::thread::hardware_concurrency(), 1U)) {
+  try {
+    if (args.IsObject()) {
+      common::rapidjson_helper arg(args);
+      for (unsigned load_index = 0; load_index < _load_labels.size();
+           ++load_index) {
+        _warning[load_index] = _get_threshold(
+            args, absl::StrCat("warning-", _load_labels[load_index]).c_str());
+        _critical[load_index] = _get_threshold(
+            args, absl::StrCat("critical-", _load_labels[load_index]).c_str());
+      }
+      _per_core = arg.get_bool("average-per-core", false);
+    }
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "check_load, fail to parse arguments: {}",
+                        e.what());
+    throw;
+  }
+}
+
+/**
+ * @brief compute status, output and perfdatas from /proc/loadavg values
+ *
+ * @param sample current /proc sample
+ * @param output out plugin output
+ * @param perfs out perfdatas
+ * @return e_status
+ */
+e_status check_load::compute(const proc_sample& sample,
+                             std::string* output,
+                             std::list<common::perfdata>* perfs) {
+  if (!sample.is_read(e_proc_file::loadavg)) {
+    throw exceptions::msg_fmt("fail to read /proc/loadavg");
+  }
+  const load_avg& load = sample.get_load_avg();
+  std::array<double, 3> values = {load.load1, load.load5, load.load15};
+  if (_per_core) {
+    for (double& value : values) {
+      value /= _nb_core;
+    }
+  }
+
+  e_status status = e_status::ok;
+  for (unsigned load_index = 0; load_index < values.size(); ++load_index) {
+    status = std::max(status, _get_status(values[load_index],
+                                          _warning[load_index],
+                                          _critical[load_index]));
+  }
+
+  *output = absl::StrCat(status_label(status), "Load average",
+                         _per_core ? " per core" : "", ": ");
+  fmt::format_to(std::back_inserter(*output), "{:.2f}, {:.2f}, {:.2f}",
+                 values[0], values[1], values[2]);
+
+  for (unsigned load_index = 0; load_index < values.size(); ++load_index) {
+    common::perfdata& perf = perfs->emplace_back();
+    perf.name(_load_labels[load_index]);
+    perf.value(values[load_index]);
+    perf.min(0);
+    if (_warning[load_index] > 0) {
+      perf.warning_low(0);
+      perf.warning(_warning[load_index]);
+    }
+    if (_critical[load_index] > 0) {
+      perf.critical_low(0);
+      perf.critical(_critical[load_index]);
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief print check arguments
+ *
+ * @param help_stream
+ */
+void check_load::help(std::ostream& help_stream) {
+  help_stream << R"(
+- load params:
+    warning-load1, warning-load5, warning-load15: load average thresholds
+    critical-load1, critical-load5, critical-load15: load average thresholds
+    average-per-core: if true, load average is divided by the number of cores
+  An example of configuration:
+  {
+    "check": "load",
+    "args": {
+      "average-per-core": true,
+      "warning-load5": 1.5,
+      "critical-load5": 3
+    }
+  }
+)";
+}
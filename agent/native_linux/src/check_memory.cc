@@ -0,0 +1,190 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_memory.hh"
+
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::proc_sampler_detail;
+
+/**
+ * @brief Construct a new check memory::check memory object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected start expected
+ * @param check_interval check interval between two checks (not only this but
+ * also others)
+ * @param serv service
+ * @param cmd_name
+ * @param cmd_line
+ * @param args native plugin arguments
+ * @param cnf engine configuration received object
+ * @param handler called at measure completion
+ * @param swap if true, swap is checked instead of memory
+ */
+check_memory::check_memory(const std::shared_ptr<asio::io_context>& io_context,
+                           const std::shared_ptr<spdlog::logger>& logger,
+                           time_point first_start_expected,
+                           duration check_interval,
+                           const std::string& serv,
+                           const std::string& cmd_name,
+                           const std::string& cmd_line,
+                           const rapidjson::Value& args,
+                           const engine_to_agent_request_ptr& cnf,
+                           check::completion_handler&& handler,
+                           bool swap)
+    : proc_sample_check(io_context,
+                        logger,
+                        first_start_expected,
+                        check_interval,
+                        serv,
+                        cmd_name,
+                        cmd_line,
+                        cnf,
+                        std::move(handler)),
+      _swap(swap),
+      _warning(0),
+      _critical(0),
+      _warning_prct(0),
+      _critical_prct(0) {
+  try {
+    if (args.IsObject()) {
+      _warning = _get_threshold(args, "warning-usage");
+      _critical = _get_threshold(args, "critical-usage");
+      _warning_prct = _get_threshold(args, "warning-usage-prct");
+      _critical_prct = _get_threshold(args, "critical-usage-prct");
+    }
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "check_memory, fail to parse arguments: {}",
+                        e.what());
+    throw;
+  }
+}
+
+/**
+ * @brief compute status, output and perfdatas from /proc/meminfo values
+ *
+ * @param sample current /proc sample
+ * @param output out plugin output
+ * @param perfs out perfdatas
+ * @return e_status
+ */
+e_status check_memory::compute(const proc_sample& sample,
+                               std::string* output,
+                               std::list<common::perfdata>* perfs) {
+  if (!sample.is_read(e_proc_file::meminfo)) {
+    throw exceptions::msg_fmt("fail to read /proc/meminfo");
+  }
+  const mem_info& info = sample.get_mem_info();
+  uint64_t total, used;
+  std::string_view label, perf_prefix;
+  if (_swap) {
+    total = info.swap_total;
+    used = info.swap_total - info.swap_free;
+    label = "Swap";
+    perf_prefix = "swap";
+  } else {
+    total = info.mem_total;
+    used = info.mem_total - info.mem_available;
+    label = "Ram";
+    perf_prefix = "memory";
+  }
+
+  if (!total) {
+    *output = absl::StrCat(status_label(e_status::ok), "No active ", label);
+    return e_status::ok;
+  }
+
+  double used_prct = static_cast<double>(used) * 100 / total;
+  e_status status =
+      std::max(_get_status(used, _warning, _critical),
+               _get_status(used_prct, _warning_prct, _critical_prct));
+
+  *output = absl::StrCat(status_label(status), label, " total: ");
+  append_scaled(output, total, 1024, "B");
+  output->append(" used: ");
+  append_scaled(output, used, 1024, "B");
+  fmt::format_to(std::back_inserter(*output), " ({:.2f}%) free: ", used_prct);
+  append_scaled(output, total - used, 1024, "B");
+  fmt::format_to(std::back_inserter(*output), " ({:.2f}%)", 100 - used_prct);
+
+  common::perfdata& usage = perfs->emplace_back();
+  usage.name(absl::StrCat(perf_prefix, ".usage.bytes"));
+  usage.unit("B");
+  usage.value(used);
+  usage.min(0);
+  usage.max(total);
+  if (_warning > 0) {
+    usage.warning_low(0);
+    usage.warning(_warning);
+  }
+  if (_critical > 0) {
+    usage.critical_low(0);
+    usage.critical(_critical);
+  }
+
+  common::perfdata& free = perfs->emplace_back();
+  free.name(absl::StrCat(perf_prefix, ".free.bytes"));
+  free.unit("B");
+  free.value(total - used);
+  free.min(0);
+  free.max(total);
+
+  common::perfdata& prct = perfs->emplace_back();
+  prct.name(absl::StrCat(perf_prefix, ".usage.percentage"));
+  prct.unit("%");
+  prct.value(used_prct);
+  prct.min(0);
+  prct.max(100);
+  if (_warning_prct > 0) {
+    prct.warning_low(0);
+    prct.warning(_warning_prct);
+  }
+  if (_critical_prct > 0) {
+    prct.critical_low(0);
+    prct.critical(_critical_prct);
+  }
+
+  return status;
+}
+
+/**
+ * @brief print check arguments
+ *
+ * @param help_stream
+ */
+void check_memory::help(std::ostream& help_stream) {
+  help_stream << R"(
+- memory and swap params:
+    warning-usage: threshold of used memory in bytes
+    critical-usage: threshold of used memory in bytes
+    warning-usage-prct: threshold of used memory in percent
+    critical-usage-prct: threshold of used memory in percent
+  An example of configuration:
+  {
+    "check": "memory",
+    "args": {
+      "warning-usage-prct": 80,
+      "critical-usage-prct": 90
+    }
+  }
+)";
+}
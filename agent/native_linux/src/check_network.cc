@@ -0,0 +1,206 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_network.hh"
+
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::proc_sampler_detail;
+
+/**
+ * @brief Construct a new check network::check network object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected start expected
+ * @param check_interval check interval between two checks (not only this but
+ * also others)
+ * @param serv service
+ * @param cmd_name
+ * @param cmd_line
+ * @param args native plugin arguments
+ * @param cnf engine configuration received object
+ * @param handler called at measure completion
+ */
+check_network::check_network(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point first_start_expected,
+    duration check_interval,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const rapidjson::Value& args,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler)
+    : proc_sample_check(io_context,
+                        logger,
+                        first_start_expected,
+                        check_interval,
+                        serv,
+                        cmd_name,
+                        cmd_line,
+                        cnf,
+                        std::move(handler)),
+      _filter(args, "filter-interface", "exclude-interface", "lo"),
+      _warning_in(0),
+      _critical_in(0),
+      _warning_out(0),
+      _critical_out(0) {
+  try {
+    if (args.IsObject()) {
+      _warning_in = _get_threshold(args, "warning-in");
+      _critical_in = _get_threshold(args, "critical-in");
+      _warning_out = _get_threshold(args, "warning-out");
+      _critical_out = _get_threshold(args, "critical-out");
+    }
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "check_network, fail to parse arguments: {}",
+                        e.what());
+    throw;
+  }
+}
+
+/**
+ * @brief compute traffic of each interface between the previous sample and
+ * this one
+ *
+ * @param sample current /proc sample
+ * @param output out plugin output
+ * @param perfs out perfdatas
+ * @return e_status
+ */
+e_status check_network::compute(const proc_sample& sample,
+                                std::string* output,
+                                std::list<common::perfdata>* perfs) {
+  if (!sample.is_read(e_proc_file::net_dev)) {
+    throw exceptions::msg_fmt("fail to read /proc/net/dev");
+  }
+
+  double elapsed =
+      std::chrono::duration<double>(sample.get_time() - _previous_time)
+          .count();
+  bool first_measure =
+      _previous_time == std::chrono::steady_clock::time_point();
+  _previous_time = sample.get_time();
+
+  e_status status = e_status::ok;
+  std::string detail;
+  unsigned nb_interfaces = 0;
+  unsigned nb_computed = 0;
+  for (const net_dev_stat& dev : sample.get_net_devs()) {
+    if (!_filter.is_allowed(dev.name)) {
+      continue;
+    }
+    ++nb_interfaces;
+    auto previous = _previous.find(dev.name);
+    if (previous == _previous.end()) {
+      _previous.emplace(dev.name, dev);
+      continue;
+    }
+    // counters reset or same sample as the previous check
+    if (first_measure || elapsed <= 0 ||
+        dev.rx_bytes < previous->second.rx_bytes ||
+        dev.tx_bytes < previous->second.tx_bytes) {
+      previous->second = dev;
+      continue;
+    }
+    double traffic_in =
+        (dev.rx_bytes - previous->second.rx_bytes) * 8 / elapsed;
+    double traffic_out =
+        (dev.tx_bytes - previous->second.tx_bytes) * 8 / elapsed;
+    previous->second = dev;
+    ++nb_computed;
+
+    status = std::max({status,
+                       _get_status(traffic_in, _warning_in, _critical_in),
+                       _get_status(traffic_out, _warning_out, _critical_out)});
+
+    if (!detail.empty()) {
+      detail.append(", ");
+    }
+    absl::StrAppend(&detail, "Interface '", dev.name, "' Traffic In: ");
+    append_scaled(&detail, traffic_in, 1000, "b/s");
+    detail.append(" Out: ");
+    append_scaled(&detail, traffic_out, 1000, "b/s");
+
+    common::perfdata& in = perfs->emplace_back();
+    in.name(absl::StrCat(dev.name, "#traffic_in"));
+    in.unit("b/s");
+    in.value(traffic_in);
+    in.min(0);
+    if (_warning_in > 0) {
+      in.warning_low(0);
+      in.warning(_warning_in);
+    }
+    if (_critical_in > 0) {
+      in.critical_low(0);
+      in.critical(_critical_in);
+    }
+
+    common::perfdata& out = perfs->emplace_back();
+    out.name(absl::StrCat(dev.name, "#traffic_out"));
+    out.unit("b/s");
+    out.value(traffic_out);
+    out.min(0);
+    if (_warning_out > 0) {
+      out.warning_low(0);
+      out.warning(_warning_out);
+    }
+    if (_critical_out > 0) {
+      out.critical_low(0);
+      out.critical(_critical_out);
+    }
+  }
+
+  if (!nb_interfaces) {
+    throw exceptions::msg_fmt("No interface found");
+  }
+  if (!nb_computed) {
+    *output = absl::StrCat(status_label(e_status::ok), "Buffer creation...");
+    return e_status::ok;
+  }
+  *output = absl::StrCat(status_label(status), detail);
+  return status;
+}
+
+/**
+ * @brief print check arguments
+ *
+ * @param help_stream
+ */
+void check_network::help(std::ostream& help_stream) {
+  help_stream << R"(
+- network_traffic params:
+    filter-interface: regex of interfaces to check, all by default
+    exclude-interface: regex of interfaces to ignore, lo by default
+    warning-in, critical-in: incoming traffic thresholds in bits per second
+    warning-out, critical-out: outgoing traffic thresholds in bits per second
+  An example of configuration:
+  {
+    "check": "network_traffic",
+    "args": {
+      "filter-interface": "eth.*",
+      "warning-in": 80000000,
+      "critical-in": 95000000
+    }
+  }
+)";
+}
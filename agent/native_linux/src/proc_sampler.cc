@@ -0,0 +1,527 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "proc_sampler.hh"
+
+#include "com/centreon/common/rapidjson_helper.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::proc_sampler_detail;
+
+constexpr std::array<std::string_view, nb_proc_file> _proc_file_names = {
+    "/stat", "/meminfo", "/net/dev", "/diskstats", "/loadavg"};
+
+constexpr std::array<std::string_view, 4> _sz_status = {
+    "OK: ", "WARNING: ", "CRITICAL: ", "UNKNOWN: "};
+
+/**
+ * @brief extract the next space separated field of line
+ *
+ * @param line line to parse, field is removed from it
+ * @return std::string_view field, empty if no more field
+ */
+static std::string_view next_field(std::string_view& line) {
+  size_t start = line.find_first_not_of(" \t");
+  if (start == std::string_view::npos) {
+    line = std::string_view();
+    return std::string_view();
+  }
+  size_t end = line.find_first_of(" \t", start);
+  std::string_view field = line.substr(start, end - start);
+  line = end == std::string_view::npos ? std::string_view()
+                                       : line.substr(end);
+  return field;
+}
+
+/**
+ * @brief extract the next space separated field of line as an integer
+ *
+ * @param line line to parse, field is removed from it
+ * @return uint64_t value, 0 if field is not a number
+ */
+static uint64_t next_uint(std::string_view& line) {
+  uint64_t value;
+  if (!absl::SimpleAtoi(next_field(line), &value)) {
+    return 0;
+  }
+  return value;
+}
+
+/**
+ * @brief skip some fields of line
+ *
+ */
+static void skip_fields(std::string_view& line, unsigned nb_fields) {
+  for (; nb_fields > 0; --nb_fields) {
+    next_field(line);
+  }
+}
+
+namespace com::centreon::agent::proc_sampler_detail {
+
+/**
+ * @brief parse /proc/meminfo content like
+ * MemTotal:       16318480 kB
+ * if MemAvailable is missing (kernel older than 3.14), it's estimated with
+ * MemFree + Buffers + Cached
+ *
+ * @param content file content
+ * @param info out values in bytes
+ */
+void parse_meminfo(const std::string_view& content, mem_info* info) {
+  *info = mem_info();
+  bool available_found = false;
+  for (std::string_view line : absl::StrSplit(content, '\n')) {
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+      continue;
+    }
+    std::string_view key = line.substr(0, colon);
+    uint64_t* to_fill;
+    if (key == "MemTotal") {
+      to_fill = &info->mem_total;
+    } else if (key == "MemFree") {
+      to_fill = &info->mem_free;
+    } else if (key == "MemAvailable") {
+      to_fill = &info->mem_available;
+      available_found = true;
+    } else if (key == "Buffers") {
+      to_fill = &info->buffers;
+    } else if (key == "Cached") {
+      to_fill = &info->cached;
+    } else if (key == "SwapTotal") {
+      to_fill = &info->swap_total;
+    } else if (key == "SwapFree") {
+      to_fill = &info->swap_free;
+    } else {
+      continue;
+    }
+    std::string_view values = line.substr(colon + 1);
+    *to_fill = next_uint(values);
+    if (next_field(values) == "kB") {
+      *to_fill *= 1024;
+    }
+  }
+  if (!available_found) {
+    info->mem_available = info->mem_free + info->buffers + info->cached;
+  }
+}
+
+/**
+ * @brief parse /proc/loadavg content like
+ * 0.52 0.58 0.59 2/1234 5678
+ *
+ * @param content file content
+ * @param load out values
+ */
+void parse_loadavg(const std::string_view& content, load_avg* load) {
+  *load = load_avg();
+  std::string_view line = content;
+  if (!absl::SimpleAtod(next_field(line), &load->load1) ||
+      !absl::SimpleAtod(next_field(line), &load->load5) ||
+      !absl::SimpleAtod(next_field(line), &load->load15)) {
+    return;
+  }
+  std::string_view threads = next_field(line);
+  size_t slash = threads.find('/');
+  if (slash != std::string_view::npos) {
+    if (!absl::SimpleAtoi(threads.substr(0, slash), &load->running) ||
+        !absl::SimpleAtoi(threads.substr(slash + 1), &load->total)) {
+      load->running = load->total = 0;
+    }
+  }
+}
+
+/**
+ * @brief parse /proc/net/dev content like
+ *   eth0: 1234 12 0 0 0 0 0 0 5678 34 0 0 0 0 0 0
+ * the two header lines have no ':' and are ignored
+ *
+ * @param content file content
+ * @param devs out interfaces, elements are reused
+ */
+void parse_net_dev(const std::string_view& content,
+                   std::vector<net_dev_stat>* devs) {
+  size_t nb_devs = 0;
+  for (std::string_view line : absl::StrSplit(content, '\n')) {
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+      continue;
+    }
+    if (nb_devs == devs->size()) {
+      devs->emplace_back();
+    }
+    net_dev_stat& dev = (*devs)[nb_devs++];
+    std::string_view name = absl::StripAsciiWhitespace(line.substr(0, colon));
+    dev.name.assign(name.data(), name.size());
+    std::string_view values = line.substr(colon + 1);
+    dev.rx_bytes = next_uint(values);
+    dev.rx_packets = next_uint(values);
+    dev.rx_errors = next_uint(values);
+    dev.rx_drops = next_uint(values);
+    // fifo frame compressed multicast
+    skip_fields(values, 4);
+    dev.tx_bytes = next_uint(values);
+    dev.tx_packets = next_uint(values);
+    dev.tx_errors = next_uint(values);
+    dev.tx_drops = next_uint(values);
+  }
+  devs->resize(nb_devs);
+}
+
+/**
+ * @brief parse /proc/diskstats content like
+ *    8       0 sda 1234 56 7890 123 4567 89 12345 678 0 901 234
+ *
+ * @param content file content
+ * @param disks out devices, elements are reused
+ */
+void parse_diskstats(const std::string_view& content,
+                     std::vector<disk_stat>* disks) {
+  size_t nb_disks = 0;
+  for (std::string_view line : absl::StrSplit(content, '\n')) {
+    // major minor
+    skip_fields(line, 2);
+    std::string_view name = next_field(line);
+    if (name.empty()) {
+      continue;
+    }
+    if (nb_disks == disks->size()) {
+      disks->emplace_back();
+    }
+    disk_stat& disk = (*disks)[nb_disks++];
+    disk.name.assign(name.data(), name.size());
+    disk.reads = next_uint(line);
+    // reads merged
+    skip_fields(line, 1);
+    disk.sectors_read = next_uint(line);
+    disk.read_ms = next_uint(line);
+    disk.writes = next_uint(line);
+    // writes merged
+    skip_fields(line, 1);
+    disk.sectors_written = next_uint(line);
+    disk.write_ms = next_uint(line);
+    // io in progress
+    skip_fields(line, 1);
+    disk.io_ms = next_uint(line);
+  }
+  disks->resize(nb_disks);
+}
+
+/**
+ * @brief output prefix of a status
+ *
+ */
+std::string_view status_label(e_status status) {
+  return status < _sz_status.size() ? _sz_status[status]
+                                    : _sz_status[e_status::unknown];
+}
+
+/**
+ * @brief append a value with a K, M, G or T prefix to output
+ * append_scaled(&output, 2048, 1024, "B") appends "2.00 KB"
+ *
+ * @param output string to complete
+ * @param value value to write
+ * @param base 1024 for bytes, 1000 for bits
+ * @param unit unit appended after prefix
+ */
+void append_scaled(std::string* output,
+                   double value,
+                   double base,
+                   const std::string_view& unit) {
+  constexpr std::array<std::string_view, 5> prefixes = {"", "K", "M", "G",
+                                                        "T"};
+  unsigned prefix_index = 0;
+  while (value >= base && prefix_index < prefixes.size() - 1) {
+    value /= base;
+    ++prefix_index;
+  }
+  fmt::format_to(std::back_inserter(*output), "{:.2f} {}{}", value,
+                 prefixes[prefix_index], unit);
+}
+
+/**
+ * @brief Construct a new name filter object
+ *
+ * @param args check arguments
+ * @param filter_field name of the include regex field
+ * @param exclude_field name of the exclude regex field
+ * @param default_exclude exclude regex used if exclude_field is absent, may be
+ * nullptr
+ * @throw msg_fmt if a field is not a string or a regex is invalid
+ */
+name_filter::name_filter(const rapidjson::Value& args,
+                         const char* filter_field,
+                         const char* exclude_field,
+                         const char* default_exclude) {
+  common::rapidjson_helper arg(args);
+  const char* filter = nullptr;
+  const char* exclude = default_exclude;
+  if (args.IsObject()) {
+    filter = arg.get_string(filter_field, nullptr);
+    exclude = arg.get_string(exclude_field, default_exclude);
+  }
+  if (filter && *filter) {
+    _filter = std::make_unique<re2::RE2>(filter);
+    if (!_filter->ok()) {
+      throw exceptions::msg_fmt("invalid regex for {}: {}", filter_field,
+                                _filter->error());
+    }
+  }
+  if (exclude && *exclude) {
+    _exclude = std::make_unique<re2::RE2>(exclude);
+    if (!_exclude->ok()) {
+      throw exceptions::msg_fmt("invalid regex for {}: {}", exclude_field,
+                                _exclude->error());
+    }
+  }
+}
+
+/**
+ * @brief test a name against regexes
+ *
+ * @param name interface or device name
+ * @return true if name must be checked
+ */
+bool name_filter::is_allowed(const std::string_view& name) const {
+  if (_exclude && RE2::FullMatch(name, *_exclude)) {
+    return false;
+  }
+  return !_filter || RE2::FullMatch(name, *_filter);
+}
+
+}  // namespace com::centreon::agent::proc_sampler_detail
+
+/**
+ * @brief Construct a new proc sampler object
+ *
+ * @param proc_dir /proc, other for unit tests
+ * @param tick a sample is reused by get_sample() during this duration
+ */
+proc_sampler::proc_sampler(const std::string_view& proc_dir,
+                           std::chrono::steady_clock::duration tick)
+    : _tick(tick) {
+  for (unsigned file_index = 0; file_index < nb_proc_file; ++file_index) {
+    _paths[file_index] = absl::StrCat(proc_dir, _proc_file_names[file_index]);
+  }
+}
+
+/**
+ * @brief sampler of /proc shared by all native checks
+ *
+ * @return proc_sampler&
+ */
+proc_sampler& proc_sampler::instance() {
+  static proc_sampler _instance("/proc", std::chrono::seconds(1));
+  return _instance;
+}
+
+/**
+ * @brief read a whole file in content, content capacity is reused
+ *
+ * @param file file to read
+ * @param content out file content
+ * @return true if the file has been read
+ */
+bool proc_sampler::_read_file(e_proc_file file, std::string* content) {
+  int fd = ::open(_paths[file].c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    content->clear();
+    return false;
+  }
+  size_t size = 0;
+  content->resize(std::max<size_t>(content->capacity(), 4096));
+  while (true) {
+    ssize_t read_size =
+        ::read(fd, content->data() + size, content->size() - size);
+    if (read_size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ::close(fd);
+      content->clear();
+      return false;
+    }
+    if (!read_size) {
+      break;
+    }
+    size += read_size;
+    if (size == content->size()) {
+      content->resize(size * 2);
+    }
+  }
+  ::close(fd);
+  content->resize(size);
+  return true;
+}
+
+/**
+ * @brief read all files and parse them in sample
+ *
+ * @param sample sample to fill
+ */
+void proc_sampler::_fill(proc_sample& sample) {
+  sample._read_flags = 0;
+  if (_read_file(e_proc_file::stat, &sample._stat)) {
+    sample._read_flags |= 1U << e_proc_file::stat;
+  }
+  if (_read_file(e_proc_file::meminfo, &_buffer)) {
+    parse_meminfo(_buffer, &sample._mem_info);
+    sample._read_flags |= 1U << e_proc_file::meminfo;
+  }
+  if (_read_file(e_proc_file::net_dev, &_buffer)) {
+    parse_net_dev(_buffer, &sample._net_devs);
+    sample._read_flags |= 1U << e_proc_file::net_dev;
+  }
+  if (_read_file(e_proc_file::diskstats, &_buffer)) {
+    parse_diskstats(_buffer, &sample._disks);
+    sample._read_flags |= 1U << e_proc_file::diskstats;
+  }
+  if (_read_file(e_proc_file::loadavg, &_buffer)) {
+    parse_loadavg(_buffer, &sample._load_avg);
+    sample._read_flags |= 1U << e_proc_file::loadavg;
+  }
+  sample._time = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief get a sample of /proc
+ * if the last sample is younger than max_age, it is returned, otherwise, files
+ * are read again. The sample is filled in the previous one if no check uses it
+ * anymore.
+ *
+ * @param max_age max age of the returned sample, 0 to force a new reading
+ * @return std::shared_ptr<const proc_sample>
+ */
+std::shared_ptr<const proc_sample> proc_sampler::get_sample(
+    std::chrono::steady_clock::duration max_age) {
+  absl::MutexLock l(&_protect);
+  if (_last && max_age > std::chrono::steady_clock::duration::zero() &&
+      std::chrono::steady_clock::now() - _last->_time < max_age) {
+    return _last;
+  }
+  std::shared_ptr<proc_sample> to_fill;
+  if (_spare && _spare.use_count() == 1) {
+    to_fill = std::move(_spare);
+  } else {
+    to_fill = std::make_shared<proc_sample>();
+  }
+  _fill(*to_fill);
+  _spare = std::move(_last);
+  _last = std::move(to_fill);
+  return _last;
+}
+
+/**
+ * @brief Construct a new proc sample check object
+ *
+ */
+proc_sample_check::proc_sample_check(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point first_start_expected,
+    duration check_interval,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler)
+    : check(io_context,
+            logger,
+            first_start_expected,
+            check_interval,
+            serv,
+            cmd_name,
+            cmd_line,
+            cnf,
+            std::move(handler)) {}
+
+/**
+ * @brief get a sample from the shared sampler and compute the check result
+ * No fork, no file read if another check has yet sampled /proc during the
+ * current tick
+ *
+ * @param timeout
+ */
+void proc_sample_check::start_check(const duration& timeout) {
+  if (!_start_check(timeout)) {
+    return;
+  }
+
+  std::string output;
+  std::list<common::perfdata> perfs;
+  e_status status;
+  try {
+    status = compute(*proc_sampler::instance().get_sample(), &output, &perfs);
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "{} fail to compute check: {}",
+                        get_command_name(), e.what());
+    status = e_status::unknown;
+    output = absl::StrCat(status_label(status), e.what());
+    perfs.clear();
+  }
+
+  _io_context->post([me = shared_from_this(),
+                     start_check_index = _get_running_check_index(), status,
+                     out = std::move(output), perfs = std::move(perfs)]() {
+    me->on_completion(start_check_index, status, perfs, {out});
+  });
+}
+
+/**
+ * @brief compare a value to its thresholds, a 0 threshold is not tested
+ *
+ * @param value
+ * @param warning
+ * @param critical
+ * @return e_status
+ */
+e_status proc_sample_check::_get_status(double value,
+                                        double warning,
+                                        double critical) {
+  if (critical > 0 && value >= critical) {
+    return e_status::critical;
+  }
+  if (warning > 0 && value >= warning) {
+    return e_status::warning;
+  }
+  return e_status::ok;
+}
+
+/**
+ * @brief read a threshold in check arguments
+ *
+ * @param args check arguments
+ * @param field_name
+ * @return double threshold, 0 if absent
+ * @throw msg_fmt if field is not a number
+ */
+double proc_sample_check::_get_threshold(const rapidjson::Value& args,
+                                         const char* field_name) {
+  common::rapidjson_helper arg(args);
+  if (!arg.has_member(field_name)) {
+    return 0;
+  }
+  return arg.get_double(field_name);
+}
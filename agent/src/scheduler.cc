@@ -20,6 +20,11 @@
 #include "check_cpu.hh"
 #ifdef _WINDOWS
 #include "check_uptime.hh"
+#else
+#include "check_disk_io.hh"
+#include "check_load.hh"
+#include "check_memory.hh"
+#include "check_network.hh"
 #endif
 #include "check_exec.hh"
 #include "com/centreon/common/rapidjson_helper.hh"
@@ -28,6 +33,9 @@
 
 using namespace com::centreon::agent;
 
+// above this size, a sent request arena is not reused but freed
+constexpr size_t _max_reused_arena_size = 16 * 1024 * 1024;
+
 /**
  * @brief to call after creation
  * it create a default configuration with no check and start send timer
@@ -65,20 +73,110 @@ void scheduler::_send_timer_handler(const boost::system::error_code& err) {
   if (err) {
     return;
   }
-  if (_current_request->mutable_otel_request()->resource_metrics_size() > 0) {
-    _metric_sender(_current_request);
+  // resources of services that have not been checked since last export
+  unsigned nb_removed = _current_request->remove_empty_resources();
+  if (_current_request->request->otel_request().resource_metrics_size() > 0) {
+    if (_logger->level() <= spdlog::level::debug) {
+      SPDLOG_LOGGER_DEBUG(
+          _logger,
+          "export {} results ({} unchanged skipped) of {} services, {} "
+          "services removed, {} bytes, {} arena bytes, store duration: {}",
+          _nb_stored_results, _nb_skipped_results,
+          _current_request->request->otel_request().resource_metrics_size(),
+          nb_removed, _current_request->request->ByteSizeLong(),
+          _current_request->arena.SpaceUsed(),
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              _store_duration));
+    }
+    _metric_sender(std::shared_ptr<MessageFromAgent>(
+        _current_request, _current_request->request));
     _init_export_request();
   }
   _start_send_timer();
 }
 
 /**
- * @brief create export request and fill some attributes
+ * @brief allocate a new export request on an arena
+ *
+ */
+scheduler::export_request::export_request()
+    : request(google::protobuf::Arena::CreateMessage<MessageFromAgent>(
+          &arena)) {}
+
+/**
+ * @brief clear all data points and outputs but keep resources and metrics
+ * already created
+ *
+ */
+void scheduler::export_request::clear_data_points() {
+  for (auto& serv_scope : serv_to_scope_metrics) {
+    for (auto& name_metric : serv_scope.second.metrics) {
+      name_metric.second->clear_description();
+      name_metric.second->mutable_gauge()->clear_data_points();
+    }
+  }
+}
+
+/**
+ * @brief remove resources and metrics without data points
+ * removed objects are not freed but kept by repeated fields in order to be
+ * reused
+ *
+ * @return unsigned number of resources removed
+ */
+unsigned scheduler::export_request::remove_empty_resources() {
+  auto* resources = request->mutable_otel_request()->mutable_resource_metrics();
+  unsigned nb_removed = 0;
+  for (auto serv_iter = serv_to_scope_metrics.begin();
+       serv_iter != serv_to_scope_metrics.end();) {
+    scope_metric_request& scope = serv_iter->second;
+    auto* metrics = scope.scope_metric->mutable_metrics();
+    for (auto metric_iter = scope.metrics.begin();
+         metric_iter != scope.metrics.end();) {
+      if (metric_iter->second->gauge().data_points_size() > 0) {
+        ++metric_iter;
+        continue;
+      }
+      int index = std::find(metrics->pointer_begin(), metrics->pointer_end(),
+                            metric_iter->second) -
+                  metrics->pointer_begin();
+      metrics->SwapElements(index, metrics->size() - 1);
+      metrics->RemoveLast();
+      scope.metrics.erase(metric_iter++);
+    }
+    if (!scope.metrics.empty()) {
+      ++serv_iter;
+      continue;
+    }
+    int index = std::find(resources->pointer_begin(), resources->pointer_end(),
+                          scope.resource_metric) -
+                resources->pointer_begin();
+    resources->SwapElements(index, resources->size() - 1);
+    resources->RemoveLast();
+    serv_to_scope_metrics.erase(serv_iter++);
+    ++nb_removed;
+  }
+  return nb_removed;
+}
+
+/**
+ * @brief prepare the next export request
+ * the last sent request is reused if the sender has released it
  *
  */
 void scheduler::_init_export_request() {
-  _current_request = std::make_shared<MessageFromAgent>();
-  _serv_to_scope_metrics.clear();
+  std::shared_ptr<export_request> to_reuse = std::move(_spare_request);
+  _spare_request = std::move(_current_request);
+  if (to_reuse && to_reuse.use_count() == 1 &&
+      to_reuse->arena.SpaceAllocated() < _max_reused_arena_size) {
+    to_reuse->clear_data_points();
+    _current_request = std::move(to_reuse);
+  } else {
+    _current_request = std::make_shared<export_request>();
+  }
+  _nb_stored_results = 0;
+  _nb_skipped_results = 0;
+  _store_duration = duration::zero();
 }
 
 /**
@@ -171,6 +269,9 @@ void scheduler::update(const engine_to_agent_request_ptr& conf) {
   SPDLOG_LOGGER_INFO(_logger, "schedule {} checks to execute in {}s", nb_check,
                      conf->config().check_interval());
 
+  // all results of the new configuration will be exported at least once
+  _last_exports.clear();
+
   if (nb_check > 0) {
     duration time_between_check =
         std::chrono::microseconds(conf->config().check_interval() * 1000000) /
@@ -255,10 +356,17 @@ void scheduler::_check_handler(
     return;
   }
 
-  if (_conf->config().use_exemplar()) {
-    _store_result_in_metrics_and_exemplars(check, status, perfdata, outputs);
+  if (_is_unchanged_since_last_export(check, status, perfdata, outputs)) {
+    ++_nb_skipped_results;
   } else {
-    _store_result_in_metrics(check, status, perfdata, outputs);
+    auto store_start = std::chrono::system_clock::now();
+    if (_conf->config().use_exemplar()) {
+      _store_result_in_metrics_and_exemplars(check, status, perfdata, outputs);
+    } else {
+      _store_result_in_metrics(check, status, perfdata, outputs);
+    }
+    _store_duration += std::chrono::system_clock::now() - store_start;
+    ++_nb_stored_results;
   }
 
   --_active_check;
@@ -280,6 +388,40 @@ void scheduler::_check_handler(
   }
 }
 
+/**
+ * @brief in delta export mode, a result identical to the last exported one of
+ * the same service is not exported until delta_export_max_period has elapsed
+ *
+ * @param check
+ * @param status
+ * @param perfdata
+ * @param outputs
+ * @return true if the result mustn't be exported
+ */
+bool scheduler::_is_unchanged_since_last_export(
+    const check::pointer& check,
+    unsigned status,
+    const std::list<com::centreon::common::perfdata>& perfdata,
+    const std::list<std::string>& outputs) {
+  if (!_conf->config().delta_export_max_period()) {
+    return false;
+  }
+  time_point now = std::chrono::system_clock::now();
+  auto [last, inserted] = _last_exports.try_emplace(check->get_service());
+  if (!inserted && last->second.status == status &&
+      last->second.outputs == outputs && last->second.perfdata == perfdata &&
+      now < last->second.export_time +
+                std::chrono::seconds(
+                    _conf->config().delta_export_max_period())) {
+    return true;
+  }
+  last->second.export_time = now;
+  last->second.status = status;
+  last->second.outputs = outputs;
+  last->second.perfdata = perfdata;
+  return false;
+}
+
 /**
  * @brief to call on process termination or accepted connection error
  *
@@ -371,12 +513,13 @@ void scheduler::_store_result_in_metrics_and_exemplars(
  */
 scheduler::scope_metric_request& scheduler::_get_scope_metrics(
     const std::string& service) {
-  auto exist = _serv_to_scope_metrics.find(service);
-  if (exist != _serv_to_scope_metrics.end()) {
+  auto exist = _current_request->serv_to_scope_metrics.find(service);
+  if (exist != _current_request->serv_to_scope_metrics.end()) {
     return exist->second;
   }
   ::opentelemetry::proto::metrics::v1::ResourceMetrics* new_res =
-      _current_request->mutable_otel_request()->add_resource_metrics();
+      _current_request->request->mutable_otel_request()
+          ->add_resource_metrics();
 
   auto* host_attrib = new_res->mutable_resource()->add_attributes();
   host_attrib->set_key("host.name");
@@ -388,10 +531,12 @@ scheduler::scope_metric_request& scheduler::_get_scope_metrics(
   ::opentelemetry::proto::metrics::v1::ScopeMetrics* new_scope =
       new_res->add_scope_metrics();
 
-  scope_metric_request to_insert;
+  scope_metric_request& to_insert =
+      _current_request->serv_to_scope_metrics[service];
+  to_insert.resource_metric = new_res;
   to_insert.scope_metric = new_scope;
 
-  return _serv_to_scope_metrics.emplace(service, to_insert).first->second;
+  return to_insert;
 }
 
 /**
@@ -570,6 +715,24 @@ std::shared_ptr<check> scheduler::default_check_builder(
       return std::make_shared<check_drive_size>(
           io_context, logger, first_start_expected, check_interval, service,
           cmd_name, cmd_line, *args, conf, std::move(handler));
+#else
+    } else if (check_type == "memory"sv || check_type == "swap"sv) {
+      return std::make_shared<check_memory>(
+          io_context, logger, first_start_expected, check_interval, service,
+          cmd_name, cmd_line, *args, conf, std::move(handler),
+          check_type == "swap"sv);
+    } else if (check_type == "load"sv) {
+      return std::make_shared<check_load>(
+          io_context, logger, first_start_expected, check_interval, service,
+          cmd_name, cmd_line, *args, conf, std::move(handler));
+    } else if (check_type == "network_traffic"sv) {
+      return std::make_shared<check_network>(
+          io_context, logger, first_start_expected, check_interval, service,
+          cmd_name, cmd_line, *args, conf, std::move(handler));
+    } else if (check_type == "disk_io"sv) {
+      return std::make_shared<check_disk_io>(
+          io_context, logger, first_start_expected, check_interval, service,
+          cmd_name, cmd_line, *args, conf, std::move(handler));
 #endif
     } else {
       throw exceptions::msg_fmt("command {}, unknown native check:{}", cmd_name,
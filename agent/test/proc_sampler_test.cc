@@ -0,0 +1,319 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+
+#include "check_cpu.hh"
+#include "check_disk_io.hh"
+#include "check_load.hh"
+#include "check_memory.hh"
+#include "check_network.hh"
+#include "com/centreon/common/rapidjson_helper.hh"
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::proc_sampler_detail;
+using namespace std::string_literals;
+
+constexpr const char* test_proc_dir = "/tmp/proc_sampler_test";
+
+const char* meminfo_sample = R"(MemTotal:       16318480 kB
+MemFree:         1015632 kB
+MemAvailable:    8159240 kB
+Buffers:          506224 kB
+Cached:          6555864 kB
+SwapCached:        18628 kB
+SwapTotal:       2097148 kB
+SwapFree:        1572860 kB
+)";
+
+const char* loadavg_sample = "0.52 1.58 2.59 2/1234 5678\n";
+
+const char* net_dev_sample =
+    R"(Inter-|   Receive                                                |  Transmit
+ face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed
+    lo: 1000000    1000    0    0    0     0          0         0  1000000    1000    0    0    0     0       0          0
+  eth0: 2000000    2000    1    2    0     0          0         0  3000000    3000    3    4    0     0       0          0
+)";
+
+const char* diskstats_sample =
+    R"(   7       0 loop0 100 0 200 10 0 0 0 0 0 20 10 0 0 0 0
+   8       0 sda 1000 10 20000 500 2000 20 40000 1000 0 1500 1500 0 0 0 0
+   8       1 sda1 900 10 18000 450 1900 20 38000 950 0 1400 1400 0 0 0 0
+)";
+
+const char* stat_sample = R"(cpu  4360186 24538 1560174 17996659 64169 0 93611 0 0 0
+cpu0 1089609 6082 396906 4497394 15269 0 11914 0 0 0
+cpu1 1082032 5818 391692 4456828 16624 0 72471 0 0 0
+intr 213853764 0 35 0 0 0
+ctxt 529237135
+)";
+
+static void write_file(const std::string_view& file_name,
+                       const char* content) {
+  std::ofstream f(absl::StrCat(test_proc_dir, file_name));
+  f.write(content, strlen(content));
+}
+
+class proc_sampler_test : public ::testing::Test {
+ public:
+  void SetUp() override {
+    std::filesystem::remove_all(test_proc_dir);
+    std::filesystem::create_directories(absl::StrCat(test_proc_dir, "/net"));
+    write_file("/stat", stat_sample);
+    write_file("/meminfo", meminfo_sample);
+    write_file("/loadavg", loadavg_sample);
+    write_file("/net/dev", net_dev_sample);
+    write_file("/diskstats", diskstats_sample);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(test_proc_dir); }
+};
+
+static check::completion_handler no_op_handler() {
+  return []([[maybe_unused]] const std::shared_ptr<check>& caller,
+            [[maybe_unused]] int status,
+            [[maybe_unused]] const std::list<com::centreon::common::perfdata>&
+                perfdata,
+            [[maybe_unused]] const std::list<std::string>& outputs) {};
+}
+
+TEST_F(proc_sampler_test, read_sample) {
+  proc_sampler sampler(test_proc_dir, std::chrono::seconds(1));
+  std::shared_ptr<const proc_sample> sample = sampler.get_sample();
+
+  for (unsigned file_index = 0; file_index < nb_proc_file; ++file_index) {
+    ASSERT_TRUE(sample->is_read(static_cast<e_proc_file>(file_index)));
+  }
+  ASSERT_EQ(sample->get_stat(), stat_sample);
+
+  const mem_info& mem = sample->get_mem_info();
+  ASSERT_EQ(mem.mem_total, 16318480ULL * 1024);
+  ASSERT_EQ(mem.mem_free, 1015632ULL * 1024);
+  ASSERT_EQ(mem.mem_available, 8159240ULL * 1024);
+  ASSERT_EQ(mem.buffers, 506224ULL * 1024);
+  ASSERT_EQ(mem.cached, 6555864ULL * 1024);
+  ASSERT_EQ(mem.swap_total, 2097148ULL * 1024);
+  ASSERT_EQ(mem.swap_free, 1572860ULL * 1024);
+
+  const load_avg& load = sample->get_load_avg();
+  ASSERT_DOUBLE_EQ(load.load1, 0.52);
+  ASSERT_DOUBLE_EQ(load.load5, 1.58);
+  ASSERT_DOUBLE_EQ(load.load15, 2.59);
+  ASSERT_EQ(load.running, 2);
+  ASSERT_EQ(load.total, 1234);
+
+  ASSERT_EQ(sample->get_net_devs().size(), 2);
+  const net_dev_stat& eth0 = sample->get_net_devs()[1];
+  ASSERT_EQ(eth0.name, "eth0");
+  ASSERT_EQ(eth0.rx_bytes, 2000000);
+  ASSERT_EQ(eth0.rx_packets, 2000);
+  ASSERT_EQ(eth0.rx_errors, 1);
+  ASSERT_EQ(eth0.rx_drops, 2);
+  ASSERT_EQ(eth0.tx_bytes, 3000000);
+  ASSERT_EQ(eth0.tx_packets, 3000);
+  ASSERT_EQ(eth0.tx_errors, 3);
+  ASSERT_EQ(eth0.tx_drops, 4);
+
+  ASSERT_EQ(sample->get_disks().size(), 3);
+  const disk_stat& sda = sample->get_disks()[1];
+  ASSERT_EQ(sda.name, "sda");
+  ASSERT_EQ(sda.reads, 1000);
+  ASSERT_EQ(sda.sectors_read, 20000);
+  ASSERT_EQ(sda.read_ms, 500);
+  ASSERT_EQ(sda.writes, 2000);
+  ASSERT_EQ(sda.sectors_written, 40000);
+  ASSERT_EQ(sda.write_ms, 1000);
+  ASSERT_EQ(sda.io_ms, 1500);
+
+  check_cpu_detail::proc_stat_file cpus(*sample, 2);
+  ASSERT_EQ(cpus.get_values().size(), 3);
+}
+
+TEST_F(proc_sampler_test, missing_file) {
+  std::filesystem::remove(absl::StrCat(test_proc_dir, "/diskstats"));
+  proc_sampler sampler(test_proc_dir, std::chrono::seconds(1));
+  std::shared_ptr<const proc_sample> sample = sampler.get_sample();
+  ASSERT_FALSE(sample->is_read(e_proc_file::diskstats));
+  ASSERT_TRUE(sample->is_read(e_proc_file::meminfo));
+  ASSERT_TRUE(sample->get_disks().empty());
+
+  rapidjson::Document check_args;
+  check_disk_io checker(g_io_context, spdlog::default_logger(), {}, {},
+                        "serv"s, "cmd_name"s, "cmd_line"s, check_args,
+                        nullptr, no_op_handler());
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  ASSERT_THROW(checker.compute(*sample, &output, &perfs), std::exception);
+}
+
+TEST_F(proc_sampler_test, sample_sharing_and_recycling) {
+  proc_sampler sampler(test_proc_dir, std::chrono::hours(1));
+  const proc_sample* first = sampler.get_sample().get();
+  // same tick => same sample
+  ASSERT_EQ(sampler.get_sample().get(), first);
+
+  // forced reading, the first sample is still the last one so it can't be
+  // reused
+  std::shared_ptr<const proc_sample> second =
+      sampler.get_sample(std::chrono::steady_clock::duration::zero());
+  ASSERT_NE(second.get(), first);
+
+  // nobody holds the first sample anymore, it's recycled
+  std::shared_ptr<const proc_sample> third =
+      sampler.get_sample(std::chrono::steady_clock::duration::zero());
+  ASSERT_EQ(third.get(), first);
+
+  // second is held, it can't be recycled
+  std::shared_ptr<const proc_sample> fourth =
+      sampler.get_sample(std::chrono::steady_clock::duration::zero());
+  ASSERT_NE(fourth.get(), second.get());
+  ASSERT_NE(fourth.get(), first);
+}
+
+TEST_F(proc_sampler_test, memory) {
+  proc_sampler sampler(test_proc_dir, std::chrono::seconds(1));
+  std::shared_ptr<const proc_sample> sample = sampler.get_sample();
+
+  rapidjson::Document check_args =
+      R"({"warning-usage-prct": 40, "critical-usage-prct": "60"})"_json;
+  check_memory checker(g_io_context, spdlog::default_logger(), {}, {},
+                       "serv"s, "cmd_name"s, "cmd_line"s, check_args, nullptr,
+                       no_op_handler(), false);
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*sample, &output, &perfs);
+  // (16318480 - 8159240) / 16318480 = 50%
+  ASSERT_EQ(status, e_status::warning);
+  ASSERT_EQ(output,
+            "WARNING: Ram total: 15.56 GB used: 7.78 GB (50.00%) free: 7.78 GB "
+            "(50.00%)");
+  ASSERT_EQ(perfs.size(), 3);
+  for (const auto& perf : perfs) {
+    if (perf.name() == "memory.usage.bytes") {
+      ASSERT_NEAR(perf.value(), 8159240.0 * 1024, 1000);
+      ASSERT_EQ(perf.unit(), "B");
+    } else if (perf.name() == "memory.free.bytes") {
+      ASSERT_NEAR(perf.value(), 8159240.0 * 1024, 1000);
+    } else if (perf.name() == "memory.usage.percentage") {
+      ASSERT_NEAR(perf.value(), 50, 0.01);
+      ASSERT_EQ(perf.warning(), 40);
+      ASSERT_EQ(perf.critical(), 60);
+    } else {
+      FAIL() << "unexpected perfdata name:" << perf.name();
+    }
+  }
+
+  check_memory swap_checker(g_io_context, spdlog::default_logger(), {}, {},
+                            "serv"s, "cmd_name"s, "cmd_line"s, check_args,
+                            nullptr, no_op_handler(), true);
+  output.clear();
+  perfs.clear();
+  status = swap_checker.compute(*sample, &output, &perfs);
+  // (2097148 - 1572860) / 2097148 = 25%
+  ASSERT_EQ(status, e_status::ok);
+  ASSERT_EQ(perfs.size(), 3);
+  ASSERT_EQ(perfs.front().name(), "swap.usage.bytes");
+}
+
+TEST_F(proc_sampler_test, load) {
+  proc_sampler sampler(test_proc_dir, std::chrono::seconds(1));
+  std::shared_ptr<const proc_sample> sample = sampler.get_sample();
+
+  rapidjson::Document check_args =
+      R"({"warning-load5": 1.5, "critical-load15": 2.5})"_json;
+  check_load checker(g_io_context, spdlog::default_logger(), {}, {}, "serv"s,
+                     "cmd_name"s, "cmd_line"s, check_args, nullptr,
+                     no_op_handler());
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*sample, &output, &perfs);
+  ASSERT_EQ(status, e_status::critical);
+  ASSERT_EQ(output, "CRITICAL: Load average: 0.52, 1.58, 2.59");
+  ASSERT_EQ(perfs.size(), 3);
+  ASSERT_EQ(perfs.back().name(), "load15");
+  ASSERT_EQ(perfs.back().critical(), 2.5f);
+}
+
+TEST_F(proc_sampler_test, network_traffic) {
+  proc_sampler sampler(test_proc_dir, std::chrono::seconds(1));
+
+  rapidjson::Document check_args = R"({"critical-in": 1})"_json;
+  check_network checker(g_io_context, spdlog::default_logger(), {}, {},
+                        "serv"s, "cmd_name"s, "cmd_line"s, check_args,
+                        nullptr, no_op_handler());
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*sampler.get_sample(), &output, &perfs);
+  ASSERT_EQ(status, e_status::ok);
+  ASSERT_EQ(output, "OK: Buffer creation...");
+  ASSERT_TRUE(perfs.empty());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  write_file("/net/dev",
+             R"(Inter-|   Receive                                                |  Transmit
+ face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed
+    lo: 2000000    1000    0    0    0     0          0         0  2000000    1000    0    0    0     0       0          0
+  eth0: 2001000    2000    1    2    0     0          0         0  3000000    3000    3    4    0     0       0          0
+)");
+  output.clear();
+  status = checker.compute(
+      *sampler.get_sample(std::chrono::steady_clock::duration::zero()),
+      &output, &perfs);
+  ASSERT_EQ(status, e_status::critical);
+  // lo is excluded by default
+  ASSERT_EQ(perfs.size(), 2);
+  ASSERT_EQ(perfs.front().name(), "eth0#traffic_in");
+  ASSERT_GT(perfs.front().value(), 0);
+  ASSERT_EQ(perfs.back().name(), "eth0#traffic_out");
+  ASSERT_EQ(perfs.back().value(), 0);
+  ASSERT_EQ(output.find("CRITICAL: Interface 'eth0' Traffic In: "), 0);
+}
+
+TEST_F(proc_sampler_test, disk_io) {
+  proc_sampler sampler(test_proc_dir, std::chrono::seconds(1));
+
+  rapidjson::Document check_args = R"({"filter-disk": "sd[a-z]"})"_json;
+  check_disk_io checker(g_io_context, spdlog::default_logger(), {}, {},
+                        "serv"s, "cmd_name"s, "cmd_line"s, check_args,
+                        nullptr, no_op_handler());
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*sampler.get_sample(), &output, &perfs);
+  ASSERT_EQ(status, e_status::ok);
+  ASSERT_EQ(output, "OK: Buffer creation...");
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  write_file("/diskstats",
+             R"(   7       0 loop0 100 0 200 10 0 0 0 0 0 20 10 0 0 0 0
+   8       0 sda 1000 10 21000 500 2000 20 40000 1000 0 1501 1500 0 0 0 0
+   8       1 sda1 900 10 19000 450 1900 20 38000 950 0 1401 1400 0 0 0 0
+)");
+  output.clear();
+  status = checker.compute(
+      *sampler.get_sample(std::chrono::steady_clock::duration::zero()),
+      &output, &perfs);
+  ASSERT_EQ(status, e_status::ok);
+  // only sda matches the filter
+  ASSERT_EQ(perfs.size(), 3);
+  ASSERT_EQ(perfs.front().name(), "sda#read");
+  ASSERT_GT(perfs.front().value(), 0);
+  ASSERT_EQ(output.find("OK: Disk 'sda' Read: "), 0);
+}
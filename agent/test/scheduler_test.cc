@@ -378,6 +378,91 @@ TEST_F(scheduler_test, correct_output_examplar) {
   sched->stop();
 }
 
+TEST_F(scheduler_test, reuse_export_request) {
+  std::mutex m;
+  std::condition_variable export_cond;
+  std::vector<const MessageFromAgent*> exported;
+  bool resources_ok = true;
+  std::shared_ptr<scheduler> sched = scheduler::load(
+      g_io_context, spdlog::default_logger(), "my_host",
+      create_conf(2, 1, 1, 10, 1),
+      [&](const std::shared_ptr<MessageFromAgent>& req) {
+        std::lock_guard l(m);
+        for (const auto& res : req->otel_request().resource_metrics()) {
+          if (res.resource().attributes_size() != 2 ||
+              res.resource().attributes(0).value().string_value() !=
+                  "my_host" ||
+              res.scope_metrics(0).metrics_size() != 5) {
+            resources_ok = false;
+          }
+          for (const auto& metric : res.scope_metrics(0).metrics()) {
+            if (metric.gauge().data_points_size() < 1) {
+              resources_ok = false;
+            }
+          }
+        }
+        // req is released at the end of this call, so it can be reused
+        exported.push_back(req.get());
+        export_cond.notify_all();
+      },
+      [](const std::shared_ptr<asio::io_context>& io_context,
+         const std::shared_ptr<spdlog::logger>& logger,
+         time_point start_expected, duration check_interval,
+         const std::string& service, const std::string& cmd_name,
+         const std::string& cmd_line,
+         const engine_to_agent_request_ptr& engine_to_agent_request,
+         check::completion_handler&& handler) {
+        return std::make_shared<tempo_check>(
+            io_context, logger, start_expected, check_interval, service,
+            cmd_name, cmd_line, engine_to_agent_request, 0,
+            std::chrono::milliseconds(10), std::move(handler));
+      });
+
+  std::unique_lock l(m);
+  export_cond.wait_for(l, std::chrono::seconds(10),
+                       [&exported]() { return exported.size() >= 4; });
+  sched->stop();
+
+  ASSERT_GE(exported.size(), 4);
+  ASSERT_TRUE(resources_ok);
+  // two requests are used alternately
+  ASSERT_NE(exported[0], exported[1]);
+  ASSERT_EQ(exported[0], exported[2]);
+  ASSERT_EQ(exported[1], exported[3]);
+}
+
+TEST_F(scheduler_test, delta_export) {
+  std::mutex m;
+  unsigned nb_exported_results = 0;
+  auto conf = create_conf(2, 1, 1, 10, 1);
+  conf->mutable_config()->set_delta_export_max_period(60);
+  std::shared_ptr<scheduler> sched = scheduler::load(
+      g_io_context, spdlog::default_logger(), "my_host", conf,
+      [&](const std::shared_ptr<MessageFromAgent>& req) {
+        std::lock_guard l(m);
+        nb_exported_results += req->otel_request().resource_metrics_size();
+      },
+      [](const std::shared_ptr<asio::io_context>& io_context,
+         const std::shared_ptr<spdlog::logger>& logger,
+         time_point start_expected, duration check_interval,
+         const std::string& service, const std::string& cmd_name,
+         const std::string& cmd_line,
+         const engine_to_agent_request_ptr& engine_to_agent_request,
+         check::completion_handler&& handler) {
+        return std::make_shared<tempo_check>(
+            io_context, logger, start_expected, check_interval, service,
+            cmd_name, cmd_line, engine_to_agent_request, 0,
+            std::chrono::milliseconds(10), std::move(handler));
+      });
+
+  // tempo_check results never change, so each service is exported once
+  std::this_thread::sleep_for(std::chrono::milliseconds(4500));
+  sched->stop();
+
+  std::lock_guard l(m);
+  ASSERT_EQ(nb_exported_results, 2);
+}
+
 class concurent_check : public check {
   asio::system_timer _completion_timer;
   int _command_exit_status;
@@ -19,6 +19,8 @@
 #ifndef CCB_BAM_AVAILABILITY_THREAD_HH
 #define CCB_BAM_AVAILABILITY_THREAD_HH
 
+#include <nlohmann/json.hpp>
+
 #include "com/centreon/broker/bam/availability_builder.hh"
 #include "com/centreon/broker/bam/timeperiod_map.hh"
 #include "com/centreon/broker/io/data.hh"
@@ -37,6 +39,9 @@ namespace bam {
  * "com/centreon/broker/bam/availability_thread.hh"
  *  @brief Availability thread
  *
+ *  Every night, the availabilities of the previous days are computed from
+ *  the BA events. Each day, BAs are shared between as many workers as the
+ *  database has connections, each worker uses its own connection.
  */
 class availability_thread final {
  public:
@@ -56,18 +61,16 @@ class availability_thread final {
 
   void rebuild_availabilities(std::string const& bas_to_rebuild);
   void wait();
+  void statistics(nlohmann::json& tree) const;
 
  private:
   void _delete_all_availabilities();
   void _build_availabilities(time_t midnight);
-  void _build_daily_availabilities(int thread_id,
-                                   time_t day_start,
-                                   time_t day_end);
-  void _write_availability(int thread_id,
-                           availability_builder const& builder,
-                           uint32_t ba_id,
-                           time_t day_start,
-                           uint32_t timeperiod_id);
+  void _build_daily_availabilities(time_t day_start, time_t day_end);
+  void _build_partition(int worker,
+                        int workers_count,
+                        time_t day_start,
+                        time_t day_end);
 
   time_t _compute_next_midnight();
   void _open_database();
@@ -88,6 +91,14 @@ class availability_thread final {
   std::string _bas_to_rebuild;
   std::condition_variable _wait;
 
+  /* Progress of the current (or last) build, read by statistics() */
+  std::atomic<time_t> _build_start;
+  std::atomic<time_t> _build_end;
+  std::atomic_uint32_t _days_to_build;
+  std::atomic_uint32_t _days_built;
+  std::atomic_uint64_t _events_read;
+  std::atomic_uint64_t _availabilities_written;
+
   /* Logger */
   std::shared_ptr<spdlog::logger> _logger;
 };
@@ -43,6 +43,7 @@ class bool_and : public bool_binary_operator {
   bool_and& operator=(const bool_and&) = delete;
   double value_hard() const override;
   bool boolean_value() const override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
 };
 }  // namespace com::centreon::broker::bam
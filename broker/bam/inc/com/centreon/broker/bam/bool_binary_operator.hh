@@ -38,6 +38,8 @@ class bool_binary_operator : public bool_value {
   std::shared_ptr<bool_value> _right;
   double _left_hard = 0;
   double _right_hard = 0;
+  bool _left_downtime = false;
+  bool _right_downtime = false;
   bool _in_downtime = false;
   bool _state_known = false;
 
@@ -44,6 +44,7 @@ class bool_constant : public bool_value {
   bool boolean_value() const override;
   bool state_known() const override;
   void update_from(computable* child, io::stream* visitor) override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
   void dump(std::ofstream& output) const override;
 };
@@ -26,6 +26,7 @@
 
 namespace com::centreon::broker::bam {
 // Forward declaration.
+class bool_program;
 class bool_value;
 
 /**
@@ -35,23 +36,30 @@ class bool_value;
  *
  *  Stores and entire boolean expression made of multiple boolean
  *  operations and evaluate them to match the kpi interface.
+ *
+ *  Once compiled, the expression is evaluated by a bool_program and the
+ *  services of the tree notify it directly.
  */
-class bool_expression : public computable {
+class bool_expression : public computable,
+                        public std::enable_shared_from_this<bool_expression> {
   const uint32_t _id;
   const bool _impact_if;
   std::shared_ptr<bool_value> _expression;
+  std::unique_ptr<bool_program> _program;
 
  public:
   bool_expression(uint32_t id,
                   bool impact_if,
                   const std::shared_ptr<spdlog::logger>& logger);
   bool_expression(const bool_expression&) = delete;
-  ~bool_expression() noexcept override = default;
+  ~bool_expression() noexcept override;
   bool_expression& operator=(const bool_expression&) = delete;
   state get_state() const;
   bool state_known() const;
   void set_expression(std::shared_ptr<bool_value> const& expression);
   std::shared_ptr<bool_value> get_expression() const;
+  bool compile();
+  const bool_program* program() const;
   bool in_downtime() const;
   uint32_t get_id() const;
   void update_from(computable* child, io::stream* visitor) override;
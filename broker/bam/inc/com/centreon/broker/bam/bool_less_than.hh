@@ -40,6 +40,7 @@ class bool_less_than : public bool_binary_operator {
   bool_less_than& operator=(const bool_less_than&) = delete;
   double value_hard() const override;
   bool boolean_value() const override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
 };
 }  // namespace com::centreon::broker::bam
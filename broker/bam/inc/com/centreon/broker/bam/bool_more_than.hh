@@ -39,6 +39,7 @@ class bool_more_than : public bool_binary_operator {
   bool_more_than& operator=(const bool_more_than&) = delete;
   double value_hard() const override;
   bool boolean_value() const override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
 };
 }  // namespace com::centreon::broker::bam
@@ -48,6 +48,7 @@ class bool_not : public bool_value {
   bool state_known() const override;
   bool in_downtime() const override;
   void update_from(computable* child, io::stream* visitor) override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
   void dump(std::ofstream& output) const override;
 };
@@ -39,6 +39,7 @@ class bool_not_equal : public bool_binary_operator {
   bool_not_equal& operator=(const bool_not_equal&) = delete;
   double value_hard() const override;
   bool boolean_value() const override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
 };
 }  // namespace com::centreon::broker::bam
@@ -49,6 +49,7 @@ class bool_operation : public bool_binary_operator {
   double value_hard() const override;
   bool boolean_value() const override;
   bool state_known() const override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
 };
 }  // namespace com::centreon::broker::bam
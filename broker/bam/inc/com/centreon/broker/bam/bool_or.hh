@@ -44,6 +44,7 @@ class bool_or : public bool_binary_operator {
   bool_or& operator=(const bool_or&) = delete;
   double value_hard() const override;
   bool boolean_value() const override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
 };
 
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_BAM_BOOL_PROGRAM_HH
+#define CCB_BAM_BOOL_PROGRAM_HH
+
+#include "com/centreon/broker/bam/bool_value.hh"
+
+namespace com::centreon::broker::bam {
+/**
+ *  @class bool_program bool_program.hh
+ * "com/centreon/broker/bam/bool_program.hh"
+ *  @brief Boolean expression compiled into a postfix program.
+ *
+ *  The tree of bool_value built by exp_builder is flattened into a list of
+ *  instructions executed on a stack. Operands (services and constants) are
+ *  slots of the program, a service update only refreshes its slot before the
+ *  program is run again.
+ *
+ *  The program reproduces the tree exactly: each binary operator keeps the
+ *  state of its node (values and downtimes of the operands seen the last
+ *  time both were known, raw known flag, value of AND and OR). It is only
+ *  recomputed when its changed operand passes the test of
+ *  bool_binary_operator::update_from(), otherwise its value is read from its
+ *  state. A service in both operands of an operator is two operands of the
+ *  program, updated one after the other as the tree does.
+ */
+class bool_program {
+ public:
+  enum op_code : uint8_t {
+    load,
+    not_op,
+    and_op,
+    or_op,
+    xor_op,
+    equal,
+    not_equal,
+    less_than,
+    less_equal,
+    more_than,
+    more_equal,
+    addition,
+    substraction,
+    multiplication,
+    division,
+    modulo
+  };
+
+  struct value {
+    double hard;
+    bool boolean;
+    bool known;
+    bool downtime;
+  };
+
+  /* The values kept by a binary operator, as the attributes of
+   * bool_binary_operator, boolean is the value of AND and OR. */
+  struct operator_state {
+    double left_hard;
+    double right_hard;
+    bool left_downtime;
+    bool right_downtime;
+    bool known;
+    bool boolean;
+  };
+
+ private:
+  struct instruction {
+    op_code code;
+    uint32_t arg;
+  };
+
+  /* A value on the stack, changed if its node would notify its parents. */
+  struct entry {
+    value val;
+    bool changed;
+  };
+
+  std::vector<instruction> _code;
+  std::vector<value> _slots;
+  /* One per binary operator, it is the argument of its instruction. */
+  std::vector<operator_state> _states;
+  /* Operands that can change, with their slot */
+  std::vector<bool_value*> _operands;
+  std::vector<uint32_t> _operand_slots;
+  absl::flat_hash_map<const computable*, uint32_t> _operand_index;
+  std::vector<entry> _stack;
+  value _result;
+
+  static value _read(const bool_value& operand);
+  bool _run(uint32_t changed_slot);
+
+ public:
+  bool_program();
+  ~bool_program() noexcept = default;
+  bool_program(const bool_program&) = delete;
+  bool_program& operator=(const bool_program&) = delete;
+
+  static std::unique_ptr<bool_program> compile(bool_value& tree);
+
+  void emit_operand(bool_value* operand);
+  void emit_constant(double constant);
+  void emit(op_code code);
+  bool emit_binary(const std::shared_ptr<bool_value>& left,
+                   const std::shared_ptr<bool_value>& right,
+                   op_code code,
+                   const operator_state& state);
+
+  bool update(const computable* child);
+  const value& result() const { return _result; }
+  const std::vector<bool_value*>& operands() const { return _operands; }
+  size_t size() const { return _code.size(); }
+};
+}  // namespace com::centreon::broker::bam
+
+#endif  // !CCB_BAM_BOOL_PROGRAM_HH
@@ -22,6 +22,8 @@
 #include "com/centreon/broker/bam/computable.hh"
 
 namespace com::centreon::broker::bam {
+class bool_program;
+
 /**
  *  @class bool_value bool_value.hh "com/centreon/broker/bam/bool_value.hh"
  *  @brief Computable boolean value.
@@ -41,6 +43,7 @@ class bool_value : public computable {
   virtual bool boolean_value() const = 0;
   virtual bool state_known() const = 0;
   virtual bool in_downtime() const;
+  virtual bool compile(bool_program& program);
 };
 }  // namespace com::centreon::broker::bam
 
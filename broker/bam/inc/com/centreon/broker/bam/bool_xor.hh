@@ -38,6 +38,7 @@ class bool_xor : public bool_binary_operator {
   bool_xor& operator=(const bool_xor&) = delete;
   double value_hard() const override;
   bool boolean_value() const override;
+  bool compile(bool_program& program) override;
   std::string object_info() const override;
 };
 }  // namespace com::centreon::broker::bam
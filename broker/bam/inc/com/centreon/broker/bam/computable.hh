@@ -52,6 +52,7 @@ class computable {
    */
   virtual void update_from(computable* child, io::stream* visitor) = 0;
   void remove_parent(const std::shared_ptr<computable>& parent);
+  void clear_parents();
   /**
    * @brief This method is used by the dump() method. It gives a summary of this
    * computable main informations.
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_BAM_DAILY_AVAILABILITIES_HH
+#define CCB_BAM_DAILY_AVAILABILITIES_HH
+
+#include "com/centreon/broker/bam/availability_builder.hh"
+#include "com/centreon/broker/bam/timeperiod_map.hh"
+
+namespace com::centreon::broker::bam {
+/**
+ *  @class daily_availabilities daily_availabilities.hh
+ * "com/centreon/broker/bam/daily_availabilities.hh"
+ *  @brief Build the availabilities of a day for a set of BAs.
+ *
+ *  Opened events (events without end time) are all given first, they are
+ *  kept until their BA is completed. Then closed events are given ordered by
+ *  BA id: when the BA id changes, the availabilities of the previous BA (and
+ *  of the BAs with only opened events before the new one) are complete, they
+ *  are given to the writer and their builders are released. So only the
+ *  builders of one BA are alive at a time.
+ */
+class daily_availabilities {
+ public:
+  using writer = std::function<void(uint32_t ba_id,
+                                    uint32_t timeperiod_id,
+                                    const availability_builder& builder)>;
+
+ private:
+  struct opened_event {
+    short status;
+    time_t start;
+    bool in_downtime;
+  };
+
+  const time_t _day_start;
+  const time_t _day_end;
+  const timeperiod_map& _tps;
+  const writer _writer;
+
+  uint32_t _current_ba;
+  std::map<uint32_t, std::unique_ptr<availability_builder>> _builders;
+  std::map<uint32_t, std::vector<opened_event>> _opened;
+
+  uint64_t _events_count;
+  uint64_t _availabilities_count;
+
+  std::shared_ptr<spdlog::logger> _logger;
+
+  availability_builder& _get_builder(uint32_t timeperiod_id);
+  void _complete_ba(uint32_t ba_id);
+  void _complete_until(uint32_t ba_id);
+
+ public:
+  daily_availabilities(time_t day_start,
+                       time_t day_end,
+                       const timeperiod_map& tps,
+                       const writer& w,
+                       const std::shared_ptr<spdlog::logger>& logger);
+  ~daily_availabilities() noexcept = default;
+  daily_availabilities(const daily_availabilities&) = delete;
+  daily_availabilities& operator=(const daily_availabilities&) = delete;
+
+  void add_opened_event(uint32_t ba_id,
+                        short status,
+                        time_t start,
+                        bool in_downtime);
+  void add_closed_event(uint32_t ba_id,
+                        uint32_t timeperiod_id,
+                        bool timeperiod_is_default,
+                        short status,
+                        time_t start,
+                        time_t end,
+                        bool in_downtime);
+  void finish();
+
+  uint64_t events_count() const { return _events_count; }
+  uint64_t availabilities_count() const { return _availabilities_count; }
+};
+}  // namespace com::centreon::broker::bam
+
+#endif  // !CCB_BAM_DAILY_AVAILABILITIES_HH
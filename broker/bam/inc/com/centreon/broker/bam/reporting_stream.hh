@@ -45,6 +45,10 @@ class dimension_timeperiod;
  *  metrics table of a centbam DB.
  */
 class reporting_stream : public io::stream {
+  /* Events, their updates and their durations are all written on this
+   * connection, so they are executed in the order they are sent. */
+  static constexpr int _events_thread_id = 0;
+
   uint32_t _ack_events;
   uint32_t _pending_events;
   uint32_t _queries_per_transaction;
@@ -53,7 +57,8 @@ class reporting_stream : public io::stream {
   uint32_t _transaction_queries;
   mysql _mysql;
   database::mysql_stmt _ba_full_event_insert;
-  database::mysql_stmt _ba_event_update;
+  std::unique_ptr<database::bulk_or_multi> _ba_event_update;
+  std::unique_ptr<database::bulk_or_multi> _ba_duration_event_upsert;
   database::mysql_stmt _ba_duration_event_insert;
   database::mysql_stmt _ba_duration_event_update;
   database::mysql_stmt _kpi_full_event_insert;
@@ -85,6 +90,17 @@ class reporting_stream : public io::stream {
   id_start_to_event_id _ba_event_cache;
   id_start_to_event_id _kpi_event_cache;
 
+  /* BAs with an update of one of their events waiting in _ba_event_update */
+  absl::flat_hash_set<uint32_t> _ba_event_pending_updates;
+
+  /* Rows written in the events tables, read by statistics() */
+  std::atomic_uint64_t _ba_event_rows;
+  std::atomic_uint64_t _ba_duration_rows;
+  std::atomic_uint64_t _kpi_event_rows;
+  std::atomic<double> _rows_per_second;
+  uint64_t _last_commit_rows;
+  std::chrono::steady_clock::time_point _last_commit;
+
   /* Logger */
   std::shared_ptr<spdlog::logger> _logger;
 
@@ -110,6 +126,23 @@ class reporting_stream : public io::stream {
   void _load_kpi_ba_events();
   void _prepare();
   void _commit();
+  void _execute_batches();
+  bool _batches_ready();
+  void _update_ba_event(uint32_t ba_event_id,
+                        uint32_t ba_id,
+                        uint64_t start_time,
+                        int64_t end_time,
+                        int32_t first_level,
+                        char status,
+                        bool in_downtime);
+  void _write_ba_duration(uint32_t ba_id,
+                          uint64_t real_start_time,
+                          uint32_t timeperiod_id,
+                          uint64_t start_time,
+                          uint64_t end_time,
+                          int32_t duration,
+                          int32_t sla_duration,
+                          bool timeperiod_is_default);
   void _process_ba_event(std::shared_ptr<io::data> const& e);
   void _process_pb_ba_event(std::shared_ptr<io::data> const& e);
   void _process_ba_duration_event(std::shared_ptr<io::data> const& e);
@@ -18,14 +18,20 @@
 
 #include "com/centreon/broker/bam/availability_thread.hh"
 
+#include "com/centreon/broker/bam/daily_availabilities.hh"
 #include "com/centreon/broker/misc/time.hh"
 #include "com/centreon/broker/sql/mysql_error.hh"
+#include "com/centreon/broker/sql/mysql_multi_insert.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 using namespace com::centreon::exceptions;
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::bam;
 
+/* Availabilities are sent to the database as soon as their BA is complete
+ * and at least this number of rows are waiting. */
+static constexpr uint32_t availabilities_batch_size = 1000;
+
 /**
  *  Constructor.
  *
@@ -43,6 +49,12 @@ availability_thread::availability_thread(
       _mutex{},
       _should_exit(false),
       _should_rebuild_all(false),
+      _build_start{0},
+      _build_end{0},
+      _days_to_build{0},
+      _days_built{0},
+      _events_read{0},
+      _availabilities_written{0},
       _logger{logger} {}
 
 /**
@@ -176,7 +188,6 @@ void availability_thread::_build_availabilities(time_t midnight) {
   time_t first_day = 0;
   time_t last_day = midnight;
   std::string query_str;
-  int thread_id;
 
   // Get the first day of rebuilding. If a complete rebuilding was asked,
   // it's the day of the chronogically first event to rebuild.
@@ -189,8 +200,7 @@ void availability_thread::_build_availabilities(time_t midnight) {
     try {
       std::promise<database::mysql_result> promise;
       std::future<database::mysql_result> future = promise.get_future();
-      thread_id =
-          _mysql->run_query_and_get_result(query_str, std::move(promise));
+      _mysql->run_query_and_get_result(query_str, std::move(promise));
       database::mysql_result res(future.get());
       if (!_mysql->fetch_row(res))
         throw msg_fmt("no events matching BAs to rebuild");
@@ -218,8 +228,7 @@ void availability_thread::_build_availabilities(time_t midnight) {
     try {
       std::promise<database::mysql_result> promise;
       std::future<database::mysql_result> future = promise.get_future();
-      thread_id =
-          _mysql->run_query_and_get_result(query_str, std::move(promise));
+      _mysql->run_query_and_get_result(query_str, std::move(promise));
       database::mysql_result res(future.get());
       if (!_mysql->fetch_row(res)) {
         _logger->error("no availability in table");
@@ -242,189 +251,217 @@ void availability_thread::_build_availabilities(time_t midnight) {
       "BAM-BI: availability thread writing availabilities from: {} to {}",
       first_day, last_day);
 
+  _days_to_build = first_day < last_day
+                       ? (last_day - first_day + 3600 * 12) / (3600 * 24)
+                       : 0;
+  _days_built = 0;
+  _events_read = 0;
+  _availabilities_written = 0;
+  _build_end = 0;
+  _build_start = ::time(nullptr);
+
   // Write the availabilities day after day.
   while (first_day < last_day) {
     time_t next_day =
         time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
-    _build_daily_availabilities(thread_id, first_day, next_day);
+    _build_daily_availabilities(first_day, next_day);
     first_day = next_day;
   }
+  _build_end = ::time(nullptr);
 }
 
 /**
  *  @brief  Build all the availabilities of a day.
  *
- *  This is called from the context of the availability thread.
+ *  This is called from the context of the availability thread. BAs are
+ *  partitioned by their id between one worker per database connection.
  *
- *  @param[in] q         A SQL query object.
  *  @param[in] day_start The start of the day.
  *  @param[in] day_end   The first second of the next day.
  */
-void availability_thread::_build_daily_availabilities(int thread_id,
-                                                      time_t day_start,
+void availability_thread::_build_daily_availabilities(time_t day_start,
                                                       time_t day_end) {
   _logger->info(
       "BAM-BI: availability thread writing daily availability for day : {}-{}",
       day_start, day_end);
 
-  // Build the availabilities tied to event durations (event finished)
-  std::string query(fmt::format(
-      "SELECT a.ba_event_id, b.ba_id, a.start_time, a.end_time, a.duration, "
-      "a.sla_duration, a.timeperiod_id, a.timeperiod_is_default, b.status, "
-      "b.in_downtime FROM mod_bam_reporting_ba_events_durations AS a INNER "
-      "JOIN mod_bam_reporting_ba_events AS b ON a.ba_event_id=b.ba_event_id "
-      "AND b.end_time IS NOT NULL WHERE a.start_time<{} AND a.end_time>={} "
-      "{}",
-      day_end, day_start,
-      _should_rebuild_all ? fmt::format("AND b.ba_id IN({})", _bas_to_rebuild)
-                          : ""));
+  int workers_count = _mysql->connections_count();
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors(workers_count);
+  workers.reserve(workers_count);
+  for (int i = 0; i < workers_count; ++i) {
+    workers.emplace_back([this, i, workers_count, day_start, day_end,
+                          &errors] {
+      try {
+        _build_partition(i, workers_count, day_start, day_end);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+    pthread_setname_np(workers.back().native_handle(),
+                       fmt::format("bam_avail_{}", i).c_str());
+  }
+  for (auto& w : workers)
+    w.join();
+  for (auto& e : errors)
+    if (e)
+      std::rethrow_exception(e);
+
+  ++_days_built;
+  double elapsed = std::max<double>(::time(nullptr) - _build_start, 1);
+  _logger->info(
+      "BAM-BI: availability thread built {}/{} days, {} events read, {} "
+      "availabilities written ({:.0f} events/s)",
+      _days_built.load(), _days_to_build.load(), _events_read.load(),
+      _availabilities_written.load(), _events_read / elapsed);
+}
 
+/**
+ *  @brief  Build the availabilities of a day for the BAs such that
+ *  ba_id % workers_count = worker.
+ *
+ *  Events are read ordered by BA so that availabilities are written as soon
+ *  as their BA is complete. They are inserted with multi-rows queries on the
+ *  connection of the worker, a query is sent each time a BA is complete and
+ *  availabilities_batch_size rows are waiting, so only one batch of rows is
+ *  kept in memory.
+ *
+ *  @param[in] worker         The index of the worker and of its connection.
+ *  @param[in] workers_count  The number of workers.
+ *  @param[in] day_start      The start of the day.
+ *  @param[in] day_end        The first second of the next day.
+ */
+void availability_thread::_build_partition(int worker,
+                                           int workers_count,
+                                           time_t day_start,
+                                           time_t day_end) {
+  auto filter = [&](const char* table) {
+    std::string retval;
+    if (_should_rebuild_all)
+      retval = fmt::format(" AND {}ba_id IN ({})", table, _bas_to_rebuild);
+    if (workers_count > 1)
+      retval += fmt::format(" AND {}ba_id % {} = {}", table, workers_count,
+                            worker);
+    return retval;
+  };
+
+  database::mysql_multi_insert availabilities(
+      "INSERT INTO mod_bam_reporting_ba_availabilities "
+      "(ba_id, time_id, timeperiod_id, timeperiod_is_default,"
+      " available, unavailable, degraded,"
+      " unknown, downtime, alert_unavailable_opened,"
+      " alert_degraded_opened, alert_unknown_opened,"
+      " nb_downtime) VALUES",
+      "");
+  uint32_t last_ba_id = 0;
+  uint32_t waiting_rows = 0;
+  auto write_availabilities = [&] {
+    availabilities.execute_queries(
+        *_mysql, database::mysql_error::insert_availability, worker);
+    availabilities.clear_queries();
+    _availabilities_written += waiting_rows;
+    waiting_rows = 0;
+  };
+  daily_availabilities day(
+      day_start, day_end, _shared_tps,
+      [&](uint32_t ba_id, uint32_t timeperiod_id,
+          const availability_builder& builder) {
+        /* The previous BA is complete. */
+        if (ba_id != last_ba_id) {
+          if (waiting_rows >= availabilities_batch_size)
+            write_availabilities();
+          last_ba_id = ba_id;
+        }
+        ++waiting_rows;
+        availabilities.push(fmt::format(
+            "({},{},{},{},{},{},{},{},{},{},{},{},{})", ba_id, day_start,
+            timeperiod_id, builder.get_timeperiod_is_default(),
+            builder.get_available(), builder.get_unavailable(),
+            builder.get_degraded(), builder.get_unknown(),
+            builder.get_downtime(), builder.get_unavailable_opened(),
+            builder.get_degraded_opened(), builder.get_unknown_opened(),
+            builder.get_downtime_opened()));
+      },
+      _logger);
+
+  // The events not finished yet.
+  std::string query(fmt::format(
+      "SELECT ba_event_id,ba_id,start_time,end_time,status,"
+      "in_downtime FROM mod_bam_reporting_ba_events WHERE start_time<{} AND "
+      "end_time IS NULL{}",
+      day_end, filter("")));
   _logger->debug("Query: {}", query);
-  std::promise<database::mysql_result> promise;
-  std::future<database::mysql_result> future = promise.get_future();
-  _mysql->run_query_and_get_result(query, std::move(promise), thread_id);
-
-  // Create a builder for each ba_id and associated timeperiod_id.
-  std::map<std::pair<uint32_t, uint32_t>, std::unique_ptr<availability_builder>>
-      builders;
   try {
+    std::promise<database::mysql_result> promise;
+    std::future<database::mysql_result> future = promise.get_future();
+    _mysql->run_query_and_get_result(query, std::move(promise), worker);
     database::mysql_result res(future.get());
-    while (_mysql->fetch_row(res)) {
-      uint32_t ba_id = res.value_as_i32(1);
-      uint32_t timeperiod_id = res.value_as_i32(6);
-      // Find the timeperiod.
-      time::timeperiod::ptr tp = _shared_tps.get_timeperiod(timeperiod_id);
-      // No timeperiod found, skip.
-      if (!tp) {
-        _logger->debug("no timeperiod found with id {}", timeperiod_id);
-        continue;
-      }
-      // Find the builder.
-      auto found = builders.find({ba_id, timeperiod_id});
-      // No builders found, create one.
-      if (found == builders.end()) {
-        _logger->debug("adding new builder for ba id {} and timeperiod id {}",
-                       ba_id, timeperiod_id);
-        found = builders
-                    .insert(std::make_pair(
-                        std::make_pair(ba_id, timeperiod_id),
-                        std::unique_ptr<availability_builder>(
-                            new availability_builder(day_end, day_start))))
-                    .first;
-      }
-      // Add the event to the builder.
-      found->second->add_event(res.value_as_i32(8),   // Status
-                               res.value_as_i32(2),   // Start time
-                               res.value_as_i32(3),   // End time
-                               res.value_as_bool(9),  // Was in downtime
-                               tp, _logger);
-      // Add the timeperiod is default flag.
-      found->second->set_timeperiod_is_default(res.value_as_bool(7));
-    }
+    while (_mysql->fetch_row(res))
+      day.add_opened_event(res.value_as_i32(1),   // BA id
+                           res.value_as_i32(4),   // Status
+                           res.value_as_i32(2),   // Start time
+                           res.value_as_bool(5));  // Was in downtime
   } catch (const std::exception& e) {
-    throw msg_fmt("BAM-BI: availability thread could not build the data {}",
+    throw msg_fmt("BAM-BI: availability thread could not build the data: {}",
                   e.what());
   }
 
-  _logger->debug("{} builders of availabilities created", builders.size());
-
-  // Build the availabilities tied to event not finished.
+  // The availabilities tied to event durations (event finished)
   query = fmt::format(
-      "SELECT ba_event_id,ba_id,start_time,end_time,status,"
-      "in_downtime FROM mod_bam_reporting_ba_events WHERE start_time<{} AND "
-      "end_time IS NULL {}",
-      day_end,
-      _should_rebuild_all ? fmt::format("AND ba_id IN ({})", _bas_to_rebuild)
-                          : "");
+      "SELECT a.ba_event_id, b.ba_id, a.start_time, a.end_time, a.duration, "
+      "a.sla_duration, a.timeperiod_id, a.timeperiod_is_default, b.status, "
+      "b.in_downtime FROM mod_bam_reporting_ba_events_durations AS a INNER "
+      "JOIN mod_bam_reporting_ba_events AS b ON a.ba_event_id=b.ba_event_id "
+      "AND b.end_time IS NOT NULL WHERE a.start_time<{} AND a.end_time>={}{} "
+      "ORDER BY b.ba_id",
+      day_end, day_start, filter("b."));
   _logger->debug("Query: {}", query);
-
-  std::promise<database::mysql_result> promise_ba;
-  std::future<database::mysql_result> future_ba = promise_ba.get_future();
-  _mysql->run_query_and_get_result(query, std::move(promise_ba), thread_id);
-
   try {
-    database::mysql_result res(future_ba.get());
-    while (_mysql->fetch_row(res)) {
-      uint32_t ba_id = res.value_as_i32(1);
-      // Get all the timeperiods associated with the ba of this event.
-      std::vector<std::pair<time::timeperiod::ptr, bool>> tps =
-          _shared_tps.get_timeperiods_by_ba_id(ba_id);
-      int count = 0;
-      for (auto it = tps.begin(), end = tps.end(); it != end; ++it) {
-        uint32_t tp_id = it->first->get_id();
-        // Find the builder.
-        auto found = builders.find(std::make_pair(ba_id, tp_id));
-        // No builders found, create one.
-        if (found == builders.end()) {
-          found = builders
-                      .insert(std::make_pair(
-                          std::make_pair(ba_id, tp_id),
-                          std::unique_ptr<availability_builder>(
-                              new availability_builder(day_end, day_start))))
-                      .first;
-          count++;
-        }
-        // Add the event to the builder.
-        found->second->add_event(res.value_as_i32(4),   // Status
-                                 res.value_as_i32(2),   // Start time
-                                 res.value_as_i32(3),   // End time
-                                 res.value_as_bool(5),  // Was in downtime
-                                 it->first, _logger);
-        // Add the timeperiod is default flag.
-        found->second->set_timeperiod_is_default(it->second);
-      }
-      _logger->debug("{} builder(s) were missing for ba {}", count, ba_id);
-    }
+    std::promise<database::mysql_result> promise;
+    std::future<database::mysql_result> future = promise.get_future();
+    _mysql->run_query_and_get_result(query, std::move(promise), worker);
+    database::mysql_result res(future.get());
+    while (_mysql->fetch_row(res))
+      day.add_closed_event(res.value_as_i32(1),   // BA id
+                           res.value_as_i32(6),   // Timeperiod id
+                           res.value_as_bool(7),  // Timeperiod is default
+                           res.value_as_i32(8),   // Status
+                           res.value_as_i32(2),   // Start time
+                           res.value_as_i32(3),   // End time
+                           res.value_as_bool(9));  // Was in downtime
+    day.finish();
   } catch (const std::exception& e) {
-    throw msg_fmt("BAM-BI: availability thread could not build the data: {}",
+    throw msg_fmt("BAM-BI: availability thread could not build the data {}",
                   e.what());
   }
 
-  _logger->debug("{} builder(s) to write availabilities", builders.size());
-  // For each builder, write the availabilities.
-  for (auto it = builders.begin(), end = builders.end(); it != end; ++it)
-    _write_availability(thread_id, *it->second, it->first.first, day_start,
-                        it->first.second);
+  write_availabilities();
+  _logger->debug(
+      "BAM-BI: availability worker {} wrote {} availabilities from {} events",
+      worker, day.availabilities_count(), day.events_count());
+  _events_read += day.events_count();
 }
 
 /**
- *  Write an availability to the database. *One* row is inserted by ba and by
- *  day.
+ *  Fill the statistics tree with the progress of the availabilities build.
  *
- *  @param[in] thread_id              Index to one connection to the database.
- *  @param[in] builder                The builder of an availability.
- *  @param[in] ba_id                  The id of the ba.
- *  @param[in] day_start              The start of the day.
- *  @param[in] timeperiod_id          The id of the timeperiod.
+ *  @param[out] tree  The statistics tree.
  */
-void availability_thread::_write_availability(
-    int thread_id,
-    availability_builder const& builder,
-    uint32_t ba_id,
-    time_t day_start,
-    uint32_t timeperiod_id) {
-  _logger->debug(
-      "BAM-BI: availability thread writing availability for BA {} at day {} "
-      "(timeperiod {})",
-      ba_id, day_start, timeperiod_id);
-
-  std::string query_str(fmt::format(
-      "INSERT INTO mod_bam_reporting_ba_availabilities "
-      "(ba_id, time_id, timeperiod_id, timeperiod_is_default,"
-      " available, unavailable, degraded,"
-      " unknown, downtime, alert_unavailable_opened,"
-      " alert_degraded_opened, alert_unknown_opened,"
-      " nb_downtime)"
-      " VALUES ({},{},{},{},{},{},{},{},{},{},{},{},{})",
-      ba_id, day_start, timeperiod_id, builder.get_timeperiod_is_default(),
-      builder.get_available(), builder.get_unavailable(),
-      builder.get_degraded(), builder.get_unknown(), builder.get_downtime(),
-      builder.get_unavailable_opened(), builder.get_degraded_opened(),
-      builder.get_unknown_opened(), builder.get_downtime_opened()));
-
-  _logger->debug("Query: {}", query_str);
-  _mysql->run_query(query_str, database::mysql_error::insert_availability,
-                    thread_id);
+void availability_thread::statistics(nlohmann::json& tree) const {
+  time_t start = _build_start;
+  if (!start)
+    return;
+  time_t end = _build_end;
+  double elapsed = std::max<double>((end ? end : ::time(nullptr)) - start, 1);
+  uint64_t events = _events_read;
+  nlohmann::json& av = tree["availabilities"];
+  av["state"] = end ? "finished" : "building";
+  av["build_start"] = start;
+  av["days_to_build"] = _days_to_build.load();
+  av["days_built"] = _days_built.load();
+  av["events_read"] = events;
+  av["availabilities_written"] = _availabilities_written.load();
+  av["events_per_second"] = events / elapsed;
 }
 
 /**
@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/broker/bam/bool_and.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -84,3 +85,17 @@ std::string bool_and::object_info() const {
       "AND {:p}\nknown: {}\nvalue: {}", static_cast<const void*>(this),
       state_known() ? "true" : "false", boolean_value() ? "true" : "false");
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_and::compile(bool_program& program) {
+  return program.emit_binary(
+      _left, _right, bool_program::and_op,
+      {_left_hard, _right_hard, _left_downtime, _right_downtime, _state_known,
+       _boolean_value});
+}
@@ -38,7 +38,9 @@ void bool_binary_operator::_update_state() {
     if (_state_known) {
       _left_hard = _left->value_hard();
       _right_hard = _right->value_hard();
-      _in_downtime = _left->in_downtime() || _right->in_downtime();
+      _left_downtime = _left->in_downtime();
+      _right_downtime = _right->in_downtime();
+      _in_downtime = _left_downtime || _right_downtime;
       _logger->trace(
           "{}::_update_state: bool binary operator: new left value: {} - new "
           "right value: {} - downtime: {}",
@@ -94,7 +96,8 @@ bool bool_binary_operator::in_downtime() const {
 }
 
 /**
- * @brief Update this computable with the child modifications.
+ * @brief Update this computable with the child modifications. A change of
+ * the downtime of a child is also propagated.
  *
  * @param child The child that changed.
  * @param visitor The visitor to handle events.
@@ -106,12 +109,15 @@ void bool_binary_operator::update_from(computable* child, io::stream* visitor) {
   if (child) {
     if (child == _left.get()) {
       if (_left->state_known() != _state_known ||
-          std::abs(_left_hard - _left->value_hard()) > ::eps) {
+          std::abs(_left_hard - _left->value_hard()) > ::eps ||
+          _left->in_downtime() != _left_downtime) {
         _logger->trace(
             "{}::update_from: on left: old state known: {} - new state "
-            "known: {} - old value: {} - new value: {}",
+            "known: {} - old value: {} - new value: {} - old downtime: {} - "
+            "new downtime: {}",
             typeid(*this).name(), _state_known, _left->state_known(),
-            _left_hard, _left->value_hard());
+            _left_hard, _left->value_hard(), _left_downtime,
+            _left->in_downtime());
         _update_state();
         changed = true;
       } else
@@ -121,12 +127,15 @@ void bool_binary_operator::update_from(computable* child, io::stream* visitor) {
             typeid(*this).name(), _state_known, _left_hard);
     } else if (child == _right.get()) {
       if (_right->state_known() != _state_known ||
-          std::abs(_right_hard - _right->value_hard()) > ::eps) {
+          std::abs(_right_hard - _right->value_hard()) > ::eps ||
+          _right->in_downtime() != _right_downtime) {
         _logger->trace(
             "{}::update_from on right: old state known: {} - new state "
-            "known: {} - old value: {} - new value: {}",
+            "known: {} - old value: {} - new value: {} - old downtime: {} - "
+            "new downtime: {}",
             typeid(*this).name(), _state_known, _right->state_known(),
-            _right_hard, _right->value_hard());
+            _right_hard, _right->value_hard(), _right_downtime,
+            _right->in_downtime());
         _update_state();
         changed = true;
       } else
@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/broker/bam/bool_constant.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -78,3 +79,15 @@ std::string bool_constant::object_info() const {
 void bool_constant::dump(std::ofstream& output [[maybe_unused]]) const {
   dump_parents(output);
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_constant::compile(bool_program& program) {
+  program.emit_constant(_value);
+  return true;
+}
@@ -20,6 +20,8 @@
 
 #include <cmath>
 
+#include "com/centreon/broker/bam/bool_program.hh"
+
 using namespace com::centreon::broker::bam;
 
 /**
@@ -59,3 +61,16 @@ std::string bool_equal::object_info() const {
       "EQUAL {:p}\nknown: {}\nvalue: {}", static_cast<const void*>(this),
       state_known() ? "true" : "false", boolean_value() ? "true" : "false");
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_equal::compile(bool_program& program) {
+  return program.emit_binary(_left, _right, bool_program::equal,
+                             {_left_hard, _right_hard, _left_downtime,
+                              _right_downtime, _state_known, false});
+}
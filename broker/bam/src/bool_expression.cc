@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/bool_expression.hh"
 
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/bool_value.hh"
 #include "com/centreon/broker/bam/impact_values.hh"
 
@@ -37,13 +38,19 @@ bool_expression::bool_expression(uint32_t id,
                                  const std::shared_ptr<spdlog::logger>& logger)
     : computable(logger), _id(id), _impact_if(impact_if) {}
 
+/**
+ *  Destructor.
+ */
+bool_expression::~bool_expression() noexcept = default;
+
 /**
  *  Get the boolean expression state.
  *
  *  @return Either OK (0) or CRITICAL (2).
  */
 state bool_expression::get_state() const {
-  bool v = _expression->boolean_value();
+  bool v =
+      _program ? _program->result().boolean : _expression->boolean_value();
   state retval = v == _impact_if ? state_critical : state_ok;
   _logger->debug(
       "BAM: boolean expression {} - impact if: {} - value: {} - state: {}", _id,
@@ -57,6 +64,8 @@ state bool_expression::get_state() const {
  *  @return  True if the state is known.
  */
 bool bool_expression::state_known() const {
+  if (_program)
+    return _program->result().known;
   return _expression->state_known();
 }
 
@@ -66,6 +75,8 @@ bool bool_expression::state_known() const {
  *  @return  True if the boolean expression is in downtime.
  */
 bool bool_expression::in_downtime() const {
+  if (_program)
+    return _program->result().downtime;
   return _expression->in_downtime();
 }
 
@@ -86,6 +97,51 @@ std::shared_ptr<bool_value> bool_expression::get_expression() const {
 void bool_expression::set_expression(
     const std::shared_ptr<bool_value>& expression) {
   _expression = expression;
+  _program.reset();
+}
+
+/**
+ * @brief Compile the expression into a bool_program. On success, the services
+ * of the tree are detached from their operators and notify this expression
+ * directly, the operators of the tree are no more updated. This must be called
+ * once the expression is set and its parents are attached.
+ *
+ * @return true if the expression is compiled, false if it stays evaluated as a
+ * tree (if it contains external calls for example).
+ */
+bool bool_expression::compile() {
+  if (!_expression)
+    return false;
+  _program = bool_program::compile(*_expression);
+  if (!_program) {
+    _logger->debug(
+        "BAM: boolean expression {} cannot be compiled, it is evaluated as a "
+        "tree",
+        _id);
+    return false;
+  }
+
+  std::shared_ptr<computable> self =
+      std::static_pointer_cast<computable>(shared_from_this());
+  _expression->remove_parent(self);
+  for (bool_value* operand : _program->operands()) {
+    operand->clear_parents();
+    operand->add_parent(self);
+  }
+  _logger->debug(
+      "BAM: boolean expression {} compiled into {} instructions with {} "
+      "services",
+      _id, _program->size(), _program->operands().size());
+  return true;
+}
+
+/**
+ *  Get the compiled program.
+ *
+ *  @return The program or nullptr if the expression is not compiled.
+ */
+const bool_program* bool_expression::program() const {
+  return _program.get();
 }
 
 uint32_t bool_expression::get_id() const {
@@ -100,7 +156,10 @@ uint32_t bool_expression::get_id() const {
  */
 void bool_expression::update_from(computable* child, io::stream* visitor) {
   _logger->trace("bool_expression::update_from");
-  if (child == _expression.get())
+  if (_program) {
+    if (_program->update(child))
+      notify_parents_of_change(visitor);
+  } else if (child == _expression.get())
     notify_parents_of_change(visitor);
 }
 
@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/broker/bam/bool_less_than.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -60,3 +61,18 @@ std::string bool_less_than::object_info() const {
       static_cast<const void*>(this), state_known() ? "true" : "false",
       boolean_value() ? "true" : "false");
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_less_than::compile(bool_program& program) {
+  return program.emit_binary(
+      _left, _right,
+      _strict ? bool_program::less_than : bool_program::less_equal,
+      {_left_hard, _right_hard, _left_downtime, _right_downtime, _state_known,
+       false});
+}
@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/bool_more_than.hh"
 #include "com/centreon/broker/bam/bool_binary_operator.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -61,3 +62,18 @@ std::string bool_more_than::object_info() const {
       _strict ? "GREATER THAN" : "GREATER OR EQUAL",
       state_known() ? "true" : "false", boolean_value() ? "true" : "false");
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_more_than::compile(bool_program& program) {
+  return program.emit_binary(
+      _left, _right,
+      _strict ? bool_program::more_than : bool_program::more_equal,
+      {_left_hard, _right_hard, _left_downtime, _right_downtime, _state_known,
+       false});
+}
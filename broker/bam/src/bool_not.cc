@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/bool_not.hh"
 #include <cmath>
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -113,3 +114,17 @@ void bool_not::dump(std::ofstream& output) const {
                         _value->object_info());
   dump_parents(output);
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_not::compile(bool_program& program) {
+  if (!_value || !_value->compile(program))
+    return false;
+  program.emit(bool_program::not_op);
+  return true;
+}
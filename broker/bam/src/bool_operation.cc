@@ -21,6 +21,7 @@
 #include <cmath>
 #include <memory>
 #include "com/centreon/broker/bam/bool_binary_operator.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -134,3 +135,36 @@ std::string bool_operation::object_info() const {
       "{} {:p}\nknown: {}\nvalue: {}", op, static_cast<const void*>(this),
       state_known() ? "true" : "false", boolean_value() ? "true" : "false");
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_operation::compile(bool_program& program) {
+  bool_program::op_code code;
+  switch (_type) {
+    case addition:
+      code = bool_program::addition;
+      break;
+    case substraction:
+      code = bool_program::substraction;
+      break;
+    case multiplication:
+      code = bool_program::multiplication;
+      break;
+    case division:
+      code = bool_program::division;
+      break;
+    case modulo:
+      code = bool_program::modulo;
+      break;
+    default:
+      return false;
+  }
+  return program.emit_binary(_left, _right, code,
+                             {_left_hard, _right_hard, _left_downtime,
+                              _right_downtime, _state_known, false});
+}
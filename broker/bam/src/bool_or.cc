@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/broker/bam/bool_or.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -79,3 +80,17 @@ std::string bool_or::object_info() const {
       "OR {:p}\nknown: {}\nvalue: {}", static_cast<const void*>(this),
       state_known() ? "true" : "false", boolean_value() ? "true" : "false");
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_or::compile(bool_program& program) {
+  return program.emit_binary(
+      _left, _right, bool_program::or_op,
+      {_left_hard, _right_hard, _left_downtime, _right_downtime, _state_known,
+       _boolean_value});
+}
@@ -0,0 +1,343 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/bam/bool_program.hh"
+
+#include <cmath>
+
+#include "com/centreon/broker/bam/bool_binary_operator.hh"
+
+using namespace com::centreon::broker::bam;
+
+static constexpr double eps = 0.000001;
+
+/**
+ * @brief Tell if a binary operator is updated by a change of one of its
+ * operands, as bool_binary_operator::update_from() does.
+ *
+ * @param s The state of the operator.
+ * @param hard The value of this operand kept by the operator.
+ * @param downtime The downtime of this operand kept by the operator.
+ * @param v The new value of the operand.
+ *
+ * @return true if the operator is computed again.
+ */
+static bool operand_changed(const bool_program::operator_state& s,
+                            double hard,
+                            bool downtime,
+                            const bool_program::value& v) {
+  return v.known != s.known || std::abs(hard - v.hard) > ::eps ||
+         v.downtime != downtime;
+}
+
+/**
+ * @brief Compute again the state of a binary operator from its operands, as
+ * the _update_state() methods of the bool_binary_operator children: the
+ * values of the operands are kept only when both are known. A short-circuit
+ * of AND or OR does not refresh the downtimes.
+ *
+ * @param code The operator.
+ * @param s The state of the operator.
+ * @param l The left value.
+ * @param r The right value.
+ */
+static void update_state(bool_program::op_code code,
+                         bool_program::operator_state& s,
+                         const bool_program::value& l,
+                         const bool_program::value& r) {
+  if (code == bool_program::and_op) {
+    if (l.known && !l.boolean) {
+      s.left_hard = 0;
+      s.boolean = false;
+      s.known = true;
+      return;
+    }
+    if (r.known && !r.boolean) {
+      s.right_hard = 0;
+      s.boolean = false;
+      s.known = true;
+      return;
+    }
+  } else if (code == bool_program::or_op) {
+    if (l.known && l.boolean) {
+      s.left_hard = 1;
+      s.boolean = true;
+      s.known = true;
+      return;
+    }
+    if (r.known && r.boolean) {
+      s.right_hard = 1;
+      s.boolean = true;
+      s.known = true;
+      return;
+    }
+  }
+
+  s.known = l.known && r.known;
+  if (s.known) {
+    s.left_hard = l.hard;
+    s.right_hard = r.hard;
+    s.left_downtime = l.downtime;
+    s.right_downtime = r.downtime;
+  }
+  if (code == bool_program::and_op)
+    s.boolean = s.known && std::abs(s.left_hard) > ::eps &&
+                std::abs(s.right_hard) > ::eps;
+  else if (code == bool_program::or_op)
+    s.boolean = false;
+}
+
+/**
+ * @brief The value of a binary operator given its state, as value_hard(),
+ * boolean_value(), state_known() and in_downtime() of the tree node.
+ *
+ * @param code The operator.
+ * @param s The state of the operator.
+ *
+ * @return The value.
+ */
+static bool_program::value output(bool_program::op_code code,
+                                  const bool_program::operator_state& s) {
+  bool downtime = s.left_downtime || s.right_downtime;
+  bool b;
+  double h;
+  switch (code) {
+    case bool_program::and_op:
+    case bool_program::or_op:
+      b = s.boolean;
+      break;
+    case bool_program::xor_op:
+      b = (std::abs(s.left_hard) > ::eps) ^ (std::abs(s.right_hard) > ::eps);
+      break;
+    case bool_program::equal:
+      b = s.known && std::fabs(s.left_hard - s.right_hard) < COMPARE_EPSILON;
+      break;
+    case bool_program::not_equal:
+      b = std::fabs(s.left_hard - s.right_hard) >= COMPARE_EPSILON;
+      break;
+    case bool_program::less_than:
+      b = s.left_hard < s.right_hard;
+      break;
+    case bool_program::less_equal:
+      b = s.left_hard <= s.right_hard;
+      break;
+    case bool_program::more_than:
+      b = s.left_hard > s.right_hard;
+      break;
+    case bool_program::more_equal:
+      b = s.left_hard >= s.right_hard;
+      break;
+    case bool_program::addition:
+      h = s.left_hard + s.right_hard;
+      return {h, static_cast<bool>(h), s.known, downtime};
+    case bool_program::substraction:
+      h = s.left_hard - s.right_hard;
+      return {h, static_cast<bool>(h), s.known, downtime};
+    case bool_program::multiplication:
+      h = s.left_hard * s.right_hard;
+      return {h, std::fabs(h) > COMPARE_EPSILON, s.known, downtime};
+    case bool_program::division:
+      if (std::fabs(s.right_hard) < COMPARE_EPSILON)
+        return {NAN, false, false, downtime};
+      h = s.left_hard / s.right_hard;
+      return {h, static_cast<bool>(h), s.known, downtime};
+    case bool_program::modulo: {
+      bool known = s.known && !(std::fabs(s.right_hard) < COMPARE_EPSILON);
+      long long left_val = static_cast<long long>(s.left_hard);
+      long long right_val = static_cast<long long>(s.right_hard);
+      if (right_val == 0)
+        return {NAN, false, known, downtime};
+      h = left_val % right_val;
+      return {h, static_cast<bool>(h), known, downtime};
+    }
+    default:
+      return {0, false, false, downtime};
+  }
+  return {static_cast<double>(b), b, s.known, downtime};
+}
+
+/**
+ * @brief Default constructor, the program is filled by the compile() methods
+ * of the tree.
+ */
+bool_program::bool_program() : _result{0, false, false, false} {}
+
+/**
+ * @brief Compile a tree of bool_value.
+ *
+ * @param tree The root of the expression.
+ *
+ * @return The program or nullptr if some nodes cannot be compiled.
+ */
+std::unique_ptr<bool_program> bool_program::compile(bool_value& tree) {
+  auto retval = std::make_unique<bool_program>();
+  if (!tree.compile(*retval))
+    return nullptr;
+
+  // The stack is allocated once with the depth needed by the program.
+  size_t depth = 0;
+  size_t max_depth = 0;
+  for (auto& i : retval->_code) {
+    switch (i.code) {
+      case load:
+        max_depth = std::max(max_depth, ++depth);
+        break;
+      case not_op:
+        break;
+      default:
+        --depth;
+        break;
+    }
+  }
+  retval->_stack.resize(max_depth);
+  retval->_run(UINT32_MAX);
+  return retval;
+}
+
+/**
+ * @brief Read the current value of an operand.
+ *
+ * @param operand The operand.
+ *
+ * @return Its value.
+ */
+bool_program::value bool_program::_read(const bool_value& operand) {
+  return {operand.value_hard(), operand.boolean_value(), operand.state_known(),
+          operand.in_downtime()};
+}
+
+/**
+ * @brief Add an operand whose value can change, it will be read again on each
+ * call to update() with it.
+ *
+ * @param operand The operand (usually a bool_service).
+ */
+void bool_program::emit_operand(bool_value* operand) {
+  uint32_t slot = _slots.size();
+  _slots.push_back(_read(*operand));
+  _operand_index.emplace(static_cast<const computable*>(operand),
+                         _operands.size());
+  _operands.push_back(operand);
+  _operand_slots.push_back(slot);
+  _code.push_back({load, slot});
+}
+
+/**
+ * @brief Add a constant operand.
+ *
+ * @param constant The constant.
+ */
+void bool_program::emit_constant(double constant) {
+  uint32_t slot = _slots.size();
+  _slots.push_back({constant, std::abs(constant) > ::eps, true, false});
+  _code.push_back({load, slot});
+}
+
+/**
+ * @brief Add an instruction without argument.
+ *
+ * @param code The instruction.
+ */
+void bool_program::emit(op_code code) {
+  _code.push_back({code, 0});
+}
+
+/**
+ * @brief Compile the two operands of a binary operator, then the operator.
+ * AND and OR evaluate their right operand even when the left one is enough,
+ * as the tree keeps updating the operators under it.
+ *
+ * @param left The left operand.
+ * @param right The right operand.
+ * @param code The operator.
+ * @param state The values of the operands kept by the tree node.
+ *
+ * @return true on success.
+ */
+bool bool_program::emit_binary(const std::shared_ptr<bool_value>& left,
+                               const std::shared_ptr<bool_value>& right,
+                               op_code code,
+                               const operator_state& state) {
+  if (!left || !right || !left->compile(*this))
+    return false;
+  if (!right->compile(*this))
+    return false;
+  _code.push_back({code, static_cast<uint32_t>(_states.size())});
+  _states.push_back(state);
+  return true;
+}
+
+/**
+ * @brief Run the program. Only the operators on the path of the changed slot
+ * can be computed again, the other ones give the value of their state.
+ *
+ * @param changed_slot The slot refreshed before this run, UINT32_MAX if none.
+ *
+ * @return true if the root of the tree would notify its parents.
+ */
+bool bool_program::_run(uint32_t changed_slot) {
+  entry* sp = _stack.data();
+  const size_t size = _code.size();
+  for (size_t pc = 0; pc < size; ++pc) {
+    const instruction& i = _code[pc];
+    switch (i.code) {
+      case load:
+        *sp++ = {_slots[i.arg], i.arg == changed_slot};
+        break;
+      case not_op: {
+        value& t = sp[-1].val;
+        t.boolean = std::abs(t.hard) < ::eps;
+        t.hard = t.boolean;
+      } break;
+      default: {
+        --sp;
+        entry& l = sp[-1];
+        const entry& r = *sp;
+        operator_state& s = _states[i.arg];
+        bool changed =
+            (l.changed &&
+             operand_changed(s, s.left_hard, s.left_downtime, l.val)) ||
+            (r.changed &&
+             operand_changed(s, s.right_hard, s.right_downtime, r.val));
+        if (changed)
+          update_state(i.code, s, l.val, r.val);
+        l = {output(i.code, s), changed};
+      } break;
+    }
+  }
+  _result = _stack[0].val;
+  return _stack[0].changed;
+}
+
+/**
+ * @brief Read again an operand that changed and run the program.
+ *
+ * @param child The operand.
+ *
+ * @return true if the expression must notify its parents, as the root of the
+ * tree would do.
+ */
+bool bool_program::update(const computable* child) {
+  auto found = _operand_index.find(child);
+  if (found == _operand_index.end())
+    return false;
+  uint32_t idx = found->second;
+  uint32_t slot = _operand_slots[idx];
+  _slots[slot] = _read(*_operands[idx]);
+  return _run(slot);
+}
@@ -21,6 +21,7 @@
 #include "com/centreon/broker/bam/bool_service.hh"
 
 #include "bbdo/bam/state.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/service_state.hh"
 #include "com/centreon/broker/neb/service_status.hh"
 
@@ -263,3 +264,15 @@ std::string bool_service::object_info() const {
 void bool_service::dump(std::ofstream& output) const {
   dump_parents(output);
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_service::compile(bool_program& program) {
+  program.emit_operand(this);
+  return true;
+}
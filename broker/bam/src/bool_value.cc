@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/broker/bam/bool_value.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -28,3 +29,15 @@ using namespace com::centreon::broker::bam;
 bool bool_value::in_downtime() const {
   return false;
 }
+
+/**
+ * @brief Append this node to a compiled program. By default a node cannot be
+ * compiled and the expression stays evaluated as a tree.
+ *
+ * @param program The program (unused).
+ *
+ * @return false.
+ */
+bool bool_value::compile(bool_program& program [[maybe_unused]]) {
+  return false;
+}
@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/broker/bam/bool_xor.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 
 using namespace com::centreon::broker::bam;
 
@@ -55,3 +56,16 @@ std::string bool_xor::object_info() const {
       "XOR {:p}\nknown: {}\nvalue: {}", static_cast<const void*>(this),
       state_known() ? "true" : "false", boolean_value() ? "true" : "false");
 }
+
+/**
+ * @brief Append this node to a compiled program.
+ *
+ * @param program The program.
+ *
+ * @return true on success.
+ */
+bool bool_xor::compile(bool_program& program) {
+  return program.emit_binary(_left, _right, bool_program::xor_op,
+                             {_left_hard, _right_hard, _left_downtime,
+                              _right_downtime, _state_known, false});
+}
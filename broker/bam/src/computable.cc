@@ -47,6 +47,13 @@ void computable::remove_parent(std::shared_ptr<computable> const& parent) {
     }
 }
 
+/**
+ *  Remove all the parents.
+ */
+void computable::clear_parents() {
+  _parents.clear();
+}
+
 /**
  * @brief Notify parents of this object because of a change made in this.
  *
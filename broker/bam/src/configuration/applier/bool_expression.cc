@@ -132,6 +132,21 @@ void applier::bool_expression::apply(
   }
 
   _resolve_expression_calls();
+
+  // Expressions are compiled once the calls are resolved, only if no
+  // expression uses calls since they read the trees of other expressions.
+  bool has_calls = false;
+  for (auto& p : _applied)
+    if (!p.second.call.empty()) {
+      has_calls = true;
+      break;
+    }
+  if (!has_calls)
+    for (auto& p : to_create) {
+      auto found = _applied.find(p.first);
+      if (found != _applied.end())
+        found->second.obj->compile();
+    }
 }
 
 /**
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/bam/daily_availabilities.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] day_start  The start of the day.
+ *  @param[in] day_end    The first second of the next day.
+ *  @param[in] tps        The timeperiods and their relations with BAs.
+ *  @param[in] w          Called for each complete availability.
+ *  @param[in] logger     The logger to use.
+ */
+daily_availabilities::daily_availabilities(
+    time_t day_start,
+    time_t day_end,
+    const timeperiod_map& tps,
+    const writer& w,
+    const std::shared_ptr<spdlog::logger>& logger)
+    : _day_start{day_start},
+      _day_end{day_end},
+      _tps{tps},
+      _writer{w},
+      _current_ba{0},
+      _events_count{0},
+      _availabilities_count{0},
+      _logger{logger} {}
+
+/**
+ *  Add an event not finished yet. All of them must be added before the
+ *  closed events.
+ *
+ *  @param[in] ba_id        The BA of the event.
+ *  @param[in] status       The status of the BA.
+ *  @param[in] start        The start time of the event.
+ *  @param[in] in_downtime  Was the BA in downtime.
+ */
+void daily_availabilities::add_opened_event(uint32_t ba_id,
+                                            short status,
+                                            time_t start,
+                                            bool in_downtime) {
+  _opened[ba_id].push_back({status, start, in_downtime});
+  ++_events_count;
+}
+
+/**
+ *  Add a finished event. Events must be added ordered by BA id.
+ *
+ *  @param[in] ba_id                  The BA of the event.
+ *  @param[in] timeperiod_id          The timeperiod of the event duration.
+ *  @param[in] timeperiod_is_default  Is it the default timeperiod of the BA.
+ *  @param[in] status                 The status of the BA.
+ *  @param[in] start                  The start time of the event.
+ *  @param[in] end                    The end time of the event.
+ *  @param[in] in_downtime            Was the BA in downtime.
+ */
+void daily_availabilities::add_closed_event(uint32_t ba_id,
+                                            uint32_t timeperiod_id,
+                                            bool timeperiod_is_default,
+                                            short status,
+                                            time_t start,
+                                            time_t end,
+                                            bool in_downtime) {
+  ++_events_count;
+  time::timeperiod::ptr tp = _tps.get_timeperiod(timeperiod_id);
+  if (!tp) {
+    _logger->debug("no timeperiod found with id {}", timeperiod_id);
+    return;
+  }
+
+  if (ba_id != _current_ba) {
+    _complete_until(ba_id);
+    _current_ba = ba_id;
+  }
+
+  availability_builder& builder = _get_builder(timeperiod_id);
+  builder.add_event(status, start, end, in_downtime, tp, _logger);
+  builder.set_timeperiod_is_default(timeperiod_is_default);
+}
+
+/**
+ *  Write the availabilities of the remaining BAs.
+ */
+void daily_availabilities::finish() {
+  if (_current_ba)
+    _complete_ba(_current_ba);
+  _current_ba = 0;
+  while (!_opened.empty())
+    _complete_ba(_opened.begin()->first);
+}
+
+/**
+ *  Get the builder of the current BA for a timeperiod, create it if needed.
+ *
+ *  @param[in] timeperiod_id  The timeperiod id.
+ *
+ *  @return The builder.
+ */
+availability_builder& daily_availabilities::_get_builder(
+    uint32_t timeperiod_id) {
+  auto found = _builders.find(timeperiod_id);
+  if (found == _builders.end())
+    found = _builders
+                .emplace(timeperiod_id, std::make_unique<availability_builder>(
+                                            _day_end, _day_start))
+                .first;
+  return *found->second;
+}
+
+/**
+ *  Write the availabilities of the current BA and of the BAs with only opened
+ *  events that are before ba_id.
+ *
+ *  @param[in] ba_id  The next BA.
+ */
+void daily_availabilities::_complete_until(uint32_t ba_id) {
+  if (_current_ba)
+    _complete_ba(_current_ba);
+  _current_ba = 0;
+  while (!_opened.empty() && _opened.begin()->first < ba_id)
+    _complete_ba(_opened.begin()->first);
+}
+
+/**
+ *  Add the opened events of a BA to its builders, one per timeperiod of the
+ *  BA, and give them to the writer.
+ *
+ *  @param[in] ba_id  The BA to complete.
+ */
+void daily_availabilities::_complete_ba(uint32_t ba_id) {
+  auto opened = _opened.find(ba_id);
+  if (opened != _opened.end()) {
+    for (auto& tp : _tps.get_timeperiods_by_ba_id(ba_id)) {
+      availability_builder& builder = _get_builder(tp.first->get_id());
+      for (const opened_event& ev : opened->second)
+        builder.add_event(ev.status, ev.start, 0, ev.in_downtime, tp.first,
+                          _logger);
+      builder.set_timeperiod_is_default(tp.second);
+    }
+    _opened.erase(opened);
+  }
+
+  for (auto& b : _builders)
+    _writer(ba_id, b.first, *b.second);
+  _availabilities_count += _builders.size();
+  _builders.clear();
+}
@@ -60,6 +60,12 @@ reporting_stream::reporting_stream(
       _pending_events(0),
       _mysql(db_cfg),
       _processing_dimensions(false),
+      _ba_event_rows{0},
+      _ba_duration_rows{0},
+      _kpi_event_rows{0},
+      _rows_per_second{0},
+      _last_commit_rows{0},
+      _last_commit{std::chrono::steady_clock::now()},
       _logger{logger} {
   SPDLOG_LOGGER_TRACE(_logger, "BAM: reporting stream constructor");
   // Prepare queries.
@@ -117,6 +123,12 @@ void reporting_stream::statistics(nlohmann::json& tree) const {
   std::lock_guard<std::mutex> lock(_statusm);
   if (!_status.empty())
     tree["status"] = _status;
+  nlohmann::json& rows = tree["rows"];
+  rows["ba_events"] = _ba_event_rows.load();
+  rows["ba_events_durations"] = _ba_duration_rows.load();
+  rows["kpi_events"] = _kpi_event_rows.load();
+  rows["per_second"] = _rows_per_second.load();
+  _availabilities->statistics(tree);
 }
 
 /**
@@ -166,7 +178,8 @@ int reporting_stream::write(std::shared_ptr<io::data> const& data) {
   }
 
   auto commit_if_needed = [this]() {
-    if (_pending_events >= _mysql.get_config().get_queries_per_transaction()) {
+    if (_pending_events >= _mysql.get_config().get_queries_per_transaction() ||
+        _batches_ready()) {
       _commit();
     }
   };
@@ -820,25 +833,28 @@ struct bulk_kpi_event_update_binder {
   }
 };
 
-// When bulk statements are not available.
+// When bulk statements are not available. The row is identified by its
+// kpi_event_id so that the ON DUPLICATE KEY clause updates it.
 struct kpi_event_update_binder {
+  uint32_t kpi_event_id;
   const std::shared_ptr<io::data>& event;
   std::string operator()() const {
     if (event->type() == bam::kpi_event::static_type()) {
       bam::kpi_event const& ke =
           *std::static_pointer_cast<bam::kpi_event const>(event);
-      std::string sz_ke_time{fmt::format("{}", ke.end_time)};
-      return fmt::format("({},{},{},{},{},{})", sz_ke_time, ke.status,
-                         int(ke.in_downtime), ke.impact_level, ke.kpi_id,
-                         ke.start_time);
+      std::string sz_ke_time =
+          ke.end_time.is_null() ? "NULL" : fmt::format("{}", ke.end_time);
+      return fmt::format("({},{},{},{},{},{},{})", kpi_event_id, sz_ke_time,
+                         ke.status, int(ke.in_downtime), ke.impact_level,
+                         ke.kpi_id, ke.start_time);
     } else {
       const KpiEvent& ke =
           std::static_pointer_cast<bam::pb_kpi_event const>(event)->obj();
       std::string sz_ke_time =
           ke.end_time() <= 0 ? "NULL" : std::to_string(ke.end_time());
-      return fmt::format("({},{},{},{},{},{})", sz_ke_time, int(ke.status()),
-                         int(ke.in_downtime()), ke.impact_level(), ke.kpi_id(),
-                         ke.start_time());
+      return fmt::format("({},{},{},{},{},{},{})", kpi_event_id, sz_ke_time,
+                         int(ke.status()), int(ke.in_downtime()),
+                         ke.impact_level(), ke.kpi_id(), ke.start_time());
     }
   }
 };
@@ -854,12 +870,46 @@ void reporting_stream::_prepare() {
       " VALUES(?,?,?,?,?,?)"};
   _ba_full_event_insert = _mysql.prepare_query(query);
 
-  query =
-      "UPDATE mod_bam_reporting_ba_events"
-      "  SET end_time=?, first_level=?,"
-      "      status=?, in_downtime=?"
-      "  WHERE ba_id=? AND start_time=?";
-  _ba_event_update = _mysql.prepare_query(query);
+  // Updates of events and their durations are accumulated and sent by
+  // batches, the rows are identified by the ids kept in _ba_event_cache.
+  const auto batch_delay =
+      std::chrono::seconds(_mysql.get_config().get_max_commit_delay());
+  const uint32_t batch_rows = _mysql.get_config().get_queries_per_transaction();
+  if (_mysql.support_bulk_statement()) {
+    _ba_event_update = std::make_unique<bulk_or_multi>(
+        _mysql,
+        "UPDATE mod_bam_reporting_ba_events"
+        " SET end_time=?, first_level=?, status=?, in_downtime=?"
+        " WHERE ba_event_id=?",
+        batch_rows, batch_delay, batch_rows);
+    _ba_duration_event_upsert = std::make_unique<bulk_or_multi>(
+        _mysql,
+        "INSERT INTO mod_bam_reporting_ba_events_durations (ba_event_id,"
+        " timeperiod_id, start_time, end_time, duration, sla_duration,"
+        " timeperiod_is_default) VALUES (?,?,?,?,?,?,?)"
+        " ON DUPLICATE KEY UPDATE start_time=VALUES(start_time),"
+        " end_time=VALUES(end_time), duration=VALUES(duration),"
+        " sla_duration=VALUES(sla_duration),"
+        " timeperiod_is_default=VALUES(timeperiod_is_default)",
+        batch_rows, batch_delay, batch_rows);
+  } else {
+    _ba_event_update = std::make_unique<bulk_or_multi>(
+        "INSERT INTO mod_bam_reporting_ba_events (ba_event_id, ba_id,"
+        " start_time, end_time, first_level, status, in_downtime) VALUES",
+        "ON DUPLICATE KEY UPDATE end_time=VALUES(end_time),"
+        " first_level=VALUES(first_level), status=VALUES(status),"
+        " in_downtime=VALUES(in_downtime)",
+        batch_delay, batch_rows);
+    _ba_duration_event_upsert = std::make_unique<bulk_or_multi>(
+        "INSERT INTO mod_bam_reporting_ba_events_durations (ba_event_id,"
+        " timeperiod_id, start_time, end_time, duration, sla_duration,"
+        " timeperiod_is_default) VALUES",
+        "ON DUPLICATE KEY UPDATE start_time=VALUES(start_time),"
+        " end_time=VALUES(end_time), duration=VALUES(duration),"
+        " sla_duration=VALUES(sla_duration),"
+        " timeperiod_is_default=VALUES(timeperiod_is_default)",
+        batch_delay, batch_rows);
+  }
 
   query =
       "INSERT INTO mod_bam_reporting_ba_events_durations ("
@@ -897,14 +947,15 @@ void reporting_stream::_prepare() {
         " SET end_time=?, status=?,"
         " in_downtime=?, impact_level=?"
         " WHERE kpi_id=? AND start_time=?",
-        _mysql.get_config().get_queries_per_transaction());
+        batch_rows, batch_delay, batch_rows);
   } else {
     _kpi_event_update = std::make_unique<bulk_or_multi>(
-        "INSERT INTO mod_bam_reporting_kpi_events (end_time, status, "
-        "in_downtime, impact_level, kpi_id, start_time) VALUES",
+        "INSERT INTO mod_bam_reporting_kpi_events (kpi_event_id, end_time, "
+        "status, in_downtime, impact_level, kpi_id, start_time) VALUES",
         "ON DUPLICATE KEY UPDATE end_time=VALUES(end_time), "
         "status=VALUES(status), in_downtime=VALUES(in_downtime), "
-        "impact_level=VALUES(impact_level)");
+        "impact_level=VALUES(impact_level)",
+        batch_delay, batch_rows);
   }
 
   query =
@@ -1015,23 +1066,11 @@ void reporting_stream::_process_ba_event(std::shared_ptr<io::data> const& e) {
   id_start ba_key = std::make_pair(
       be.ba_id, static_cast<uint64_t>(be.start_time.get_time_t()));
   // event exists?
-  if (_ba_event_cache.find(ba_key) != _ba_event_cache.end()) {
-    if (be.end_time.is_null())
-      _ba_event_update.bind_null_u64(0);
-    else
-      _ba_event_update.bind_value_as_u64(0, be.end_time.get_time_t());
-    _ba_event_update.bind_value_as_i32(1, be.first_level);
-    _ba_event_update.bind_value_as_tiny(2, be.status);
-    _ba_event_update.bind_value_as_bool(3, be.in_downtime);
-    _ba_event_update.bind_value_as_i32(4, be.ba_id);
-    _ba_event_update.bind_value_as_u64(
-        5, static_cast<uint64_t>(be.start_time.get_time_t()));
-
-    std::promise<int> promise;
-    std::future<int> future = promise.get_future();
-    _mysql.run_statement_and_get_int<int>(_ba_event_update, std::move(promise),
-                                          mysql_task::int_type::AFFECTED_ROWS);
-
+  auto found = _ba_event_cache.find(ba_key);
+  if (found != _ba_event_cache.end()) {
+    _update_ba_event(found->second, be.ba_id, ba_key.second,
+                     be.end_time.is_null() ? -1 : be.end_time.get_time_t(),
+                     be.first_level, be.status, be.in_downtime);
   } else {
     // Event was not found, insert one.
     try {
@@ -1052,9 +1091,10 @@ void reporting_stream::_process_ba_event(std::shared_ptr<io::data> const& e) {
       std::future<uint32_t> future_r = result.get_future();
       _mysql.run_statement_and_get_int<uint32_t>(
           _ba_full_event_insert, std::move(result), mysql_task::LAST_INSERT_ID,
-          -1);
+          _events_thread_id);
       uint32_t newba = future_r.get();
       _ba_event_cache[ba_key] = newba;
+      ++_ba_event_rows;
       // check events for BA
       if (_last_inserted_kpi.find(be.ba_id) != _last_inserted_kpi.end()) {
         std::map<std::time_t, uint64_t>& m_events =
@@ -1065,7 +1105,8 @@ void reporting_stream::_process_ba_event(std::shared_ptr<io::data> const& e) {
           _kpi_event_link_update.bind_value_as_u64(
               1, m_events[be.start_time.get_time_t()]);
           _mysql.run_statement(_kpi_event_link_update,
-                               database::mysql_error::update_kpi_event);
+                               database::mysql_error::update_kpi_event,
+                               _events_thread_id);
         }
         // remove older events for BA
         for (auto it = m_events.begin(); it != m_events.end();) {
@@ -1112,22 +1153,13 @@ void reporting_stream::_process_pb_ba_event(
 
   id_start ba_key = std::make_pair(be.ba_id(), be.start_time());
   // event exists?
-  if (_ba_event_cache.find(ba_key) != _ba_event_cache.end()) {
-    if (static_cast<int64_t>(be.end_time()) <= 0)
-      _ba_event_update.bind_null_u64(0);
-    else
-      _ba_event_update.bind_value_as_u64(0, be.end_time());
-    _ba_event_update.bind_value_as_i32(1, be.first_level());
-    _ba_event_update.bind_value_as_tiny(2, be.status());
-    _ba_event_update.bind_value_as_bool(3, be.in_downtime());
-    _ba_event_update.bind_value_as_i32(4, be.ba_id());
-    _ba_event_update.bind_value_as_u64(5, be.start_time());
-
-    std::promise<int> promise;
-    std::future<int> future = promise.get_future();
-    _mysql.run_statement_and_get_int<int>(_ba_event_update, std::move(promise),
-                                          mysql_task::int_type::AFFECTED_ROWS);
-
+  auto found = _ba_event_cache.find(ba_key);
+  if (found != _ba_event_cache.end()) {
+    _update_ba_event(found->second, be.ba_id(), be.start_time(),
+                     static_cast<int64_t>(be.end_time()) <= 0
+                         ? -1
+                         : static_cast<int64_t>(be.end_time()),
+                     be.first_level(), be.status(), be.in_downtime());
   } else {
     // Event was not found, insert one.
     try {
@@ -1146,9 +1178,10 @@ void reporting_stream::_process_pb_ba_event(
       std::future<uint32_t> future_r = result.get_future();
       _mysql.run_statement_and_get_int<uint32_t>(
           _ba_full_event_insert, std::move(result), mysql_task::LAST_INSERT_ID,
-          -1);
+          _events_thread_id);
       uint32_t newba = future_r.get();
       _ba_event_cache[ba_key] = newba;
+      ++_ba_event_rows;
       // check events for BA
       if (_last_inserted_kpi.find(be.ba_id()) != _last_inserted_kpi.end()) {
         std::map<std::time_t, uint64_t>& m_events =
@@ -1159,7 +1192,8 @@ void reporting_stream::_process_pb_ba_event(
           _kpi_event_link_update.bind_value_as_u64(1,
                                                    m_events[be.start_time()]);
           _mysql.run_statement(_kpi_event_link_update,
-                               database::mysql_error::update_kpi_event);
+                               database::mysql_error::update_kpi_event,
+                               _events_thread_id);
         }
         // remove older events for BA
         for (auto it = m_events.begin(); it != m_events.end();) {
@@ -1197,48 +1231,12 @@ void reporting_stream::_process_ba_duration_event(
                       bde.ba_id, bde.start_time, bde.end_time, bde.duration,
                       bde.sla_duration);
 
-  // Try to update first.
-  _ba_duration_event_update.bind_value_as_u64(
-      1, static_cast<uint64_t>(bde.end_time.get_time_t()));
-  _ba_duration_event_update.bind_value_as_u64(
-      0, static_cast<uint64_t>(bde.start_time.get_time_t()));
-  _ba_duration_event_update.bind_value_as_i32(2, bde.duration);
-  _ba_duration_event_update.bind_value_as_i32(3, bde.sla_duration);
-  _ba_duration_event_update.bind_value_as_i32(4, bde.timeperiod_is_default);
-  _ba_duration_event_update.bind_value_as_i32(5, bde.ba_id);
-  _ba_duration_event_update.bind_value_as_u64(
-      6, static_cast<uint64_t>(bde.real_start_time.get_time_t()));
-  _ba_duration_event_update.bind_value_as_i32(7, bde.timeperiod_id);
-
-  std::promise<int> promise;
-  std::future<int> future = promise.get_future();
-  int thread_id(_mysql.run_statement_and_get_int<int>(
-      _ba_duration_event_update, std::move(promise),
-      mysql_task::int_type::AFFECTED_ROWS));
-  try {
-    // Insert if no rows was updated.
-    if (future.get() == 0) {
-      _ba_duration_event_insert.bind_value_as_u64(
-          0, static_cast<uint64_t>(bde.start_time.get_time_t()));
-      _ba_duration_event_insert.bind_value_as_u64(
-          1, static_cast<uint64_t>(bde.end_time.get_time_t()));
-      _ba_duration_event_insert.bind_value_as_i32(2, bde.duration);
-      _ba_duration_event_insert.bind_value_as_i32(3, bde.sla_duration);
-      _ba_duration_event_insert.bind_value_as_i32(4, bde.timeperiod_id);
-      _ba_duration_event_insert.bind_value_as_f64(5, bde.timeperiod_is_default);
-      _ba_duration_event_insert.bind_value_as_i32(6, bde.ba_id);
-      _ba_duration_event_insert.bind_value_as_u64(
-          7, static_cast<uint64_t>(bde.real_start_time.get_time_t()));
-
-      _mysql.run_statement(_ba_duration_event_insert,
-                           database::mysql_error::empty, thread_id);
-    }
-  } catch (std::exception const& e) {
-    throw msg_fmt(
-        "BAM-BI: could not insert duration event of BA {}"
-        " starting at {} : {}",
-        bde.ba_id, bde.start_time, e.what());
-  }
+  _write_ba_duration(bde.ba_id,
+                     static_cast<uint64_t>(bde.real_start_time.get_time_t()),
+                     bde.timeperiod_id,
+                     static_cast<uint64_t>(bde.start_time.get_time_t()),
+                     static_cast<uint64_t>(bde.end_time.get_time_t()),
+                     bde.duration, bde.sla_duration, bde.timeperiod_is_default);
 }
 
 /**
@@ -1257,43 +1255,136 @@ void reporting_stream::_process_pb_ba_duration_event(
                       bde.ba_id(), bde.start_time(), bde.end_time(),
                       bde.duration(), bde.sla_duration());
 
+  _write_ba_duration(bde.ba_id(), bde.real_start_time(), bde.timeperiod_id(),
+                     bde.start_time(), bde.end_time(), bde.duration(),
+                     bde.sla_duration(), bde.timeperiod_is_default());
+}
+
+/**
+ *  Queue the update of a known BA event, it is sent with the next batch.
+ *
+ *  @param[in] ba_event_id  The id of the event in the database.
+ *  @param[in] ba_id        The BA of the event.
+ *  @param[in] start_time   The start time of the event.
+ *  @param[in] end_time     The end time of the event, negative if not ended.
+ *  @param[in] first_level  The level of the BA at the start of the event.
+ *  @param[in] status       The status of the BA.
+ *  @param[in] in_downtime  Is the BA in downtime.
+ */
+void reporting_stream::_update_ba_event(uint32_t ba_event_id,
+                                        uint32_t ba_id,
+                                        uint64_t start_time,
+                                        int64_t end_time,
+                                        int32_t first_level,
+                                        char status,
+                                        bool in_downtime) {
+  if (_ba_event_update->is_bulk()) {
+    _ba_event_update->add_bulk_row([&](database::mysql_bulk_bind& binder) {
+      if (end_time < 0)
+        binder.set_null_u64(0);
+      else
+        binder.set_value_as_u64(0, end_time);
+      binder.set_value_as_i32(1, first_level);
+      binder.set_value_as_tiny(2, status);
+      binder.set_value_as_bool(3, in_downtime);
+      binder.set_value_as_u32(4, ba_event_id);
+      binder.next_row();
+    });
+  } else {
+    _ba_event_update->add_multi_row([&] {
+      return fmt::format(
+          "({},{},{},{},{},{},{})", ba_event_id, ba_id, start_time,
+          end_time < 0 ? std::string("NULL") : std::to_string(end_time),
+          first_level, int(status), int(in_downtime));
+    });
+  }
+  _ba_event_pending_updates.insert(ba_id);
+}
+
+/**
+ *  Write the duration of a BA event on a timeperiod. When the event is known,
+ *  the duration is queued for the next batch, otherwise it is updated or
+ *  inserted immediately.
+ *
+ *  @param[in] ba_id                  The BA of the event.
+ *  @param[in] real_start_time        The start time of the event.
+ *  @param[in] timeperiod_id          The timeperiod.
+ *  @param[in] start_time             The start of the duration.
+ *  @param[in] end_time               The end of the duration.
+ *  @param[in] duration               The duration.
+ *  @param[in] sla_duration           The duration within the timeperiod.
+ *  @param[in] timeperiod_is_default  Is it the default timeperiod of the BA.
+ */
+void reporting_stream::_write_ba_duration(uint32_t ba_id,
+                                          uint64_t real_start_time,
+                                          uint32_t timeperiod_id,
+                                          uint64_t start_time,
+                                          uint64_t end_time,
+                                          int32_t duration,
+                                          int32_t sla_duration,
+                                          bool timeperiod_is_default) {
+  auto found = _ba_event_cache.find(std::make_pair(ba_id, real_start_time));
+  if (found != _ba_event_cache.end()) {
+    uint32_t ba_event_id = found->second;
+    if (_ba_duration_event_upsert->is_bulk()) {
+      _ba_duration_event_upsert->add_bulk_row(
+          [&](database::mysql_bulk_bind& binder) {
+            binder.set_value_as_u32(0, ba_event_id);
+            binder.set_value_as_u32(1, timeperiod_id);
+            binder.set_value_as_u64(2, start_time);
+            binder.set_value_as_u64(3, end_time);
+            binder.set_value_as_i32(4, duration);
+            binder.set_value_as_i32(5, sla_duration);
+            binder.set_value_as_bool(6, timeperiod_is_default);
+            binder.next_row();
+          });
+    } else {
+      _ba_duration_event_upsert->add_multi_row([&] {
+        return fmt::format("({},{},{},{},{},{},{})", ba_event_id,
+                           timeperiod_id, start_time, end_time, duration,
+                           sla_duration, int(timeperiod_is_default));
+      });
+    }
+    return;
+  }
+
   // Try to update first.
-  _ba_duration_event_update.bind_value_as_u64(1, bde.end_time());
-  _ba_duration_event_update.bind_value_as_u64(0, bde.start_time());
-  _ba_duration_event_update.bind_value_as_i32(2, bde.duration());
-  _ba_duration_event_update.bind_value_as_i32(3, bde.sla_duration());
-  _ba_duration_event_update.bind_value_as_i32(4, bde.timeperiod_is_default());
-  _ba_duration_event_update.bind_value_as_i32(5, bde.ba_id());
-  _ba_duration_event_update.bind_value_as_u64(
-      6, static_cast<uint64_t>(bde.real_start_time()));
-  _ba_duration_event_update.bind_value_as_i32(7, bde.timeperiod_id());
+  _ba_duration_event_update.bind_value_as_u64(0, start_time);
+  _ba_duration_event_update.bind_value_as_u64(1, end_time);
+  _ba_duration_event_update.bind_value_as_i32(2, duration);
+  _ba_duration_event_update.bind_value_as_i32(3, sla_duration);
+  _ba_duration_event_update.bind_value_as_i32(4, timeperiod_is_default);
+  _ba_duration_event_update.bind_value_as_i32(5, ba_id);
+  _ba_duration_event_update.bind_value_as_u64(6, real_start_time);
+  _ba_duration_event_update.bind_value_as_i32(7, timeperiod_id);
 
   std::promise<int> promise;
   std::future<int> future = promise.get_future();
-  int thread_id(_mysql.run_statement_and_get_int<int>(
-      _ba_duration_event_update, std::move(promise),
-      mysql_task::int_type::AFFECTED_ROWS));
+  _mysql.run_statement_and_get_int<int>(_ba_duration_event_update,
+                                        std::move(promise),
+                                        mysql_task::int_type::AFFECTED_ROWS,
+                                        _events_thread_id);
   try {
     // Insert if no rows was updated.
     if (future.get() == 0) {
-      _ba_duration_event_insert.bind_value_as_u64(0, bde.start_time());
-      _ba_duration_event_insert.bind_value_as_u64(1, bde.end_time());
-      _ba_duration_event_insert.bind_value_as_i32(2, bde.duration());
-      _ba_duration_event_insert.bind_value_as_i32(3, bde.sla_duration());
-      _ba_duration_event_insert.bind_value_as_i32(4, bde.timeperiod_id());
-      _ba_duration_event_insert.bind_value_as_f64(5,
-                                                  bde.timeperiod_is_default());
-      _ba_duration_event_insert.bind_value_as_i32(6, bde.ba_id());
-      _ba_duration_event_insert.bind_value_as_u64(7, bde.real_start_time());
+      _ba_duration_event_insert.bind_value_as_u64(0, start_time);
+      _ba_duration_event_insert.bind_value_as_u64(1, end_time);
+      _ba_duration_event_insert.bind_value_as_i32(2, duration);
+      _ba_duration_event_insert.bind_value_as_i32(3, sla_duration);
+      _ba_duration_event_insert.bind_value_as_i32(4, timeperiod_id);
+      _ba_duration_event_insert.bind_value_as_f64(5, timeperiod_is_default);
+      _ba_duration_event_insert.bind_value_as_i32(6, ba_id);
+      _ba_duration_event_insert.bind_value_as_u64(7, real_start_time);
 
       _mysql.run_statement(_ba_duration_event_insert,
-                           database::mysql_error::empty, thread_id);
+                           database::mysql_error::empty, _events_thread_id);
     }
+    ++_ba_duration_rows;
   } catch (std::exception const& e) {
     throw msg_fmt(
         "BAM-BI: could not insert duration event of BA {}"
         " starting at {} : {}",
-        bde.ba_id(), bde.start_time(), e.what());
+        ba_id, start_time, e.what());
   }
 }
 
@@ -1317,11 +1408,13 @@ void reporting_stream::_process_kpi_event(std::shared_ptr<io::data> const& e) {
   id_start kpi_key = std::make_pair(
       ke.kpi_id, static_cast<uint64_t>(ke.start_time.get_time_t()));
   // event exists?
-  if (_kpi_event_cache.find(kpi_key) != _kpi_event_cache.end()) {
+  auto found = _kpi_event_cache.find(kpi_key);
+  if (found != _kpi_event_cache.end()) {
     if (_kpi_event_update->is_bulk())
       _kpi_event_update->add_bulk_row(bulk_kpi_event_update_binder{e});
     else
-      _kpi_event_update->add_multi_row(kpi_event_update_binder{e});
+      _kpi_event_update->add_multi_row(
+          kpi_event_update_binder{found->second, e});
   } else {
     // don't exist.
     try {
@@ -1342,8 +1435,14 @@ void reporting_stream::_process_kpi_event(std::shared_ptr<io::data> const& e) {
 
       int thread_id(_mysql.run_statement_and_get_int<uint64_t>(
           _kpi_full_event_insert, std::move(result_kpi_insert),
-          mysql_task::LAST_INSERT_ID));
+          mysql_task::LAST_INSERT_ID, _events_thread_id));
       _kpi_event_cache[kpi_key] = future_kpi_insert.get();
+      ++_kpi_event_rows;
+
+      // The link is computed from the BA events, their pending updates
+      // must be written before.
+      if (_ba_event_pending_updates.contains(ke.ba_id))
+        _execute_batches();
 
       // Insert kpi event link.
       _kpi_event_link.bind_value_as_i32(0, ke.kpi_id);
@@ -1393,11 +1492,13 @@ void reporting_stream::_process_pb_kpi_event(
 
   id_start kpi_key = std::make_pair(ke.kpi_id(), ke.start_time());
   // event exists?
-  if (_kpi_event_cache.find(kpi_key) != _kpi_event_cache.end()) {
+  auto found = _kpi_event_cache.find(kpi_key);
+  if (found != _kpi_event_cache.end()) {
     if (_kpi_event_update->is_bulk())
       _kpi_event_update->add_bulk_row(bulk_kpi_event_update_binder{e});
     else
-      _kpi_event_update->add_multi_row(kpi_event_update_binder{e});
+      _kpi_event_update->add_multi_row(
+          kpi_event_update_binder{found->second, e});
   } else {
     // don't exist => insert one.
     try {
@@ -1416,8 +1517,14 @@ void reporting_stream::_process_pb_kpi_event(
 
       int thread_id(_mysql.run_statement_and_get_int<uint64_t>(
           _kpi_full_event_insert, std::move(result_kpi_insert),
-          mysql_task::LAST_INSERT_ID));
+          mysql_task::LAST_INSERT_ID, _events_thread_id));
       _kpi_event_cache[kpi_key] = future_kpi_insert.get();
+      ++_kpi_event_rows;
+
+      // The link is computed from the BA events, their pending updates
+      // must be written before.
+      if (_ba_event_pending_updates.contains(ke.ba_id()))
+        _execute_batches();
 
       // Insert kpi event link.
       _kpi_event_link.bind_value_as_i32(0, ke.kpi_id());
@@ -2144,6 +2251,10 @@ void reporting_stream::_process_rebuild(std::shared_ptr<io::data> const& e) {
 
   _update_status("rebuilding: querying ba events");
 
+  // The pending updates of events and durations must be in the database
+  // before it is queried.
+  _commit();
+
   // We block the availability thread to prevent it waking
   // up on truncated event durations.
   try {
@@ -2236,8 +2347,57 @@ void reporting_stream::_update_status(std::string const& status) {
 
 void reporting_stream::_commit() {
   _dimension_kpi_insert->execute(_mysql);
-  _kpi_event_update->execute(_mysql);
+  _execute_batches();
   _mysql.commit();
   _ack_events += _pending_events;
   _pending_events = 0;
+
+  // Rows written per second, computed over at least one second.
+  auto now = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed = now - _last_commit;
+  if (elapsed.count() >= 1) {
+    uint64_t rows = _ba_event_rows + _ba_duration_rows + _kpi_event_rows;
+    _rows_per_second = (rows - _last_commit_rows) / elapsed.count();
+    _last_commit_rows = rows;
+    _last_commit = now;
+  }
+}
+
+/**
+ *  Send the pending batches of events updates and of durations. They are all
+ *  sent on the connection used to insert events so that they are executed in
+ *  order.
+ */
+void reporting_stream::_execute_batches() {
+  uint32_t rows = _ba_event_update->row_count();
+  if (rows) {
+    _ba_event_update->execute(_mysql, database::mysql_error::update_ba_event,
+                              _events_thread_id);
+    _ba_event_rows += rows;
+  }
+  _ba_event_pending_updates.clear();
+
+  rows = _ba_duration_event_upsert->row_count();
+  if (rows) {
+    _ba_duration_event_upsert->execute(
+        _mysql, database::mysql_error::store_ba_duration, _events_thread_id);
+    _ba_duration_rows += rows;
+  }
+
+  rows = _kpi_event_update->row_count();
+  if (rows) {
+    _kpi_event_update->execute(_mysql, database::mysql_error::update_kpi_event,
+                               _events_thread_id);
+    _kpi_event_rows += rows;
+  }
+}
+
+/**
+ *  Tell if a batch is full or waits for too long.
+ *
+ *  @return true if the batches should be sent.
+ */
+bool reporting_stream::_batches_ready() {
+  return _ba_event_update->ready() || _ba_duration_event_upsert->ready() ||
+         _kpi_event_update->ready();
 }
@@ -0,0 +1,283 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#include "com/centreon/broker/bam/bool_program.hh"
+#include <gtest/gtest.h>
+#include <random>
+#include "bbdo/neb.pb.h"
+#include "com/centreon/broker/bam/bool_expression.hh"
+#include "com/centreon/broker/bam/exp_builder.hh"
+#include "com/centreon/broker/bam/exp_parser.hh"
+#include "com/centreon/broker/bam/kpi_boolexp.hh"
+#include "com/centreon/broker/bam/service_book.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+class BamBoolProgram : public ::testing::Test {
+ protected:
+  std::shared_ptr<spdlog::logger> _logger;
+  std::unique_ptr<bam::hst_svc_mapping> _mapping;
+
+  /**
+   * @brief Build a boolean expression from a string, the services are
+   * registered in the book.
+   *
+   * @param id The expression id.
+   * @param expression The expression.
+   * @param book The service book.
+   * @param compile true to compile the expression.
+   *
+   * @return The boolean expression.
+   */
+  std::shared_ptr<bam::bool_expression> _build(uint32_t id,
+                                               const std::string& expression,
+                                               bam::service_book& book,
+                                               bool compile) {
+    bam::exp_parser p(expression);
+    bam::exp_builder builder(p.get_postfix(), *_mapping, _logger);
+    bam::bool_value::ptr tree(builder.get_tree());
+    auto retval = std::make_shared<bam::bool_expression>(id, true, _logger);
+    retval->set_expression(tree);
+    tree->add_parent(retval);
+    for (auto& svc : builder.get_services())
+      book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
+    if (compile) {
+      EXPECT_TRUE(retval->compile());
+    }
+    return retval;
+  }
+
+  static std::shared_ptr<neb::pb_service_status>
+  _status(uint32_t service_id, int state, bool downtime = false) {
+    auto retval = std::make_shared<neb::pb_service_status>();
+    retval->mut_obj().set_host_id(1);
+    retval->mut_obj().set_service_id(service_id);
+    retval->mut_obj().set_state(static_cast<ServiceStatus::State>(state));
+    retval->mut_obj().set_last_hard_state(
+        static_cast<ServiceStatus::State>(state));
+    retval->mut_obj().set_scheduled_downtime_depth(downtime ? 1 : 0);
+    return retval;
+  }
+
+ public:
+  void SetUp() override {
+    _logger = log_v2::instance().get(log_v2::BAM);
+    try {
+      config::applier::init(0, "test_broker", 0);
+    } catch (std::exception const& e) {
+      (void)e;
+    }
+    _mapping = std::make_unique<bam::hst_svc_mapping>(_logger);
+    for (uint32_t i = 1; i <= 4; ++i)
+      _mapping->set_service("host_1", fmt::format("service_{}", i), 1, i,
+                            true);
+  }
+
+  void TearDown() override { config::applier::deinit(); }
+};
+
+static const std::vector<std::string> expressions{
+    "{host_1 service_1} {IS} {OK} {AND} {host_1 service_2} {NOT} {CRITICAL}",
+    "({host_1 service_1} {IS} {OK} {OR} {host_1 service_2} {IS} {OK}) {AND} "
+    "{host_1 service_3} {NOT} {UNKNOWN}",
+    "({host_1 service_1} {IS} {WARNING}) {XOR} ({host_1 service_2} {IS} "
+    "{WARNING})",
+    "{host_1 service_1} < {host_1 service_2}",
+    "{host_1 service_1} <= {host_1 service_3}",
+    "{host_1 service_1} > {host_1 service_2} {OR} {host_1 service_3} >= "
+    "{host_1 service_4}",
+    "({host_1 service_1} + {host_1 service_2}) >= 3",
+    "({host_1 service_3} - {host_1 service_1}) * 2 == 2",
+    "{host_1 service_3} % {host_1 service_2} == 1",
+    "{host_1 service_4} / {host_1 service_2} > 1",
+    "!({host_1 service_1} {IS} {OK} {AND} ({host_1 service_2} {IS} {OK} {OR} "
+    "{host_1 service_3} {IS} {CRITICAL}))",
+    /* A service in both operands of an operator. */
+    "{host_1 service_1} {IS} {OK} {OR} {host_1 service_1} {IS} {CRITICAL}",
+    "{host_1 service_1} {NOT} {OK} {AND} {host_1 service_1} {NOT} {WARNING}",
+    "({host_1 service_1} {IS} {WARNING}) {XOR} ({host_1 service_1} {IS} "
+    "{WARNING} {AND} {host_1 service_2} {NOT} {OK})",
+    "{host_1 service_2} - {host_1 service_2} == 0",
+    "{host_1 service_2} % ({host_1 service_2} / 2) == 0",
+};
+
+/**
+ * Each expression is built twice, once evaluated as a tree and once compiled.
+ * Both must give the same states for all the combinations of four services.
+ */
+TEST_F(BamBoolProgram, SameAsTree) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::service_book book(_logger);
+  std::vector<std::shared_ptr<bam::bool_expression>> trees, compiled;
+  uint32_t id = 1;
+  for (auto& e : expressions) {
+    trees.push_back(_build(id, e, book, false));
+    compiled.push_back(_build(id, e, book, true));
+    ++id;
+  }
+
+  /* All the services are known before the comparison. */
+  for (uint32_t svc = 1; svc <= 4; ++svc)
+    book.update(_status(svc, 0));
+
+  for (uint32_t combination = 0; combination < 256; ++combination) {
+    for (uint32_t svc = 1; svc <= 4; ++svc) {
+      int state = (combination >> (2 * (svc - 1))) & 3;
+      book.update(_status(svc, state));
+      for (size_t i = 0; i < expressions.size(); ++i) {
+        ASSERT_EQ(trees[i]->state_known(), compiled[i]->state_known())
+            << expressions[i] << " for combination " << combination;
+        if (trees[i]->state_known()) {
+          ASSERT_EQ(trees[i]->get_state(), compiled[i]->get_state())
+              << expressions[i] << " for combination " << combination;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * The services are unknown until their first status and some of them are in
+ * downtime. The tree and the program must give the same states and the same
+ * downtimes after each update, the operators keeping the values of their
+ * operands while one of them is unknown.
+ */
+TEST_F(BamBoolProgram, SameAsTreeWithUnknownAndDowntime) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::service_book book(_logger);
+  std::vector<std::shared_ptr<bam::bool_expression>> trees, compiled;
+  uint32_t id = 1;
+  for (auto& e : expressions) {
+    trees.push_back(_build(id, e, book, false));
+    compiled.push_back(_build(id, e, book, true));
+    ++id;
+  }
+
+  auto check = [&](uint32_t step) {
+    for (size_t i = 0; i < expressions.size(); ++i) {
+      ASSERT_EQ(trees[i]->state_known(), compiled[i]->state_known())
+          << expressions[i] << " at step " << step;
+      if (trees[i]->state_known()) {
+        ASSERT_EQ(trees[i]->get_state(), compiled[i]->get_state())
+            << expressions[i] << " at step " << step;
+      }
+      ASSERT_EQ(trees[i]->in_downtime(), compiled[i]->in_downtime())
+          << expressions[i] << " at step " << step;
+    }
+  };
+
+  check(0);
+  std::mt19937 gen(12345);
+  for (uint32_t step = 1; step <= 1000; ++step) {
+    /* The first steps only concern services 1 to 3, service 4 stays
+     * unknown. */
+    uint32_t svc = step < 50 ? gen() % 3 + 1 : gen() % 4 + 1;
+    book.update(_status(svc, gen() % 4, gen() % 3 == 0));
+    check(step);
+  }
+}
+
+/**
+ * A compiled expression notifies its kpi as the root of the tree does.
+ */
+TEST_F(BamBoolProgram, KpiBoolexp) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::service_book book(_logger);
+  auto exp = _build(1, "({host_1 service_1} {NOT} {CRITICAL})", book, true);
+  ASSERT_NE(exp->program(), nullptr);
+  ASSERT_EQ(exp->program()->operands().size(), 1u);
+
+  auto kpi =
+      std::make_shared<bam::kpi_boolexp>(1, 1, "test_boool_exp", _logger);
+  kpi->link_boolexp(exp);
+  exp->add_parent(kpi);
+
+  ASSERT_FALSE(exp->state_known());
+  ASSERT_TRUE(kpi->ok_state());
+
+  book.update(_status(1, 1));
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_FALSE(kpi->ok_state());
+
+  book.update(_status(1, 2));
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_TRUE(kpi->ok_state());
+}
+
+/**
+ * The result of AND and OR is known as soon as the left operand is enough,
+ * even if the right one is unknown.
+ */
+TEST_F(BamBoolProgram, ShortCircuit) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::service_book book(_logger);
+  auto exp = _build(1,
+                    "{host_1 service_1} {IS} {OK} {AND} ({host_1 service_2} "
+                    "{IS} {OK} {OR} {host_1 service_3} {IS} {OK})",
+                    book, true);
+  book.update(_status(1, 2));
+  /* The right operand of AND is unknown but the result is known. */
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_EQ(exp->get_state(), bam::state_ok);
+
+  book.update(_status(1, 0));
+  ASSERT_FALSE(exp->state_known());
+
+  book.update(_status(2, 0));
+  ASSERT_TRUE(exp->state_known());
+  ASSERT_EQ(exp->get_state(), bam::state_critical);
+}
+
+/**
+ * Thousands of expressions evaluated with the tree and with the compiled
+ * programs give the same states.
+ */
+TEST_F(BamBoolProgram, ManyExpressions) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  _logger->set_level(spdlog::level::info);
+  constexpr uint32_t count = 1000;
+  constexpr uint32_t updates = 200;
+  bam::service_book book(_logger);
+  std::vector<std::shared_ptr<bam::bool_expression>> trees, compiled;
+  trees.reserve(count);
+  compiled.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    const std::string& e = expressions[i % expressions.size()];
+    trees.push_back(_build(i + 1, e, book, false));
+    compiled.push_back(_build(i + 1, e, book, true));
+  }
+
+  for (uint32_t i = 0; i < updates; ++i)
+    book.update(_status(i % 4 + 1, i / 4 % 4, i % 5 == 0));
+
+  for (uint32_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(trees[i]->state_known());
+    ASSERT_EQ(trees[i]->state_known(), compiled[i]->state_known());
+    ASSERT_EQ(trees[i]->get_state(), compiled[i]->get_state());
+    ASSERT_EQ(trees[i]->in_downtime(), compiled[i]->in_downtime());
+  }
+}
@@ -0,0 +1,226 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#include "com/centreon/broker/bam/daily_availabilities.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/misc/time.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+namespace {
+struct event {
+  uint32_t ba_id;
+  short status;
+  time_t start;
+  time_t end;
+  bool in_downtime;
+};
+
+/* An availability as it would be inserted in the database. */
+using row = std::array<int, 10>;
+
+row to_row(const availability_builder& b) {
+  return {b.get_timeperiod_is_default(),
+          b.get_available(),
+          b.get_unavailable(),
+          b.get_degraded(),
+          b.get_unknown(),
+          b.get_downtime(),
+          b.get_unavailable_opened(),
+          b.get_degraded_opened(),
+          b.get_unknown_opened(),
+          b.get_downtime_opened()};
+}
+}  // namespace
+
+class BamDailyAvailabilities : public ::testing::Test {
+ protected:
+  /* mon. 29 mars 2021 */
+  const time_t _day_start = misc::start_of_day(1617026358);
+  const time_t _day_end = _day_start + 24 * 3600;
+  timeperiod_map _tps;
+  std::vector<event> _opened;
+  std::vector<event> _closed;
+  std::shared_ptr<spdlog::logger> _logger;
+
+  void SetUp() override {
+    _logger = log_v2::instance().get(log_v2::BAM);
+    _tps.add_timeperiod(
+        1, std::make_shared<time::timeperiod>(
+               1, "24x7", "24x7", "00:00-24:00", "00:00-24:00", "00:00-24:00",
+               "00:00-24:00", "00:00-24:00", "00:00-24:00", "00:00-24:00"));
+    _tps.add_timeperiod(
+        2, std::make_shared<time::timeperiod>(
+               2, "workhours", "workhours", "", "08:00-20:00", "08:00-20:00",
+               "08:00-20:00", "08:00-20:00", "08:00-20:00", ""));
+  }
+
+  /* nb_bas BAs, each one with the two timeperiods and nb_events closed
+   * events. One BA out of three has an opened event, one out of ten has only
+   * an opened event. */
+  void _generate(uint32_t nb_bas, uint32_t nb_events) {
+    for (uint32_t ba_id = 1; ba_id <= nb_bas; ++ba_id) {
+      _tps.add_relation(ba_id, 1, true);
+      _tps.add_relation(ba_id, 2, false);
+      time_t t = _day_start - 3600;
+      if (ba_id % 10) {
+        time_t step = (_day_end - t) / (nb_events + 1);
+        for (uint32_t i = 0; i < nb_events; ++i, t += step)
+          _closed.push_back({ba_id, static_cast<short>((ba_id + i) % 4), t,
+                             t + step, (ba_id + i) % 7 == 0});
+      }
+      if (ba_id % 3 == 0 || ba_id % 10 == 0)
+        _opened.push_back({ba_id, static_cast<short>(ba_id % 4), t, 0, false});
+    }
+  }
+
+  /* The availabilities computed with one builder per BA and timeperiod, as
+   * they were before daily_availabilities. */
+  std::map<std::pair<uint32_t, uint32_t>, row> _expected() {
+    std::map<std::pair<uint32_t, uint32_t>,
+             std::unique_ptr<availability_builder>>
+        builders;
+    auto get = [&](uint32_t ba_id, uint32_t tp_id) -> availability_builder& {
+      auto& b = builders[{ba_id, tp_id}];
+      if (!b)
+        b = std::make_unique<availability_builder>(_day_end, _day_start);
+      return *b;
+    };
+    for (auto& e : _closed)
+      for (uint32_t tp_id : {1u, 2u}) {
+        availability_builder& b = get(e.ba_id, tp_id);
+        b.add_event(e.status, e.start, e.end, e.in_downtime,
+                    _tps.get_timeperiod(tp_id), _logger);
+        b.set_timeperiod_is_default(tp_id == 1);
+      }
+    for (auto& e : _opened)
+      for (auto& tp : _tps.get_timeperiods_by_ba_id(e.ba_id)) {
+        availability_builder& b = get(e.ba_id, tp.first->get_id());
+        b.add_event(e.status, e.start, 0, e.in_downtime, tp.first, _logger);
+        b.set_timeperiod_is_default(tp.second);
+      }
+    std::map<std::pair<uint32_t, uint32_t>, row> retval;
+    for (auto& b : builders)
+      retval[b.first] = to_row(*b.second);
+    return retval;
+  }
+
+  /* Build the availabilities of BAs such that ba_id % workers = worker. */
+  uint64_t _build(uint32_t worker,
+                  uint32_t workers,
+                  const daily_availabilities::writer& w) {
+    daily_availabilities day(_day_start, _day_end, _tps, w, _logger);
+    for (auto& e : _opened)
+      if (e.ba_id % workers == worker)
+        day.add_opened_event(e.ba_id, e.status, e.start, e.in_downtime);
+    for (auto& e : _closed)
+      if (e.ba_id % workers == worker)
+        for (uint32_t tp_id : {1u, 2u})
+          day.add_closed_event(e.ba_id, tp_id, tp_id == 1, e.status, e.start,
+                               e.end, e.in_downtime);
+    day.finish();
+    return day.events_count();
+  }
+};
+
+// Given BAs with closed and opened events
+// When their availabilities are built BA after BA
+// Then they are the same as with one builder per BA and timeperiod
+// And each availability is written once
+TEST_F(BamDailyAvailabilities, SameAsBuilders) {
+  _generate(200, 10);
+  std::map<std::pair<uint32_t, uint32_t>, row> written;
+  _build(0, 1, [&](uint32_t ba_id, uint32_t tp_id,
+                   const availability_builder& b) {
+    ASSERT_TRUE(written.emplace(std::make_pair(ba_id, tp_id), to_row(b))
+                    .second);
+  });
+  ASSERT_EQ(written.size(), 400u);
+  ASSERT_EQ(written, _expected());
+}
+
+// Given a BA without any event
+// When the availabilities are built
+// Then nothing is written
+TEST_F(BamDailyAvailabilities, NoEvent) {
+  _tps.add_relation(1, 1, true);
+  daily_availabilities day(
+      _day_start, _day_end, _tps,
+      [](uint32_t, uint32_t, const availability_builder&) { FAIL(); },
+      _logger);
+  day.finish();
+  ASSERT_EQ(day.availabilities_count(), 0u);
+}
+
+// Given BAs with closed events
+// When the events of a BA are added
+// Then the availabilities of the previous BA are already written
+TEST_F(BamDailyAvailabilities, WrittenWhenNextBaStarts) {
+  _generate(9, 3);
+  std::vector<uint32_t> written;
+  daily_availabilities day(
+      _day_start, _day_end, _tps,
+      [&](uint32_t ba_id, uint32_t, const availability_builder&) {
+        written.push_back(ba_id);
+      },
+      _logger);
+  for (auto& e : _opened)
+    day.add_opened_event(e.ba_id, e.status, e.start, e.in_downtime);
+  for (auto& e : _closed) {
+    /* Two availabilities (one per timeperiod) for each previous BA. */
+    ASSERT_EQ(written.size(), 2 * (e.ba_id - 1));
+    for (uint32_t tp_id : {1u, 2u})
+      day.add_closed_event(e.ba_id, tp_id, tp_id == 1, e.status, e.start,
+                           e.end, e.in_downtime);
+  }
+  ASSERT_EQ(written.size(), 16u);
+  day.finish();
+  ASSERT_EQ(written.size(), 18u);
+}
+
+// Given BAs partitioned between four workers
+// When each worker builds its partition
+// Then all the availabilities are built once
+TEST_F(BamDailyAvailabilities, PartitionedWorkers) {
+  _generate(2000, 20);
+  const uint32_t workers = 4;
+  std::vector<std::map<std::pair<uint32_t, uint32_t>, row>> written(workers);
+  std::vector<uint64_t> events(workers);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < workers; ++i)
+    threads.emplace_back([&, i] {
+      events[i] = _build(i, workers, [&, i](uint32_t ba_id, uint32_t tp_id,
+                                            const availability_builder& b) {
+        written[i][{ba_id, tp_id}] = to_row(b);
+      });
+    });
+  for (auto& t : threads)
+    t.join();
+
+  std::map<std::pair<uint32_t, uint32_t>, row> all;
+  uint64_t all_events = 0;
+  for (uint32_t i = 0; i < workers; ++i) {
+    all.insert(written[i].begin(), written[i].end());
+    all_events += events[i];
+  }
+  ASSERT_EQ(all.size(), 4000u);
+  ASSERT_EQ(all_events, 2 * _closed.size() + _opened.size());
+  ASSERT_EQ(all, _expected());
+}
@@ -36,6 +36,21 @@ using namespace com::centreon::broker;
 using log_v2 = com::centreon::common::log_v2::log_v2;
 
 
+/* A parent counting the updates it receives. */
+class update_counter : public bam::computable {
+ public:
+  uint32_t count = 0;
+
+  update_counter(const std::shared_ptr<spdlog::logger>& logger)
+      : bam::computable(logger) {}
+  void update_from(bam::computable* child [[maybe_unused]],
+                   io::stream* visitor [[maybe_unused]]) override {
+    ++count;
+  }
+  std::string object_info() const override { return "update counter"; }
+  void dump(std::ofstream& output [[maybe_unused]]) const override {}
+};
+
 class BamExpBuilder : public ::testing::Test {
  protected:
   std::unique_ptr<test_visitor> _visitor;
@@ -512,6 +527,112 @@ TEST_F(BamExpBuilder, CritAndOkService3) {
   ASSERT_TRUE(b->boolean_value());
 }
 
+/* Only the downtime of service_1 changes, the values of the operators stay
+ * the same: the downtime must still go up to the root of the tree. */
+TEST_F(BamExpBuilder, OkAndOkServiceDowntime) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::exp_parser p(
+      "{host_1 service_1} {IS} {OK} {AND} {host_1 service_2} {IS} {OK}");
+  bam::hst_svc_mapping mapping(_logger);
+  mapping.set_service("host_1", "service_1", 1, 1, true);
+  mapping.set_service("host_1", "service_2", 1, 2, true);
+  bam::exp_builder builder(p.get_postfix(), mapping, _logger);
+  bam::bool_value::ptr b(builder.get_tree());
+
+  bam::service_book book(_logger);
+  for (auto& svc : builder.get_services())
+    book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
+
+  auto svc1 = std::make_shared<neb::pb_service_status>();
+  svc1->mut_obj().set_host_id(1);
+  svc1->mut_obj().set_service_id(1);
+  svc1->mut_obj().set_state(ServiceStatus::OK);
+  svc1->mut_obj().set_last_hard_state(ServiceStatus::OK);
+  book.update(svc1);
+
+  auto svc2 = std::make_shared<neb::pb_service_status>();
+  svc2->mut_obj().set_host_id(1);
+  svc2->mut_obj().set_service_id(2);
+  svc2->mut_obj().set_state(ServiceStatus::OK);
+  svc2->mut_obj().set_last_hard_state(ServiceStatus::OK);
+  book.update(svc2);
+
+  ASSERT_TRUE(b->state_known());
+  ASSERT_TRUE(b->boolean_value());
+  ASSERT_FALSE(b->in_downtime());
+
+  svc1->mut_obj().set_scheduled_downtime_depth(1);
+  book.update(svc1);
+
+  ASSERT_TRUE(b->state_known());
+  ASSERT_TRUE(b->boolean_value());
+  ASSERT_TRUE(b->in_downtime());
+
+  svc1->mut_obj().set_scheduled_downtime_depth(0);
+  book.update(svc1);
+
+  ASSERT_TRUE(b->state_known());
+  ASSERT_TRUE(b->boolean_value());
+  ASSERT_FALSE(b->in_downtime());
+}
+
+/* service_1 is in downtime, not service_2: a change of service_2 that does
+ * not change the value of its operand is not propagated by the AND. */
+TEST_F(BamExpBuilder, OkAndNotCritServiceDowntimeNoUpdate) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+  bam::exp_parser p(
+      "{host_1 service_1} {IS} {OK} {AND} {host_1 service_2} {NOT} "
+      "{CRITICAL}");
+  bam::hst_svc_mapping mapping(_logger);
+  mapping.set_service("host_1", "service_1", 1, 1, true);
+  mapping.set_service("host_1", "service_2", 1, 2, true);
+  bam::exp_builder builder(p.get_postfix(), mapping, _logger);
+  bam::bool_value::ptr b(builder.get_tree());
+  auto counter = std::make_shared<update_counter>(_logger);
+  b->add_parent(counter);
+
+  bam::service_book book(_logger);
+  for (auto& svc : builder.get_services())
+    book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
+
+  auto svc1 = std::make_shared<neb::pb_service_status>();
+  svc1->mut_obj().set_host_id(1);
+  svc1->mut_obj().set_service_id(1);
+  svc1->mut_obj().set_state(ServiceStatus::OK);
+  svc1->mut_obj().set_last_hard_state(ServiceStatus::OK);
+  svc1->mut_obj().set_scheduled_downtime_depth(1);
+  book.update(svc1);
+
+  auto svc2 = std::make_shared<neb::pb_service_status>();
+  svc2->mut_obj().set_host_id(1);
+  svc2->mut_obj().set_service_id(2);
+  svc2->mut_obj().set_state(ServiceStatus::OK);
+  svc2->mut_obj().set_last_hard_state(ServiceStatus::OK);
+  book.update(svc2);
+
+  ASSERT_TRUE(b->state_known());
+  ASSERT_TRUE(b->boolean_value());
+  ASSERT_TRUE(b->in_downtime());
+
+  counter->count = 0;
+  svc2->mut_obj().set_state(ServiceStatus::WARNING);
+  svc2->mut_obj().set_last_hard_state(ServiceStatus::WARNING);
+  book.update(svc2);
+
+  ASSERT_EQ(counter->count, 0u);
+  ASSERT_TRUE(b->boolean_value());
+  ASSERT_TRUE(b->in_downtime());
+
+  svc2->mut_obj().set_state(ServiceStatus::CRITICAL);
+  svc2->mut_obj().set_last_hard_state(ServiceStatus::CRITICAL);
+  book.update(svc2);
+
+  ASSERT_EQ(counter->count, 1u);
+  ASSERT_FALSE(b->boolean_value());
+}
+
 TEST_F(BamExpBuilder, NotCritService3) {
   config::applier::modules modules(_logger);
   modules.load_file("./broker/neb/10-neb.so");
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/bam/reporting_stream.hh"
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/broker/bam/internal.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "common/log_v2/log_v2.hh"
+
+using log_v2 = com::centreon::common::log_v2::log_v2;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+
+class BamReportingStream : public testing::Test {
+  void SetUp() override { config::applier::init(0, "test_broker", 0); }
+  void TearDown() override { config::applier::deinit(); }
+};
+
+// Given a reporting stream with a transaction of 1000 queries
+// And a BA event inserted by the stream
+// When the end of the event and its duration are written
+// Then they are kept in the batches until the stream is flushed
+// And the flush writes them and acknowledges the three events
+TEST_F(BamReportingStream, FlushBatchedEventsAndDurations) {
+  constexpr uint32_t ba_id = 987654;
+  constexpr uint64_t start = 1700000000;
+  database_config storage("MySQL", "127.0.0.1", "", 3306, "root", "centreon",
+                          "centreon_storage", 1000, true, 1, 3600);
+
+  mysql ms(storage);
+  ms.run_query(fmt::format(
+      "DELETE FROM mod_bam_reporting_ba_events WHERE ba_id={}", ba_id));
+  ms.commit();
+
+  std::unique_ptr<reporting_stream> rs;
+  ASSERT_NO_THROW(rs.reset(
+      new reporting_stream(storage, log_v2::instance().get(log_v2::BAM))));
+
+  auto opened = std::make_shared<pb_ba_event>();
+  opened->mut_obj().set_ba_id(ba_id);
+  opened->mut_obj().set_start_time(start);
+  opened->mut_obj().set_status(com::centreon::broker::State::OK);
+  ASSERT_EQ(rs->write(opened), 0);
+
+  auto closed = std::make_shared<pb_ba_event>();
+  closed->mut_obj().CopyFrom(opened->obj());
+  closed->mut_obj().set_end_time(start + 100);
+  closed->mut_obj().set_status(com::centreon::broker::State::CRITICAL);
+  ASSERT_EQ(rs->write(closed), 0);
+
+  auto duration = std::make_shared<pb_ba_duration_event>();
+  BaDurationEvent& d = duration->mut_obj();
+  d.set_ba_id(ba_id);
+  d.set_real_start_time(start);
+  d.set_start_time(start);
+  d.set_end_time(start + 100);
+  d.set_duration(100);
+  d.set_sla_duration(60);
+  d.set_timeperiod_id(1);
+  d.set_timeperiod_is_default(true);
+  ASSERT_EQ(rs->write(duration), 0);
+
+  nlohmann::json tree;
+  rs->statistics(tree);
+  ASSERT_EQ(tree["rows"]["ba_events"], 1u);
+  ASSERT_EQ(tree["rows"]["ba_events_durations"], 0u);
+
+  ASSERT_EQ(rs->flush(), 3);
+  tree.clear();
+  rs->statistics(tree);
+  ASSERT_EQ(tree["rows"]["ba_events"], 2u);
+  ASSERT_EQ(tree["rows"]["ba_events_durations"], 1u);
+
+  std::promise<database::mysql_result> promise;
+  std::future<database::mysql_result> future = promise.get_future();
+  ms.run_query_and_get_result(
+      fmt::format("SELECT e.end_time, e.status, d.duration, d.sla_duration, "
+                  "d.timeperiod_is_default FROM mod_bam_reporting_ba_events "
+                  "AS e INNER JOIN mod_bam_reporting_ba_events_durations AS d "
+                  "ON e.ba_event_id=d.ba_event_id WHERE e.ba_id={} AND "
+                  "d.timeperiod_id=1",
+                  ba_id),
+      std::move(promise));
+  database::mysql_result res{future.get()};
+  ASSERT_TRUE(ms.fetch_row(res));
+  ASSERT_EQ(res.value_as_u64(0), start + 100);
+  ASSERT_EQ(res.value_as_i32(1), 2);
+  ASSERT_EQ(res.value_as_i32(2), 100);
+  ASSERT_EQ(res.value_as_i32(3), 60);
+  ASSERT_TRUE(res.value_as_bool(4));
+  ASSERT_FALSE(ms.fetch_row(res));
+}
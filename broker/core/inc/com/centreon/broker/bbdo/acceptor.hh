@@ -48,6 +48,7 @@ class acceptor : public io::endpoint {
   uint32_t _ack_limit;
   std::list<std::shared_ptr<io::extension>> _extensions;
   const bool _grpc_serialized;
+  bool _prefilter;
 
  public:
   acceptor(std::string name, bool negotiate, time_t timeout,
@@ -61,6 +62,7 @@ class acceptor : public io::endpoint {
   std::shared_ptr<io::stream> open() override;
   void stats(nlohmann::json& tree) override;
   bool is_output() const { return _is_output; }
+  void set_prefilter(bool prefilter);
 
  private:
   uint32_t _negotiate_features(std::shared_ptr<io::stream> stream,
@@ -38,6 +38,7 @@ class connector : public io::endpoint {
   uint32_t _ack_limit;
   std::list<std::shared_ptr<io::extension>> _extensions;
   const bool _grpc_serialized;
+  bool _prefilter;
 
   std::shared_ptr<io::stream> _open(std::shared_ptr<io::stream> stream);
 
@@ -50,6 +51,7 @@ class connector : public io::endpoint {
   connector(const connector&) = delete;
   connector& operator=(const connector&) = delete;
   std::shared_ptr<io::stream> open() override;
+  void set_prefilter(bool prefilter);
 };
 }  // namespace com::centreon::broker::bbdo
 
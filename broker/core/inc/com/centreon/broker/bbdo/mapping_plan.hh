@@ -0,0 +1,75 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_BBDO_MAPPING_PLAN_HH
+#define CCB_BBDO_MAPPING_PLAN_HH
+
+#include "com/centreon/broker/io/event_info.hh"
+
+namespace com::centreon::broker::bbdo {
+
+/**
+ *  @class mapping_plan mapping_plan.hh
+ * "com/centreon/broker/bbdo/mapping_plan.hh"
+ *  @brief Legacy BBDO serialization of a mapped event type.
+ *
+ *  The mapping of an event type is walked once to build a flat list of
+ *  operations, each one made of a wire type and of the offset of the member
+ *  in the object. So the serialization and the unserialization of an event
+ *  do not need anymore to go through the mapping sources virtual methods.
+ *
+ *  The offsets are computed on an object built with the event constructor,
+ *  they are valid for all the objects of this type.
+ */
+class mapping_plan {
+ public:
+  enum op_type : uint8_t {
+    BOOL,
+    DOUBLE,
+    INT,
+    SHORT,
+    STRING,
+    TIME,
+    UINT,
+    ULONG
+  };
+
+  struct op {
+    op_type type;
+    uint32_t offset;
+  };
+
+ private:
+  std::vector<op> _ops;
+  /* Size of the serialized non string fields, doubles excepted. */
+  size_t _fixed_size;
+
+ public:
+  mapping_plan(const io::event_info& info);
+  ~mapping_plan() noexcept = default;
+  mapping_plan(const mapping_plan&) = delete;
+  mapping_plan& operator=(const mapping_plan&) = delete;
+
+  void serialize(const io::data& e, std::vector<char>& buffer) const;
+  void unserialize(io::data& e, const char* buffer, uint32_t size) const;
+  const std::vector<op>& ops() const { return _ops; }
+};
+
+}  // namespace com::centreon::broker::bbdo
+
+#endif  // !CCB_BBDO_MAPPING_PLAN_HH
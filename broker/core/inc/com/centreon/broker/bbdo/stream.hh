@@ -20,9 +20,11 @@
 #define CCB_BBDO_STREAM_HH
 
 #include "bbdo/bbdo/bbdo_version.hh"
+#include "com/centreon/broker/bbdo/mapping_plan.hh"
 #include "com/centreon/broker/io/extension.hh"
 #include "com/centreon/broker/io/raw.hh"
 #include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/multiplexing/muxer_filter.hh"
 
 namespace com::centreon::broker::bbdo {
 /**
@@ -145,6 +147,23 @@ class stream : public io::stream {
    */
   std::deque<std::shared_ptr<io::data>> _grpc_serialized_queue;
 
+  /* Pre-filtering: when enabled, events that no muxer wants are not
+   * unserialized. _wanted_events is a copy of the multiplexing engine
+   * subscribers filter, refreshed when its version changes. */
+  bool _prefilter;
+  uint32_t _wanted_events_version;
+  multiplexing::muxer_filter _wanted_events;
+  uint64_t _events_parsed;
+  uint64_t _events_skipped;
+
+  /* Output: events written with their received payload vs serialized. */
+  uint64_t _events_passed_through;
+  uint64_t _events_serialized;
+
+  /* Compiled mappings of the legacy events, by event type. */
+  absl::flat_hash_map<const io::event_info*, std::unique_ptr<mapping_plan>>
+      _plans;
+
   /**
    * It is possible to mix bbdo stream with others like tls or compression.
    * This list of extensions provides a simple access to others ones with
@@ -158,6 +177,8 @@ class stream : public io::stream {
 
   void _write(std::shared_ptr<io::data> const& d);
   bool _read_any(std::shared_ptr<io::data>& d, time_t deadline);
+  bool _event_wanted(uint32_t event_id);
+  const mapping_plan& _get_plan(const io::event_info& info);
   void _send_event_stop_and_wait_for_ack();
   std::string _get_extension_names(bool mandatory) const;
   std::string _poller_name;
@@ -165,8 +186,8 @@ class stream : public io::stream {
   io::data* unserialize(uint32_t event_type,
                         uint32_t source_id,
                         uint32_t destination_id,
-                        const char* buffer,
-                        uint32_t size);
+                        std::vector<char>&& content,
+                        size_t offset);
   io::raw* serialize(const io::data& e);
 
  public:
@@ -186,6 +207,7 @@ class stream : public io::stream {
   void set_ack_limit(uint32_t limit);
   void set_coarse(bool coarse);
   void set_negotiate(bool negotiate);
+  void set_prefilter(bool prefilter);
   void set_timeout(int timeout);
   void statistics(nlohmann::json& tree) const override;
   int write(std::shared_ptr<io::data> const& d) override;
@@ -55,23 +55,28 @@ inline bool operator!=(const string& left, const std::string_view& right) {
   return left.compare(0, right.length(), right.data()) != 0;
 }
 
+/**
+ * @brief metric names and units are very repetitive (rta, pl, ms, %...), so
+ * they are stored once in the string pool of the cache and shared by all the
+ * metrics using them.
+ */
+using interned_string = interprocess::offset_ptr<const string>;
+
 struct metric_info {
-  template <class string_view_class>
   metric_info(uint64_t i_index_id,
-              const string_view_class& i_name,
-              const string_view_class& i_unit,
+              const string* i_name,
+              const string* i_unit,
               double i_min,
-              double i_max,
-              const char_allocator& char_alloc)
+              double i_max)
       : index_id(i_index_id),
-        name(i_name.data(), i_name.length(), char_alloc),
-        unit(i_unit.data(), i_unit.length(), char_alloc),
+        name(i_name),
+        unit(i_unit),
         min(i_min),
         max(i_max) {}
 
   uint64_t index_id;
-  string name;
-  string unit;
+  interned_string name;
+  interned_string unit;
   double min;
   double max;
 };
@@ -129,6 +134,8 @@ struct resource_info {
  *
  *
  * a flag _dirty indicates if the file has been closed gracefully
+ * a layout_version is also stored in the file, a file written with another
+ * layout is recreated
  */
 class global_cache : public std::enable_shared_from_this<global_cache> {
  private:
@@ -165,6 +172,8 @@ class global_cache : public std::enable_shared_from_this<global_cache> {
 
   static pointer instance_ptr() { return _instance; }
 
+  static constexpr uint32_t layout_version = 2;
+
   virtual ~global_cache();
 
   /**
@@ -182,6 +191,14 @@ class global_cache : public std::enable_shared_from_this<global_cache> {
   // use only for tests
   const void* get_address() const;
 
+  size_t file_size() const;
+  size_t used_size() const;
+
+  virtual size_t string_pool_size() const = 0;
+  /* Called when an existing file is opened, there is no compaction while
+   * the cache is running. */
+  virtual size_t compact_string_pool() = 0;
+
   virtual void set_metric_info(uint64_t metric_id,
                                uint64_t index_id,
                                const std::string_view& name,
@@ -45,15 +45,20 @@ namespace multi_index = boost::multi_index;
  *
  */
 struct string_string_view_equal {
+  using is_transparent = void;
+  bool operator()(const string& left, const string& right) const {
+    return left == right;
+  }
   bool operator()(const string& left, const std::string_view& right) const {
-    return left.compare(0, right.length(), right.data()) == 0;
+    return std::string_view(left.c_str(), left.length()) == right;
   }
   bool operator()(const std::string_view& left, const string& right) const {
-    return right.compare(0, left.length(), left.data()) == 0;
+    return std::string_view(right.c_str(), right.length()) == left;
   }
 };
 
 struct string_string_view_hash {
+  using is_transparent = void;
   size_t operator()(const string& left) const {
     return absl::Hash<std::string_view>()(
         std::string_view(left.c_str(), left.length()));
@@ -80,6 +85,13 @@ class global_cache_data : public global_cache {
   using metric_info_allocator = com::centreon::common::
       node_allocator<metric_info, char_allocator, 0x10000>;
 
+  /* Node based, so interned strings never move. */
+  using string_pool =
+      boost::unordered_set<string,
+                           string_string_view_hash,
+                           string_string_view_equal,
+                           managed_mapped_file::allocator<string>::type>;
+
   using index_id_mapping =
       interprocess::flat_map<uint64_t,
                              host_serv_pair,
@@ -216,6 +228,7 @@ class global_cache_data : public global_cache {
 
   id_to_metric_info* _metric_info;
   metric_info_allocator* _metric_info_allocator;
+  string_pool* _string_pool;
   index_id_mapping* _index_id_mapping;
 
   id_to_host* _id_to_host;
@@ -229,10 +242,24 @@ class global_cache_data : public global_cache {
 
   void managed_map(bool create) override;
 
+  const string* _intern(const std::string_view& str);
+
  public:
+  /**
+   * @brief sizes of a cache file read by read_info() without opening the
+   * cache
+   */
+  struct file_info {
+    size_t file_size;
+    size_t used_size;
+    size_t string_pool_size;
+  };
+
   global_cache_data(const std::string& file_path)
       : global_cache(file_path, log_v2::instance().get(log_v2::CORE)) {}
 
+  static file_info read_info(const std::string& file_path);
+
   void set_metric_info(uint64_t metric_id,
                        uint64_t index_id,
                        const std::string_view& name,
@@ -260,6 +287,9 @@ class global_cache_data : public global_cache {
 
   const metric_info* get_metric_info(uint32_t metric_id) const override;
 
+  size_t string_pool_size() const override;
+  size_t compact_string_pool() override;
+
   const resource_info* get_host(uint64_t host_id) const override;
   const resource_info* get_host_from_index_id(uint64_t index_id) const override;
   const resource_info* get_service(uint64_t host_id,
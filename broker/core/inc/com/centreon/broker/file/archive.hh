@@ -0,0 +1,224 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_FILE_ARCHIVE_HH
+#define CCB_FILE_ARCHIVE_HH
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace com::centreon::broker::file {
+
+/**
+ *  On disk format of BBDO archives.
+ *
+ *  An archive is a list of segments named <path>.<id> where id is a six digits
+ *  number incremented at each new segment. Segments are only appended, a
+ *  segment is never reopened for writing, a restarted writer starts a new
+ *  one.
+ *
+ *  A segment starts with segment_magic and its id (u64), then comes a list of
+ *  blocks. A block is made of a block_header_size bytes header:
+ *  * block_magic (u32)
+ *  * flags (u32), block_compressed if the payload is zlib compressed
+ *  * raw size (u32), size of the uncompressed payload
+ *  * stored size (u32), size of the payload following the header
+ *  * number of events (u32)
+ *  * crc32 of the stored payload (u32)
+ *  * first and last timestamps of the block (i64)
+ *  The uncompressed payload is a list of events, each one is an
+ *  event_header_size bytes header (size (u32), timestamp offset from the first
+ *  timestamp of the block (i32)) followed by the BBDO packets of the event.
+ *
+ *  Each segment has a sparse index named <path>.<id>.idx. It starts with
+ *  index_magic and the segment id, then there is one index_record_size bytes
+ *  record per block:
+ *  * offset of the block in the segment (u64)
+ *  * first and last timestamps (i64)
+ *  * a 64 bits bloom filter of the event types of the block (u64)
+ *  * number of events (u32)
+ *  * stored size (u32)
+ *  * reserved (u64)
+ *
+ *  A block is always entirely written before its index record. Readers only
+ *  trust the index, so they can read an archive while it is written and a
+ *  block partially written by a crashed writer is ignored.
+ *
+ *  All integers are little endian. Timestamps are the arrival times of the
+ *  events in seconds.
+ */
+namespace archive_format {
+constexpr char segment_magic[8] = {'C', 'B', 'A', 'R', 'S', 'E', 'G', '1'};
+constexpr char index_magic[8] = {'C', 'B', 'A', 'R', 'I', 'D', 'X', '1'};
+constexpr uint32_t block_magic = 0x4b4c4243u;
+constexpr uint32_t block_compressed = 1u;
+constexpr size_t segment_header_size = 16;
+constexpr size_t block_header_size = 40;
+constexpr size_t index_header_size = 16;
+constexpr size_t index_record_size = 48;
+constexpr size_t event_header_size = 8;
+}  // namespace archive_format
+
+/**
+ *  Description of a block, as stored in the index.
+ */
+struct archive_block_info {
+  uint64_t offset = 0;
+  int64_t first_ts = 0;
+  int64_t last_ts = 0;
+  uint64_t types = 0;
+  uint32_t nb_events = 0;
+  uint32_t stored_size = 0;
+
+  static uint64_t type_bit(uint32_t type);
+  bool may_contain(uint64_t types_mask) const { return types & types_mask; }
+};
+
+/**
+ *  An archived event. data points to the BBDO packets of the event, it is
+ *  valid until the next call to archive_reader::next().
+ */
+struct archive_event {
+  int64_t ts;
+  uint32_t type;
+  std::string_view data;
+};
+
+/**
+ *  @class archive_writer archive.hh "com/centreon/broker/file/archive.hh"
+ *  @brief Append events to a BBDO archive.
+ *
+ *  Events are accumulated in memory until the block reaches block_size bytes
+ *  or its first event is older than max_block_age seconds. The block is then
+ *  compressed and appended to the current segment with one write, followed by
+ *  its index record. When the segment exceeds max_segment_size, a new one is
+ *  started.
+ *
+ *  Only one thread may use a writer.
+ */
+class archive_writer {
+  const std::string _base_path;
+  const uint64_t _max_segment_size;
+  const uint32_t _block_size;
+  const int _compression_level;
+  const time_t _max_block_age;
+
+  uint64_t _segment_id;
+  int _segment_fd;
+  int _index_fd;
+  uint64_t _segment_size;
+
+  std::vector<char> _block;
+  archive_block_info _current;
+  std::vector<char> _stored;
+
+  uint64_t _nb_events;
+  uint64_t _nb_blocks;
+  uint64_t _raw_bytes;
+  uint64_t _stored_bytes;
+
+  void _open_segment();
+  void _close_segment();
+  void _write_block();
+
+ public:
+  archive_writer(const std::string& path,
+                 uint64_t max_segment_size = 1000000000u,
+                 uint32_t block_size = 256 * 1024,
+                 int compression_level = 1,
+                 time_t max_block_age = 5);
+  ~archive_writer() noexcept;
+  archive_writer(const archive_writer&) = delete;
+  archive_writer& operator=(const archive_writer&) = delete;
+
+  void write(const char* data, size_t size, int64_t ts);
+  void flush();
+
+  /* Events still in memory, in the block not written yet. */
+  uint32_t pending_events() const {
+    return _block.empty() ? 0 : _current.nb_events;
+  }
+
+  uint64_t segment_id() const { return _segment_id; }
+  uint64_t nb_events() const { return _nb_events; }
+  uint64_t nb_blocks() const { return _nb_blocks; }
+  uint64_t raw_bytes() const { return _raw_bytes; }
+  uint64_t stored_bytes() const { return _stored_bytes; }
+};
+
+/**
+ *  @class archive_reader archive.hh "com/centreon/broker/file/archive.hh"
+ *  @brief Read events from a BBDO archive.
+ *
+ *  The reader has its own file descriptors and only reads what is referenced
+ *  by the indexes, so it can run concurrently with a writer, in another thread
+ *  or another process. When next() returns false, the reader is at the end of
+ *  the archive, a later call returns the events written since.
+ *
+ *  seek() uses the indexes to find the first block containing events not
+ *  older than the given timestamp, only this block is decompressed. Blocks
+ *  whose bloom filter does not match the type filter are skipped without
+ *  being read.
+ */
+class archive_reader {
+  const std::string _base_path;
+
+  uint64_t _segment_id;
+  int _segment_fd;
+  int _index_fd;
+  std::vector<archive_block_info> _index;
+  size_t _next_block;
+
+  std::vector<char> _stored;
+  std::vector<char> _raw;
+  size_t _raw_offset;
+  int64_t _block_first_ts;
+
+  int64_t _min_ts;
+  uint64_t _types_mask;
+  std::vector<uint32_t> _types;
+
+  bool _open_segment(uint64_t id);
+  void _close_segment();
+  void _refresh_index();
+  bool _next_segment();
+  void _read_block(const archive_block_info& info);
+  bool _accept(uint32_t type) const;
+
+ public:
+  archive_reader(const std::string& path);
+  ~archive_reader() noexcept;
+  archive_reader(const archive_reader&) = delete;
+  archive_reader& operator=(const archive_reader&) = delete;
+
+  static std::vector<uint64_t> segments(const std::string& path);
+  static std::vector<archive_block_info> read_index(const std::string& path,
+                                                    uint64_t id);
+  static std::string segment_path(const std::string& path, uint64_t id);
+
+  void set_type_filter(const std::vector<uint32_t>& types);
+  void seek(int64_t ts);
+  bool next(archive_event& ev);
+};
+
+}  // namespace com::centreon::broker::file
+
+#endif  // !CCB_FILE_ARCHIVE_HH
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_FILE_ARCHIVE_FACTORY_HH
+#define CCB_FILE_ARCHIVE_FACTORY_HH
+
+#include "com/centreon/broker/io/extension.hh"
+#include "com/centreon/broker/io/factory.hh"
+
+namespace com::centreon::broker::file {
+/**
+ *  @class archive_factory archive_factory.hh
+ * "com/centreon/broker/file/archive_factory.hh"
+ *  @brief Build archive endpoints.
+ *
+ *  An archive endpoint is an 'archive' typed endpoint. Above it, the BBDO
+ *  layer is used without negotiation nor compression, compression is done
+ *  by the archive on whole blocks.
+ */
+class archive_factory : public io::factory {
+ public:
+  archive_factory() = default;
+  archive_factory(const archive_factory&) = delete;
+  ~archive_factory() = default;
+  archive_factory& operator=(const archive_factory&) = delete;
+  bool has_endpoint(config::endpoint& cfg, io::extension* ext) override;
+  io::endpoint* new_endpoint(
+      config::endpoint& cfg,
+      const std::map<std::string, std::string>& global_params,
+      bool& is_acceptor,
+      std::shared_ptr<persistent_cache> cache =
+          std::shared_ptr<persistent_cache>()) const override;
+};
+}  // namespace com::centreon::broker::file
+
+#endif  // !CCB_FILE_ARCHIVE_FACTORY_HH
@@ -0,0 +1,43 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_FILE_ARCHIVE_OPENER_HH
+#define CCB_FILE_ARCHIVE_OPENER_HH
+
+#include "com/centreon/broker/file/archive_stream.hh"
+#include "com/centreon/broker/io/endpoint.hh"
+
+namespace com::centreon::broker::file {
+/**
+ *  @class archive_opener archive_opener.hh
+ * "com/centreon/broker/file/archive_opener.hh"
+ *  @brief Open an archive stream.
+ */
+class archive_opener : public io::endpoint {
+  const archive_config _config;
+
+ public:
+  archive_opener(const archive_config& config);
+  archive_opener(const archive_opener& other);
+  ~archive_opener() noexcept = default;
+  archive_opener& operator=(const archive_opener&) = delete;
+  std::shared_ptr<io::stream> open() override;
+};
+}  // namespace com::centreon::broker::file
+
+#endif  // !CCB_FILE_ARCHIVE_OPENER_HH
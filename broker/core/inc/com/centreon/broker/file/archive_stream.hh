@@ -0,0 +1,75 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_FILE_ARCHIVE_STREAM_HH
+#define CCB_FILE_ARCHIVE_STREAM_HH
+
+#include "com/centreon/broker/file/archive.hh"
+#include "com/centreon/broker/io/stream.hh"
+
+namespace com::centreon::broker::file {
+
+/**
+ *  Parameters of an archive endpoint.
+ */
+struct archive_config {
+  std::string path;
+  uint64_t max_segment_size = 1000000000u;
+  uint32_t block_size = 256 * 1024;
+  int compression_level = 1;
+  time_t max_block_age = 5;
+  /* Input only: events older than this timestamp are not replayed. */
+  int64_t replay_from = 0;
+};
+
+/**
+ *  @class archive_stream archive_stream.hh
+ * "com/centreon/broker/file/archive_stream.hh"
+ *  @brief BBDO archive stream.
+ *
+ *  As output, the serialized events received from the BBDO layer are appended
+ *  to the archive with their arrival time. As input, the archive is replayed
+ *  from replay_from and then followed as it is written.
+ */
+class archive_stream : public io::stream {
+  const archive_config _config;
+  std::unique_ptr<archive_writer> _writer;
+  std::unique_ptr<archive_reader> _reader;
+  /* Events received and not acknowledged yet, because the block containing
+   * them is not written. */
+  int32_t _pending_events;
+  std::shared_ptr<spdlog::logger> _logger;
+
+  int32_t _acknowledge();
+
+ public:
+  archive_stream(const archive_config& config);
+  ~archive_stream() noexcept = default;
+  archive_stream(const archive_stream&) = delete;
+  archive_stream& operator=(const archive_stream&) = delete;
+  std::string peer() const override;
+  bool read(std::shared_ptr<io::data>& d, time_t deadline) override;
+  void statistics(nlohmann::json& tree) const override;
+  int32_t write(std::shared_ptr<io::data> const& d) override;
+  int flush() override;
+  int32_t stop() override;
+};
+
+}  // namespace com::centreon::broker::file
+
+#endif  // !CCB_FILE_ARCHIVE_STREAM_HH
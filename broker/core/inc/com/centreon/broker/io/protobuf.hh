@@ -23,6 +23,9 @@
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/util/message_differencer.h>
 
+#include <memory>
+#include <mutex>
+
 #include "com/centreon/broker/io/data.hh"
 #include "com/centreon/broker/io/event_info.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
@@ -45,16 +48,45 @@ namespace com::centreon::broker::io {
  *  This class is very important when we want to parse a protobuf message
  *  without knowing about its exact type. This is very useful with reflection
  *  (see code in Lua module for more examples).
+ *
+ *  A message read by a bbdo stream is not parsed immediately: the stream
+ *  gives it the buffer it has been received in with set_payload() and the
+ *  parsing is done on the first access to the message, the buffer is then
+ *  released. As long as no one accessed the message, a bbdo output can write
+ *  the payload again as is instead of serializing the message (see
+ *  payload()).
  */
 class protobuf_base : public data {
+ public:
+  /**
+   * @brief A received payload: the buffer of the packet it has been read in
+   * and the position of the message in it.
+   */
+  struct payload_buffer {
+    std::vector<char> buffer;
+    size_t offset;
+    const char* data() const { return buffer.data() + offset; }
+    size_t size() const { return buffer.size() - offset; }
+  };
+
+ private:
   google::protobuf::Message* _msg;
 
+  /* The wire payload, parsed once into _msg when needed and then released.
+   * An output may still be writing it while another thread parses the
+   * message, so it is shared and accessed with std::atomic_load/store. */
+  mutable std::shared_ptr<const payload_buffer> _payload;
+  uint16_t _payload_version;
+  mutable std::once_flag _parsed;
+
  protected:
   protobuf_base(uint32_t typ, google::protobuf::Message* msg)
-      : data(typ), _msg{msg} {}
+      : data(typ), _msg{msg}, _payload_version{0} {}
 
   void set_message(google::protobuf::Message* msg) { _msg = msg; }
 
+  void _parse_payload() const;
+
  public:
   enum attribute {
     always_valid = 0,
@@ -67,14 +99,66 @@ class protobuf_base : public data {
    *
    * @return a google::protobuf::Message* pointer.
    */
-  google::protobuf::Message* mut_msg() { return _msg; }
+  google::protobuf::Message* mut_msg() {
+    _parse_payload();
+    return _msg;
+  }
 
   /**
    * @brief Accessor to the protouf::Message* pointer.
    *
    * @return a google::protobuf::Message* pointer.
    */
-  const google::protobuf::Message* msg() const { return _msg; }
+  const google::protobuf::Message* msg() const {
+    _parse_payload();
+    return _msg;
+  }
+
+  /**
+   * @brief Accessor to the descriptor of the message, the payload is not
+   * parsed.
+   *
+   * @return a google::protobuf::Descriptor* pointer.
+   */
+  const google::protobuf::Descriptor* descriptor() const {
+    return _msg->GetDescriptor();
+  }
+
+  /**
+   * @brief Give to this message the buffer it has been received in. The
+   * buffer is moved, not copied. The message is parsed later on the first
+   * access to it. This must be called before any other access to the
+   * message.
+   *
+   * @param buffer The buffer containing the serialized protobuf message.
+   * The bbdo stream has checked its structure, so the parsing should not
+   * fail.
+   * @param offset The position of the message in buffer.
+   * @param version The BBDO major version used to receive it.
+   */
+  void set_payload(std::vector<char>&& buffer,
+                   size_t offset,
+                   uint16_t version) {
+    _payload_version = version;
+    std::atomic_store(&_payload,
+                      std::make_shared<const payload_buffer>(
+                          payload_buffer{std::move(buffer), offset}));
+  }
+
+  /**
+   * @brief Get the payload if it can be written as is on a BBDO stream, this
+   * is the case if the message has not been accessed since its reception and
+   * if the stream uses the same BBDO version.
+   *
+   * @param version The BBDO major version of the stream.
+   *
+   * @return The payload or nullptr if the message must be serialized.
+   */
+  std::shared_ptr<const payload_buffer> payload(uint16_t version) const {
+    if (_payload_version != version)
+      return nullptr;
+    return std::atomic_load(&_payload);
+  }
 };
 
 /**
@@ -121,11 +205,12 @@ class protobuf : public protobuf_base {
   }
 
   protobuf(const protobuf& to_clone) : protobuf_base(Typ, &_obj) {
-    _obj.CopyFrom(to_clone._obj);
+    _obj.CopyFrom(to_clone.obj());
   }
 
   protobuf& operator=(const protobuf& to_clone) {
-    _obj.CopyFrom(to_clone._obj);
+    _parse_payload();
+    _obj.CopyFrom(to_clone.obj());
     return *this;
   }
 
@@ -181,11 +266,20 @@ class protobuf : public protobuf_base {
     return retval.release();
   }
 
-  virtual const T& obj() const { return _obj; }
+  virtual const T& obj() const {
+    _parse_payload();
+    return _obj;
+  }
 
-  virtual T& mut_obj() { return _obj; }
+  virtual T& mut_obj() {
+    _parse_payload();
+    return _obj;
+  }
 
-  virtual void set_obj(T&& obj) { _obj = std::move(obj); }
+  virtual void set_obj(T&& obj) {
+    _parse_payload();
+    _obj = std::move(obj);
+  }
 
   void dump(std::ostream& s) const override;
   void dump_more_detail(std::ostream& s) const override;
@@ -253,6 +253,7 @@ class entry {
   uint32_t get_uint(const io::data& d) const;
   uint64_t get_ulong(const io::data& d) const;
   unsigned short get_ushort(const io::data& d) const;
+  uint32_t get_offset(const io::data& d) const;
   /**
    *  Get if this entry is a null entry.
    *
@@ -297,6 +297,52 @@ class property : public source {
     static_cast<T*>(&d)->*(_prop.l) = value;
   }
 
+  /**
+   *  Get the offset of the property from the beginning of the object. It is
+   *  the same for all the objects of type T.
+   *
+   *  @param[in] d    Object to get from.
+   *  @param[in] type The property type.
+   *
+   *  @return The property offset in bytes.
+   */
+  uint32_t get_offset(io::data const& d, source_type type) override {
+    T const* obj = static_cast<T const*>(&d);
+    void const* addr;
+    switch (type) {
+      case BOOL:
+        addr = &(obj->*(_prop.b));
+        break;
+      case DOUBLE:
+        addr = &(obj->*(_prop.d));
+        break;
+      case INT:
+        addr = &(obj->*(_prop.i));
+        break;
+      case SHORT:
+        addr = &(obj->*(_prop.s));
+        break;
+      case STRING:
+        addr = &(obj->*(_prop.q));
+        break;
+      case TIME:
+        addr = &(obj->*(_prop.t));
+        break;
+      case UINT:
+        addr = &(obj->*(_prop.I));
+        break;
+      case USHORT:
+        addr = &(obj->*(_prop.S));
+        break;
+      case ULONG:
+        addr = &(obj->*(_prop.l));
+        break;
+      default:
+        return 0;
+    }
+    return static_cast<char const*>(addr) - reinterpret_cast<char const*>(&d);
+  }
+
   /**
    *  Set an unsigned short property.
    *
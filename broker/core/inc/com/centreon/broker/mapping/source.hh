@@ -66,6 +66,7 @@ class source {
   virtual uint32_t get_uint(io::data const& d) = 0;
   virtual uint64_t get_ulong(io::data const& d) = 0;
   virtual unsigned short get_ushort(io::data const& d) = 0;
+  virtual uint32_t get_offset(io::data const& d, source_type type) = 0;
 
   virtual void set_bool(io::data& d, bool value) = 0;
   virtual void set_double(io::data& d, double value) = 0;
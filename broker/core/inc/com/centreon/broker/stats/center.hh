@@ -19,10 +19,70 @@
 #ifndef CCB_STATS_CENTER_HH
 #define CCB_STATS_CENTER_HH
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/synchronization/mutex.h>
 #include "broker.pb.h"
 
 namespace com::centreon::broker::stats {
+
+/**
+ * @brief A value written by hot paths with a relaxed store and read by the
+ * center when statistics are requested.
+ */
+class gauge {
+  std::atomic<uint64_t> _value{0};
+
+ public:
+  void set(uint64_t value) noexcept {
+    _value.store(value, std::memory_order_relaxed);
+  }
+  uint64_t get() const noexcept {
+    return _value.load(std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief A counter incremented concurrently by many threads. Each thread
+ * works on its own shard, on its own cache line, so an increment is a
+ * relaxed atomic addition without contention. Shards are only summed when
+ * the value is read.
+ */
+class counter {
+  static constexpr size_t _shards_count = 16;
+  struct alignas(64) shard {
+    std::atomic<uint64_t> value{0};
+  };
+  std::array<shard, _shards_count> _shards;
+
+  static size_t _shard_index() noexcept;
+
+ public:
+  void add(uint64_t value = 1) noexcept {
+    _shards[_shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+  }
+  uint64_t get() const noexcept;
+};
+
+/**
+ * @brief Counters of a muxer, refreshed by the muxer each time its queue
+ * changes.
+ */
+struct muxer_counters {
+  gauge total_events;
+  gauge unacknowledged_events;
+  std::atomic_bool queue_file_open{false};
+  /* Status events replaced in the queue by a newer one. */
+  counter coalesced_events;
+};
+
+/**
+ * @brief Counters of the multiplexing engine.
+ */
+struct engine_counters {
+  gauge processed_events;
+  counter published_events;
+};
+
 /**
  * @brief Centralize Broker statistics.
  *
@@ -46,6 +106,12 @@ namespace com::centreon::broker::stats {
  * * update(_stats->mutable_state(), state)
  *   sets the std::string state() of the _stats EndpointStats object to the
  *   value value.
+ *
+ * Components updating their statistics very often (muxers, the
+ * multiplexing engine) do not use the mutex: they get a block of counters
+ * (muxer_counters, engine_counters) that they update with relaxed atomic
+ * operations. These blocks are copied into the protobuf statistics only
+ * when they are read (to_string(), gRPC getters...).
  */
 class center {
   static std::shared_ptr<center> _instance;
@@ -53,6 +119,16 @@ class center {
   mutable absl::Mutex _stats_m;
   int _json_stats_file_creation;
 
+  struct muxer_block {
+    std::string queue_file;
+    std::shared_ptr<muxer_counters> counters;
+  };
+  absl::flat_hash_map<std::string, muxer_block> _muxer_counters
+      ABSL_GUARDED_BY(_stats_m);
+  engine_counters _engine_counters;
+
+  void _collect() ABSL_EXCLUSIVE_LOCKS_REQUIRED(_stats_m);
+
  public:
   center();
 
@@ -62,13 +138,15 @@ class center {
   std::string to_string() ABSL_LOCKS_EXCLUDED(_stats_m);
 
   EngineStats* register_engine() ABSL_LOCKS_EXCLUDED(_stats_m);
+  engine_counters& get_engine_counters() noexcept { return _engine_counters; }
+  std::shared_ptr<muxer_counters> register_muxer(const std::string& name,
+                                                 const std::string& queue_file)
+      ABSL_LOCKS_EXCLUDED(_stats_m);
   ConflictManagerStats* register_conflict_manager()
       ABSL_LOCKS_EXCLUDED(_stats_m);
-  void unregister_muxer(const std::string& name) ABSL_LOCKS_EXCLUDED(_stats_m);
-  void update_muxer(std::string name,
-                    std::string queue_file,
-                    uint32_t size,
-                    uint32_t unack) ABSL_LOCKS_EXCLUDED(_stats_m);
+  void unregister_muxer(const std::string& name,
+                        const std::shared_ptr<muxer_counters>& counters)
+      ABSL_LOCKS_EXCLUDED(_stats_m);
   void init_queue_file(std::string muxer,
                        std::string queue_file,
                        uint32_t max_file_size) ABSL_LOCKS_EXCLUDED(_stats_m);
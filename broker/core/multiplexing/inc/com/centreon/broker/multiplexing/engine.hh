@@ -20,6 +20,7 @@
 #define CCB_MULTIPLEXING_ENGINE_HH
 
 #include <absl/base/thread_annotations.h>
+#include "com/centreon/broker/multiplexing/muxer_filter.hh"
 #include "com/centreon/broker/persistent_cache.hh"
 #include "com/centreon/broker/stats/center.hh"
 
@@ -59,6 +60,11 @@ class callback_caller;
  *    written to a cache file ...unprocessed... This file will be re-read at the
  *    next broker start.
  *
+ *  The engine also maintains the union of the write filters of its muxers.
+ *  Inputs use it to skip the decoding of events that no output wants. Each
+ *  modification of this filter increments a global version so that readers
+ *  only have to compare versions to know their copy is up to date.
+ *
  *  @see muxer
  */
 class engine {
@@ -80,6 +86,10 @@ class engine {
   // Subscriber.
   std::vector<std::weak_ptr<muxer>> _muxers ABSL_GUARDED_BY(_kiew_m);
 
+  // Events wanted by at least one subscriber.
+  static std::atomic_uint32_t _subscribers_filter_version;
+  muxer_filter _subscribers_filter ABSL_GUARDED_BY(_kiew_m);
+
   // Statistics.
   std::shared_ptr<stats::center> _center;
   EngineStats* _stats;
@@ -91,6 +101,7 @@ class engine {
   engine(const std::shared_ptr<spdlog::logger>& logger);
   std::string _cache_file_path() const;
   bool _send_to_subscribers(send_to_mux_callback_type&& callback);
+  void _update_subscribers_filter() ABSL_EXCLUSIVE_LOCKS_REQUIRED(_kiew_m);
 
   friend class detail::callback_caller;
 
@@ -112,6 +123,19 @@ class engine {
   void subscribe(const std::shared_ptr<muxer>& subscriber)
       ABSL_LOCKS_EXCLUDED(_kiew_m);
   void unsubscribe_muxer(const muxer* subscriber) ABSL_LOCKS_EXCLUDED(_kiew_m);
+  void update_subscribers_filter() ABSL_LOCKS_EXCLUDED(_kiew_m);
+  muxer_filter subscribers_filter(uint32_t& version)
+      ABSL_LOCKS_EXCLUDED(_kiew_m);
+
+  /**
+   * @brief Version of the subscribers filter, it changes each time the filter
+   * of an engine is computed again.
+   *
+   * @return A version number.
+   */
+  static uint32_t subscribers_filter_version() {
+    return _subscribers_filter_version.load(std::memory_order_acquire);
+  }
 };
 }  // namespace com::centreon::broker::multiplexing
 
@@ -20,6 +20,7 @@
 #define CCB_MULTIPLEXING_MUXER_HH
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <absl/synchronization/mutex.h>
 
 #include "com/centreon/broker/multiplexing/engine.hh"
@@ -47,6 +48,11 @@ namespace com::centreon::broker::multiplexing {
  *  * read(): it is used to get the next available event for the
  * failover/feeder.
  *
+ *  When status coalescing is enabled (see set_coalesce_status()), a host or
+ * service status event published while an older status of the same resource
+ * is still waiting to be read replaces this one in place. Other events are
+ * never touched.
+ *
  *  @see engine
  */
 class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
@@ -65,7 +71,9 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
   std::shared_ptr<engine> _engine;
   const std::string _queue_file_name;
   multiplexing::muxer_filter _read_filter;
-  multiplexing::muxer_filter _write_filter;
+  /* Read by publish() and by the engine when it computes the filter of its
+   * subscribers, it is protected by _events_m. */
+  multiplexing::muxer_filter _write_filter ABSL_GUARDED_BY(_events_m);
   std::string _read_filters_str;
   std::string _write_filters_str;
   const bool _persistent;
@@ -83,7 +91,22 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
   std::unique_ptr<persistent_file> _file ABSL_GUARDED_BY(_events_m);
   absl::CondVar _no_event_cv;
 
+  /* Status coalescing. The key is (event type, host id, service id). Only
+   * events not read yet (from _pos to the end) are in _pending_status. Keys
+   * written to _file are kept in _status_in_file, a newer status of these
+   * keys must follow them in the file to keep the order. When _file was
+   * already there at the muxer creation, its content is unknown and nothing
+   * is coalesced until it is consumed. */
+  using status_key = std::tuple<uint32_t, uint64_t, uint64_t>;
+  bool _coalesce_status ABSL_GUARDED_BY(_events_m);
+  absl::flat_hash_map<status_key,
+                      std::list<std::shared_ptr<io::data>>::iterator>
+      _pending_status ABSL_GUARDED_BY(_events_m);
+  absl::flat_hash_set<status_key> _status_in_file ABSL_GUARDED_BY(_events_m);
+  bool _file_content_unknown ABSL_GUARDED_BY(_events_m);
+
   std::shared_ptr<stats::center> _center;
+  std::shared_ptr<stats::muxer_counters> _counters;
   std::time_t _last_stats;
 
   /* The map of running muxers with the mutex to protect it. */
@@ -99,6 +122,11 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(_events_m);
   void _push_to_queue(std::shared_ptr<io::data> const& event)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(_events_m);
+  void _forget_pending_status(
+      std::list<std::shared_ptr<io::data>>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(_events_m);
+  void _reset_file() ABSL_EXCLUSIVE_LOCKS_REQUIRED(_events_m);
+  static bool _get_status_key(const io::data& d, status_key& key);
 
   void _update_stats(void) noexcept ABSL_EXCLUSIVE_LOCKS_REQUIRED(_events_m);
 
@@ -131,6 +159,7 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
       ABSL_LOCKS_EXCLUDED(_events_m);
   const std::string& read_filters_as_str() const;
   const std::string& write_filters_as_str() const;
+  muxer_filter write_filter() const ABSL_LOCKS_EXCLUDED(_events_m);
   uint32_t get_event_queue_size() const ABSL_LOCKS_EXCLUDED(_events_m);
   void nack_events() ABSL_LOCKS_EXCLUDED(_events_m)
       ABSL_LOCKS_EXCLUDED(_events_m);
@@ -143,7 +172,9 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
   int32_t stop() override;
   const std::string& name() const;
   void set_read_filter(const muxer_filter& w_filter);
-  void set_write_filter(const muxer_filter& w_filter);
+  void set_write_filter(const muxer_filter& w_filter)
+      ABSL_LOCKS_EXCLUDED(_events_m);
+  void set_coalesce_status(bool enabled) ABSL_LOCKS_EXCLUDED(_events_m);
   void clear_read_handler();
   void unsubscribe();
   void set_action_on_new_data(const std::shared_ptr<data_handler>& handler)
@@ -172,6 +203,8 @@ bool muxer::read(container& to_fill, size_t max_to_read) noexcept {
   size_t nb_read = 0;
   while (_pos != _events.end() && nb_read < max_to_read) {
     to_fill.push_back(*_pos);
+    if (!_pending_status.empty())
+      _forget_pending_status(_pos);
     ++_pos;
     ++nb_read;
   }
@@ -43,6 +43,8 @@ absl::Mutex engine::_load_m;
  *
  *  @return Class instance.
  */
+std::atomic_uint32_t engine::_subscribers_filter_version{0};
+
 std::shared_ptr<engine> engine::instance_ptr() {
   return _instance;
 }
@@ -171,6 +173,7 @@ void engine::start() {
       SPDLOG_LOGGER_DEBUG(_logger, "multiplexing: engine starting");
       _state = running;
       _center->update(&EngineStats::set_mode, _stats, EngineStats::RUNNING);
+      _update_subscribers_filter();
 
       // Local queue.
       std::deque<std::shared_ptr<io::data>> kiew;
@@ -219,6 +222,7 @@ void engine::stop() {
     // Set writing method.
     _state = stopped;
     _center->update(&EngineStats::set_mode, _stats, EngineStats::STOPPED);
+    _update_subscribers_filter();
     lck.Release();
     // Notify hooks of multiplexing loop end.
     SPDLOG_LOGGER_INFO(_logger, "multiplexing: stopping engine");
@@ -261,6 +265,7 @@ void engine::subscribe(const std::shared_ptr<muxer>& subscriber) {
       return;
     }
   _muxers.push_back(subscriber);
+  _update_subscribers_filter();
 }
 
 /**
@@ -285,11 +290,54 @@ void engine::unsubscribe_muxer(const muxer* subscriber) {
                     subscriber->name());
 
       _muxers.erase(it);
+      _update_subscribers_filter();
       return;
     }
   }
 }
 
+/**
+ * @brief Compute again the union of the write filters of the subscribers, for
+ * example after a muxer filter change.
+ */
+void engine::update_subscribers_filter() {
+  absl::MutexLock lck(&_kiew_m);
+  _update_subscribers_filter();
+}
+
+/**
+ * @brief Compute the union of the write filters of the subscribers. While the
+ * engine is not running, events are kept for muxers that may not be
+ * subscribed yet, so all the events are wanted.
+ */
+void engine::_update_subscribers_filter() {
+  if (_state != running)
+    _subscribers_filter = muxer_filter();
+  else {
+    muxer_filter filter{muxer_filter::zero_init()};
+    for (auto& w : _muxers) {
+      auto m = w.lock();
+      if (m)
+        filter |= m->write_filter();
+    }
+    _subscribers_filter = filter;
+  }
+  _subscribers_filter_version.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Get the events wanted by at least one subscriber.
+ *
+ * @param version Filled with the version of the returned filter.
+ *
+ * @return A copy of the filter.
+ */
+muxer_filter engine::subscribers_filter(uint32_t& version) {
+  absl::MutexLock lck(&_kiew_m);
+  version = _subscribers_filter_version.load(std::memory_order_acquire);
+  return _subscribers_filter;
+}
+
 /**
  *  Default constructor.
  */
@@ -430,8 +478,9 @@ bool engine::_send_to_subscribers(send_to_mux_callback_type&& callback) {
     }
   }
   if (first_muxer) {
-    _center->update(&EngineStats::set_processed_events, _stats,
-                    static_cast<uint32_t>(kiew->size()));
+    stats::engine_counters& counters = _center->get_engine_counters();
+    counters.processed_events.set(kiew->size());
+    counters.published_events.add(kiew->size());
     /* The same work but by this thread for the last muxer. */
     first_muxer->publish(*kiew);
     return true;
@@ -21,10 +21,12 @@
 
 #include <cassert>
 
+#include "bbdo/neb.pb.h"
 #include "com/centreon/broker/bbdo/internal.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/io/protobuf.hh"
 #include "com/centreon/broker/misc/misc.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/common/pool.hh"
@@ -35,6 +37,13 @@ using namespace com::centreon::broker;
 using namespace com::centreon::broker::multiplexing;
 using log_v2 = com::centreon::common::log_v2::log_v2;
 
+/* The status events that can be coalesced. They are declared here as in the
+ * neb module, the muxer does not depend on it. */
+using pb_host_status =
+    io::protobuf<HostStatus, make_type(io::neb, neb::de_pb_host_status)>;
+using pb_service_status =
+    io::protobuf<ServiceStatus, make_type(io::neb, neb::de_pb_service_status)>;
+
 static absl::Mutex _add_bench_point_m;
 /**
  * @brief add a bench point to pb_bench event
@@ -88,7 +97,10 @@ muxer::muxer(std::string name,
       _write_filters_str{misc::dump_filters(w_filter)},
       _persistent(persistent),
       _events_size{0u},
+      _coalesce_status{false},
+      _file_content_unknown{false},
       _center{stats::center::instance_ptr()},
+      _counters{_center->register_muxer(_name, _queue_file_name)},
       _last_stats{std::time(nullptr)},
       _logger{log_v2::instance().get(log_v2::CORE)} {
   absl::SetMutexDeadlockDetectionMode(absl::OnDeadlockCycle::kAbort);
@@ -134,6 +146,8 @@ muxer::muxer(std::string name,
     // Queue file was entirely read back.
     (void)e;
   }
+  /* Statuses still in the queue file are not known. */
+  _file_content_unknown = static_cast<bool>(_file);
 
   _update_stats();
 
@@ -217,7 +231,7 @@ muxer::~muxer() noexcept {
 
   // caution, unregister_muxer must be the last center method called at muxer
   // destruction to avoid re create a muxer stat entry
-  _center->unregister_muxer(_name);
+  _center->unregister_muxer(_name, _counters);
 }
 
 /**
@@ -410,6 +424,19 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
             _name, event->type());
         continue;
       }
+      /* A status can replace an older one waiting in memory only if no status
+       * of the same resource is in the retention file. */
+      status_key key;
+      bool is_status = _coalesce_status && _get_status_key(*event, key);
+      if (is_status && !_file_content_unknown &&
+          !_status_in_file.contains(key)) {
+        auto found = _pending_status.find(key);
+        if (found != _pending_status.end()) {
+          *found->second = event;
+          _counters->coalesced_events.add();
+          continue;
+        }
+      }
       if (event->type() == bbdo::pb_bench::static_type()) {
         add_bench_point(*std::static_pointer_cast<bbdo::pb_bench>(event), _name,
                         "retention_publish");
@@ -423,6 +450,8 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
       }
       try {
         _file->write(event);
+        if (is_status)
+          _status_in_file.insert(key);
         SPDLOG_LOGGER_TRACE(
             _logger,
             "{} publish one event of type {:x} to file {} queue size:{}", _name,
@@ -432,7 +461,7 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
         // infinite loop in case of permanent disk problem
         SPDLOG_LOGGER_ERROR(_logger, "{} fail to write event to {}: {}", _name,
                             _queue_file_name, ex.what());
-        _file.reset();
+        _reset_file();
       }
     }
     _update_stats();
@@ -466,6 +495,8 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
 
     if (_pos != _events.end()) {
       event = *_pos;
+      if (!_pending_status.empty())
+        _forget_pending_status(_pos);
       ++_pos;
       if (event)
         timed_out = false;
@@ -475,6 +506,8 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
   // Data is available, no need to wait.
   else {
     event = *_pos;
+    if (!_pending_status.empty())
+      _forget_pending_status(_pos);
     ++_pos;
   }
 
@@ -560,6 +593,9 @@ void muxer::statistics(nlohmann::json& tree) const {
   for (auto it = _events.begin(); it != _pos; ++it)
     count++;
   tree["unacknowledged_events"] = count;
+
+  if (_coalesce_status)
+    tree["coalesced_events"] = _counters->coalesced_events.get();
 }
 
 /**
@@ -628,8 +664,8 @@ void muxer::write(std::deque<std::shared_ptr<io::data>>& to_publish) {
  *  Warning: _events_m must be locked to call this function.
  */
 void muxer::_clean() {
-  _file.reset();
-  _center->clear_muxer_queue_file(_name);
+  _reset_file();
+  _pending_status.clear();
   if (_persistent && !_events.empty()) {
     try {
       SPDLOG_LOGGER_TRACE(_logger, "muxer: sending {} events to {}",
@@ -668,8 +704,7 @@ void muxer::_get_event_from_file(std::shared_ptr<io::data>& event) {
     } catch (exceptions::shutdown const& e) {
       // The file end was reach.
       (void)e;
-      _file.reset();
-      _center->clear_muxer_queue_file(_name);
+      _reset_file();
     }
   }
 }
@@ -706,11 +741,27 @@ std::string muxer::queue_file(std::string const& name) {
  *  @param[in] event  New event.
  */
 void muxer::_push_to_queue(std::shared_ptr<io::data> const& event) {
+  status_key key;
+  bool is_status = _coalesce_status && _get_status_key(*event, key);
+  if (is_status) {
+    auto found = _pending_status.find(key);
+    if (found != _pending_status.end()) {
+      SPDLOG_LOGGER_TRACE(_logger,
+                          "muxer {} event of type {:x} replaces an older one",
+                          _name, event->type());
+      *found->second = event;
+      _counters->coalesced_events.add();
+      return;
+    }
+  }
+
   bool pos_has_no_more_to_read(_pos == _events.end());
   SPDLOG_LOGGER_TRACE(_logger, "muxer {} event of type {:x} pushed", _name,
                       event->type());
   _events.push_back(event);
   ++_events_size;
+  if (is_status)
+    _pending_status.emplace(key, std::prev(_events.end()));
 
   if (pos_has_no_more_to_read) {
     _pos = --_events.end();
@@ -719,19 +770,74 @@ void muxer::_push_to_queue(std::shared_ptr<io::data> const& event) {
 }
 
 /**
- * @brief Fill statistics if it happened more than 1 second ago
+ * @brief Get the coalescing key of a status event.
+ *
+ * @param d The event.
+ * @param key The key filled if d is a host or a service status.
+ *
+ * @return true if d is a status that can be coalesced.
+ */
+bool muxer::_get_status_key(const io::data& d, status_key& key) {
+  switch (d.type()) {
+    case pb_service_status::static_type(): {
+      const ServiceStatus& obj =
+          static_cast<const pb_service_status&>(d).obj();
+      key = {d.type(), obj.host_id(), obj.service_id()};
+      return true;
+    }
+    case pb_host_status::static_type():
+      key = {d.type(), static_cast<const pb_host_status&>(d).obj().host_id(),
+             0};
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief An event is about to be read, if it is a status, it cannot be
+ * replaced anymore (_events_m is locked when this method is called).
+ *
+ * @param it The position of the event in _events.
+ */
+void muxer::_forget_pending_status(
+    std::list<std::shared_ptr<io::data>>::iterator it) {
+  status_key key;
+  if (_get_status_key(**it, key)) {
+    auto found = _pending_status.find(key);
+    if (found != _pending_status.end() && found->second == it)
+      _pending_status.erase(found);
+  }
+}
+
+/**
+ * @brief Close the retention file, its statuses are forgotten
+ * (_events_m is locked when this method is called).
+ */
+void muxer::_reset_file() {
+  _file.reset();
+  _center->clear_muxer_queue_file(_name);
+  _status_in_file.clear();
+  _file_content_unknown = false;
+}
+
+/**
+ * @brief Fill statistics. They are only relaxed stores in the muxer
+ * counters, the center reads them when statistics are requested. The
+ * unacknowledged events count needs to walk the queue, so it is only
+ * computed once per second.
  *
  * Warning: _events_m must be locked before while calling this function.
  */
 void muxer::_update_stats() noexcept {
+  _counters->total_events.set(_events_size);
+  _counters->queue_file_open.store(static_cast<bool>(_file),
+                                   std::memory_order_relaxed);
   std::time_t now{std::time(nullptr)};
   if (now - _last_stats > 0) {
     _last_stats = now;
-    /* Since _events_m is locked, we can get interesting values and copy them
-     * in the capture. Then the execute() function can put them in the stats
-     * object asynchronously. */
-    _center->update_muxer(_name, _file ? _queue_file_name : "", _events_size,
-                          std::distance(_events.begin(), _pos));
+    _counters->unacknowledged_events.set(
+        std::distance(_events.begin(), _pos));
   }
 }
 
@@ -776,8 +882,23 @@ void muxer::set_read_filter(const muxer_filter& r_filter) {
  */
 void muxer::set_write_filter(const muxer_filter& w_filter) {
   _logger->trace("multiplexing: '{}' set write filter...", _name);
-  _write_filter = w_filter;
+  {
+    absl::MutexLock lck(&_events_m);
+    _write_filter = w_filter;
+  }
   _write_filters_str = misc::dump_filters(w_filter);
+  _engine->update_subscribers_filter();
+}
+
+/**
+ * @brief Accessor to the write filter. The engine calls it with its own
+ * mutex locked, so _events_m must never be held while calling the engine.
+ *
+ * @return A copy of the write filter.
+ */
+muxer_filter muxer::write_filter() const {
+  absl::MutexLock lck(&_events_m);
+  return _write_filter;
 }
 
 /**
@@ -788,6 +909,23 @@ void muxer::unsubscribe() {
   _engine->unsubscribe_muxer(this);
 }
 
+/**
+ * @brief Enable or disable the coalescing of status events. When enabled, a
+ * host or service status waiting in the queue is replaced by a newer status
+ * of the same resource, so a late output only receives the last states.
+ *
+ * @param enabled true to enable the coalescing.
+ */
+void muxer::set_coalesce_status(bool enabled) {
+  absl::MutexLock lck(&_events_m);
+  if (_coalesce_status != enabled)
+    SPDLOG_LOGGER_INFO(_logger, "multiplexing: '{}' status coalescing {}",
+                       _name, enabled ? "enabled" : "disabled");
+  _coalesce_status = enabled;
+  if (!enabled)
+    _pending_status.clear();
+}
+
 void muxer::set_action_on_new_data(
     const std::shared_ptr<data_handler>& handler) {
   absl::MutexLock lck(&_events_m);
@@ -23,6 +23,7 @@
 #include "com/centreon/broker/io/raw.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/broker/multiplexing/muxer_filter.hh"
+#include "com/centreon/broker/neb/internal.hh"
 
 using namespace com::centreon::broker;
 
@@ -140,3 +141,74 @@ TEST_F(MultiplexingMuxerRead, AckEventsPartial) {
   _m->read(d, 0);
   ASSERT_TRUE(!d);
 }
+
+// Given a muxer object with status coalescing enabled
+// And statuses of the same resources given to publish() between other events
+// When I read() the events
+// Then I get the last status of each resource at the place of the first one
+// And the other events are untouched
+TEST_F(MultiplexingMuxerRead, CoalesceStatus) {
+  multiplexing::muxer_filter f{io::raw::static_type(),
+                               neb::pb_host_status::static_type(),
+                               neb::pb_service_status::static_type()};
+  _m = multiplexing::muxer::create("MultiplexingMuxerRead_CoalesceStatus",
+                                   multiplexing::engine::instance_ptr(), f, f,
+                                   false);
+  _m->set_coalesce_status(true);
+
+  auto service_status = [](uint64_t service_id, int32_t state) {
+    auto ss = std::make_shared<neb::pb_service_status>();
+    ss->mut_obj().set_host_id(1);
+    ss->mut_obj().set_service_id(service_id);
+    ss->mut_obj().set_state(static_cast<ServiceStatus_State>(state));
+    return ss;
+  };
+  auto host_status = [](int32_t state) {
+    auto hs = std::make_shared<neb::pb_host_status>();
+    hs->mut_obj().set_host_id(1);
+    hs->mut_obj().set_state(static_cast<HostStatus_State>(state));
+    return hs;
+  };
+
+  std::deque<std::shared_ptr<io::data>> q;
+  q.push_back(service_status(1, 0));
+  q.push_back(std::make_shared<io::raw>());
+  q.push_back(host_status(0));
+  q.push_back(service_status(1, 2));
+  q.push_back(service_status(2, 1));
+  q.push_back(host_status(1));
+  q.push_back(service_status(1, 1));
+  _m->publish(q);
+  ASSERT_EQ(_m->get_event_queue_size(), 4u);
+
+  std::shared_ptr<io::data> d;
+  _m->read(d, 0);
+  ASSERT_EQ(d->type(), neb::pb_service_status::static_type());
+  ASSERT_EQ(std::static_pointer_cast<neb::pb_service_status>(d)->obj().state(),
+            ServiceStatus_State_WARNING);
+
+  /* This status is read, a new one is queued after the others. */
+  q = {service_status(1, 2)};
+  _m->publish(q);
+
+  _m->read(d, 0);
+  ASSERT_EQ(d->type(), io::raw::static_type());
+  _m->read(d, 0);
+  ASSERT_EQ(d->type(), neb::pb_host_status::static_type());
+  ASSERT_EQ(std::static_pointer_cast<neb::pb_host_status>(d)->obj().state(),
+            HostStatus_State_DOWN);
+  _m->read(d, 0);
+  ASSERT_EQ(std::static_pointer_cast<neb::pb_service_status>(d)
+                ->obj()
+                .service_id(),
+            2u);
+  _m->read(d, 0);
+  ASSERT_EQ(std::static_pointer_cast<neb::pb_service_status>(d)->obj().state(),
+            ServiceStatus_State_CRITICAL);
+  _m->read(d, 0);
+  ASSERT_TRUE(!d);
+
+  nlohmann::json tree;
+  _m->statistics(tree);
+  ASSERT_EQ(tree["coalesced_events"].get<uint64_t>(), 3u);
+}
@@ -210,6 +210,8 @@ class mysql_bulk_stmt : public mysql_stmt_base {
 
   std::unique_ptr<mysql_bulk_bind> create_bind();
   void set_bind(std::unique_ptr<mysql_bulk_bind>&& bind);
+  void next_row();
+  size_t rows_count() const;
 };
 
 }  // namespace database
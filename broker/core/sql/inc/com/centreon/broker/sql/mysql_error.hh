@@ -110,6 +110,8 @@ class mysql_error {
     delete_resources_tags = 74,
     clean_resources = 75,
     delete_poller = 76,
+    update_ba_event = 77,
+    store_ba_duration = 78,
   };
 
   static constexpr const char* msg[]{
@@ -191,6 +193,8 @@ class mysql_error {
       "could not delete entry in resources_tags table: ",
       "could not clean the resources table: ",
       "could not delete poller: ",
+      "could not update BA event: ",
+      "could not store BA duration event: ",
   };
 
   mysql_error() : _active(false) {}
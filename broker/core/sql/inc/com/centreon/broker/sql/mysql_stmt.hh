@@ -39,7 +39,6 @@ class mysql_stmt : public mysql_stmt_base {
   mysql_stmt& operator=(const mysql_stmt&) = delete;
   mysql_stmt& operator=(mysql_stmt&& other);
   std::unique_ptr<database::mysql_bind> get_bind();
-  void operator<<(io::data const& d);
 
   /**
    * @brief Set the given value at the column in the prepared statement at index
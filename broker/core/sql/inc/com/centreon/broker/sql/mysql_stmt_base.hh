@@ -407,6 +407,7 @@ class mysql_stmt_base {
 
   const std::string& get_query() const;
   size_t get_param_count() const;
+  void operator<<(io::data const& d);
   void set_pb_mapping(
       std::vector<std::tuple<std::string, uint32_t, uint16_t>>&& mapping);
   const std::vector<std::tuple<std::string, uint32_t, uint16_t>>&
@@ -22,6 +22,9 @@
 #include "com/centreon/broker/sql/mysql.hh"
 
 namespace com::centreon::broker {
+namespace io {
+class event_info;
+}
 
 /**
  *  @class query_preparator query_preparator.hh
@@ -40,7 +43,7 @@ namespace com::centreon::broker {
  *
  *  Once, the query preparator constructed, we can use it to prepare:
  *  * an insert statement
- *  * an update statement
+ *  * an update statement, or a bulk one to update many rows at once.
  *  * an insert or update statement: which tries to insert the row and on
  *    duplication, updates it.
  *  * a delete statement.
@@ -85,6 +88,10 @@ class query_preparator {
   event_unique _unique;
   event_pb_unique _pb_unique;
 
+  const io::event_info* _build_update(
+      std::string& query,
+      mysql_bind_mapping& query_bind_mapping) const;
+
  public:
   query_preparator(uint32_t event_id,
                    event_unique const& unique = event_unique(),
@@ -99,6 +106,7 @@ class query_preparator {
                                            const std::vector<pb_entry>& mapping,
                                            bool ignore = false);
   database::mysql_stmt prepare_update(mysql& q);
+  std::unique_ptr<database::mysql_bulk_stmt> prepare_bulk_update(mysql& q);
   database::mysql_stmt prepare_update_table(
       mysql& q,
       const std::string& table,
@@ -115,3 +115,23 @@ BIND_VALUE(bool, bool)
 BIND_VALUE(str, const fmt::string_view&)
 
 #undef BIND_VALUE
+
+/**
+ * @brief Go to the next row of the bind, useful after binding an object with
+ * the operator<<().
+ */
+void mysql_bulk_stmt::next_row() {
+  if (!_bind)
+    _bind = std::make_unique<database::mysql_bulk_bind>(
+        get_param_count(), _reserved_size, _logger);
+  _bind->next_row();
+}
+
+/**
+ * @brief The number of rows in the current bind.
+ *
+ * @return A number of rows, 0 if there is no bind.
+ */
+size_t mysql_bulk_stmt::rows_count() const {
+  return _bind ? _bind->rows_count() : 0u;
+}
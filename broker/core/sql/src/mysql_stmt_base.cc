@@ -25,6 +25,7 @@
 #include "com/centreon/broker/io/protobuf.hh"
 #include "com/centreon/broker/mapping/entry.hh"
 #include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/common/utf8.hh"
 #include "common/log_v2/log_v2.hh"
 
 using namespace com::centreon::exceptions;
@@ -351,3 +352,201 @@ void mysql_stmt_base::bind_value_as_u64_ext(size_t range,
   else
     bind_value_as_u64(range, value);
 }
+
+/**
+ * @brief Operator useful to fill a database table row from a neb object. It
+ * works well when all the content of the object has an equivalent column in
+ * the table. With a mysql_bulk_stmt, the current row is filled and
+ * next_row() must be called before binding the next object.
+ *
+ * @param d The object to save to the database.
+ */
+void mysql_stmt_base::operator<<(io::data const& d) {
+  // Get event info.
+  const io::event_info* info = io::events::instance().get_event_info(d.type());
+  if (info) {
+    if (info->get_mapping()) {
+      for (const mapping::entry* current_entry(info->get_mapping());
+           !current_entry->is_null(); ++current_entry) {
+        char const* entry_name = current_entry->get_name_v2();
+        if (entry_name && entry_name[0]) {
+          std::string field{fmt::format(":{}", entry_name)};
+          switch (current_entry->get_type()) {
+            case mapping::source::BOOL:
+              bind_value_as_bool_k(field, current_entry->get_bool(d));
+              break;
+            case mapping::source::DOUBLE:
+              bind_value_as_f64_k(field, current_entry->get_double(d));
+              break;
+            case mapping::source::INT: {
+              int32_t v = current_entry->get_int(d);
+              uint32_t attr = current_entry->get_attribute();
+
+              if (((attr & mapping::entry::invalid_on_zero) && v == 0) ||
+                  ((attr & mapping::entry::invalid_on_negative) && v < 0) ||
+                  ((attr & mapping::entry::invalid_on_minus_one) && v == -1))
+                bind_null_i32_k(field);
+              else
+                bind_value_as_i32_k(field, v);
+            } break;
+            case mapping::source::SHORT: {
+              int32_t v = current_entry->get_short(d);
+              uint32_t attr = current_entry->get_attribute();
+
+              if (((attr & mapping::entry::invalid_on_zero) && v == 0) ||
+                  ((attr & mapping::entry::invalid_on_negative) && v < 0) ||
+                  ((attr & mapping::entry::invalid_on_minus_one) && v == -1))
+                bind_null_i32_k(field);
+              else
+                bind_value_as_i32_k(field, v);
+            } break;
+            case mapping::source::STRING: {
+              size_t max_len = 0;
+              const std::string& v(current_entry->get_string(d, &max_len));
+              fmt::string_view sv;
+              if (max_len > 0 && v.size() > max_len) {
+                _logger->trace(
+                    "column '{}' should admit a longer string, it is cut to {} "
+                    "characters to be stored anyway.",
+                    current_entry->get_name_v2(), max_len);
+                max_len = common::adjust_size_utf8(v, max_len);
+                sv = fmt::string_view(v.data(), max_len);
+              } else
+                sv = fmt::string_view(v);
+              uint32_t attr = current_entry->get_attribute();
+
+              if ((attr & mapping::entry::invalid_on_zero) && sv.size() == 0)
+                bind_null_str_k(field);
+              else
+                bind_value_as_str_k(field, sv);
+            } break;
+            case mapping::source::TIME: {
+              time_t v = current_entry->get_time(d);
+              uint32_t attr = current_entry->get_attribute();
+
+              if (((attr & mapping::entry::invalid_on_zero) && v == 0) ||
+                  ((attr & mapping::entry::invalid_on_negative) && v < 0) ||
+                  ((attr & mapping::entry::invalid_on_minus_one) && v == -1))
+                bind_null_u32_k(field);
+              else
+                bind_value_as_u32_k(field, v);
+            } break;
+            case mapping::source::UINT: {
+              uint32_t v = current_entry->get_uint(d);
+              uint32_t attr = current_entry->get_attribute();
+
+              if (((attr & mapping::entry::invalid_on_zero) && v == 0) ||
+                  ((attr & mapping::entry::invalid_on_minus_one) &&
+                   v == static_cast<uint32_t>(-1)))
+                bind_null_u32_k(field);
+              else
+                bind_value_as_u32_k(field, v);
+            } break;
+            default:  // Error in one of the mappings.
+              throw msg_fmt(
+                  "invalid mapping for object "
+                  "of type '{}': {} is not a know type ID",
+                  info->get_name(), current_entry->get_type());
+          };
+        }
+      }
+    } else {
+      /* Here is the protobuf case: no mapping */
+      const google::protobuf::Message* p =
+          static_cast<const io::protobuf_base*>(&d)->msg();
+      const google::protobuf::Descriptor* desc = p->GetDescriptor();
+      const google::protobuf::Reflection* refl = p->GetReflection();
+
+      for (uint32_t i = 0; i < get_pb_mapping().size(); i++) {
+        auto& pr = get_pb_mapping()[i];
+        if (std::get<0>(pr).empty())
+          continue;
+        auto f = desc->field(i);
+        std::string field{fmt::format(":{}", std::get<0>(pr))};
+        switch (f->type()) {
+          case google::protobuf::FieldDescriptor::TYPE_BOOL:
+            bind_value_as_bool_k(field, refl->GetBool(*p, f));
+            break;
+          case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
+            bind_value_as_f64_k(field, refl->GetDouble(*p, f));
+            break;
+          case google::protobuf::FieldDescriptor::TYPE_INT32: {
+            int32_t v = refl->GetInt32(*p, f);
+            uint32_t attr = std::get<2>(pr);
+
+            if (((attr & io::protobuf_base::invalid_on_zero) && v == 0) ||
+                ((attr & mapping::entry::invalid_on_negative) && v < 0) ||
+                ((attr & mapping::entry::invalid_on_minus_one) && v == -1))
+              bind_null_i32_k(field);
+            else
+              bind_value_as_i32_k(field, v);
+          } break;
+          case google::protobuf::FieldDescriptor::TYPE_UINT32: {
+            uint32_t v = refl->GetUInt32(*p, f);
+            uint32_t attr = std::get<2>(pr);
+
+            if (((attr & io::protobuf_base::invalid_on_zero) && v == 0) ||
+                ((attr & mapping::entry::invalid_on_minus_one) &&
+                 v == static_cast<uint32_t>(-1)))
+              bind_null_u32_k(field);
+            else
+              bind_value_as_u32_k(field, v);
+          } break;
+          case google::protobuf::FieldDescriptor::TYPE_INT64: {
+            int64_t v = refl->GetInt64(*p, f);
+            uint32_t attr = std::get<2>(pr);
+
+            if (((attr & io::protobuf_base::invalid_on_zero) && v == 0) ||
+                ((attr & mapping::entry::invalid_on_negative) && v < 0) ||
+                ((attr & mapping::entry::invalid_on_minus_one) && v == -1))
+              bind_null_i64_k(field);
+            else
+              bind_value_as_i64_k(field, v);
+          } break;
+          case google::protobuf::FieldDescriptor::TYPE_UINT64: {
+            uint64_t v = refl->GetUInt64(*p, f);
+            uint32_t attr = std::get<2>(pr);
+
+            if (((attr & io::protobuf_base::invalid_on_zero) && v == 0) ||
+                ((attr & mapping::entry::invalid_on_minus_one) &&
+                 v == static_cast<uint64_t>(-1)))
+              bind_null_u64_k(field);
+            else
+              bind_value_as_u64_k(field, v);
+          } break;
+          case google::protobuf::FieldDescriptor::TYPE_ENUM:
+            bind_value_as_i32_k(field, refl->GetEnumValue(*p, f));
+            break;
+          case google::protobuf::FieldDescriptor::TYPE_STRING: {
+            size_t max_len = std::get<1>(pr);
+            std::string v(refl->GetString(*p, f));
+            fmt::string_view sv;
+            if (max_len > 0 && v.size() > max_len) {
+              _logger->trace(
+                  "column '{}' should admit a longer string, it is cut to {} "
+                  "characters to be stored anyway.",
+                  field, max_len);
+              max_len = common::adjust_size_utf8(v, max_len);
+              sv = fmt::string_view(v.data(), max_len);
+            } else
+              sv = fmt::string_view(v);
+            uint32_t attr = std::get<2>(pr);
+            if (attr & io::protobuf_base::invalid_on_zero && sv.size() == 0)
+              bind_null_str_k(field);
+            else
+              bind_value_as_str_k(field, sv);
+          } break;
+          default:
+            throw msg_fmt(
+                "invalid mapping for object of type '{}': {} is not a know "
+                "type ID",
+                info->get_name(), static_cast<uint32_t>(f->type()));
+        }
+      }
+    }
+  } else
+    throw msg_fmt(
+        "cannot bind object of type {}"
+        " to database query: mapping does not exist",
+        d.type());
+}
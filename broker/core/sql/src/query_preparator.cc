@@ -422,12 +422,17 @@ mysql_stmt query_preparator::prepare_insert_or_update_table(
 }
 
 /**
- *  Prepare update query for specified event.
+ *  Build the update query for specified event with the correspondance table
+ *  between the columns and their indices.
  *
- *  @param[out] q  Database query, prepared and ready to run.
+ *  @param[out] query  The query.
+ *  @param[out] query_bind_mapping  The columns indices.
+ *
+ *  @return The event info.
  */
-mysql_stmt query_preparator::prepare_update(mysql& ms) {
-  absl::flat_hash_map<std::string, int> query_bind_mapping;
+const io::event_info* query_preparator::_build_update(
+    std::string& query,
+    mysql_bind_mapping& query_bind_mapping) const {
   absl::flat_hash_map<std::string, int> where_bind_mapping;
   // Find event info.
   io::event_info const* info(io::events::instance().get_event_info(_event_id));
@@ -438,7 +443,7 @@ mysql_stmt query_preparator::prepare_update(mysql& ms) {
         _event_id);
 
   // Build query string.
-  std::string query("UPDATE ");
+  query = "UPDATE ";
   std::string where(" WHERE ");
   query.append(info->get_table_v2());
   query.append(" SET ");
@@ -478,6 +483,18 @@ mysql_stmt query_preparator::prepare_update(mysql& ms) {
        it != end; ++it)
     query_bind_mapping.insert(
         std::make_pair(it->first, it->second + query_size));
+  return info;
+}
+
+/**
+ *  Prepare update query for specified event.
+ *
+ *  @param[out] q  Database query, prepared and ready to run.
+ */
+mysql_stmt query_preparator::prepare_update(mysql& ms) {
+  std::string query;
+  mysql_bind_mapping query_bind_mapping;
+  const io::event_info* info = _build_update(query, query_bind_mapping);
 
   // Prepare statement.
   mysql_stmt retval;
@@ -491,6 +508,33 @@ mysql_stmt query_preparator::prepare_update(mysql& ms) {
   return retval;
 }
 
+/**
+ *  Prepare a bulk update query for specified event. Each row of its bind is
+ *  filled with the operator<<() and the statement updates all of them at
+ *  once. Bulk statements are only available with MariaDB.
+ *
+ *  @param[out] q  Database query, prepared and ready to run.
+ *
+ *  @return The statement.
+ */
+std::unique_ptr<mysql_bulk_stmt> query_preparator::prepare_bulk_update(
+    mysql& ms) {
+  std::string query;
+  mysql_bind_mapping query_bind_mapping;
+  const io::event_info* info = _build_update(query, query_bind_mapping);
+
+  auto retval = std::make_unique<mysql_bulk_stmt>(query, query_bind_mapping);
+  try {
+    ms.prepare_statement(*retval);
+  } catch (std::exception const& e) {
+    throw msg_fmt(
+        "could not prepare bulk update query for event '{}': on table '{}': "
+        "{}",
+        info->get_name(), info->get_table_v2(), e.what());
+  }
+  return retval;
+}
+
 /**
  *  Prepare update query for specified event.
  *
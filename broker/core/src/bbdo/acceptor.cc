@@ -66,7 +66,8 @@ acceptor::acceptor(std::string name,
       _timeout(timeout),
       _ack_limit(ack_limit),
       _extensions{extensions},
-      _grpc_serialized(grpc_serialized) {
+      _grpc_serialized(grpc_serialized),
+      _prefilter(false) {
   if (_timeout == (time_t)-1 || _timeout == 0)
     _timeout = 3;
 }
@@ -98,6 +99,7 @@ std::shared_ptr<io::stream> acceptor::open() {
       my_bbdo->set_substream(u);
       my_bbdo->set_coarse(_coarse);
       my_bbdo->set_negotiate(_negotiate);
+      my_bbdo->set_prefilter(_prefilter && !_is_output);
       my_bbdo->set_timeout(_timeout);
       my_bbdo->set_ack_limit(_ack_limit);
       try {
@@ -114,6 +116,17 @@ std::shared_ptr<io::stream> acceptor::open() {
   return std::shared_ptr<io::stream>();
 }
 
+/**
+ *  Enable the pre-filtering of received events on the streams opened by this
+ *  acceptor (see bbdo::stream::set_prefilter()). It is ignored when the
+ *  acceptor is an output.
+ *
+ *  @param[in] prefilter  True to enable the pre-filtering.
+ */
+void acceptor::set_prefilter(bool prefilter) {
+  _prefilter = prefilter;
+}
+
 /**
  *  Get BBDO statistics.
  *
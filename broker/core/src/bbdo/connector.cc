@@ -60,7 +60,19 @@ connector::connector(bool negotiate,
       _timeout(timeout == -1 || timeout == 0 ? 3 : timeout),
       _ack_limit{ack_limit},
       _extensions{std::move(extensions)},
-      _grpc_serialized(grpc_serialized) {}
+      _grpc_serialized(grpc_serialized),
+      _prefilter(false) {}
+
+/**
+ *  Enable the pre-filtering of received events on the streams opened by this
+ *  connector (see bbdo::stream::set_prefilter()). It is ignored when the
+ *  connector is an output.
+ *
+ *  @param[in] prefilter  True to enable the pre-filtering.
+ */
+void connector::set_prefilter(bool prefilter) {
+  _prefilter = prefilter;
+}
 
 /**
  *  Open the connector.
@@ -93,6 +105,7 @@ std::shared_ptr<io::stream> connector::_open(
     bbdo_stream->set_substream(stream);
     bbdo_stream->set_coarse(_coarse);
     bbdo_stream->set_negotiate(_negotiate);
+    bbdo_stream->set_prefilter(_prefilter && _is_input);
     bbdo_stream->set_timeout(_timeout);
     try {
       bbdo_stream->negotiate(bbdo::stream::negotiate_first);
@@ -113,6 +113,16 @@ io::endpoint* factory::new_endpoint(
     ack_limit = 1000;
   }
 
+  // Skip the decoding of events wanted by no output? Only used by inputs.
+  bool prefilter = false;
+  it = cfg.params.find("prefilter");
+  if (it != cfg.params.end() && !absl::SimpleAtob(it->second, &prefilter)) {
+    logger->error(
+        "BBDO: cannot parse the 'prefilter' boolean: the content is '{}'",
+        it->second);
+    prefilter = false;
+  }
+
   // Create object.
   std::string host;
 
@@ -165,17 +175,21 @@ io::endpoint* factory::new_endpoint(
           "be "
           "set only when the connection is reversed");
 
-    retval = std::make_unique<bbdo::acceptor>(
+    auto acc = std::make_unique<bbdo::acceptor>(
         cfg.name, negotiate, cfg.read_timeout, acceptor_is_output, coarse,
         ack_limit, std::move(extensions), grpc_serialized);
+    acc->set_prefilter(prefilter);
+    retval = std::move(acc);
     if (acceptor_is_output && keep_retention)
       is_acceptor = false;
     logger->debug("BBDO: new acceptor {}", cfg.name);
   } else {
     bool connector_is_input = cfg.get_io_type() == config::endpoint::input;
-    retval = std::make_unique<bbdo::connector>(
+    auto conn = std::make_unique<bbdo::connector>(
         negotiate, cfg.read_timeout, connector_is_input, coarse, ack_limit,
         std::move(extensions), grpc_serialized);
+    conn->set_prefilter(prefilter);
+    retval = std::move(conn);
     logger->debug("BBDO: new connector {}", cfg.name);
   }
   return retval.release();
@@ -0,0 +1,273 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/bbdo/mapping_plan.hh"
+
+#include <arpa/inet.h>
+
+#include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bbdo;
+
+template <typename T>
+static inline const T& member(const io::data& e, uint32_t offset) {
+  return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(&e) +
+                                     offset);
+}
+
+template <typename T>
+static inline T& member(io::data& e, uint32_t offset) {
+  return *reinterpret_cast<T*>(reinterpret_cast<char*>(&e) + offset);
+}
+
+template <typename T>
+static inline void append(std::vector<char>& buffer, T value) {
+  const char* v = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), v, v + sizeof(value));
+}
+
+static inline void append_64(std::vector<char>& buffer, uint64_t value) {
+  append(buffer, static_cast<uint32_t>(htonl(value >> 32)));
+  append(buffer, static_cast<uint32_t>(htonl(value & 0xffffffff)));
+}
+
+template <typename T>
+static inline T read(const char* data) {
+  T retval;
+  memcpy(&retval, data, sizeof(retval));
+  return retval;
+}
+
+static inline uint64_t read_64(const char* data) {
+  uint64_t retval = ntohl(read<uint32_t>(data));
+  retval <<= 32;
+  retval |= ntohl(read<uint32_t>(data + sizeof(uint32_t)));
+  return retval;
+}
+
+/**
+ * @brief Compile the mapping of an event type.
+ *
+ * @param info The event type informations, it must have a mapping.
+ */
+mapping_plan::mapping_plan(const io::event_info& info) : _fixed_size{0} {
+  std::unique_ptr<io::data> sample(info.get_operations().constructor());
+  if (!sample)
+    throw msg_fmt(
+        "BBDO: cannot create object of type '{}' whereas it has been "
+        "registered",
+        info.get_name());
+
+  for (const mapping::entry* current_entry = info.get_mapping();
+       !current_entry->is_null(); ++current_entry) {
+    // Skip entries that should not be serialized.
+    if (!current_entry->get_serialize())
+      continue;
+    op o;
+    o.offset = current_entry->get_offset(*sample);
+    switch (current_entry->get_type()) {
+      case mapping::source::BOOL:
+        o.type = BOOL;
+        _fixed_size += 1;
+        break;
+      case mapping::source::DOUBLE:
+        o.type = DOUBLE;
+        break;
+      case mapping::source::INT:
+        o.type = INT;
+        _fixed_size += sizeof(uint32_t);
+        break;
+      case mapping::source::SHORT:
+        o.type = SHORT;
+        _fixed_size += sizeof(uint16_t);
+        break;
+      case mapping::source::STRING:
+        o.type = STRING;
+        break;
+      case mapping::source::TIME:
+        o.type = TIME;
+        _fixed_size += sizeof(uint64_t);
+        break;
+      case mapping::source::UINT:
+        o.type = UINT;
+        _fixed_size += sizeof(uint32_t);
+        break;
+      case mapping::source::ULONG:
+        o.type = ULONG;
+        _fixed_size += sizeof(uint64_t);
+        break;
+      default:
+        throw msg_fmt(
+            "BBDO: invalid mapping for object of type '{}': {} is not a known "
+            "type ID",
+            info.get_name(), current_entry->get_type());
+    }
+    _ops.push_back(o);
+  }
+}
+
+/**
+ * @brief Append the BBDO content of an event to a buffer. Nothing is done
+ * about packets, the content may be longer than 0xffff bytes.
+ *
+ * @param e The event to serialize, of the type of this plan.
+ * @param buffer The buffer to fill.
+ */
+void mapping_plan::serialize(const io::data& e,
+                             std::vector<char>& buffer) const {
+  /* We reserve the needed size once, doubles are at most 32 bytes long. */
+  size_t size = _fixed_size;
+  for (const op& o : _ops) {
+    if (o.type == STRING)
+      size += member<std::string>(e, o.offset).size() + 1;
+    else if (o.type == DOUBLE)
+      size += 32;
+  }
+  buffer.reserve(buffer.size() + size);
+
+  for (const op& o : _ops) {
+    switch (o.type) {
+      case BOOL:
+        buffer.push_back(member<bool>(e, o.offset) ? 1 : 0);
+        break;
+      case DOUBLE: {
+        char str[32];
+        size_t strsz(
+            snprintf(str, sizeof(str), "%f", member<double>(e, o.offset)) + 1);
+        if (strsz > sizeof(str))
+          strsz = sizeof(str);
+        buffer.insert(buffer.end(), str, str + strsz);
+      } break;
+      case INT:
+        append(buffer, htonl(member<int>(e, o.offset)));
+        break;
+      case SHORT:
+        append(buffer, htons(member<short>(e, o.offset)));
+        break;
+      case STRING: {
+        const std::string& str = member<std::string>(e, o.offset);
+        buffer.insert(buffer.end(), str.c_str(), str.c_str() + str.size() + 1);
+      } break;
+      case TIME:
+        append_64(buffer, member<timestamp>(e, o.offset).get_time_t());
+        break;
+      case UINT:
+        append(buffer, htonl(member<uint32_t>(e, o.offset)));
+        break;
+      case ULONG:
+        append_64(buffer, member<uint64_t>(e, o.offset));
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Fill an event from its BBDO content.
+ *
+ * @param e The event to fill, of the type of this plan.
+ * @param buffer The BBDO content.
+ * @param size The content size.
+ */
+void mapping_plan::unserialize(io::data& e,
+                               const char* buffer,
+                               uint32_t size) const {
+  for (const op& o : _ops) {
+    uint32_t rb;
+    switch (o.type) {
+      case BOOL:
+        if (!size)
+          throw msg_fmt(
+              "cannot extract boolean value: "
+              "0 bytes left in packet");
+        member<bool>(e, o.offset) = *buffer;
+        rb = 1;
+        break;
+      case DOUBLE: {
+        const char* end = static_cast<const char*>(memchr(buffer, 0, size));
+        if (!end)
+          throw msg_fmt(
+              "cannot extract double value: "
+              "not terminating '\\0' in remaining {} bytes of packet",
+              size);
+        member<double>(e, o.offset) = strtod(buffer, nullptr);
+        rb = end - buffer + 1;
+      } break;
+      case INT:
+        if (size < sizeof(uint32_t))
+          throw msg_fmt(
+              "BBDO: cannot extract integer value: {}"
+              " bytes left in packet",
+              size);
+        member<int>(e, o.offset) = ntohl(read<uint32_t>(buffer));
+        rb = sizeof(uint32_t);
+        break;
+      case SHORT:
+        if (size < sizeof(uint16_t))
+          throw msg_fmt(
+              "BBDO: cannot extract short value: {}"
+              " bytes left in packet",
+              size);
+        member<short>(e, o.offset) = ntohs(read<uint16_t>(buffer));
+        rb = sizeof(uint16_t);
+        break;
+      case STRING: {
+        const char* end = static_cast<const char*>(memchr(buffer, 0, size));
+        if (!end)
+          throw msg_fmt(
+              "BBDO: cannot extract string value: "
+              "no terminating '\\0' in remaining {} bytes of packet",
+              size);
+        member<std::string>(e, o.offset).assign(buffer, end);
+        rb = end - buffer + 1;
+      } break;
+      case TIME:
+        if (size < sizeof(uint64_t))
+          throw msg_fmt(
+              "BBDO: cannot extract timestamp value: {}"
+              " bytes left in packet",
+              size);
+        member<timestamp>(e, o.offset) =
+            timestamp(static_cast<time_t>(read_64(buffer)));
+        rb = sizeof(uint64_t);
+        break;
+      case UINT:
+        if (size < sizeof(uint32_t))
+          throw msg_fmt(
+              "BBDO: cannot extract uint32_teger value: {}"
+              " bytes left in packet",
+              size);
+        member<uint32_t>(e, o.offset) = ntohl(read<uint32_t>(buffer));
+        rb = sizeof(uint32_t);
+        break;
+      case ULONG:
+        if (size < sizeof(uint64_t))
+          throw msg_fmt(
+              "BBDO: cannot extract uint64_teger value: {}"
+              " bytes left in packet",
+              size);
+        member<uint64_t>(e, o.offset) = read_64(buffer);
+        rb = sizeof(uint64_t);
+        break;
+    }
+    buffer += rb;
+    size -= rb;
+  }
+}
@@ -20,6 +20,8 @@
 
 #include <absl/strings/str_split.h>
 #include <arpa/inet.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include "bbdo/bbdo/ack.hh"
 #include "bbdo/bbdo/stop.hh"
@@ -29,6 +31,7 @@
 #include "com/centreon/broker/io/protocols.hh"
 #include "com/centreon/broker/misc/misc.hh"
 #include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "common/log_v2/log_v2.hh"
@@ -40,146 +43,142 @@ using namespace com::centreon::broker::bbdo;
 using log_v2 = com::centreon::common::log_v2::log_v2;
 
 /**
- *  Set a boolean within an object.
- */
-static uint32_t set_boolean(io::data& t,
-                            mapping::entry const& member,
-                            void const* data,
-                            uint32_t size) {
-  if (!size)
-    throw msg_fmt(
-        "cannot extract boolean value: "
-        "0 bytes left in packet");
-
-  member.set_bool(t, *static_cast<char const*>(data));
-  return 1;
-}
-
-/**
- *  Set a double within an object.
- */
-static uint32_t set_double(io::data& t,
-                           mapping::entry const& member,
-                           void const* data,
-                           uint32_t size) {
-  char const* str(static_cast<char const*>(data));
-  uint32_t len(strlen(str));
-  if (len >= size)
-    throw msg_fmt(
-        "cannot extract double value: "
-        "not terminating '\\0' in remaining {} bytes of packet",
-        size);
-  member.set_double(t, strtod(str, nullptr));
-  return len + 1;
-}
-
-/**
- *  Set an integer within an object.
- */
-static uint32_t set_integer(io::data& t,
-                            mapping::entry const& member,
-                            void const* data,
-                            uint32_t size) {
-  if (size < sizeof(uint32_t))
-    throw msg_fmt(
-        "BBDO: cannot extract integer value: {}"
-        " bytes left in packet",
-        size);
-  member.set_int(t, ntohl(*static_cast<uint32_t const*>(data)));
-  return sizeof(uint32_t);
-}
-
-/**
- *  Set a short within an object.
+ *  Cut the content of a serialized event in BBDO packets and fill their
+ *  headers. The buffer starts with room for one header followed by the whole
+ *  content, the other headers are inserted in place every 0xffff bytes.
+ *
+ *  @param[in, out] buffer  The buffer to finalize.
+ *  @param[in]      e       The serialized event.
  */
-static uint32_t set_short(io::data& t,
-                          mapping::entry const& member,
-                          void const* data,
-                          uint32_t size) {
-  if (size < sizeof(uint16_t))
-    throw msg_fmt(
-        "BBDO: cannot extract short value: {}"
-        " bytes left in packet",
-        size);
-  member.set_short(t, ntohs(*static_cast<uint16_t const*>(data)));
-  return sizeof(uint16_t);
-}
+static void finalize_packets(std::vector<char>& buffer, const io::data& e) {
+  const size_t content_size = buffer.size() - BBDO_HEADER_SIZE;
+  const size_t packets = content_size / 0xffff + 1;
+  if (packets > 1) {
+    buffer.resize(content_size + packets * BBDO_HEADER_SIZE);
+    /* Chunks are moved from the last one, each one only goes forward. */
+    for (size_t i = packets - 1; i > 0; --i) {
+      size_t len = i == packets - 1 ? content_size - i * 0xffff : 0xffff;
+      memmove(buffer.data() + (i + 1) * BBDO_HEADER_SIZE + i * 0xffff,
+              buffer.data() + BBDO_HEADER_SIZE + i * 0xffff, len);
+    }
+  }
 
-/**
- *  Set a string within an object.
- */
-static uint32_t set_string(io::data& t,
-                           mapping::entry const& member,
-                           void const* data,
-                           uint32_t size) {
-  char const* str(static_cast<char const*>(data));
-  uint32_t len(strlen(str));
-  if (len >= size)
-    throw msg_fmt(
-        "BBDO: cannot extract string value: "
-        "no terminating '\\0' in remaining {} bytes of packet",
-        size);
-  member.set_string(t, str);
-  return len + 1;
+  const uint32_t type = htonl(e.type());
+  const uint32_t source_id = htonl(e.source_id);
+  const uint32_t destination_id = htonl(e.destination_id);
+  for (size_t i = 0; i < packets; ++i) {
+    char* header = buffer.data() + i * (BBDO_HEADER_SIZE + 0xffff);
+    uint16_t size =
+        htons(i == packets - 1 ? content_size - i * 0xffff : 0xffff);
+    memcpy(header + 2, &size, sizeof(size));
+    memcpy(header + 4, &type, sizeof(type));
+    memcpy(header + 8, &source_id, sizeof(source_id));
+    memcpy(header + 12, &destination_id, sizeof(destination_id));
+    uint16_t crc = htons(misc::crc16_ccitt(header + 2, BBDO_HEADER_SIZE - 2));
+    memcpy(header, &crc, sizeof(crc));
+  }
 }
 
 /**
- *  Set a timestamp within an object.
+ *  Get the compiled mapping of a legacy event type, it is built on the first
+ *  call.
+ *
+ *  @param[in] info  The event type informations.
+ *
+ *  @return The mapping plan.
  */
-static uint32_t set_timestamp(io::data& t,
-                              mapping::entry const& member,
-                              void const* data,
-                              uint32_t size) {
-  if (size < sizeof(uint64_t))
-    throw msg_fmt(
-        "BBDO: cannot extract timestamp value: {}"
-        " bytes left in packet",
-        size);
-  uint32_t const* ptr(static_cast<uint32_t const*>(data));
-  uint64_t val(ntohl(*ptr));
-  ++ptr;
-  val <<= 32;
-  val |= ntohl(*ptr);
-  member.set_time(t, val);
-  return sizeof(uint64_t);
+const mapping_plan& stream::_get_plan(const io::event_info& info) {
+  auto found = _plans.find(&info);
+  if (found != _plans.end())
+    return *found->second;
+  try {
+    return *_plans.emplace(&info, std::make_unique<mapping_plan>(info))
+                .first->second;
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "{}", e.what());
+    throw;
+  }
 }
 
 /**
- *  Set an uint32_teger within an object.
+ *  Check the wire structure of a protobuf message without parsing it: every
+ *  tag must be valid and every length must fit in the buffer. BBDO messages
+ *  are proto3 ones, so their parsing fails on a string field that is not
+ *  valid UTF-8. Such fields are checked here too, and embedded messages are
+ *  checked with their own descriptor, so that a payload accepted here is
+ *  also accepted by the parser.
+ *
+ *  @param[in] input       The stream positioned on the message.
+ *  @param[in] descriptor  The descriptor of the message.
+ *
+ *  @return true if the message can be parsed later.
  */
-static uint32_t set_uint(io::data& t,
-                         mapping::entry const& member,
-                         void const* data,
-                         uint32_t size) {
-  if (size < sizeof(uint32_t))
-    throw msg_fmt(
-        "BBDO: cannot extract uint32_teger value: {}"
-        " bytes left in packet",
-        size);
-  member.set_uint(t, ntohl(*static_cast<uint32_t const*>(data)));
-  return sizeof(uint32_t);
+static bool valid_protobuf_message(
+    google::protobuf::io::CodedInputStream* input,
+    const google::protobuf::Descriptor* descriptor) {
+  using google::protobuf::FieldDescriptor;
+  using google::protobuf::internal::WireFormatLite;
+  for (;;) {
+    uint32_t tag = input->ReadTag();
+    if (tag == 0)
+      return true;
+    const FieldDescriptor* field =
+        descriptor->FindFieldByNumber(WireFormatLite::GetTagFieldNumber(tag));
+    if (!field || WireFormatLite::GetTagWireType(tag) !=
+                      WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (!WireFormatLite::SkipField(input, tag))
+        return false;
+      continue;
+    }
+    if (field->type() == FieldDescriptor::TYPE_STRING) {
+      uint32_t length;
+      if (!input->ReadVarint32(&length))
+        return false;
+      if (length == 0)
+        continue;
+      const void* data;
+      int available;
+      if (!input->GetDirectBufferPointer(&data, &available) ||
+          static_cast<uint32_t>(available) < length ||
+          !google::protobuf::internal::IsStructurallyValidUTF8(
+              static_cast<const char*>(data), length))
+        return false;
+      input->Skip(length);
+    } else if (field->type() == FieldDescriptor::TYPE_MESSAGE) {
+      uint32_t length;
+      if (!input->ReadVarint32(&length) || !input->IncrementRecursionDepth())
+        return false;
+      auto limit = input->PushLimit(length);
+      bool valid = valid_protobuf_message(input, field->message_type()) &&
+                   input->ConsumedEntireMessage();
+      input->PopLimit(limit);
+      input->DecrementRecursionDepth();
+      if (!valid)
+        return false;
+    } else if (!WireFormatLite::SkipField(input, tag))
+      return false;
+  }
 }
 
 /**
- *  Set an uint64_teger within an object.
+ *  Check a whole protobuf payload without parsing it, see
+ *  valid_protobuf_message(). It is called when a payload is received, so
+ *  that a malformed event is rejected there as if it had been parsed.
+ *
+ *  @param[in] buffer      The payload.
+ *  @param[in] size        Its size.
+ *  @param[in] descriptor  The descriptor of the message.
+ *
+ *  @return true if the payload can be parsed later.
  */
-static uint32_t set_ulong(io::data& t,
-                          mapping::entry const& member,
-                          void const* data,
-                          uint32_t size) {
-  if (size < sizeof(uint64_t))
-    throw msg_fmt(
-        "BBDO: cannot extract uint64_teger value: {}"
-        " bytes left in packet",
-        size);
-  const uint32_t* ptr(static_cast<uint32_t const*>(data));
-  uint64_t val(ntohl(*ptr));
-  ++ptr;
-  val <<= 32;
-  val |= ntohl(*ptr);
-
-  member.set_ulong(t, val);
-  return sizeof(uint64_t);
+static bool valid_protobuf_payload(
+    const char* buffer,
+    uint32_t size,
+    const google::protobuf::Descriptor* descriptor) {
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t*>(buffer), size);
+  return valid_protobuf_message(&input, descriptor) &&
+         input.ConsumedEntireMessage();
 }
 
 /**
@@ -188,16 +187,20 @@ static uint32_t set_ulong(io::data& t,
  *  @param[in] event_type  Event type.
  *  @param[in] source_id   The source id.
  *  @param[in] destination The destination id.
- *  @param[in] buffer      Serialized data.
- *  @param[in] size        Buffer size.
+ *  @param[in] content     Buffer containing the serialized data. It is
+ *                         moved into protobuf events, which are parsed
+ *                         later.
+ *  @param[in] offset      Position of the serialized data in content.
  *
  *  @return Event.
  */
 io::data* stream::unserialize(uint32_t event_type,
                               uint32_t source_id,
                               uint32_t destination_id,
-                              const char* buffer,
-                              uint32_t size) {
+                              std::vector<char>&& content,
+                              size_t offset) {
+  const char* buffer = content.data() + offset;
+  uint32_t size = content.size() - offset;
   // Get event info (operations and mapping).
   io::event_info const* info(io::events::instance().get_event_info(event_type));
   if (info) {
@@ -207,52 +210,7 @@ io::data* stream::unserialize(uint32_t event_type,
       if (t) {
         t->source_id = source_id;
         t->destination_id = destination_id;
-        // Browse all mapping to unserialize the object.
-        for (const mapping::entry* current_entry = info->get_mapping();
-             !current_entry->is_null(); ++current_entry)
-          // Skip entries that should not be serialized.
-          if (current_entry->get_serialize()) {
-            uint32_t rb;
-            switch (current_entry->get_type()) {
-              case mapping::source::BOOL:
-                rb = set_boolean(*t, *current_entry, buffer, size);
-                break;
-              case mapping::source::DOUBLE:
-                rb = set_double(*t, *current_entry, buffer, size);
-                break;
-              case mapping::source::INT:
-                rb = set_integer(*t, *current_entry, buffer, size);
-                break;
-              case mapping::source::SHORT:
-                rb = set_short(*t, *current_entry, buffer, size);
-                break;
-              case mapping::source::STRING:
-                rb = set_string(*t, *current_entry, buffer, size);
-                break;
-              case mapping::source::TIME:
-                rb = set_timestamp(*t, *current_entry, buffer, size);
-                break;
-              case mapping::source::UINT:
-                rb = set_uint(*t, *current_entry, buffer, size);
-                break;
-              case mapping::source::ULONG:
-                rb = set_ulong(*t, *current_entry, buffer, size);
-                break;
-
-              default:
-                SPDLOG_LOGGER_ERROR(
-                    _logger,
-                    "BBDO: invalid mapping for object of type '{0}': {1} is "
-                    "not a known type ID",
-                    info->get_name(), current_entry->get_type());
-                throw msg_fmt(
-                    "BBDO: invalid mapping for object of type '{}"
-                    "': {} is not a known type ID",
-                    info->get_name(), current_entry->get_type());
-            }
-            buffer += rb;
-            size -= rb;
-          }
+        _get_plan(*info).unserialize(*t, buffer, size);
         return t.release();
       } else {
         SPDLOG_LOGGER_ERROR(
@@ -266,8 +224,30 @@ io::data* stream::unserialize(uint32_t event_type,
             event_type);
       }
     } else {
-      std::unique_ptr<io::data> t(
-          info->get_operations().unserialize(buffer, size));
+      std::unique_ptr<io::data> t;
+      /* Protobuf events are not parsed here, they keep the received buffer
+       * and are parsed on their first access. If no one reads them, they can
+       * be written again by a bbdo output without any serialization. The
+       * payload is only checked, a malformed one is rejected as the parser
+       * would do. */
+      if (info->get_operations().constructor) {
+        t.reset(info->get_operations().constructor());
+        auto* pb = dynamic_cast<io::protobuf_base*>(t.get());
+        if (pb) {
+          if (!valid_protobuf_payload(buffer, size, pb->descriptor())) {
+            SPDLOG_LOGGER_ERROR(
+                _logger,
+                "BBDO: malformed protobuf payload of {} bytes for event of "
+                "type {:x}",
+                size, event_type);
+            throw msg_fmt("Unable to unserialize protobuf object");
+          }
+          pb->set_payload(std::move(content), offset, _bbdo_version.major_v);
+        } else
+          t.reset();
+      }
+      if (!t)
+        t.reset(info->get_operations().unserialize(buffer, size));
       if (t) {
         t->source_id = source_id;
         t->destination_id = destination_id;
@@ -295,103 +275,6 @@ io::data* stream::unserialize(uint32_t event_type,
   return nullptr;
 }
 
-/**
- *  Get a boolean from an object.
- */
-static void get_boolean(io::data const& t,
-                        mapping::entry const& member,
-                        std::vector<char>& buffer) {
-  char c(member.get_bool(t) ? 1 : 0);
-  buffer.push_back(c);
-}
-
-/**
- *  Get a double from an object.
- */
-static void get_double(io::data const& t,
-                       mapping::entry const& member,
-                       std::vector<char>& buffer) {
-  char str[32];
-  size_t strsz(snprintf(str, sizeof(str), "%f", member.get_double(t)) + 1);
-  if (strsz > sizeof(str))
-    strsz = sizeof(str);
-  std::copy(str, str + strsz, std::back_inserter(buffer));
-}
-
-/**
- *  Get an integer from an object.
- */
-static void get_integer(io::data const& t,
-                        mapping::entry const& member,
-                        std::vector<char>& buffer) {
-  uint32_t value(htonl(member.get_int(t)));
-  char* v(reinterpret_cast<char*>(&value));
-  std::copy(v, v + sizeof(value), std::back_inserter(buffer));
-}
-
-/**
- *  Get a short from an object.
- */
-static void get_short(io::data const& t,
-                      mapping::entry const& member,
-                      std::vector<char>& buffer) {
-  uint16_t value(htons(member.get_short(t)));
-  char* v(reinterpret_cast<char*>(&value));
-  std::copy(v, v + sizeof(value), std::back_inserter(buffer));
-}
-
-/**
- *  Get a string from an object.
- */
-static void get_string(io::data const& t,
-                       mapping::entry const& member,
-                       std::vector<char>& buffer) {
-  std::string const& tmp(member.get_string(t));
-  std::copy(tmp.c_str(), tmp.c_str() + tmp.size() + 1,
-            std::back_inserter(buffer));
-}
-
-/**
- *  Get a timestamp from an object.
- */
-static void get_timestamp(io::data const& t,
-                          mapping::entry const& member,
-                          std::vector<char>& buffer) {
-  uint64_t ts(member.get_time(t).get_time_t());
-  uint32_t high{htonl(ts >> 32)};
-  uint32_t low{htonl(ts & 0xffffffff)};
-  char* vh{reinterpret_cast<char*>(&high)};
-  char* vl{reinterpret_cast<char*>(&low)};
-  std::copy(vh, vh + sizeof(high), std::back_inserter(buffer));
-  std::copy(vl, vl + sizeof(low), std::back_inserter(buffer));
-}
-
-/**
- *  Get an uint32_teger from an object.
- */
-static void get_uint(io::data const& t,
-                     mapping::entry const& member,
-                     std::vector<char>& buffer) {
-  uint32_t value{htonl(member.get_uint(t))};
-  char* v{reinterpret_cast<char*>(&value)};
-  std::copy(v, v + sizeof(value), std::back_inserter(buffer));
-}
-
-/**
- *  Get an uint64_teger from an object.
- */
-static void get_ulong(io::data const& t,
-                      mapping::entry const& member,
-                      std::vector<char>& buffer) {
-  uint64_t value{member.get_ulong(t)};
-  uint32_t high{htonl(value >> 32)};
-  uint32_t low{htonl(value & 0xffffffff)};
-  char* vh{reinterpret_cast<char*>(&high)};
-  char* vl{reinterpret_cast<char*>(&low)};
-  std::copy(vh, vh + sizeof(high), std::back_inserter(buffer));
-  std::copy(vl, vl + sizeof(low), std::back_inserter(buffer));
-}
-
 /**
  *  Serialize an event in the BBDO protocol.
  *
@@ -400,147 +283,40 @@ static void get_ulong(io::data const& t,
  *  @return Serialized event.
  */
 io::raw* stream::serialize(const io::data& e) {
-  std::deque<std::vector<char>> queue;
-
   // Get event info (mapping).
   const io::event_info* info = io::events::instance().get_event_info(e.type());
   if (info) {
-    // Serialize properties of the object.
-    const mapping::entry* current_entry = info->get_mapping();
-    if (current_entry) {
-      // Serialization buffer.
-      queue.emplace_back(std::vector<char>());
-      auto* header = &queue.back();
-      header->resize(BBDO_HEADER_SIZE);
-      queue.emplace_back(std::vector<char>());
-      auto* content = &queue.back();
-
-      for (mapping::entry const* current_entry(info->get_mapping());
-           !current_entry->is_null(); ++current_entry) {
-        // Skip entries that should not be serialized.
-        if (current_entry->get_serialize())
-          switch (current_entry->get_type()) {
-            case mapping::source::BOOL:
-              get_boolean(e, *current_entry, *content);
-              break;
-            case mapping::source::DOUBLE:
-              get_double(e, *current_entry, *content);
-              break;
-            case mapping::source::INT:
-              get_integer(e, *current_entry, *content);
-              break;
-            case mapping::source::SHORT:
-              get_short(e, *current_entry, *content);
-              break;
-            case mapping::source::STRING:
-              get_string(e, *current_entry, *content);
-              break;
-            case mapping::source::TIME:
-              get_timestamp(e, *current_entry, *content);
-              break;
-            case mapping::source::UINT:
-              get_uint(e, *current_entry, *content);
-              break;
-            case mapping::source::ULONG:
-              get_ulong(e, *current_entry, *content);
-              break;
-            default:
-              SPDLOG_LOGGER_ERROR(
-                  _logger,
-                  "BBDO: invalid mapping for object of type '{}': {} is not a "
-                  "known type ID",
-                  info->get_name(), current_entry->get_type());
-              throw msg_fmt(
-                  "BBDO: invalid mapping for object"
-                  " of type '{}"
-                  "': {}"
-                  " is not a known type ID",
-                  info->get_name(), current_entry->get_type());
-          }
-
-        // Packet splitting.
-        while (content->size() >= 0xffff) {
-          queue.emplace_back(std::vector<char>());
-          auto* new_header = &queue.back();
-          new_header->resize(BBDO_HEADER_SIZE);
-          queue.emplace_back(content->begin() + 0xffff, content->end());
-          content->resize(0xffff);
-          auto* new_content = &queue.back();
-          *(reinterpret_cast<uint16_t*>(header->data() + 2)) = 0xffff;
-          *(reinterpret_cast<uint32_t*>(header->data() + 4)) = htonl(e.type());
-          *(reinterpret_cast<uint32_t*>(header->data() + 8)) =
-              htonl(e.source_id);
-          *(reinterpret_cast<uint32_t*>(header->data() + 12)) =
-              htonl(e.destination_id);
-
-          *(reinterpret_cast<uint16_t*>(header->data())) = htons(
-              misc::crc16_ccitt(header->data() + 2, BBDO_HEADER_SIZE - 2));
-          content = new_content;
-          header = new_header;
-        }
-      }
-
-      *(reinterpret_cast<uint16_t*>(header->data() + 2)) =
-          htons(content->size());
-      *(reinterpret_cast<uint32_t*>(header->data() + 4)) = htonl(e.type());
-      *(reinterpret_cast<uint32_t*>(header->data() + 8)) = htonl(e.source_id);
-      *(reinterpret_cast<uint32_t*>(header->data() + 12)) =
-          htonl(e.destination_id);
-
-      *(reinterpret_cast<uint16_t*>(header->data())) =
-          htons(misc::crc16_ccitt(header->data() + 2, BBDO_HEADER_SIZE - 2));
+    // Serialization buffer, the first header is filled at the end.
+    std::unique_ptr<io::raw> buffer(std::make_unique<io::raw>());
+    std::vector<char>& data(buffer->get_buffer());
+    data.resize(BBDO_HEADER_SIZE);
 
+    if (info->get_mapping()) {
+      ++_events_serialized;
+      _get_plan(*info).serialize(e, data);
     } else {
-      /* Here is the protobuf case: no mapping */
-      std::string r{info->get_operations().serialize(e)};
-      size_t size = r.size();
-      auto it = r.begin();
-      do {
-        // Serialization buffer.
-        queue.emplace_back(std::vector<char>());
-        auto* content = &queue.back();
-        content->resize(BBDO_HEADER_SIZE);
-        if (size < 0xffff) {
-          content->insert(content->end(), it, r.end());
-          *(reinterpret_cast<uint16_t*>(content->data() + 2)) = htons(size);
-          *(reinterpret_cast<uint32_t*>(content->data() + 4)) = htonl(e.type());
-          *(reinterpret_cast<uint32_t*>(content->data() + 8)) =
-              htonl(e.source_id);
-          *(reinterpret_cast<uint32_t*>(content->data() + 12)) =
-              htonl(e.destination_id);
-
-          *(reinterpret_cast<uint16_t*>(content->data())) = htons(
-              misc::crc16_ccitt(content->data() + 2, BBDO_HEADER_SIZE - 2));
-          break;
-        } else {
-          content->insert(content->end(), it, it + 0xffff);
-          *(reinterpret_cast<uint16_t*>(content->data() + 2)) = 0xffff;
-          *(reinterpret_cast<uint32_t*>(content->data() + 4)) = htonl(e.type());
-          *(reinterpret_cast<uint32_t*>(content->data() + 8)) =
-              htonl(e.source_id);
-          *(reinterpret_cast<uint32_t*>(content->data() + 12)) =
-              htonl(e.destination_id);
-
-          *(reinterpret_cast<uint16_t*>(content->data())) = htons(
-              misc::crc16_ccitt(content->data() + 2, BBDO_HEADER_SIZE - 2));
-          size -= 0xffff;
-          it += 0xffff;
-        }
-      } while (size > 0);
+      /* Here is the protobuf case: no mapping. If the event still has the
+       * payload it has been received with, we write it as is. */
+      const auto* pb = dynamic_cast<const io::protobuf_base*>(&e);
+      std::shared_ptr<const io::protobuf_base::payload_buffer> payload;
+      if (pb)
+        payload = pb->payload(_bbdo_version.major_v);
+      if (payload) {
+        ++_events_passed_through;
+        data.reserve(BBDO_HEADER_SIZE * (payload->size() / 0xffff + 1) +
+                     payload->size());
+        data.insert(data.end(), payload->data(),
+                    payload->data() + payload->size());
+      } else {
+        ++_events_serialized;
+        std::string serialized = info->get_operations().serialize(e);
+        data.reserve(BBDO_HEADER_SIZE * (serialized.size() / 0xffff + 1) +
+                     serialized.size());
+        data.insert(data.end(), serialized.begin(), serialized.end());
+      }
     }
 
-    // Finalization: concatenation of all the vectors in the queue.
-    size_t size = 0;
-    for (auto& v : queue)
-      size += v.size();
-
-    // Serialization buffer.
-    std::unique_ptr<io::raw> buffer(std::make_unique<io::raw>());
-    std::vector<char>& data(buffer->get_buffer());
-    data.reserve(size);
-    for (auto& v : queue)
-      data.insert(data.end(), v.begin(), v.end());
-
+    finalize_packets(data, e);
     return buffer.release();
   } else {
     SPDLOG_LOGGER_INFO(
@@ -575,6 +351,12 @@ stream::stream(bool is_input,
       _events_received_since_last_ack(0),
       _last_sent_ack(time(nullptr)),
       _grpc_serialized(grpc_serialized),
+      _prefilter{false},
+      _wanted_events_version{0},
+      _events_parsed{0},
+      _events_skipped{0},
+      _events_passed_through{0},
+      _events_serialized{0},
       _extensions{extensions},
       _bbdo_version(config::applier::state::instance().get_bbdo_version()),
       _logger{log_v2::instance().get(log_v2::BBDO)} {
@@ -1167,16 +949,15 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
       // Now, _packet contains at least BBDO_HEADER_SIZE + packet_size bytes.
 
       std::vector<char> content;
+      size_t content_offset = 0;
       if (_packet.size() == BBDO_HEADER_SIZE + packet_size) {
         SPDLOG_LOGGER_TRACE(
             _logger, "packet matches header + content => extracting content");
-        // We remove the header from the packet: FIXME DBR this is not
-        // beautiful...
-
-        content = std::vector<char>(_packet.begin() + BBDO_HEADER_SIZE,
-                                    _packet.end());
+        /* The packet buffer is kept as is, without copy, the header is
+         * skipped with content_offset. */
+        content = std::move(_packet);
+        content_offset = BBDO_HEADER_SIZE;
         _packet.clear();
-        // The size should be of only packet_size now.
       } else {
         /* we have _packet.size() > BBDO_HEADER_SIZE + packet_size */
 
@@ -1194,6 +975,14 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
             previous_packet_size, content.size(), _packet.size());
       }
 
+      /* Parts of long events are pasted together without their header. */
+      auto strip_header = [&content, &content_offset] {
+        if (content_offset) {
+          content.erase(content.begin(), content.begin() + content_offset);
+          content_offset = 0;
+        }
+      };
+
       if (packet_size != 0xffff) {
         // Cool we can work with it!
 
@@ -1202,6 +991,7 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
           auto& b = *it;
           if (b.matches(event_id, source_id, dest_id)) {
             // Good, we've found it.
+            strip_header();
             b.push_back(std::move(content));
             content = b.to_vector();
             _buffer.erase(it);
@@ -1226,11 +1016,21 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
           }
         }
 
-        pack = content.data();
-
         // Maybe it is bigger now.
-        packet_size = content.size();
-        d.reset(unserialize(event_id, source_id, dest_id, pack, packet_size));
+        packet_size = content.size() - content_offset;
+        if (_prefilter && !_event_wanted(event_id)) {
+          /* No one wants this event, we return it as an undecoded one. It
+           * is still acknowledged to the peer. */
+          ++_events_skipped;
+          SPDLOG_LOGGER_TRACE(_logger,
+                              "skipped {} bytes for event of type {} wanted by "
+                              "no output",
+                              BBDO_HEADER_SIZE + packet_size, event_id);
+          return true;
+        }
+        ++_events_parsed;
+        d.reset(unserialize(event_id, source_id, dest_id, std::move(content),
+                            content_offset));
         if (d) {
           SPDLOG_LOGGER_TRACE(_logger,
                               "unserialized {} bytes for event of type {}",
@@ -1245,6 +1045,7 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
         return true;
       } else {
         // Is it the next part of an already known input buffer?
+        strip_header();
         bool done = false;
         for (auto it = _buffer.begin(); it != _buffer.end(); ++it) {
           auto& b = *it;
@@ -1285,6 +1086,35 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
   return false;
 }
 
+/**
+ * @brief Tell if an event type is wanted by at least one muxer of the
+ * multiplexing engine. BBDO control events and events the filters cannot
+ * represent are always wanted.
+ *
+ * @param event_id The event type.
+ *
+ * @return true if the event has to be unserialized.
+ */
+bool stream::_event_wanted(uint32_t event_id) {
+  uint16_t cat = category_of_type(event_id);
+  if (cat == io::bbdo || cat == io::internal || cat == io::none ||
+      cat >= multiplexing::max_filter_category ||
+      element_of_type(event_id) >= 64)
+    return true;
+
+  if (multiplexing::engine::subscribers_filter_version() !=
+      _wanted_events_version) {
+    auto engine = multiplexing::engine::instance_ptr();
+    if (!engine)
+      return true;
+    _wanted_events = engine->subscribers_filter(_wanted_events_version);
+    SPDLOG_LOGGER_DEBUG(_logger,
+                        "BBDO: events wanted by outputs changed to{}",
+                        _wanted_events.get_allowed_categories());
+  }
+  return _wanted_events.allows(event_id);
+}
+
 /**
  * @brief Fill the internal _packet vector until it reaches the given size. It
  * may be bigger. The deadline is the limit time after that an exception is
@@ -1357,6 +1187,18 @@ void stream::set_negotiate(bool negotiate) {
   _negotiate = negotiate;
 }
 
+/**
+ *  Set whether or not the stream should skip the unserialization of events
+ *  that no muxer of the multiplexing engine wants. This is only useful for
+ *  streams publishing their events to the engine. It is disabled by default
+ *  and enabled by the 'prefilter' option of BBDO input endpoints.
+ *
+ *  @param[in] prefilter  True to enable the pre-filtering.
+ */
+void stream::set_prefilter(bool prefilter) {
+  _prefilter = prefilter;
+}
+
 /**
  *  Set the timeout supported by this stream.
  *
@@ -1375,6 +1217,18 @@ void stream::statistics(nlohmann::json& tree) const {
   tree["bbdo_input_ack_limit"] = static_cast<double>(_ack_limit);
   tree["bbdo_unacknowledged_events"] =
       static_cast<double>(_events_received_since_last_ack);
+  if (_is_input) {
+    tree["bbdo_parsed_events"] = static_cast<double>(_events_parsed);
+    tree["bbdo_skipped_events"] = static_cast<double>(_events_skipped);
+  }
+  uint64_t written = _events_passed_through + _events_serialized;
+  if (written) {
+    tree["bbdo_passed_through_events"] =
+        static_cast<double>(_events_passed_through);
+    tree["bbdo_serialized_events"] = static_cast<double>(_events_serialized);
+    tree["bbdo_pass_through_ratio"] =
+        static_cast<double>(_events_passed_through) / written;
+  }
 
   if (_substream)
     _substream->statistics(tree);
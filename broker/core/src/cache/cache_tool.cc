@@ -0,0 +1,145 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ *  cbd-cache: inspect and compact the global cache file of a stopped broker.
+ *
+ *    cbd-cache info <path>
+ *    cbd-cache compact <path>
+ *
+ *  info only reads the file. compact removes the strings no more used from
+ *  the string pool and gives the free space of the file back to the file
+ *  system. The broker using the
+ *  file must be stopped: a file still opened by a broker is left untouched.
+ */
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "com/centreon/broker/cache/global_cache_data.hh"
+
+using namespace com::centreon::broker::cache;
+using com::centreon::common::log_v2::log_v2;
+
+static void usage() {
+  std::cerr << "usage:\n"
+               "  cbd-cache info <path>\n"
+               "  cbd-cache compact <path>\n"
+               "The broker using the cache file must be stopped.\n";
+}
+
+/**
+ *  Check that the file has been closed by its broker and that it uses the
+ *  current layout. Otherwise global_cache::load() would recreate it.
+ *
+ *  @param[in] path  The cache file.
+ *
+ *  @return true if the file can be opened.
+ */
+static bool check_closed(const char* path) {
+  try {
+    managed_mapped_file file(interprocess::open_read_only, path);
+    const bool* dirty = file.find<bool>("dirty").first;
+    const uint32_t* version = file.find<uint32_t>("layout_version").first;
+    if (!version || *version != global_cache::layout_version) {
+      std::cerr << path << ": written with another layout, it will be "
+                << "recreated by the broker\n";
+      return false;
+    }
+    if (!dirty || *dirty) {
+      std::cerr << path << ": still opened by a broker or not closed "
+                << "gracefully\n";
+      return false;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << path << ": cannot open the cache file: " << e.what() << '\n';
+    return false;
+  }
+  return true;
+}
+
+/**
+ *  Print the sizes of the cache file. The file is only read, info neither
+ *  marks it dirty nor compacts its string pool.
+ *
+ *  @param[in] path  The cache file.
+ */
+static void print_info(const std::string& path) {
+  global_cache_data::file_info info = global_cache_data::read_info(path);
+  std::cout << "file size:   " << info.file_size << '\n'
+            << "used size:   " << info.used_size << '\n'
+            << "string pool: " << info.string_pool_size << " strings\n";
+}
+
+/**
+ *  Compact the cache file. The string pool is compacted when the file is
+ *  opened, then the file is shrunk to the size really used. The size is kept
+ *  a multiple of 8 bytes, otherwise the broker would recreate the file.
+ *
+ *  @param[in] path  The cache file.
+ *
+ *  @return 0 on success.
+ */
+static int compact(const std::string& path) {
+  size_t before = global_cache::load(path)->file_size();
+  global_cache::unload();
+
+  if (!managed_mapped_file::shrink_to_fit(path.c_str())) {
+    std::cerr << path << ": cannot shrink the cache file\n";
+    return 1;
+  }
+  struct stat info;
+  if (::stat(path.c_str(), &info)) {
+    std::cerr << path << ": " << strerror(errno) << '\n';
+    return 1;
+  }
+  if (info.st_size & 0x07)
+    managed_mapped_file::grow(path.c_str(), 8 - (info.st_size & 0x07));
+
+  global_cache::pointer cache = global_cache::load(path);
+  std::cout << "file size:   " << before << " -> " << cache->file_size()
+            << '\n'
+            << "string pool: " << cache->string_pool_size() << " strings\n";
+  global_cache::unload();
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc != 3 || (strcmp(argv[1], "info") && strcmp(argv[1], "compact"))) {
+    usage();
+    return 1;
+  }
+  if (!check_closed(argv[2]))
+    return 1;
+
+  log_v2::load("cbd-cache");
+  int retval = 0;
+  try {
+    if (!strcmp(argv[1], "info"))
+      print_info(argv[2]);
+    else
+      retval = compact(argv[2]);
+  } catch (const std::exception& e) {
+    std::cerr << argv[2] << ": " << e.what() << '\n';
+    retval = 1;
+  }
+  log_v2::unload();
+  return retval;
+}
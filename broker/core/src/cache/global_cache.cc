@@ -59,11 +59,22 @@ void global_cache::_open(size_t initial_size_on_create, const void* address) {
         _file = std::make_unique<managed_mapped_file>(
             interprocess::open_only, _file_path.c_str(), address);
         bool* dirty = _file->find<bool>("dirty").first;
-        if (dirty && !*dirty) {
+        uint32_t* version = _file->find<uint32_t>("layout_version").first;
+        if (!version || *version != layout_version) {
+          SPDLOG_LOGGER_ERROR(
+              _logger,
+              "global_cache file written with another layout => erase file "
+              "and recreate");
+        } else if (dirty && !*dirty) {
           // dirty will be erased by destructor
           *dirty = true;
           SPDLOG_LOGGER_INFO(_logger, "global_cache open file {}", _file_path);
           this->managed_map(false);
+          size_t removed = compact_string_pool();
+          SPDLOG_LOGGER_INFO(_logger,
+                             "global_cache {} unused strings removed, {} "
+                             "strings in pool",
+                             removed, string_pool_size());
           return;
         } else {
           SPDLOG_LOGGER_ERROR(
@@ -95,6 +106,7 @@ void global_cache::_open(size_t initial_size_on_create, const void* address) {
     ::remove(_file_path.c_str());
     _grow(initial_size_on_create);
     *_file->find_or_construct<bool>("dirty")() = true;
+    *_file->find_or_construct<uint32_t>("layout_version")() = layout_version;
     try {
       this->managed_map(true);
     } catch (const boost::interprocess::bad_alloc& e) {
@@ -209,3 +221,27 @@ const void* global_cache::get_address() const {
   }
   return nullptr;
 }
+
+/**
+ * @brief Size of the mapped file
+ *
+ * @return size_t
+ */
+size_t global_cache::file_size() const {
+  absl::ReaderMutexLock l(&_protect);
+  return _file_size;
+}
+
+/**
+ * @brief Bytes of the mapped file used by the cache data (file size minus the
+ * free memory of the segment)
+ *
+ * @return size_t
+ */
+size_t global_cache::used_size() const {
+  absl::ReaderMutexLock l(&_protect);
+  if (_file) {
+    return _file->get_size() - _file->get_free_memory();
+  }
+  return 0;
+}
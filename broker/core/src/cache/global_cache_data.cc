@@ -17,7 +17,9 @@
  */
 
 #include "com/centreon/broker/cache/global_cache_data.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
 
+using namespace com::centreon::exceptions;
 using namespace com::centreon::broker::cache;
 
 void global_cache_data::managed_map(bool create) {
@@ -26,6 +28,8 @@ void global_cache_data::managed_map(bool create) {
       _file->get_segment_manager());
   _metric_info_allocator = _file->find_or_construct<metric_info_allocator>(
       "metric_info_allocator")(_file->get_segment_manager());
+  _string_pool = _file->find_or_construct<string_pool>("string_pool")(
+      _file->get_segment_manager());
   _index_id_mapping = _file->find_or_construct<index_id_mapping>(
       "index_id_mapping")(_file->get_segment_manager());
   _id_to_host = _file->find_or_construct<id_to_host>("id_to_host")(
@@ -46,6 +50,80 @@ void global_cache_data::managed_map(bool create) {
       _file->get_segment_manager());
 }
 
+/**
+ * @brief get the pooled copy of a string, it is added to the pool if not
+ * already there
+ * _protect must be locked
+ *
+ * @param str
+ * @return const string* never null
+ */
+const string* global_cache_data::_intern(const std::string_view& str) {
+  auto found = _string_pool->find(str, string_string_view_hash(),
+                                   string_string_view_equal());
+  if (found != _string_pool->end()) {
+    return &*found;
+  }
+  return &*_string_pool
+               ->emplace(str.data(), str.length(),
+                         _file->get_segment_manager())
+               .first;
+}
+
+/**
+ * @brief remove from the string pool the strings no more used by any metric
+ * (units or names of metrics that have been renamed)
+ *
+ * @return size_t the number of removed strings
+ */
+size_t global_cache_data::compact_string_pool() {
+  absl::WriterMutexLock l(&_protect);
+  absl::flat_hash_set<const string*> used;
+  used.reserve(_string_pool->size());
+  for (const auto& id_info : *_metric_info) {
+    used.insert(id_info.second->name.get());
+    used.insert(id_info.second->unit.get());
+  }
+  size_t removed = 0;
+  for (auto it = _string_pool->begin(); it != _string_pool->end();) {
+    if (used.contains(&*it)) {
+      ++it;
+    } else {
+      it = _string_pool->erase(it);
+      ++removed;
+    }
+  }
+  return removed;
+}
+
+/**
+ * @brief number of strings in the string pool
+ *
+ * @return size_t
+ */
+size_t global_cache_data::string_pool_size() const {
+  absl::ReaderMutexLock l(&_protect);
+  return _string_pool->size();
+}
+
+/**
+ * @brief read the sizes of a cache file. Unlike load(), the file is mapped
+ * read only: it is neither marked dirty nor compacted, so the string pool
+ * size is the one of the file as it was closed.
+ *
+ * @param file_path
+ * @return file_info
+ */
+global_cache_data::file_info global_cache_data::read_info(
+    const std::string& file_path) {
+  managed_mapped_file file(interprocess::open_read_only, file_path.c_str());
+  const string_pool* pool = file.find<string_pool>("string_pool").first;
+  if (!pool)
+    throw msg_fmt("no string pool in cache file {}", file_path);
+  return {file.get_size(), file.get_size() - file.get_free_memory(),
+          pool->size()};
+}
+
 /***********************************************************/
 /*                   feeders                               */
 /***********************************************************/
@@ -71,12 +149,8 @@ void global_cache_data::set_metric_info(uint64_t metric_id,
     auto exist = _metric_info->find(metric_id);
     if (exist != _metric_info->end()) {
       metric_info& to_update = *exist->second;
-      if (to_update.name != name) {
-        to_update.name.assign(name.data(), name.length());
-      }
-      if (to_update.unit != unit) {
-        to_update.unit.assign(unit.data(), unit.length());
-      }
+      to_update.name = _intern(name);
+      to_update.unit = _intern(unit);
       to_update.min = min;
       to_update.max = max;
       to_update.index_id = index_id;
@@ -84,9 +158,11 @@ void global_cache_data::set_metric_info(uint64_t metric_id,
       if (_metric_info->capacity() <= _metric_info->size()) {  // need to grow ?
         _metric_info->reserve(_metric_info->capacity() + 0x80000);
       }
+      const string* interned_name = _intern(name);
+      const string* interned_unit = _intern(unit);
       metric_info* to_add = _metric_info_allocator->allocate();
-      to_add = new (to_add) metric_info(index_id, name, unit, min, max,
-                                        _file->get_segment_manager());
+      to_add = new (to_add)
+          metric_info(index_id, interned_name, interned_unit, min, max);
 
       _metric_info->emplace(metric_id, to_add);
     }
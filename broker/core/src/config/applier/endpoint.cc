@@ -227,6 +227,18 @@ void endpoint::apply(std::list<config::endpoint> const& endpoints,
         auto mux = multiplexing::muxer::create(
             ep.name, multiplexing::engine::instance_ptr(), r_filter, w_filter,
             true);
+        bool coalesce_status = false;
+        auto it = ep.params.find("coalesce_status");
+        if (it != ep.params.end() &&
+            !absl::SimpleAtob(it->second, &coalesce_status)) {
+          SPDLOG_LOGGER_ERROR(
+              _logger,
+              "endpoint applier: cannot parse the 'coalesce_status' boolean "
+              "of endpoint '{}': the content is '{}'",
+              ep.name, it->second);
+          coalesce_status = false;
+        }
+        mux->set_coalesce_status(coalesce_status);
         endp.reset(_create_failover(ep, global_params, mux, e, endp_to_create));
       }
       {
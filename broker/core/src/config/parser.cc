@@ -610,7 +610,9 @@ void parser::_parse_endpoint(const json& elem,
               "config parser: A '{}' endpoint must have an entry "
               "'transport_protocol'",
               e.type);
-      } else if (e.type == "file")
+      } else if (e.type == "archive")
+        module.clear();  // archive is a core endpoint, no module needed
+      else if (e.type == "file")
         throw deprecated(
             "'file' endpoint is deprecated and should not be used anymore");
       else
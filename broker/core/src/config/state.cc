@@ -324,9 +324,12 @@ std::list<std::string>& state::module_list() noexcept {
 /**
  * @brief Add the module to the module list if not already present.
  *
- * @param module the module name to add.
+ * @param module the module name to add, empty for endpoints provided by the
+ * core.
  */
 void state::add_module(std::string module) {
+  if (module.empty())
+    return;
   bool conflict{false};
   if (module == "20-unified_sql.so")
     conflict = std::find(_module_list.begin(), _module_list.end(),
@@ -0,0 +1,669 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/archive.hh"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#include "com/centreon/broker/exceptions/corruption.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+using namespace com::centreon::broker::file::archive_format;
+
+/* zlib never compresses more than 1032 to 1. */
+static constexpr uint64_t max_compression_ratio = 1032;
+
+static void put_u32(char* buffer, uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    buffer[i] = static_cast<char>(value >> (8 * i));
+}
+
+static void put_u64(char* buffer, uint64_t value) {
+  for (int i = 0; i < 8; ++i)
+    buffer[i] = static_cast<char>(value >> (8 * i));
+}
+
+static uint32_t get_u32(const char* buffer) {
+  uint32_t retval = 0;
+  for (int i = 3; i >= 0; --i)
+    retval = (retval << 8) | static_cast<uint8_t>(buffer[i]);
+  return retval;
+}
+
+static uint64_t get_u64(const char* buffer) {
+  uint64_t retval = 0;
+  for (int i = 7; i >= 0; --i)
+    retval = (retval << 8) | static_cast<uint8_t>(buffer[i]);
+  return retval;
+}
+
+/**
+ *  The event type is the second field of the BBDO header, in network order.
+ */
+static uint32_t bbdo_type(const char* data, size_t size) {
+  if (size < 8)
+    return 0;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data) + 4;
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+         (uint32_t(p[2]) << 8) | p[3];
+}
+
+static std::string index_path(const std::string& path, uint64_t id) {
+  return archive_reader::segment_path(path, id) + ".idx";
+}
+
+/**
+ *  Write the whole buffers, retrying on partial writes.
+ */
+static void write_all(int fd, struct iovec* iov, int iovcnt) {
+  while (iovcnt > 0) {
+    ssize_t written = ::writev(fd, iov, iovcnt);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      throw msg_fmt("archive: write error: {}", strerror(errno));
+    }
+    while (iovcnt > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+      written -= iov->iov_len;
+      ++iov;
+      --iovcnt;
+    }
+    if (iovcnt > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+/**
+ *  Read up to size bytes at offset.
+ *
+ *  @return the number of bytes read, smaller than size only at end of file.
+ */
+static size_t pread_all(int fd, char* buffer, size_t size, uint64_t offset) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t rb = ::pread(fd, buffer + done, size - done, offset + done);
+    if (rb < 0) {
+      if (errno == EINTR)
+        continue;
+      throw msg_fmt("archive: read error: {}", strerror(errno));
+    }
+    if (rb == 0)
+      break;
+    done += rb;
+  }
+  return done;
+}
+
+/**
+ *  Append to index the records written after the ones it already contains.
+ */
+static void read_records(int fd, std::vector<archive_block_info>& index) {
+  char buffer[index_record_size * 1024];
+  for (;;) {
+    uint64_t offset = index_header_size + index.size() * index_record_size;
+    size_t rb = pread_all(fd, buffer, sizeof(buffer), offset);
+    for (size_t pos = 0; pos + index_record_size <= rb;
+         pos += index_record_size) {
+      const char* rec = buffer + pos;
+      archive_block_info& info = index.emplace_back();
+      info.offset = get_u64(rec);
+      info.first_ts = static_cast<int64_t>(get_u64(rec + 8));
+      info.last_ts = static_cast<int64_t>(get_u64(rec + 16));
+      info.types = get_u64(rec + 24);
+      info.nb_events = get_u32(rec + 32);
+      info.stored_size = get_u32(rec + 36);
+    }
+    if (rb < sizeof(buffer))
+      break;
+  }
+}
+
+/**
+ *  Check the header of a segment or of an index file.
+ *
+ *  @return false if the header is not entirely written yet.
+ */
+static bool check_header(int fd,
+                         const char (&magic)[8],
+                         uint64_t id,
+                         const std::string& path) {
+  char header[segment_header_size];
+  if (pread_all(fd, header, sizeof(header), 0) < sizeof(header))
+    return false;
+  if (memcmp(header, magic, sizeof(magic)) || get_u64(header + 8) != id)
+    throw exceptions::corruption("archive: '{}' has a bad header", path);
+  return true;
+}
+
+/**
+ *  Bit of an event type in the bloom filter of a block.
+ */
+uint64_t archive_block_info::type_bit(uint32_t type) {
+  return uint64_t(1) << ((type * 0x9e3779b97f4a7c15ull) >> 58);
+}
+
+/**
+ *  Constructor. Nothing is created until the first block is written.
+ *
+ *  @param path base path of the archive
+ *  @param max_segment_size a new segment is started when the current one
+ *  exceeds this size
+ *  @param block_size uncompressed size of a block
+ *  @param compression_level zlib level, 0 disables compression. The default,
+ *  1, is the fastest one, higher levels divide the write throughput by four
+ *  for a small gain
+ *  @param max_block_age a block is written once its first event is older than
+ *  this number of seconds
+ */
+archive_writer::archive_writer(const std::string& path,
+                               uint64_t max_segment_size,
+                               uint32_t block_size,
+                               int compression_level,
+                               time_t max_block_age)
+    : _base_path(path),
+      _max_segment_size(max_segment_size),
+      _block_size(block_size),
+      _compression_level(compression_level),
+      _max_block_age(max_block_age),
+      _segment_fd(-1),
+      _index_fd(-1),
+      _segment_size(0),
+      _nb_events(0),
+      _nb_blocks(0),
+      _raw_bytes(0),
+      _stored_bytes(0) {
+  std::vector<uint64_t> existing = archive_reader::segments(path);
+  _segment_id = existing.empty() ? 1 : existing.back() + 1;
+  _block.reserve(block_size + block_size / 4);
+}
+
+/**
+ *  Destructor, the pending block is written.
+ */
+archive_writer::~archive_writer() noexcept {
+  try {
+    flush();
+  } catch (const std::exception&) {
+  }
+  _close_segment();
+}
+
+/**
+ *  Append an event.
+ *
+ *  @param data BBDO packets of the event
+ *  @param size their size
+ *  @param ts arrival time of the event
+ */
+void archive_writer::write(const char* data, size_t size, int64_t ts) {
+  if (_block.empty()) {
+    _current = archive_block_info();
+    _current.first_ts = ts;
+    _current.last_ts = ts;
+  } else if (ts > _current.last_ts)
+    _current.last_ts = ts;
+
+  int64_t delta = std::clamp<int64_t>(ts - _current.first_ts,
+                                      std::numeric_limits<int32_t>::min(),
+                                      std::numeric_limits<int32_t>::max());
+  size_t pos = _block.size();
+  _block.resize(pos + event_header_size + size);
+  put_u32(_block.data() + pos, size);
+  put_u32(_block.data() + pos + 4, static_cast<uint32_t>(delta));
+  memcpy(_block.data() + pos + event_header_size, data, size);
+
+  _current.types |= archive_block_info::type_bit(bbdo_type(data, size));
+  ++_current.nb_events;
+  ++_nb_events;
+  _raw_bytes += size;
+
+  if (_block.size() >= _block_size ||
+      ts - _current.first_ts >= _max_block_age)
+    _write_block();
+}
+
+/**
+ *  Write the pending block, if any.
+ */
+void archive_writer::flush() {
+  _write_block();
+}
+
+/**
+ *  Create the segment _segment_id and its index. If a segment already exists
+ *  with this id, the next id is tried.
+ */
+void archive_writer::_open_segment() {
+  for (;;) {
+    std::string path = archive_reader::segment_path(_base_path, _segment_id);
+    _segment_fd = ::open(path.c_str(),
+                         O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC,
+                         0644);
+    if (_segment_fd >= 0)
+      break;
+    if (errno != EEXIST)
+      throw msg_fmt("archive: cannot create '{}': {}", path, strerror(errno));
+    ++_segment_id;
+  }
+  std::string idx_path = index_path(_base_path, _segment_id);
+  _index_fd = ::open(idx_path.c_str(),
+                     O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+  if (_index_fd < 0) {
+    int err = errno;
+    _close_segment();
+    throw msg_fmt("archive: cannot create '{}': {}", idx_path, strerror(err));
+  }
+
+  char header[segment_header_size];
+  memcpy(header, segment_magic, sizeof(segment_magic));
+  put_u64(header + 8, _segment_id);
+  struct iovec iov{header, sizeof(header)};
+  write_all(_segment_fd, &iov, 1);
+  memcpy(header, index_magic, sizeof(index_magic));
+  iov = {header, sizeof(header)};
+  write_all(_index_fd, &iov, 1);
+  _segment_size = segment_header_size;
+}
+
+void archive_writer::_close_segment() {
+  if (_segment_fd >= 0) {
+    ::close(_segment_fd);
+    _segment_fd = -1;
+  }
+  if (_index_fd >= 0) {
+    ::close(_index_fd);
+    _index_fd = -1;
+  }
+}
+
+/**
+ *  Compress the pending block and append it to the current segment, then
+ *  append its record to the index.
+ */
+void archive_writer::_write_block() {
+  if (_block.empty())
+    return;
+
+  const char* payload = _block.data();
+  uLongf stored_size = _block.size();
+  uint32_t flags = 0;
+  if (_compression_level) {
+    uLongf len = compressBound(_block.size());
+    _stored.resize(len);
+    if (compress2(reinterpret_cast<Bytef*>(_stored.data()), &len,
+                  reinterpret_cast<const Bytef*>(_block.data()), _block.size(),
+                  _compression_level) == Z_OK &&
+        len < _block.size()) {
+      payload = _stored.data();
+      stored_size = len;
+      flags = block_compressed;
+    }
+  }
+
+  if (_segment_fd >= 0 && _segment_size > segment_header_size &&
+      _segment_size + block_header_size + stored_size > _max_segment_size) {
+    _close_segment();
+    ++_segment_id;
+  }
+  if (_segment_fd < 0)
+    _open_segment();
+
+  char header[block_header_size];
+  put_u32(header, block_magic);
+  put_u32(header + 4, flags);
+  put_u32(header + 8, _block.size());
+  put_u32(header + 12, stored_size);
+  put_u32(header + 16, _current.nb_events);
+  put_u32(header + 20,
+          crc32(0, reinterpret_cast<const Bytef*>(payload), stored_size));
+  put_u64(header + 24, _current.first_ts);
+  put_u64(header + 32, _current.last_ts);
+  struct iovec iov[2]{{header, sizeof(header)},
+                      {const_cast<char*>(payload), stored_size}};
+  write_all(_segment_fd, iov, 2);
+
+  char record[index_record_size]{};
+  put_u64(record, _segment_size);
+  put_u64(record + 8, _current.first_ts);
+  put_u64(record + 16, _current.last_ts);
+  put_u64(record + 24, _current.types);
+  put_u32(record + 32, _current.nb_events);
+  put_u32(record + 36, stored_size);
+  iov[0] = {record, sizeof(record)};
+  write_all(_index_fd, iov, 1);
+
+  _segment_size += block_header_size + stored_size;
+  _stored_bytes += block_header_size + stored_size;
+  ++_nb_blocks;
+  _block.clear();
+}
+
+/**
+ *  Constructor. Nothing is opened until the first read or seek.
+ *
+ *  @param path base path of the archive
+ */
+archive_reader::archive_reader(const std::string& path)
+    : _base_path(path),
+      _segment_id(0),
+      _segment_fd(-1),
+      _index_fd(-1),
+      _next_block(0),
+      _raw_offset(0),
+      _block_first_ts(0),
+      _min_ts(std::numeric_limits<int64_t>::min()),
+      _types_mask(~uint64_t(0)) {}
+
+archive_reader::~archive_reader() noexcept {
+  _close_segment();
+}
+
+/**
+ *  Path of a segment.
+ */
+std::string archive_reader::segment_path(const std::string& path,
+                                         uint64_t id) {
+  return fmt::format("{}.{:06}", path, id);
+}
+
+/**
+ *  Ids of the segments of an archive, sorted.
+ *
+ *  @param path base path of the archive
+ */
+std::vector<uint64_t> archive_reader::segments(const std::string& path) {
+  std::vector<uint64_t> retval;
+  std::filesystem::path base(path);
+  std::filesystem::path dir = base.parent_path();
+  if (dir.empty())
+    dir = ".";
+  std::string prefix = base.filename().string() + ".";
+  std::error_code err;
+  for (auto& entry : std::filesystem::directory_iterator(dir, err)) {
+    std::string name = entry.path().filename().string();
+    if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix))
+      continue;
+    std::string_view suffix(name);
+    suffix.remove_prefix(prefix.size());
+    if (std::all_of(suffix.begin(), suffix.end(),
+                    [](char c) { return c >= '0' && c <= '9'; }))
+      retval.push_back(std::stoull(std::string(suffix)));
+  }
+  std::sort(retval.begin(), retval.end());
+  return retval;
+}
+
+/**
+ *  Read the whole index of a segment.
+ *
+ *  @param path base path of the archive
+ *  @param id segment id
+ */
+std::vector<archive_block_info> archive_reader::read_index(
+    const std::string& path,
+    uint64_t id) {
+  std::vector<archive_block_info> retval;
+  std::string idx_path = index_path(path, id);
+  int fd = ::open(idx_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    throw msg_fmt("archive: cannot open '{}': {}", idx_path, strerror(errno));
+  try {
+    if (check_header(fd, index_magic, id, idx_path))
+      read_records(fd, retval);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+  return retval;
+}
+
+/**
+ *  Only return events of these types. Blocks that contain none of them, as
+ *  told by their bloom filter, are not read.
+ *
+ *  @param types BBDO event types, empty to read all the events
+ */
+void archive_reader::set_type_filter(const std::vector<uint32_t>& types) {
+  _types = types;
+  std::sort(_types.begin(), _types.end());
+  if (_types.empty())
+    _types_mask = ~uint64_t(0);
+  else {
+    _types_mask = 0;
+    for (uint32_t t : _types)
+      _types_mask |= archive_block_info::type_bit(t);
+  }
+}
+
+bool archive_reader::_accept(uint32_t type) const {
+  return _types.empty() ||
+         std::binary_search(_types.begin(), _types.end(), type);
+}
+
+bool archive_reader::_open_segment(uint64_t id) {
+  _close_segment();
+  std::string path = segment_path(_base_path, id);
+  _segment_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (_segment_fd < 0)
+    return false;
+  std::string idx_path = index_path(_base_path, id);
+  _index_fd = ::open(idx_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (_index_fd < 0) {
+    _close_segment();
+    return false;
+  }
+  _segment_id = id;
+  _index.clear();
+  _next_block = 0;
+  _raw.clear();
+  _raw_offset = 0;
+  return true;
+}
+
+void archive_reader::_close_segment() {
+  if (_segment_fd >= 0) {
+    ::close(_segment_fd);
+    _segment_fd = -1;
+  }
+  if (_index_fd >= 0) {
+    ::close(_index_fd);
+    _index_fd = -1;
+  }
+}
+
+/**
+ *  Load the index records written since the last call.
+ */
+void archive_reader::_refresh_index() {
+  if (_index.empty() &&
+      !check_header(_index_fd, index_magic, _segment_id,
+                    index_path(_base_path, _segment_id)))
+    return;
+  read_records(_index_fd, _index);
+}
+
+/**
+ *  Open the segment following the current one.
+ *
+ *  @return false if there is no such segment.
+ */
+bool archive_reader::_next_segment() {
+  for (uint64_t id : segments(_base_path))
+    if (id > _segment_id && _open_segment(id))
+      return true;
+  return false;
+}
+
+/**
+ *  Read and decompress a block.
+ */
+void archive_reader::_read_block(const archive_block_info& info) {
+  size_t size = block_header_size + info.stored_size;
+  _stored.resize(size);
+  if (pread_all(_segment_fd, _stored.data(), size, info.offset) < size)
+    throw exceptions::corruption("archive: block at {} of segment {} truncated",
+                                 info.offset, _segment_id);
+  const char* header = _stored.data();
+  const char* payload = header + block_header_size;
+  uint32_t flags = get_u32(header + 4);
+  uint32_t raw_size = get_u32(header + 8);
+  /* The header is not covered by the crc, the raw size must at least be
+   * possible for the stored size. */
+  bool bad_raw_size =
+      flags & block_compressed
+          ? raw_size > uint64_t(info.stored_size) * max_compression_ratio
+          : raw_size != info.stored_size;
+  if (get_u32(header) != block_magic ||
+      get_u32(header + 12) != info.stored_size || bad_raw_size ||
+      get_u32(header + 20) != crc32(0, reinterpret_cast<const Bytef*>(payload),
+                                    info.stored_size))
+    throw exceptions::corruption("archive: block at {} of segment {} corrupted",
+                                 info.offset, _segment_id);
+
+  if (flags & block_compressed) {
+    _raw.resize(raw_size);
+    uLongf len = raw_size;
+    if (uncompress(reinterpret_cast<Bytef*>(_raw.data()), &len,
+                   reinterpret_cast<const Bytef*>(payload),
+                   info.stored_size) != Z_OK ||
+        len != raw_size)
+      throw exceptions::corruption(
+          "archive: cannot uncompress block at {} of segment {}", info.offset,
+          _segment_id);
+  } else
+    _raw.assign(payload, payload + info.stored_size);
+  _block_first_ts = static_cast<int64_t>(get_u64(header + 24));
+  _raw_offset = 0;
+}
+
+/**
+ *  Position the reader on the first event whose timestamp is greater or equal
+ *  to ts. Older events are no more returned.
+ *
+ *  Segments are chosen with the first record of their index, then the block
+ *  with the index of the segment. Timestamps are supposed to be
+ *  non-decreasing, if the clock went back, a few older events may be missed.
+ *
+ *  @param ts a timestamp in seconds
+ */
+void archive_reader::seek(int64_t ts) {
+  _min_ts = ts;
+  _close_segment();
+  _segment_id = 0;
+  _index.clear();
+  _next_block = 0;
+  _raw.clear();
+  _raw_offset = 0;
+
+  std::vector<uint64_t> ids = segments(_base_path);
+  auto starts_before = [this, ts](uint64_t id) {
+    std::string idx_path = index_path(_base_path, id);
+    int fd = ::open(idx_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return false;
+    char rec[index_record_size];
+    bool retval = pread_all(fd, rec, sizeof(rec), index_header_size) ==
+                      sizeof(rec) &&
+                  static_cast<int64_t>(get_u64(rec + 8)) <= ts;
+    ::close(fd);
+    return retval;
+  };
+  auto it = std::partition_point(ids.begin(), ids.end(), starts_before);
+  if (it != ids.begin())
+    --it;
+  for (; it != ids.end(); ++it) {
+    if (!_open_segment(*it))
+      continue;
+    _refresh_index();
+    _next_block = std::partition_point(_index.begin(), _index.end(),
+                                       [ts](const archive_block_info& info) {
+                                         return info.last_ts < ts;
+                                       }) -
+                  _index.begin();
+    return;
+  }
+}
+
+/**
+ *  Get the next event.
+ *
+ *  @param ev filled with the event, its data are valid until the next call
+ *
+ *  @return false if there is no more event for now.
+ */
+bool archive_reader::next(archive_event& ev) {
+  for (;;) {
+    while (_raw_offset < _raw.size()) {
+      if (_raw_offset + event_header_size > _raw.size())
+        throw exceptions::corruption(
+            "archive: truncated event in segment {}", _segment_id);
+      const char* header = _raw.data() + _raw_offset;
+      uint32_t size = get_u32(header);
+      int32_t delta = static_cast<int32_t>(get_u32(header + 4));
+      if (_raw_offset + event_header_size + size > _raw.size())
+        throw exceptions::corruption(
+            "archive: truncated event in segment {}", _segment_id);
+      _raw_offset += event_header_size + size;
+      ev.ts = _block_first_ts + delta;
+      ev.data = std::string_view(header + event_header_size, size);
+      ev.type = bbdo_type(ev.data.data(), size);
+      if (ev.ts >= _min_ts && _accept(ev.type))
+        return true;
+    }
+
+    if (_segment_fd < 0 && !_next_segment())
+      return false;
+
+    if (_next_block >= _index.size()) {
+      _refresh_index();
+      if (_next_block >= _index.size()) {
+        /* The writer completes a segment before creating the next one, so
+         * once a newer segment exists, this one is reread a last time. */
+        std::vector<uint64_t> ids = segments(_base_path);
+        if (ids.empty() || ids.back() <= _segment_id)
+          return false;
+        _refresh_index();
+        if (_next_block >= _index.size()) {
+          if (!_next_segment())
+            return false;
+          continue;
+        }
+      }
+    }
+
+    const archive_block_info& info = _index[_next_block++];
+    if (info.last_ts < _min_ts || !info.may_contain(_types_mask))
+      continue;
+    _read_block(info);
+  }
+}
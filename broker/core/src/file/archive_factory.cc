@@ -0,0 +1,90 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/archive_factory.hh"
+
+#include <absl/strings/numbers.h>
+
+#include "com/centreon/broker/file/archive_opener.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+
+/**
+ *  Read an optional integer parameter.
+ */
+template <typename T>
+static void read_param(const config::endpoint& cfg,
+                       const char* name,
+                       T& value) {
+  auto it = cfg.params.find(name);
+  if (it != cfg.params.end() && !absl::SimpleAtoi(it->second, &value))
+    throw msg_fmt("archive: '{}' must be an integer in endpoint '{}'", name,
+                  cfg.name);
+}
+
+/**
+ *  Check if a configuration match the archive layer.
+ *
+ *  @param[in] cfg  Endpoint configuration.
+ *
+ *  @return True if configuration matches the archive layer.
+ */
+bool archive_factory::has_endpoint(config::endpoint& cfg, io::extension* ext) {
+  if (ext)
+    *ext = io::extension("ARCHIVE", false, false);
+  if (cfg.type == "archive") {
+    cfg.params["protocol"] = "bbdo";
+    cfg.params["coarse"] = "yes";  // An archive doesn't negotiate.
+    return true;
+  }
+  return false;
+}
+
+/**
+ *  Generate an endpoint matching a configuration.
+ *
+ *  @param[in]  cfg          Endpoint configuration.
+ *  @param[out] is_acceptor  Will be set to false.
+ *  @param[in]  cache        Unused.
+ *
+ *  @return New endpoint.
+ */
+io::endpoint* archive_factory::new_endpoint(
+    config::endpoint& cfg,
+    const std::map<std::string, std::string>& global_params [[maybe_unused]],
+    bool& is_acceptor,
+    std::shared_ptr<persistent_cache> cache [[maybe_unused]]) const {
+  archive_config conf;
+  auto it = cfg.params.find("path");
+  if (it == cfg.params.end())
+    throw msg_fmt("archive: no 'path' defined for archive endpoint '{}'",
+                  cfg.name);
+  conf.path = it->second;
+
+  read_param(cfg, "max_segment_size", conf.max_segment_size);
+  read_param(cfg, "block_size", conf.block_size);
+  read_param(cfg, "compression_level", conf.compression_level);
+  read_param(cfg, "max_block_age", conf.max_block_age);
+  read_param(cfg, "replay_from", conf.replay_from);
+
+  is_acceptor = false;
+  return new archive_opener(conf);
+}
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/archive_opener.hh"
+
+#include "com/centreon/broker/multiplexing/muxer_filter.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+
+/**
+ *  Constructor.
+ *
+ *  @param config archive parameters
+ */
+archive_opener::archive_opener(const archive_config& config)
+    : io::endpoint(
+          false,
+          {},
+          multiplexing::muxer_filter(multiplexing::muxer_filter::zero_init())),
+      _config(config) {}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] other  Object to copy.
+ */
+archive_opener::archive_opener(const archive_opener& other)
+    : io::endpoint(other), _config(other._config) {}
+
+/**
+ *  Open a new stream.
+ *
+ *  @return Opened stream.
+ */
+std::shared_ptr<io::stream> archive_opener::open() {
+  return std::make_shared<archive_stream>(_config);
+}
@@ -0,0 +1,156 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/archive_stream.hh"
+
+#include "com/centreon/broker/io/raw.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+/* When the end of the archive is reached, the reader waits this delay before
+ * looking for new events. */
+static constexpr std::chrono::milliseconds _follow_delay(200);
+
+/**
+ *  Constructor.
+ *
+ *  @param config archive parameters
+ */
+archive_stream::archive_stream(const archive_config& config)
+    : io::stream("archive"),
+      _config(config),
+      _pending_events{0},
+      _logger{log_v2::instance().get(log_v2::CORE)} {}
+
+/**
+ *  Get peer name.
+ *
+ *  @return Peer name.
+ */
+std::string archive_stream::peer() const {
+  return fmt::format("archive://{}", _config.path);
+}
+
+/**
+ *  Read the next archived event.
+ *
+ *  @param[out] d         The BBDO packets of the event, null if there is
+ *                        nothing to read yet.
+ *  @param[in]  deadline  Timeout.
+ *
+ *  @return false if the deadline is reached without any event.
+ */
+bool archive_stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
+  d.reset();
+  if (!_reader) {
+    _reader = std::make_unique<archive_reader>(_config.path);
+    if (_config.replay_from > 0) {
+      SPDLOG_LOGGER_INFO(_logger, "archive: replay of '{}' from {}",
+                         _config.path, _config.replay_from);
+      _reader->seek(_config.replay_from);
+    }
+  }
+
+  archive_event ev;
+  if (_reader->next(ev)) {
+    d = std::make_shared<io::raw>(
+        std::vector<char>(ev.data.begin(), ev.data.end()));
+    return true;
+  }
+
+  if (deadline != static_cast<time_t>(-1) && time(nullptr) >= deadline)
+    return false;
+  std::this_thread::sleep_for(_follow_delay);
+  return true;
+}
+
+/**
+ *  Generate statistics about the archive.
+ *
+ *  @param[out] tree Output tree.
+ */
+void archive_stream::statistics(nlohmann::json& tree) const {
+  if (!_writer)
+    return;
+  tree["archive_segment"] = static_cast<double>(_writer->segment_id());
+  tree["archive_events"] = static_cast<double>(_writer->nb_events());
+  tree["archive_blocks"] = static_cast<double>(_writer->nb_blocks());
+  tree["archive_raw_bytes"] = static_cast<double>(_writer->raw_bytes());
+  tree["archive_stored_bytes"] = static_cast<double>(_writer->stored_bytes());
+}
+
+/**
+ *  Events are acknowledged once the block containing them is written. A block
+ *  is always entirely written, so either every pending event is written or
+ *  none of them is.
+ *
+ *  @return The number of events to acknowledge.
+ */
+int32_t archive_stream::_acknowledge() {
+  if (_writer && _writer->pending_events())
+    return 0;
+  int32_t retval = _pending_events;
+  _pending_events = 0;
+  return retval;
+}
+
+/**
+ *  Archive a serialized event.
+ *
+ *  @param[in] d  Data to write.
+ *
+ *  @return Number of events acknowledged.
+ */
+int32_t archive_stream::write(std::shared_ptr<io::data> const& d) {
+  ++_pending_events;
+  if (!validate(d, get_name()))
+    return _acknowledge();
+
+  if (d->type() == io::raw::static_type()) {
+    if (!_writer)
+      _writer = std::make_unique<archive_writer>(
+          _config.path, _config.max_segment_size, _config.block_size,
+          _config.compression_level, _config.max_block_age);
+    io::raw& data = static_cast<io::raw&>(*d);
+    _writer->write(data.data(), data.size(), time(nullptr));
+  }
+  return _acknowledge();
+}
+
+/**
+ *  Write the pending block.
+ *
+ *  @return Number of events acknowledged.
+ */
+int archive_stream::flush() {
+  if (_writer)
+    _writer->flush();
+  return _acknowledge();
+}
+
+/**
+ * @brief Flush the stream and stop it.
+ *
+ * @return The number of acknowledged events.
+ */
+int32_t archive_stream::stop() {
+  return flush();
+}
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ *  cbd-archive: inspect and replay BBDO archives written by an 'archive'
+ *  endpoint.
+ *
+ *    cbd-archive info <path>
+ *    cbd-archive dump <path> [--from T] [--to T] [--type C:E]...
+ *    cbd-archive replay <path> [--from T] [--to T] [--type C:E]...
+ *                              [--output FILE]
+ *
+ *  T is a timestamp in seconds or a local time as YYYY-MM-DDTHH:MM:SS.
+ *  --from uses the indexes to seek directly to the first block containing
+ *  events not older than T. replay writes the BBDO packets of the events, as
+ *  they were received by the endpoint, to FILE or to the standard output.
+ */
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <limits>
+
+#include "com/centreon/broker/file/archive.hh"
+
+using namespace com::centreon::broker::file;
+
+static void usage() {
+  std::cerr
+      << "usage:\n"
+         "  cbd-archive info <path>\n"
+         "  cbd-archive dump <path> [--from T] [--to T] [--type C:E]...\n"
+         "  cbd-archive replay <path> [--from T] [--to T] [--type C:E]... "
+         "[--output FILE]\n"
+         "T is a timestamp in seconds or a local time YYYY-MM-DDTHH:MM:SS\n"
+         "C:E is an event category and element, for example 1:27\n";
+}
+
+static bool parse_time(const char* str, int64_t& ts) {
+  char* end;
+  long long value = strtoll(str, &end, 10);
+  if (*end == 0 && end != str) {
+    ts = value;
+    return true;
+  }
+  struct tm tmp {};
+  const char* rest = strptime(str, "%Y-%m-%dT%H:%M:%S", &tmp);
+  if (!rest || *rest)
+    return false;
+  tmp.tm_isdst = -1;
+  ts = mktime(&tmp);
+  return true;
+}
+
+static bool parse_type(const char* str, uint32_t& type) {
+  unsigned category, element;
+  char trailing;
+  if (sscanf(str, "%u:%u%c", &category, &element, &trailing) != 2 ||
+      category > 0xffff || element > 0xffff)
+    return false;
+  type = (category << 16) | element;
+  return true;
+}
+
+static uint32_t be32(const char* data) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+         (uint32_t(p[2]) << 8) | p[3];
+}
+
+static int info(const std::string& path) {
+  uint64_t total_events = 0, total_blocks = 0, total_size = 0;
+  for (uint64_t id : archive_reader::segments(path)) {
+    std::vector<archive_block_info> index =
+        archive_reader::read_index(path, id);
+    uint64_t events = 0, size = 0;
+    for (auto& b : index) {
+      events += b.nb_events;
+      size += b.stored_size;
+    }
+    if (index.empty())
+      fmt::print("segment {:06}: empty\n", id);
+    else
+      fmt::print(
+          "segment {:06}: {} blocks, {} events, {} bytes, from {:%Y-%m-%d "
+          "%H:%M:%S} to {:%Y-%m-%d %H:%M:%S}\n",
+          id, index.size(), events, size,
+          fmt::localtime(static_cast<time_t>(index.front().first_ts)),
+          fmt::localtime(static_cast<time_t>(index.back().last_ts)));
+    total_events += events;
+    total_blocks += index.size();
+    total_size += size;
+  }
+  fmt::print("total: {} blocks, {} events, {} bytes\n", total_blocks,
+             total_events, total_size);
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+  std::string command(argv[1]);
+  std::string path(argv[2]);
+  if (command == "info")
+    return info(path);
+  if (command != "dump" && command != "replay") {
+    usage();
+    return 1;
+  }
+
+  int64_t from = std::numeric_limits<int64_t>::min();
+  int64_t to = std::numeric_limits<int64_t>::max();
+  std::vector<uint32_t> types;
+  const char* output = nullptr;
+  for (int i = 3; i < argc; ++i) {
+    bool ok = i + 1 < argc;
+    if (ok && !strcmp(argv[i], "--from"))
+      ok = parse_time(argv[++i], from);
+    else if (ok && !strcmp(argv[i], "--to"))
+      ok = parse_time(argv[++i], to);
+    else if (ok && !strcmp(argv[i], "--type"))
+      ok = parse_type(argv[++i], types.emplace_back());
+    else if (ok && !strcmp(argv[i], "--output") && command == "replay")
+      output = argv[++i];
+    else
+      ok = false;
+    if (!ok) {
+      usage();
+      return 1;
+    }
+  }
+
+  try {
+    archive_reader reader(path);
+    reader.set_type_filter(types);
+    if (from != std::numeric_limits<int64_t>::min())
+      reader.seek(from);
+
+    FILE* out = stdout;
+    if (output) {
+      out = fopen(output, "w");
+      if (!out) {
+        std::cerr << "cannot open " << output << ": " << strerror(errno)
+                  << std::endl;
+        return 1;
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t nb_events = 0, nb_bytes = 0;
+    archive_event ev;
+    while (reader.next(ev) && ev.ts <= to) {
+      ++nb_events;
+      nb_bytes += ev.data.size();
+      if (command == "replay")
+        fwrite(ev.data.data(), 1, ev.data.size(), out);
+      else
+        fmt::print(
+            "{:%Y-%m-%d %H:%M:%S} type {}:{} size {} source {} destination "
+            "{}\n",
+            fmt::localtime(static_cast<time_t>(ev.ts)), ev.type >> 16,
+            ev.type & 0xffff, ev.data.size(),
+            ev.data.size() >= 16 ? be32(ev.data.data() + 8) : 0,
+            ev.data.size() >= 16 ? be32(ev.data.data() + 12) : 0);
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (output)
+      fclose(out);
+    else
+      fflush(out);
+
+    if (command == "replay")
+      std::cerr << fmt::format(
+                       "{} events, {} bytes replayed in {:.3f}s ({:.0f} "
+                       "events/s, {:.1f} MB/s)",
+                       nb_events, nb_bytes, elapsed.count(),
+                       nb_events / elapsed.count(),
+                       nb_bytes / elapsed.count() / 1e6)
+                << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/io/protobuf.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker::io;
+using com::centreon::common::log_v2::log_v2;
+
+/**
+ * @brief Parse the payload into the message if not already done and release
+ * it. This method is thread safe and costs almost nothing once the parsing is
+ * done.
+ *
+ * The payload structure is checked when it is received and a malformed event
+ * is rejected there, so the parsing should not fail. If it does anyway, the
+ * error is logged and the message is left empty, it is too late to drop the
+ * event.
+ */
+void protobuf_base::_parse_payload() const {
+  std::call_once(_parsed, [this] {
+    std::shared_ptr<const payload_buffer> payload{
+        std::atomic_exchange(&_payload, {})};
+    if (payload &&
+        !_msg->ParseFromArray(payload->data(),
+                              static_cast<int>(payload->size()))) {
+      _msg->Clear();
+      SPDLOG_LOGGER_ERROR(log_v2::instance().get(log_v2::BBDO),
+                          "BBDO: unable to parse the payload of event of type "
+                          "{:x}, its content is lost",
+                          type());
+    }
+  });
+}
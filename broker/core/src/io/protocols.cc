@@ -19,6 +19,7 @@
 #include "com/centreon/broker/io/protocols.hh"
 #include <cassert>
 #include "com/centreon/broker/compression/factory.hh"
+#include "com/centreon/broker/file/archive_factory.hh"
 #include "com/centreon/broker/file/factory.hh"
 #include "common/log_v2/log_v2.hh"
 
@@ -119,6 +120,7 @@ void protocols::unreg(std::string const& name) {
 protocols::protocols() {
   // Registering internal protocols
   reg("file", std::make_shared<file::factory>(), 1, 3);
+  reg("archive", std::make_shared<file::archive_factory>(), 1, 3);
   reg("compression", std::make_shared<compression::factory>(), 6, 6);
 }
 
@@ -127,6 +129,7 @@ protocols::protocols() {
  */
 protocols::~protocols() noexcept {
   unreg("compression");
+  unreg("archive");
   unreg("file");
   log_v2::instance()
       .get(log_v2::CORE)
@@ -121,6 +121,17 @@ unsigned short entry::get_ushort(io::data const& d) const {
   return _source->get_ushort(d);
 }
 
+/**
+ *  Get the offset of the member in the object.
+ *
+ *  @param[in] d Object to work on.
+ *
+ *  @return The offset in bytes.
+ */
+uint32_t entry::get_offset(io::data const& d) const {
+  return _source->get_offset(d, _type);
+}
+
 /**
  *  Set the boolean value.
  *
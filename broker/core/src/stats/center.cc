@@ -37,6 +37,33 @@ using com::centreon::common::log_v2::log_v2;
 
 std::shared_ptr<center> center::_instance;
 
+/**
+ * @brief The shard used by the calling thread. Threads are spread over the
+ * shards in their creation order, so up to _shards_count threads never
+ * share a shard.
+ *
+ * @return An index in _shards.
+ */
+size_t counter::_shard_index() noexcept {
+  static std::atomic<size_t> next{0};
+  thread_local size_t idx =
+      next.fetch_add(1, std::memory_order_relaxed) % _shards_count;
+  return idx;
+}
+
+/**
+ * @brief Sum of all the shards. Concurrent additions may or may not be
+ * counted.
+ *
+ * @return The counter value.
+ */
+uint64_t counter::get() const noexcept {
+  uint64_t retval = 0;
+  for (auto& s : _shards)
+    retval += s.value.load(std::memory_order_relaxed);
+  return retval;
+}
+
 std::shared_ptr<center> center::instance_ptr() {
   assert(_instance);
   return _instance;
@@ -89,6 +116,51 @@ EngineStats* center::register_engine() {
   return _stats.mutable_processing()->mutable_engine();
 }
 
+/**
+ * @brief Register a muxer that will publish its queue sizes through the
+ * returned counters. Writing in them does not lock the center.
+ *
+ * Each call returns a new block: a muxer can be recreated with the same name
+ * before the previous one is destroyed, they must not share their counters.
+ *
+ * @param name The muxer name.
+ * @param queue_file The name of the muxer queue file.
+ *
+ * @return The muxer counters, until unregister_muxer() is called.
+ */
+std::shared_ptr<muxer_counters> center::register_muxer(
+    const std::string& name,
+    const std::string& queue_file) {
+  absl::MutexLock lck(&_stats_m);
+  muxer_block& b = _muxer_counters[name];
+  b.queue_file = queue_file;
+  b.counters = std::make_shared<muxer_counters>();
+  (*_stats.mutable_processing()->mutable_muxers())[name];
+  return b.counters;
+}
+
+/**
+ * @brief Copy the counters blocks into the protobuf statistics.
+ */
+void center::_collect() {
+  EngineStats* es = _stats.mutable_processing()->mutable_engine();
+  es->set_processed_events(
+      static_cast<uint32_t>(_engine_counters.processed_events.get()));
+  es->set_published_events(_engine_counters.published_events.get());
+  auto* muxers = _stats.mutable_processing()->mutable_muxers();
+  for (auto& [name, b] : _muxer_counters) {
+    MuxerStats& ms = (*muxers)[name];
+    ms.set_total_events(static_cast<uint32_t>(b.counters->total_events.get()));
+    ms.set_unacknowledged_events(
+        static_cast<uint32_t>(b.counters->unacknowledged_events.get()));
+    ms.set_coalesced_events(b.counters->coalesced_events.get());
+    if (b.counters->queue_file_open.load(std::memory_order_relaxed))
+      ms.mutable_queue_file()->set_name(b.queue_file);
+    else
+      ms.mutable_queue_file()->clear_name();
+  }
+}
+
 SqlConnectionStats* center::connection(size_t idx) {
   return &_stats.mutable_sql_manager()->mutable_connections()->at(idx);
 }
@@ -116,39 +188,22 @@ void center::remove_connection(SqlConnectionStats* stats) {
 
 /**
  * @brief Unregister a muxer from the stats. It removed its statistics from
- * the center statistics. In case of updates not already set to the stats,
- * the function waits for them before unregistering.
+ * the center statistics. Nothing is done if another muxer with the same name
+ * has been registered since, the statistics belong to it now.
  *
  * @param name The name of the concerned muxer.
- *
- * @return true on success (it never fails).
+ * @param counters The counters returned to this muxer by register_muxer().
  */
-void center::unregister_muxer(const std::string& name) {
+void center::unregister_muxer(const std::string& name,
+                              const std::shared_ptr<muxer_counters>& counters) {
   absl::MutexLock lck(&_stats_m);
+  auto found = _muxer_counters.find(name);
+  if (found == _muxer_counters.end() || found->second.counters != counters)
+    return;
+  _muxer_counters.erase(found);
   _stats.mutable_processing()->mutable_muxers()->erase(name);
 }
 
-/**
- * @brief Update the given muxer statistics in the center.
- *
- * @param name The name of the concerned muxer.
- * @param queue_file its queue file
- * @param size current total events.
- * @param unack current unacknowledged events.
- */
-void center::update_muxer(std::string name,
-                          std::string queue_file,
-                          uint32_t size,
-                          uint32_t unack) {
-  absl::MutexLock lck(&_stats_m);
-  auto ms = &(*_stats.mutable_processing()->mutable_muxers())[std::move(name)];
-  if (ms) {
-    ms->mutable_queue_file()->set_name(std::move(queue_file));
-    ms->set_total_events(size);
-    ms->set_unacknowledged_events(unack);
-  }
-}
-
 void center::init_queue_file(std::string muxer,
                              std::string queue_file,
                              uint32_t max_file_size) {
@@ -185,6 +240,7 @@ std::string center::to_string() {
   std::string retval;
   std::time_t now = time(nullptr);
   absl::MutexLock lck(&_stats_m);
+  _collect();
   _json_stats_file_creation = now;
   _stats.set_now(now);
   MessageToJsonString(_stats, &retval, options);
@@ -218,6 +274,7 @@ int center::get_json_stats_file_creation(void) {
 
 bool center::muxer_stats(const std::string& name, MuxerStats* response) {
   absl::MutexLock lck(&_stats_m);
+  _collect();
   if (!_stats.processing().muxers().contains(name))
     return false;
   else {
@@ -233,6 +290,7 @@ MuxerStats* center::muxer_stats(const std::string& name) {
 
 void center::get_processing_stats(ProcessingStats* response) {
   absl::MutexLock lck(&_stats_m);
+  _collect();
   *response = _stats.processing();
 }
 
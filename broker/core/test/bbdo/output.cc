@@ -20,14 +20,20 @@
 #include <arpa/inet.h>
 #include <gtest/gtest.h>
 
+#include "com/centreon/broker/bbdo/internal.hh"
 #include "com/centreon/broker/bbdo/stream.hh"
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/config/applier/modules.hh"
 #include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/mapping/entry.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/misc/variant.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/broker/neb/instance.hh"
+#include "com/centreon/broker/neb/internal.hh"
+#include "com/centreon/broker/neb/service_status.hh"
 #include "com/centreon/broker/persistent_file.hh"
 #include "common/log_v2/log_v2.hh"
 
@@ -453,3 +459,263 @@ TEST_F(OutputTest, ServiceTooShortAndAGoodOne) {
   ASSERT_EQ(new_svc->output, std::string("SecondOutput"));
   ASSERT_EQ(new_svc->perf_data, std::string("metric=3.14"));
 }
+
+// Given a bbdo input stream with the pre-filtering enabled
+// And a running engine whose only muxer wants service_status events
+// When a service and then a service_status are received
+// Then the service is skipped without being unserialized
+// And the service_status is unserialized.
+TEST_F(OutputTest, PrefilterSkipsUnwantedEvents) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+
+  auto engine = multiplexing::engine::instance_ptr();
+  engine->start();
+  multiplexing::muxer_filter f{neb::service_status::static_type()};
+  auto mux = multiplexing::muxer::create("bbdo_prefilter", engine, f, f, false);
+
+  std::shared_ptr<into_memory> memory_stream(std::make_shared<into_memory>());
+  bbdo::stream stm(true);
+  stm.set_substream(memory_stream);
+  stm.set_coarse(false);
+  stm.set_negotiate(false);
+  stm.set_prefilter(true);
+  stm.negotiate(bbdo::stream::negotiate_first);
+
+  auto svc = std::make_shared<neb::service>();
+  svc->host_id = 12345;
+  svc->service_id = 18;
+  stm.write(svc);
+  std::shared_ptr<io::data> e;
+  ASSERT_TRUE(stm.read(e, time(nullptr) + 1000));
+  ASSERT_FALSE(e);
+
+  auto ss = std::make_shared<neb::service_status>();
+  ss->host_id = 12345;
+  ss->service_id = 18;
+  ss->output = "Bonjour";
+  stm.write(ss);
+  ASSERT_TRUE(stm.read(e, time(nullptr) + 1000));
+  ASSERT_TRUE(e);
+  ASSERT_EQ(e->type(), neb::service_status::static_type());
+  ASSERT_EQ(std::static_pointer_cast<neb::service_status>(e)->output,
+            "Bonjour");
+
+  nlohmann::json tree;
+  stm.statistics(tree);
+  ASSERT_EQ(tree["bbdo_parsed_events"].get<double>(), 1);
+  ASSERT_EQ(tree["bbdo_skipped_events"].get<double>(), 1);
+  mux.reset();
+}
+
+TEST_F(OutputTest, PassThroughPayload) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+
+  std::shared_ptr<into_memory> memory_stream(std::make_shared<into_memory>());
+  bbdo::stream stm(true);
+  stm.set_substream(memory_stream);
+  stm.set_coarse(false);
+  stm.set_negotiate(false);
+  stm.negotiate(bbdo::stream::negotiate_first);
+
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_host_id(12345);
+  ss->mut_obj().set_service_id(18);
+  ss->mut_obj().set_output("Bonjour");
+  stm.write(ss);
+  std::shared_ptr<io::data> e;
+  ASSERT_TRUE(stm.read(e, time(nullptr) + 1000));
+  ASSERT_TRUE(e);
+  ASSERT_EQ(e->type(), neb::pb_service_status::static_type());
+
+  /* The event is written again as received. */
+  stm.write(e);
+  ASSERT_TRUE(stm.read(e, time(nullptr) + 1000));
+  ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+      std::static_pointer_cast<neb::pb_service_status>(e)->obj(), ss->obj()));
+
+  /* Once read, its payload is released and it is serialized. */
+  auto received = std::static_pointer_cast<neb::pb_service_status>(e);
+  ASSERT_EQ(received->obj().output(), "Bonjour");
+  stm.write(received);
+  ASSERT_TRUE(stm.read(e, time(nullptr) + 1000));
+  received = std::static_pointer_cast<neb::pb_service_status>(e);
+  ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+      received->obj(), ss->obj()));
+
+  received->mut_obj().set_output("Au revoir");
+  stm.write(received);
+  ASSERT_TRUE(stm.read(e, time(nullptr) + 1000));
+  ASSERT_EQ(std::static_pointer_cast<neb::pb_service_status>(e)->obj().output(),
+            "Au revoir");
+
+  nlohmann::json tree;
+  stm.statistics(tree);
+  ASSERT_EQ(tree["bbdo_passed_through_events"].get<double>(), 1);
+  ASSERT_EQ(tree["bbdo_serialized_events"].get<double>(), 3);
+}
+
+// All the mapped events are written and read back with all their serialized
+// members set.
+TEST_F(OutputTest, MappingPlanRoundTrip) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+
+  std::shared_ptr<into_memory> memory_stream(std::make_shared<into_memory>());
+  bbdo::stream stm(true);
+  stm.set_substream(memory_stream);
+  stm.set_coarse(false);
+  stm.set_negotiate(false);
+  stm.negotiate(bbdo::stream::negotiate_first);
+
+  size_t tested = 0;
+  for (auto& p : io::events::instance().get_events_by_category_name("all")) {
+    const io::event_info& info = p.second;
+    // bbdo events are consumed by the stream itself.
+    if (!info.get_mapping() || !info.get_operations().constructor ||
+        category_of_type(p.first) == io::bbdo)
+      continue;
+    std::shared_ptr<io::data> e(info.get_operations().constructor());
+    e->source_id = 3;
+    e->destination_id = 4;
+    int i = 0;
+    for (const mapping::entry* m = info.get_mapping(); !m->is_null();
+         ++m, ++i) {
+      if (!m->get_serialize())
+        continue;
+      switch (m->get_type()) {
+        case mapping::source::BOOL:
+          m->set_bool(*e, i % 2);
+          break;
+        case mapping::source::DOUBLE:
+          m->set_double(*e, i + 0.5);
+          break;
+        case mapping::source::INT:
+          m->set_int(*e, -1000 * i);
+          break;
+        case mapping::source::SHORT:
+          m->set_short(*e, i);
+          break;
+        case mapping::source::STRING:
+          m->set_string(*e, fmt::format("{}_{}", info.get_name(), i));
+          break;
+        case mapping::source::TIME:
+          m->set_time(*e, timestamp(1700000000 + i));
+          break;
+        case mapping::source::UINT:
+          m->set_uint(*e, 7 * i);
+          break;
+        case mapping::source::ULONG:
+          m->set_ulong(*e, (1ull << 40) + i);
+          break;
+      }
+    }
+    stm.write(e);
+    std::shared_ptr<io::data> r;
+    ASSERT_TRUE(stm.read(r, time(nullptr) + 1000));
+    ASSERT_TRUE(r) << info.get_name();
+    ASSERT_EQ(r->type(), p.first);
+    ASSERT_EQ(r->source_id, 3u);
+    ASSERT_EQ(r->destination_id, 4u);
+    for (const mapping::entry* m = info.get_mapping(); !m->is_null(); ++m) {
+      if (!m->get_serialize())
+        continue;
+      switch (m->get_type()) {
+        case mapping::source::BOOL:
+          ASSERT_EQ(m->get_bool(*r), m->get_bool(*e)) << info.get_name();
+          break;
+        case mapping::source::DOUBLE:
+          ASSERT_EQ(m->get_double(*r), m->get_double(*e)) << info.get_name();
+          break;
+        case mapping::source::INT:
+          ASSERT_EQ(m->get_int(*r), m->get_int(*e)) << info.get_name();
+          break;
+        case mapping::source::SHORT:
+          ASSERT_EQ(m->get_short(*r), m->get_short(*e)) << info.get_name();
+          break;
+        case mapping::source::STRING:
+          ASSERT_EQ(m->get_string(*r), m->get_string(*e)) << info.get_name();
+          break;
+        case mapping::source::TIME:
+          ASSERT_EQ(m->get_time(*r).get_time_t(),
+                    m->get_time(*e).get_time_t())
+              << info.get_name();
+          break;
+        case mapping::source::UINT:
+          ASSERT_EQ(m->get_uint(*r), m->get_uint(*e)) << info.get_name();
+          break;
+        case mapping::source::ULONG:
+          ASSERT_EQ(m->get_ulong(*r), m->get_ulong(*e)) << info.get_name();
+          break;
+      }
+    }
+    ++tested;
+  }
+  ASSERT_GT(tested, 10u);
+}
+
+TEST_F(OutputTest, MalformedPayload) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+
+  std::shared_ptr<into_memory> memory_stream(std::make_shared<into_memory>());
+  bbdo::stream stm(true);
+  stm.set_substream(memory_stream);
+  stm.set_coarse(false);
+  stm.set_negotiate(false);
+  stm.negotiate(bbdo::stream::negotiate_first);
+
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_host_id(12345);
+  ss->mut_obj().set_service_id(18);
+  ss->mut_obj().set_output("Bonjour");
+  stm.write(ss);
+
+  /* The payload is not covered by the header crc: its first field now
+   * announces more bytes than there are. */
+  std::vector<char>& mem = memory_stream->get_mutable_memory();
+  ASSERT_GT(mem.size(), BBDO_HEADER_SIZE + 2u);
+  mem[BBDO_HEADER_SIZE] = 0x0a;
+  mem[BBDO_HEADER_SIZE + 1] = 0x7f;
+  std::shared_ptr<io::data> e;
+  ASSERT_THROW(stm.read(e, time(nullptr) + 1000),
+               com::centreon::exceptions::msg_fmt);
+}
+
+// Given a pb_service_status written with a UTF-8 output
+// When the output bytes are replaced by invalid UTF-8 in the payload
+// Then the event is rejected when read, as its parsing would fail.
+TEST_F(OutputTest, InvalidUtf8StringInPayload) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/neb/10-neb.so");
+
+  std::shared_ptr<into_memory> memory_stream(std::make_shared<into_memory>());
+  bbdo::stream stm(true);
+  stm.set_substream(memory_stream);
+  stm.set_coarse(false);
+  stm.set_negotiate(false);
+  stm.negotiate(bbdo::stream::negotiate_first);
+
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_host_id(12345);
+  ss->mut_obj().set_service_id(18);
+  ss->mut_obj().set_output("Été chaud");
+  stm.write(ss);
+  std::vector<char> valid = memory_stream->get_memory();
+
+  std::shared_ptr<io::data> e;
+  ASSERT_TRUE(stm.read(e, time(nullptr) + 1000));
+  ASSERT_EQ(std::static_pointer_cast<neb::pb_service_status>(e)->obj().output(),
+            "Été chaud");
+
+  /* The payload is not covered by the header crc. */
+  std::vector<char>& mem = memory_stream->get_mutable_memory();
+  mem = valid;
+  std::string output("Été chaud");
+  auto it = std::search(mem.begin(), mem.end(), output.begin(), output.end());
+  ASSERT_NE(it, mem.end());
+  *it = '\xff';
+  ASSERT_THROW(stm.read(e, time(nullptr) + 1000),
+               com::centreon::exceptions::msg_fmt);
+}
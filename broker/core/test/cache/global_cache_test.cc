@@ -63,9 +63,9 @@ TEST_F(global_cache_test, CanBeMoved) {
       const metric_info* infos = obj->get_metric_info(ii);
       ASSERT_NE(infos, nullptr);
       std::string name_expected = fmt::format("metric_name_{}", ii);
-      ASSERT_FALSE(infos->name.compare(0, name_expected.length(),
-                                       name_expected.c_str()));
-      ASSERT_EQ(infos->unit, "metric_unit");
+      ASSERT_FALSE(infos->name->compare(0, name_expected.length(),
+                                        name_expected.c_str()));
+      ASSERT_EQ(*infos->unit, "metric_unit");
       ASSERT_EQ(infos->min, double(ii) / 100);
       ASSERT_EQ(infos->max, double(ii + 10.5) / 100);
       const string* instance_name = obj->get_instance_name(ii);
@@ -403,3 +403,101 @@ TEST_F(global_cache_test, Huge) {
   SPDLOG_LOGGER_INFO(log_v2::instance().get(log_v2::CORE),
                      "end of 10000 metric search");
 }
+
+TEST_F(global_cache_test, StringPool) {
+  global_cache::unload();
+  ::remove("/tmp/cache_test");
+  global_cache::pointer obj = global_cache::load("/tmp/cache_test");
+
+  for (unsigned ii = 0; ii < 1000; ++ii)
+    obj->set_metric_info(ii, ii + 1000, fmt::format("metric_{}", ii % 10),
+                         ii % 2 ? "ms" : "%", 0, 100);
+  ASSERT_EQ(obj->string_pool_size(), 12);
+  {
+    global_cache::lock l;
+    ASSERT_EQ(obj->get_metric_info(0)->name, obj->get_metric_info(10)->name);
+    ASSERT_EQ(obj->get_metric_info(1)->unit, obj->get_metric_info(3)->unit);
+    ASSERT_EQ(*obj->get_metric_info(3)->unit, "ms");
+  }
+
+  // all the ms metrics become s metrics
+  for (unsigned ii = 1; ii < 1000; ii += 2)
+    obj->set_metric_info(ii, ii + 1000, fmt::format("metric_{}", ii % 10),
+                         "s", 0, 100);
+  ASSERT_EQ(obj->string_pool_size(), 13);
+  ASSERT_EQ(obj->compact_string_pool(), 1);
+  ASSERT_EQ(obj->string_pool_size(), 12);
+
+  // the pool is kept in the file
+  obj.reset();
+  global_cache::unload();
+  obj = global_cache::load("/tmp/cache_test");
+  ASSERT_EQ(obj->string_pool_size(), 12);
+  {
+    global_cache::lock l;
+    ASSERT_EQ(*obj->get_metric_info(3)->unit, "s");
+    ASSERT_EQ(*obj->get_metric_info(13)->name, "metric_3");
+  }
+  obj.reset();
+  global_cache::unload();
+}
+
+TEST_F(global_cache_test, StringPoolCompactedOnOpen) {
+  global_cache::unload();
+  ::remove("/tmp/cache_test");
+  global_cache::pointer obj = global_cache::load("/tmp/cache_test");
+
+  for (unsigned ii = 0; ii < 100; ++ii)
+    obj->set_metric_info(ii, ii + 1000, fmt::format("metric_{}", ii), "ms", 0,
+                         100);
+  ASSERT_EQ(obj->string_pool_size(), 101);
+  // the metrics are renamed, the old names stay in the pool
+  for (unsigned ii = 0; ii < 100; ++ii)
+    obj->set_metric_info(ii, ii + 1000, fmt::format("metric_{}", ii % 10),
+                         "ms", 0, 100);
+  ASSERT_EQ(obj->string_pool_size(), 101);
+
+  // they are removed when the file is opened again
+  obj.reset();
+  global_cache::unload();
+  obj = global_cache::load("/tmp/cache_test");
+  ASSERT_EQ(obj->string_pool_size(), 11);
+  {
+    global_cache::lock l;
+    ASSERT_EQ(*obj->get_metric_info(57)->name, "metric_7");
+    ASSERT_EQ(*obj->get_metric_info(57)->unit, "ms");
+  }
+  obj.reset();
+  global_cache::unload();
+}
+
+TEST_F(global_cache_test, ReadInfo) {
+  global_cache::unload();
+  ::remove("/tmp/cache_test");
+  global_cache::pointer obj = global_cache::load("/tmp/cache_test");
+
+  for (unsigned ii = 0; ii < 100; ++ii)
+    obj->set_metric_info(ii, ii + 1000, fmt::format("metric_{}", ii), "ms", 0,
+                         100);
+  for (unsigned ii = 0; ii < 100; ++ii)
+    obj->set_metric_info(ii, ii + 1000, fmt::format("metric_{}", ii % 10),
+                         "ms", 0, 100);
+  size_t file_size = obj->file_size();
+  size_t used_size = obj->used_size();
+  obj.reset();
+  global_cache::unload();
+
+  // the file is neither compacted nor marked dirty
+  global_cache_data::file_info info =
+      global_cache_data::read_info("/tmp/cache_test");
+  ASSERT_EQ(info.file_size, file_size);
+  ASSERT_EQ(info.used_size, used_size);
+  ASSERT_EQ(info.string_pool_size, 101);
+  info = global_cache_data::read_info("/tmp/cache_test");
+  ASSERT_EQ(info.string_pool_size, 101);
+
+  obj = global_cache::load("/tmp/cache_test");
+  ASSERT_EQ(obj->string_pool_size(), 11);
+  obj.reset();
+  global_cache::unload();
+}
@@ -0,0 +1,308 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/file/archive.hh"
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "com/centreon/broker/exceptions/corruption.hh"
+#include "com/centreon/broker/file/archive_stream.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+
+class FileArchive : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _path = "/tmp/archive_test";
+    _remove_files();
+  }
+
+  void TearDown() override { _remove_files(); }
+
+ protected:
+  std::string _path;
+
+  void _remove_files() {
+    for (const std::string& f :
+         misc::filesystem::dir_content_with_filter("/tmp/", "archive_test.*"))
+      std::remove(f.c_str());
+  }
+
+  /* A fake BBDO event: a header with its type followed by its number. */
+  static std::vector<char> _event(uint32_t type, uint32_t num, size_t size) {
+    std::vector<char> retval(std::max<size_t>(size, 20), 'a' + num % 26);
+    uint32_t t = htonl(type);
+    memcpy(retval.data() + 4, &t, sizeof(t));
+    memcpy(retval.data() + 16, &num, sizeof(num));
+    return retval;
+  }
+
+  static uint32_t _num(const archive_event& ev) {
+    uint32_t retval;
+    memcpy(&retval, ev.data.data() + 16, sizeof(retval));
+    return retval;
+  }
+};
+
+// Given an archive written with small segments
+// When it is read
+// Then all the events are read back in order with their timestamps
+TEST_F(FileArchive, WriteRead) {
+  {
+    archive_writer writer(_path, 100000, 8192);
+    for (uint32_t i = 0; i < 20000; ++i) {
+      std::vector<char> ev = _event(0x10001, i, 50 + i % 200);
+      writer.write(ev.data(), ev.size(), 1000 + i / 100);
+    }
+  }
+  ASSERT_GT(archive_reader::segments(_path).size(), 1u);
+
+  archive_reader reader(_path);
+  archive_event ev;
+  uint32_t i = 0;
+  while (reader.next(ev)) {
+    ASSERT_EQ(_num(ev), i);
+    ASSERT_EQ(ev.data.size(), std::max<size_t>(50 + i % 200, 20));
+    ASSERT_EQ(ev.ts, 1000 + i / 100);
+    ASSERT_EQ(ev.type, 0x10001u);
+    ++i;
+  }
+  ASSERT_EQ(i, 20000u);
+}
+
+// Given an archive
+// When the reader seeks to a timestamp
+// Then the first event read is the first one with this timestamp
+TEST_F(FileArchive, Seek) {
+  {
+    archive_writer writer(_path, 100000, 8192);
+    for (uint32_t i = 0; i < 20000; ++i) {
+      std::vector<char> ev = _event(0x10001, i, 100);
+      writer.write(ev.data(), ev.size(), 1000 + i / 100);
+    }
+  }
+  archive_reader reader(_path);
+  archive_event ev;
+  reader.seek(1150);
+  ASSERT_TRUE(reader.next(ev));
+  ASSERT_EQ(ev.ts, 1150);
+  ASSERT_EQ(_num(ev), 15000u);
+
+  reader.seek(0);
+  ASSERT_TRUE(reader.next(ev));
+  ASSERT_EQ(_num(ev), 0u);
+
+  reader.seek(5000);
+  ASSERT_FALSE(reader.next(ev));
+}
+
+// Given an archive with two event types
+// When a type filter is set
+// Then only events of this type are read
+TEST_F(FileArchive, TypeFilter) {
+  {
+    archive_writer writer(_path, 100000, 8192);
+    for (uint32_t i = 0; i < 10000; ++i) {
+      std::vector<char> ev = _event(i % 10 ? 0x10002 : 0x10001, i, 100);
+      writer.write(ev.data(), ev.size(), 1000);
+    }
+  }
+  archive_reader reader(_path);
+  reader.set_type_filter({0x10001});
+  archive_event ev;
+  uint32_t count = 0;
+  while (reader.next(ev)) {
+    ASSERT_EQ(ev.type, 0x10001u);
+    ASSERT_EQ(_num(ev) % 10, 0u);
+    ++count;
+  }
+  ASSERT_EQ(count, 1000u);
+}
+
+// Given a writer that crashed while writing a block
+// When the archive is read
+// Then the partial block is ignored
+// And a new writer starts a new segment
+TEST_F(FileArchive, PartialBlock) {
+  {
+    archive_writer writer(_path);
+    for (uint32_t i = 0; i < 100; ++i) {
+      std::vector<char> ev = _event(0x10001, i, 100);
+      writer.write(ev.data(), ev.size(), 1000);
+    }
+  }
+  {
+    std::ofstream f(archive_reader::segment_path(_path, 1),
+                    std::ios::app | std::ios::binary);
+    f << "partially written block";
+  }
+  {
+    archive_writer writer(_path);
+    std::vector<char> ev = _event(0x10001, 100, 100);
+    writer.write(ev.data(), ev.size(), 1001);
+    writer.flush();
+    ASSERT_EQ(writer.segment_id(), 2u);
+  }
+
+  archive_reader reader(_path);
+  archive_event ev;
+  uint32_t i = 0;
+  while (reader.next(ev))
+    ASSERT_EQ(_num(ev), i++);
+  ASSERT_EQ(i, 101u);
+}
+
+// Given a writer appending events
+// When a reader follows the archive in another thread
+// Then it reads all the events in order
+TEST_F(FileArchive, ConcurrentReader) {
+  constexpr uint32_t nb_events = 50000;
+  std::atomic_bool done = false;
+  std::thread writer_thread([&] {
+    archive_writer writer(_path, 200000, 4096);
+    for (uint32_t i = 0; i < nb_events; ++i) {
+      std::vector<char> ev = _event(0x10001, i, 100);
+      writer.write(ev.data(), ev.size(), 1000 + i / 1000);
+    }
+    writer.flush();
+    done = true;
+  });
+
+  archive_reader reader(_path);
+  archive_event ev;
+  uint32_t i = 0;
+  while (i < nb_events) {
+    bool finished = done;
+    if (reader.next(ev))
+      ASSERT_EQ(_num(ev), i++);
+    else if (finished)
+      break;
+    else
+      std::this_thread::yield();
+  }
+  writer_thread.join();
+  ASSERT_EQ(i, nb_events);
+}
+
+// Given an archive stream
+// When serialized events are written then read through the stream
+// Then the same buffers are read back
+TEST_F(FileArchive, Stream) {
+  archive_config conf;
+  conf.path = _path;
+  {
+    archive_stream s(conf);
+    for (uint32_t i = 0; i < 100; ++i)
+      s.write(std::make_shared<io::raw>(_event(0x10001, i, 100)));
+    s.stop();
+  }
+  archive_stream s(conf);
+  for (uint32_t i = 0; i < 100; ++i) {
+    std::shared_ptr<io::data> d;
+    ASSERT_TRUE(s.read(d, -1));
+    ASSERT_TRUE(d);
+    ASSERT_EQ(std::static_pointer_cast<io::raw>(d)->_buffer,
+              _event(0x10001, i, 100));
+  }
+  std::shared_ptr<io::data> d;
+  ASSERT_FALSE(s.read(d, time(nullptr)));
+  ASSERT_FALSE(d);
+}
+
+// Given an archive stream
+// When events are written
+// Then they are acknowledged only once their block is written
+TEST_F(FileArchive, StreamAcknowledgesWrittenBlocks) {
+  archive_config conf;
+  conf.path = _path;
+  conf.block_size = 1000;
+  conf.max_block_age = 3600;
+  archive_stream s(conf);
+  int32_t acknowledged = 0;
+  for (uint32_t i = 0; i < 5; ++i)
+    acknowledged += s.write(std::make_shared<io::raw>(_event(0x10001, i, 100)));
+  ASSERT_EQ(acknowledged, 0);
+  // The tenth event fills the block.
+  for (uint32_t i = 5; i < 10; ++i)
+    acknowledged += s.write(std::make_shared<io::raw>(_event(0x10001, i, 100)));
+  ASSERT_EQ(acknowledged, 10);
+  acknowledged += s.write(std::make_shared<io::raw>(_event(0x10001, 10, 100)));
+  ASSERT_EQ(acknowledged, 10);
+  ASSERT_EQ(s.flush(), 1);
+  ASSERT_EQ(s.stop(), 0);
+}
+
+// Given a block whose raw size was altered in its header
+// When the archive is read
+// Then the block is reported as corrupted
+TEST_F(FileArchive, BadRawSize) {
+  {
+    archive_writer writer(_path);
+    for (uint32_t i = 0; i < 100; ++i) {
+      std::vector<char> ev = _event(0x10001, i, 100);
+      writer.write(ev.data(), ev.size(), 1000);
+    }
+  }
+  {
+    std::fstream f(archive_reader::segment_path(_path, 1),
+                   std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(archive_format::segment_header_size + 8);
+    f.write("\xff\xff\xff\xff", 4);
+  }
+  archive_reader reader(_path);
+  archive_event ev;
+  ASSERT_THROW(reader.next(ev), exceptions::corruption);
+}
+
+// Given events of realistic sizes written in many blocks
+// When they are replayed and a timestamp is looked for
+// Then all of them are read back and the seek finds the right block
+TEST_F(FileArchive, ManyBlocks) {
+  constexpr uint32_t nb_events = 50000;
+  std::vector<std::vector<char>> events;
+  for (uint32_t i = 0; i < 100; ++i)
+    events.push_back(_event(0x10000 | (1 + i % 30), i, 200 + i * 7 % 400));
+
+  {
+    archive_writer writer(_path);
+    for (uint32_t i = 0; i < nb_events; ++i) {
+      const std::vector<char>& ev = events[i % events.size()];
+      writer.write(ev.data(), ev.size(), 1000 + i / 1000);
+    }
+    writer.flush();
+    ASSERT_GT(writer.nb_blocks(), 1u);
+    ASSERT_LT(writer.stored_bytes(), writer.raw_bytes());
+  }
+
+  archive_reader reader(_path);
+  archive_event ev;
+  uint32_t count = 0;
+  while (reader.next(ev))
+    ++count;
+  ASSERT_EQ(count, nb_events);
+
+  reader.seek(1040);
+  ASSERT_TRUE(reader.next(ev));
+  ASSERT_EQ(ev.ts, 1040);
+}
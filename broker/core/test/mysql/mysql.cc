@@ -2297,3 +2297,75 @@ TEST_F(DatabaseStorageTest, bulk_or_multi_bbdo_event_multi) {
     ASSERT_EQ(select_res.value_as_i32(6), 789 + data_index);
   }
 }
+
+// Given a bulk_or_multi based on a bulk statement and another one based on
+// multi-rows inserts
+// When rows are added and then executed
+// Then row_count() counts the waiting rows in both modes
+// And they are ready once row_count_ready rows are waiting
+TEST_F(DatabaseStorageTest, bulk_or_multi_row_count) {
+  database_config db_cfg("MySQL", "127.0.0.1", MYSQL_SOCKET, 3306, "root",
+                         "centreon", "centreon_storage", 5, true, 5);
+  auto ms{std::make_unique<mysql>(db_cfg)};
+  std::string query1{"DROP TABLE IF EXISTS ut_test"};
+  std::string query2{
+      "CREATE TABLE ut_test (id BIGINT NOT NULL AUTO_INCREMENT "
+      "PRIMARY KEY, name VARCHAR(1000), value DOUBLE, t TINYINT, e "
+      "enum('a', "
+      "'b', 'c') DEFAULT 'a', i INT, u INT UNSIGNED)"};
+  ms->run_query(query1);
+  ms->commit();
+  ms->run_query(query2);
+  ms->commit();
+
+  database::bulk_or_multi bulk(
+      *ms, "INSERT INTO ut_test (name, value, t, e, i, u) VALUES (?,?,?,?,?,?)",
+      100, std::chrono::hours(1), 10);
+  database::bulk_or_multi multi(
+      "INSERT INTO ut_test (name, value, t, e, i, u) VALUES", "",
+      std::chrono::hours(1), 10);
+  ASSERT_TRUE(bulk.is_bulk());
+  ASSERT_FALSE(multi.is_bulk());
+
+  event_binder_index = 0;
+  bulk_event_binder bulk_binder;
+  multi_event_binder multi_filler;
+  for (database::bulk_or_multi* inserter : {&bulk, &multi}) {
+    ASSERT_EQ(inserter->row_count(), 0u);
+    ASSERT_EQ(inserter->get_oldest_waiting_event_delay(),
+              std::chrono::seconds(0));
+    ASSERT_FALSE(inserter->ready());
+  }
+
+  for (unsigned data_index = 0; data_index < 9; ++data_index) {
+    bulk.add_bulk_row(bulk_binder);
+    multi.add_multi_row(multi_filler);
+  }
+  ASSERT_EQ(bulk.row_count(), 9u);
+  ASSERT_EQ(multi.row_count(), 9u);
+  ASSERT_FALSE(bulk.ready());
+  ASSERT_FALSE(multi.ready());
+
+  bulk.add_bulk_row(bulk_binder);
+  multi.add_multi_row(multi_filler);
+  ASSERT_EQ(bulk.row_count(), 10u);
+  ASSERT_EQ(multi.row_count(), 10u);
+  ASSERT_TRUE(bulk.ready());
+  ASSERT_TRUE(multi.ready());
+
+  bulk.execute(*ms);
+  multi.execute(*ms);
+  ms->commit();
+  ASSERT_EQ(bulk.row_count(), 0u);
+  ASSERT_EQ(multi.row_count(), 0u);
+  ASSERT_FALSE(bulk.ready());
+  ASSERT_FALSE(multi.ready());
+
+  std::promise<mysql_result> select_prom;
+  std::future<mysql_result> select_fut = select_prom.get_future();
+  ms->run_query_and_get_result("SELECT COUNT(*) FROM ut_test",
+                               std::move(select_prom));
+  mysql_result select_res = select_fut.get();
+  ASSERT_TRUE(ms->fetch_row(select_res));
+  ASSERT_EQ(select_res.value_as_i32(0), 20);
+}
@@ -92,9 +92,15 @@ TEST_F(BrokerRpc, GetMuxerStats) {
       "1790\n"};
 
   auto center = stats::center::instance_ptr();
-  center->update_muxer("mx1", "qufl_", 18u, 1789u);
+  auto mx1 = center->register_muxer("mx1", "qufl_");
+  mx1->queue_file_open = true;
+  mx1->total_events.set(18u);
+  mx1->unacknowledged_events.set(1789u);
 
-  center->update_muxer("mx2", "_qufl", 18u, 1790u);
+  auto mx2 = center->register_muxer("mx2", "_qufl");
+  mx2->queue_file_open = true;
+  mx2->total_events.set(18u);
+  mx2->unacknowledged_events.set(1790u);
 
   std::list<std::string> output = execute("GetMuxerStats mx1 mx2");
 
@@ -104,5 +110,7 @@ TEST_F(BrokerRpc, GetMuxerStats) {
   ASSERT_EQ(output.size(), 2u);
   ASSERT_EQ(results, vectests);
 
+  center->unregister_muxer("mx1", mx1);
+  center->unregister_muxer("mx2", mx2);
   brpc.shutdown();
 }
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/stats/center.hh"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace com::centreon::broker;
+
+class StatsCenter : public ::testing::Test {
+ public:
+  void SetUp() override { stats::center::load(); }
+
+  void TearDown() override { stats::center::unload(); }
+};
+
+TEST_F(StatsCenter, MuxerCounters) {
+  auto center = stats::center::instance_ptr();
+  auto counters = center->register_muxer("mx1", "/tmp/mx1_queue");
+  counters->total_events.set(18);
+  counters->unacknowledged_events.set(7);
+  counters->queue_file_open = true;
+
+  MuxerStats ms;
+  ASSERT_TRUE(center->muxer_stats("mx1", &ms));
+  ASSERT_EQ(ms.total_events(), 18u);
+  ASSERT_EQ(ms.unacknowledged_events(), 7u);
+  ASSERT_EQ(ms.queue_file().name(), "/tmp/mx1_queue");
+
+  counters->queue_file_open = false;
+  counters->total_events.set(3);
+  ProcessingStats ps;
+  center->get_processing_stats(&ps);
+  ASSERT_EQ(ps.muxers().at("mx1").total_events(), 3u);
+  ASSERT_EQ(ps.muxers().at("mx1").queue_file().name(), "");
+
+  center->unregister_muxer("mx1", counters);
+  ASSERT_FALSE(center->muxer_stats("mx1", &ms));
+}
+
+/* A muxer is recreated with the same name before the old one is destroyed.
+ * The old one must not write in the new counters nor remove them. */
+TEST_F(StatsCenter, MuxerRecreatedWithSameName) {
+  auto center = stats::center::instance_ptr();
+  auto old_counters = center->register_muxer("mx1", "/tmp/mx1_queue");
+  old_counters->total_events.set(5);
+
+  auto new_counters = center->register_muxer("mx1", "/tmp/mx1_queue");
+  ASSERT_NE(old_counters, new_counters);
+  new_counters->total_events.set(9);
+  old_counters->total_events.set(100);
+
+  center->unregister_muxer("mx1", old_counters);
+  MuxerStats ms;
+  ASSERT_TRUE(center->muxer_stats("mx1", &ms));
+  ASSERT_EQ(ms.total_events(), 9u);
+
+  new_counters->total_events.set(11);
+  ASSERT_TRUE(center->muxer_stats("mx1", &ms));
+  ASSERT_EQ(ms.total_events(), 11u);
+
+  center->unregister_muxer("mx1", new_counters);
+  ASSERT_FALSE(center->muxer_stats("mx1", &ms));
+}
+
+TEST_F(StatsCenter, EngineCounters) {
+  auto center = stats::center::instance_ptr();
+  stats::engine_counters& counters = center->get_engine_counters();
+  counters.processed_events.set(12);
+  counters.published_events.add(12);
+  counters.published_events.add(5);
+
+  ProcessingStats ps;
+  center->get_processing_stats(&ps);
+  ASSERT_EQ(ps.engine().processed_events(), 12u);
+  ASSERT_EQ(ps.engine().published_events(), 17u);
+}
+
+/* 16 threads update the same statistic, first through the center mutex,
+ * then through a sharded counter. No update must be lost. */
+TEST_F(StatsCenter, Contention16Threads) {
+  constexpr int threads_count = 16;
+  constexpr uint64_t updates = 20000;
+  auto center = stats::center::instance_ptr();
+  EngineStats* es = center->register_engine();
+
+  auto run = [&](auto&& update) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threads_count; ++i)
+      threads.emplace_back([&update] {
+        for (uint64_t j = 0; j < updates; ++j)
+          update();
+      });
+    for (auto& t : threads)
+      t.join();
+  };
+
+  uint64_t locked_total = 0;
+  run([&] {
+    center->execute([&] {
+      ++locked_total;
+      es->set_queue_size(locked_total);
+    });
+  });
+
+  stats::counter counter;
+  run([&] { counter.add(); });
+
+  ASSERT_EQ(locked_total, threads_count * updates);
+  ASSERT_EQ(counter.get(), threads_count * updates);
+}
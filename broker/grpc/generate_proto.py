@@ -296,6 +296,10 @@ package com.centreon.broker.stream;
     fp.write(file_message_centreon_event)
     fp.write("""
     }
+    /* When both peers have agreed on it (see the centreon-batch metadata), an
+     * emitter may gather several events in this field, the content is then
+     * empty. */
+    repeated CentreonEvent batch = 125;
     uint32 destination_id = 126;
     uint32 source_id = 127;
 }
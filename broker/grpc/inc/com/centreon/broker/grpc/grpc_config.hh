@@ -32,13 +32,32 @@ class grpc_config : public com::centreon::common::grpc::grpc_config {
    */
   const bool _grpc_serialized;
 
+  /**
+   * @brief when _batch_max_events is greater than 1 and the peer accepts it,
+   * several events are sent in one grpc message. A batch contains at most
+   * _batch_max_events events and _batch_max_bytes bytes (one event is always
+   * accepted). If _batch_linger_ms is not null, an incomplete batch waits
+   * this delay for other events before being sent.
+   *
+   */
+  const uint32_t _batch_max_events;
+  const uint32_t _batch_max_bytes;
+  const uint32_t _batch_linger_ms;
+
  public:
   using pointer = std::shared_ptr<grpc_config>;
 
-  grpc_config() : _grpc_serialized(false) {}
+  grpc_config()
+      : _grpc_serialized(false),
+        _batch_max_events(0),
+        _batch_max_bytes(0),
+        _batch_linger_ms(0) {}
   grpc_config(const std::string& hostp)
       : com::centreon::common::grpc::grpc_config(hostp),
-        _grpc_serialized(false) {}
+        _grpc_serialized(false),
+        _batch_max_events(0),
+        _batch_max_bytes(0),
+        _batch_linger_ms(0) {}
   grpc_config(const std::string& hostp,
               bool crypted,
               const std::string& certificate,
@@ -48,7 +67,10 @@ class grpc_config : public com::centreon::common::grpc::grpc_config {
               const std::string& ca_name,
               bool compression,
               int second_keepalive_interval,
-              bool grpc_serialized)
+              bool grpc_serialized,
+              uint32_t batch_max_events = 0,
+              uint32_t batch_max_bytes = 0,
+              uint32_t batch_linger_ms = 0)
       : com::centreon::common::grpc::grpc_config(hostp,
                                                  crypted,
                                                  certificate,
@@ -58,12 +80,19 @@ class grpc_config : public com::centreon::common::grpc::grpc_config {
                                                  compression,
                                                  second_keepalive_interval),
         _authorization(authorization),
-        _grpc_serialized(grpc_serialized) {}
+        _grpc_serialized(grpc_serialized),
+        _batch_max_events(batch_max_events),
+        _batch_max_bytes(batch_max_bytes),
+        _batch_linger_ms(batch_linger_ms) {}
 
   constexpr const std::string& get_authorization() const {
     return _authorization;
   }
   constexpr bool get_grpc_serialized() const { return _grpc_serialized; }
+  constexpr uint32_t get_batch_max_events() const { return _batch_max_events; }
+  constexpr uint32_t get_batch_max_bytes() const { return _batch_max_bytes; }
+  constexpr uint32_t get_batch_linger_ms() const { return _batch_linger_ms; }
+  constexpr bool is_batch_enabled() const { return _batch_max_events > 1; }
 };
 
 }  // namespace com::centreon::broker::grpc
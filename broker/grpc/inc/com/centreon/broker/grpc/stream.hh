@@ -32,6 +32,7 @@ std::ostream& operator<<(std::ostream&, const CentreonEvent&);
 namespace grpc {
 
 extern const std::string authorization_header;
+extern const std::string batch_header;
 
 struct detail_centreon_event;
 std::ostream& operator<<(std::ostream&, const detail_centreon_event&);
@@ -58,12 +59,14 @@ struct event_with_data {
   std::shared_ptr<io::data> bbdo_event;
   typedef google::protobuf::Message* (grpc_event_type::*releaser_type)();
   releaser_type releaser;
+  /* serialized size of grpc_event, only computed when batches are enabled */
+  size_t byte_size;
 
-  event_with_data() : releaser(nullptr) {}
+  event_with_data() : releaser(nullptr), byte_size(0) {}
 
   event_with_data(const std::shared_ptr<io::data>& bbdo_evt,
                   releaser_type relser)
-      : bbdo_event(bbdo_evt), releaser(relser) {}
+      : bbdo_event(bbdo_evt), releaser(relser), byte_size(0) {}
 
   event_with_data(const event_with_data&) = delete;
   event_with_data& operator=(const event_with_data&) = delete;
@@ -83,7 +86,7 @@ class stream : public io::stream,
   static std::mutex _instances_m;
 
   using read_queue = std::queue<event_ptr>;
-  using write_queue = std::queue<event_with_data::pointer>;
+  using write_queue = std::deque<event_with_data::pointer>;
 
   read_queue _read_queue;
   write_queue _write_queue;
@@ -98,12 +101,23 @@ class stream : public io::stream,
   std::condition_variable _write_cond;
   std::mutex _write_m;
 
+  /* batch part: _batch_message borrows the grpc_event of the _in_flight first
+   * events of _write_queue, they are given back when the write is done. */
+  std::atomic_bool _peer_accepts_batch = false;
+  grpc_event_type _batch_message;
+  size_t _in_flight = 0;
+  bool _linger_armed = false;
+  bool _linger_elapsed = false;
+  boost::asio::steady_timer _linger_timer;
+
   grpc_config::pointer _conf;
   const std::string_view _class_name;
 
   std::mutex _protect;
 
   void start_write();
+  void _release_batch();
+  void _arm_linger_timer();
 
  protected:
   stream(const grpc_config::pointer& conf, const std::string_view& class_name);
@@ -114,6 +128,8 @@ class stream : public io::stream,
   /* Logger */
   std::shared_ptr<spdlog::logger> _logger;
 
+  void set_peer_accepts_batch();
+
  public:
   virtual ~stream();
 
@@ -140,6 +156,8 @@ class stream : public io::stream,
   int32_t stop() override;
 
   bool wait_for_all_events_written(unsigned ms_timeout) override;
+
+  bool is_batch_negotiated() const { return _peer_accepts_batch; }
 };
 
 }  // namespace grpc
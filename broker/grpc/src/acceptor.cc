@@ -55,6 +55,8 @@ class server_stream : public client_stream_base_class {
                 const std::shared_ptr<service_impl>& serv);
 
   void OnDone() override;
+
+  void accept_batch();
 };
 
 /**
@@ -66,6 +68,16 @@ server_stream::server_stream(const grpc_config::pointer& conf,
                              const std::shared_ptr<service_impl>& serv)
     : client_stream_base_class(conf, "accepted"), _parent(serv) {}
 
+/**
+ * @brief client and server accept batches, batch_header has been added to
+ * initial metadata that we send now
+ *
+ */
+void server_stream::accept_batch() {
+  set_peer_accepts_batch();
+  StartSendInitialMetadata();
+}
+
 /**
  * @brief shutdown bireactor
  *
@@ -149,6 +161,13 @@ service_impl::exchange(::grpc::CallbackServerContext* context) {
       std::make_shared<server_stream>(_conf, shared_from_this());
 
   server_stream::register_stream(next_stream);
+  if (_conf->is_batch_enabled()) {
+    const auto& metas = context->client_metadata();
+    if (metas.find(batch_header) != metas.end()) {
+      context->AddInitialMetadata(batch_header, "1");
+      next_stream->accept_batch();
+    }
+  }
   next_stream->start_read();
   {
     std::lock_guard l(_wait_m);
@@ -89,6 +89,8 @@ class client_stream : public stream_base_class {
  public:
   client_stream(const grpc_config::pointer& conf);
   ::grpc::ClientContext& get_context() { return _context; }
+
+  void OnReadInitialMetadataDone(bool ok) override;
 };
 
 /**
@@ -101,6 +103,24 @@ client_stream::client_stream(const grpc_config::pointer& conf)
   if (!conf->get_authorization().empty()) {
     _context.AddMetadata(authorization_header, conf->get_authorization());
   }
+  if (conf->is_batch_enabled()) {
+    _context.AddMetadata(batch_header, "1");
+  }
+}
+
+/**
+ * @brief server has sent its initial metadata, if it contains batch_header,
+ * it accepts batches
+ *
+ * @param ok
+ */
+void client_stream::OnReadInitialMetadataDone(bool ok) {
+  if (!ok)
+    return;
+  const auto& metas = _context.GetServerInitialMetadata();
+  if (metas.find(batch_header) != metas.end()) {
+    set_peer_accepts_batch();
+  }
 }
 
 /**
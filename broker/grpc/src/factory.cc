@@ -72,6 +72,51 @@ static std::string read_file(const std::string& path) {
     throw msg_fmt("Cannot open file '{}': {}", path, strerror(errno));
 }
 
+/**
+ * @brief read an unsigned integer parameter of the endpoint
+ *
+ * @param cfg Endpoint configuration.
+ * @param name Parameter name.
+ * @param value out: parameter value, unchanged if the parameter is missing.
+ */
+static void read_uint_param(
+    const com::centreon::broker::config::endpoint& cfg,
+    const std::string& name,
+    uint32_t& value) {
+  auto it = cfg.params.find(name);
+  if (it != cfg.params.end() && !absl::SimpleAtoi(it->second, &value)) {
+    log_v2::instance()
+        .get(log_v2::CORE)
+        ->error("GRPC: '{}' field should be an unsigned integer and not '{}'",
+                name, it->second);
+    throw msg_fmt("GRPC: '{}' field should be an unsigned integer and not '{}'",
+                  name, it->second);
+  }
+}
+
+/**
+ * @brief read batch parameters. Batches are disabled by default, they are
+ * enabled by setting batch_max_events greater than 1, and used only if the
+ * peer enables them too.
+ *
+ * @param cfg Endpoint configuration.
+ * @param max_events out: max events in a grpc message
+ * @param max_bytes out: max size of a grpc message (0 means no limit)
+ * @param linger_ms out: delay to wait for a full batch (0 means no delay)
+ */
+static void read_batch_params(
+    const com::centreon::broker::config::endpoint& cfg,
+    uint32_t& max_events,
+    uint32_t& max_bytes,
+    uint32_t& linger_ms) {
+  max_events = 0;
+  max_bytes = 1024 * 1024;
+  linger_ms = 0;
+  read_uint_param(cfg, "batch_max_events", max_events);
+  read_uint_param(cfg, "batch_max_bytes", max_bytes);
+  read_uint_param(cfg, "batch_linger_ms", linger_ms);
+}
+
 /**
  *  Create a new endpoint from a configuration.
  *
@@ -231,10 +276,14 @@ io::endpoint* factory::new_endpoint(
     hostport = fmt::format("{}:{}", host, port);
   }
 
+  uint32_t batch_max_events, batch_max_bytes, batch_linger_ms;
+  read_batch_params(cfg, batch_max_events, batch_max_bytes, batch_linger_ms);
+
   grpc_config::pointer conf(std::make_shared<grpc_config>(
       hostport, encrypted, certificate, certificate_key, certificate_authority,
       authorization, ca_name, compression, keepalive_interval,
-      direct_grpc_serialized(cfg)));
+      direct_grpc_serialized(cfg), batch_max_events, batch_max_bytes,
+      batch_linger_ms));
 
   std::unique_ptr<io::endpoint> endp;
 
@@ -461,10 +510,14 @@ io::endpoint* factory::_new_endpoint_bbdo_cs(
     hostport = fmt::format("{}:{}", host, port);
   }
 
+  uint32_t batch_max_events, batch_max_bytes, batch_linger_ms;
+  read_batch_params(cfg, batch_max_events, batch_max_bytes, batch_linger_ms);
+
   grpc_config::pointer conf(std::make_shared<grpc_config>(
       hostport, encryption, certificate, private_key, ca_certificate,
       authorization, ca_name, compression, keepalive_interval,
-      direct_grpc_serialized(cfg)));
+      direct_grpc_serialized(cfg), batch_max_events, batch_max_bytes,
+      batch_linger_ms));
 
   // Acceptor.
   std::unique_ptr<io::endpoint> endp;
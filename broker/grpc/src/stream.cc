@@ -50,6 +50,8 @@ std::ostream& operator<<(std::ostream& st,
       st << "buff: "
          << com::centreon::broker::misc::string::debug_buf(
                 to_dump.buffer().data(), to_dump.buffer().length(), 20);
+    } else if (to_dump.batch_size() > 0) {
+      st << "batch of " << to_dump.batch_size() << " events";
     } else {
       std::string dump{to_dump.ShortDebugString()};
       if (dump.size() > 200) {
@@ -95,6 +97,14 @@ std::ostream& operator<<(std::ostream& st,
 const std::string com::centreon::broker::grpc::authorization_header(
     "authorization");
 
+/**
+ * @brief this header is used to negotiate batches: the client sends it if it
+ * accepts to receive batches, the server answers with it in its initial
+ * metadata if it accepts them too.
+ *
+ */
+const std::string com::centreon::broker::grpc::batch_header("centreon-batch");
+
 /**
  * @brief when BiReactor::OnDone is called by grpc layers, we should delete
  * this. But this object is even used by feeder or failover.
@@ -121,6 +131,7 @@ template <class bireactor_class>
 stream<bireactor_class>::stream(const grpc_config::pointer& conf,
                                 const std::string_view& class_name)
     : io::stream("GRPC"),
+      _linger_timer(common::pool::io_context()),
       _conf(conf),
       _class_name(class_name),
       _logger{log_v2::instance().get(log_v2::GRPC)} {
@@ -135,6 +146,7 @@ stream<bireactor_class>::stream(const grpc_config::pointer& conf,
  */
 template <class bireactor_class>
 stream<bireactor_class>::~stream() {
+  _release_batch();
   SPDLOG_LOGGER_DEBUG(_logger, "delete {} this={:p}", _class_name,
                       static_cast<const void*>(this));
 }
@@ -191,7 +203,13 @@ void stream<bireactor_class>::OnReadDone(bool ok) {
       SPDLOG_LOGGER_TRACE(_logger, "{:p} {} receive: {}",
                           static_cast<const void*>(this), _class_name,
                           *_read_current);
-      _read_queue.push(_read_current);
+      if (_read_current->batch_size() > 0) {
+        /* Each event of the batch is queued alone, it shares the ownership of
+         * the received message so nothing is copied. */
+        for (grpc_event_type& evt : *_read_current->mutable_batch())
+          _read_queue.emplace(_read_current, &evt);
+      } else
+        _read_queue.push(_read_current);
       _read_current.reset();
     }
     _read_cond.notify_one();
@@ -257,8 +275,70 @@ bool stream<bireactor_class>::read(std::shared_ptr<io::data>& d,
 }
 
 /**
- * @brief peeks an event from write queue and pushes it on the wire
+ * @brief set by the server or client part when the peer has told it accepts
+ * batches
+ *
+ * @tparam bireactor_class
+ */
+template <class bireactor_class>
+void stream<bireactor_class>::set_peer_accepts_batch() {
+  if (_conf->is_batch_enabled()) {
+    SPDLOG_LOGGER_DEBUG(_logger, "{:p} {} batches of at most {} events enabled",
+                        static_cast<void*>(this), _class_name,
+                        _conf->get_batch_max_events());
+    _peer_accepts_batch = true;
+  }
+}
+
+/**
+ * @brief gives back to the write queue events borrowed by _batch_message
+ * _write_m must be locked
+ *
+ * @tparam bireactor_class
+ */
+template <class bireactor_class>
+void stream<bireactor_class>::_release_batch() {
+  auto* batch = _batch_message.mutable_batch();
+  while (!batch->empty())
+    batch->ReleaseLast();
+}
+
+/**
+ * @brief start linger timer, when it expires an incomplete batch is sent
+ * _write_m must be locked
+ *
+ * @tparam bireactor_class
+ */
+template <class bireactor_class>
+void stream<bireactor_class>::_arm_linger_timer() {
+  if (_linger_armed)
+    return;
+  _linger_armed = true;
+  _linger_timer.expires_after(
+      std::chrono::milliseconds(_conf->get_batch_linger_ms()));
+  _linger_timer.async_wait(
+      [me = std::enable_shared_from_this<
+           stream<bireactor_class>>::weak_from_this()](
+          const boost::system::error_code& err) {
+        if (err)
+          return;
+        auto self = me.lock();
+        if (!self)
+          return;
+        {
+          std::lock_guard l(self->_write_m);
+          self->_linger_armed = false;
+          self->_linger_elapsed = true;
+        }
+        self->start_write();
+      });
+}
+
+/**
+ * @brief peeks events from write queue and pushes them on the wire
  * does nothing if a write is already pending
+ * If batches have been negotiated, the first events of the queue are sent in
+ * one message, otherwise they are sent one by one.
  *
  * @tparam bireactor_class
  */
@@ -268,30 +348,62 @@ void stream<bireactor_class>::start_write() {
   if (!_alive) {
     return;
   }
-  event_with_data::pointer to_send;
+  const grpc_event_type* to_send;
   {
     std::unique_lock l(_write_m);
     if (_write_pending || _write_queue.empty()) {
       return;
     }
-    to_send = _write_queue.front();
+    size_t count = 1;
+    if (_peer_accepts_batch) {
+      const size_t max_events = _conf->get_batch_max_events();
+      if (_conf->get_batch_linger_ms() && _write_queue.size() < max_events &&
+          !_linger_elapsed) {
+        _arm_linger_timer();
+        return;
+      }
+      _linger_elapsed = false;
+      const size_t max_bytes = _conf->get_batch_max_bytes();
+      size_t bytes = _write_queue.front()->byte_size;
+      for (count = 1; count < max_events && count < _write_queue.size();
+           ++count) {
+        bytes += _write_queue[count]->byte_size;
+        if (max_bytes && bytes > max_bytes)
+          break;
+      }
+    }
+
+    if (count > 1) {
+      auto* batch = _batch_message.mutable_batch();
+      batch->Reserve(count);
+      for (size_t i = 0; i < count; ++i)
+        batch->AddAllocated(&_write_queue[i]->grpc_event);
+      to_send = &_batch_message;
+      SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write batch of {} events",
+                          static_cast<void*>(this), _class_name, count);
+    } else {
+      const event_with_data::pointer& first = _write_queue.front();
+      if (first->bbdo_event)
+        SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write: {}",
+                            static_cast<void*>(this), _class_name,
+                            *first->bbdo_event);
+      else
+        SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write: {}",
+                            static_cast<void*>(this), _class_name,
+                            first->grpc_event);
+      to_send = &first->grpc_event;
+    }
+    _in_flight = count;
     _write_pending = true;
   }
 
-  if (to_send->bbdo_event)
-    SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write: {}", static_cast<void*>(this),
-                        _class_name, *to_send->bbdo_event);
-  else
-    SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write: {}", static_cast<void*>(this),
-                        _class_name, to_send->grpc_event);
-
-  bireactor_class::StartWrite(&to_send->grpc_event);
+  bireactor_class::StartWrite(to_send);
 }
 
 /**
  * @brief write completion handler
- * if ok first element of write queue is popped and next event is pushed on the
- * wire
+ * if ok events sent are popped from write queue and next events are pushed on
+ * the wire
  *
  * @tparam bireactor_class
  * @param ok
@@ -301,22 +413,21 @@ void stream<bireactor_class>::OnWriteDone(bool ok) {
   if (ok) {
     {
       std::unique_lock l(_write_m);
-      event_with_data::pointer written = _write_queue.front();
-      if (written->bbdo_event)
-        SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write done: {}",
-                            static_cast<void*>(this), _class_name,
-                            *written->bbdo_event);
-      else
-        SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write done: {}",
-                            static_cast<void*>(this), _class_name,
-                            written->grpc_event);
-
-      _write_queue.pop();
+      _release_batch();
+      SPDLOG_LOGGER_TRACE(_logger, "{:p} {} write done: {} events",
+                          static_cast<void*>(this), _class_name, _in_flight);
+      _write_queue.erase(_write_queue.begin(),
+                         _write_queue.begin() + _in_flight);
+      _in_flight = 0;
       _write_pending = false;
     };
     _write_cond.notify_one();
     start_write();
   } else {
+    {
+      std::unique_lock l(_write_m);
+      _release_batch();
+    }
     SPDLOG_LOGGER_ERROR(_logger, "{:p} {} fail write to stream",
                         static_cast<void*>(this), _class_name);
     stop();
@@ -347,9 +458,12 @@ int32_t stream<bireactor_class>::write(std::shared_ptr<io::data> const& d) {
     to_send->grpc_event.mutable_buffer()->assign(raw_src->_buffer.begin(),
                                                  raw_src->_buffer.end());
   }
+  /* The size is computed here, out of the grpc threads. */
+  if (_peer_accepts_batch && _conf->get_batch_max_bytes())
+    to_send->byte_size = to_send->grpc_event.ByteSizeLong();
   {
     std::lock_guard l(_write_m);
-    _write_queue.push(to_send);
+    _write_queue.push_back(to_send);
   }
   start_write();
   return 0;
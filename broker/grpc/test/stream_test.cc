@@ -19,6 +19,7 @@
 
 #include "grpc_stream.grpc.pb.h"
 
+#include "com/centreon/broker/grpc/factory.hh"
 #include "com/centreon/broker/io/events.hh"
 #include "com/centreon/broker/io/protocols.hh"
 #include "common/log_v2/log_v2.hh"
@@ -468,3 +469,158 @@ TEST_P(grpc_test_server_crypted, ServerToClientWithKeyAndBadAuthorization) {
   ASSERT_FALSE(s->is_ready());
   client->stop();
 }
+
+static com::centreon::broker::grpc::grpc_config::pointer make_batch_conf(
+    const std::string& hostport,
+    uint32_t batch_max_events,
+    uint32_t batch_linger_ms = 0) {
+  return std::make_shared<com::centreon::broker::grpc::grpc_config>(
+      hostport, false, "", "", "", "", "", false, 30, false, batch_max_events,
+      1024 * 1024, batch_linger_ms);
+}
+
+using client_stream_class = com::centreon::broker::grpc::stream<
+    ::grpc::ClientBidiReactor<::com::centreon::broker::stream::CentreonEvent,
+                              ::com::centreon::broker::stream::CentreonEvent>>;
+using server_stream_class = com::centreon::broker::grpc::stream<
+    ::grpc::ServerBidiReactor<::com::centreon::broker::stream::CentreonEvent,
+                              ::com::centreon::broker::stream::CentreonEvent>>;
+
+/**
+ * @brief wait for the end of the batch negotiation (server initial metadata
+ * received by the client)
+ */
+static bool wait_batch_negotiated(const std::shared_ptr<io::stream>& client) {
+  auto strm = std::dynamic_pointer_cast<client_stream_class>(client);
+  if (!strm)
+    return false;
+  for (int i = 0; i < 100 && !strm->is_batch_negotiated(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  return strm->is_batch_negotiated();
+}
+
+/**
+ * @brief writes nb_events events to the stream to and check that they are all
+ * read in the same order from the stream from
+ */
+static void transfer(const std::shared_ptr<io::stream>& to,
+                     const std::shared_ptr<io::stream>& from,
+                     unsigned nb_events) {
+  std::thread writer([&to, nb_events]() {
+    for (unsigned ind = 0; ind < nb_events; ++ind)
+      to->write(create_event({0, 0, 0, fmt::format("event_{}", ind)}));
+  });
+  unsigned received = 0;
+  for (; received < nb_events; ++received) {
+    std::shared_ptr<io::data> receive;
+    if (!from->read(receive, time(nullptr) + 5))
+      break;
+    auto raw = std::dynamic_pointer_cast<io::raw>(receive);
+    if (!raw ||
+        std::string(raw->get_buffer().begin(), raw->get_buffer().end()) !=
+            fmt::format("event_{}", received)) {
+      ADD_FAILURE() << "unexpected event received at position " << received;
+      break;
+    }
+  }
+  writer.join();
+  EXPECT_EQ(received, nb_events);
+  EXPECT_TRUE(to->wait_for_all_events_written(1000));
+}
+
+/**
+ * @brief writes nb_events events from client to server and check that they
+ * are all received in the same order
+ */
+static void client_to_server_transfer(
+    com::centreon::broker::grpc::acceptor& server,
+    const com::centreon::broker::grpc::grpc_config::pointer& client_conf,
+    unsigned nb_events,
+    bool expect_batch) {
+  com::centreon::broker::grpc::connector conn(client_conf);
+  std::shared_ptr<io::stream> client = conn.open();
+  std::shared_ptr<io::stream> accepted = server.open();
+  EXPECT_NE(accepted.get(), nullptr);
+  if (!accepted)
+    return;
+  EXPECT_EQ(wait_batch_negotiated(client), expect_batch);
+
+  transfer(client, accepted, nb_events);
+  client->stop();
+  accepted->stop();
+}
+
+TEST(grpc_batch, ClientToServerBatched) {
+  com::centreon::broker::grpc::acceptor server(
+      make_batch_conf("127.0.0.1:4448", 64));
+  client_to_server_transfer(server, make_batch_conf("127.0.0.1:4448", 64),
+                            10000, true);
+}
+
+TEST(grpc_batch, ClientToServerBatchedWithLinger) {
+  com::centreon::broker::grpc::acceptor server(
+      make_batch_conf("127.0.0.1:4448", 64, 5));
+  client_to_server_transfer(server, make_batch_conf("127.0.0.1:4448", 64, 5),
+                            1000, true);
+}
+
+TEST(grpc_batch, ServerToClientBatched) {
+  com::centreon::broker::grpc::acceptor server(
+      make_batch_conf("127.0.0.1:4448", 64));
+  com::centreon::broker::grpc::connector conn(
+      make_batch_conf("127.0.0.1:4448", 64));
+  std::shared_ptr<io::stream> client = conn.open();
+  std::shared_ptr<io::stream> accepted = server.open();
+  ASSERT_NE(accepted.get(), nullptr);
+  ASSERT_TRUE(wait_batch_negotiated(client));
+  auto server_strm = std::dynamic_pointer_cast<server_stream_class>(accepted);
+  ASSERT_TRUE(server_strm);
+  ASSERT_TRUE(server_strm->is_batch_negotiated());
+
+  transfer(accepted, client, 10000);
+  client->stop();
+  accepted->stop();
+}
+
+TEST(grpc_batch, ServerRefusesBatch) {
+  com::centreon::broker::grpc::acceptor server(
+      make_batch_conf("127.0.0.1:4448", 0));
+  client_to_server_transfer(server, make_batch_conf("127.0.0.1:4448", 64),
+                            1000, false);
+}
+
+TEST(grpc_batch, ClientRefusesBatch) {
+  com::centreon::broker::grpc::acceptor server(
+      make_batch_conf("127.0.0.1:4448", 64));
+  client_to_server_transfer(server, make_batch_conf("127.0.0.1:4448", 0), 1000,
+                            false);
+}
+
+TEST(grpc_batch, DisabledByDefault) {
+  com::centreon::broker::grpc::factory fact;
+  bool is_acceptor;
+  std::shared_ptr<persistent_cache> cache;
+
+  config::endpoint server_cfg(config::endpoint::io_type::input);
+  server_cfg.type = "grpc";
+  server_cfg.params["port"] = "4448";
+  std::unique_ptr<io::endpoint> server(
+      fact.new_endpoint(server_cfg, {}, is_acceptor, cache));
+  ASSERT_TRUE(is_acceptor);
+
+  config::endpoint client_cfg(config::endpoint::io_type::output);
+  client_cfg.type = "grpc";
+  client_cfg.params["host"] = "127.0.0.1";
+  client_cfg.params["port"] = "4448";
+  std::unique_ptr<io::endpoint> connector(
+      fact.new_endpoint(client_cfg, {}, is_acceptor, cache));
+  ASSERT_FALSE(is_acceptor);
+
+  std::shared_ptr<io::stream> client = connector->open();
+  std::shared_ptr<io::stream> accepted = server->open();
+  ASSERT_NE(accepted.get(), nullptr);
+  ASSERT_FALSE(wait_batch_negotiated(client));
+  transfer(client, accepted, 1000);
+  client->stop();
+  accepted->stop();
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_LUA_BROKER_ASYNC_SOCKET_HH
+#define CCB_LUA_BROKER_ASYNC_SOCKET_HH
+
+extern "C" {
+#include "lauxlib.h"
+#include "lua.h"
+#include "lualib.h"
+}
+
+namespace com::centreon::broker::lua {
+
+/**
+ *  @class async_socket broker_async_socket.hh
+ * "com/centreon/broker/lua/broker_async_socket.hh"
+ *  @brief TCP client socket whose writes never block the Lua thread.
+ *
+ *  Data given to write() are appended to a send queue and the socket is
+ *  flushed in background by the broker pool. The connection is established
+ *  asynchronously too, data written while connecting are sent once
+ *  connected. When the queue exceeds max_queued_bytes, write() refuses new
+ *  data so that the script can slow down (back-pressure).
+ *
+ *  If the connection is lost and reconnect is enabled, the socket tries to
+ *  reconnect to the same address every reconnect_delay and the queue is kept.
+ *  A new connect() cancels the lookup or connection still running. Once
+ *  close() is called, write() refuses data until the next connect().
+ *
+ *  All the socket operations are done through a strand, the queue and the
+ *  statistics are protected by _queue_m.
+ */
+class async_socket : public std::enable_shared_from_this<async_socket> {
+ public:
+  enum state_t { unconnected, hostLookup, connecting, connected, closing };
+
+  struct options {
+    size_t max_queued_bytes = 16 * 1024 * 1024;
+    bool keepalive = true;
+    bool reconnect = true;
+    std::chrono::milliseconds reconnect_delay{1000};
+  };
+
+  struct stats {
+    state_t state = unconnected;
+    size_t queued_bytes = 0;
+    size_t queued_buffers = 0;
+    size_t max_queued_bytes = 0;
+    uint64_t sent_bytes = 0;
+    uint64_t sent_buffers = 0;
+    uint64_t refused_writes = 0;
+    uint32_t connections = 0;
+    std::string last_error;
+  };
+
+ private:
+  const options _options;
+  asio::strand<asio::io_context::executor_type> _strand;
+  asio::ip::tcp::socket _socket;
+  asio::ip::tcp::resolver _resolver;
+  asio::steady_timer _reconnect_timer;
+  std::string _host;
+  std::string _port;
+  /* Incremented by each connect(), handlers of the operations started for a
+   * previous connect() give up. Only used from the strand. */
+  uint32_t _connect_id;
+
+  mutable std::mutex _queue_m;
+  std::condition_variable _queue_cv;
+  std::deque<std::string> _queue;
+  /* Number of buffers at the front of _queue given to the running write. */
+  size_t _writing;
+  bool _closed;
+  stats _stats;
+
+  void _resolve();
+  void _connect(uint32_t connect_id,
+                asio::ip::tcp::resolver::results_type endpoints);
+  void _start_write();
+  void _on_write(const boost::system::error_code& err, size_t len);
+  void _on_error(const boost::system::error_code& err,
+                 const std::string& msg);
+
+ public:
+  async_socket(asio::io_context& io_context, const options& opts);
+  ~async_socket() noexcept = default;
+  async_socket(const async_socket&) = delete;
+  async_socket& operator=(const async_socket&) = delete;
+
+  void connect(const std::string& host, uint16_t port);
+  bool write(std::string&& data);
+  bool flush(std::chrono::milliseconds timeout);
+  void close();
+  bool closed() const;
+  state_t state() const;
+  stats get_stats() const;
+};
+
+/**
+ *  @class broker_async_socket broker_async_socket.hh
+ * "com/centreon/broker/lua/broker_async_socket.hh"
+ *  @brief Class providing asynchronous TCP sockets to the lua interpreter
+ *
+ *  This class provides a binding to Lua to access async_socket objects.
+ */
+class broker_async_socket {
+ public:
+  static void broker_async_socket_reg(lua_State* L);
+};
+
+}  // namespace com::centreon::broker::lua
+
+#endif  // !CCB_LUA_BROKER_ASYNC_SOCKET_HH
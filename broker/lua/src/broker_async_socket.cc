@@ -0,0 +1,566 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/lua/broker_async_socket.hh"
+#include <fmt/format.h>
+
+#include "com/centreon/common/pool.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::lua;
+
+/* Maximum number of queued buffers given to one write operation. */
+static constexpr size_t max_buffers_per_write = 64;
+
+/* Default timeout of the flush() Lua method, in seconds. */
+static constexpr double default_flush_timeout = 10;
+
+static const char* const state_names[] = {
+    "unconnected", "hostLookup", "connecting", "connected", "closing",
+};
+
+/**
+ * @brief Constructor. The socket is not connected, connect() must be called.
+ *
+ * @param io_context The io_context running the socket operations.
+ * @param opts The socket options.
+ */
+async_socket::async_socket(asio::io_context& io_context, const options& opts)
+    : _options{opts},
+      _strand{asio::make_strand(io_context)},
+      _socket{_strand},
+      _resolver{_strand},
+      _reconnect_timer{_strand},
+      _connect_id{0},
+      _writing{0},
+      _closed{false} {
+  _stats.max_queued_bytes = opts.max_queued_bytes;
+}
+
+/**
+ * @brief Start the connection to host:port. This method returns immediately,
+ * the connection is established in background. A lookup or a connection
+ * started by a previous call is cancelled.
+ *
+ * @param host The host name or address.
+ * @param port The port.
+ */
+void async_socket::connect(const std::string& host, uint16_t port) {
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    _closed = false;
+    _stats.state = hostLookup;
+  }
+  asio::post(_strand, [me = shared_from_this(), host, port] {
+    me->_host = host;
+    me->_port = std::to_string(port);
+    ++me->_connect_id;
+    me->_reconnect_timer.cancel();
+    me->_resolver.cancel();
+    boost::system::error_code ec;
+    me->_socket.close(ec);
+    me->_resolve();
+  });
+}
+
+/**
+ * @brief Resolve the address given to connect() and then connect to it. Must
+ * be called from the strand.
+ */
+void async_socket::_resolve() {
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    if (_closed)
+      return;
+    _stats.state = hostLookup;
+  }
+  _resolver.async_resolve(
+      _host, _port,
+      [me = shared_from_this(), connect_id = _connect_id](
+          const boost::system::error_code& err,
+          asio::ip::tcp::resolver::results_type endpoints) {
+        if (connect_id != me->_connect_id)
+          return;
+        if (err)
+          me->_on_error(err, fmt::format("Couldn't resolve {}:{}: {}",
+                                         me->_host, me->_port, err.message()));
+        else
+          me->_connect(connect_id, std::move(endpoints));
+      });
+}
+
+/**
+ * @brief Connect to the first available endpoint. Must be called from the
+ * strand.
+ *
+ * @param connect_id The _connect_id of the connect() call resolved.
+ * @param endpoints The resolved endpoints, there can be several of them, for
+ * example an ipv4 and an ipv6 one.
+ */
+void async_socket::_connect(uint32_t connect_id,
+                            asio::ip::tcp::resolver::results_type endpoints) {
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    if (_closed)
+      return;
+    _stats.state = connecting;
+  }
+  asio::async_connect(
+      _socket, endpoints,
+      [me = shared_from_this(), connect_id](
+          const boost::system::error_code& err,
+          const asio::ip::tcp::endpoint&) {
+        if (connect_id != me->_connect_id)
+          return;
+        if (err) {
+          me->_on_error(err, fmt::format("Couldn't connect to {}:{}: {}",
+                                         me->_host, me->_port, err.message()));
+          return;
+        }
+        boost::system::error_code ec;
+        me->_socket.set_option(asio::ip::tcp::no_delay(true), ec);
+        if (me->_options.keepalive)
+          me->_socket.set_option(asio::socket_base::keep_alive(true), ec);
+        {
+          std::lock_guard<std::mutex> lck(me->_queue_m);
+          if (me->_closed)
+            return;
+          me->_stats.state = connected;
+          ++me->_stats.connections;
+        }
+        me->_start_write();
+      });
+}
+
+/**
+ * @brief Send the buffers at the front of the queue if the socket is
+ * connected and no write is running. Several buffers are sent by the same
+ * operation. Must be called from the strand.
+ */
+void async_socket::_start_write() {
+  std::vector<asio::const_buffer> buffers;
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    if (_writing || _queue.empty() || _stats.state != connected)
+      return;
+    size_t count = std::min(_queue.size(), max_buffers_per_write);
+    buffers.reserve(count);
+    /* std::deque::push_back() does not move its elements, so these buffers
+     * stay valid while other data are queued. */
+    for (size_t i = 0; i < count; ++i)
+      buffers.emplace_back(asio::buffer(_queue[i]));
+    _writing = count;
+  }
+  asio::async_write(_socket, buffers,
+                    [me = shared_from_this()](
+                        const boost::system::error_code& err, size_t len) {
+                      me->_on_write(err, len);
+                    });
+}
+
+/**
+ * @brief Handler called at the end of a write operation. Sent buffers are
+ * removed from the queue. On error, only the data really sent are removed,
+ * the remaining ones will be sent after reconnection.
+ *
+ * @param err The error code.
+ * @param len The number of bytes written.
+ */
+void async_socket::_on_write(const boost::system::error_code& err,
+                             size_t len) {
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    _stats.sent_bytes += len;
+    if (_closed) {
+      _queue.clear();
+      _stats.queued_bytes = 0;
+    } else {
+      size_t remaining = len;
+      for (; _writing > 0 && remaining >= _queue.front().size(); --_writing) {
+        remaining -= _queue.front().size();
+        _stats.queued_bytes -= _queue.front().size();
+        _queue.pop_front();
+        ++_stats.sent_buffers;
+      }
+      if (remaining) {
+        _queue.front().erase(0, remaining);
+        _stats.queued_bytes -= remaining;
+      }
+    }
+    _writing = 0;
+    _stats.queued_buffers = _queue.size();
+  }
+  _queue_cv.notify_all();
+  if (err)
+    _on_error(err, fmt::format("Couldn't write to {}:{}: {}", _host, _port,
+                               err.message()));
+  else
+    _start_write();
+}
+
+/**
+ * @brief Handle a resolution, connection or write error: the socket is
+ * closed and, if enabled, a reconnection is scheduled. Must be called from
+ * the strand.
+ *
+ * @param err The error code. operation_aborted means the operation was
+ * cancelled by close(), there is then nothing to do.
+ * @param msg The error message, also available in the socket statistics.
+ */
+void async_socket::_on_error(const boost::system::error_code& err,
+                             const std::string& msg) {
+  if (err == asio::error::operation_aborted)
+    return;
+  boost::system::error_code ec;
+  _socket.close(ec);
+  bool reconnect;
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    _stats.state = unconnected;
+    if (_closed)
+      return;
+    _stats.last_error = msg;
+    reconnect = _options.reconnect;
+  }
+  _queue_cv.notify_all();
+  if (reconnect) {
+    _reconnect_timer.expires_after(_options.reconnect_delay);
+    _reconnect_timer.async_wait(
+        [me = shared_from_this(),
+         connect_id = _connect_id](const boost::system::error_code& err) {
+          if (!err && connect_id == me->_connect_id)
+            me->_resolve();
+        });
+  }
+}
+
+/**
+ * @brief Queue data to send. This method never blocks.
+ *
+ * @param data The data to send.
+ *
+ * @return true if the data are queued, false if the socket is closed or if
+ * the queue is full, the caller should then retry later. An empty queue
+ * always accepts data.
+ */
+bool async_socket::write(std::string&& data) {
+  bool start;
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    if (_closed)
+      return false;
+    if (!_queue.empty() &&
+        _stats.queued_bytes + data.size() > _options.max_queued_bytes) {
+      ++_stats.refused_writes;
+      return false;
+    }
+    _stats.queued_bytes += data.size();
+    _queue.emplace_back(std::move(data));
+    _stats.queued_buffers = _queue.size();
+    start = !_writing && _stats.state == connected;
+  }
+  if (start)
+    asio::post(_strand, [me = shared_from_this()] { me->_start_write(); });
+  return true;
+}
+
+/**
+ * @brief Wait for the queue to be sent.
+ *
+ * @param timeout The maximum duration to wait.
+ *
+ * @return true if the queue is empty.
+ */
+bool async_socket::flush(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lck(_queue_m);
+  return _queue_cv.wait_for(lck, timeout,
+                            [this] { return _queue.empty() || _closed; }) &&
+         _queue.empty();
+}
+
+/**
+ * @brief Close the socket. Data still in the queue are dropped, flush() should
+ * be called before if they matter.
+ */
+void async_socket::close() {
+  {
+    std::lock_guard<std::mutex> lck(_queue_m);
+    _closed = true;
+    _stats.state = closing;
+    /* Buffers given to a running write are released by _on_write(). */
+    for (auto it = _queue.begin() + _writing; it != _queue.end(); ++it)
+      _stats.queued_bytes -= it->size();
+    _queue.erase(_queue.begin() + _writing, _queue.end());
+    _stats.queued_buffers = _queue.size();
+  }
+  _queue_cv.notify_all();
+  asio::post(_strand, [me = shared_from_this()] {
+    me->_reconnect_timer.cancel();
+    me->_resolver.cancel();
+    boost::system::error_code ec;
+    me->_socket.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+    me->_socket.close(ec);
+    std::lock_guard<std::mutex> lck(me->_queue_m);
+    if (me->_closed)
+      me->_stats.state = unconnected;
+  });
+}
+
+/**
+ * @brief Tell if close() has been called since the last connect().
+ *
+ * @return true if the socket is closed.
+ */
+bool async_socket::closed() const {
+  std::lock_guard<std::mutex> lck(_queue_m);
+  return _closed;
+}
+
+/**
+ * @brief Accessor to the socket state.
+ *
+ * @return The current state.
+ */
+async_socket::state_t async_socket::state() const {
+  std::lock_guard<std::mutex> lck(_queue_m);
+  return _stats.state;
+}
+
+/**
+ * @brief Accessor to the socket statistics.
+ *
+ * @return A copy of the statistics.
+ */
+async_socket::stats async_socket::get_stats() const {
+  std::lock_guard<std::mutex> lck(_queue_m);
+  return _stats;
+}
+
+/**
+ *  Get the async_socket stored in the Lua userdata at index 1.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return The socket.
+ */
+static std::shared_ptr<async_socket>& check_socket(lua_State* L) {
+  return *static_cast<std::shared_ptr<async_socket>*>(
+      luaL_checkudata(L, 1, "lua_broker_async_tcp_socket"));
+}
+
+/**
+ *  The Lua broker_async_tcp_socket constructor. It accepts an optional table
+ *  of options: max_queued_bytes, keepalive, reconnect and reconnect_delay (in
+ *  seconds).
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1
+ */
+static int l_broker_async_socket_constructor(lua_State* L) {
+  async_socket::options opts;
+  if (lua_istable(L, 1)) {
+    lua_getfield(L, 1, "max_queued_bytes");
+    if (lua_isnumber(L, -1))
+      opts.max_queued_bytes = lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    lua_getfield(L, 1, "keepalive");
+    if (lua_isboolean(L, -1))
+      opts.keepalive = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+    lua_getfield(L, 1, "reconnect");
+    if (lua_isboolean(L, -1))
+      opts.reconnect = lua_toboolean(L, -1);
+    lua_pop(L, 1);
+    lua_getfield(L, 1, "reconnect_delay");
+    if (lua_isnumber(L, -1))
+      opts.reconnect_delay = std::chrono::milliseconds(
+          static_cast<int64_t>(lua_tonumber(L, -1) * 1000));
+    lua_pop(L, 1);
+  }
+
+  void* udata = lua_newuserdata(L, sizeof(std::shared_ptr<async_socket>));
+  new (udata) std::shared_ptr<async_socket>(std::make_shared<async_socket>(
+      com::centreon::common::pool::io_context(), opts));
+
+  luaL_getmetatable(L, "lua_broker_async_tcp_socket");
+  lua_setmetatable(L, -2);
+
+  return 1;
+}
+
+/**
+ *  The Lua broker_async_tcp_socket destructor. The connection is closed, the
+ *  object is really destroyed when its pending operations are over.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 0
+ */
+static int l_broker_async_socket_destructor(lua_State* L) {
+  auto& socket = check_socket(L);
+  if (socket)
+    socket->close();
+  socket.~shared_ptr<async_socket>();
+  return 0;
+}
+
+/**
+ *  The Lua broker_async_tcp_socket connect method. It returns immediately,
+ *  the connection is established in background.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 0
+ */
+static int l_broker_async_socket_connect(lua_State* L) {
+  auto& socket = check_socket(L);
+  char const* addr{luaL_checkstring(L, 2)};
+  int port{static_cast<int>(luaL_checknumber(L, 3))};
+  if (port <= 0 || port > 65535)
+    luaL_error(L, "broker_async_tcp_socket::connect: invalid port %d", port);
+  socket->connect(addr, port);
+  return 0;
+}
+
+/**
+ *  The Lua broker_async_tcp_socket write method. The data are queued, true is
+ *  returned on success and false if the queue is full. Writing on a closed
+ *  socket is an error.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1
+ */
+static int l_broker_async_socket_write(lua_State* L) {
+  auto& socket = check_socket(L);
+  size_t len;
+  char const* content = luaL_checklstring(L, 2, &len);
+  if (socket->closed())
+    luaL_error(L, "broker_async_tcp_socket::write: the socket is closed");
+  lua_pushboolean(L, socket->write(std::string(content, len)));
+  return 1;
+}
+
+/**
+ *  The Lua broker_async_tcp_socket flush method. It waits for the queue to be
+ *  sent, at most the number of seconds given as argument (10 by default).
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1, true if the queue is empty.
+ */
+static int l_broker_async_socket_flush(lua_State* L) {
+  auto& socket = check_socket(L);
+  double timeout = luaL_optnumber(L, 2, default_flush_timeout);
+  lua_pushboolean(
+      L, socket->flush(std::chrono::milliseconds(
+             static_cast<int64_t>(timeout * 1000))));
+  return 1;
+}
+
+/**
+ *  The Lua broker_async_tcp_socket state method
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1
+ */
+static int l_broker_async_socket_state(lua_State* L) {
+  auto& socket = check_socket(L);
+  lua_pushstring(L, state_names[socket->state()]);
+  return 1;
+}
+
+/**
+ *  The Lua broker_async_tcp_socket get_stats method. It returns a table
+ *  with the state, the queue size and the number of sent bytes.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1
+ */
+static int l_broker_async_socket_stats(lua_State* L) {
+  auto& socket = check_socket(L);
+  async_socket::stats s = socket->get_stats();
+  lua_createtable(L, 0, 9);
+  lua_pushstring(L, state_names[s.state]);
+  lua_setfield(L, -2, "state");
+  lua_pushinteger(L, s.queued_bytes);
+  lua_setfield(L, -2, "queued_bytes");
+  lua_pushinteger(L, s.queued_buffers);
+  lua_setfield(L, -2, "queued_buffers");
+  lua_pushinteger(L, s.max_queued_bytes);
+  lua_setfield(L, -2, "max_queued_bytes");
+  lua_pushinteger(L, s.sent_bytes);
+  lua_setfield(L, -2, "sent_bytes");
+  lua_pushinteger(L, s.sent_buffers);
+  lua_setfield(L, -2, "sent_buffers");
+  lua_pushinteger(L, s.refused_writes);
+  lua_setfield(L, -2, "refused_writes");
+  lua_pushinteger(L, s.connections);
+  lua_setfield(L, -2, "connections");
+  lua_pushlstring(L, s.last_error.data(), s.last_error.size());
+  lua_setfield(L, -2, "last_error");
+  return 1;
+}
+
+/**
+ *  The Lua broker_async_tcp_socket close method
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 0
+ */
+static int l_broker_async_socket_close(lua_State* L) {
+  auto& socket = check_socket(L);
+  socket->close();
+  return 0;
+}
+
+/**
+ *  Register the broker_async_tcp_socket class in the Lua interpreter.
+ *
+ *  @param L The Lua interpreter
+ */
+void broker_async_socket::broker_async_socket_reg(lua_State* L) {
+  luaL_Reg s_broker_async_socket_regs[] = {
+      {"new", l_broker_async_socket_constructor},
+      {"__gc", l_broker_async_socket_destructor},
+      {"connect", l_broker_async_socket_connect},
+      {"get_state", l_broker_async_socket_state},
+      {"get_stats", l_broker_async_socket_stats},
+      {"write", l_broker_async_socket_write},
+      {"flush", l_broker_async_socket_flush},
+      {"close", l_broker_async_socket_close},
+      {nullptr, nullptr}};
+
+  luaL_newmetatable(L, "lua_broker_async_tcp_socket");
+
+#ifdef LUA51
+  luaL_register(L, NULL, s_broker_async_socket_regs);
+#else
+  luaL_setfuncs(L, s_broker_async_socket_regs, 0);
+#endif
+
+  // Set the __index field of the metatable to point to itself
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -1, "__index");
+
+  lua_setglobal(L, "broker_async_tcp_socket");
+}
@@ -50,16 +50,46 @@ using namespace com::centreon::exceptions;
 using namespace nlohmann;
 using com::centreon::common::log_v2::log_v2;
 
-static void broker_json_encode(lua_State* L, std::ostringstream& oss);
+static void broker_json_encode(lua_State* L, std::string& buf);
 static void broker_json_decode(lua_State* L, const json& it);
 
+/* Above this capacity, the json_encode buffer is released after use so that
+ * an exceptional big event does not keep its memory forever. */
+static constexpr size_t json_buffer_max_capacity = 4 * 1024 * 1024;
+
+/**
+ * @brief Return the buffer used by json_encode() on this thread. It is reused
+ * from one call to the other to avoid allocations on each event.
+ *
+ * @return An empty string with some capacity.
+ */
+static std::string& json_buffer() {
+  thread_local std::string buf;
+  buf.clear();
+  if (buf.capacity() > json_buffer_max_capacity)
+    buf.shrink_to_fit();
+  if (buf.capacity() < 4096)
+    buf.reserve(4096);
+  return buf;
+}
+
+/**
+ * @brief Append to buf a value formatted with fmt.
+ */
+template <typename... Args>
+static inline void append_fmt(std::string& buf,
+                              fmt::format_string<Args...> f,
+                              Args&&... args) {
+  fmt::format_to(std::back_inserter(buf), f, std::forward<Args>(args)...);
+}
+
 /**
  *  The json_encode function for Lua tables
  *
  *  @param L The Lua interpreter
- *  @param oss The output stream
+ *  @param buf The output buffer
  */
-static void broker_json_encode_table(lua_State* L, std::ostringstream& oss) {
+static void broker_json_encode_table(lua_State* L, std::string& buf) {
   bool array(false);
   /* We must parse the table from the first key */
   lua_pushnil(L); /* this tells lua_next to start from the first key */
@@ -72,8 +102,8 @@ static void broker_json_encode_table(lua_State* L, std::ostringstream& oss) {
       int index(lua_tointeger(L, -2));
       if (index == 1) {
         array = true;
-        oss << '[';
-        broker_json_encode(L, oss);
+        buf.push_back('[');
+        broker_json_encode(L, buf);
         lua_pop(L, 1);
         while (lua_next(L, -2)) {
 #if LUA53
@@ -81,67 +111,245 @@ static void broker_json_encode_table(lua_State* L, std::ostringstream& oss) {
 #else
           if (lua_isnumber(L, -2)) {
 #endif
-            oss << ',';
-            broker_json_encode(L, oss);
+            buf.push_back(',');
+            broker_json_encode(L, buf);
           }
           lua_pop(L, 1);
         }
-        oss << ']';
+        buf.push_back(']');
       }
     }
   } else {
     /* There are no key, the table is empty */
-    oss << "[]";
+    buf.append("[]", 2);
     return;
   }
 
   if (!array) {
-    oss << "{\"" << lua_tostring(L, -2) << "\":";
-    broker_json_encode(L, oss);
+    buf.append("{\"", 2);
+    buf.append(lua_tostring(L, -2));
+    buf.append("\":", 2);
+    broker_json_encode(L, buf);
     lua_pop(L, 1);
     while (lua_next(L, -2)) {
-      oss << ",\"" << lua_tostring(L, -2) << "\":";
-      broker_json_encode(L, oss);
+      buf.append(",\"", 2);
+      buf.append(lua_tostring(L, -2));
+      buf.append("\":", 2);
+      broker_json_encode(L, buf);
       lua_pop(L, 1);
     }
-    oss << '}';
+    buf.push_back('}');
   }
 }
 
-static void escape_str(const char* content, std::ostringstream& oss) {
-  /* If the string contains '"', we must escape it */
-  size_t pos(strcspn(content, "\\\"\t\r\n"));
-  if (content[pos] != 0) {
-    std::string str(content);
-    char replacement[3] = "\\\\";
-    do {
-      switch (str[pos]) {
-        case '\\':
-          replacement[1] = '\\';
-          break;
-        case '"':
-          replacement[1] = '"';
-          break;
-        case '\t':
-          replacement[1] = 't';
-          break;
-        case '\r':
-          replacement[1] = 'r';
-          break;
-        case '\n':
-          replacement[1] = 'n';
-          break;
+/**
+ * @brief Tell if one of the eight bytes of w must be escaped in a json string,
+ * that is if it is a control character, a double quote or a backslash. The
+ * test is done on the whole word at once, it may only give a false positive
+ * in a word that really contains such a byte.
+ *
+ * @param w Eight bytes of the string.
+ *
+ * @return true if one of them needs to be escaped.
+ */
+static inline bool word_needs_escape(uint64_t w) {
+  constexpr uint64_t ones = 0x0101010101010101ull;
+  constexpr uint64_t high = 0x8080808080808080ull;
+  uint64_t quote = w ^ (ones * '"');
+  uint64_t bslash = w ^ (ones * '\\');
+  return (((w - ones * 0x20) & ~w) | ((quote - ones) & ~quote) |
+          ((bslash - ones) & ~bslash)) &
+         high;
+}
+
+/**
+ * @brief Append the json escaped version of the string content to buf. The
+ * string is scanned eight bytes at a time, and runs of characters without
+ * anything to escape are copied at once.
+ *
+ * @param content The string to escape.
+ * @param size Its length.
+ * @param buf The output buffer.
+ */
+static void escape_str(const char* content, size_t size, std::string& buf) {
+  static const char hex[] = "0123456789abcdef";
+  const char* end = content + size;
+  const char* run = content;
+  const char* p = content;
+  while (p < end) {
+    if (end - p >= 8) {
+      uint64_t w;
+      memcpy(&w, p, sizeof(w));
+      if (!word_needs_escape(w)) {
+        p += 8;
+        continue;
       }
-      str.replace(pos, 1, replacement);
-      pos += 2;
-    } while ((pos = str.find_first_of("\\\"\t\r\n", pos)) != std::string::npos);
-    oss << str;
-  } else
-    oss << content;
+    }
+    unsigned char c = *p;
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      ++p;
+      continue;
+    }
+    buf.append(run, p - run);
+    switch (c) {
+      case '"':
+        buf.append("\\\"", 2);
+        break;
+      case '\\':
+        buf.append("\\\\", 2);
+        break;
+      case '\t':
+        buf.append("\\t", 2);
+        break;
+      case '\r':
+        buf.append("\\r", 2);
+        break;
+      case '\n':
+        buf.append("\\n", 2);
+        break;
+      case '\b':
+        buf.append("\\b", 2);
+        break;
+      case '\f':
+        buf.append("\\f", 2);
+        break;
+      default: {
+        char u[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+        buf.append(u, sizeof(u));
+      }
+    }
+    run = ++p;
+  }
+  buf.append(run, end - run);
+}
+
+static inline void escape_str(const std::string& content, std::string& buf) {
+  escape_str(content.data(), content.size(), buf);
+}
+
+/**
+ * @brief Append a json key followed by ':' to buf, preceded by the separator
+ * if it is not the first key of the object.
+ *
+ * @param name The key.
+ * @param first true for the first key of the object, it is set to false.
+ * @param buf The output buffer.
+ */
+static inline void append_key(const std::string& name,
+                              bool& first,
+                              std::string& buf) {
+  if (first)
+    first = false;
+  else
+    buf.append(", ", 2);
+  buf.push_back('"');
+  buf.append(name);
+  buf.append("\":", 2);
+}
+
+static void _message_to_json(std::string& buf,
+                             const google::protobuf::Message* p,
+                             bool first = true);
+
+/**
+ * @brief Append to buf one value of a field of a protobuf message. If
+ * index is not negative, the field is repeated and index is the index of the
+ * value to append.
+ *
+ * @param buf The output buffer.
+ * @param p The message.
+ * @param f The field descriptor.
+ * @param index The index of the value if the field is repeated, -1 otherwise.
+ * @param tmpl A scratch string.
+ */
+static void _field_to_json(std::string& buf,
+                           const google::protobuf::Message* p,
+                           const google::protobuf::FieldDescriptor* f,
+                           int index,
+                           std::string& tmpl) {
+  const google::protobuf::Reflection* refl = p->GetReflection();
+  const bool rep = index >= 0;
+  switch (f->cpp_type()) {
+    case google::protobuf::FieldDescriptor::CPPTYPE_BOOL:
+      if (rep ? refl->GetRepeatedBool(*p, f, index) : refl->GetBool(*p, f))
+        buf.append("true", 4);
+      else
+        buf.append("false", 5);
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_DOUBLE:
+      /* Repeated doubles keep the six significant digits of an ostream,
+       * single ones the shortest exact form of fmt. */
+      if (rep)
+        append_fmt(buf, "{:g}", refl->GetRepeatedDouble(*p, f, index));
+      else
+        append_fmt(buf, "{}", refl->GetDouble(*p, f));
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_FLOAT:
+      append_fmt(buf, "{}",
+                 rep ? refl->GetRepeatedFloat(*p, f, index)
+                     : refl->GetFloat(*p, f));
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+      append_fmt(buf, "{}",
+                 rep ? refl->GetRepeatedInt32(*p, f, index)
+                     : refl->GetInt32(*p, f));
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+      append_fmt(buf, "{}",
+                 rep ? refl->GetRepeatedUInt32(*p, f, index)
+                     : refl->GetUInt32(*p, f));
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+      append_fmt(buf, "{}",
+                 rep ? refl->GetRepeatedInt64(*p, f, index)
+                     : refl->GetInt64(*p, f));
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+      append_fmt(buf, "{}",
+                 rep ? refl->GetRepeatedUInt64(*p, f, index)
+                     : refl->GetUInt64(*p, f));
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+      append_fmt(buf, "{}",
+                 rep ? refl->GetRepeatedEnumValue(*p, f, index)
+                     : refl->GetEnumValue(*p, f));
+      break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_STRING: {
+      const std::string& s =
+          rep ? refl->GetRepeatedStringReference(*p, f, index, &tmpl)
+              : refl->GetStringReference(*p, f, &tmpl);
+      buf.push_back('"');
+      if (f->type() == google::protobuf::FieldDescriptor::TYPE_BYTES)
+        buf.append(com::centreon::common::hex_dump(s, 0));
+      else
+        escape_str(s, buf);
+      buf.push_back('"');
+    } break;
+    case google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE:
+      buf.push_back('{');
+      _message_to_json(buf, rep ? &refl->GetRepeatedMessage(*p, f, index)
+                                : &refl->GetMessage(*p, f));
+      buf.push_back('}');
+      break;
+    default:  // Error, a type not handled
+      throw msg_fmt(
+          "protobuf {} type ID is not handled in the broker json converter",
+          static_cast<uint32_t>(f->type()));
+  }
 }
 
-static void _message_to_json(std::ostringstream& oss,
-                             const google::protobuf::Message* p) {
+/**
+ * @brief Append to buf the fields of the protobuf message p, walking directly
+ * its descriptor. The enclosing braces are not written.
+ *
+ * @param buf The output buffer.
+ * @param p The message to encode.
+ * @param first false if fields have already been written in the current
+ * object, a separator is then written before the first field of p.
+ */
+static void _message_to_json(std::string& buf,
+                             const google::protobuf::Message* p,
+                             bool first) {
   std::string tmpl;
   const google::protobuf::Descriptor* desc = p->GetDescriptor();
   const google::protobuf::Reflection* refl = p->GetReflection();
@@ -153,171 +361,40 @@ static void _message_to_json(std::ostringstream& oss,
         continue;
       }
     }
-    const std::string& entry_name = f->name();
+    append_key(f->name(), first, buf);
     if (f->is_repeated()) {
-      size_t s = refl->FieldSize(*p, f);
-      if (i > 0)
-        oss << ", ";
-      switch (f->type()) {
-        case google::protobuf::FieldDescriptor::TYPE_BOOL:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << refl->GetRepeatedBool(*p, f, j);
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << refl->GetRepeatedDouble(*p, f, j);
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_INT32:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << refl->GetRepeatedInt32(*p, f, j);
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_UINT32:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << refl->GetRepeatedUInt32(*p, f, j);
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_SFIXED64:
-        case google::protobuf::FieldDescriptor::TYPE_INT64:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << refl->GetRepeatedInt64(*p, f, j);
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_FIXED64:
-        case google::protobuf::FieldDescriptor::TYPE_UINT64:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << refl->GetRepeatedUInt64(*p, f, j);
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_ENUM:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << refl->GetRepeatedEnumValue(*p, f, j);
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_STRING:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ",";
-            oss << "\"" << refl->GetRepeatedStringReference(*p, f, j, &tmpl)
-                << "\"";
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_MESSAGE:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t i = 0; i < s; i++) {
-            if (i > 0)
-              oss << ", ";
-            oss << '{';
-            _message_to_json(oss, &refl->GetRepeatedMessage(*p, f, i));
-            oss << '}';
-          }
-          oss << ']';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_BYTES:
-          oss << fmt::format("\"{}\":[", entry_name);
-          for (size_t j = 0; j < s; j++) {
-            if (j > 0)
-              oss << ',';
-            tmpl = refl->GetRepeatedStringReference(*p, f, j, &tmpl);
-            oss << '"' << com::centreon::common::hex_dump(tmpl, 0) << '"';
-          }
-          oss << ']';
-          break;
-        default:  // Error, a type not handled
-          throw msg_fmt(
-              "protobuf {} type ID is not handled in the broker json converter",
-              static_cast<uint32_t>(f->type()));
+      int s = refl->FieldSize(*p, f);
+      const char* sep =
+          f->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE
+              ? ", "
+              : ",";
+      buf.push_back('[');
+      for (int j = 0; j < s; j++) {
+        if (j > 0)
+          buf.append(sep);
+        _field_to_json(buf, p, f, j, tmpl);
       }
-    } else {
-      if (i > 0)
-        oss << ", ";
-      switch (f->type()) {
-        case google::protobuf::FieldDescriptor::TYPE_BOOL:
-          oss << fmt::format("\"{}\":{}", entry_name, refl->GetBool(*p, f));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_DOUBLE:
-          oss << fmt::format("\"{}\":{}", entry_name, refl->GetDouble(*p, f));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_INT32:
-          oss << fmt::format("\"{}\":{}", entry_name, refl->GetInt32(*p, f));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_UINT32:
-          oss << fmt::format("\"{}\":{}", entry_name, refl->GetUInt32(*p, f));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_SFIXED64:
-        case google::protobuf::FieldDescriptor::TYPE_INT64:
-          oss << fmt::format("\"{}\":{}", entry_name, refl->GetInt64(*p, f));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_FIXED64:
-        case google::protobuf::FieldDescriptor::TYPE_UINT64:
-          oss << fmt::format("\"{}\":{}", entry_name, refl->GetUInt64(*p, f));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_ENUM:
-          oss << fmt::format("\"{}\":{}", entry_name,
-                             refl->GetEnumValue(*p, f));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_STRING:
-          oss << fmt::format("\"{}\":\"{}\"", entry_name,
-                             refl->GetStringReference(*p, f, &tmpl));
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_MESSAGE:
-          oss << fmt::format("\"{}\":{{", entry_name);
-          _message_to_json(oss, &refl->GetMessage(*p, f));
-          oss << '}';
-          break;
-        case google::protobuf::FieldDescriptor::TYPE_BYTES:
-          tmpl = refl->GetStringReference(*p, f, &tmpl);
-          oss << fmt::format(R"("{}":"{}")", entry_name,
-                             com::centreon::common::hex_dump(tmpl, 0));
-          break;
-        default:  // Error, a type not handled
-          throw msg_fmt(
-              "protobuf {} type ID is not handled in the broker json converter",
-              static_cast<uint32_t>(f->type()));
-      }
-    }
+      buf.push_back(']');
+    } else
+      _field_to_json(buf, p, f, -1, tmpl);
   }
 }
 
-static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
-                                            std::ostringstream& oss) {
+/**
+ * @brief Append to buf the json representation of a broker event. Events
+ * with a mapping are written from it, protobuf events are written directly
+ * from their descriptor.
+ *
+ * @param e The event to encode.
+ * @param buf The output buffer.
+ */
+static void broker_json_encode_broker_event(const std::shared_ptr<io::data>& e,
+                                            std::string& buf) {
   io::event_info const* info = io::events::instance().get_event_info(e->type());
   if (info) {
-    oss << fmt::format("{{\"_type\":{}, \"category\":{}, \"element\":{}",
-                       e->type(), static_cast<uint32_t>(e->type()) >> 16,
-                       static_cast<uint32_t>(e->type()) & 0xffff);
+    append_fmt(buf, "{{\"_type\":{}, \"category\":{}, \"element\":{}",
+               e->type(), static_cast<uint32_t>(e->type()) >> 16,
+               static_cast<uint32_t>(e->type()) & 0xffff);
     if (info->get_mapping()) {
       for (const mapping::entry* current_entry = info->get_mapping();
            !current_entry->is_null(); ++current_entry) {
@@ -325,47 +402,47 @@ static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
         if (entry_name && *entry_name) {
           switch (current_entry->get_type()) {
             case mapping::source::BOOL:
-              oss << fmt::format(", \"{}\":{}", entry_name,
-                                 current_entry->get_bool(*e));
+              append_fmt(buf, ", \"{}\":{}", entry_name,
+                         current_entry->get_bool(*e));
               break;
             case mapping::source::DOUBLE:
-              oss << fmt::format(", \"{}\":{}", entry_name,
-                                 current_entry->get_double(*e));
+              append_fmt(buf, ", \"{}\":{}", entry_name,
+                         current_entry->get_double(*e));
               break;
             case mapping::source::INT:
               switch (current_entry->get_attribute()) {
                 case mapping::entry::invalid_on_zero: {
                   int val(current_entry->get_int(*e));
                   if (val != 0)
-                    oss << fmt::format(", \"{}\":{}", entry_name, val);
+                    append_fmt(buf, ", \"{}\":{}", entry_name, val);
                 } break;
                 case mapping::entry::invalid_on_minus_one: {
                   int val(current_entry->get_int(*e));
                   if (val != -1)
-                    oss << fmt::format(", \"{}\":{}", entry_name, val);
+                    append_fmt(buf, ", \"{}\":{}", entry_name, val);
                 } break;
                 default:
-                  oss << fmt::format(", \"{}\":{}", entry_name,
-                                     current_entry->get_int(*e));
+                  append_fmt(buf, ", \"{}\":{}", entry_name,
+                             current_entry->get_int(*e));
               }
               break;
             case mapping::source::SHORT:
-              oss << fmt::format(", \"{}\":{}", entry_name,
-                                 current_entry->get_short(*e));
+              append_fmt(buf, ", \"{}\":{}", entry_name,
+                         current_entry->get_short(*e));
               break;
             case mapping::source::STRING:
               if (current_entry->get_attribute() ==
                   mapping::entry::invalid_on_zero) {
-                std::string val{current_entry->get_string(*e)};
+                const std::string& val = current_entry->get_string(*e);
                 if (!val.empty()) {
-                  oss << fmt::format(", \"{}\":\"", entry_name);
-                  escape_str(val.c_str(), oss);
-                  oss << '"';
+                  append_fmt(buf, ", \"{}\":\"", entry_name);
+                  escape_str(val, buf);
+                  buf.push_back('"');
                 }
               } else {
-                oss << fmt::format(", \"{}\":\"", entry_name);
-                escape_str(current_entry->get_string(*e).c_str(), oss);
-                oss << '"';
+                append_fmt(buf, ", \"{}\":\"", entry_name);
+                escape_str(current_entry->get_string(*e), buf);
+                buf.push_back('"');
               }
               break;
             case mapping::source::TIME:
@@ -373,16 +450,16 @@ static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
                 case mapping::entry::invalid_on_zero: {
                   time_t val = current_entry->get_time(*e);
                   if (val != 0)
-                    oss << fmt::format(", \"{}\":\"{}\"", entry_name, val);
+                    append_fmt(buf, ", \"{}\":\"{}\"", entry_name, val);
                 } break;
                 case mapping::entry::invalid_on_minus_one: {
                   time_t val = current_entry->get_time(*e);
                   if (val != -1)
-                    oss << fmt::format(", \"{}\":\"{}\"", entry_name, val);
+                    append_fmt(buf, ", \"{}\":\"{}\"", entry_name, val);
                 } break;
                 default:
-                  oss << fmt::format(", \"{}\":\"{}\"", entry_name,
-                                     current_entry->get_time(*e));
+                  append_fmt(buf, ", \"{}\":\"{}\"", entry_name,
+                             current_entry->get_time(*e));
               }
               break;
             case mapping::source::UINT:
@@ -390,16 +467,16 @@ static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
                 case mapping::entry::invalid_on_zero: {
                   uint32_t val = current_entry->get_uint(*e);
                   if (val != 0)
-                    oss << fmt::format(", \"{}\":{}", entry_name, val);
+                    append_fmt(buf, ", \"{}\":{}", entry_name, val);
                 } break;
                 case mapping::entry::invalid_on_minus_one: {
                   uint32_t val = current_entry->get_uint(*e);
                   if (val != static_cast<uint32_t>(-1))
-                    oss << fmt::format(", \"{}\":{}", entry_name, val);
+                    append_fmt(buf, ", \"{}\":{}", entry_name, val);
                 } break;
                 default:
-                  oss << fmt::format(", \"{}\":{}", entry_name,
-                                     current_entry->get_uint(*e));
+                  append_fmt(buf, ", \"{}\":{}", entry_name,
+                             current_entry->get_uint(*e));
               }
               break;
             case mapping::source::ULONG:
@@ -407,16 +484,16 @@ static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
                 case mapping::entry::invalid_on_zero: {
                   uint64_t val = current_entry->get_ulong(*e);
                   if (val != 0)
-                    oss << fmt::format(", \"{}\":{}", entry_name, val);
+                    append_fmt(buf, ", \"{}\":{}", entry_name, val);
                 } break;
                 case mapping::entry::invalid_on_minus_one: {
                   uint64_t val = current_entry->get_ulong(*e);
                   if (val != static_cast<uint64_t>(-1))
-                    oss << fmt::format(", \"{}\":{}", entry_name, val);
+                    append_fmt(buf, ", \"{}\":{}", entry_name, val);
                 } break;
                 default:
-                  oss << fmt::format(", \"{}\":{}", entry_name,
-                                     current_entry->get_ulong(*e));
+                  append_fmt(buf, ", \"{}\":{}", entry_name,
+                             current_entry->get_ulong(*e));
               }
               break;
 
@@ -430,49 +507,54 @@ static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
         }
       }
     } else {
-      oss << ", ";
       /* Here is the protobuf case: no mapping */
       const google::protobuf::Message* p =
           static_cast<const io::protobuf_base*>(e.get())->msg();
-      _message_to_json(oss, p);
+      _message_to_json(buf, p, false);
     }
   } else
     throw msg_fmt(
         "cannot bind object of type {}"
         " to database query: mapping does not exist",
         e->type());
-  oss << '}';
+  buf.push_back('}');
 }
 
 /**
  *  The json_encode function for Lua objects others than tables
  *
  *  @param L The Lua interpreter
- *  @param oss The output stream
+ *  @param buf The output buffer
  */
-static void broker_json_encode(lua_State* L, std::ostringstream& oss) {
+static void broker_json_encode(lua_State* L, std::string& buf) {
   switch (lua_type(L, -1)) {
-    case LUA_TNUMBER:
-      oss << lua_tostring(L, -1);
-      break;
+    case LUA_TNUMBER: {
+      size_t len;
+      const char* content = lua_tolstring(L, -1, &len);
+      buf.append(content, len);
+    } break;
     case LUA_TSTRING: {
       /* If the string contains '"', we must escape it */
-      const char* content = lua_tostring(L, -1);
-      oss << '"';
-      escape_str(content, oss);
-      oss << '"';
+      size_t len;
+      const char* content = lua_tolstring(L, -1, &len);
+      buf.push_back('"');
+      escape_str(content, len, buf);
+      buf.push_back('"');
     } break;
     case LUA_TBOOLEAN:
-      oss << (lua_toboolean(L, -1) ? "true" : "false");
+      if (lua_toboolean(L, -1))
+        buf.append("true", 4);
+      else
+        buf.append("false", 5);
       break;
     case LUA_TTABLE:
-      broker_json_encode_table(L, oss);
+      broker_json_encode_table(L, buf);
       break;
     case LUA_TUSERDATA: {
-      void* ptr = luaL_checkudata(L, 1, "broker_event");
+      void* ptr = luaL_checkudata(L, -1, "broker_event");
       if (ptr) {
         auto event = static_cast<std::shared_ptr<io::data>*>(ptr);
-        broker_json_encode_broker_event(*event, oss);
+        broker_json_encode_broker_event(*event, buf);
       }
     } break;
     default:
@@ -489,10 +571,9 @@ static void broker_json_encode(lua_State* L, std::ostringstream& oss) {
  */
 static int l_broker_json_encode(lua_State* L) noexcept {
   try {
-    std::ostringstream oss;
-    broker_json_encode(L, oss);
-    std::string s{oss.str()};
-    lua_pushlstring(L, s.c_str(), s.size());
+    std::string& buf = json_buffer();
+    broker_json_encode(L, buf);
+    lua_pushlstring(L, buf.data(), buf.size());
     return 1;
   } catch (const std::exception& e) {
     auto logger = log_v2::instance().get(log_v2::LUA);
@@ -501,6 +582,63 @@ static int l_broker_json_encode(lua_State* L) noexcept {
   return 0;
 }
 
+/**
+ * @brief The Lua json_encode_batch function. It takes an array of events
+ * (broker events or tables) and returns in one call the json array of their
+ * encodings, all written in the same buffer. Elements that cannot be encoded
+ * are skipped with an error in the logs.
+ *
+ * @param L The Lua interpreter
+ *
+ * @return 1
+ */
+static int l_broker_json_encode_batch(lua_State* L) noexcept {
+  luaL_checktype(L, 1, LUA_TTABLE);
+#ifdef LUA51
+  size_t size = lua_objlen(L, 1);
+#else
+  size_t size = lua_rawlen(L, 1);
+#endif
+  /* An element that fails in the middle of a table leaves its keys and values
+   * on the stack, so the stack is restored to this top after each element. */
+  const int top = lua_gettop(L);
+  std::string& buf = json_buffer();
+  buf.push_back('[');
+  bool first = true;
+  for (size_t i = 1; i <= size; ++i) {
+    lua_rawgeti(L, 1, i);
+    switch (lua_type(L, -1)) {
+      case LUA_TNUMBER:
+      case LUA_TSTRING:
+      case LUA_TBOOLEAN:
+      case LUA_TTABLE:
+      case LUA_TUSERDATA:
+        break;
+      default:
+        lua_settop(L, top);
+        return luaL_error(
+            L, "json_encode_batch: element %d: type not implemented",
+            static_cast<int>(i));
+    }
+    size_t mark = buf.size();
+    if (!first)
+      buf.push_back(',');
+    try {
+      broker_json_encode(L, buf);
+      first = false;
+    } catch (const std::exception& e) {
+      buf.resize(mark);
+      auto logger = log_v2::instance().get(log_v2::LUA);
+      logger->error("lua: json_encode_batch cannot encode element {}: {}", i,
+                    e.what());
+    }
+    lua_settop(L, top);
+  }
+  buf.push_back(']');
+  lua_pushlstring(L, buf.data(), buf.size());
+  return 1;
+}
+
 /**
  *  The Lua json_decode function for arrays.
  *
@@ -886,6 +1024,7 @@ static int l_broker_bbdo_version(lua_State* L) {
  */
 void broker_utils::broker_utils_reg(lua_State* L) {
   luaL_Reg s_broker_regs[] = {{"json_encode", l_broker_json_encode},
+                              {"json_encode_batch", l_broker_json_encode_batch},
                               {"json_decode", l_broker_json_decode},
                               {"parse_perfdata", l_broker_parse_perfdata},
                               {"url_encode", l_broker_url_encode},
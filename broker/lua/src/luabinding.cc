@@ -20,6 +20,7 @@
 
 #include <cassert>
 
+#include "com/centreon/broker/lua/broker_async_socket.hh"
 #include "com/centreon/broker/lua/broker_cache.hh"
 #include "com/centreon/broker/lua/broker_event.hh"
 #include "com/centreon/broker/lua/broker_log.hh"
@@ -261,6 +262,9 @@ void luabinding::_load_script(const std::string& lua_script) {
   // Registers the broker socket object
   broker_socket::broker_socket_reg(_L);
 
+  // Registers the broker asynchronous socket object
+  broker_async_socket::broker_async_socket_reg(_L);
+
   // Registers the broker utils
   broker_utils::broker_utils_reg(_L);
 
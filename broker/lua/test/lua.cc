@@ -406,6 +406,147 @@ TEST_F(LuaAsioTest, SocketWrite) {
   RemoveFile("/tmp/log");
 }
 
+// When a script writes on an asynchronous socket connected to the test server
+// And flushes it
+// Then all the data are sent and the stats show them.
+TEST_F(LuaAsioTest, AsyncSocketWrite) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/socket.lua");
+
+  ASSERT_TRUE(_server.get_bind_ok());
+
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/log')\n"
+               "  local socket = broker_async_tcp_socket.new()\n"
+               "  socket:connect('127.0.0.1', 4242)\n"
+               "  for i = 1, 3 do\n"
+               "    broker_log:info(1, 'queued: ' .. "
+               "tostring(socket:write('message ' .. i .. '\\n')))\n"
+               "  end\n"
+               "  broker_log:info(1, 'flushed: ' .. "
+               "tostring(socket:flush(5)))\n"
+               "  local stats = socket:get_stats()\n"
+               "  broker_log:info(1, 'State: ' .. stats.state)\n"
+               "  broker_log:info(1, 'sent_bytes: ' .. stats.sent_bytes)\n"
+               "  broker_log:info(1, 'queued_bytes: ' .. stats.queued_bytes)\n"
+               "  socket:close()\n"
+               "end\n\n"
+               "function write(d)\n"
+               "end\n\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  std::string lst(ReadFile("/tmp/log"));
+
+  ASSERT_EQ(lst.find("queued: false"), std::string::npos);
+  ASSERT_NE(lst.find("flushed: true"), std::string::npos);
+  ASSERT_NE(lst.find("State: connected"), std::string::npos);
+  ASSERT_NE(lst.find("sent_bytes: 30"), std::string::npos);
+  ASSERT_NE(lst.find("queued_bytes: 0"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/log");
+}
+
+// When a script connects an asynchronous socket to a bad address
+// And connects it again to the test server before the first connection ends
+// Then the first connection is given up and the data go to the test server.
+TEST_F(LuaAsioTest, AsyncSocketConnectTwice) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/socket.lua");
+
+  ASSERT_TRUE(_server.get_bind_ok());
+
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/log')\n"
+               "  local socket = broker_async_tcp_socket.new()\n"
+               "  socket:connect('localhost', 1)\n"
+               "  socket:connect('127.0.0.1', 4242)\n"
+               "  socket:write('message\\n')\n"
+               "  broker_log:info(1, 'flushed: ' .. "
+               "tostring(socket:flush(5)))\n"
+               "  local stats = socket:get_stats()\n"
+               "  broker_log:info(1, 'State: ' .. stats.state)\n"
+               "  broker_log:info(1, 'connections: ' .. stats.connections)\n"
+               "  socket:close()\n"
+               "end\n\n"
+               "function write(d)\n"
+               "end\n\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  std::string lst(ReadFile("/tmp/log"));
+
+  ASSERT_NE(lst.find("flushed: true"), std::string::npos);
+  ASSERT_NE(lst.find("State: connected"), std::string::npos);
+  ASSERT_NE(lst.find("connections: 1"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/log");
+}
+
+// When a script writes on an asynchronous socket that cannot connect
+// Then write() does not block and returns false once the queue is full.
+TEST_F(LuaTest, AsyncSocketBackPressure) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/socket.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/log')\n"
+               "  local socket = broker_async_tcp_socket.new("
+               "{ max_queued_bytes = 10, reconnect_delay = 0.1 })\n"
+               "  socket:connect('127.0.0.1', 1)\n"
+               "  broker_log:info(1, 'first: ' .. "
+               "tostring(socket:write('0123456789')))\n"
+               "  broker_log:info(1, 'second: ' .. "
+               "tostring(socket:write('0123456789')))\n"
+               "  broker_log:info(1, 'flushed: ' .. "
+               "tostring(socket:flush(0.2)))\n"
+               "  local stats = socket:get_stats()\n"
+               "  broker_log:info(1, 'queued_bytes: ' .. stats.queued_bytes)\n"
+               "  broker_log:info(1, 'refused_writes: ' .. "
+               "stats.refused_writes)\n"
+               "  socket:close()\n"
+               "end\n\n"
+               "function write(d)\n"
+               "end\n\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  std::string lst(ReadFile("/tmp/log"));
+
+  ASSERT_NE(lst.find("first: true"), std::string::npos);
+  ASSERT_NE(lst.find("second: false"), std::string::npos);
+  ASSERT_NE(lst.find("flushed: false"), std::string::npos);
+  ASSERT_NE(lst.find("queued_bytes: 10"), std::string::npos);
+  ASSERT_NE(lst.find("refused_writes: 1"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/log");
+}
+
+// When a script writes on a closed asynchronous socket
+// Then write() raises an error and nothing is queued.
+TEST_F(LuaTest, AsyncSocketWriteAfterClose) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/socket.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/log')\n"
+               "  local socket = broker_async_tcp_socket.new()\n"
+               "  socket:connect('127.0.0.1', 1)\n"
+               "  socket:close()\n"
+               "  local ok, err = pcall(socket.write, socket, '0123456789')\n"
+               "  broker_log:info(1, 'write: ' .. tostring(ok) .. ' ' .. "
+               "err)\n"
+               "  broker_log:info(1, 'queued_bytes: ' .. "
+               "socket:get_stats().queued_bytes)\n"
+               "end\n\n"
+               "function write(d)\n"
+               "end\n\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  std::string lst(ReadFile("/tmp/log"));
+
+  ASSERT_NE(lst.find("write: false"), std::string::npos);
+  ASSERT_NE(lst.find("the socket is closed"), std::string::npos);
+  ASSERT_NE(lst.find("queued_bytes: 0"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/log");
+}
+
 // When a script is loaded, a new socket is created
 // And a call to connect is made with a good adress/port
 // Then it succeeds.
@@ -3744,6 +3885,157 @@ TEST_F(LuaTest, BrokerApi2PbServiceStatusJsonEncode) {
   RemoveFile("/tmp/event_log");
 }
 
+// Given a Lua script that stores the events it receives in an array
+// When json_encode_batch() is called on that array
+// Then a json array containing all the encoded events is returned.
+TEST_F(LuaTest, BrokerApi2PbServiceJsonEncodeBatch) {
+  config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
+  modules.load_file("./broker/neb/10-neb.so");
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/cache_test.lua");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "local queue = {}\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  queue[#queue + 1] = d\n"
+               "  if #queue == 3 then\n"
+               "    local json = broker.json_encode_batch(queue)\n"
+               "    broker_log:info(0, json)\n"
+               "    local b = broker.json_decode(json)\n"
+               "    broker_log:info(0, 'decoded ' .. #b .. ' events')\n"
+               "    queue = {}\n"
+               "  end\n"
+               "  return true\n"
+               "end\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  for (int i = 1; i <= 3; ++i) {
+    auto svc = std::make_shared<neb::pb_service>();
+    auto& obj = svc->mut_obj();
+    obj.set_host_id(1899);
+    obj.set_service_id(i);
+    obj.set_description(fmt::format("svc \"{}\"\t", i));
+    binding->write(svc);
+  }
+  std::string lst(ReadFile("/tmp/event_log"));
+  ASSERT_NE(lst.find("[{\"_type\":65563"), std::string::npos);
+  ASSERT_NE(lst.find("\"service_id\":1"), std::string::npos);
+  ASSERT_NE(lst.find("\"service_id\":3"), std::string::npos);
+  ASSERT_NE(lst.find("\"description\":\"svc \\\"2\\\"\\t\""),
+            std::string::npos);
+  ASSERT_NE(lst.find("}]"), std::string::npos);
+  ASSERT_NE(lst.find("decoded 3 events"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
+
+// Given an array containing a function between two tables
+// When json_encode_batch() is called on that array in a pcall
+// Then an error naming the bad element is raised
+// And the script can still encode arrays afterwards.
+TEST_F(LuaTest, JsonEncodeBatchBadElement) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/cache_test.lua");
+  CreateScript(filename,
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+               "  local ok, err = pcall(broker.json_encode_batch,\n"
+               "                        { { a = 1 }, function() end, {} })\n"
+               "  broker_log:info(0, 'first ' .. tostring(ok) .. ' ' .. err)\n"
+               "  broker_log:info(0, 'second ' ..\n"
+               "    broker.json_encode_batch({ { a = 1 }, 'b' }))\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  return true\n"
+               "end\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  std::string lst(ReadFile("/tmp/event_log"));
+  ASSERT_NE(lst.find("first false"), std::string::npos);
+  ASSERT_NE(lst.find("element 2: type not implemented"), std::string::npos);
+  ASSERT_NE(lst.find("second [{\"a\":1},\"b\"]"), std::string::npos);
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
+
+// Given a Lua script encoding the same events one by one and then by batches
+// When the sizes of the produced json strings are compared
+// Then the batches only add the brackets and the commas between events.
+TEST_F(LuaTest, BrokerApi2PbServiceJsonEncodeBatchSize) {
+  config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
+  modules.load_file("./broker/neb/10-neb.so");
+  constexpr int count = 1000;
+  constexpr int batch = 100;
+  std::string filename("/tmp/cache_test.lua");
+  CreateScript(filename,
+               fmt::format("broker_api_version = 2\n"
+                           "local queue = {{}}\n"
+                           "local mode\n"
+                           "local n = 0\n"
+                           "local size = 0\n"
+                           "function init(conf)\n"
+                           "  mode = conf.mode\n"
+                           "  broker_log:set_parameters(3, '/tmp/event_log')\n"
+                           "end\n\n"
+                           "function write(d)\n"
+                           "  n = n + 1\n"
+                           "  if mode == 'single' then\n"
+                           "    size = size + #broker.json_encode(d)\n"
+                           "  else\n"
+                           "    queue[#queue + 1] = d\n"
+                           "    if #queue == {} then\n"
+                           "      size = size + "
+                           "#broker.json_encode_batch(queue)\n"
+                           "      queue = {{}}\n"
+                           "    end\n"
+                           "  end\n"
+                           "  if n == {} then\n"
+                           "    broker_log:info(0, mode .. ' size ' .. size)\n"
+                           "  end\n"
+                           "  return true\n"
+                           "end\n",
+                           batch, count));
+  std::vector<std::shared_ptr<io::data>> events;
+  events.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    auto svc = std::make_shared<neb::pb_service>();
+    auto& obj = svc->mut_obj();
+    obj.set_host_id(1 + i / 50);
+    obj.set_service_id(i);
+    obj.set_description(fmt::format("service \"{}\"", i));
+    obj.set_output(fmt::format("OK - all is fine\nline {}", i));
+    obj.set_perfdata("rta=0.1ms;100;200;0 pl=0%;20;50;0;100");
+    events.push_back(std::move(svc));
+  }
+
+  auto run = [&](const char* mode) {
+    std::map<std::string, misc::variant> conf;
+    conf.insert({"mode", mode});
+    auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+    for (auto& e : events)
+      binding->write(e);
+  };
+
+  run("single");
+  run("batch");
+
+  std::string lst(ReadFile("/tmp/event_log"));
+  auto read_size = [&lst](const std::string& mode) -> uint64_t {
+    size_t pos = lst.find(mode + " size ");
+    if (pos == std::string::npos)
+      return 0;
+    return std::strtoull(lst.c_str() + pos + mode.size() + 6, nullptr, 10);
+  };
+  uint64_t single_size = read_size("single");
+  uint64_t batch_size = read_size("batch");
+  ASSERT_GT(single_size, 0u);
+  /* Each batch adds two brackets and batch - 1 commas. */
+  ASSERT_EQ(batch_size, single_size + (count / batch) * (batch + 1));
+  RemoveFile(filename);
+  RemoveFile("/tmp/event_log");
+}
+
 TEST_F(LuaTest, BrokerPbServiceStatusJsonEncode) {
   config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
   modules.load_file("./broker/neb/10-neb.so");
@@ -103,8 +103,9 @@ void exporter::init_metrics(
           fmt::format("Total number of events stacked in the muxer '{}'",
                       m.name),
           [name = m.name, center = _center]() -> int64_t {
-            const auto& s = center->stats();
-            return s.processing().muxers().at(name).total_events();
+            MuxerStats ms;
+            center->muxer_stats(name, &ms);
+            return ms.total_events();
           });
 
       mi.unacknowledged_events = std::make_unique<instrument_i64>(
@@ -113,8 +114,9 @@ void exporter::init_metrics(
               "Number of unacknowlkedged events stacked in the muxer '{}'",
               m.name),
           [name = m.name, center = _center]() -> int64_t {
-            const auto& s = center->stats();
-            return s.processing().muxers().at(name).unacknowledged_events();
+            MuxerStats ms;
+            center->muxer_stats(name, &ms);
+            return ms.unacknowledged_events();
           });
 
       mi.queue_file.file_write_path = std::make_unique<instrument_i64>(
@@ -140,6 +140,10 @@ class conflict_manager {
     short status;
     float value;
   };
+  struct pending_status {
+    std::shared_ptr<io::data> event;
+    bool* ack;
+  };
 
   static void (conflict_manager::*const _neb_processing_table[])(
       std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>&);
@@ -169,6 +173,7 @@ class conflict_manager {
   uint32_t _max_cv_queries = 0u;
   uint32_t _max_log_queries = 0u;
   uint32_t _max_downtime_queries = 0u;
+  uint32_t _max_status_queries = 0u;
 
   std::unique_ptr<rebuilder> _rebuilder;
 
@@ -231,6 +236,17 @@ class conflict_manager {
   std::deque<std::pair<bool*, std::string>> _log_queue;
   std::deque<std::pair<bool*, std::string>> _downtimes_queue;
 
+  /* The last host/service statuses received, by (host_id, service_id), the
+   * service_id being 0 for a host. A new status replaces the previous one of
+   * the same resource, that is acknowledged at once. The update is done if
+   * the flush interval is reached or if the queue size is greater than
+   * _max_status_queries, with one bulk statement per connection when the
+   * database supports them. */
+  absl::flat_hash_map<std::pair<uint64_t, uint64_t>, pending_status>
+      _status_queue;
+  std::atomic<uint64_t> _statuses_received{0u};
+  std::atomic<uint64_t> _statuses_written{0u};
+
   timestamp _oldest_timestamp;
   std::unordered_map<uint32_t, stored_timestamp> _stored_timestamps;
   std::shared_ptr<spdlog::logger> _logger_sql;
@@ -259,6 +275,8 @@ class conflict_manager {
   database::mysql_stmt _service_group_member_insert;
   database::mysql_stmt _service_insupdate;
   database::mysql_stmt _service_status_update;
+  std::unique_ptr<database::mysql_bulk_stmt> _host_status_bulk_update;
+  std::unique_ptr<database::mysql_bulk_stmt> _service_status_bulk_update;
   database::mysql_stmt _severity_insert;
   database::mysql_stmt _severity_update;
   database::mysql_stmt _tag_insert;
@@ -346,6 +364,10 @@ class conflict_manager {
   void _insert_perfdatas();
   void _update_customvariables();
   void _insert_logs();
+  void _queue_status(std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>& t,
+                     uint64_t host_id,
+                     uint64_t service_id);
+  void _update_statuses();
   void __exit();
 
   void _update_stats(const std::uint32_t size,
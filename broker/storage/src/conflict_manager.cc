@@ -175,6 +175,7 @@ bool conflict_manager::init_storage(bool store_in_db,
       _singleton->_max_cv_queries = dbcfg.get_queries_per_transaction();
       _singleton->_max_log_queries = dbcfg.get_queries_per_transaction();
       _singleton->_max_downtime_queries = dbcfg.get_queries_per_transaction();
+      _singleton->_max_status_queries = dbcfg.get_queries_per_transaction();
       _singleton->_ref_count++;
       _singleton->_thread =
           std::thread(&conflict_manager::_callback, _singleton);
@@ -546,11 +547,19 @@ void conflict_manager::_callback() {
         time_t next_update_cv = next_insert_perfdatas;
         time_t next_update_log = next_insert_perfdatas;
         time_t next_update_downtime = next_insert_perfdatas;
+        time_t next_update_status = next_insert_perfdatas;
 
         auto empty_caches = [this, &next_insert_perfdatas, &next_update_metrics,
                              &next_update_cv, &next_update_log,
-                             &next_update_downtime](
+                             &next_update_downtime, &next_update_status](
                                 std::chrono::system_clock::time_point now) {
+          /* Statuses are coalesced during one second, then written in bulk. */
+          if (std::chrono::system_clock::to_time_t(now) >= next_update_status ||
+              _status_queue.size() > _max_status_queries) {
+            next_update_status = std::chrono::system_clock::to_time_t(now) + 1;
+            _update_statuses();
+          }
+
           /* If there are too many perfdata to send, let's send them... */
           if (std::chrono::system_clock::to_time_t(now) >=
                   next_insert_perfdatas ||
@@ -704,6 +713,7 @@ void conflict_manager::_callback() {
         }
         _logger_sql->debug("{} new events to treat", count);
         /* Here, just before looping, we commit. */
+        _update_statuses();
         _finish_actions();
         if (_fifo.get_pending_elements() == 0)
           _logger_sql->debug(
@@ -898,6 +908,8 @@ nlohmann::json conflict_manager::get_statistics() {
   retval["max pending events"] = static_cast<int32_t>(_max_pending_queries);
   retval["max perfdata events"] = static_cast<int32_t>(_max_perfdata_queries);
   retval["loop timeout"] = static_cast<int32_t>(_loop_timeout);
+  retval["statuses received"] = _statuses_received.load();
+  retval["statuses written"] = _statuses_written.load();
   if (std::unique_lock<std::mutex>(_stat_m, std::try_to_lock)) {
     retval["waiting_events"] = static_cast<int32_t>(_fifo.get_events().size());
     retval["events_handled"] = _events_handled;
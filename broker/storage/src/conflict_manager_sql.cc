@@ -216,6 +216,7 @@ void conflict_manager::_update_hosts_and_services_of_unresponsive_instances() {
  */
 void conflict_manager::_update_hosts_and_services_of_instance(uint32_t id,
                                                               bool responsive) {
+  _update_statuses();
   int32_t conn = _mysql.choose_connection_by_instance(id);
   _finish_action(conn, actions::hosts);
   _finish_action(-1, actions::acknowledgements | actions::modules |
@@ -757,6 +758,7 @@ void conflict_manager::_process_host_group_member(
 void conflict_manager::_process_host(
     std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>& t) {
   auto& d = std::get<0>(t);
+  _update_statuses();
   _finish_action(-1, actions::instances | actions::hostgroups |
                          actions::host_parents | actions::custom_variables |
                          actions::downtimes | actions::comments);
@@ -869,9 +871,6 @@ void conflict_manager::_process_host_parent(
 void conflict_manager::_process_host_status(
     std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>& t) {
   auto& d = std::get<0>(t);
-  _finish_action(-1, actions::instances | actions::downtimes |
-                         actions::comments | actions::custom_variables |
-                         actions::hostgroups | actions::host_parents);
 
   // Processed object.
   neb::host_status const& hs(*static_cast<neb::host_status const*>(d.get()));
@@ -888,29 +887,17 @@ void conflict_manager::_process_host_status(
         "{}))",
         hs.host_id, hs.last_check, hs.current_state, hs.state_type);
 
-    // Prepare queries.
-    if (!_host_status_update.prepared()) {
-      query_preparator::event_unique unique;
-      unique.insert("host_id");
-      query_preparator qp(neb::host_status::static_type(), unique);
-      _host_status_update = qp.prepare_update(_mysql);
-    }
-
-    // Processing.
-    _host_status_update << hs;
-    int32_t conn =
-        _mysql.choose_connection_by_instance(_cache_host_instance[hs.host_id]);
-    _mysql.run_statement(_host_status_update,
-                         database::mysql_error::store_host_status, conn);
-    _add_action(conn, actions::hosts);
-  } else
+    // Processing, the status is written with the next bulk.
+    _queue_status(t, hs.host_id, 0);
+  } else {
     // Do nothing.
     _logger_sql->info(
         "SQL: not processing host status event (id: {}, check type: {}, last "
         "check: {}, next check: {}, now: {}, state: ({}, {}))",
         hs.host_id, hs.check_type, hs.last_check, hs.next_check, now,
         hs.current_state, hs.state_type);
-  *std::get<2>(t) = true;
+    *std::get<2>(t) = true;
+  }
 }
 
 /**
@@ -925,6 +912,7 @@ void conflict_manager::_process_instance(
     std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>& t) {
   auto& d = std::get<0>(t);
   neb::instance& i(*static_cast<neb::instance*>(d.get()));
+  _update_statuses();
   int32_t conn = _mysql.choose_connection_by_instance(i.poller_id);
   _finish_action(-1, actions::hosts | actions::acknowledgements |
                          actions::modules | actions::downtimes |
@@ -1268,6 +1256,7 @@ void conflict_manager::_process_service_group_member(
 void conflict_manager::_process_service(
     std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>& t) {
   auto& d = std::get<0>(t);
+  _update_statuses();
   _finish_action(
       -1, actions::host_parents | actions::comments | actions::downtimes);
 
@@ -1320,8 +1309,6 @@ void conflict_manager::_process_service(
 void conflict_manager::_process_service_status(
     std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>& t) {
   auto& d = std::get<0>(t);
-  _finish_action(
-      -1, actions::host_parents | actions::comments | actions::downtimes);
   // Processed object.
   neb::service_status const& ss{
       *static_cast<neb::service_status const*>(d.get())};
@@ -1342,23 +1329,9 @@ void conflict_manager::_process_service_status(
         ss.host_id, ss.service_id, ss.last_check, ss.current_state,
         ss.state_type);
 
-    // Prepare queries.
-    if (!_service_status_update.prepared()) {
-      query_preparator::event_unique unique;
-      unique.insert("host_id");
-      unique.insert("service_id");
-      query_preparator qp(neb::service_status::static_type(), unique);
-      _service_status_update = qp.prepare_update(_mysql);
-    }
-
-    // Processing.
-    _service_status_update << ss;
-    int32_t conn =
-        _mysql.choose_connection_by_instance(_cache_host_instance[ss.host_id]);
-    _mysql.run_statement(_service_status_update,
-                         database::mysql_error::store_service_status, conn);
-    _add_action(conn, actions::services);
-  } else
+    // Processing, the status is written with the next bulk.
+    _queue_status(t, ss.host_id, ss.service_id);
+  } else {
     // Do nothing.
     _logger_sql->info(
         "SQL: not processing service status event (host: {}, service: {}, "
@@ -1366,7 +1339,8 @@ void conflict_manager::_process_service_status(
         "{}))",
         ss.host_id, ss.service_id, ss.check_type, ss.last_check, ss.next_check,
         now, ss.current_state, ss.state_type);
-  *std::get<2>(t) = true;
+    *std::get<2>(t) = true;
+  }
 }
 
 /**
@@ -1656,6 +1630,114 @@ void conflict_manager::_update_downtimes() {
   }
 }
 
+/**
+ * @brief Keep a host or service status until the next call to
+ * _update_statuses(). If a status of the same resource is already waiting, it
+ * is replaced and acknowledged since this one contains all its columns.
+ *
+ * @param t The event with its acknowledgement boolean.
+ * @param host_id The host id.
+ * @param service_id The service id or 0 for a host status.
+ */
+void conflict_manager::_queue_status(
+    std::tuple<std::shared_ptr<io::data>, uint32_t, bool*>& t,
+    uint64_t host_id,
+    uint64_t service_id) {
+  ++_statuses_received;
+  auto found = _status_queue.find({host_id, service_id});
+  if (found == _status_queue.end())
+    _status_queue.emplace(std::make_pair(host_id, service_id),
+                          pending_status{std::get<0>(t), std::get<2>(t)});
+  else {
+    *found->second.ack = true;
+    found->second = pending_status{std::get<0>(t), std::get<2>(t)};
+  }
+}
+
+/**
+ * @brief Write the waiting host and service statuses. They are grouped by
+ * connection, each connection receives one bulk statement for its hosts and
+ * one for its services. If the database does not support bulk statements
+ * (MySQL, MariaDB before 10.2), the statuses are written one by one with the
+ * usual update statements, one statement per row: only the coalescing of
+ * the statuses of a same host or service reduces the queries then. Then the
+ * events are acknowledged.
+ *
+ * When we exit the function, the statuses queue is empty.
+ */
+void conflict_manager::_update_statuses() {
+  if (_status_queue.empty())
+    return;
+
+  _finish_action(-1, actions::instances | actions::downtimes |
+                         actions::comments | actions::custom_variables |
+                         actions::hostgroups | actions::host_parents);
+
+  // Prepare queries.
+  const bool bulk = _mysql.support_bulk_statement();
+  if (!_host_status_update.prepared()) {
+    query_preparator::event_unique unique;
+    unique.insert("host_id");
+    query_preparator qp(neb::host_status::static_type(), unique);
+    _host_status_update = qp.prepare_update(_mysql);
+    if (bulk)
+      _host_status_bulk_update = qp.prepare_bulk_update(_mysql);
+  }
+  if (!_service_status_update.prepared()) {
+    query_preparator::event_unique unique;
+    unique.insert("host_id");
+    unique.insert("service_id");
+    query_preparator qp(neb::service_status::static_type(), unique);
+    _service_status_update = qp.prepare_update(_mysql);
+    if (bulk)
+      _service_status_bulk_update = qp.prepare_bulk_update(_mysql);
+  }
+
+  /* Statuses by connection, hosts at index 0 and services at index 1. */
+  std::vector<std::array<std::vector<const io::data*>, 2>> by_conn(
+      _mysql.connections_count());
+  for (auto& p : _status_queue) {
+    int32_t conn = _mysql.choose_connection_by_instance(
+        _cache_host_instance[p.first.first]);
+    by_conn[conn][p.first.second ? 1 : 0].push_back(p.second.event.get());
+  }
+
+  for (int32_t conn = 0; conn < static_cast<int32_t>(by_conn.size());
+       ++conn) {
+    for (int i = 0; i < 2; ++i) {
+      auto& rows = by_conn[conn][i];
+      if (rows.empty())
+        continue;
+      my_error::code ec = i ? database::mysql_error::store_service_status
+                            : database::mysql_error::store_host_status;
+      if (bulk) {
+        database::mysql_bulk_stmt& stmt =
+            i ? *_service_status_bulk_update : *_host_status_bulk_update;
+        for (const io::data* d : rows) {
+          stmt << *d;
+          stmt.next_row();
+        }
+        _mysql.run_statement(stmt, ec, conn);
+      } else {
+        database::mysql_stmt& stmt =
+            i ? _service_status_update : _host_status_update;
+        for (const io::data* d : rows) {
+          stmt << *d;
+          _mysql.run_statement(stmt, ec, conn);
+        }
+      }
+      _add_action(conn, i ? actions::services : actions::hosts);
+    }
+  }
+  _logger_sql->debug("{} host/service statuses updated", _status_queue.size());
+  _statuses_written += _status_queue.size();
+
+  /* Acknowledgement and cleanup */
+  for (auto& p : _status_queue)
+    *p.second.ack = true;
+  _status_queue.clear();
+}
+
 /**
  * @brief Send a big query to insert a bulk of logs. When the query is done,
  * we set the corresponding boolean of each pair to true to ack each event.
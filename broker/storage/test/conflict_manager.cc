@@ -27,9 +27,12 @@
 #include "com/centreon/broker/modules/loader.hh"
 #include "com/centreon/broker/neb/custom_variable.hh"
 #include "com/centreon/broker/neb/host.hh"
+#include "com/centreon/broker/neb/host_status.hh"
 #include "com/centreon/broker/neb/instance.hh"
 #include "com/centreon/broker/neb/module.hh"
 #include "com/centreon/broker/neb/service.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+#include "status_stream.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::sql;
@@ -131,3 +134,46 @@ TEST_F(ConflictManagerTest, InstCVConflict) {
 
   conflict_manager::close();
 }
+
+/**
+ * Replay of a stream of statuses as sent by a poller: 20 hosts with 50
+ * services each, every resource receives 10 statuses. They are coalesced
+ * before being written, so all the events are acknowledged but far less rows
+ * are updated.
+ */
+TEST_F(ConflictManagerTest, StatusesReplay) {
+  modules::loader l;
+  l.load_file("./broker/neb/10-neb.so");
+  uint32_t loop_timeout = 5;
+  uint32_t instance_timeout = 5;
+  database_config dbcfg("MySQL", "127.0.0.1", 3306, "centreon", "centreon",
+                        "centreon_storage", 5, true, 5);
+  ASSERT_NO_THROW(
+      conflict_manager::init_sql(dbcfg, loop_timeout, instance_timeout));
+  auto& cm = conflict_manager::instance();
+
+  constexpr uint32_t hosts = 20;
+  constexpr uint32_t services = 50;
+  constexpr uint32_t rounds = 10;
+
+  std::vector<std::shared_ptr<io::data>> stream =
+      status_stream(hosts, services, rounds);
+
+  for (auto& e : stream)
+    cm.send_event(conflict_manager::sql, e);
+
+  size_t acks = 0;
+  for (int i = 0; i < 600 && acks < stream.size(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    acks += cm.get_acks(conflict_manager::sql);
+  }
+  ASSERT_EQ(acks, stream.size());
+
+  nlohmann::json stats = cm.get_statistics();
+  uint64_t received = stats["statuses received"].get<uint64_t>();
+  uint64_t written = stats["statuses written"].get<uint64_t>();
+  ASSERT_EQ(received, hosts * (services + 1) * rounds);
+  ASSERT_LT(written, received);
+
+  conflict_manager::close();
+}
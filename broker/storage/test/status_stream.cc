@@ -0,0 +1,93 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#include "status_stream.hh"
+
+#include "com/centreon/broker/neb/host.hh"
+#include "com/centreon/broker/neb/host_status.hh"
+#include "com/centreon/broker/neb/instance.hh"
+#include "com/centreon/broker/neb/service.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+
+using namespace com::centreon::broker;
+
+/**
+ * @brief The stream sent by the poller 1: its instance, its hosts with their
+ * services, then rounds statuses of each host and service. Each round changes
+ * the states, the outputs and the perfdata.
+ *
+ * @param hosts The number of hosts.
+ * @param services The number of services of each host.
+ * @param rounds The number of statuses of each host and service.
+ *
+ * @return The events in the order the poller sends them.
+ */
+std::vector<std::shared_ptr<io::data>> status_stream(uint32_t hosts,
+                                                     uint32_t services,
+                                                     uint32_t rounds) {
+  std::vector<std::shared_ptr<io::data>> retval;
+  retval.reserve(1 + hosts * (services + 1) * (rounds + 1));
+  auto inst = std::make_shared<neb::instance>();
+  inst->poller_id = 1;
+  inst->name = "Central";
+  inst->program_start = time(nullptr) - 100;
+  inst->version = "1.8.1";
+  inst->is_running = true;
+  retval.push_back(inst);
+  for (uint32_t i = 1; i <= hosts; ++i) {
+    auto h = std::make_shared<neb::host>();
+    h->host_id = i;
+    h->host_name = fmt::format("host_{}", i);
+    h->address = "127.0.0.1";
+    h->poller_id = 1;
+    h->enabled = true;
+    retval.push_back(h);
+    for (uint32_t j = 1; j <= services; ++j) {
+      auto s = std::make_shared<neb::service>();
+      s->host_id = i;
+      s->service_id = (i - 1) * services + j;
+      s->service_description = fmt::format("service_{}", j);
+      s->enabled = true;
+      retval.push_back(s);
+    }
+  }
+
+  time_t now = time(nullptr);
+  for (uint32_t r = 0; r < rounds; ++r) {
+    for (uint32_t i = 1; i <= hosts; ++i) {
+      auto hs = std::make_shared<neb::host_status>();
+      hs->host_id = i;
+      hs->last_check = now + r;
+      hs->next_check = now + r + 300;
+      hs->current_state = r % 2;
+      hs->output = fmt::format("round {}", r);
+      retval.push_back(hs);
+      for (uint32_t j = 1; j <= services; ++j) {
+        auto ss = std::make_shared<neb::service_status>();
+        ss->host_id = i;
+        ss->service_id = (i - 1) * services + j;
+        ss->last_check = now + r;
+        ss->next_check = now + r + 300;
+        ss->current_state = r % 3;
+        ss->output = fmt::format("round {}", r);
+        ss->perf_data = fmt::format("metric={}", r);
+        retval.push_back(ss);
+      }
+    }
+  }
+  return retval;
+}
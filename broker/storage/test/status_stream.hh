@@ -0,0 +1,28 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+#ifndef CENTREON_BROKER_STORAGE_TEST_STATUS_STREAM_HH_
+#define CENTREON_BROKER_STORAGE_TEST_STATUS_STREAM_HH_
+
+#include "com/centreon/broker/io/data.hh"
+
+std::vector<std::shared_ptr<com::centreon::broker::io::data>> status_stream(
+    uint32_t hosts,
+    uint32_t services,
+    uint32_t rounds);
+
+#endif  // CENTREON_BROKER_STORAGE_TEST_STATUS_STREAM_HH_
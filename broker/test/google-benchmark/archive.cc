@@ -0,0 +1,139 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include <arpa/inet.h>
+
+#include "com/centreon/broker/file/archive.hh"
+#include "com/centreon/broker/misc/filesystem.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::file;
+
+namespace {
+constexpr const char* archive_path = "/tmp/bench_archive";
+constexpr uint32_t nb_events = 200000;
+/* Events per second of archive time, so the archive spans 2000s. */
+constexpr uint32_t events_per_second = 100;
+
+void remove_archive() {
+  for (const std::string& f : misc::filesystem::dir_content_with_filter(
+           "/tmp/", "bench_archive.*"))
+    std::remove(f.c_str());
+}
+
+/* A fake BBDO event of 200 to 600 bytes: a header with its type followed by
+ * a status text, as repetitive as the real ones. */
+std::string make_event(uint32_t num) {
+  std::string retval(16, '\0');
+  uint32_t type = htonl(num % 10 ? 0x10018 : 0x1001d);
+  memcpy(&retval[4], &type, sizeof(type));
+  retval.append(fmt::format(
+      "host_{};service_{};OK - load average: {}.{:02}, {}.{:02}, {}.{:02}|"
+      "load1={}.{:02};5;10;0; load5={}.{:02};4;8;0;",
+      num % 1000, num % 20, num % 7, num % 100, num % 5, num % 97, num % 3,
+      num % 89, num % 7, num % 100, num % 5, num % 97));
+  retval.resize(200 + num % 400, 'x');
+  return retval;
+}
+
+/* The archive read by the replay and seek benchmarks, written once. */
+void write_archive(int compression_level) {
+  remove_archive();
+  archive_writer writer(archive_path, 1000000000u, 256 * 1024,
+                        compression_level);
+  for (uint32_t i = 0; i < nb_events; ++i) {
+    std::string ev = make_event(i);
+    writer.write(ev.data(), ev.size(), 1000 + i / events_per_second);
+  }
+}
+}  // namespace
+
+/* Write nb_events events with the compression level range(0). */
+static void BM_archive_write(benchmark::State& state) {
+  std::vector<std::string> events;
+  events.reserve(nb_events);
+  size_t bytes = 0;
+  for (uint32_t i = 0; i < nb_events; ++i) {
+    events.emplace_back(make_event(i));
+    bytes += events.back().size();
+  }
+
+  uint64_t stored = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    remove_archive();
+    state.ResumeTiming();
+    archive_writer writer(archive_path, 1000000000u, 256 * 1024,
+                          state.range(0));
+    for (uint32_t i = 0; i < nb_events; ++i)
+      writer.write(events[i].data(), events[i].size(),
+                   1000 + i / events_per_second);
+    writer.flush();
+    stored = writer.stored_bytes();
+  }
+  remove_archive();
+  state.counters["ratio"] = static_cast<double>(bytes) / stored;
+  state.SetItemsProcessed(state.iterations() * nb_events);
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_archive_write)->Arg(1)->Arg(6)->Unit(benchmark::kMillisecond);
+
+/* Read the whole archive. */
+static void BM_archive_replay(benchmark::State& state) {
+  write_archive(1);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    archive_reader reader(archive_path);
+    archive_event ev;
+    uint32_t count = 0;
+    bytes = 0;
+    while (reader.next(ev)) {
+      bytes += ev.data.size();
+      ++count;
+    }
+    if (count != nb_events)
+      state.SkipWithError("events missing in the replay");
+  }
+  remove_archive();
+  state.SetItemsProcessed(state.iterations() * nb_events);
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_archive_replay)->Unit(benchmark::kMillisecond);
+
+/* Seek to a timestamp and read the first event from there. */
+static void BM_archive_seek(benchmark::State& state) {
+  write_archive(1);
+  archive_reader reader(archive_path);
+  archive_event ev;
+  constexpr int64_t duration = nb_events / events_per_second;
+  int64_t offset = 0;
+  for (auto _ : state) {
+    int64_t ts = 1000 + offset;
+    reader.seek(ts);
+    if (!reader.next(ev) || ev.ts != ts) {
+      state.SkipWithError("seek did not find the timestamp");
+      break;
+    }
+    offset = (offset + 733) % duration;
+  }
+  remove_archive();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_archive_seek)->Unit(benchmark::kMicrosecond);
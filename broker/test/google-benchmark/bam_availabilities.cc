@@ -0,0 +1,149 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/bam/daily_availabilities.hh"
+#include "com/centreon/broker/misc/time.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+namespace {
+struct event {
+  uint32_t ba_id;
+  short status;
+  time_t start;
+  time_t end;
+  bool in_downtime;
+};
+
+/* The events of the BAs for one day, as read by the availability thread.
+ * Each BA has the two timeperiods and nb_events closed events, one BA out of
+ * three has an opened event, one out of ten has only an opened event. */
+struct day_events {
+  std::vector<event> opened;
+  std::vector<event> closed;
+
+  day_events(timeperiod_map& tps,
+             uint32_t nb_bas,
+             uint32_t nb_events,
+             time_t day_start,
+             time_t day_end) {
+    for (uint32_t ba_id = 1; ba_id <= nb_bas; ++ba_id) {
+      tps.add_relation(ba_id, 1, true);
+      tps.add_relation(ba_id, 2, false);
+      time_t t = day_start - 3600;
+      if (ba_id % 10) {
+        time_t step = (day_end - t) / (nb_events + 1);
+        for (uint32_t i = 0; i < nb_events; ++i, t += step)
+          closed.push_back({ba_id, static_cast<short>((ba_id + i) % 4), t,
+                            t + step, (ba_id + i) % 7 == 0});
+      }
+      if (ba_id % 3 == 0 || ba_id % 10 == 0)
+        opened.push_back({ba_id, static_cast<short>(ba_id % 4), t, 0, false});
+    }
+  }
+};
+
+/* Build the availabilities of the BAs such that ba_id % workers = worker,
+ * the events are shifted by shift seconds to the built day. */
+uint64_t build_partition(const day_events& events,
+                         const timeperiod_map& tps,
+                         time_t day_start,
+                         time_t shift,
+                         uint32_t worker,
+                         uint32_t workers,
+                         const std::shared_ptr<spdlog::logger>& logger) {
+  uint64_t retval = 0;
+  daily_availabilities day(
+      day_start, day_start + 24 * 3600, tps,
+      [&retval](uint32_t, uint32_t, const availability_builder& b) {
+        benchmark::DoNotOptimize(b.get_available());
+        ++retval;
+      },
+      logger);
+  for (auto& e : events.opened)
+    if (e.ba_id % workers == worker)
+      day.add_opened_event(e.ba_id, e.status, e.start + shift, e.in_downtime);
+  for (auto& e : events.closed)
+    if (e.ba_id % workers == worker)
+      for (uint32_t tp_id : {1u, 2u})
+        day.add_closed_event(e.ba_id, tp_id, tp_id == 1, e.status,
+                             e.start + shift, e.end + shift, e.in_downtime);
+  day.finish();
+  return retval;
+}
+}  // namespace
+
+/* Availabilities of range(0) days for range(1) BAs with 20 events each, the
+ * BAs of each day are partitioned between range(2) workers as done by the
+ * availability thread. */
+static void BM_daily_availabilities(benchmark::State& state) {
+  const uint32_t nb_days = state.range(0);
+  const uint32_t nb_bas = state.range(1);
+  const uint32_t workers = state.range(2);
+  auto logger = log_v2::instance().get(log_v2::BAM);
+
+  timeperiod_map tps;
+  tps.add_timeperiod(
+      1, std::make_shared<time::timeperiod>(
+             1, "24x7", "24x7", "00:00-24:00", "00:00-24:00", "00:00-24:00",
+             "00:00-24:00", "00:00-24:00", "00:00-24:00", "00:00-24:00"));
+  tps.add_timeperiod(
+      2, std::make_shared<time::timeperiod>(
+             2, "workhours", "workhours", "", "08:00-20:00", "08:00-20:00",
+             "08:00-20:00", "08:00-20:00", "08:00-20:00", ""));
+  /* mon. 1 march 2021 */
+  const time_t first_day = misc::start_of_day(1614600000);
+  day_events events(tps, nb_bas, 20, first_day, first_day + 24 * 3600);
+
+  uint64_t written = 0;
+  for (auto _ : state) {
+    std::vector<uint64_t> counts(workers);
+    for (uint32_t d = 0; d < nb_days; ++d) {
+      time_t day_start = misc::start_of_day(first_day + d * 24 * 3600 + 43200);
+      time_t shift = day_start - first_day;
+      std::vector<std::thread> threads;
+      for (uint32_t w = 0; w < workers; ++w)
+        threads.emplace_back([&, w] {
+          counts[w] += build_partition(events, tps, day_start, shift, w,
+                                       workers, logger);
+        });
+      for (auto& t : threads)
+        t.join();
+    }
+    written = 0;
+    for (uint64_t c : counts)
+      written += c;
+  }
+  if (written != 2ull * nb_bas * nb_days)
+    state.SkipWithError("availabilities missing");
+  state.counters["availabilities"] = written;
+  state.SetItemsProcessed(state.iterations() * nb_days * nb_bas);
+}
+BENCHMARK(BM_daily_availabilities)
+    ->ArgNames({"days", "bas", "workers"})
+    ->Args({7, 5000, 1})
+    ->Args({7, 5000, 2})
+    ->Args({7, 5000, 4})
+    ->Args({7, 5000, 8})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "bbdo/neb.pb.h"
+#include "com/centreon/broker/bam/bool_expression.hh"
+#include "com/centreon/broker/bam/exp_builder.hh"
+#include "com/centreon/broker/bam/exp_parser.hh"
+#include "com/centreon/broker/bam/service_book.hh"
+#include "com/centreon/broker/neb/internal.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+namespace {
+/* nb_expressions boolean expressions using nb_expressions services of
+ * host_1, each service is used by three expressions. */
+struct expressions {
+  bam::hst_svc_mapping mapping;
+  bam::service_book book;
+  std::vector<std::shared_ptr<bam::bool_expression>> exps;
+
+  expressions(uint32_t nb_expressions,
+              bool compile,
+              const std::shared_ptr<spdlog::logger>& logger)
+      : mapping(logger), book(logger) {
+    for (uint32_t i = 1; i <= nb_expressions; ++i)
+      mapping.set_service("host_1", fmt::format("service_{}", i), 1, i, true);
+
+    for (uint32_t i = 0; i < nb_expressions; ++i) {
+      bam::exp_parser p(fmt::format(
+          "({{host_1 service_{}}} {{IS}} {{OK}} {{OR}} {{host_1 service_{}}} "
+          "{{IS}} {{OK}}) {{AND}} {{host_1 service_{}}} {{NOT}} {{CRITICAL}}",
+          i + 1, (i + 1) % nb_expressions + 1, (i + 2) % nb_expressions + 1));
+      bam::exp_builder builder(p.get_postfix(), mapping, logger);
+      bam::bool_value::ptr tree(builder.get_tree());
+      auto exp = std::make_shared<bam::bool_expression>(i + 1, true, logger);
+      exp->set_expression(tree);
+      tree->add_parent(exp);
+      for (auto& svc : builder.get_services())
+        book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
+      if (compile)
+        exp->compile();
+      exps.push_back(std::move(exp));
+    }
+  }
+};
+
+std::shared_ptr<neb::pb_service_status> status(uint32_t service_id,
+                                               int state) {
+  auto retval = std::make_shared<neb::pb_service_status>();
+  retval->mut_obj().set_host_id(1);
+  retval->mut_obj().set_service_id(service_id);
+  retval->mut_obj().set_state(static_cast<ServiceStatus::State>(state));
+  retval->mut_obj().set_last_hard_state(
+      static_cast<ServiceStatus::State>(state));
+  return retval;
+}
+}  // namespace
+
+/* range(0) expressions evaluated as trees (range(1) = 0) or compiled into
+ * bool_program (range(1) = 1). Once all the services are known, each
+ * iteration is a status of one service with a new state, it changes the
+ * three expressions using it. */
+static void BM_bool_expressions_update(benchmark::State& state) {
+  const uint32_t nb_expressions = state.range(0);
+  auto logger = log_v2::instance().get(log_v2::BAM);
+  expressions env(nb_expressions, state.range(1), logger);
+
+  std::vector<std::shared_ptr<neb::pb_service_status>> statuses;
+  for (uint32_t i = 1; i <= nb_expressions; ++i) {
+    env.book.update(status(i, 0));
+    for (int s = 0; s < 4; ++s)
+      statuses.push_back(status(i, s));
+  }
+
+  uint32_t service = 0;
+  uint32_t turn = 1;
+  for (auto _ : state) {
+    env.book.update(statuses[4 * service + turn % 4]);
+    service = (service + 7919) % nb_expressions;
+    if (!service)
+      ++turn;
+  }
+
+  uint32_t known = 0;
+  for (auto& exp : env.exps)
+    known += exp->state_known();
+  state.counters["known"] = known;
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_bool_expressions_update)
+    ->ArgNames({"expressions", "compiled"})
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({5000, 0})
+    ->Args({5000, 1});
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/storage/conflict_manager.hh"
+#include "common/log_v2/log_v2.hh"
+#include "status_stream.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::storage;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+namespace {
+constexpr uint32_t nb_hosts = 100;
+constexpr uint32_t nb_services = 50;
+}  // namespace
+
+/* Replay of a poller stream with range(0) statuses per host and service
+ * through the sql stream of the conflict manager. The stream is the one of
+ * the StatusesReplay test, built once and replayed by each iteration. An iteration lasts until
+ * all the events are acknowledged, so it includes the writing of the
+ * coalesced statuses. It needs the centreon_storage database of the SQL
+ * tests. */
+static void BM_conflict_manager_replay(benchmark::State& state) {
+  config::applier::modules modules(log_v2::instance().get(log_v2::SQL));
+  modules.load_file("./broker/neb/10-neb.so");
+  database_config dbcfg("MySQL", "127.0.0.1", MYSQL_SOCKET, 3306, "centreon",
+                        "centreon", "centreon_storage", 5, true, 5);
+  std::vector<std::shared_ptr<io::data>> stream =
+      status_stream(nb_hosts, nb_services, state.range(0));
+
+  uint64_t received = 0;
+  uint64_t written = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    try {
+      conflict_manager::init_sql(dbcfg, 5, 5);
+    } catch (const std::exception& e) {
+      state.SkipWithError(e.what());
+      break;
+    }
+    conflict_manager& cm = conflict_manager::instance();
+    state.ResumeTiming();
+
+    for (auto& e : stream)
+      cm.send_event(conflict_manager::sql, e);
+    size_t acks = 0;
+    for (int i = 0; i < 60000 && acks < stream.size(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      acks += cm.get_acks(conflict_manager::sql);
+    }
+
+    state.PauseTiming();
+    nlohmann::json stats = cm.get_statistics();
+    received = stats["statuses received"].get<uint64_t>();
+    written = stats["statuses written"].get<uint64_t>();
+    conflict_manager::unload(conflict_manager::sql);
+    if (acks < stream.size()) {
+      state.SkipWithError("events not acknowledged");
+      break;
+    }
+    state.ResumeTiming();
+  }
+  state.counters["statuses_received"] = received;
+  state.counters["statuses_written"] = written;
+  state.SetItemsProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(BM_conflict_manager_replay)
+    ->ArgName("rounds")
+    ->Arg(1)
+    ->Arg(10)
+    ->Iterations(3)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,196 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/cache/global_cache_data.hh"
+
+using namespace com::centreon::broker::cache;
+
+/* The global cache with its string pool is compared to the former layout,
+ * where each metric_info had its own name and unit strings. The former
+ * layout is rebuilt here in another mapped file. */
+namespace {
+struct former_metric_info {
+  former_metric_info(uint64_t i_index_id,
+                     const std::string_view& i_name,
+                     const std::string_view& i_unit,
+                     double i_min,
+                     double i_max,
+                     const char_allocator& char_alloc)
+      : index_id(i_index_id),
+        name(i_name.data(), i_name.length(), char_alloc),
+        unit(i_unit.data(), i_unit.length(), char_alloc),
+        min(i_min),
+        max(i_max) {}
+
+  uint64_t index_id;
+  string name;
+  string unit;
+  double min;
+  double max;
+};
+
+using former_id_to_metric_info = interprocess::flat_map<
+    uint64_t,
+    interprocess::offset_ptr<former_metric_info>,
+    std::less<uint64_t>,
+    interprocess::allocator<
+        std::pair<uint64_t, interprocess::offset_ptr<former_metric_info>>,
+        segment_manager>>;
+
+using former_metric_info_allocator = com::centreon::common::
+    node_allocator<former_metric_info, char_allocator, 0x10000>;
+
+constexpr const char* cache_path = "/tmp/bench_global_cache";
+constexpr const char* former_path = "/tmp/bench_former_global_cache";
+constexpr size_t file_size = 0x10000000;
+
+/* Metric names and units are very repetitive on a real central. */
+const std::array<std::string_view, 12> names{
+    "rta",   "pl",    "rtmax",  "rtmin",      "used",        "size",
+    "load1", "load5", "load15", "traffic_in", "traffic_out", "cpu"};
+const std::array<std::string_view, 5> units{"ms", "%", "B", "b/s", ""};
+
+std::string metric_name(uint64_t metric_id) {
+  return fmt::format("{}_{}", names[metric_id % names.size()],
+                     metric_id % 16);
+}
+
+std::string_view metric_unit(uint64_t metric_id) {
+  return units[metric_id % units.size()];
+}
+
+void fill_global_cache(size_t count) {
+  global_cache::pointer cache = global_cache::instance_ptr();
+  for (uint64_t ii = 0; ii < count; ++ii)
+    cache->set_metric_info(ii, ii / 4, metric_name(ii), metric_unit(ii), 0,
+                           100);
+}
+
+void fill_former_layout(interprocess::managed_mapped_file& file,
+                        size_t count) {
+  auto* metrics = file.find_or_construct<former_id_to_metric_info>(
+      "metric_info")(file.get_segment_manager());
+  auto* alloc = file.find_or_construct<former_metric_info_allocator>(
+      "metric_info_allocator")(file.get_segment_manager());
+  metrics->reserve(count);
+  for (uint64_t ii = 0; ii < count; ++ii) {
+    former_metric_info* to_add = new (alloc->allocate()) former_metric_info(
+        ii / 4, metric_name(ii), metric_unit(ii), 0, 100,
+        file.get_segment_manager());
+    metrics->emplace(ii, to_add);
+  }
+}
+}  // namespace
+
+/* Fill a new cache file, the bytes used by metric are reported. */
+static void BM_global_cache_metric_size(benchmark::State& state) {
+  const size_t count = state.range(0);
+  size_t used = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    global_cache::unload();
+    ::remove(cache_path);
+    global_cache::load(cache_path, file_size);
+    size_t initial = global_cache::instance_ptr()->used_size();
+    state.ResumeTiming();
+
+    fill_global_cache(count);
+
+    state.PauseTiming();
+    used = global_cache::instance_ptr()->used_size() - initial;
+    state.ResumeTiming();
+  }
+  global_cache::unload();
+  ::remove(cache_path);
+  state.counters["bytes_per_metric"] = static_cast<double>(used) / count;
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_global_cache_metric_size)->Arg(10000)->Arg(100000);
+
+static void BM_former_layout_metric_size(benchmark::State& state) {
+  const size_t count = state.range(0);
+  size_t used = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ::remove(former_path);
+    interprocess::managed_mapped_file file(interprocess::create_only,
+                                           former_path, file_size);
+    size_t initial = file.get_size() - file.get_free_memory();
+    state.ResumeTiming();
+
+    fill_former_layout(file, count);
+
+    state.PauseTiming();
+    used = file.get_size() - file.get_free_memory() - initial;
+    state.ResumeTiming();
+  }
+  ::remove(former_path);
+  state.counters["bytes_per_metric"] = static_cast<double>(used) / count;
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_former_layout_metric_size)->Arg(10000)->Arg(100000);
+
+/* A reader takes the lock, gets a metric and reads its name and unit. */
+static void BM_global_cache_lookup(benchmark::State& state) {
+  const size_t count = state.range(0);
+  global_cache::unload();
+  ::remove(cache_path);
+  global_cache::pointer cache = global_cache::load(cache_path, file_size);
+  fill_global_cache(count);
+
+  uint64_t metric_id = 0;
+  size_t length = 0;
+  for (auto _ : state) {
+    global_cache::lock l;
+    const metric_info* info = cache->get_metric_info(metric_id);
+    length += info->name->length() + info->unit->length();
+    metric_id = (metric_id + 7919) % count;
+  }
+  benchmark::DoNotOptimize(length);
+  cache.reset();
+  global_cache::unload();
+  ::remove(cache_path);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_global_cache_lookup)->Arg(10000)->Arg(100000);
+
+static void BM_former_layout_lookup(benchmark::State& state) {
+  const size_t count = state.range(0);
+  ::remove(former_path);
+  interprocess::managed_mapped_file file(interprocess::create_only,
+                                         former_path, file_size);
+  fill_former_layout(file, count);
+  const auto* metrics =
+      file.find<former_id_to_metric_info>("metric_info").first;
+  absl::Mutex protect;
+
+  uint64_t metric_id = 0;
+  size_t length = 0;
+  for (auto _ : state) {
+    absl::ReaderMutexLock l(&protect);
+    const former_metric_info& info = *metrics->find(metric_id)->second;
+    length += info.name.length() + info.unit.length();
+    metric_id = (metric_id + 7919) % count;
+  }
+  benchmark::DoNotOptimize(length);
+  ::remove(former_path);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_former_layout_lookup)->Arg(10000)->Arg(100000);
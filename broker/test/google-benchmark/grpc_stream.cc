@@ -0,0 +1,83 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/grpc/acceptor.hh"
+#include "com/centreon/broker/grpc/connector.hh"
+#include "com/centreon/broker/io/raw.hh"
+
+using namespace com::centreon::broker;
+using com::centreon::broker::grpc::acceptor;
+using com::centreon::broker::grpc::connector;
+using com::centreon::broker::grpc::grpc_config;
+
+/**
+ * @brief Client to server transfer of range(1) events of 100 bytes on a
+ * local gRPC stream. range(0) is batch_max_events given to both peers, 0
+ * for one event per message.
+ */
+static void BM_grpc_client_to_server(benchmark::State& state) {
+  const uint32_t batch_max_events = state.range(0);
+  const int64_t nb_events = state.range(1);
+  auto conf = std::make_shared<grpc_config>(
+      "127.0.0.1:4460", false, "", "", "", "", "", false, 30, false,
+      batch_max_events, 1024 * 1024, 0);
+
+  acceptor server(conf);
+  connector conn(conf);
+  std::shared_ptr<io::stream> client = conn.open();
+  std::shared_ptr<io::stream> accepted = server.open();
+  if (!client || !accepted) {
+    state.SkipWithError("cannot open the gRPC streams");
+    return;
+  }
+
+  const std::vector<char> payload(100, 'a');
+  for (auto _ : state) {
+    std::thread writer([&client, &payload, nb_events] {
+      for (int64_t i = 0; i < nb_events; ++i) {
+        auto evt = std::make_shared<io::raw>();
+        evt->_buffer = payload;
+        client->write(evt);
+      }
+    });
+    int64_t received = 0;
+    for (; received < nb_events; ++received) {
+      std::shared_ptr<io::data> d;
+      if (!accepted->read(d, time(nullptr) + 5))
+        break;
+    }
+    writer.join();
+    if (received < nb_events) {
+      state.SkipWithError("events lost during the transfer");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nb_events);
+
+  client->wait_for_all_events_written(1000);
+  client->stop();
+  accepted->stop();
+}
+BENCHMARK(BM_grpc_client_to_server)
+    ->Args({0, 10000})
+    ->Args({64, 10000})
+    ->Args({256, 10000})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
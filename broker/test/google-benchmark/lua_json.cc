@@ -0,0 +1,91 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+#include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/lua/luabinding.hh"
+#include "com/centreon/broker/neb/events.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+/**
+ * @brief json encoding of pb_service events by a Lua stream connector.
+ * range(0) is the number of events given at once to json_encode_batch(), 1
+ * means that each event is encoded alone by json_encode().
+ */
+static void BM_lua_json_encode(benchmark::State& state) {
+  const int batch = state.range(0);
+  config::applier::modules modules(log_v2::instance().get(log_v2::LUA));
+  modules.load_file("./broker/neb/10-neb.so");
+
+  const std::string filename("/tmp/bench_json_encode.lua");
+  {
+    std::ofstream script(filename);
+    script << fmt::format(
+        "local queue = {{}}\n"
+        "function init(conf)\n"
+        "end\n\n"
+        "function write(d)\n"
+        "  if {0} == 1 then\n"
+        "    broker.json_encode(d)\n"
+        "  else\n"
+        "    queue[#queue + 1] = d\n"
+        "    if #queue == {0} then\n"
+        "      broker.json_encode_batch(queue)\n"
+        "      queue = {{}}\n"
+        "    end\n"
+        "  end\n"
+        "  return true\n"
+        "end\n",
+        batch);
+  }
+
+  auto pcache = std::make_shared<persistent_cache>(
+      "/tmp/bench_json_encode_cache", log_v2::instance().get(log_v2::LUA));
+  macro_cache cache(pcache);
+  std::map<std::string, misc::variant> conf;
+  auto binding = std::make_unique<lua::luabinding>(filename, conf, cache);
+
+  std::vector<std::shared_ptr<io::data>> events;
+  events.reserve(1000);
+  for (int i = 0; i < 1000; ++i) {
+    auto svc = std::make_shared<neb::pb_service>();
+    auto& obj = svc->mut_obj();
+    obj.set_host_id(1 + i / 50);
+    obj.set_service_id(i);
+    obj.set_description(fmt::format("service \"{}\"", i));
+    obj.set_output(fmt::format("OK - all is fine\nline {}", i));
+    obj.set_perfdata("rta=0.1ms;100;200;0 pl=0%;20;50;0;100");
+    events.push_back(std::move(svc));
+  }
+
+  for (auto _ : state)
+    for (auto& e : events)
+      binding->write(e);
+  state.SetItemsProcessed(state.iterations() * events.size());
+
+  binding.reset();
+  ::remove(filename.c_str());
+  ::remove("/tmp/bench_json_encode_cache");
+}
+BENCHMARK(BM_lua_json_encode)->Arg(1)->Arg(10)->Arg(100);
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/common/pool.hh"
+#include "common/log_v2/log_v2.hh"
+
+using com::centreon::common::log_v2::log_v2;
+
+std::shared_ptr<asio::io_context> g_io_context =
+    std::make_shared<asio::io_context>();
+
+/**
+ *  Benchmarks entry point. The broker structures are loaded once for all the
+ *  benchmarks.
+ *
+ *  @param[in] argc  Argument count.
+ *  @param[in] argv  Argument values.
+ *
+ *  @return 0 on success, any other value on failure.
+ */
+int main(int argc, char* argv[]) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  log_v2::load("bench");
+  com::centreon::common::pool::load(g_io_context,
+                                    log_v2::instance().get(log_v2::CORE));
+  com::centreon::common::pool::set_pool_size(0);
+  com::centreon::broker::config::applier::init(0, "bench", 0);
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  com::centreon::broker::config::applier::deinit();
+  spdlog::shutdown();
+  g_io_context->stop();
+  com::centreon::common::pool::unload();
+  return 0;
+}
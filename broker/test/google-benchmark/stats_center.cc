@@ -0,0 +1,54 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <benchmark/benchmark.h>
+
+#include "com/centreon/broker/stats/center.hh"
+
+using namespace com::centreon::broker;
+
+/* The statistic updated by all the threads of the benchmarks below. */
+static EngineStats* engine_stats = nullptr;
+static uint64_t locked_total = 0;
+static stats::counter sharded_counter;
+
+/* Every update locks the center mutex, as before the sharded counters. */
+static void BM_center_execute(benchmark::State& state) {
+  auto center = stats::center::instance_ptr();
+  if (state.thread_index() == 0) {
+    engine_stats = center->register_engine();
+    locked_total = 0;
+  }
+  for (auto _ : state) {
+    center->execute([] {
+      ++locked_total;
+      engine_stats->set_queue_size(locked_total);
+    });
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_center_execute)->Threads(1)->Threads(4)->Threads(16);
+
+/* Every update is an atomic addition on the shard of the thread. */
+static void BM_sharded_counter(benchmark::State& state) {
+  for (auto _ : state)
+    sharded_counter.add();
+  benchmark::DoNotOptimize(sharded_counter.get());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_sharded_counter)->Threads(1)->Threads(4)->Threads(16);
@@ -127,7 +127,7 @@ void request::append_metric_info(const Metric& metric) {
   const cache::metric_info* metric_inf =
       cache::global_cache::instance_ptr()->get_metric_info(metric.metric_id());
   if (metric_inf) {
-    absl::StrAppend(&body(), _sz_unit, string_filter(metric_inf->unit));
+    absl::StrAppend(&body(), _sz_unit, string_filter(*metric_inf->unit));
     const cache::resource_info* res_info =
         cache::global_cache::instance_ptr()->get_service(metric.host_id(),
                                                          metric.service_id());
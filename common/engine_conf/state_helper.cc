@@ -217,6 +217,7 @@ void state_helper::_init() {
   obj->set_admin_email("");
   obj->set_admin_pager("");
   obj->set_allow_empty_hostgroup_assignment(false);
+  obj->set_async_system_commands(true);
   obj->set_auto_reschedule_checks(false);
   obj->set_auto_rescheduling_interval(30);
   obj->set_auto_rescheduling_window(180);
@@ -227,6 +228,7 @@ void state_helper::_init() {
   obj->set_check_orphaned_hosts(true);
   obj->set_check_orphaned_services(true);
   obj->set_check_reaper_interval(10);
+  obj->set_check_reaper_threads(0);
   obj->set_check_service_freshness(true);
   obj->set_command_check_interval(-1);
   obj->set_command_file(DEFAULT_COMMAND_FILE);
@@ -271,6 +273,7 @@ void state_helper::_init() {
   obj->set_max_host_check_spread(5);
   obj->set_max_log_file_size(0);
   obj->set_max_parallel_service_checks(0);
+  obj->set_max_parallel_system_commands(10);
   obj->set_max_service_check_spread(5);
   obj->set_notification_timeout(30);
   obj->set_obsess_over_hosts(false);
@@ -301,6 +304,7 @@ void state_helper::_init() {
   obj->set_state_retention_file(DEFAULT_RETENTION_FILE);
   obj->set_status_file(DEFAULT_STATUS_FILE);
   obj->set_status_update_interval(60);
+  obj->set_status_file_incremental(false);
   obj->set_time_change_threshold(900);
   obj->set_use_large_installation_tweaks(false);
   obj->set_instance_heartbeat_interval(30);
@@ -327,6 +331,7 @@ void state_helper::_init() {
   obj->set_log_level_runtime(LogLevel::error);
   obj->set_use_timezone("");
   obj->set_use_true_regexp_matching(false);
+  obj->set_stats_shm_name("");
 }
 
 /**
@@ -281,6 +281,12 @@ void state::_init_setter() {
          "send_recovery_notifications_anyways");
   SETTER(bool, use_host_down_disable_service_checks,
          "host_down_disable_service_checks");
+  SETTER(bool, status_file_incremental, "status_file_incremental");
+  SETTER(const std::string&, stats_shm_name, "stats_shm_name");
+  SETTER(uint32_t, check_reaper_threads, "check_reaper_threads");
+  SETTER(uint32_t, max_parallel_system_commands,
+         "max_parallel_system_commands");
+  SETTER(bool, async_system_commands, "async_system_commands");
 }
 
 // Default values.
@@ -375,6 +381,7 @@ static bool const default_soft_state_dependencies(false);
 static std::string const default_state_retention_file(DEFAULT_RETENTION_FILE);
 static std::string const default_status_file(DEFAULT_STATUS_FILE);
 static unsigned int const default_status_update_interval(60);
+static bool const default_status_file_incremental(false);
 static unsigned int const default_time_change_threshold(900);
 static bool const default_use_large_installation_tweaks(false);
 static uint32_t const default_instance_heartbeat_interval(30);
@@ -403,6 +410,10 @@ static std::string const default_log_level_otl("error");
 static std::string const default_use_timezone("");
 static bool const default_use_true_regexp_matching(false);
 static const std::string default_rpc_listen_address("localhost");
+static std::string const default_stats_shm_name("");
+static uint32_t const default_check_reaper_threads(0);
+static uint32_t const default_max_parallel_system_commands(10);
+static bool const default_async_system_commands(true);
 
 /**
  *  Default constructor.
@@ -538,7 +549,12 @@ state::state()
       _use_timezone(default_use_timezone),
       _use_true_regexp_matching(default_use_true_regexp_matching),
       _send_recovery_notifications_anyways(false),
-      _host_down_disable_service_checks(false) {
+      _host_down_disable_service_checks(false),
+      _status_file_incremental(default_status_file_incremental),
+      _stats_shm_name(default_stats_shm_name),
+      _check_reaper_threads(default_check_reaper_threads),
+      _max_parallel_system_commands(default_max_parallel_system_commands),
+      _async_system_commands(default_async_system_commands) {
   static absl::once_flag _init_call_once;
   absl::call_once(_init_call_once, _init_setter);
 }
@@ -705,6 +721,11 @@ state& state::operator=(state const& right) {
     _send_recovery_notifications_anyways =
         right._send_recovery_notifications_anyways;
     _host_down_disable_service_checks = right._host_down_disable_service_checks;
+    _status_file_incremental = right._status_file_incremental;
+    _stats_shm_name = right._stats_shm_name;
+    _check_reaper_threads = right._check_reaper_threads;
+    _max_parallel_system_commands = right._max_parallel_system_commands;
+    _async_system_commands = right._async_system_commands;
   }
   return *this;
 }
@@ -857,7 +878,12 @@ bool state::operator==(state const& right) const noexcept {
       _send_recovery_notifications_anyways ==
           right._send_recovery_notifications_anyways &&
       _host_down_disable_service_checks ==
-          right._host_down_disable_service_checks);
+          right._host_down_disable_service_checks &&
+      _status_file_incremental == right._status_file_incremental &&
+      _stats_shm_name == right._stats_shm_name &&
+      _check_reaper_threads == right._check_reaper_threads &&
+      _max_parallel_system_commands == right._max_parallel_system_commands &&
+      _async_system_commands == right._async_system_commands);
 }
 
 /**
@@ -4223,6 +4249,104 @@ void state::use_host_down_disable_service_checks(bool value) {
   _host_down_disable_service_checks = value;
 }
 
+/**
+ * @brief when this flag is set, the status file only serializes again hosts
+ * and services whose status changed since the previous dump, and the file is
+ * written by a background thread.
+ *
+ * @return true if the incremental status file writer is enabled.
+ */
+bool state::status_file_incremental() const noexcept {
+  return _status_file_incremental;
+}
+
+/**
+ * @brief set the status_file_incremental flag.
+ *
+ * @param value
+ */
+void state::status_file_incremental(bool value) {
+  _status_file_incremental = value;
+}
+
+/**
+ * @brief Name of the shared memory segment where centengine publishes its
+ * statistics (empty to disable).
+ *
+ * @return The stats_shm_name value.
+ */
+const std::string& state::stats_shm_name() const noexcept {
+  return _stats_shm_name;
+}
+
+/**
+ * @brief Set the name of the statistics shared memory segment.
+ *
+ * @param value The new stats_shm_name value.
+ */
+void state::stats_shm_name(const std::string& value) {
+  _stats_shm_name = value;
+}
+
+/**
+ * @brief Get the number of threads used to parse the output of check results
+ * while the main loop handles them (0 to disable).
+ *
+ * @return The check_reaper_threads value.
+ */
+uint32_t state::check_reaper_threads() const noexcept {
+  return _check_reaper_threads;
+}
+
+/**
+ * @brief Set the number of threads used to parse the output of check results.
+ *
+ * @param value The new check_reaper_threads value.
+ */
+void state::check_reaper_threads(uint32_t value) {
+  _check_reaper_threads = value;
+}
+
+/**
+ * @brief Get the maximum number of notification, event handler or obsessive
+ * commands of each kind running at the same time (0 for no limit).
+ *
+ * @return The max_parallel_system_commands value.
+ */
+uint32_t state::max_parallel_system_commands() const noexcept {
+  return _max_parallel_system_commands;
+}
+
+/**
+ * @brief Set the maximum number of system commands of each kind running at
+ * the same time.
+ *
+ * @param value The new max_parallel_system_commands value.
+ */
+void state::max_parallel_system_commands(uint32_t value) {
+  _max_parallel_system_commands = value;
+}
+
+/**
+ * @brief Get if notification, event handler and obsessive commands run in
+ * background. If not, the main loop waits for each of them as it used to.
+ *
+ * @return The async_system_commands value.
+ */
+bool state::async_system_commands() const noexcept {
+  return _async_system_commands;
+}
+
+/**
+ * @brief Set if notification, event handler and obsessive commands run in
+ * background.
+ *
+ * @param value The new async_system_commands value.
+ */
+void state::async_system_commands(bool value) {
+  _async_system_commands = value;
+}
+
 /**
  * @brief modify state according json passed in parameter
  *
@@ -444,6 +444,16 @@ class state {
   void use_send_recovery_notifications_anyways(bool value);
   bool use_host_down_disable_service_checks() const;
   void use_host_down_disable_service_checks(bool value);
+  bool status_file_incremental() const noexcept;
+  void status_file_incremental(bool value);
+  const std::string& stats_shm_name() const noexcept;
+  void stats_shm_name(const std::string& value);
+  uint32_t check_reaper_threads() const noexcept;
+  void check_reaper_threads(uint32_t value);
+  uint32_t max_parallel_system_commands() const noexcept;
+  void max_parallel_system_commands(uint32_t value);
+  bool async_system_commands() const noexcept;
+  void async_system_commands(bool value);
 
   using setter_map =
       absl::flat_hash_map<std::string_view, std::unique_ptr<setter_base>>;
@@ -612,6 +622,11 @@ class state {
   bool _use_true_regexp_matching;
   bool _send_recovery_notifications_anyways;
   bool _host_down_disable_service_checks;
+  bool _status_file_incremental;
+  std::string _stats_shm_name;
+  uint32_t _check_reaper_threads;
+  uint32_t _max_parallel_system_commands;
+  bool _async_system_commands;
 };
 
 }  // namespace com::centreon::engine::configuration
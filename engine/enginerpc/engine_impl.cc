@@ -121,9 +121,16 @@ grpc::Status engine_impl::GetStats(grpc::ServerContext* context
                                    const GenericString* request
                                    [[maybe_unused]],
                                    Stats* response) {
-  auto fn = std::packaged_task<int(void)>(
-      std::bind(&command_manager::get_stats, &command_manager::instance(),
-                request->str_arg(), response));
+  /* On explicit request, the statistics published in shared memory are
+   * directly read from there, the main loop is not involved. They are those
+   * of the last status update. */
+  const bool shm = request->str_arg() == "shm";
+  if (shm && command_manager::instance().get_shared_stats(response))
+    return grpc::Status::OK;
+
+  auto fn = std::packaged_task<int(void)>(std::bind(
+      &command_manager::get_stats, &command_manager::instance(),
+      shm ? std::string("default") : request->str_arg(), response));
   std::future<int32_t> result = fn.get_future();
   command_manager::instance().enqueue(std::move(fn));
   int32_t res = result.get();
@@ -19,9 +19,11 @@
 #ifndef CCE_ANOMALYDETECTION_HH
 #define CCE_ANOMALYDETECTION_HH
 
+#include <sys/stat.h>
 #include <map>
 #include <mutex>
 
+#include <absl/container/flat_hash_map.h>
 #include <rapidjson/document.h>
 #include <tuple>
 
@@ -60,18 +62,64 @@ class anomalydetection : public service {
                               const threshold_point& left) const;
   };
 
+  using threshold_point_map = std::map<time_t, threshold_point>;
+
+  /**
+   * @brief Thresholds of one metric as read in a thresholds file. Once built,
+   * a series is never modified, it is shared by the thresholds store and the
+   * anomaly detection service. Points are computed with the sensitivity of
+   * the file, the one of the service is applied on the interpolated point.
+   */
+  struct threshold_series {
+    double sensitivity;
+    threshold_point_map points;
+  };
+  using threshold_series_ptr = std::shared_ptr<const threshold_series>;
+
+  /**
+   * @brief Process-wide cache of parsed thresholds files. Each file is parsed
+   * once and its series are indexed by (host_id, service_id, metric_name).
+   * A file is parsed again only if it has changed on disk or if a reload is
+   * forced.
+   */
+  class thresholds_store {
+   public:
+    using key = std::tuple<uint64_t, uint64_t, std::string>;
+    using index = absl::flat_hash_map<key, threshold_series_ptr>;
+    using index_ptr = std::shared_ptr<const index>;
+
+   private:
+    struct file_entry {
+      dev_t dev;
+      ino_t ino;
+      off_t size;
+      struct timespec mtime;
+      struct timespec ctime;
+      index_ptr idx;
+    };
+    std::mutex _m;
+    absl::flat_hash_map<std::string, file_entry> _files;
+
+    static index_ptr _parse(const std::string& filename);
+
+   public:
+    static thresholds_store& instance();
+    index_ptr get(const std::string& filename, bool force_reload = false);
+    void clear();
+  };
+
  protected:
   service* _dependent_service;
   uint64_t _internal_id;
   std::string _metric_name;
   std::string _thresholds_file;
   bool _status_change;
-  bool _thresholds_file_viable;
   double _sensitivity;
   uint64_t _dependent_service_id;
 
-  using threshold_point_map = std::map<time_t, threshold_point>;
-  threshold_point_map _thresholds;
+  /* Only accessed through std::atomic_load/std::atomic_store, a new series is
+   * swapped in when the thresholds file is reloaded. */
+  threshold_series_ptr _thresholds;
   std::mutex _thresholds_m;
 
  public:
@@ -120,12 +168,11 @@ class anomalydetection : public service {
   void set_metric_name(std::string const& name);
   void set_thresholds_file(std::string const& file);
 
-  void set_thresholds_lock(const std::string& filename,
-                           double json_sensitivity,
-                           const rapidjson::Value& thresholds);
-  void set_thresholds_no_lock(const std::string& filename,
-                              double json_sensitivity,
-                              const rapidjson::Value& thresholds);
+  void set_thresholds(const std::string& filename,
+                      const threshold_series_ptr& series);
+  threshold_series_ptr get_thresholds() const {
+    return std::atomic_load(&_thresholds);
+  }
 
   void set_sensitivity(double sensitivity);
   double get_sensitivity() const { return _sensitivity; }
@@ -137,8 +184,7 @@ class anomalydetection : public service {
                               bool reschedule_check,
                               bool* time_is_valid,
                               time_t* preferred_time) noexcept override;
-  int handle_async_check_result(
-      const check_result& queued_check_result) override;
+  int handle_async_check_result(check_result& queued_check_result) override;
   bool parse_perfdata(std::string const& perfdata,
                       time_t check_time,
                       check_result& calculated_result);
@@ -77,6 +77,19 @@ class check_result {
   inline unsigned get_check_options() const { return _check_options; };
   void set_check_options(unsigned check_options);
 
+  bool parse_output();
+  void take_parsed_output(std::string& plugin_output,
+                          std::string& long_plugin_output,
+                          std::string& perf_data);
+  inline bool is_output_parsed() const {
+    return _output_state.load(std::memory_order_acquire) == output_parsed;
+  }
+  inline const std::string& get_plugin_output() const { return _plugin_output; }
+  inline const std::string& get_long_plugin_output() const {
+    return _long_plugin_output;
+  }
+  inline const std::string& get_perf_data() const { return _perf_data; }
+
  private:
   enum check_source _object_check_type;  // is this a service or a host check?
   notifier* _notifier;
@@ -91,6 +104,19 @@ class check_result {
   bool _exited_ok;              // did the plugin check return okay?
   int _return_code;             // plugin return code
   std::string _output;          // plugin output
+  /* Output split by parse_output() on a check reaper worker, so that it is
+   * not parsed again by the notifier. The state tells who owns these strings:
+   * the worker while it is parsing, the main loop once it took them. */
+  enum output_state : uint8_t {
+    output_raw,
+    output_parsing,
+    output_parsed,
+    output_taken
+  };
+  std::atomic<uint8_t> _output_state;
+  std::string _plugin_output;
+  std::string _long_plugin_output;
+  std::string _perf_data;
 };
 
 std::ostream& operator<<(std::ostream& stream, const check_result& res);
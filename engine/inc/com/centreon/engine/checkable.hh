@@ -103,6 +103,9 @@ class checkable {
   commands::command* _event_handler_ptr;
   std::shared_ptr<commands::command> _check_command_ptr;
   bool _is_executing;
+  /* Set when the status of this object changed since the last status.dat
+   * dump. Only used by the incremental status file writer. */
+  bool _status_dirty;
   std::shared_ptr<severity> _severity;
   uint64_t _icon_id;
   std::forward_list<std::shared_ptr<tag>> _tags;
@@ -254,6 +257,8 @@ class checkable {
   }
   bool get_is_executing() const;
   void set_is_executing(bool is_executing);
+  bool get_status_dirty() const;
+  void set_status_dirty(bool status_dirty);
   void set_severity(std::shared_ptr<severity> sv);
   const std::shared_ptr<severity>& get_severity() const;
   void set_icon_id(uint64_t icon_id);
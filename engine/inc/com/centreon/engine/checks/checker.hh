@@ -30,7 +30,8 @@ namespace com::centreon::engine::checks {
  *  @brief Run object and reap the result.
  *
  *  Checker is a singleton to run host or service and reap the
- *  result.
+ *  result. Results are handled on the main loop, only the parsing of their
+ *  outputs can be done by worker threads (check_reaper_threads).
  */
 class checker : public commands::command_listener {
   static checker* _instance;
@@ -50,6 +51,8 @@ class checker : public commands::command_listener {
   void add_check_result(uint64_t id,
                         const check_result::pointer result) noexcept;
   void add_check_result_to_reap(const check_result::pointer result) noexcept;
+  void add_check_results_to_reap(
+      std::vector<check_result::pointer>& results) noexcept;
   static void forget(notifier* n) noexcept;
 
   enum class e_completion_filter { all, service, host };
@@ -66,6 +69,10 @@ class checker : public commands::command_listener {
   checker& operator=(checker const& right);
   void finished(commands::result const& res) noexcept override;
   host::host_state _execute_sync(host* hst);
+  void _set_prepare_threads(uint32_t count);
+  void _prepare_worker();
+  void _dispatch_results();
+  void _drop_dispatched_results();
 
   /* A mutex to protect access on _waiting_check_result and _to_reap_partial */
   mutable std::mutex _mut_reap;
@@ -87,6 +94,16 @@ class checker : public commands::command_listener {
    * that should be forgotten if notifiers are removed. */
   std::deque<notifier*> _to_forget;
 
+  /*
+   * Workers parsing the outputs of check results while the main loop handles
+   * them. They share one queue. Their count is given by the
+   * check_reaper_threads setting, there is none by default. */
+  std::vector<std::thread> _prepare_threads;
+  std::mutex _prepare_m;
+  std::condition_variable _prepare_cv;
+  std::deque<check_result::pointer> _prepare_queue;
+  bool _prepare_exit;
+
   /**
    * used only for test in order to wait for completion
    */
@@ -52,6 +52,7 @@ class command_manager {
                                  uint32_t return_code,
                                  const std::string& output);
   int get_stats(std::string const& request, Stats* response);
+  bool get_shared_stats(Stats* response) const;
   int get_restart_stats(RestartStats* response);
   int get_services_stats(ServicesStats* sstats);
   int get_hosts_stats(HostsStats* hstats);
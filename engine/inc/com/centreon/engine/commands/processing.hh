@@ -48,6 +48,10 @@ class processing {
  public:
   static bool execute(std::string const& cmd);
   static bool is_thread_safe(char const* cmd);
+  static bool is_passive_check_result(std::string_view cmd);
+  static size_t execute_passive_check_results(
+      const std::vector<std::string_view>& cmds);
+  static void invalidate_passive_check_cache();
 
   static void wrapper_enable_host_and_child_notifications(host* hst);
   static void wrapper_disable_host_and_child_notifications(host* hst);
@@ -36,6 +36,8 @@ class environment;
  *  Raw is a specific implementation of command.
  */
 class raw : public command, public process_listener {
+  friend class system_executor;
+
   std::unordered_map<process*, uint64_t> _processes_busy;
   std::deque<process*> _processes_free;
 
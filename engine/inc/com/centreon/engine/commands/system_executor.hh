@@ -0,0 +1,125 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_COMMANDS_SYSTEM_EXECUTOR_HH
+#define CCE_COMMANDS_SYSTEM_EXECUTOR_HH
+
+#include "com/centreon/engine/commands/environment.hh"
+#include "com/centreon/engine/commands/result.hh"
+#include "com/centreon/engine/macros/defines.hh"
+#include "com/centreon/process.hh"
+#include "com/centreon/process_listener.hh"
+
+namespace com::centreon::engine::commands {
+
+/**
+ *  @class system_executor system_executor.hh
+ *  @brief Asynchronous execution of notifications, event handlers and
+ *  obsessive commands.
+ *
+ *  These commands used to be executed by my_system_r() that waits for the
+ *  process end on the main loop. Here, run() only starts the process (or
+ *  queues the command if too many commands of the same kind are running) and
+ *  returns. The environment is built from the macros when run() is called,
+ *  so a queued command does not need them anymore.
+ *
+ *  Processes end in the process manager thread, their results are stored
+ *  and handled by reap(), called from the main loop: the broker callbacks,
+ *  the logs and the completion callback given to run() are executed there,
+ *  as before. Queued commands are also started by reap().
+ *
+ *  There is one queue per kind of command, so a notification storm does not
+ *  delay event handlers. The number of running commands of each kind is
+ *  limited by the max_parallel_system_commands setting (0 for no limit).
+ *  Obsessive commands (OCSP/OCHP) are run one at a time, in the order of the
+ *  check results they are about, as their consumers expect.
+ *
+ *  With the async_system_commands setting set to false, run() waits for the
+ *  end of the command and calls its callback before returning, as
+ *  my_system_r() did.
+ */
+class system_executor : public process_listener {
+ public:
+  enum kind { notification = 0, event_handler, obsessive, kinds_count };
+  using callback = std::function<void(const result&)>;
+  /* Time given to the queued commands to be executed at shutdown. */
+  static constexpr std::chrono::milliseconds shutdown_wait{30000};
+
+ private:
+  static system_executor* _instance;
+
+  struct job {
+    kind type;
+    std::string cmd;
+    uint32_t timeout;
+    environment env;
+    callback on_finished;
+    uint64_t command_id;
+    timeval start_time;
+    result res;
+  };
+
+  /* Only used by the main loop. */
+  std::array<std::deque<std::unique_ptr<job>>, kinds_count> _waiting;
+  std::array<uint32_t, kinds_count> _running_count;
+  std::deque<std::unique_ptr<process>> _free_processes;
+  uint64_t _next_id;
+
+  /* Shared with the process manager thread. */
+  mutable std::mutex _m;
+  std::condition_variable _cv;
+  absl::flat_hash_map<process*,
+                      std::pair<std::unique_ptr<process>, std::unique_ptr<job>>>
+      _running;
+  std::vector<process*> _finished;
+
+  system_executor();
+  bool _can_start(kind k) const;
+  process* _start(std::unique_ptr<job>&& j);
+  void _run_sync(std::unique_ptr<job>&& j);
+  void _complete(std::unique_ptr<process>&& p, std::unique_ptr<job>&& j);
+
+ public:
+  static system_executor& instance();
+  static void init();
+  static void deinit(std::chrono::milliseconds max_wait = shutdown_wait);
+
+  ~system_executor() noexcept;
+  system_executor(const system_executor&) = delete;
+  system_executor& operator=(const system_executor&) = delete;
+
+  void run(kind k,
+           const std::string& cmd,
+           nagios_macros& macros,
+           uint32_t timeout,
+           callback&& on_finished);
+  void reap();
+  void wait_completion();
+  bool wait_completion(std::chrono::steady_clock::time_point deadline);
+  size_t drop_waiting();
+  size_t running() const;
+  size_t waiting() const;
+
+  void data_is_available(process& p) noexcept override;
+  void data_is_available_err(process& p) noexcept override;
+  void finished(process& p) noexcept override;
+};
+
+}  // namespace com::centreon::engine::commands
+
+#endif  // !CCE_COMMANDS_SYSTEM_EXECUTOR_HH
@@ -28,14 +28,22 @@ namespace downtimes {
 
 class host_downtime;
 class service_downtime;
+/**
+ * @brief Store of the scheduled downtimes. Downtimes are kept in a multimap
+ * ordered by start time, and indexed by id, by host/service and by end time,
+ * so that the lookups done on each check result do not scan all the
+ * downtimes. All the modifications go through _index() and _unindex() to
+ * keep these indexes coherent.
+ */
 class downtime_manager {
  public:
+  using downtime_map = std::multimap<time_t, std::shared_ptr<downtime>>;
+
   static downtime_manager& instance() {
     static downtime_manager instance;
     return instance;
   }
-  std::multimap<time_t, std::shared_ptr<downtime>> const&
-  get_scheduled_downtimes() const;
+  downtime_map const& get_scheduled_downtimes() const;
 
   void delete_downtime(uint64_t downtime_id);
   int unschedule_downtime(uint64_t downtime_id);
@@ -93,7 +101,17 @@ class downtime_manager {
 
  private:
   downtime_manager() = default;
-  std::multimap<time_t, std::shared_ptr<downtime>> _scheduled_downtimes;
+  downtime_map::iterator _index(const std::shared_ptr<downtime>& dt);
+  downtime_map::iterator _unindex(downtime_map::iterator it);
+
+  downtime_map _scheduled_downtimes;
+  /* Indexes on _scheduled_downtimes. A host downtime is indexed in
+   * _downtimes_by_object with a null service_id. */
+  absl::flat_hash_map<uint64_t, downtime_map::iterator> _downtimes_by_id;
+  absl::flat_hash_map<std::pair<uint64_t, uint64_t>,
+                      std::vector<std::shared_ptr<downtime>>>
+      _downtimes_by_object;
+  std::multimap<time_t, uint64_t> _downtimes_by_end;
   uint64_t _next_id;
 };
 }  // namespace downtimes
@@ -79,6 +79,13 @@ class loop {
       return _event_list_high.end();
   }
 
+  size_t event_count(priority priority) const noexcept {
+    if (priority == low)
+      return _event_list_low.size();
+    else
+      return _event_list_high.size();
+  }
+
   void reschedule_event(std::unique_ptr<timed_event>&& event,
                         priority priority);
   void resort_event_list(priority priority);
@@ -93,4 +93,68 @@ enum verbosity_level { basic = 0u, more = 1u, most = 2u };
        ++__com_centreon_engine_logging_define_ui)                        \
   com::centreon::logging::temp_logger(type, verbose)
 
+/**
+ *  Unified logging front end, to use instead of an engine_logger() followed
+ *  by the same message sent to a spdlog logger.
+ *
+ *  Levels under SPDLOG_ACTIVE_LEVEL are removed at compile time (see
+ *  ENGINE_LOG_ACTIVE_LEVEL in CMakeLists.txt). Otherwise, the legacy and the
+ *  spdlog levels are checked first and arguments are only evaluated and
+ *  formatted, once, if at least one of them is enabled. So a disabled log
+ *  costs two bit tests and expensive arguments such as my_ctime() calls are
+ *  not computed.
+ *
+ *  @param[in] type     Legacy logging type (dbg_events, log_runtime_error...).
+ *  @param[in] verbose  Legacy verbosity.
+ *  @param[in] logger   spdlog logger (events_logger, checks_logger...).
+ *  @param[in] level    spdlog::level::level_enum.
+ *  @param[in] ...      fmt format string and its arguments.
+ */
+#define ENGINE_LOG(type, verbose, logger, level, ...)                       \
+  do {                                                                      \
+    if (static_cast<int>(level) >= SPDLOG_ACTIVE_LEVEL) {                   \
+      bool __engine_log_legacy =                                            \
+          com::centreon::logging::engine::instance().is_log(type, verbose); \
+      bool __engine_log_spd = (logger)->should_log(level);                  \
+      if (__engine_log_legacy || __engine_log_spd) {                        \
+        std::string __engine_log_msg = fmt::format(__VA_ARGS__);            \
+        if (__engine_log_legacy)                                            \
+          com::centreon::logging::temp_logger(type, verbose)                \
+              << __engine_log_msg;                                          \
+        if (__engine_log_spd)                                               \
+          (logger)->log(                                                    \
+              spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION},      \
+              level, __engine_log_msg);                                     \
+      }                                                                     \
+    }                                                                       \
+  } while (0)
+
+#define ENGINE_LOG_TRACE(type, verbose, logger, ...) \
+  ENGINE_LOG(type, verbose, logger, spdlog::level::trace, __VA_ARGS__)
+#define ENGINE_LOG_DEBUG(type, verbose, logger, ...) \
+  ENGINE_LOG(type, verbose, logger, spdlog::level::debug, __VA_ARGS__)
+#define ENGINE_LOG_INFO(type, verbose, logger, ...) \
+  ENGINE_LOG(type, verbose, logger, spdlog::level::info, __VA_ARGS__)
+#define ENGINE_LOG_WARN(type, verbose, logger, ...) \
+  ENGINE_LOG(type, verbose, logger, spdlog::level::warn, __VA_ARGS__)
+#define ENGINE_LOG_ERROR(type, verbose, logger, ...) \
+  ENGINE_LOG(type, verbose, logger, spdlog::level::err, __VA_ARGS__)
+
+/**
+ *  spdlog only logging. Unlike SPDLOG_LOGGER_*, arguments are not evaluated
+ *  when the logger level is not enabled.
+ */
+#define ENGINE_LOGGER(logger, level, ...)                                 \
+  do {                                                                    \
+    if (static_cast<int>(level) >= SPDLOG_ACTIVE_LEVEL &&                 \
+        (logger)->should_log(level))                                      \
+      (logger)->log(spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, \
+                    level, __VA_ARGS__);                                  \
+  } while (0)
+
+#define ENGINE_LOGGER_TRACE(logger, ...) \
+  ENGINE_LOGGER(logger, spdlog::level::trace, __VA_ARGS__)
+#define ENGINE_LOGGER_DEBUG(logger, ...) \
+  ENGINE_LOGGER(logger, spdlog::level::debug, __VA_ARGS__)
+
 #endif  // !CCE_LOGGING_LOGGER_HH
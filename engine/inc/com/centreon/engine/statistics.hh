@@ -22,6 +22,10 @@
 
 #include <sys/types.h>
 
+#include <shared_mutex>
+
+#include "com/centreon/engine/stats_shm.hh"
+
 struct buffer_stats {
   uint32_t used;
   uint32_t high;
@@ -30,12 +34,24 @@ struct buffer_stats {
 
 namespace com::centreon::engine {
 class statistics {
+  /* Shared memory segment where statistics are published, it is not open if
+   * stats_shm_name is empty. */
+  stats_shm _shm;
+  /* The segment is read by gRPC threads while the main loop may unmap it on
+   * reload or shutdown. read_shared_stats() and publish_shared_stats() take
+   * it shared, open_shared_stats() and close_shared_stats() exclusively. */
+  mutable std::shared_mutex _shm_m;
+
   statistics();
 
  public:
   static statistics& instance();
   pid_t get_pid() const noexcept;
   bool get_external_command_buffer_stats(buffer_stats& retval) const noexcept;
+  void open_shared_stats(const std::string& name);
+  void close_shared_stats() noexcept;
+  void publish_shared_stats();
+  bool read_shared_stats(shm_stats_data& data) const noexcept;
 };
 
 }
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#ifndef CCE_STATS_SHM_HH
+#define CCE_STATS_SHM_HH
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "com/centreon/engine/checks/stats.hh"
+
+namespace com::centreon::engine {
+
+/**
+ * @brief Latencies, execution times and state changes of active or passive
+ * checked objects.
+ */
+struct shm_check_type_stats {
+  double min_latency;
+  double max_latency;
+  double average_latency;
+  double min_execution_time;
+  double max_execution_time;
+  double average_execution_time;
+  double min_state_change;
+  double max_state_change;
+  double average_state_change;
+  uint32_t checks_last_1min;
+  uint32_t checks_last_5min;
+  uint32_t checks_last_15min;
+  uint32_t checks_last_1hour;
+};
+
+/**
+ * @brief Aggregated statistics about hosts or services. The states array is
+ * indexed by the host/service state (up/down/unreachable or
+ * ok/warning/critical/unknown).
+ */
+struct shm_object_stats {
+  uint32_t count;
+  uint32_t checked;
+  uint32_t scheduled;
+  uint32_t actively_checked;
+  uint32_t passively_checked;
+  double min_state_change;
+  double max_state_change;
+  double average_state_change;
+  shm_check_type_stats active;
+  shm_check_type_stats passive;
+  uint32_t states[4];
+  uint32_t flapping;
+  uint32_t downtime;
+};
+
+/**
+ * @brief The statistics published by centengine. This structure is copied as
+ * is in the shared memory segment, so it must only contain trivially
+ * copyable members and each modification of its layout must be followed by
+ * an increment of stats_shm::version.
+ */
+struct shm_stats_data {
+  int64_t last_update;
+  uint32_t pid;
+  int64_t program_start;
+  int64_t last_command_check;
+  int64_t last_log_rotation;
+  uint32_t modified_host_attributes;
+  uint32_t modified_service_attributes;
+  uint8_t enable_notifications;
+  uint8_t active_service_checks_enabled;
+  uint8_t passive_service_checks_enabled;
+  uint8_t active_host_checks_enabled;
+  uint8_t passive_host_checks_enabled;
+  uint8_t enable_event_handlers;
+  uint8_t obsess_over_services;
+  uint8_t obsess_over_hosts;
+  uint8_t check_service_freshness;
+  uint8_t check_host_freshness;
+  uint8_t enable_flap_detection;
+  uint8_t process_performance_data;
+  /* Global event handler names, truncated if too long. */
+  char global_host_event_handler[256];
+  char global_service_event_handler[256];
+  uint64_t next_comment_id;
+  uint64_t next_event_id;
+  uint64_t next_problem_id;
+  uint64_t next_notification_id;
+  uint32_t used_external_command_buffer_slots;
+  uint32_t high_external_command_buffer_slots;
+  uint32_t total_external_command_buffer_slots;
+  /* Queue depths. */
+  uint32_t check_results_to_reap;
+  uint32_t high_priority_events;
+  uint32_t low_priority_events;
+  /* check_statistics minute stats (1, 5, 15 minutes). */
+  int32_t check_stats[MAX_CHECK_STATS_TYPES][3];
+  shm_object_stats hosts;
+  shm_object_stats services;
+};
+
+/**
+ * @class stats_shm stats_shm.hh "com/centreon/engine/stats_shm.hh"
+ * @brief Shared memory segment used by centengine to publish its statistics.
+ *
+ * centengine is the only writer, it opens the segment with create() and
+ * updates it in place with publish(). Readers (centenginestats, the gRPC
+ * server) call read() that never blocks the writer: the segment is protected
+ * by a sequence counter, odd while an update is in progress, and a reader
+ * retries its copy until it gets a stable even value.
+ */
+class stats_shm {
+ public:
+  static constexpr uint32_t magic = 0x43454e53;  // "CENS"
+  static constexpr uint32_t version = 1;
+
+ private:
+  struct segment {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t data_size;
+    std::atomic<uint64_t> sequence;
+    shm_stats_data data;
+  };
+
+  std::string _name;
+  segment* _segment;
+  bool _owner;
+
+ public:
+  stats_shm();
+  ~stats_shm() noexcept;
+  stats_shm(const stats_shm&) = delete;
+  stats_shm& operator=(const stats_shm&) = delete;
+
+  bool create(const std::string& name);
+  bool open(const std::string& name);
+  void close() noexcept;
+  bool is_open() const noexcept { return _segment != nullptr; }
+  const std::string& name() const noexcept { return _name; }
+
+  void publish(const shm_stats_data& data) noexcept;
+  bool read(shm_stats_data& data) const noexcept;
+};
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_STATS_SHM_HH
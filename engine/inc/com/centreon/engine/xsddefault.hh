@@ -28,6 +28,7 @@ extern "C" {
 int xsddefault_initialize_status_data();
 int xsddefault_cleanup_status_data(int delete_status_data);
 int xsddefault_save_status_data();
+void xsddefault_invalidate_status_data();
 
 #ifdef __cplusplus
 }
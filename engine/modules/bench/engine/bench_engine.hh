@@ -0,0 +1,34 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CCE_BENCH_ENGINE_BENCH_ENGINE_HH
+#define CCE_BENCH_ENGINE_BENCH_ENGINE_HH
+
+#include "test_engine.hh"
+
+/**
+ * @brief Gives access to the configuration helpers of the unit tests from a
+ * benchmark, the fixture is never run by gtest.
+ */
+class BenchEngine : public TestEngine {
+ public:
+  void TestBody() override {}
+};
+
+#endif  // !CCE_BENCH_ENGINE_BENCH_ENGINE_HH
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench_engine.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include "com/centreon/engine/downtimes/service_downtime.hh"
+#include "helper.hh"
+#include "timeperiod/utils.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::downtimes;
+
+namespace {
+/**
+ * @brief One host test_host with one service test_svc (12, 8), and no
+ * downtime.
+ */
+class DowntimeManagerBench : public BenchEngine {
+ public:
+  void setup() {
+    init_config_state();
+
+    configuration::error_cnt err;
+    configuration::applier::contact ct_aply;
+    configuration::Contact ctct{new_pb_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(pb_config);
+    ct_aply.resolve_object(ctct, err);
+
+    configuration::Host hst{new_pb_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+
+    configuration::Service svc{
+        new_pb_configuration_service("test_host", "test_svc", "admin", 8)};
+    configuration::applier::service svc_aply;
+    svc_aply.add_object(svc);
+
+    hst_aply.resolve_object(hst, err);
+    svc_aply.resolve_object(svc, err);
+
+    svc_ptr = service::services_by_id.find({12, 8})->second;
+    downtime_manager::instance().clear_scheduled_downtimes();
+    downtime_manager::instance().initialize_downtime_data();
+  }
+
+  void teardown() {
+    svc_ptr.reset();
+    downtime_manager::instance().clear_scheduled_downtimes();
+    deinit_config_state();
+  }
+
+  std::shared_ptr<service> svc_ptr;
+};
+
+/**
+ * @brief Schedule nb flexible downtimes on other services than test_svc.
+ */
+void schedule_other_downtimes(time_t now, uint64_t nb) {
+  downtime_manager& mgr = downtime_manager::instance();
+  for (uint64_t i = 1; i <= nb; ++i)
+    mgr.add_downtime(std::make_shared<service_downtime>(
+        12, 1000 + i, now, "admin", "other", now - 10 + (i % 100),
+        now + 3600 + (i % 100), false, 0, 600, i));
+}
+}  // namespace
+
+/* Scheduling and expiration of range(0) flexible downtimes. */
+static void BM_downtime_schedule_and_expire(benchmark::State& state) {
+  DowntimeManagerBench env;
+  env.setup();
+  downtime_manager& mgr = downtime_manager::instance();
+  for (auto _ : state) {
+    set_time(20000);
+    schedule_other_downtimes(time(nullptr), state.range(0));
+    set_time(20000 + 7200);
+    mgr.check_for_expired_downtime();
+  }
+  if (!mgr.get_scheduled_downtimes().empty())
+    state.SkipWithError("downtimes are still scheduled");
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  env.teardown();
+}
+BENCHMARK(BM_downtime_schedule_and_expire)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+/* Check results of test_svc processed while range(0) flexible downtimes are
+ * scheduled on other services. The cost must not depend on range(0). */
+static void BM_downtime_check_result(benchmark::State& state) {
+  DowntimeManagerBench env;
+  env.setup();
+  downtime_manager& mgr = downtime_manager::instance();
+  set_time(20000);
+  schedule_other_downtimes(time(nullptr), state.range(0));
+  env.svc_ptr->set_current_state(service::state_critical);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        mgr.check_pending_flex_service_downtime(env.svc_ptr.get()));
+  env.teardown();
+}
+BENCHMARK(BM_downtime_check_result)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench_engine.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/macros.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+namespace {
+/**
+ * @brief One host test_host notifying the contact admin, its notification
+ * command is true.
+ */
+class NotificationStormBench : public BenchEngine {
+ public:
+  void setup() {
+    init_config_state();
+    pb_config.set_max_parallel_system_commands(20);
+
+    configuration::error_cnt err;
+    configuration::applier::contact ct_aply;
+    configuration::Contact ctct{new_pb_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(pb_config);
+    ct_aply.resolve_object(ctct, err);
+
+    configuration::Host hst{new_pb_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+    hst_aply.resolve_object(hst, err);
+
+    hst_ptr = host::hosts.find("test_host")->second;
+    cntct_ptr = contact::contacts.find("admin")->second;
+  }
+
+  void teardown() {
+    hst_ptr.reset();
+    cntct_ptr.reset();
+    deinit_config_state();
+  }
+
+  std::shared_ptr<host> hst_ptr;
+  std::shared_ptr<contact> cntct_ptr;
+};
+}  // namespace
+
+/* A storm of 5,000 host notifications handled as by the main loop: each
+ * loop turn sends range(0) notifications and reaps the finished commands.
+ * The longest and the mean turn durations give the main loop latency, the
+ * iteration time is the duration of the whole storm. */
+static void BM_notification_storm_loop_latency(benchmark::State& state) {
+  constexpr uint32_t storm_size = 5000;
+  const uint32_t batch = state.range(0);
+  NotificationStormBench env;
+  env.setup();
+  nagios_macros* mac = get_global_macros();
+  commands::system_executor& executor = commands::system_executor::instance();
+
+  std::chrono::nanoseconds max_turn{0};
+  std::chrono::nanoseconds all_turns{0};
+  uint64_t turns = 0;
+  for (auto _ : state) {
+    uint32_t sent = 0;
+    while (sent < storm_size || executor.running() || executor.waiting()) {
+      auto start = std::chrono::steady_clock::now();
+      for (uint32_t i = 0; i < batch && sent < storm_size; ++i, ++sent)
+        env.hst_ptr->notify_contact(mac, env.cntct_ptr.get(),
+                                    notifier::reason_normal, "", "", 0, 0);
+      executor.reap();
+      auto turn = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start);
+      max_turn = std::max(max_turn, turn);
+      all_turns += turn;
+      ++turns;
+      /* The main loop idles a bit when it has nothing else to do. */
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+  state.counters["max_turn_us"] = max_turn.count() / 1000.0;
+  state.counters["mean_turn_us"] =
+      turns ? all_turns.count() / 1000.0 / turns : 0.0;
+  state.SetItemsProcessed(state.iterations() * storm_size);
+  env.teardown();
+}
+BENCHMARK(BM_notification_storm_loop_latency)
+    ->Arg(100)
+    ->Arg(5000)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
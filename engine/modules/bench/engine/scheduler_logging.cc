@@ -0,0 +1,125 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * This file is part of Centreon Engine.
+ *
+ * Centreon Engine is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License version 2
+ * as published by the Free Software Foundation.
+ *
+ * Centreon Engine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Centreon Engine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "bench_engine.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/events/loop.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/process.hh"
+#include "helper.hh"
+#include "timeperiod/utils.hh"
+
+using namespace com::centreon::engine;
+
+namespace {
+constexpr uint64_t nb_services = 100;
+
+/**
+ * @brief One host test_host with nb_services services, their ids are 1 to
+ * nb_services.
+ */
+class SchedulerBench : public BenchEngine {
+ public:
+  void setup() {
+    init_config_state();
+
+    configuration::error_cnt err;
+    configuration::applier::contact ct_aply;
+    configuration::Contact ctct{new_pb_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(pb_config);
+    ct_aply.resolve_object(ctct, err);
+
+    configuration::Host hst{new_pb_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+
+    configuration::applier::service svc_aply;
+    std::vector<configuration::Service> svcs;
+    for (uint64_t i = 1; i <= nb_services; ++i) {
+      svcs.emplace_back(new_pb_configuration_service(
+          "test_host", fmt::format("test_svc_{}", i), "admin", i));
+      svc_aply.add_object(svcs.back());
+    }
+
+    hst_aply.resolve_object(hst, err);
+    for (auto& svc : svcs)
+      svc_aply.resolve_object(svc, err);
+
+    hst_ptr = host::hosts.find("test_host")->second;
+    for (uint64_t i = 1; i <= nb_services; ++i)
+      svc_ptrs.push_back(service::services_by_id.find({12, i})->second);
+  }
+
+  void teardown() {
+    hst_ptr.reset();
+    svc_ptrs.clear();
+    events::loop::instance().clear();
+    deinit_config_state();
+  }
+
+  std::shared_ptr<host> hst_ptr;
+  std::vector<std::shared_ptr<service>> svc_ptrs;
+};
+}  // namespace
+
+/* One pass of the scheduler: the checks of all the services and of the host
+ * are rescheduled, the check times are adjusted and a check command line is
+ * built for each service. The loggers used by the scheduler are set to
+ * range(0), info or off: the debug and trace logs are filtered in both cases,
+ * so both timings should be the same. */
+static void BM_scheduler_loop_logging(benchmark::State& state) {
+  std::shared_ptr<spdlog::logger> loggers[] = {
+      events_logger, checks_logger, functions_logger, macros_logger};
+  std::vector<spdlog::level::level_enum> previous;
+  for (auto& logger : loggers) {
+    previous.push_back(logger->level());
+    logger->set_level(
+        static_cast<spdlog::level::level_enum>(state.range(0)));
+  }
+
+  SchedulerBench env;
+  env.setup();
+  time_t now = time(nullptr);
+  set_time(now);
+  nagios_macros* mac(get_global_macros());
+  std::string out;
+  uint32_t i = 0;
+  for (auto _ : state) {
+    for (auto& svc : env.svc_ptrs) {
+      svc->schedule_check(now + 60 + i++ % 300, CHECK_OPTION_NONE, true);
+      process_macros_r(mac, "check -H $HOSTNAME$ -s $SERVICEDESC$", out, 0);
+    }
+    env.hst_ptr->schedule_check(now + 60 + i % 300, CHECK_OPTION_NONE, true);
+    events::loop::instance().adjust_check_scheduling();
+  }
+  state.SetItemsProcessed(state.iterations() * (nb_services + 1));
+  env.teardown();
+
+  for (size_t j = 0; j < previous.size(); ++j)
+    loggers[j]->set_level(previous[j]);
+}
+BENCHMARK(BM_scheduler_loop_logging)
+    ->ArgName("level")
+    ->Arg(spdlog::level::info)
+    ->Arg(spdlog::level::off);
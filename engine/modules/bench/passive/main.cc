@@ -52,6 +52,8 @@ int main(int argc, char* argv[]) {
       // Benchmark options.
       {"engine", required_argument, NULL, 'e'},
       {"module", required_argument, NULL, 'm'},
+      {"reaperthreads", required_argument, NULL, 't'},
+      {"burst", no_argument, NULL, 'b'},
       {NULL, no_argument, NULL, '\0'}};
 #endif  // HAVE_GETOPT_H
   int activehosts(0);
@@ -62,14 +64,16 @@ int main(int argc, char* argv[]) {
   int count(1000);
   std::string engine("/usr/sbin/centengine");
   std::string module("/usr/lib64/centreon-engine/externalcmd.so");
+  int reaperthreads(0);
+  bool burst(false);
 
   // Process command line arguments.
   int c;
 #ifdef HAVE_GETOPT_H
-  while ((c = getopt_long(argc, argv, "+?h:M:s:H:S:c:e:m:", long_options,
+  while ((c = getopt_long(argc, argv, "+?h:M:s:H:S:c:e:m:t:b", long_options,
                           &option_index)) != -1) {
 #else
-  while ((c = getopt(argc, argv, "+?h:M:s:H:S:c:e:m:")) != -1) {
+  while ((c = getopt(argc, argv, "+?h:M:s:H:S:c:e:m:t:b")) != -1) {
 #endif  // HAVE_GETOPT_H
     switch (c) {
       case '?':
@@ -99,6 +103,12 @@ int main(int argc, char* argv[]) {
       case 'm':
         module = optarg;
         break;
+      case 't':
+        reaperthreads = strtol(optarg, NULL, 0);
+        break;
+      case 'b':
+        burst = true;
+        break;
     }
   }
 
@@ -118,6 +128,9 @@ int main(int argc, char* argv[]) {
     std::string additional("broker_module=");
     additional.append(module);
     additional.append("\n");
+    additional.append("check_reaper_threads=");
+    additional.append(std::to_string(reaperthreads));
+    additional.append("\n");
     engine_cfg cfg_files(additional, count, activehosts, activeservices,
                          passivehosts, passiveservices);
     std::cout << "Done\n";
@@ -150,7 +163,7 @@ int main(int argc, char* argv[]) {
                       << i << "/" << count;
             std::cout.flush();
           }
-          if (!(i % slice))
+          if (!burst && !(i % slice))
             sleep(1);
           if (centengine.wait(0))
             break;
@@ -177,6 +190,8 @@ int main(int argc, char* argv[]) {
     std::cout << "\n"
               << "  Total passive check results                   " << count
               << "\n"
+              << "  Check output parsing threads                  "
+              << reaperthreads << "\n"
               << "  Total send time in seconds                    "
               << send_time - start_time << "\n"
               << "  Total processing time in seconds              "
@@ -247,6 +262,12 @@ int main(int argc, char* argv[]) {
         << "  -m --module           Centreon Engine external command module "
            "(default is "
         << module << ")\n"
+        << "  -t --reaperthreads    Number of threads parsing check outputs "
+           "(default is "
+        << reaperthreads << ")\n"
+        << "  -b --burst            Send all the check results at once instead "
+           "of\n"
+        << "                        spreading them over 100 seconds.\n"
         << "\n"
         << "This benchmarking tool aims to mesure the time needed by\n"
         << "Centreon Engine to process some amount of passive service\n"
@@ -187,7 +187,25 @@ int close_command_file(void) {
 static void command_file_worker_thread() {
   external_command_logger->info("start command_file_worker_thread");
 
-  char input_buffer[MAX_EXTERNAL_COMMAND_LENGTH];
+  /* Commands are read by large chunks, and the passive check results they
+   * contain are given to the engine by batches, which is far cheaper than
+   * one line at a time when pollers send bursts of results. */
+  static constexpr size_t read_buffer_size = 64 * 1024;
+  static_assert(read_buffer_size >= MAX_EXTERNAL_COMMAND_LENGTH,
+                "the read buffer must be able to contain a whole command");
+  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(read_buffer_size);
+  char* input_buffer = buffer.get();
+  size_t pending = 0;
+  std::vector<std::string_view> batch;
+  auto flush_batch = [&batch] {
+    if (!batch.empty()) {
+      size_t count =
+          commands::processing::execute_passive_check_results(batch);
+      external_command_logger->debug(
+          "{} passive check results read, {} queued", batch.size(), count);
+      batch.clear();
+    }
+  };
   struct pollfd pfd;
   int pollval;
   struct timeval tv;
@@ -274,34 +292,61 @@ static void command_file_worker_thread() {
     /* process all commands in the file (named pipe) if there's some space in
      * the buffer */
     if (!external_command_buffer.full()) {
-      /* clear EOF condition from prior run (FreeBSD fix) */
-      /* FIXME: use_poll_on_cmd_pipe: Still needed? */
-      clearerr(command_file_fp);
-
-      /* read and process the next command in the file */
+      /* read and process the commands in the file, by large chunks */
+      ssize_t rb;
       while (!should_exit &&
-             fgets(input_buffer, (int)(sizeof(input_buffer) - 1),
-                   command_file_fp) != nullptr) {
-        // Check if command is thread-safe (for immediate execution).
-        if (commands::processing::is_thread_safe(input_buffer)) {
-          external_command_logger->debug("direct execute {}", input_buffer);
-          commands::processing::execute(input_buffer);
-        }
-        // Submit the external command for processing
-        // (retry if buffer is full).
-        else {
-          while (!should_exit && external_command_buffer.full()) {
-            // Wait a bit.
-            tv.tv_sec = 0;
-            tv.tv_usec = 250000;
-            select(0, nullptr, nullptr, nullptr, &tv);
+             (rb = read(command_file_fd, input_buffer + pending,
+                        read_buffer_size - pending)) > 0) {
+        size_t size = pending + rb;
+        std::string_view chunk(input_buffer, size);
+        size_t start = 0;
+        for (;;) {
+          size_t eol = chunk.find('\n', start);
+          if (eol == std::string_view::npos) {
+            /* A line too long for the buffer is handled as is, as fgets()
+             * did. */
+            if (start == 0 && size == read_buffer_size)
+              eol = size;
+            else
+              break;
+          }
+          std::string_view line = chunk.substr(start, eol - start);
+          start = eol + 1;
+          if (line.empty())
+            continue;
+
+          if (commands::processing::is_passive_check_result(line)) {
+            batch.push_back(line);
+            continue;
+          }
+
+          /* Commands are executed in their arrival order. */
+          flush_batch();
+          std::string cmd(line);
+          // Check if command is thread-safe (for immediate execution).
+          if (commands::processing::is_thread_safe(cmd.c_str())) {
+            external_command_logger->debug("direct execute {}", cmd);
+            commands::processing::execute(cmd);
+          }
+          // Submit the external command for processing
+          // (retry if buffer is full).
+          else {
+            while (!should_exit && external_command_buffer.full()) {
+              // Wait a bit.
+              tv.tv_sec = 0;
+              tv.tv_usec = 250000;
+              select(0, nullptr, nullptr, nullptr, &tv);
+            }
+            external_command_logger->debug("push execute {}", cmd);
+            external_command_buffer.push(cmd);
           }
-          external_command_logger->debug("push execute {}", input_buffer);
-          external_command_buffer.push(input_buffer);
-          // Bail if the circular buffer is full.
-          if (external_command_buffer.full())
-            break;
         }
+        flush_batch();
+
+        /* The beginning of an incomplete line is kept for the next read. */
+        pending = start < size ? size - start : 0;
+        if (pending)
+          memmove(input_buffer, input_buffer + start, pending);
       }
     }
   }
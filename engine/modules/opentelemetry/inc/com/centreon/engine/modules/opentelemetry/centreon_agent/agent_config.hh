@@ -42,6 +42,9 @@ class agent_config {
   uint32_t _export_period;
   // after this timeout, process is killed (in seconds)
   uint32_t _check_timeout;
+  // if not null, unchanged check results are not exported until this period
+  // has elapsed (in seconds)
+  uint32_t _delta_export_max_period;
 
  public:
   agent_config(const rapidjson::Value& json_config_v);
@@ -68,6 +71,9 @@ class agent_config {
   uint32_t get_max_concurrent_checks() const { return _max_concurrent_checks; }
   uint32_t get_export_period() const { return _export_period; }
   uint32_t get_check_timeout() const { return _check_timeout; }
+  uint32_t get_delta_export_max_period() const {
+    return _delta_export_max_period;
+  }
 
   bool operator==(const agent_config& right) const;
 
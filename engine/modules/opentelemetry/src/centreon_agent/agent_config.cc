@@ -50,6 +50,11 @@ static constexpr std::string_view _config_schema(R"(
             "type": "integer",
             "minimum": 1
         },
+        "delta_export_max_period": {
+            "description": "if not null, agent doesn't export a check result identical to the last exported one until this period in second has elapsed",
+            "type": "integer",
+            "minimum": 0
+        },
         "reverse_connections": {
             "description": "array of agent endpoints (reverse mode, engine connects to centreon-agent) ",
             "type": "array",
@@ -66,6 +71,7 @@ constexpr unsigned default_check_interval = 60;
 constexpr unsigned default_max_concurrent_checks = 100;
 constexpr unsigned default_export_period = 60;
 constexpr unsigned default_check_timeout = 30;
+constexpr unsigned default_delta_export_max_period = 0;
 
 /**
  * @brief Construct a new agent config::agent from json data
@@ -87,6 +93,8 @@ agent_config::agent_config(const rapidjson::Value& json_config_v) {
       file_content.get_unsigned("export_period", default_export_period);
   _check_timeout =
       file_content.get_unsigned("check_timeout", default_check_timeout);
+  _delta_export_max_period = file_content.get_unsigned(
+      "delta_export_max_period", default_delta_export_max_period);
 
   if (file_content.has_member("reverse_connections")) {
     const auto& reverse_array = file_content.get_member("reverse_connections");
@@ -106,7 +114,8 @@ agent_config::agent_config()
     : _check_interval(default_check_interval),
       _max_concurrent_checks(default_max_concurrent_checks),
       _export_period(default_export_period),
-      _check_timeout(default_check_timeout) {}
+      _check_timeout(default_check_timeout),
+      _delta_export_max_period(default_delta_export_max_period) {}
 
 /**
  * @brief Constructor used by tests
@@ -123,7 +132,8 @@ agent_config::agent_config(uint32_t check_interval,
     : _check_interval(check_interval),
       _max_concurrent_checks(max_concurrent_checks),
       _export_period(export_period),
-      _check_timeout(check_timeout) {}
+      _check_timeout(check_timeout),
+      _delta_export_max_period(default_delta_export_max_period) {}
 
 /**
  * @brief Constructor used by tests
@@ -144,7 +154,8 @@ agent_config::agent_config(
       _check_interval(check_interval),
       _max_concurrent_checks(max_concurrent_checks),
       _export_period(export_period),
-      _check_timeout(check_timeout) {}
+      _check_timeout(check_timeout),
+      _delta_export_max_period(default_delta_export_max_period) {}
 
 /**
  * @brief equality operator
@@ -158,6 +169,7 @@ bool agent_config::operator==(const agent_config& right) const {
       _max_concurrent_checks != right._max_concurrent_checks ||
       _export_period != right._export_period ||
       _check_timeout != right._check_timeout ||
+      _delta_export_max_period != right._delta_export_max_period ||
       _agent_grpc_reverse_conf.size() != right._agent_grpc_reverse_conf.size())
     return false;
 
@@ -164,6 +164,7 @@ void agent_impl<bireactor_class>::_calc_and_send_config_if_needed() {
     cnf->set_export_period(_conf->get_export_period());
     cnf->set_max_concurrent_checks(_conf->get_max_concurrent_checks());
     cnf->set_use_exemplar(true);
+    cnf->set_delta_export_max_period(_conf->get_delta_export_max_period());
     absl::MutexLock l(&_protect);
     if (!_alive) {
       return;
@@ -18,6 +18,10 @@
 
 #include "com/centreon/engine/anomalydetection.hh"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include "com/centreon/common/rapidjson_helper.hh"
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks/checker.hh"
@@ -30,10 +34,12 @@
 #include "com/centreon/engine/macros/grab_service.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/string.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
 
 using namespace com::centreon::engine;
 
 using com::centreon::common::rapidjson_helper;
+using com::centreon::exceptions::msg_fmt;
 using namespace com::centreon::engine::logging;
 
 namespace com::centreon::engine {
@@ -111,6 +117,7 @@ anomalydetection::threshold_point anomalydetection::threshold_point::interpoll(
     time_t timepoint,
     const anomalydetection::threshold_point& left) const {
   anomalydetection::threshold_point ret(timepoint);
+  ret._format = _format;
   double bary =
       ((double)(timepoint - left._timepoint)) / (_timepoint - left._timepoint);
   INTERPOL(_lower);
@@ -484,7 +491,6 @@ anomalydetection::anomalydetection(uint64_t host_id,
       _metric_name{metric_name},
       _thresholds_file{thresholds_file},
       _status_change{status_change},
-      _thresholds_file_viable{false},
       _sensitivity(sensitivity),
       _dependent_service_id(0) {
   set_host_id(host_id);
@@ -949,13 +955,12 @@ int anomalydetection::run_async_check(int check_options,
  * @return int
  */
 int anomalydetection::handle_async_check_result(
-    const check_result& queued_check_result) {
-  std::string output{queued_check_result.get_output()};
+    check_result& queued_check_result) {
   std::string plugin_output;
   std::string long_plugin_output;
   std::string perf_data;
-  parse_check_output(output, plugin_output, long_plugin_output, perf_data, true,
-                     false);
+  queued_check_result.take_parsed_output(plugin_output, long_plugin_output,
+                                         perf_data);
 
   perf_data = string::extract_perfdata(perf_data, _metric_name);
 
@@ -984,7 +989,8 @@ bool anomalydetection::parse_perfdata(std::string const& perfdata,
                                       check_result& calculated_result) {
   std::ostringstream oss;
 
-  if (!_thresholds_file_viable) {
+  threshold_series_ptr thresholds = std::atomic_load(&_thresholds);
+  if (!thresholds || thresholds->points.size() < 2) {
     engine_logger(log_info_message, basic)
         << "The thresholds file is not viable "
            "(not available or not readable).";
@@ -1000,7 +1006,6 @@ bool anomalydetection::parse_perfdata(std::string const& perfdata,
 
   std::string without_thresholds(perfdata);
   string::remove_thresholds(without_thresholds);
-  std::lock_guard<std::mutex> lock(_thresholds_m);
   size_t pos = without_thresholds.find_last_of("=");
   /* If the perfdata is wrong. */
   if (pos == std::string::npos) {
@@ -1030,9 +1035,10 @@ bool anomalydetection::parse_perfdata(std::string const& perfdata,
 
   service::service_state status;
 
+  const threshold_point_map& points = thresholds->points;
   threshold_point_map::const_iterator next_iter =
-      _thresholds.lower_bound(check_time);
-  if (next_iter == _thresholds.end()) {
+      points.lower_bound(check_time);
+  if (next_iter == points.end()) {
     engine_logger(log_runtime_error, basic)
         << "Error: the thresholds file is too old "
            "compared to the check timestamp "
@@ -1050,7 +1056,7 @@ bool anomalydetection::parse_perfdata(std::string const& perfdata,
   }
 
   threshold_point_map::const_iterator prev_iter;
-  if (next_iter != _thresholds.begin()) {
+  if (next_iter != points.begin()) {
     prev_iter = next_iter;
     --prev_iter;
   } else {
@@ -1072,6 +1078,10 @@ bool anomalydetection::parse_perfdata(std::string const& perfdata,
 
   threshold_point interpoll =
       next_iter->second.interpoll(check_time, prev_iter->second);
+  /* json sensitivity is only a default value used if conf or retention
+   * sensitivity value is null */
+  interpoll.set_factor(_sensitivity > 0 ? _sensitivity
+                                        : thresholds->sensitivity);
 
   if (!_status_change)
     status = service::state_ok;
@@ -1131,38 +1141,76 @@ bool anomalydetection::parse_perfdata(std::string const& perfdata,
   return true;
 }
 
-void anomalydetection::init_thresholds() {
-  std::lock_guard<std::mutex> lock(_thresholds_m);
+/****************************************************************
+ * anomalydetection::thresholds_store
+ ****************************************************************/
 
-  engine_logger(dbg_config, most)
-      << "Trying to read thresholds file '" << _thresholds_file << "'";
-  SPDLOG_LOGGER_DEBUG(config_logger, "Trying to read thresholds file '{}'",
-                      _thresholds_file);
+anomalydetection::thresholds_store&
+anomalydetection::thresholds_store::instance() {
+  static thresholds_store instance;
+  return instance;
+}
 
+/**
+ * @brief Parse a thresholds file. The file is memory mapped and parsed once,
+ * then each entry is converted into a threshold_series.
+ *
+ * @param filename The fullname of the file to parse.
+ *
+ * @return The index of the series found in the file, nullptr on error.
+ */
+anomalydetection::thresholds_store::index_ptr
+anomalydetection::thresholds_store::_parse(const std::string& filename) {
   rapidjson::Document json_doc;
   try {
-    json_doc = rapidjson_helper::read_from_file(_thresholds_file);
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw msg_fmt("Fail to read file '{}' : {}", filename, strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+      int err = errno;
+      ::close(fd);
+      throw msg_fmt("Fail to read file '{}' : {}", filename, strerror(err));
+    }
+    if (st.st_size == 0) {
+      ::close(fd);
+      json_doc = rapidjson_helper::read_from_string("");
+    } else {
+      void* content = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      int err = errno;
+      ::close(fd);
+      if (content == MAP_FAILED)
+        throw msg_fmt("Fail to read file '{}' : {}", filename, strerror(err));
+      try {
+        json_doc = rapidjson_helper::read_from_string(std::string_view(
+            static_cast<const char*>(content), st.st_size));
+      } catch (...) {
+        munmap(content, st.st_size);
+        throw;
+      }
+      munmap(content, st.st_size);
+    }
   } catch (const std::exception& e) {
-    SPDLOG_LOGGER_ERROR(config_logger, "Fail to load {}: {}", _thresholds_file,
+    SPDLOG_LOGGER_ERROR(config_logger, "Fail to load {}: {}", filename,
                         e.what());
-    return;
+    return nullptr;
   }
 
   if (!json_doc.IsArray()) {
     engine_logger(log_config_error, basic)
-        << "Error: the file '" << _thresholds_file
+        << "Error: the file '" << filename
         << "' is not a thresholds file. Its global structure is not an array.";
     SPDLOG_LOGGER_ERROR(
         config_logger,
         "Error: the file '{}' is not a thresholds file. Its global structure "
         "is not an array.",
-        _thresholds_file);
-    return;
+        filename);
+    return nullptr;
   }
 
+  auto ret = std::make_shared<index>();
   rapidjson_helper json(json_doc);
-
-  bool found = false;
+  ret->reserve(json_doc.Size());
   for (const auto& value : json) {
     uint64_t host_id, service_id;
     std::string_view metric_name;
@@ -1180,42 +1228,132 @@ void anomalydetection::init_thresholds() {
       }
     } catch (std::exception const& e) {
       engine_logger(log_config_error, basic)
-          << "Error: metric_name and predict are mandatory and host_id, "
+          << "Error: metric_name and predict are mandatory, host_id and "
              "service_id must "
              "be strings containing integers: "
           << e.what();
       SPDLOG_LOGGER_ERROR(config_logger,
-                          "Error: metric_name and predict are mandatory and "
+                          "Error: metric_name and predict are mandatory, "
                           "host_id and service_id must "
                           "be strings containing integers: {}",
                           e.what());
-      return;
+      continue;
     }
-    if (host_id == this->host_id() && service_id == this->service_id() &&
-        metric_name == _metric_name) {
-      set_thresholds_no_lock(_thresholds_file, sensitivity, *predict);
-      if (!_thresholds_file_viable) {
-        SPDLOG_LOGGER_ERROR(config_logger,
-                            "{} don't contain at least 2 thresholds datas for "
-                            "host_id{} and service_id {} ",
-                            _thresholds_file, this->host_id(),
-                            this->service_id());
+
+    auto series = std::make_shared<threshold_series>();
+    series->sensitivity = sensitivity;
+    rapidjson_helper thresholds(*predict);
+    for (const auto& threshold_obj : thresholds) {
+      try {
+        time_t timepoint = static_cast<time_t>(
+            rapidjson_helper(threshold_obj).get_uint64_t("timestamp"));
+        series->points.emplace_hint(
+            series->points.end(), timepoint,
+            threshold_point(timepoint, sensitivity, threshold_obj));
+      } catch (const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(config_logger, "fail to parse predict:{} cause {}",
+                            *predict, e.what());
       }
-      found = true;
-      break;
     }
+    ret->try_emplace(key{host_id, service_id, std::string(metric_name)},
+                     std::move(series));
   }
-  if (!found) {
+  return ret;
+}
+
+/**
+ * @brief Get the index of a thresholds file. The file is parsed only if it
+ * is not already known or if it has changed since its last parsing.
+ *
+ * @param filename The fullname of the thresholds file.
+ * @param force_reload If true, the file is parsed even if it seems unchanged.
+ *
+ * @return The index of the file, nullptr if the file cannot be parsed.
+ */
+anomalydetection::thresholds_store::index_ptr
+anomalydetection::thresholds_store::get(const std::string& filename,
+                                        bool force_reload) {
+  std::lock_guard<std::mutex> lck(_m);
+  struct stat st;
+  if (stat(filename.c_str(), &st) < 0) {
+    SPDLOG_LOGGER_ERROR(config_logger, "Fail to load {}: {}", filename,
+                        strerror(errno));
+    _files.erase(filename);
+    return nullptr;
+  }
+  auto found = _files.find(filename);
+  if (!force_reload && found != _files.end()) {
+    const file_entry& e = found->second;
+    if (e.dev == st.st_dev && e.ino == st.st_ino && e.size == st.st_size &&
+        e.mtime.tv_sec == st.st_mtim.tv_sec &&
+        e.mtime.tv_nsec == st.st_mtim.tv_nsec &&
+        e.ctime.tv_sec == st.st_ctim.tv_sec &&
+        e.ctime.tv_nsec == st.st_ctim.tv_nsec)
+      return e.idx;
+  }
+
+  index_ptr idx = _parse(filename);
+  if (!idx) {
+    _files.erase(filename);
+    return nullptr;
+  }
+  SPDLOG_LOGGER_DEBUG(config_logger, "{} parsed: {} thresholds series",
+                      filename, idx->size());
+  _files[filename] = file_entry{st.st_dev,   st.st_ino,   st.st_size,
+                                st.st_mtim, st.st_ctim, idx};
+  return idx;
+}
+
+/**
+ * @brief Forget all the parsed files.
+ */
+void anomalydetection::thresholds_store::clear() {
+  std::lock_guard<std::mutex> lck(_m);
+  _files.clear();
+}
+
+/****************************************************************
+ * anomalydetection thresholds
+ ****************************************************************/
+
+void anomalydetection::init_thresholds() {
+  std::string filename;
+  {
+    std::lock_guard<std::mutex> lock(_thresholds_m);
+    filename = _thresholds_file;
+  }
+
+  engine_logger(dbg_config, most)
+      << "Trying to read thresholds file '" << filename << "'";
+  SPDLOG_LOGGER_DEBUG(config_logger, "Trying to read thresholds file '{}'",
+                      filename);
+
+  thresholds_store::index_ptr idx = thresholds_store::instance().get(filename);
+  if (!idx)
+    return;
+
+  auto found = idx->find(thresholds_store::key{host_id(), service_id(),
+                                               _metric_name});
+  if (found == idx->end()) {
     SPDLOG_LOGGER_ERROR(
         config_logger,
-        "{} don't contain datas for host_id {} and service_id {}",
-        _thresholds_file, host_id(), this->service_id());
+        "{} don't contain datas for host_id {} and service_id {}", filename,
+        host_id(), this->service_id());
+    return;
+  }
+  set_thresholds(filename, found->second);
+  if (found->second->points.size() < 2) {
+    SPDLOG_LOGGER_ERROR(config_logger,
+                        "{} don't contain at least 2 thresholds datas for "
+                        "host_id{} and service_id {} ",
+                        filename, this->host_id(), this->service_id());
   }
 }
 
 /**
  * @brief Update all the anomaly detection services concerned by one thresholds
- *        file. The file has already been parsed and is translated into json.
+ *        file. The file is parsed again and each service concerned gets its
+ *        new thresholds series.
  *        if sensitivity in json file is a default value taken into account
  *        if conf value is null
  *
@@ -1226,56 +1364,13 @@ int anomalydetection::update_thresholds(const std::string& filename) {
       << "Reading thresholds file '" << filename << "'.";
   SPDLOG_LOGGER_INFO(checks_logger, "Reading thresholds file '{}'.", filename);
 
-  rapidjson::Document json_doc;
-  try {
-    json_doc = rapidjson_helper::read_from_file(filename);
-  } catch (const std::exception& e) {
-    SPDLOG_LOGGER_ERROR(config_logger, "Fail to load {}: {}", filename,
-                        e.what());
+  thresholds_store::index_ptr idx =
+      thresholds_store::instance().get(filename, true);
+  if (!idx)
     return -1;
-  }
 
-  if (!json_doc.IsArray()) {
-    engine_logger(log_config_error, basic)
-        << "Error: the file '" << filename
-        << "' is not a thresholds file. Its global structure is not an array.";
-    SPDLOG_LOGGER_ERROR(
-        config_logger,
-        "Error: the file '{}' is not a thresholds file. Its global structure "
-        "is not an array.",
-        filename);
-    return -3;
-  }
-
-  rapidjson_helper json(json_doc);
-  for (const auto& value : json) {
-    uint64_t host_id, svc_id;
-    double sensitivity = 0.0;
-    std::string_view metric_name;
-    rapidjson_helper item(value);
-    const rapidjson::Value* predict = nullptr;
-    try {
-      host_id = item.get_double("host_id");
-      svc_id = item.get_double("service_id");
-      metric_name = item.get_string("metric_name");
-      predict = &item.get_member("predict");
-      try {
-        sensitivity = item.get_double("sensitivity");
-      } catch (const std::exception&) {  // sensitivity is not mandatory
-      }
-    } catch (std::exception const& e) {
-      engine_logger(log_config_error, basic)
-          << "Error: metric_name and predict are mandatory, host_id and "
-             "service_id must "
-             "be strings containing integers: "
-          << e.what();
-      SPDLOG_LOGGER_ERROR(config_logger,
-                          "Error: metric_name and predict are mandatory, "
-                          "host_id and service_id must "
-                          "be strings containing integers: {}",
-                          e.what());
-      continue;
-    }
+  for (const auto& [k, series] : *idx) {
+    const auto& [host_id, svc_id, metric_name] = k;
     auto found = service::services_by_id.find({host_id, svc_id});
     if (found == service::services_by_id.end()) {
       engine_logger(log_config_error, basic)
@@ -1314,68 +1409,40 @@ int anomalydetection::update_thresholds(const std::string& filename) {
         "metric: {})",
         ad->host_id(), ad->service_id(), ad->get_metric_name());
 
-    ad->set_thresholds_lock(filename, sensitivity, *predict);
+    ad->set_thresholds(filename, series);
   }
   return 0;
 }
 
-void anomalydetection::set_thresholds_lock(const std::string& filename,
-                                           double json_sensitivity,
-                                           const rapidjson::Value& thresholds) {
-  std::lock_guard<std::mutex> _lock(_thresholds_m);
-  set_thresholds_no_lock(filename, json_sensitivity, thresholds);
-}
-
 /**
- * @brief update thresholds with new json content
+ * @brief replace the thresholds series of this service
  *
- * @param filename
- * @param json_sensitivity sensitivity found in json
- * @param thresholds //predict data
+ * @param filename the file where the series has been read
+ * @param series the new series
  */
-void anomalydetection::set_thresholds_no_lock(
-    const std::string& filename,
-    double json_sensitivity,
-    const rapidjson::Value& thresholds_val) {
-  if (_thresholds_file != filename) {
-    _thresholds_file = filename;
+void anomalydetection::set_thresholds(const std::string& filename,
+                                      const threshold_series_ptr& series) {
+  {
+    std::lock_guard<std::mutex> _lock(_thresholds_m);
+    if (_thresholds_file != filename)
+      _thresholds_file = filename;
   }
-  _thresholds.clear();
-  // json sensitivity is only a default value used only if conf or retention
-  // sensitivity value is null json sensitivity is not saved in retention
-  double sensitivity = json_sensitivity;
-  if (_sensitivity > 0) {
-    sensitivity = _sensitivity;
-  }
-  rapidjson_helper thresholds(thresholds_val);
-  for (const auto& threshold_obj : thresholds) {
-    try {
-      time_t timepoint = static_cast<time_t>(
-          rapidjson_helper(threshold_obj).get_uint64_t("timestamp"));
-      _thresholds.emplace_hint(
-          _thresholds.end(), timepoint,
-          threshold_point(timepoint, sensitivity, threshold_obj));
-    } catch (const std::exception& e) {
-      SPDLOG_LOGGER_ERROR(config_logger, "fail to parse predict:{} cause {}",
-                          thresholds_val, e.what());
-    }
-  }
-  if (_thresholds.size() > 1) {
+  std::atomic_store(&_thresholds, series);
+  size_t size = series ? series->points.size() : 0;
+  if (size > 1) {
     engine_logger(dbg_config, most)
         << "host_id=" << host_id() << " serv_id=" << service_id()
-        << " Number of rows in memory: " << _thresholds.size();
+        << " Number of rows in memory: " << size;
     SPDLOG_LOGGER_DEBUG(config_logger,
                         "host_id={} serv_id={} Number of rows in memory: {}",
-                        host_id(), service_id(), _thresholds.size());
-    _thresholds_file_viable = true;
+                        host_id(), service_id(), size);
   } else {
     engine_logger(dbg_config, most)
-        << "Nothing in memory " << _thresholds.size()
-        << " for host_id=" << host_id() << " serv_id=" << service_id();
+        << "Nothing in memory " << size << " for host_id=" << host_id()
+        << " serv_id=" << service_id();
     SPDLOG_LOGGER_ERROR(config_logger,
-                        "Nothing in memory {} for host_id={} servid={}",
-                        _thresholds.size(), host_id(), service_id());
-    _thresholds_file_viable = false;
+                        "Nothing in memory {} for host_id={} servid={}", size,
+                        host_id(), service_id());
   }
 }
 
@@ -1397,14 +1464,10 @@ void anomalydetection::resolve(uint32_t& w, uint32_t& e) {
 }
 
 /**
- * @brief update sensitivity member and recalculate all bounds
+ * @brief update sensitivity member, it is applied on the next evaluations
  *
  * @param sensitivity
  */
 void anomalydetection::set_sensitivity(double sensitivity) {
   _sensitivity = sensitivity;
-  std::lock_guard<std::mutex> _lock(_thresholds_m);
-  for (auto& toupdate : _thresholds) {
-    toupdate.second.set_factor(sensitivity);
-  }
 }
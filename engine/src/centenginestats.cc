@@ -25,6 +25,7 @@
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/notifier.hh"
 #include "com/centreon/engine/objects.hh"
+#include "com/centreon/engine/stats_shm.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/version.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
@@ -42,6 +43,7 @@ using com::centreon::exceptions::msg_fmt;
 static char* main_config_file(NULL);
 static char* stats_file(NULL);
 static char* status_file(NULL);
+static char* stats_shm_name(NULL);
 
 time_t status_creation_date = 0L;
 char* status_version = NULL;
@@ -195,12 +197,18 @@ int total_external_command_buffer_slots = 0;
 int used_external_command_buffer_slots = 0;
 int high_external_command_buffer_slots = 0;
 
+unsigned long status_data_serialization_time = 0;
+unsigned long status_data_write_time = 0;
+int status_data_refreshed_objects = 0;
+int status_data_total_objects = 0;
+
 // Forward declarations.
 int display_stats();
 void get_time_breakdown(unsigned long, int*, int*, int*, int*);
 int read_config_file();
 int read_stats_file();
 int read_status_file();
+int read_shm_stats();
 /* strip newline, carriage return, and tab characters from beginning and end of
  * a string */
 void strip(char*);
@@ -221,6 +229,7 @@ int main(int argc, char* argv[]) {
       {"license", no_argument, 0, 'L'},
       {"config", required_argument, 0, 'c'},
       {"statsfile", required_argument, 0, 's'},
+      {"shm", required_argument, 0, 'm'},
       {0, 0, 0, 0}};
 #endif  // HAVE_GETOPT_H
 
@@ -241,9 +250,9 @@ int main(int argc, char* argv[]) {
     while (!error) {
       // Get next flag.
 #ifdef HAVE_GETOPT_H
-      c = getopt_long(argc, argv, "+hVLc:s:", long_options, NULL);
+      c = getopt_long(argc, argv, "+hVLc:s:m:", long_options, NULL);
 #else
-      c = getopt(argc, argv, "+hVLc:s:");
+      c = getopt(argc, argv, "+hVLc:s:m:");
 #endif  // getopt_long() or getopt()
       if (c == -1)
         break;
@@ -267,6 +276,10 @@ int main(int argc, char* argv[]) {
           stats_file = NULL;
           stats_file = string::dup(optarg);
           break;
+        case 'm':
+          delete[] stats_shm_name;
+          stats_shm_name = string::dup(optarg);
+          break;
         default:
           error = true;
       }
@@ -316,6 +329,10 @@ int main(int argc, char* argv[]) {
           << "  -s, --statsfile=FILE specifies alternate location of file to "
              "read Centreon\n"
           << "                       Engine performance data from.\n"
+          << "  -m, --shm=NAME       specifies the shared memory segment "
+             "where Centreon\n"
+          << "                       Engine publishes its statistics "
+             "(stats_shm_name).\n"
           << std::endl;
       retval = (error ? EXIT_FAILURE : EXIT_SUCCESS);
     }
@@ -328,14 +345,17 @@ int main(int argc, char* argv[]) {
           throw msg_fmt("Error reading stats file '{}': {}", stats_file, msg);
         }
       }
-      // Else read the normal status file.
+      // Else read the shared memory segment or the normal status file.
       else {
-        // Read main config file.
-        if (read_config_file() == ERROR)
+        // Read main config file (the shared memory name given on the command
+        // line is enough).
+        if (!stats_shm_name && read_config_file() == ERROR)
           throw msg_fmt("Error processing config file '{}'", main_config_file);
 
-        // Read status file.
-        if (read_status_file() == ERROR) {
+        // Read statistics published in shared memory, if unavailable, read
+        // the status file.
+        bool shm_read = stats_shm_name && read_shm_stats() == OK;
+        if (!shm_read && read_status_file() == ERROR) {
           char const* msg(strerror(errno));
           throw msg_fmt("Error reading status file '{}': {}", status_file, msg);
         }
@@ -360,6 +380,8 @@ int main(int argc, char* argv[]) {
   stats_file = NULL;
   delete[] status_file;
   status_file = NULL;
+  delete[] stats_shm_name;
+  stats_shm_name = NULL;
 
   return (retval);
 }
@@ -392,6 +414,11 @@ int display_stats() {
   printf("Used/High/Total Command Buffers:        %d / %d / %d\n",
          used_external_command_buffer_slots, high_external_command_buffer_slots,
          total_external_command_buffer_slots);
+  printf("Status Data Serialize/Write Time:       %.3f / %.3f ms\n",
+         status_data_serialization_time / 1000.0,
+         status_data_write_time / 1000.0);
+  printf("Status Data Refreshed/Total Objects:    %d / %d\n",
+         status_data_refreshed_objects, status_data_total_objects);
   printf("\n");
   printf("Total Services:                         %d\n",
          status_service_entries);
@@ -557,6 +584,9 @@ int read_config_file() {
       if (status_file)
         delete[] status_file;
       status_file = string::dup(val);
+    } else if (!strcmp(var, "stats_shm_name")) {
+      delete[] stats_shm_name;
+      stats_shm_name = string::dup(val);
     }
   }
 
@@ -564,6 +594,179 @@ int read_config_file() {
   return (OK);
 }
 
+/**
+ * @brief Read the statistics published by Centreon Engine in shared memory.
+ * This is almost immediate whatever the number of hosts and services.
+ *
+ * @return OK on success, ERROR otherwise (errno is set).
+ */
+int read_shm_stats() {
+  stats_shm shm;
+  shm_stats_data data;
+  if (!shm.open(stats_shm_name))
+    return ERROR;
+  if (!shm.read(data)) {
+    errno = EAGAIN;
+    return ERROR;
+  }
+
+  status_creation_date = data.last_update;
+  delete[] status_version;
+  status_version = string::dup(fmt::format("shm v{}", stats_shm::version));
+  delete[] status_file;
+  status_file = string::dup(stats_shm_name);
+  program_start = data.program_start;
+  nagios_pid = data.pid;
+  total_external_command_buffer_slots =
+      data.total_external_command_buffer_slots;
+  used_external_command_buffer_slots = data.used_external_command_buffer_slots;
+  high_external_command_buffer_slots = data.high_external_command_buffer_slots;
+
+  const int32_t(&cs)[MAX_CHECK_STATS_TYPES][3] = data.check_stats;
+  active_scheduled_host_checks_last_1min =
+      cs[ACTIVE_SCHEDULED_HOST_CHECK_STATS][0];
+  active_scheduled_host_checks_last_5min =
+      cs[ACTIVE_SCHEDULED_HOST_CHECK_STATS][1];
+  active_scheduled_host_checks_last_15min =
+      cs[ACTIVE_SCHEDULED_HOST_CHECK_STATS][2];
+  active_ondemand_host_checks_last_1min =
+      cs[ACTIVE_ONDEMAND_HOST_CHECK_STATS][0];
+  active_ondemand_host_checks_last_5min =
+      cs[ACTIVE_ONDEMAND_HOST_CHECK_STATS][1];
+  active_ondemand_host_checks_last_15min =
+      cs[ACTIVE_ONDEMAND_HOST_CHECK_STATS][2];
+  active_cached_host_checks_last_1min = cs[ACTIVE_CACHED_HOST_CHECK_STATS][0];
+  active_cached_host_checks_last_5min = cs[ACTIVE_CACHED_HOST_CHECK_STATS][1];
+  active_cached_host_checks_last_15min = cs[ACTIVE_CACHED_HOST_CHECK_STATS][2];
+  passive_host_checks_last_1min = cs[PASSIVE_HOST_CHECK_STATS][0];
+  passive_host_checks_last_5min = cs[PASSIVE_HOST_CHECK_STATS][1];
+  passive_host_checks_last_15min = cs[PASSIVE_HOST_CHECK_STATS][2];
+  active_scheduled_service_checks_last_1min =
+      cs[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS][0];
+  active_scheduled_service_checks_last_5min =
+      cs[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS][1];
+  active_scheduled_service_checks_last_15min =
+      cs[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS][2];
+  active_ondemand_service_checks_last_1min =
+      cs[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS][0];
+  active_ondemand_service_checks_last_5min =
+      cs[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS][1];
+  active_ondemand_service_checks_last_15min =
+      cs[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS][2];
+  active_cached_service_checks_last_1min =
+      cs[ACTIVE_CACHED_SERVICE_CHECK_STATS][0];
+  active_cached_service_checks_last_5min =
+      cs[ACTIVE_CACHED_SERVICE_CHECK_STATS][1];
+  active_cached_service_checks_last_15min =
+      cs[ACTIVE_CACHED_SERVICE_CHECK_STATS][2];
+  passive_service_checks_last_1min = cs[PASSIVE_SERVICE_CHECK_STATS][0];
+  passive_service_checks_last_5min = cs[PASSIVE_SERVICE_CHECK_STATS][1];
+  passive_service_checks_last_15min = cs[PASSIVE_SERVICE_CHECK_STATS][2];
+  external_commands_last_1min = cs[EXTERNAL_COMMAND_STATS][0];
+  external_commands_last_5min = cs[EXTERNAL_COMMAND_STATS][1];
+  external_commands_last_15min = cs[EXTERNAL_COMMAND_STATS][2];
+  parallel_host_checks_last_1min = cs[PARALLEL_HOST_CHECK_STATS][0];
+  parallel_host_checks_last_5min = cs[PARALLEL_HOST_CHECK_STATS][1];
+  parallel_host_checks_last_15min = cs[PARALLEL_HOST_CHECK_STATS][2];
+  serial_host_checks_last_1min = cs[SERIAL_HOST_CHECK_STATS][0];
+  serial_host_checks_last_5min = cs[SERIAL_HOST_CHECK_STATS][1];
+  serial_host_checks_last_15min = cs[SERIAL_HOST_CHECK_STATS][2];
+
+  /* 02-15-2008 exclude cached checks from total (they were ondemand checks
+   * that never actually executed) */
+  active_host_checks_last_1min = active_scheduled_host_checks_last_1min +
+                                 active_ondemand_host_checks_last_1min;
+  active_host_checks_last_5min = active_scheduled_host_checks_last_5min +
+                                 active_ondemand_host_checks_last_5min;
+  active_host_checks_last_15min = active_scheduled_host_checks_last_15min +
+                                  active_ondemand_host_checks_last_15min;
+  active_service_checks_last_1min = active_scheduled_service_checks_last_1min +
+                                    active_ondemand_service_checks_last_1min;
+  active_service_checks_last_5min = active_scheduled_service_checks_last_5min +
+                                    active_ondemand_service_checks_last_5min;
+  active_service_checks_last_15min =
+      active_scheduled_service_checks_last_15min +
+      active_ondemand_service_checks_last_15min;
+
+  const shm_object_stats& svc = data.services;
+  status_service_entries = svc.count;
+  services_checked = svc.checked;
+  services_scheduled = svc.scheduled;
+  active_service_checks = svc.actively_checked;
+  passive_service_checks = svc.passively_checked;
+  min_service_state_change = svc.min_state_change;
+  max_service_state_change = svc.max_state_change;
+  average_service_state_change = svc.average_state_change;
+  min_active_service_latency = svc.active.min_latency;
+  max_active_service_latency = svc.active.max_latency;
+  average_active_service_latency = svc.active.average_latency;
+  min_active_service_execution_time = svc.active.min_execution_time;
+  max_active_service_execution_time = svc.active.max_execution_time;
+  average_active_service_execution_time = svc.active.average_execution_time;
+  min_active_service_state_change = svc.active.min_state_change;
+  max_active_service_state_change = svc.active.max_state_change;
+  average_active_service_state_change = svc.active.average_state_change;
+  active_services_checked_last_1min = svc.active.checks_last_1min;
+  active_services_checked_last_5min = svc.active.checks_last_5min;
+  active_services_checked_last_15min = svc.active.checks_last_15min;
+  active_services_checked_last_1hour = svc.active.checks_last_1hour;
+  min_passive_service_latency = svc.passive.min_latency;
+  max_passive_service_latency = svc.passive.max_latency;
+  average_passive_service_latency = svc.passive.average_latency;
+  min_passive_service_state_change = svc.passive.min_state_change;
+  max_passive_service_state_change = svc.passive.max_state_change;
+  average_passive_service_state_change = svc.passive.average_state_change;
+  passive_services_checked_last_1min = svc.passive.checks_last_1min;
+  passive_services_checked_last_5min = svc.passive.checks_last_5min;
+  passive_services_checked_last_15min = svc.passive.checks_last_15min;
+  passive_services_checked_last_1hour = svc.passive.checks_last_1hour;
+  services_ok = svc.states[service::state_ok];
+  services_warning = svc.states[service::state_warning];
+  services_critical = svc.states[service::state_critical];
+  services_unknown = svc.states[service::state_unknown];
+  services_flapping = svc.flapping;
+  services_in_downtime = svc.downtime;
+
+  const shm_object_stats& hst = data.hosts;
+  status_host_entries = hst.count;
+  hosts_checked = hst.checked;
+  hosts_scheduled = hst.scheduled;
+  active_host_checks = hst.actively_checked;
+  passive_host_checks = hst.passively_checked;
+  min_host_state_change = hst.min_state_change;
+  max_host_state_change = hst.max_state_change;
+  average_host_state_change = hst.average_state_change;
+  min_active_host_latency = hst.active.min_latency;
+  max_active_host_latency = hst.active.max_latency;
+  average_active_host_latency = hst.active.average_latency;
+  min_active_host_execution_time = hst.active.min_execution_time;
+  max_active_host_execution_time = hst.active.max_execution_time;
+  average_active_host_execution_time = hst.active.average_execution_time;
+  min_active_host_state_change = hst.active.min_state_change;
+  max_active_host_state_change = hst.active.max_state_change;
+  average_active_host_state_change = hst.active.average_state_change;
+  active_hosts_checked_last_1min = hst.active.checks_last_1min;
+  active_hosts_checked_last_5min = hst.active.checks_last_5min;
+  active_hosts_checked_last_15min = hst.active.checks_last_15min;
+  active_hosts_checked_last_1hour = hst.active.checks_last_1hour;
+  min_passive_host_latency = hst.passive.min_latency;
+  max_passive_host_latency = hst.passive.max_latency;
+  average_passive_host_latency = hst.passive.average_latency;
+  min_passive_host_state_change = hst.passive.min_state_change;
+  max_passive_host_state_change = hst.passive.max_state_change;
+  average_passive_host_state_change = hst.passive.average_state_change;
+  passive_hosts_checked_last_1min = hst.passive.checks_last_1min;
+  passive_hosts_checked_last_5min = hst.passive.checks_last_5min;
+  passive_hosts_checked_last_15min = hst.passive.checks_last_15min;
+  passive_hosts_checked_last_1hour = hst.passive.checks_last_1hour;
+  hosts_up = hst.states[host::state_up];
+  hosts_down = hst.states[host::state_down];
+  hosts_unreachable = hst.states[host::state_unreachable];
+  hosts_flapping = hst.flapping;
+  hosts_in_downtime = hst.downtime;
+  return OK;
+}
+
 int read_status_file() {
   char temp_buffer[MAX_INPUT_BUFFER];
   FILE* fp = NULL;
@@ -967,7 +1170,17 @@ int read_status_file() {
             high_external_command_buffer_slots = atoi(val);
           else if (!strcmp(var, "nagios_pid"))
             nagios_pid = strtoul(val, NULL, 10);
-          else if (!strcmp(var, "active_scheduled_host_check_stats")) {
+          else if (!strcmp(var, "status_data_dump_time")) {
+            if ((temp_ptr = strtok(val, ",")))
+              status_data_serialization_time = strtoul(temp_ptr, NULL, 10);
+            if ((temp_ptr = strtok(NULL, ",")))
+              status_data_write_time = strtoul(temp_ptr, NULL, 10);
+          } else if (!strcmp(var, "status_data_refreshed_objects")) {
+            if ((temp_ptr = strtok(val, ",")))
+              status_data_refreshed_objects = atoi(temp_ptr);
+            if ((temp_ptr = strtok(NULL, ",")))
+              status_data_total_objects = atoi(temp_ptr);
+          } else if (!strcmp(var, "active_scheduled_host_check_stats")) {
             if ((temp_ptr = strtok(val, ",")))
               active_scheduled_host_checks_last_1min = atoi(temp_ptr);
             if ((temp_ptr = strtok(NULL, ",")))
@@ -1147,7 +1360,17 @@ int read_stats_file() {
       high_external_command_buffer_slots = atoi(val);
     else if (!strcmp(var, "nagios_pid"))
       nagios_pid = strtoul(val, NULL, 10);
-    else if (!strcmp(var, "active_scheduled_host_check_stats")) {
+    else if (!strcmp(var, "status_data_dump_time")) {
+      if ((temp_ptr = strtok(val, ",")))
+        status_data_serialization_time = strtoul(temp_ptr, NULL, 10);
+      if ((temp_ptr = strtok(NULL, ",")))
+        status_data_write_time = strtoul(temp_ptr, NULL, 10);
+    } else if (!strcmp(var, "status_data_refreshed_objects")) {
+      if ((temp_ptr = strtok(val, ",")))
+        status_data_refreshed_objects = atoi(temp_ptr);
+      if ((temp_ptr = strtok(NULL, ",")))
+        status_data_total_objects = atoi(temp_ptr);
+    } else if (!strcmp(var, "active_scheduled_host_check_stats")) {
       if ((temp_ptr = strtok(val, ",")))
         active_scheduled_host_checks_last_1min = atoi(temp_ptr);
       if ((temp_ptr = strtok(NULL, ",")))
@@ -22,6 +22,7 @@
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/utils.hh"
 
 using namespace com::centreon::engine;
 
@@ -36,7 +37,8 @@ check_result::check_result()
       _finish_time{0, 0},
       _early_timeout{false},
       _exited_ok{false},
-      _return_code{0} {}
+      _return_code{0},
+      _output_state{output_raw} {}
 
 check_result::check_result(enum check_source object_check_type,
                            notifier* notifier,
@@ -61,7 +63,8 @@ check_result::check_result(enum check_source object_check_type,
       _early_timeout{early_timeout},
       _exited_ok{exited_ok},
       _return_code{return_code},
-      _output{std::move(output)} {}
+      _output{std::move(output)},
+      _output_state{output_raw} {}
 
 void check_result::set_object_check_type(enum check_source object_check_type) {
   _object_check_type = object_check_type;
@@ -97,6 +100,7 @@ void check_result::set_early_timeout(bool early_timeout) {
  */
 void check_result::set_output(std::string const& output) {
   _output = output;
+  _output_state.store(output_raw, std::memory_order_release);
 }
 
 void check_result::set_exited_ok(bool exited_ok) {
@@ -119,6 +123,65 @@ void check_result::set_check_options(unsigned check_options) {
   _check_options = check_options;
 }
 
+/**
+ * @brief Split the output into short output, long output and perfdata, the
+ * same way the notifier does it when it handles the result. This method
+ * only works on this object, so it can be called from any thread. Nothing is
+ * done if the output is already parsed or taken by the main loop.
+ *
+ * @return true if the output has been parsed by this call.
+ */
+bool check_result::parse_output() {
+  uint8_t expected = output_raw;
+  if (!_output_state.compare_exchange_strong(expected, output_parsing,
+                                             std::memory_order_acquire))
+    return false;
+  _plugin_output.clear();
+  _long_plugin_output.clear();
+  _perf_data.clear();
+  parse_check_output(_output, _plugin_output, _long_plugin_output, _perf_data,
+                     true, false);
+  _output_state.store(output_parsed, std::memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Give the short output, long output and perfdata of this result. If
+ * they have been prepared by parse_output(), they are moved, if they are
+ * being prepared, we wait for them, otherwise the output is parsed now and
+ * no worker will parse it anymore.
+ *
+ * @param plugin_output The short output.
+ * @param long_plugin_output The long output.
+ * @param perf_data The perfdata.
+ */
+void check_result::take_parsed_output(std::string& plugin_output,
+                                      std::string& long_plugin_output,
+                                      std::string& perf_data) {
+  uint8_t state = _output_state.load(std::memory_order_acquire);
+  for (;;) {
+    if (state == output_parsed) {
+      plugin_output = std::move(_plugin_output);
+      long_plugin_output = std::move(_long_plugin_output);
+      perf_data = std::move(_perf_data);
+      _output_state.store(output_taken, std::memory_order_relaxed);
+      return;
+    }
+    if (state == output_parsing) {
+      /* A worker is parsing it, this is a matter of microseconds. */
+      std::this_thread::yield();
+      state = _output_state.load(std::memory_order_acquire);
+    } else if (_output_state.compare_exchange_weak(state, output_taken,
+                                                   std::memory_order_acquire))
+      break;
+  }
+  plugin_output.clear();
+  long_plugin_output.clear();
+  perf_data.clear();
+  parse_check_output(_output, plugin_output, long_plugin_output, perf_data,
+                     true, false);
+}
+
 namespace com::centreon::engine {
 
 std::ostream& operator<<(std::ostream& stream, const check_result& res) {
@@ -91,6 +91,7 @@ checkable::checkable(const std::string& name,
       _event_handler_ptr{nullptr},
       _check_command_ptr{nullptr},
       _is_executing{false},
+      _status_dirty{true},
       _icon_id{icon_id},
       check_period_ptr{nullptr} {
   if (max_attempts <= 0 || retry_interval <= 0 || freshness_threshold < 0) {
@@ -133,6 +134,7 @@ const std::string& checkable::check_command() const {
 
 void checkable::set_check_command(const std::string& check_command) {
   _check_command = check_command;
+  _status_dirty = true;
 }
 
 uint32_t checkable::check_interval() const {
@@ -141,6 +143,7 @@ uint32_t checkable::check_interval() const {
 
 void checkable::set_check_interval(uint32_t check_interval) {
   _check_interval = check_interval;
+  _status_dirty = true;
 }
 
 double checkable::retry_interval() const {
@@ -149,6 +152,7 @@ double checkable::retry_interval() const {
 
 void checkable::set_retry_interval(double retry_interval) {
   _retry_interval = retry_interval;
+  _status_dirty = true;
 }
 
 time_t checkable::get_last_state_change() const {
@@ -157,6 +161,7 @@ time_t checkable::get_last_state_change() const {
 
 void checkable::set_last_state_change(time_t last_state_change) {
   _last_state_change = last_state_change;
+  _status_dirty = true;
 }
 
 time_t checkable::get_last_hard_state_change() const {
@@ -165,6 +170,7 @@ time_t checkable::get_last_hard_state_change() const {
 
 void checkable::set_last_hard_state_change(time_t last_hard_state_change) {
   _last_hard_state_change = last_hard_state_change;
+  _status_dirty = true;
 }
 
 int checkable::max_check_attempts() const {
@@ -173,6 +179,7 @@ int checkable::max_check_attempts() const {
 
 void checkable::set_max_attempts(int max_attempts) {
   _max_attempts = max_attempts;
+  _status_dirty = true;
 }
 
 const std::string& checkable::check_period() const {
@@ -181,6 +188,7 @@ const std::string& checkable::check_period() const {
 
 void checkable::set_check_period(const std::string& check_period) {
   _check_period = check_period;
+  _status_dirty = true;
 }
 
 const std::string& checkable::get_action_url() const {
@@ -213,6 +221,7 @@ const std::string& checkable::event_handler() const {
 
 void checkable::set_event_handler(const std::string& event_handler) {
   _event_handler = event_handler;
+  _status_dirty = true;
 }
 
 const std::string& checkable::get_notes() const {
@@ -237,6 +246,7 @@ const std::string& checkable::get_plugin_output() const {
 
 void checkable::set_plugin_output(const std::string& plugin_output) {
   _plugin_output = plugin_output;
+  _status_dirty = true;
 }
 
 const std::string& checkable::get_long_plugin_output() const {
@@ -245,6 +255,7 @@ const std::string& checkable::get_long_plugin_output() const {
 
 void checkable::set_long_plugin_output(const std::string& long_plugin_output) {
   _long_plugin_output = long_plugin_output;
+  _status_dirty = true;
 }
 
 const std::string& checkable::get_perf_data() const {
@@ -253,6 +264,7 @@ const std::string& checkable::get_perf_data() const {
 
 void checkable::set_perf_data(const std::string& perf_data) {
   _perf_data = perf_data;
+  _status_dirty = true;
 }
 
 bool checkable::flap_detection_enabled() const {
@@ -261,6 +273,7 @@ bool checkable::flap_detection_enabled() const {
 
 void checkable::set_flap_detection_enabled(bool flap_detection_enabled) {
   _flap_detection_enabled = flap_detection_enabled;
+  _status_dirty = true;
 }
 
 double checkable::get_low_flap_threshold() const {
@@ -301,6 +314,7 @@ bool checkable::active_checks_enabled() const {
 
 void checkable::set_checks_enabled(bool checks_enabled) {
   _checks_enabled = checks_enabled;
+  _status_dirty = true;
 }
 
 bool checkable::check_freshness_enabled() const {
@@ -317,10 +331,12 @@ enum checkable::check_type checkable::get_check_type() const {
 
 void checkable::set_check_type(checkable::check_type check_type) {
   _check_type = check_type;
+  _status_dirty = true;
 }
 
 void checkable::set_current_attempt(int attempt) {
   _current_attempt = attempt;
+  _status_dirty = true;
 }
 
 int checkable::get_current_attempt() const {
@@ -329,6 +345,7 @@ int checkable::get_current_attempt() const {
 
 void checkable::add_current_attempt(int num) {
   _current_attempt += num;
+  _status_dirty = true;
 }
 
 bool checkable::has_been_checked() const {
@@ -337,6 +354,7 @@ bool checkable::has_been_checked() const {
 
 void checkable::set_has_been_checked(bool has_been_checked) {
   _has_been_checked = has_been_checked;
+  _status_dirty = true;
 }
 
 bool checkable::event_handler_enabled() const {
@@ -345,6 +363,7 @@ bool checkable::event_handler_enabled() const {
 
 void checkable::set_event_handler_enabled(bool event_handler_enabled) {
   _event_handler_enabled = event_handler_enabled;
+  _status_dirty = true;
 }
 
 bool checkable::passive_checks_enabled() const {
@@ -353,6 +372,7 @@ bool checkable::passive_checks_enabled() const {
 
 void checkable::set_accept_passive_checks(bool accept_passive_checks) {
   _accept_passive_checks = accept_passive_checks;
+  _status_dirty = true;
 }
 
 int checkable::get_scheduled_downtime_depth() const {
@@ -362,14 +382,17 @@ int checkable::get_scheduled_downtime_depth() const {
 void checkable::set_scheduled_downtime_depth(
     int scheduled_downtime_depth) noexcept {
   _scheduled_downtime_depth = scheduled_downtime_depth;
+  _status_dirty = true;
 }
 
 void checkable::inc_scheduled_downtime_depth() noexcept {
   ++_scheduled_downtime_depth;
+  _status_dirty = true;
 }
 
 void checkable::dec_scheduled_downtime_depth() noexcept {
   --_scheduled_downtime_depth;
+  _status_dirty = true;
 }
 
 double checkable::get_execution_time() const {
@@ -378,6 +401,7 @@ double checkable::get_execution_time() const {
 
 void checkable::set_execution_time(double execution_time) {
   _execution_time = execution_time;
+  _status_dirty = true;
 }
 
 int checkable::get_freshness_threshold() const {
@@ -394,6 +418,7 @@ bool checkable::get_is_flapping() const {
 
 void checkable::set_is_flapping(bool is_flapping) {
   _is_flapping = is_flapping;
+  _status_dirty = true;
 }
 
 std::time_t checkable::get_last_check() const {
@@ -402,6 +427,7 @@ std::time_t checkable::get_last_check() const {
 
 void checkable::set_last_check(time_t last_check) {
   _last_check = last_check;
+  _status_dirty = true;
 }
 
 double checkable::get_latency() const {
@@ -410,6 +436,7 @@ double checkable::get_latency() const {
 
 void checkable::set_latency(double latency) {
   _latency = latency;
+  _status_dirty = true;
 }
 
 std::time_t checkable::get_next_check() const {
@@ -418,6 +445,7 @@ std::time_t checkable::get_next_check() const {
 
 void checkable::set_next_check(std::time_t next_check) {
   _next_check = next_check;
+  _status_dirty = true;
 }
 
 enum checkable::state_type checkable::get_state_type() const {
@@ -426,6 +454,7 @@ enum checkable::state_type checkable::get_state_type() const {
 
 void checkable::set_state_type(enum checkable::state_type state_type) {
   _state_type = state_type;
+  _status_dirty = true;
 }
 
 double checkable::get_percent_state_change() const {
@@ -434,6 +463,7 @@ double checkable::get_percent_state_change() const {
 
 void checkable::set_percent_state_change(double percent_state_change) {
   _percent_state_change = percent_state_change;
+  _status_dirty = true;
 }
 
 bool checkable::obsess_over() const {
@@ -442,6 +472,7 @@ bool checkable::obsess_over() const {
 
 void checkable::set_obsess_over(bool obsess_over) {
   _obsess_over = obsess_over;
+  _status_dirty = true;
 }
 
 bool checkable::get_should_be_scheduled() const {
@@ -450,6 +481,7 @@ bool checkable::get_should_be_scheduled() const {
 
 void checkable::set_should_be_scheduled(bool should_be_scheduled) {
   _should_be_scheduled = should_be_scheduled;
+  _status_dirty = true;
 }
 
 commands::command* checkable::get_event_handler_ptr() const {
@@ -473,6 +505,27 @@ void checkable::set_is_executing(bool is_executing) {
   _is_executing = is_executing;
 }
 
+/**
+ * @brief Tell if the status of this object changed since the last time it was
+ * written in the status file.
+ *
+ * @return true if its status block has to be generated again.
+ */
+bool checkable::get_status_dirty() const {
+  return _status_dirty;
+}
+
+/**
+ * @brief Set the status dirty flag. It is raised by the setters of the fields
+ * written in the status file and cleared by the status file writer once the
+ * object has been serialized.
+ *
+ * @param status_dirty The new value of the flag.
+ */
+void checkable::set_status_dirty(bool status_dirty) {
+  _status_dirty = status_dirty;
+}
+
 /**
  * @brief Set the severity. And we can also set nullptr if we don't want any
  * severity.
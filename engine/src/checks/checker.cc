@@ -38,6 +38,9 @@ using namespace com::centreon::engine::checks;
 
 checker* checker::_instance = nullptr;
 static constexpr time_t max_check_reaper_time = 30;
+/* Under this number of results per worker, preparing results in parallel
+ * costs more than it saves. */
+static constexpr size_t min_results_per_prepare_thread = 64;
 
 /**
  *  Get instance of the checker singleton.
@@ -76,6 +79,13 @@ void checker::clear() noexcept {
 
 /**
  *  Reap and process all results received by execution process.
+ *
+ *  Results are handled one after the other on the main loop, whatever the
+ *  check_reaper_threads setting: state changes, flapping, notifications,
+ *  dependencies and broker callbacks are never run in parallel nor
+ *  partitioned by host. With check_reaper_threads > 0, only the parsing of
+ *  the outputs (short/long output and perfdata) is done in advance by
+ *  workers, see _dispatch_results().
  */
 void checker::reap() {
   engine_logger(dbg_functions, basic) << "checker::reap";
@@ -115,6 +125,16 @@ void checker::reap() {
       std::swap(_to_reap, _to_reap_partial);
     }
 
+#ifdef LEGACY_CONF
+    _set_prepare_threads(config->check_reaper_threads());
+#else
+    _set_prepare_threads(pb_config.check_reaper_threads());
+#endif
+    if (!_prepare_threads.empty() &&
+        _to_reap.size() >=
+            _prepare_threads.size() * min_results_per_prepare_thread)
+      _dispatch_results();
+
     // Process check results.
     while (!_to_reap.empty()) {
       // Get result host or service check.
@@ -192,6 +212,8 @@ void checker::reap() {
         break;
       }
     }
+    if (!_prepare_threads.empty())
+      _drop_dispatched_results();
   }
 
   // Reaping finished.
@@ -346,6 +368,7 @@ void checker::run_sync(host* hst,
  */
 checker::checker(bool used_by_test)
     : commands::command_listener(),
+      _prepare_exit(false),
       _used_by_test(used_by_test),
       _finished(false) {}
 
@@ -353,9 +376,108 @@ checker::checker(bool used_by_test)
  *  Default destructor.
  */
 checker::~checker() noexcept {
+  _set_prepare_threads(0);
   clear();
 }
 
+/**
+ * @brief Start or stop workers so that there are count of them to parse the
+ * output of check results. Must be called from the main loop.
+ *
+ * @param count The wanted number of workers, 0 to disable parallel
+ * parsing.
+ */
+void checker::_set_prepare_threads(uint32_t count) {
+  if (count == _prepare_threads.size())
+    return;
+
+  if (!_prepare_threads.empty()) {
+    {
+      std::lock_guard<std::mutex> lck(_prepare_m);
+      _prepare_exit = true;
+    }
+    _prepare_cv.notify_all();
+    for (auto& t : _prepare_threads)
+      t.join();
+    _prepare_threads.clear();
+    _prepare_exit = false;
+  }
+
+  _prepare_queue.clear();
+  _prepare_threads.reserve(count);
+  for (uint32_t i = 0; i < count; ++i)
+    _prepare_threads.emplace_back(&checker::_prepare_worker, this);
+  if (count)
+    SPDLOG_LOGGER_INFO(checks_logger,
+                       "{} threads used to parse check results outputs",
+                       count);
+}
+
+/**
+ * @brief Worker loop: the check results of the shared queue get their output
+ * parsed, unless the main loop already did it. Each worker takes a slice of
+ * the queue at a time to limit the contention on the mutex.
+ */
+void checker::_prepare_worker() {
+  std::vector<check_result::pointer> to_prepare;
+  to_prepare.reserve(min_results_per_prepare_thread);
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lck(_prepare_m);
+      _prepare_cv.wait(
+          lck, [this] { return _prepare_exit || !_prepare_queue.empty(); });
+      if (_prepare_exit)
+        return;
+      while (!_prepare_queue.empty() &&
+             to_prepare.size() < min_results_per_prepare_thread) {
+        to_prepare.push_back(std::move(_prepare_queue.front()));
+        _prepare_queue.pop_front();
+      }
+    }
+
+    for (check_result::pointer& cr : to_prepare)
+      cr->parse_output();
+    to_prepare.clear();
+  }
+}
+
+/**
+ * @brief Queue the check results of _to_reap to the workers and return at
+ * once. The workers only parse the outputs (short/long output and perfdata),
+ * which do not depend on any other result, so any worker can take any
+ * result. The main loop handles _to_reap meanwhile: a result not parsed yet
+ * when its turn comes is parsed by the main loop and then skipped by the
+ * workers. State changes, flapping, notifications, dependencies and the
+ * broker callbacks stay on the main loop, in reap().
+ */
+void checker::_dispatch_results() {
+  size_t dispatched = 0;
+  {
+    std::lock_guard<std::mutex> lck(_prepare_m);
+    for (check_result::pointer& cr : _to_reap) {
+      if (cr->is_output_parsed())
+        continue;
+      _prepare_queue.push_back(cr);
+      ++dispatched;
+    }
+  }
+  _prepare_cv.notify_all();
+
+  SPDLOG_LOGGER_DEBUG(checks_logger,
+                      "{} check results dispatched to {} parsing threads",
+                      dispatched, _prepare_threads.size());
+}
+
+/**
+ * @brief Forget the results still queued to the workers at the end of
+ * reap(). The main loop has already parsed them, or will parse them itself
+ * if they are still in _to_reap.
+ */
+void checker::_drop_dispatched_results() {
+  std::lock_guard<std::mutex> lck(_prepare_m);
+  _prepare_queue.clear();
+}
+
 /**
  *  Slot to catch the result of the execution and add to the reap queue.
  *
@@ -700,6 +822,20 @@ void checker::add_check_result_to_reap(
   _to_reap_partial.push_back(check_result);
 }
 
+/**
+ * @brief Same as add_check_result_to_reap() but for several check results
+ * that are all queued under one lock. The vector is emptied.
+ *
+ * @param results The check results to reap.
+ */
+void checker::add_check_results_to_reap(
+    std::vector<check_result::pointer>& results) noexcept {
+  std::lock_guard<std::mutex> lock(_mut_reap);
+  for (auto& r : results)
+    _to_reap_partial.push_back(std::move(r));
+  results.clear();
+}
+
 /**
  * @brief Notifiers added here will be removed from current checks. This task
  * is necessary because the user could remove a service or a host while a check
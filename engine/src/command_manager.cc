@@ -28,6 +28,7 @@
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/statistics.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
@@ -400,6 +401,140 @@ int command_manager::get_stats(std::string const& request, Stats* response) {
   return 0;
 }
 
+/**
+ * @brief Fill the default statistics from the shared memory segment published
+ * by statistics::publish_shared_stats(). Contrary to get_stats(), this method
+ * can be called from any thread.
+ *
+ * @param response The Stats message to fill.
+ *
+ * @return true on success, false if no statistics are available, the caller
+ * then has to use get_stats() in the main loop.
+ */
+bool command_manager::get_shared_stats(Stats* response) const {
+  shm_stats_data data;
+  if (!statistics::instance().read_shared_stats(data))
+    return false;
+
+  ProgramStatus* ps = response->mutable_program_status();
+  ps->set_modified_host_attributes(data.modified_host_attributes);
+  ps->set_modified_service_attributes(data.modified_service_attributes);
+  ps->set_pid(data.pid);
+  *ps->mutable_program_start() =
+      google::protobuf::util::TimeUtil::SecondsToTimestamp(data.program_start);
+  *ps->mutable_last_command_check() =
+      google::protobuf::util::TimeUtil::SecondsToTimestamp(
+          data.last_command_check);
+  *ps->mutable_last_log_rotation() =
+      google::protobuf::util::TimeUtil::SecondsToTimestamp(
+          data.last_log_rotation);
+  ps->set_enable_notifications(data.enable_notifications);
+  ps->set_active_service_checks_enabled(data.active_service_checks_enabled);
+  ps->set_passive_service_checks_enabled(data.passive_service_checks_enabled);
+  ps->set_active_host_checks_enabled(data.active_host_checks_enabled);
+  ps->set_passive_host_checks_enabled(data.passive_host_checks_enabled);
+  ps->set_enable_event_handlers(data.enable_event_handlers);
+  ps->set_obsess_over_services(data.obsess_over_services);
+  ps->set_obsess_over_hosts(data.obsess_over_hosts);
+  ps->set_check_service_freshness(data.check_service_freshness);
+  ps->set_check_host_freshness(data.check_host_freshness);
+  ps->set_enable_flap_detection(data.enable_flap_detection);
+  ps->set_process_performance_data(data.process_performance_data);
+  ps->set_global_host_event_handler(data.global_host_event_handler);
+  ps->set_global_service_event_handler(data.global_service_event_handler);
+  ps->set_next_comment_id(data.next_comment_id);
+  ps->set_next_event_id(data.next_event_id);
+  ps->set_next_problem_id(data.next_problem_id);
+  ps->set_next_notification_id(data.next_notification_id);
+  ps->set_total_external_command_buffer_slots(
+      data.total_external_command_buffer_slots);
+  ps->set_used_external_command_buffer_slots(
+      data.used_external_command_buffer_slots);
+  ps->set_high_external_command_buffer_slots(
+      data.high_external_command_buffer_slots);
+  ps->set_check_results_to_reap(data.check_results_to_reap);
+  ps->set_high_priority_events(data.high_priority_events);
+  ps->set_low_priority_events(data.low_priority_events);
+
+  for (int i = 0; i < 3; ++i) {
+    ps->add_active_scheduled_host_check_stats(
+        data.check_stats[ACTIVE_SCHEDULED_HOST_CHECK_STATS][i]);
+    ps->add_active_ondemand_host_check_stats(
+        data.check_stats[ACTIVE_ONDEMAND_HOST_CHECK_STATS][i]);
+    ps->add_passive_host_check_stats(
+        data.check_stats[PASSIVE_HOST_CHECK_STATS][i]);
+    ps->add_active_scheduled_service_check_stats(
+        data.check_stats[ACTIVE_SCHEDULED_SERVICE_CHECK_STATS][i]);
+    ps->add_active_ondemand_service_check_stats(
+        data.check_stats[ACTIVE_ONDEMAND_SERVICE_CHECK_STATS][i]);
+    ps->add_passive_service_check_stats(
+        data.check_stats[PASSIVE_SERVICE_CHECK_STATS][i]);
+    ps->add_cached_host_check_stats(
+        data.check_stats[ACTIVE_CACHED_HOST_CHECK_STATS][i]);
+    ps->add_cached_service_check_stats(
+        data.check_stats[ACTIVE_CACHED_SERVICE_CHECK_STATS][i]);
+    ps->add_external_command_stats(
+        data.check_stats[EXTERNAL_COMMAND_STATS][i]);
+    ps->add_parallel_host_check_stats(
+        data.check_stats[PARALLEL_HOST_CHECK_STATS][i]);
+    ps->add_serial_host_check_stats(
+        data.check_stats[SERIAL_HOST_CHECK_STATS][i]);
+  }
+  response->mutable_program_configuration()->set_hosts_count(data.hosts.count);
+
+  auto fill_type = [](const shm_check_type_stats& src, auto* dst) {
+    dst->set_min_latency(src.min_latency);
+    dst->set_max_latency(src.max_latency);
+    dst->set_average_latency(src.average_latency);
+    dst->set_min_execution_time(src.min_execution_time);
+    dst->set_max_execution_time(src.max_execution_time);
+    dst->set_average_execution_time(src.average_execution_time);
+    dst->set_min_state_change(src.min_state_change);
+    dst->set_max_state_change(src.max_state_change);
+    dst->set_average_state_change(src.average_state_change);
+    dst->set_checks_last_1min(src.checks_last_1min);
+    dst->set_checks_last_5min(src.checks_last_5min);
+    dst->set_checks_last_15min(src.checks_last_15min);
+    dst->set_checks_last_1hour(src.checks_last_1hour);
+  };
+
+  ServicesStats* sstats = response->mutable_services_stats();
+  sstats->set_services_count(data.services.count);
+  sstats->set_checked_services(data.services.checked);
+  sstats->set_scheduled_services(data.services.scheduled);
+  sstats->set_actively_checked(data.services.actively_checked);
+  sstats->set_passively_checked(data.services.passively_checked);
+  sstats->set_min_state_change(data.services.min_state_change);
+  sstats->set_max_state_change(data.services.max_state_change);
+  sstats->set_average_state_change(data.services.average_state_change);
+  fill_type(data.services.active, sstats->mutable_active_services());
+  fill_type(data.services.passive, sstats->mutable_passive_services());
+  sstats->set_ok(data.services.states[service::state_ok]);
+  sstats->set_warning(data.services.states[service::state_warning]);
+  sstats->set_critical(data.services.states[service::state_critical]);
+  sstats->set_unknown(data.services.states[service::state_unknown]);
+  sstats->set_flapping(data.services.flapping);
+  sstats->set_downtime(data.services.downtime);
+
+  HostsStats* hstats = response->mutable_hosts_stats();
+  hstats->set_hosts_count(data.hosts.count);
+  hstats->set_checked_hosts(data.hosts.checked);
+  hstats->set_scheduled_hosts(data.hosts.scheduled);
+  hstats->set_actively_checked(data.hosts.actively_checked);
+  hstats->set_passively_checked(data.hosts.passively_checked);
+  hstats->set_min_state_change(data.hosts.min_state_change);
+  hstats->set_max_state_change(data.hosts.max_state_change);
+  hstats->set_average_state_change(data.hosts.average_state_change);
+  fill_type(data.hosts.active, hstats->mutable_active_hosts());
+  fill_type(data.hosts.passive, hstats->mutable_passive_hosts());
+  hstats->set_up(data.hosts.states[host::state_up]);
+  hstats->set_down(data.hosts.states[host::state_down]);
+  hstats->set_unreachable(data.hosts.states[host::state_unreachable]);
+  hstats->set_flapping(data.hosts.flapping);
+  hstats->set_downtime(data.hosts.downtime);
+  return true;
+}
+
 void command_manager::schedule_and_propagate_downtime(
     host* temp_host,
     time_t entry_time,
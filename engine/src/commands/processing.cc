@@ -18,7 +18,9 @@
  */
 
 #include "com/centreon/engine/commands/processing.hh"
+#include <absl/strings/match.h>
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/commands.hh"
 #include "com/centreon/engine/flapping.hh"
 #include "com/centreon/engine/globals.hh"
@@ -27,6 +29,7 @@
 #include "com/centreon/engine/retention/dump.hh"
 #include "com/centreon/engine/retention/parser.hh"
 #include "com/centreon/engine/retention/state.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
@@ -908,6 +911,205 @@ bool processing::is_thread_safe(char const* cmd) {
   return it != _lst_command.end() && it->second.thread_safe;
 }
 
+/**
+ *  Check if a command is a PROCESS_SERVICE_CHECK_RESULT or a
+ *  PROCESS_HOST_CHECK_RESULT, i.e. a command that can be given to
+ *  execute_passive_check_results().
+ *
+ *  @param[in] cmd  Command to check.
+ *
+ *  @return True if command is a passive check result.
+ */
+bool processing::is_passive_check_result(std::string_view cmd) {
+  size_t pos = cmd.find_first_not_of("[]0123456789 ");
+  if (pos == std::string_view::npos)
+    return false;
+  cmd.remove_prefix(pos);
+  return absl::StartsWith(cmd, "PROCESS_SERVICE_CHECK_RESULT;") ||
+         absl::StartsWith(cmd, "PROCESS_HOST_CHECK_RESULT;");
+}
+
+namespace {
+/* Ids of the hosts resolved by execute_passive_check_results(), kept from a
+ * batch to the next one (0 for names not found). Only the command file
+ * worker uses it. Ids and not pointers are kept: a reload may delete a host
+ * while a batch is handled, so hosts are always looked up again in
+ * host::hosts_by_id. A configuration reload increments the generation, and
+ * the cache is emptied before the next batch.
+ */
+absl::flat_hash_map<std::string, uint64_t> passive_hosts_cache;
+uint64_t passive_hosts_cache_generation = 0;
+std::atomic<uint64_t> passive_hosts_generation{0};
+/* Names not found are also cached, this bounds what garbage sent to the
+ * command file can cost. */
+constexpr size_t passive_hosts_cache_max_size = 200000;
+}  // namespace
+
+/**
+ * @brief Forget the hosts resolved by execute_passive_check_results(). To
+ * call each time hosts are added or removed.
+ */
+void processing::invalidate_passive_check_cache() {
+  passive_hosts_generation.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Execute a batch of passive check results, as read from the command
+ * file. Each command is handled like execute() does (statistics, logs and
+ * broker events) but names are resolved without copy, with a cache kept
+ * until the next configuration reload, and the check results are queued in the checker with
+ * only one lock.
+ *
+ * @param cmds Commands accepted by is_passive_check_result(), without their
+ * trailing new line.
+ *
+ * @return The number of check results queued.
+ */
+size_t processing::execute_passive_check_results(
+    const std::vector<std::string_view>& cmds) {
+#ifdef LEGACY_CONF
+  bool accept_passive_service_checks = config->accept_passive_service_checks();
+  bool log_passive_checks_enabled = config->log_passive_checks();
+#else
+  bool accept_passive_service_checks =
+      pb_config.accept_passive_service_checks();
+  bool log_passive_checks_enabled = pb_config.log_passive_checks();
+#endif
+
+  /* Hosts may be given by their address, so the resolution of a name can be
+   * a full scan of the hosts. Names are only resolved once until the next
+   * configuration reload. */
+  uint64_t generation = passive_hosts_generation.load(std::memory_order_acquire);
+  if (generation != passive_hosts_cache_generation ||
+      passive_hosts_cache.size() > passive_hosts_cache_max_size) {
+    passive_hosts_cache.clear();
+    passive_hosts_cache_generation = generation;
+  }
+  auto find_host = [](std::string_view name) -> host* {
+    auto cached = passive_hosts_cache.find(name);
+    if (cached != passive_hosts_cache.end()) {
+      if (cached->second == 0)
+        return nullptr;
+      auto by_id = host::hosts_by_id.find(cached->second);
+      if (by_id != host::hosts_by_id.end() && by_id->second)
+        return by_id->second.get();
+      /* The host has been removed since, its name is resolved again. */
+      passive_hosts_cache.erase(cached);
+    }
+    host* found = nullptr;
+    host_map::const_iterator it = host::hosts.find(name);
+    if (it != host::hosts.end() && it->second)
+      found = it->second.get();
+    else {
+      for (auto& [_, h] : host::hosts) {
+        if (h && h->get_address() == name) {
+          found = h.get();
+          break;
+        }
+      }
+    }
+    passive_hosts_cache.emplace(name, found ? found->host_id() : 0);
+    return found;
+  };
+
+  std::vector<check_result::pointer> results;
+  results.reserve(cmds.size());
+  timeval now;
+  gettimeofday(&now, nullptr);
+
+  for (std::string_view cmd : cmds) {
+    size_t pos = cmd.find('[');
+    if (pos == std::string_view::npos)
+      continue;
+    cmd.remove_prefix(pos + 1);
+    while (!cmd.empty() && isspace(cmd.back()))
+      cmd.remove_suffix(1);
+    pos = cmd.find(']');
+    uint64_t entry_time;
+    if (pos == std::string_view::npos ||
+        !absl::SimpleAtoi(cmd.substr(0, pos), &entry_time) ||
+        pos + 1 >= cmd.size() || cmd[pos + 1] != ' ')
+      continue;
+    cmd.remove_prefix(pos + 2);
+    pos = cmd.find(';');
+    if (pos == std::string_view::npos)
+      continue;
+    std::string_view command_name = cmd.substr(0, pos);
+    std::string_view args = cmd.substr(pos + 1);
+    bool is_service = command_name == "PROCESS_SERVICE_CHECK_RESULT";
+    int command_id = is_service ? CMD_PROCESS_SERVICE_CHECK_RESULT
+                                : CMD_PROCESS_HOST_CHECK_RESULT;
+    time_t check_time = static_cast<time_t>(entry_time);
+
+    update_check_stats(EXTERNAL_COMMAND_STATS, now.tv_sec);
+    if (log_passive_checks_enabled) {
+      engine_logger(log_passive_check, basic)
+          << "EXTERNAL COMMAND: " << command_name << ';' << args;
+      checks_logger->info("EXTERNAL COMMAND: {};{}", command_name, args);
+    }
+
+    std::string args_str(args);
+    broker_external_command(NEBTYPE_EXTERNALCOMMAND_START, command_id,
+                            args_str.data(), nullptr);
+
+    /* Fields: host;service;return code;output or host;return code;output. */
+    std::vector<std::string_view> fields =
+        absl::StrSplit(args, absl::MaxSplits(';', is_service ? 3 : 2));
+    size_t code_idx = is_service ? 2 : 1;
+    int32_t return_code;
+    notifier* target = nullptr;
+    if (accept_passive_service_checks && fields.size() > code_idx &&
+        absl::SimpleAtoi(fields[code_idx], &return_code)) {
+      host* hst = find_host(fields[0]);
+      if (!hst) {
+        runtime_logger->warn(
+            "Warning:  Passive check result was received for host '{}', but "
+            "the host could not be found!",
+            fields[0]);
+      } else if (is_service) {
+        service_map::const_iterator found = service::services.find(
+            std::make_pair(std::string_view(hst->name()), fields[1]));
+        if (found == service::services.end() || !found->second)
+          runtime_logger->warn(
+              "Warning:  Passive check result was received for service '{}' "
+              "on host '{}', but the service could not be found!",
+              fields[1], fields[0]);
+        else if (found->second->passive_checks_enabled())
+          target = found->second.get();
+      } else if (return_code >= 0 && return_code <= 2 &&
+                 hst->passive_checks_enabled())
+        target = hst;
+    }
+
+    if (target) {
+      std::string output;
+      if (fields.size() > code_idx + 1) {
+        output = std::string(fields[code_idx + 1]);
+        string::unescape(output);
+      }
+      timeval check_tv = {.tv_sec = check_time, .tv_usec = 0};
+      double latency = static_cast<double>(now.tv_sec - check_time) +
+                       static_cast<double>(now.tv_usec / 1000000.0);
+      auto result = std::make_shared<check_result>(
+          is_service ? service_check : host_check, target,
+          checkable::check_passive, CHECK_OPTION_NONE, false,
+          latency < 0.0 ? 0.0 : latency, check_tv, check_tv, false, true,
+          return_code, std::move(output));
+      if (return_code < 0 || return_code > 3)
+        result->set_return_code(service::state_unknown);
+      results.push_back(std::move(result));
+    }
+
+    broker_external_command(NEBTYPE_EXTERNALCOMMAND_END, command_id,
+                            args_str.data(), nullptr);
+  }
+
+  size_t retval = results.size();
+  if (!results.empty())
+    checks::checker::instance().add_check_results_to_reap(results);
+  return retval;
+}
+
 void processing::_wrapper_read_state_information() {
   try {
     retention::state state;
@@ -0,0 +1,462 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/engine/commands/system_executor.hh"
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::commands;
+
+system_executor* system_executor::_instance = nullptr;
+
+/**
+ *  Get instance of the system_executor singleton.
+ *
+ *  @return This singleton.
+ */
+system_executor& system_executor::instance() {
+  assert(_instance);
+  return *_instance;
+}
+
+void system_executor::init() {
+  if (!_instance)
+    _instance = new system_executor;
+}
+
+/**
+ * @brief Destroy the singleton. The queued commands are still executed if
+ * they can be over before max_wait, otherwise the remaining ones are dropped
+ * and their callbacks are called with a crash status (see drop_waiting()).
+ * The running ones are always waited for, they are bounded by their own
+ * timeout.
+ *
+ * @param max_wait The maximum time spent to execute the queued commands.
+ */
+void system_executor::deinit(std::chrono::milliseconds max_wait) {
+  if (_instance) {
+    if (!_instance->wait_completion(std::chrono::steady_clock::now() +
+                                    max_wait))
+      _instance->drop_waiting();
+    _instance->wait_completion();
+    delete _instance;
+    _instance = nullptr;
+  }
+}
+
+system_executor::system_executor() : _running_count{}, _next_id{0} {}
+
+/**
+ * @brief Destructor. wait_completion() should have been called before, we
+ * still wait for the processes that could be running to not destroy them
+ * while the process manager uses them.
+ */
+system_executor::~system_executor() noexcept {
+  std::unique_lock<std::mutex> lck(_m);
+  _cv.wait(lck, [this] { return _running.size() == _finished.size(); });
+}
+
+/**
+ * @brief Tell if a new command of the given kind can be started now.
+ * Obsessive commands are started one after the other to keep their order.
+ *
+ * @param k The command kind.
+ *
+ * @return true if it can be started.
+ */
+bool system_executor::_can_start(kind k) const {
+  if (k == obsessive)
+    return _running_count[k] == 0;
+#ifdef LEGACY_CONF
+  uint32_t max_parallel = config->max_parallel_system_commands();
+#else
+  uint32_t max_parallel = pb_config.max_parallel_system_commands();
+#endif
+  return !max_parallel || _running_count[k] < max_parallel;
+}
+
+/**
+ * @brief Execute a system command in background, it is the asynchronous
+ * version of my_system_r().
+ *
+ * @param k The kind of command, each kind has its own queue.
+ * @param cmd The command line, macros already processed.
+ * @param macros The macros used to build the command environment.
+ * @param timeout The command timeout in seconds.
+ * @param on_finished Called from reap() when the command is over, or before
+ * returning if async_system_commands is disabled.
+ */
+void system_executor::run(kind k,
+                          const std::string& cmd,
+                          nagios_macros& macros,
+                          uint32_t timeout,
+                          callback&& on_finished) {
+  // if no command was passed, return with no error.
+  if (cmd.empty())
+    return;
+
+  auto j = std::make_unique<job>();
+  j->type = k;
+  j->cmd = cmd;
+  j->timeout = timeout;
+  raw::_build_environment_macros(macros, j->env);
+  j->on_finished = std::move(on_finished);
+  j->command_id = ++_next_id;
+
+#ifdef LEGACY_CONF
+  bool async = config->async_system_commands();
+#else
+  bool async = pb_config.async_system_commands();
+#endif
+  if (!async)
+    _run_sync(std::move(j));
+  else if (_waiting[k].empty() && _can_start(k))
+    _start(std::move(j));
+  else {
+    SPDLOG_LOGGER_DEBUG(commands_logger,
+                        "Command '{}' queued, {} commands already waiting",
+                        cmd, _waiting[k].size());
+    _waiting[k].push_back(std::move(j));
+  }
+}
+
+/**
+ * @brief Start the process of a job. This function is called from the main
+ * loop.
+ *
+ * @param j The job to start.
+ *
+ * @return The process running the job.
+ */
+process* system_executor::_start(std::unique_ptr<job>&& j) {
+  engine_logger(dbg_commands, more) << "Running command '" << j->cmd << "'...";
+  SPDLOG_LOGGER_DEBUG(commands_logger, "Running command '{}'...", j->cmd);
+
+  std::unique_ptr<process> p;
+  if (_free_processes.empty()) {
+    /* Only the out stream is open */
+    p = std::make_unique<process>(this, false, true, false);
+#ifdef LEGACY_CONF
+    p->setpgid_on_exec(config->use_setpgid());
+#else
+    p->setpgid_on_exec(pb_config.use_setpgid());
+#endif
+  } else {
+    p = std::move(_free_processes.front());
+    _free_processes.pop_front();
+  }
+
+  gettimeofday(&j->start_time, nullptr);
+
+  // send event broker.
+  broker_system_command(NEBTYPE_SYSTEM_COMMAND_START, NEBFLAG_NONE,
+                        NEBATTR_NONE, j->start_time, timeval(), 0.0,
+                        j->timeout, false, service::state_ok,
+                        const_cast<char*>(j->cmd.c_str()), nullptr, nullptr);
+
+  process* ptr = p.get();
+  const std::string& cmd = j->cmd;
+  uint32_t timeout = j->timeout;
+  char** env = j->env.data();
+  kind k = j->type;
+  {
+    std::lock_guard<std::mutex> lck(_m);
+    _running.emplace(ptr, std::make_pair(std::move(p), std::move(j)));
+  }
+  try {
+    ptr->exec(cmd.c_str(), env, timeout);
+  } catch (...) {
+    std::lock_guard<std::mutex> lck(_m);
+    _running.erase(ptr);
+    throw;
+  }
+  ++_running_count[k];
+  return ptr;
+}
+
+/**
+ * @brief Execute a job and wait for its end, its callback is called before
+ * returning. This function is called from the main loop.
+ *
+ * @param j The job to execute.
+ */
+void system_executor::_run_sync(std::unique_ptr<job>&& j) {
+  process* p = _start(std::move(j));
+  {
+    std::unique_lock<std::mutex> lck(_m);
+    _cv.wait(lck, [this, p] {
+      return std::find(_finished.begin(), _finished.end(), p) !=
+             _finished.end();
+    });
+  }
+  reap();
+}
+
+/**
+ * @brief Execute the end of a job: logs, broker callback and completion
+ * callback. This function is called from the main loop.
+ *
+ * @param p The process that executed the job, it is kept for the next ones.
+ * @param j The finished job.
+ */
+void system_executor::_complete(std::unique_ptr<process>&& p,
+                                std::unique_ptr<job>&& j) {
+  --_running_count[j->type];
+  _free_processes.push_back(std::move(p));
+
+  const result& res = j->res;
+  timeval end_time;
+  end_time.tv_sec = res.end_time.to_seconds();
+  end_time.tv_usec = res.end_time.to_useconds() - end_time.tv_sec * 1000000ull;
+  double exectime = (res.end_time - res.start_time).to_seconds();
+  bool early_timeout = res.exit_status == process::timeout;
+
+  engine_logger(dbg_commands, more)
+      << com::centreon::logging::setprecision(3)
+      << "Execution time=" << exectime
+      << " sec, early timeout=" << early_timeout
+      << ", result=" << res.exit_code << ", output=" << res.output;
+  SPDLOG_LOGGER_DEBUG(
+      commands_logger,
+      "Execution time={:.3f} sec, early timeout={}, result={}, output={}",
+      exectime, early_timeout, res.exit_code, res.output);
+
+  // send event broker.
+  broker_system_command(NEBTYPE_SYSTEM_COMMAND_END, NEBFLAG_NONE, NEBATTR_NONE,
+                        j->start_time, end_time, exectime, j->timeout,
+                        early_timeout, res.exit_code,
+                        const_cast<char*>(j->cmd.c_str()),
+                        const_cast<char*>(res.output.c_str()), nullptr);
+
+  if (j->on_finished)
+    j->on_finished(res);
+}
+
+/**
+ * @brief Handle the finished commands and start the queued ones. This
+ * function is called from the main loop.
+ */
+void system_executor::reap() {
+  std::vector<process*> finished;
+  {
+    std::lock_guard<std::mutex> lck(_m);
+    std::swap(finished, _finished);
+  }
+
+  for (process* p : finished) {
+    std::pair<std::unique_ptr<process>, std::unique_ptr<job>> running;
+    {
+      std::lock_guard<std::mutex> lck(_m);
+      auto found = _running.find(p);
+      running = std::move(found->second);
+      _running.erase(found);
+    }
+    _cv.notify_all();
+    try {
+      _complete(std::move(running.first), std::move(running.second));
+    } catch (const std::exception& e) {
+      SPDLOG_LOGGER_ERROR(runtime_logger,
+                          "Error: system command completion failed: {}",
+                          e.what());
+    }
+  }
+
+  for (uint32_t k = 0; k < kinds_count; ++k) {
+    auto& waiting = _waiting[k];
+    while (!waiting.empty() && _can_start(static_cast<kind>(k))) {
+      std::unique_ptr<job> j = std::move(waiting.front());
+      waiting.pop_front();
+      std::string cmd = j->cmd;
+      try {
+        _start(std::move(j));
+      } catch (const std::exception& e) {
+        engine_logger(log_runtime_error, basic)
+            << "Error: can't execute command line '" << cmd
+            << "' : " << e.what();
+        SPDLOG_LOGGER_ERROR(runtime_logger,
+                            "Error: can't execute command line '{}' : {}", cmd,
+                            e.what());
+      }
+    }
+  }
+}
+
+/**
+ * @brief Wait for all the running and queued commands to be over and handle
+ * them. This function is called from the main loop.
+ */
+void system_executor::wait_completion() {
+  for (;;) {
+    reap();
+    std::unique_lock<std::mutex> lck(_m);
+    if (_running.empty() && _finished.empty())
+      break;
+    _cv.wait(lck, [this] { return !_finished.empty(); });
+  }
+}
+
+/**
+ * @brief Wait for the running and queued commands to be over and handle them
+ * until the deadline. This function is called from the main loop.
+ *
+ * @param deadline The time after which we stop waiting.
+ *
+ * @return true if all the commands are over, false if the deadline has been
+ * reached.
+ */
+bool system_executor::wait_completion(
+    std::chrono::steady_clock::time_point deadline) {
+  for (;;) {
+    reap();
+    std::unique_lock<std::mutex> lck(_m);
+    if (_running.empty() && _finished.empty())
+      return true;
+    if (!_cv.wait_until(lck, deadline, [this] { return !_finished.empty(); }))
+      return false;
+  }
+}
+
+/**
+ * @brief Drop the queued commands, they are not executed. Each of them is
+ * logged since a dropped notification is never sent, and its callback is
+ * called with a crash status so that the end of the notification is still
+ * sent to the broker. This function is called from the main loop.
+ *
+ * @return The number of dropped commands.
+ */
+size_t system_executor::drop_waiting() {
+  static constexpr std::array<const char*, kinds_count> kind_names{
+      "notification", "event handler", "obsessive"};
+  size_t retval = 0;
+  for (uint32_t k = 0; k < kinds_count; ++k) {
+    std::deque<std::unique_ptr<job>> waiting;
+    std::swap(waiting, _waiting[k]);
+    for (const std::unique_ptr<job>& j : waiting) {
+      engine_logger(log_runtime_warning, basic)
+          << "Warning: " << kind_names[k] << " command '" << j->cmd
+          << "' dropped, it was still queued";
+      SPDLOG_LOGGER_WARN(runtime_logger,
+                         "Warning: {} command '{}' dropped, it was still "
+                         "queued",
+                         kind_names[k], j->cmd);
+      ++retval;
+      if (!j->on_finished)
+        continue;
+      result& res = j->res;
+      res.command_id = j->command_id;
+      res.start_time = timestamp::now();
+      res.end_time = res.start_time;
+      res.exit_code = service::state_unknown;
+      res.exit_status = process::crash;
+      res.output = "(Command dropped at shutdown)";
+      try {
+        j->on_finished(res);
+      } catch (const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(runtime_logger,
+                            "Error: system command completion failed: {}",
+                            e.what());
+      }
+    }
+  }
+  return retval;
+}
+
+/**
+ * @brief Number of running commands, finished commands not reaped yet
+ * included.
+ *
+ * @return A number of commands.
+ */
+size_t system_executor::running() const {
+  std::lock_guard<std::mutex> lck(_m);
+  return _running.size();
+}
+
+/**
+ * @brief Number of queued commands.
+ *
+ * @return A number of commands.
+ */
+size_t system_executor::waiting() const {
+  size_t retval = 0;
+  for (auto& w : _waiting)
+    retval += w.size();
+  return retval;
+}
+
+/**
+ *  Provide by process_listener interface but not used.
+ *
+ *  @param[in] p  Unused.
+ */
+void system_executor::data_is_available(process& p [[maybe_unused]]) noexcept {
+}
+
+/**
+ *  Provide by process_listener interface but not used.
+ *
+ *  @param[in] p  Unused.
+ */
+void system_executor::data_is_available_err(process& p
+                                            [[maybe_unused]]) noexcept {}
+
+/**
+ * @brief Provide by process_listener interface. Called from the process
+ * manager thread at the end of the process execution. The result is stored,
+ * it is handled by reap().
+ *
+ * @param p The finished process.
+ */
+void system_executor::finished(process& p) noexcept {
+  try {
+    std::lock_guard<std::mutex> lck(_m);
+    auto found = _running.find(&p);
+    if (found == _running.end()) {
+      SPDLOG_LOGGER_WARN(runtime_logger,
+                         "Warning: Invalid process pointer: "
+                         "process not found into running system commands");
+      return;
+    }
+    job& j = *found->second.second;
+    result& res = j.res;
+    p.read(res.output);
+    res.command_id = j.command_id;
+    res.start_time = p.start_time();
+    res.end_time = p.end_time();
+    res.exit_code = p.exit_code();
+    res.exit_status = p.exit_status();
+    if (res.exit_status == process::timeout) {
+      res.exit_code = service::state_unknown;
+      res.output = "(Process Timeout)";
+    } else if (res.exit_status == process::crash || res.exit_code < -1 ||
+               res.exit_code > 3)
+      res.exit_code = service::state_unknown;
+    _finished.push_back(&p);
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_WARN(runtime_logger,
+                       "Warning: system command termination routine failed: {}",
+                       e.what());
+  }
+  _cv.notify_all();
+}
@@ -1563,11 +1563,9 @@ void applier::scheduler::_schedule_host_events(
         (time_t)(now + (mult_factor * scheduling_info.host_inter_check_delay)));
 
     time_t time = hst.get_next_check();
-    engine_logger(dbg_events, most)
-        << "Preferred Check Time: " << hst.get_next_check() << " --> "
-        << my_ctime(&time);
-    events_logger->debug("Preferred Check Time: {} --> {}",
-                         hst.get_next_check(), my_ctime(&time));
+    ENGINE_LOG_DEBUG(dbg_events, most, events_logger,
+                     "Preferred Check Time: {} --> {}", hst.get_next_check(),
+                     my_ctime(&time));
 
     // Make sure the host can actually be scheduled at this time.
     {
@@ -1582,11 +1580,9 @@ void applier::scheduler::_schedule_host_events(
     }
 
     time = hst.get_next_check();
-    engine_logger(dbg_events, most)
-        << "Actual Check Time: " << hst.get_next_check() << " --> "
-        << my_ctime(&time);
-    events_logger->debug("Actual Check Time: {} --> {}", hst.get_next_check(),
-                         my_ctime(&time));
+    ENGINE_LOG_DEBUG(dbg_events, most, events_logger,
+                     "Actual Check Time: {} --> {}", hst.get_next_check(),
+                     my_ctime(&time));
 
     if (!scheduling_info.first_host_check ||
         (hst.get_next_check() < scheduling_info.first_host_check))
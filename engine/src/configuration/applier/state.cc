@@ -22,6 +22,7 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/commands/connector.hh"
 #include "com/centreon/engine/commands/otel_connector.hh"
+#include "com/centreon/engine/commands/processing.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/anomalydetection.hh"
 #include "com/centreon/engine/configuration/applier/command.hh"
@@ -48,6 +49,7 @@
 #include "com/centreon/engine/logging/broker_sink.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/retention/applier/state.hh"
+#include "com/centreon/engine/statistics.hh"
 #include "com/centreon/engine/version.hh"
 #include "com/centreon/engine/xsddefault.hh"
 #ifdef LEGACY_CONF
@@ -98,6 +100,7 @@ void applier::state::apply(configuration::state& new_cfg,
       _processing(save, err, state);
     }
   }
+  commands::processing::invalidate_passive_check_cache();
 }
 #else
 /**
@@ -129,6 +132,7 @@ void applier::state::apply(configuration::State& new_cfg,
       _processing(save, err, state);
     }
   }
+  commands::processing::invalidate_passive_check_cache();
 }
 #endif
 
@@ -143,6 +147,7 @@ applier::state& applier::state::instance() {
 }
 
 void applier::state::clear() {
+  commands::processing::invalidate_passive_check_cache();
   engine::contact::contacts.clear();
   engine::contactgroup::contactgroups.clear();
   engine::servicegroup::servicegroups.clear();
@@ -321,6 +326,7 @@ void applier::state::_apply(configuration::state const& new_cfg,
   config->check_orphaned_hosts(new_cfg.check_orphaned_hosts());
   config->check_orphaned_services(new_cfg.check_orphaned_services());
   config->check_reaper_interval(new_cfg.check_reaper_interval());
+  config->check_reaper_threads(new_cfg.check_reaper_threads());
   config->check_service_freshness(new_cfg.check_service_freshness());
   config->command_check_interval(new_cfg.command_check_interval(),
                                  new_cfg.command_check_interval_is_seconds());
@@ -398,6 +404,7 @@ void applier::state::_apply(configuration::state const& new_cfg,
   config->state_retention_file(new_cfg.state_retention_file());
   config->status_file(new_cfg.status_file());
   config->status_update_interval(new_cfg.status_update_interval());
+  config->status_file_incremental(new_cfg.status_file_incremental());
   config->time_change_threshold(new_cfg.time_change_threshold());
   config->use_large_installation_tweaks(
       new_cfg.use_large_installation_tweaks());
@@ -428,8 +435,14 @@ void applier::state::_apply(configuration::state const& new_cfg,
       new_cfg.use_send_recovery_notifications_anyways());
   config->use_host_down_disable_service_checks(
       new_cfg.use_host_down_disable_service_checks());
+  config->max_parallel_system_commands(new_cfg.max_parallel_system_commands());
+  config->async_system_commands(new_cfg.async_system_commands());
+  config->stats_shm_name(new_cfg.stats_shm_name());
   config->user(new_cfg.user());
 
+  if (!verify_config && !test_scheduling)
+    statistics::instance().open_shared_stats(new_cfg.stats_shm_name());
+
   // Set this variable just the first time.
   if (!has_already_been_loaded) {
     config->broker_module(new_cfg.broker_module());
@@ -606,6 +619,7 @@ void applier::state::_apply(const configuration::State& new_cfg,
   pb_config.set_check_orphaned_hosts(new_cfg.check_orphaned_hosts());
   pb_config.set_check_orphaned_services(new_cfg.check_orphaned_services());
   pb_config.set_check_reaper_interval(new_cfg.check_reaper_interval());
+  pb_config.set_check_reaper_threads(new_cfg.check_reaper_threads());
   pb_config.set_check_service_freshness(new_cfg.check_service_freshness());
   pb_config.set_command_check_interval(new_cfg.command_check_interval());
   pb_config.set_command_check_interval_is_seconds(
@@ -690,6 +704,7 @@ void applier::state::_apply(const configuration::State& new_cfg,
   pb_config.set_state_retention_file(new_cfg.state_retention_file());
   pb_config.set_status_file(new_cfg.status_file());
   pb_config.set_status_update_interval(new_cfg.status_update_interval());
+  pb_config.set_status_file_incremental(new_cfg.status_file_incremental());
   pb_config.set_time_change_threshold(new_cfg.time_change_threshold());
   pb_config.set_use_large_installation_tweaks(
       new_cfg.use_large_installation_tweaks());
@@ -724,10 +739,17 @@ void applier::state::_apply(const configuration::State& new_cfg,
       new_cfg.send_recovery_notifications_anyways());
   pb_config.set_host_down_disable_service_checks(
       new_cfg.host_down_disable_service_checks());
+  pb_config.set_max_parallel_system_commands(
+      new_cfg.max_parallel_system_commands());
+  pb_config.set_async_system_commands(new_cfg.async_system_commands());
+  pb_config.set_stats_shm_name(new_cfg.stats_shm_name());
   pb_config.clear_user();
   for (auto& p : new_cfg.user())
     pb_config.mutable_user()->at(p.first) = p.second;
 
+  if (!verify_config && !test_scheduling)
+    statistics::instance().open_shared_stats(new_cfg.stats_shm_name());
+
   // Set this variable just the first time.
   if (!has_already_been_loaded) {
     pb_config.mutable_broker_module()->CopyFrom(new_cfg.broker_module());
@@ -2071,6 +2093,9 @@ void applier::state::_processing(configuration::state& new_cfg,
     throw;
   }
 
+  // Objects may have changed, the status file has to be fully rebuilt.
+  xsddefault_invalidate_status_data();
+
   has_already_been_loaded = true;
   _processing_state = state_ready;
 }
@@ -2491,6 +2516,9 @@ void applier::state::_processing(configuration::State& new_cfg,
     throw;
   }
 
+  // Objects may have changed, the status file has to be fully rebuilt.
+  xsddefault_invalidate_status_data();
+
   has_already_been_loaded = true;
   _processing_state = state_ready;
 }
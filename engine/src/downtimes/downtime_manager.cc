@@ -34,6 +34,66 @@ using namespace com::centreon::engine::configuration::applier;
 using namespace com::centreon::engine::downtimes;
 using namespace com::centreon::engine::logging;
 
+/**
+ * @brief Insert a downtime in the scheduled downtimes and in all the indexes.
+ *
+ * @param dt The downtime to insert.
+ *
+ * @return An iterator to the downtime in _scheduled_downtimes.
+ */
+downtime_manager::downtime_map::iterator downtime_manager::_index(
+    const std::shared_ptr<downtime>& dt) {
+  auto it = _scheduled_downtimes.insert({dt->get_start_time(), dt});
+  _downtimes_by_id.try_emplace(dt->get_downtime_id(), it);
+  uint64_t service_id =
+      dt->get_type() == downtime::service_downtime
+          ? static_cast<service_downtime*>(dt.get())->service_id()
+          : 0;
+  _downtimes_by_object[{dt->host_id(), service_id}].push_back(dt);
+  _downtimes_by_end.insert({dt->get_end_time(), dt->get_downtime_id()});
+  return it;
+}
+
+/**
+ * @brief Remove a downtime from the scheduled downtimes and from all the
+ * indexes.
+ *
+ * @param it An iterator to the downtime in _scheduled_downtimes.
+ *
+ * @return The iterator following the removed one.
+ */
+downtime_manager::downtime_map::iterator downtime_manager::_unindex(
+    downtime_map::iterator it) {
+  const std::shared_ptr<downtime>& dt = it->second;
+  uint64_t downtime_id = dt->get_downtime_id();
+  auto found_id = _downtimes_by_id.find(downtime_id);
+  if (found_id != _downtimes_by_id.end() && found_id->second == it)
+    _downtimes_by_id.erase(found_id);
+
+  uint64_t service_id =
+      dt->get_type() == downtime::service_downtime
+          ? static_cast<service_downtime*>(dt.get())->service_id()
+          : 0;
+  auto found_obj = _downtimes_by_object.find({dt->host_id(), service_id});
+  if (found_obj != _downtimes_by_object.end()) {
+    auto& lst = found_obj->second;
+    auto found_dt = std::find(lst.begin(), lst.end(), dt);
+    if (found_dt != lst.end())
+      lst.erase(found_dt);
+    if (lst.empty())
+      _downtimes_by_object.erase(found_obj);
+  }
+
+  auto range = _downtimes_by_end.equal_range(dt->get_end_time());
+  for (auto end_it = range.first; end_it != range.second; ++end_it) {
+    if (end_it->second == downtime_id) {
+      _downtimes_by_end.erase(end_it);
+      break;
+    }
+  }
+  return _scheduled_downtimes.erase(it);
+}
+
 /**
  *  Remove a service/host downtime from its id.
  *
@@ -44,27 +104,18 @@ using namespace com::centreon::engine::logging;
 void downtime_manager::delete_downtime(uint64_t downtime_id) {
   SPDLOG_LOGGER_TRACE(functions_logger, "delete_downtime({})", downtime_id);
   /* find the downtime we should remove */
-  for (auto it = _scheduled_downtimes.begin(), end = _scheduled_downtimes.end();
-       it != end; ++it) {
-    if (it->second->get_downtime_id() == downtime_id) {
-      engine_logger(dbg_downtime, basic)
-          << "delete downtime(id: " << downtime_id << ")";
-      SPDLOG_LOGGER_TRACE(downtimes_logger, "delete downtime(id: {})",
-                          downtime_id);
-      _scheduled_downtimes.erase(it);
-      break;
-    }
+  auto found = _downtimes_by_id.find(downtime_id);
+  if (found != _downtimes_by_id.end()) {
+    engine_logger(dbg_downtime, basic)
+        << "delete downtime(id: " << downtime_id << ")";
+    SPDLOG_LOGGER_TRACE(downtimes_logger, "delete downtime(id: {})",
+                        downtime_id);
+    _unindex(found->second);
   }
 }
 
 /* unschedules a host or service downtime */
 int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
-  auto found = std::find_if(
-      _scheduled_downtimes.begin(), _scheduled_downtimes.end(),
-      [&downtime_id](std::pair<time_t, std::shared_ptr<downtime>> d) {
-        return downtime_id == d.second->get_downtime_id();
-      });
-
   engine_logger(dbg_functions, basic) << "unschedule_downtime()";
   SPDLOG_LOGGER_TRACE(functions_logger, "unschedule_downtime()");
   engine_logger(dbg_downtime, basic)
@@ -73,20 +124,21 @@ int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
                       downtime_id);
 
   /* find the downtime entry in the list in memory */
-  if (found == _scheduled_downtimes.end()) {
+  auto found = _downtimes_by_id.find(downtime_id);
+  if (found == _downtimes_by_id.end()) {
     SPDLOG_LOGGER_DEBUG(downtimes_logger, "unknown downtime(id: {})",
                         downtime_id);
     return ERROR;
   }
 
-  if (found->second->unschedule() == ERROR)
+  if (found->second->second->unschedule() == ERROR)
     return ERROR;
 
   /* remove scheduled entry from event queue */
   events::loop::instance().remove_downtime(downtime_id);
 
-  /* delete downtime entry */
-  _scheduled_downtimes.erase(found);
+  /* delete downtime entry, unschedule() may have modified the indexes */
+  delete_downtime(downtime_id);
 
   /* unschedule all downtime entries that were triggered by this one */
   std::list<uint64_t> lst;
@@ -110,16 +162,13 @@ int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
 std::shared_ptr<downtime> downtime_manager::find_downtime(
     downtime::type type,
     uint64_t downtime_id) {
-  for (std::multimap<time_t, std::shared_ptr<downtime>>::iterator
-           it{_scheduled_downtimes.begin()},
-       end{_scheduled_downtimes.end()};
-       it != end; ++it) {
-    if (type != downtime::any_downtime && it->second->get_type() != type)
-      continue;
-    if (it->second->get_downtime_id() == downtime_id)
-      return it->second;
-  }
-  return nullptr;
+  auto found = _downtimes_by_id.find(downtime_id);
+  if (found == _downtimes_by_id.end())
+    return nullptr;
+  const std::shared_ptr<downtime>& dt = found->second->second;
+  if (type != downtime::any_downtime && dt->get_type() != type)
+    return nullptr;
+  return dt;
 }
 
 /* checks for flexible (non-fixed) host downtime that should start now */
@@ -138,38 +187,30 @@ int downtime_manager::check_pending_flex_host_downtime(host* hst) {
   if (hst->get_current_state() == host::state_up)
     return OK;
 
-  /* check all downtime entries */
-  for (std::multimap<time_t, std::shared_ptr<downtime>>::iterator
-           it{_scheduled_downtimes.begin()},
-       end{_scheduled_downtimes.end()};
-       it != end; ++it) {
-    if (it->second->get_type() != downtime::host_downtime ||
-        it->second->is_fixed() || it->second->is_in_effect() ||
-        it->second->get_triggered_by() != 0)
+  /* check downtime entries of this host, they are copied because handle()
+   * may modify the index */
+  auto found = _downtimes_by_object.find({hst->host_id(), 0});
+  if (found == _downtimes_by_object.end())
+    return OK;
+  std::vector<std::shared_ptr<downtime>> dts(found->second);
+  for (const std::shared_ptr<downtime>& dt : dts) {
+    if (dt->get_type() != downtime::host_downtime || dt->is_fixed() ||
+        dt->is_in_effect() || dt->get_triggered_by() != 0)
       continue;
 
-    /* this entry matches our host! */
-    host* temp_host(nullptr);
-    host_id_map::const_iterator it_hg =
-        host::hosts_by_id.find(it->second->host_id());
-    if (it_hg != host::hosts_by_id.end())
-      temp_host = it_hg->second.get();
-
-    if (temp_host == hst) {
-      /* if the time boundaries are okay, start this scheduled downtime */
-      if (it->second->get_start_time() <= current_time &&
-          current_time <= it->second->get_end_time()) {
-        engine_logger(dbg_downtime, basic)
-            << "Flexible downtime (id=" << it->second->get_downtime_id()
-            << ") for host '" << hst->name() << "' starting now...";
-        SPDLOG_LOGGER_TRACE(
-            downtimes_logger,
-            "Flexible downtime (id={}) for host '{}' starting now...",
-            it->second->get_downtime_id(), hst->name());
-
-        it->second->start_flex_downtime();
-        it->second->handle();
-      }
+    /* if the time boundaries are okay, start this scheduled downtime */
+    if (dt->get_start_time() <= current_time &&
+        current_time <= dt->get_end_time()) {
+      engine_logger(dbg_downtime, basic)
+          << "Flexible downtime (id=" << dt->get_downtime_id()
+          << ") for host '" << hst->name() << "' starting now...";
+      SPDLOG_LOGGER_TRACE(
+          downtimes_logger,
+          "Flexible downtime (id={}) for host '{}' starting now...",
+          dt->get_downtime_id(), hst->name());
+
+      dt->start_flex_downtime();
+      dt->handle();
     }
   }
   return OK;
@@ -193,57 +234,52 @@ int downtime_manager::check_pending_flex_service_downtime(service* svc) {
   if (svc->get_current_state() == service::state_ok)
     return OK;
 
-  /* check all downtime entries */
-  for (std::multimap<time_t, std::shared_ptr<downtime>>::iterator
-           it{_scheduled_downtimes.begin()},
-       end{_scheduled_downtimes.end()};
-       it != end; ++it) {
-    if (it->second->get_type() != downtime::service_downtime ||
-        it->second->is_fixed() || it->second->is_in_effect() ||
-        it->second->get_triggered_by() != 0)
+  /* check downtime entries of this service, they are copied because
+   * handle() may modify the index */
+  auto found = _downtimes_by_object.find({svc->host_id(), svc->service_id()});
+  if (found == _downtimes_by_object.end())
+    return OK;
+  std::vector<std::shared_ptr<downtime>> dts(found->second);
+  for (const std::shared_ptr<downtime>& dt : dts) {
+    if (dt->get_type() != downtime::service_downtime || dt->is_fixed() ||
+        dt->is_in_effect() || dt->get_triggered_by() != 0)
       continue;
 
-    service_downtime& dt(
-        *std::static_pointer_cast<service_downtime>(it->second));
-
-    auto found = service::services_by_id.find(
-        std::make_pair(dt.host_id(), dt.service_id()));
-
-    /* this entry matches our service! */
-    if (found != service::services_by_id.end() && found->second.get() == svc) {
-      /* if the time boundaries are okay, start this scheduled downtime */
-      if (dt.get_start_time() <= current_time &&
-          current_time <= dt.get_end_time()) {
-        engine_logger(dbg_downtime, basic)
-            << "Flexible downtime (id=" << dt.get_downtime_id()
-            << ") for service '" << svc->description() << "' on host '"
-            << svc->get_hostname() << "' starting now...";
-        SPDLOG_LOGGER_TRACE(
-            downtimes_logger,
-            "Flexible downtime (id={}) for service '{}' on host '{}' starting "
-            "now...",
-            dt.get_downtime_id(), svc->description(), svc->get_hostname());
-
-        dt.start_flex_downtime();
-        dt.handle();
-      }
+    /* if the time boundaries are okay, start this scheduled downtime */
+    if (dt->get_start_time() <= current_time &&
+        current_time <= dt->get_end_time()) {
+      engine_logger(dbg_downtime, basic)
+          << "Flexible downtime (id=" << dt->get_downtime_id()
+          << ") for service '" << svc->description() << "' on host '"
+          << svc->get_hostname() << "' starting now...";
+      SPDLOG_LOGGER_TRACE(
+          downtimes_logger,
+          "Flexible downtime (id={}) for service '{}' on host '{}' starting "
+          "now...",
+          dt->get_downtime_id(), svc->description(), svc->get_hostname());
+
+      dt->start_flex_downtime();
+      dt->handle();
     }
   }
   return OK;
 }
 
-std::multimap<time_t, std::shared_ptr<downtime>> const&
+downtime_manager::downtime_map const&
 downtime_manager::get_scheduled_downtimes() const {
   return _scheduled_downtimes;
 }
 
 void downtime_manager::clear_scheduled_downtimes() {
   _scheduled_downtimes.clear();
+  _downtimes_by_id.clear();
+  _downtimes_by_object.clear();
+  _downtimes_by_end.clear();
 }
 
 void downtime_manager::add_downtime(
     const std::shared_ptr<downtime>& dt) noexcept {
-  _scheduled_downtimes.insert({dt->get_start_time(), dt});
+  _index(dt);
 }
 
 int downtime_manager::check_for_expired_downtime() {
@@ -254,15 +290,21 @@ int downtime_manager::check_for_expired_downtime() {
 
   time(&current_time);
 
-  /* check all downtime entries... */
-  auto next_it = downtime_manager::instance()._scheduled_downtimes.begin();
-  for (auto it = _scheduled_downtimes.begin(), end = _scheduled_downtimes.end();
-       it != end; it = next_it) {
-    downtime& dt(*it->second);
-    ++next_it;
+  /* check downtime entries already ended... */
+  std::vector<std::shared_ptr<downtime>> ended;
+  for (auto it = _downtimes_by_end.begin(), end = _downtimes_by_end.end();
+       it != end && it->first < current_time; ++it) {
+    std::shared_ptr<downtime> dt = find_downtime(downtime::any_downtime,
+                                                 it->second);
+    if (dt)
+      ended.push_back(std::move(dt));
+  }
+
+  for (const std::shared_ptr<downtime>& ended_dt : ended) {
+    downtime& dt(*ended_dt);
 
     /* this entry should be removed */
-    if (!dt.is_in_effect() && dt.get_end_time() < current_time) {
+    if (!dt.is_in_effect()) {
       engine_logger(dbg_downtime, basic)
           << "Expiring "
           << (dt.get_type() == downtime::host_downtime ? "host" : "service")
@@ -307,9 +349,7 @@ int downtime_manager::
       comment.empty())
     return deleted;
 
-  std::pair<std::multimap<time_t, std::shared_ptr<downtime>>::iterator,
-            std::multimap<time_t, std::shared_ptr<downtime>>::iterator>
-      range;
+  std::pair<downtime_map::iterator, downtime_map::iterator> range;
 
   if (start_time.first)
     range = _scheduled_downtimes.equal_range(start_time.second);
@@ -348,8 +388,7 @@ int downtime_manager::
 void downtime_manager::insert_downtime(std::shared_ptr<downtime> dt) {
   engine_logger(dbg_functions, basic) << "downtime_manager::insert_downtime()";
   SPDLOG_LOGGER_TRACE(functions_logger, "downtime_manager::insert_downtime()");
-  time_t start{dt->get_start_time()};
-  _scheduled_downtimes.insert({start, dt});
+  _index(dt);
 }
 
 /**
@@ -381,7 +420,7 @@ int downtime_manager::xdddefault_validate_downtime_data() {
     /* delete downtimes with invalid host names, invalid service descriptions
      * or that have expired. */
     if (temp_downtime->is_stale())
-      it = _scheduled_downtimes.erase(it);
+      it = _unindex(it);
     else
       ++it;
   }
@@ -403,7 +442,7 @@ int downtime_manager::xdddefault_validate_downtime_data() {
 
     /* delete the downtime */
     if (!save)
-      it = _scheduled_downtimes.erase(it);
+      it = _unindex(it);
     else
       ++it;
   }
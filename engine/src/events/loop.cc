@@ -24,6 +24,7 @@
 #include <future>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/command_manager.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/extended_conf.hh"
 #include "com/centreon/engine/globals.hh"
@@ -226,36 +227,27 @@ void loop::_dispatching() {
     _last_time = current_time;
 
     // Log messages about event lists.
-    engine_logger(dbg_events, more) << "** Event Check Loop";
-    events_logger->debug("** Event Check Loop");
+    ENGINE_LOG_DEBUG(dbg_events, more, events_logger, "** Event Check Loop");
     if (!_event_list_high.empty()) {
-      engine_logger(dbg_events, more)
-          << "Next High Priority Event Time: "
-          << my_ctime(&(*_event_list_high.begin())->run_time);
-      events_logger->debug("Next High Priority Event Time: {}",
-                           my_ctime(&(*_event_list_high.begin())->run_time));
+      ENGINE_LOG_DEBUG(dbg_events, more, events_logger,
+                       "Next High Priority Event Time: {}",
+                       my_ctime(&(*_event_list_high.begin())->run_time));
     } else {
-      engine_logger(dbg_events, more)
-          << "No high priority events are scheduled...";
-      events_logger->debug("No high priority events are scheduled...");
+      ENGINE_LOG_DEBUG(dbg_events, more, events_logger,
+                       "No high priority events are scheduled...");
     }
     if (!_event_list_low.empty()) {
-      engine_logger(dbg_events, more)
-          << "Next Low Priority Event Time:  "
-          << my_ctime(&(*_event_list_low.begin())->run_time);
-      events_logger->debug("Next Low Priority Event Time:  {}",
-                           my_ctime(&(*_event_list_low.begin())->run_time));
+      ENGINE_LOG_DEBUG(dbg_events, more, events_logger,
+                       "Next Low Priority Event Time:  {}",
+                       my_ctime(&(*_event_list_low.begin())->run_time));
     } else {
-      engine_logger(dbg_events, more)
-          << "No low priority events are scheduled...";
-      events_logger->debug("No low priority events are scheduled...");
+      ENGINE_LOG_DEBUG(dbg_events, more, events_logger,
+                       "No low priority events are scheduled...");
     }
-    engine_logger(dbg_events, more)
-        << "Current/Max Service Checks: " << currently_running_service_checks
-        << '/' << max_parallel_service_checks;
-    events_logger->debug("Current/Max Service Checks: {}/{}",
-                         currently_running_service_checks,
-                         max_parallel_service_checks);
+    ENGINE_LOG_DEBUG(dbg_events, more, events_logger,
+                     "Current/Max Service Checks: {}/{}",
+                     currently_running_service_checks,
+                     max_parallel_service_checks);
 
     // Update status information occassionally - NagVis watches the
     // NDOUtils DB to see if Engine is alive.
@@ -333,12 +325,9 @@ void loop::_dispatching() {
 
         // Don't run a service check if active checks are disabled.
         if (!execute_service_checks) {
-          engine_logger(dbg_events | dbg_checks, more)
-              << "We're not executing service checks right now, "
-              << "so we'll skip this event.";
-          events_logger->debug(
-              "We're not executing service checks right now, so we'll skip "
-              "this event.");
+          ENGINE_LOG_DEBUG(dbg_events | dbg_checks, more, events_logger,
+                           "We're not executing service checks right now, so "
+                           "we'll skip this event.");
           run_event = false;
         }
 
@@ -389,12 +378,9 @@ void loop::_dispatching() {
 
         // Don't run a host check if active checks are disabled.
         if (!execute_host_checks) {
-          engine_logger(dbg_events | dbg_checks, more)
-              << "We're not executing host checks right now, "
-              << "so we'll skip this event.";
-          events_logger->debug(
-              "We're not executing host checks right now, so we'll skip this "
-              "event.");
+          ENGINE_LOG_DEBUG(dbg_events | dbg_checks, more, events_logger,
+                           "We're not executing host checks right now, so "
+                           "we'll skip this event.");
           run_event = false;
         }
 
@@ -436,8 +422,7 @@ void loop::_dispatching() {
         // We may have just removed the only item from the list.
 
         // Handle the event.
-        engine_logger(dbg_events, more) << "Running event...";
-        events_logger->debug("Running event...");
+        ENGINE_LOG_DEBUG(dbg_events, more, events_logger, "Running event...");
         temp_event->handle_timed_event();
 
         // Reschedule the event if necessary.
@@ -446,9 +431,8 @@ void loop::_dispatching() {
       }
       // Wait a while so we don't hog the CPU...
       else {
-        engine_logger(dbg_events, most)
-            << "Did not execute scheduled event. Idling for a bit...";
-        events_logger->debug(
+        ENGINE_LOG_DEBUG(
+            dbg_events, most, events_logger,
             "Did not execute scheduled event. Idling for a bit...");
         uint64_t d = static_cast<uint64_t>(sleep_time * 1000000000);
         std::this_thread::sleep_for(std::chrono::nanoseconds(d));
@@ -459,9 +443,8 @@ void loop::_dispatching() {
               current_time < (*_event_list_high.begin())->run_time) &&
              (_event_list_low.empty() ||
               current_time < (*_event_list_low.begin())->run_time)) {
-      engine_logger(dbg_events, most)
-          << "No events to execute at the moment. Idling for a bit...";
-      events_logger->debug(
+      ENGINE_LOG_DEBUG(
+          dbg_events, most, events_logger,
           "No events to execute at the moment. Idling for a bit...");
 
       // Check for external commands if we're supposed to check as
@@ -476,6 +459,7 @@ void loop::_dispatching() {
       auto delay = std::chrono::nanoseconds(
           static_cast<uint64_t>(1000000000 * sleep_time));
       command_manager::instance().execute();
+      commands::system_executor::instance().reap();
 
       // Set time to sleep so we don't hog the CPU...
       timespec stime;
@@ -865,8 +849,7 @@ void loop::compensate_for_system_time_change(unsigned long last_time,
  */
 void loop::add_event(std::unique_ptr<timed_event>&& event,
                      loop::priority priority) {
-  engine_logger(dbg_functions, basic) << "add_event()";
-  functions_logger->trace("add_event()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger, "add_event()");
 
   timed_event_list* list;
 
@@ -901,8 +884,8 @@ void loop::add_event(std::unique_ptr<timed_event>&& event,
 }
 
 void loop::remove_downtime(uint64_t downtime_id) {
-  engine_logger(dbg_functions, basic) << "loop::remove_downtime()";
-  functions_logger->trace("loop::remove_downtime()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "loop::remove_downtime()");
 
   for (auto it = _event_list_high.begin(), end = _event_list_high.end();
        it != end; ++it) {
@@ -926,8 +909,8 @@ void loop::remove_downtime(uint64_t downtime_id) {
  */
 void loop::remove_event(timed_event_list::iterator& it,
                         loop::priority priority) {
-  engine_logger(dbg_functions, basic) << "loop::remove_event()";
-  functions_logger->trace("loop::remove_event()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "loop::remove_event()");
 
   if (priority == loop::low)
     _event_list_low.erase(it);
@@ -942,8 +925,8 @@ void loop::remove_event(timed_event_list::iterator& it,
  *  @param[in]     priority        This is to know which list to work with.
  */
 void loop::remove_event(timed_event* evt, loop::priority priority) {
-  engine_logger(dbg_functions, basic) << "loop::remove_event()";
-  functions_logger->trace("loop::remove_event()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "loop::remove_event()");
   timed_event_list* list;
   if (priority == loop::low)
     list = &_event_list_low;
@@ -979,8 +962,8 @@ timed_event_list::iterator loop::find_event(loop::priority priority,
                                             void* data) {
   timed_event_list* list;
 
-  engine_logger(dbg_functions, basic) << "resort_event_list()";
-  functions_logger->trace("resort_event_list()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "resort_event_list()");
 
   // move current event list to temp list.
   if (priority == loop::low)
@@ -1004,8 +987,8 @@ timed_event_list::iterator loop::find_event(loop::priority priority,
  */
 void loop::reschedule_event(std::unique_ptr<timed_event>&& event,
                             loop::priority priority) {
-  engine_logger(dbg_functions, basic) << "reschedule_event()";
-  functions_logger->trace("reschedule_event()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "reschedule_event()");
 
   // reschedule recurring events...
   if (event->recurring) {
@@ -1043,8 +1026,8 @@ void loop::reschedule_event(std::unique_ptr<timed_event>&& event,
 void loop::resort_event_list(loop::priority priority) {
   timed_event_list* list;
 
-  engine_logger(dbg_functions, basic) << "resort_event_list()";
-  functions_logger->trace("resort_event_list()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "resort_event_list()");
 
   // move current event list to temp list.
   if (priority == loop::low)
@@ -23,6 +23,7 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/command_manager.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
 #include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/exceptions/error.hh"
@@ -189,6 +190,7 @@ void timed_event::_exec_event_check_reaper() {
   // reap host and service check results.
   try {
     checks::checker::instance().reap();
+    commands::system_executor::instance().reap();
   } catch (std::exception const& e) {
     engine_logger(log_runtime_error, basic) << "Error: " << e.what();
     runtime_logger->error("Error: {}", e.what());
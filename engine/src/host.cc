@@ -22,6 +22,7 @@
 
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/whitelist.hh"
@@ -379,6 +380,7 @@ bool host::get_process_performance_data() const {
 
 void host::set_process_performance_data(bool process_performance_data) {
   _process_performance_data = process_performance_data;
+  set_status_dirty(true);
 }
 
 const std::string& host::get_vrml_image() const {
@@ -467,6 +469,7 @@ time_t host::get_last_time_down() const {
 
 void host::set_last_time_down(time_t last_time) {
   _last_time_down = last_time;
+  set_status_dirty(true);
 }
 
 time_t host::get_last_time_unreachable() const {
@@ -475,6 +478,7 @@ time_t host::get_last_time_unreachable() const {
 
 void host::set_last_time_unreachable(time_t last_time) {
   _last_time_unreachable = last_time;
+  set_status_dirty(true);
 }
 
 time_t host::get_last_time_up() const {
@@ -483,6 +487,7 @@ time_t host::get_last_time_up() const {
 
 void host::set_last_time_up(time_t last_time) {
   _last_time_up = last_time;
+  set_status_dirty(true);
 }
 
 bool host::get_should_reschedule_current_check() const {
@@ -540,6 +545,7 @@ enum host::host_state host::get_current_state() const {
 
 void host::set_current_state(enum host::host_state current_state) {
   _current_state = current_state;
+  set_status_dirty(true);
 }
 
 enum host::host_state host::get_last_state() const {
@@ -556,6 +562,7 @@ enum host::host_state host::get_last_hard_state() const {
 
 void host::set_last_hard_state(enum host::host_state last_hard_state) {
   _last_hard_state = last_hard_state;
+  set_status_dirty(true);
 }
 
 enum host::host_state host::get_initial_state() const {
@@ -1231,8 +1238,7 @@ int host::log_event() {
 }
 
 /* process results of an asynchronous host check */
-int host::handle_async_check_result_3x(
-    const check_result& queued_check_result) {
+int host::handle_async_check_result_3x(check_result& queued_check_result) {
   enum service::service_state svc_res{service::state_ok};
   enum host::host_state hst_res{host::state_up};
   int reschedule_check{false};
@@ -1436,12 +1442,11 @@ int host::handle_async_check_result_3x(
   /* parse check output to get: (1) short output, (2) long output, (3) perf data
    */
 
-  std::string output{queued_check_result.get_output()};
   std::string plugin_output;
   std::string long_plugin_output;
   std::string perf_data;
-  parse_check_output(output, plugin_output, long_plugin_output, perf_data, true,
-                     false);
+  queued_check_result.take_parsed_output(plugin_output, long_plugin_output,
+                                         perf_data);
   set_plugin_output(plugin_output);
   set_long_plugin_output(long_plugin_output);
   set_perf_data(perf_data);
@@ -1679,10 +1684,9 @@ int host::run_scheduled_check(int check_options, double latency) {
         set_next_check(next_valid_time);
         set_should_be_scheduled(true);
 
-        engine_logger(dbg_checks, more)
-            << "Rescheduled next host check for " << my_ctime(&next_valid_time);
-        SPDLOG_LOGGER_DEBUG(checks_logger, "Rescheduled next host check for {}",
-                            my_ctime(&next_valid_time));
+        ENGINE_LOG_DEBUG(dbg_checks, more, checks_logger,
+                         "Rescheduled next host check for {}",
+                         my_ctime(&next_valid_time));
       }
     }
 
@@ -1907,16 +1911,12 @@ int host::run_async_check(int check_options,
 bool host::schedule_check(time_t check_time,
                           uint32_t options,
                           bool no_update_status_now) {
-  engine_logger(dbg_functions, basic) << "schedule_host_check()";
-  SPDLOG_LOGGER_TRACE(functions_logger, "schedule_host_check()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "schedule_host_check()");
 
-  engine_logger(dbg_checks, basic)
-      << "Scheduling a "
-      << (options & CHECK_OPTION_FORCE_EXECUTION ? "forced" : "non-forced")
-      << ", active check of host '" << name() << "' @ "
-      << my_ctime(&check_time);
-  SPDLOG_LOGGER_TRACE(
-      checks_logger, "Scheduling a {}, active check of host '{}' @ {}",
+  ENGINE_LOG_TRACE(
+      dbg_checks, basic, checks_logger,
+      "Scheduling a {}, active check of host '{}' @ {}",
       options & CHECK_OPTION_FORCE_EXECUTION ? "forced" : "non-forced", name(),
       my_ctime(&check_time));
 
@@ -1947,12 +1947,9 @@ bool host::schedule_check(time_t check_time,
    * we do? */
   if (found != events::loop::instance().list_end(events::loop::low)) {
     auto& temp_event = *found;
-    engine_logger(dbg_checks, most)
-        << "Found another host check event for this host @ "
-        << my_ctime(&temp_event->run_time);
-    SPDLOG_LOGGER_DEBUG(checks_logger,
-                        "Found another host check event for this host @ {}",
-                        my_ctime(&temp_event->run_time));
+    ENGINE_LOG_DEBUG(dbg_checks, most, checks_logger,
+                     "Found another host check event for this host @ {}",
+                     my_ctime(&temp_event->run_time));
     /* use the originally scheduled check unless we decide otherwise */
     use_original_event = true;
 
@@ -2609,6 +2606,74 @@ void host::grab_macros_r(nagios_macros* mac) {
   grab_host_macros_r(mac, this);
 }
 
+namespace {
+/**
+ *  The notification commands of a contact run in background. The end of each
+ *  command and the end of the whole notification are sent to the broker
+ *  once the commands are over. The host and the contact are looked up again
+ *  by name then: a reload may have removed them meanwhile.
+ */
+struct host_notification_end {
+  std::string host_name;
+  std::string contact_name;
+  notifier::reason_type type;
+  std::string author;
+  std::string data;
+  int escalated;
+  timeval start_time;
+  uint32_t running = 0;
+};
+
+/**
+ *  Send the end of a notification method to the broker.
+ *
+ *  @param[in] n                  The notification.
+ *  @param[in] method_start_time  The start time of the method.
+ */
+void end_host_notification_method(const host_notification_end& n,
+                                  const timeval& method_start_time) {
+  auto hst = host::hosts.find(n.host_name);
+  auto cntct = contact::contacts.find(n.contact_name);
+  if (hst == host::hosts.end() || cntct == contact::contacts.end())
+    return;
+
+  timeval method_end_time;
+  gettimeofday(&method_end_time, nullptr);
+  broker_contact_notification_method_data(
+      NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
+      notifier::host_notification, n.type, method_start_time,
+      method_end_time, hst->second.get(), cntct->second.get(), n.author.c_str(),
+      n.data.c_str(), n.escalated, nullptr);
+}
+
+/**
+ *  Update the contact's last host notification time and send the end of the
+ *  notification to the broker.
+ *
+ *  @param[in] n  The notification.
+ */
+void end_host_notification(const host_notification_end& n) {
+  auto hst = host::hosts.find(n.host_name);
+  auto cntct = contact::contacts.find(n.contact_name);
+  if (hst == host::hosts.end() || cntct == contact::contacts.end()) {
+    notifications_logger->debug(
+        "Host '{}' or contact '{}' removed before the end of their "
+        "notification",
+        n.host_name, n.contact_name);
+    return;
+  }
+
+  timeval end_time;
+  gettimeofday(&end_time, nullptr);
+  cntct->second->set_last_host_notification(n.start_time.tv_sec);
+  broker_contact_notification_data(
+      NEBTYPE_CONTACTNOTIFICATION_END, NEBFLAG_NONE, NEBATTR_NONE,
+      notifier::host_notification, n.type, n.start_time, end_time,
+      hst->second.get(), cntct->second.get(), n.author.c_str(), n.data.c_str(),
+      n.escalated, nullptr);
+}
+}  // namespace
+
 /* notify a specific contact that an entire host is down or up */
 int host::notify_contact(nagios_macros* mac,
                          contact* cntct,
@@ -2619,8 +2684,6 @@ int host::notify_contact(nagios_macros* mac,
                          int escalated) {
   std::string raw_command;
   std::string processed_command;
-  bool early_timeout = false;
-  double exectime;
   struct timeval start_time, end_time;
   struct timeval method_start_time, method_end_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
@@ -2657,6 +2720,12 @@ int host::notify_contact(nagios_macros* mac,
   else if (NEBERROR_CALLBACKOVERRIDE == neb_result)
     return OK;
 
+  /* the end of the notification is sent once its last command is over, the
+   * loop below holds it until all the commands are given */
+  auto pending = std::make_shared<host_notification_end>(host_notification_end{
+      name(), cntct->get_name(), type, not_author, not_data, escalated,
+      start_time, 1});
+
   /* process all the notification commands this user has */
   for (std::shared_ptr<commands::command> const& cmd :
        cntct->get_host_notification_commands()) {
@@ -2734,13 +2803,36 @@ int host::notify_contact(nagios_macros* mac,
                                  this->get_plugin_output(), info);
     }
 
-    /* run the notification command */
+    /* run the notification command, the timeout is checked once it is over */
     if (command_is_allowed_by_whitelist(processed_command, NOTIF_TYPE)) {
+      /* the callback may be called by run() if commands are synchronous */
+      ++pending->running;
       try {
-        std::string out;
-        my_system_r(mac, processed_command, notification_timeout,
-                    &early_timeout, &exectime, out, 0);
+        commands::system_executor::instance().run(
+            commands::system_executor::notification, processed_command, *mac,
+            notification_timeout,
+            [pending, method_start_time, processed_command,
+             notification_timeout](const commands::result& res) {
+              if (res.exit_status == process::timeout) {
+                engine_logger(log_host_notification | log_runtime_warning,
+                              basic)
+                    << "Warning: Contact '" << pending->contact_name
+                    << "' host notification command '" << processed_command
+                    << "' timed out after " << notification_timeout
+                    << " seconds";
+                notifications_logger->info(
+                    "Warning: Contact '{}' host notification command '{}' "
+                    "timed out after {} seconds",
+                    pending->contact_name, processed_command,
+                    notification_timeout);
+              }
+              end_host_notification_method(*pending, method_start_time);
+              if (--pending->running == 0)
+                end_host_notification(*pending);
+            });
+        continue;
       } catch (std::exception const& e) {
+        --pending->running;
         engine_logger(log_runtime_error, basic)
             << "Error: can't execute host notification for contact '"
             << cntct->get_name() << "' : " << e.what();
@@ -2755,40 +2847,13 @@ int host::notify_contact(nagios_macros* mac,
           cntct->get_name());
     }
 
-    /* check to see if the notification timed out */
-    if (early_timeout) {
-      engine_logger(log_host_notification | log_runtime_warning, basic)
-          << "Warning: Contact '" << cntct->get_name()
-          << "' host notification command '" << processed_command
-          << "' timed out after " << notification_timeout << " seconds";
-      notifications_logger->info(
-          "Warning: Contact '{}' host notification command '{}' timed out "
-          "after {} seconds",
-          cntct->get_name(), processed_command, notification_timeout);
-    }
-
-    /* get end time */
-    gettimeofday(&method_end_time, nullptr);
-
-    /* send data to event broker */
-    broker_contact_notification_method_data(
-        NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
-        host_notification, type, method_start_time, method_end_time,
-        (void*)this, cntct, not_author.c_str(), not_data.c_str(), escalated,
-        nullptr);
+    /* the command has not been run, its method is already over */
+    end_host_notification_method(*pending, method_start_time);
   }
 
-  /* get end time */
-  gettimeofday(&end_time, nullptr);
-
-  /* update the contact's last host notification time */
-  cntct->set_last_host_notification(start_time.tv_sec);
-
-  /* send data to event broker */
-  broker_contact_notification_data(
-      NEBTYPE_CONTACTNOTIFICATION_END, NEBFLAG_NONE, NEBATTR_NONE,
-      host_notification, type, start_time, end_time, (void*)this, cntct,
-      not_author.c_str(), not_data.c_str(), escalated, nullptr);
+  /* without running command, the notification is already over */
+  if (--pending->running == 0)
+    end_host_notification(*pending);
 
   return OK;
 }
@@ -3188,6 +3253,9 @@ int host::process_check_result_3x(enum host::host_state new_state,
   int run_async_check = true;
   bool has_parent;
 
+  /* The state is also written directly below, without its setter. */
+  set_status_dirty(true);
+
   engine_logger(dbg_functions, basic) << "process_host_check_result_3x()";
   SPDLOG_LOGGER_TRACE(functions_logger, "process_host_check_result_3x()");
 
@@ -3605,14 +3673,12 @@ int host::process_check_result_3x(enum host::host_state new_state,
    * checks, unless overridden above) */
   bool sent = false;
   if (reschedule_check) {
-    engine_logger(dbg_checks, more)
-        << "Rescheduling next check of host at " << my_ctime(&next_check);
-    SPDLOG_LOGGER_DEBUG(checks_logger,
-                        "Rescheduling next check of host: {} of last check at "
-                        "{:%Y-%m-%dT%H:%M:%S} and next "
-                        "check at {:%Y-%m-%dT%H:%M:%S}",
-                        name(), fmt::localtime(get_last_check()),
-                        fmt::localtime(next_check));
+    ENGINE_LOG_DEBUG(dbg_checks, more, checks_logger,
+                     "Rescheduling next check of host: {} of last check at "
+                     "{:%Y-%m-%dT%H:%M:%S} and next "
+                     "check at {:%Y-%m-%dT%H:%M:%S}",
+                     name(), fmt::localtime(get_last_check()),
+                     fmt::localtime(next_check));
 
     /* default is to reschedule host check unless a test below fails... */
     set_should_be_scheduled(true);
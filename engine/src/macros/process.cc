@@ -43,19 +43,17 @@ int process_macros_r(nagios_macros* mac,
   int free_macro = false;
   int macro_options = 0;
 
-  engine_logger(dbg_functions, basic) << "process_macros_r()";
-  functions_logger->trace("process_macros_r()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "process_macros_r()");
 
   output_buffer = "";
 
   if (input_buffer.empty())
     return ERROR;
 
-  engine_logger(dbg_macros, more) << "**** BEGIN MACRO PROCESSING ***********\n"
-                                     "Processing: '"
-                                  << input_buffer << "'";
-  macros_logger->trace("**** BEGIN MACRO PROCESSING **** Processing: '{}'",
-                       input_buffer);
+  ENGINE_LOG_TRACE(dbg_macros, more, macros_logger,
+                   "**** BEGIN MACRO PROCESSING **** Processing: '{}'",
+                   input_buffer);
 
   for (std::string::const_iterator it{input_buffer.begin()},
        end{input_buffer.end()};
@@ -81,41 +79,29 @@ int process_macros_r(nagios_macros* mac,
           result = grab_macro_value_r(mac, token, token_resolved,
                                       &clean_options, &free_macro);
 
-          engine_logger(dbg_macros, most)
-              << "  Processed '" << token.c_str() << "', To '" << token_resolved
-              << "', Clean Options: " << clean_options
-              << ", Free: " << free_macro;
-          macros_logger->trace(
+          ENGINE_LOG_TRACE(
+              dbg_macros, most, macros_logger,
               "  Processed '{}', To '{}', Clean Options: {}, Free: {}", token,
               token_resolved, clean_options, free_macro);
 
           /* an error occurred - we couldn't parse the macro, so continue on */
           if (result == ERROR) {
-            engine_logger(dbg_macros, basic)
-                << " WARNING: An error occurred processing macro '" << token
-                << "'!";
-            macros_logger->trace(
+            ENGINE_LOG_TRACE(
+                dbg_macros, basic, macros_logger,
                 " WARNING: An error occurred processing macro '{}'!", token);
           }
 
           /* insert macro */
           if (!token_resolved.empty()) {
-            engine_logger(dbg_macros, most)
-                << "  Processed '" << token
-                << "', Clean Options: " << clean_options
-                << ", Free: " << free_macro;
-            macros_logger->trace(
-                "  Processed '{}', Clean Options: {}, Free: {}", token,
-                clean_options, free_macro);
+            ENGINE_LOG_TRACE(dbg_macros, most, macros_logger,
+                             "  Processed '{}', Clean Options: {}, Free: {}",
+                             token, clean_options, free_macro);
 
             /* include any cleaning options passed back to us */
             macro_options = (options | clean_options);
 
-            engine_logger(dbg_macros, most)
-                << "  Cleaning options: global=" << options
-                << ", local=" << clean_options
-                << ", effective=" << macro_options;
-            macros_logger->trace(
+            ENGINE_LOG_TRACE(
+                dbg_macros, most, macros_logger,
                 "  Cleaning options: global={}, local={}, effective={}",
                 options, clean_options, macro_options);
 
@@ -130,11 +116,8 @@ int process_macros_r(nagios_macros* mac,
                 if (!cleaned_macro.empty()) {
                   output_buffer.append(cleaned_macro);
 
-                  engine_logger(dbg_macros, basic)
-                      << "  Cleaned macro.  Running output ("
-                      << output_buffer.length() << "): '" << output_buffer
-                      << "'";
-                  macros_logger->trace(
+                  ENGINE_LOG_TRACE(
+                      dbg_macros, basic, macros_logger,
                       "  Cleaned macro.  Running output ({}): '{}'",
                       output_buffer.length(), output_buffer);
                 }
@@ -144,20 +127,15 @@ int process_macros_r(nagios_macros* mac,
                * buffer */
               output_buffer.append(token_resolved);
 
-              engine_logger(dbg_macros, basic)
-                  << "  Uncleaned macro.  Running output ("
-                  << output_buffer.length() << "): '" << output_buffer << "'";
-              macros_logger->trace(
-                  "  Uncleaned macro.  Running output ({}): '{}'",
-                  output_buffer.length(), output_buffer);
+              ENGINE_LOG_TRACE(dbg_macros, basic, macros_logger,
+                               "  Uncleaned macro.  Running output ({}): '{}'",
+                               output_buffer.length(), output_buffer);
             }
 
             /* free memory if necessary (if we URL encoded the macro or we were
              * told to do so by grab_macro_value()) */
-            engine_logger(dbg_macros, basic)
-                << "  Just finished macro.  Running output ("
-                << output_buffer.length() << "): '" << output_buffer << "'";
-            macros_logger->trace(
+            ENGINE_LOG_TRACE(
+                dbg_macros, basic, macros_logger,
                 "  Just finished macro.  Running output ({}): '{}'",
                 output_buffer.length(), output_buffer);
           }
@@ -170,11 +148,8 @@ int process_macros_r(nagios_macros* mac,
     }
   }
 
-  engine_logger(dbg_macros, more) << "  Done.  Final output: '" << output_buffer
-                                  << "'\n"
-                                     "**** END MACRO PROCESSING *************";
-  macros_logger->trace(
-      "  Done.  Final output: '{}' **** END MACRO PROCESSING ****",
-      output_buffer);
+  ENGINE_LOG_TRACE(dbg_macros, more, macros_logger,
+                   "  Done.  Final output: '{}' **** END MACRO PROCESSING ****",
+                   output_buffer);
   return OK;
 }
@@ -47,6 +47,7 @@ namespace asio = boost::asio;
 #include "com/centreon/engine/broker/loader.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/connector.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/logging.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
@@ -64,6 +65,7 @@ namespace asio = boost::asio;
 #include "com/centreon/engine/retention/dump.hh"
 #include "com/centreon/engine/retention/parser.hh"
 #include "com/centreon/engine/retention/state.hh"
+#include "com/centreon/engine/statistics.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/version.hh"
@@ -215,6 +217,7 @@ int main(int argc, char* argv[]) {
 
     // Checker init
     checks::checker::init();
+    commands::system_executor::init();
 
     // Just display the license.
     if (display_license) {
@@ -603,6 +606,7 @@ int main(int argc, char* argv[]) {
 
         // Clean up the status data.
         cleanup_status_data(true);
+        statistics::instance().close_shared_stats();
 
         // Shutdown stuff.
         if (sigshutdown) {
@@ -176,6 +176,7 @@ unsigned long notifier::get_current_event_id() const {
 
 void notifier::set_current_event_id(unsigned long current_event_id) noexcept {
   _current_event_id = current_event_id;
+  set_status_dirty(true);
 }
 
 unsigned long notifier::get_last_event_id() const noexcept {
@@ -184,6 +185,7 @@ unsigned long notifier::get_last_event_id() const noexcept {
 
 void notifier::set_last_event_id(unsigned long last_event_id) noexcept {
   _last_event_id = last_event_id;
+  set_status_dirty(true);
 }
 
 unsigned long notifier::get_current_problem_id() const noexcept {
@@ -193,6 +195,7 @@ unsigned long notifier::get_current_problem_id() const noexcept {
 void notifier::set_current_problem_id(
     unsigned long current_problem_id) noexcept {
   _current_problem_id = current_problem_id;
+  set_status_dirty(true);
 }
 
 unsigned long notifier::get_last_problem_id() const noexcept {
@@ -201,6 +204,7 @@ unsigned long notifier::get_last_problem_id() const noexcept {
 
 void notifier::set_last_problem_id(unsigned long last_problem_id) noexcept {
   _last_problem_id = last_problem_id;
+  set_status_dirty(true);
 }
 
 /**
@@ -209,6 +213,7 @@ void notifier::set_last_problem_id(unsigned long last_problem_id) noexcept {
  * @param num The notification number.
  */
 void notifier::set_notification_number(int num) {
+  set_status_dirty(true);
   SPDLOG_LOGGER_TRACE(notifications_logger,
                       "_notification_number set_notification_number: {} => {}",
                       _notification_number, num);
@@ -590,6 +595,7 @@ bool notifier::_is_notification_viable_recovery(reason_type type
           " _notification_number _is_notification_viable_recovery: {} => 0",
           _notification_number);
       _notification_number = 0;
+      set_status_dirty(true);
     }
   }
 
@@ -1024,6 +1030,7 @@ int notifier::notify(notifier::reason_type type,
       get_contacts_to_notify(cat, type, notification_interval, escalated)};
 
   _current_notification_id = _next_notification_id++;
+  set_status_dirty(true);
   auto notif = std::make_unique<notification>(
       this, type, not_author, not_data, options, _current_notification_id,
       _notification_number, notification_interval, escalated);
@@ -1079,6 +1086,7 @@ int notifier::notify(notifier::reason_type type,
 
 void notifier::set_current_notification_id(uint64_t id) noexcept {
   _current_notification_id = id;
+  set_status_dirty(true);
 }
 
 uint64_t notifier::get_current_notification_id() const noexcept {
@@ -1091,6 +1099,7 @@ time_t notifier::get_next_notification() const noexcept {
 
 void notifier::set_next_notification(time_t next_notification) noexcept {
   _next_notification = next_notification;
+  set_status_dirty(true);
 }
 
 time_t notifier::get_last_notification() const noexcept {
@@ -1099,6 +1108,7 @@ time_t notifier::get_last_notification() const noexcept {
 
 void notifier::set_last_notification(time_t last_notification) noexcept {
   _last_notification = last_notification;
+  set_status_dirty(true);
 }
 
 void notifier::set_initial_notif_time(time_t notif_time) noexcept {
@@ -1137,6 +1147,7 @@ std::string const& notifier::notification_period() const noexcept {
 void notifier::set_notification_period(
     std::string const& notification_period) noexcept {
   _notification_period = notification_period;
+  set_status_dirty(true);
 }
 
 bool notifier::get_notify_on(notification_flag type) const noexcept {
@@ -1183,6 +1194,7 @@ bool notifier::get_notifications_enabled() const noexcept {
 
 void notifier::set_notifications_enabled(bool notifications_enabled) noexcept {
   _notifications_enabled = notifications_enabled;
+  set_status_dirty(true);
 }
 
 bool notifier::get_notified_on(notification_flag type) const noexcept {
@@ -1243,10 +1255,12 @@ uint32_t notifier::get_modified_attributes() const noexcept {
 
 void notifier::set_modified_attributes(uint32_t modified_attributes) noexcept {
   _modified_attributes = modified_attributes;
+  set_status_dirty(true);
 }
 
 void notifier::add_modified_attributes(uint32_t attr) noexcept {
   _modified_attributes |= attr;
+  set_status_dirty(true);
 }
 
 std::list<escalation*>& notifier::get_escalations() noexcept {
@@ -1271,6 +1285,7 @@ int notifier::get_check_options(void) const noexcept {
 
 void notifier::set_check_options(int option) noexcept {
   _check_options = option;
+  set_status_dirty(true);
 }
 
 /**
@@ -1291,6 +1306,7 @@ AckType notifier::get_acknowledgement() const noexcept {
  */
 void notifier::set_acknowledgement(AckType acknowledge_type) noexcept {
   _acknowledgement_type = acknowledge_type;
+  set_status_dirty(true);
 }
 
 int notifier::get_retain_status_information() const noexcept {
@@ -1334,6 +1350,7 @@ bool notifier::get_no_more_notifications() const noexcept {
 
 void notifier::set_no_more_notifications(bool no_more_notifications) noexcept {
   _no_more_notifications = no_more_notifications;
+  set_status_dirty(true);
 }
 
 int notifier::get_notification_number() const noexcept {
@@ -22,6 +22,7 @@
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checkable.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/downtimes/downtime.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
@@ -36,6 +37,28 @@ using namespace com::centreon::engine;
 using namespace com::centreon::engine::downtimes;
 using namespace com::centreon::engine::logging;
 
+/**
+ * @brief Execute an event handler or an obsessive command in background.
+ *
+ * @param mac The macros used to build the command environment.
+ * @param k The command kind.
+ * @param cmd The command line.
+ * @param timeout The command timeout in seconds.
+ * @param on_timeout Called from the main loop if the command timed out.
+ */
+static void run_system_command(nagios_macros* mac,
+                               commands::system_executor::kind k,
+                               const std::string& cmd,
+                               uint32_t timeout,
+                               std::function<void()>&& on_timeout) {
+  commands::system_executor::instance().run(
+      k, cmd, *mac, timeout,
+      [on_timeout = std::move(on_timeout)](const commands::result& res) {
+        if (res.exit_status == com::centreon::process::timeout)
+          on_timeout();
+      });
+}
+
 /******************************************************************/
 /************* OBSESSIVE COMPULSIVE HANDLER FUNCTIONS *************/
 /******************************************************************/
@@ -45,8 +68,6 @@ int obsessive_compulsive_host_check_processor(
     com::centreon::engine::host* hst) {
   std::string raw_command;
   std::string processed_command;
-  bool early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros* mac(get_global_macros());
 
@@ -116,9 +137,19 @@ int obsessive_compulsive_host_check_processor(
                                            checkable::OBSESS_TYPE)) {
     /* run the command */
     try {
-      std::string tmp;
-      my_system_r(mac, processed_command, ochp_timeout,
-                  &early_timeout, &exectime, tmp, 0);
+      run_system_command(
+          mac, commands::system_executor::obsessive, processed_command,
+          ochp_timeout,
+          [processed_command, host_name = hst->name(), ochp_timeout] {
+            engine_logger(log_runtime_warning, basic)
+                << "Warning: OCHP command '" << processed_command
+                << "' for host '" << host_name << "' timed out after "
+                << ochp_timeout << " seconds";
+            runtime_logger->warn(
+                "Warning: OCHP command '{}' for host '{}' timed out after {} "
+                "seconds",
+                processed_command, host_name, ochp_timeout);
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute compulsive host processor command line '"
@@ -136,16 +167,6 @@ int obsessive_compulsive_host_check_processor(
   }
   clear_volatile_macros_r(mac);
 
-  /* check to see if the command timed out */
-  if (early_timeout)
-    engine_logger(log_runtime_warning, basic)
-        << "Warning: OCHP command '" << processed_command << "' for host '"
-        << hst->name() << "' timed out after " << ochp_timeout
-        << " seconds";
-  runtime_logger->warn(
-      "Warning: OCHP command '{}' for host '{}' timed out after {} seconds",
-      processed_command, hst->name(), ochp_timeout);
-
   return OK;
 }
 
@@ -159,9 +180,6 @@ int run_global_service_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -246,8 +264,18 @@ int run_global_service_event_handler(nagios_macros* mac,
                                                  cached_cmd)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      run_system_command(
+          mac, commands::system_executor::event_handler, processed_command,
+          event_handler_timeout, [processed_command, event_handler_timeout] {
+            engine_logger(log_event_handler | log_runtime_warning, basic)
+                << "Warning: Global service event handler command '"
+                << processed_command << "' timed out after "
+                << event_handler_timeout << " seconds";
+            events_logger->info(
+                "Warning: Global service event handler command '{}' timed "
+                "out after {} seconds",
+                processed_command, event_handler_timeout);
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute global service event handler "
@@ -265,17 +293,6 @@ int run_global_service_event_handler(nagios_macros* mac,
         processed_command);
   }
 
-  /* check to see if the event handler timed out */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Global service event handler command '"
-        << processed_command << "' timed out after "
-        << event_handler_timeout << " seconds";
-    events_logger->info(
-        "Warning: Global service event handler command '{}' timed out after {} "
-        "seconds",
-        processed_command, event_handler_timeout);
-  }
   return OK;
 }
 
@@ -285,9 +302,6 @@ int run_service_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -357,8 +371,18 @@ int run_service_event_handler(nagios_macros* mac,
                                            checkable::EVH_TYPE)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      run_system_command(
+          mac, commands::system_executor::event_handler, processed_command,
+          event_handler_timeout, [processed_command, event_handler_timeout] {
+            engine_logger(log_event_handler | log_runtime_warning, basic)
+                << "Warning: Service event handler command '"
+                << processed_command << "' timed out after "
+                << event_handler_timeout << " seconds";
+            events_logger->info(
+                "Warning: Service event handler command '{}' timed out after "
+                "{} seconds",
+                processed_command, event_handler_timeout);
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute service event handler command line '"
@@ -374,17 +398,6 @@ int run_service_event_handler(nagios_macros* mac,
         processed_command);
   }
 
-  /* check to see if the event handler timed out */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Service event handler command '" << processed_command
-        << "' timed out after " << event_handler_timeout
-        << " seconds";
-    events_logger->info(
-        "Warning: Service event handler command '{}' timed out after {} "
-        "seconds",
-        processed_command, event_handler_timeout);
-  }
   return OK;
 }
 
@@ -447,9 +460,6 @@ int run_global_host_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -529,8 +539,18 @@ int run_global_host_event_handler(nagios_macros* mac,
   if (host::command_is_allowed_by_whitelist(processed_command, cached_cmd)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      run_system_command(
+          mac, commands::system_executor::event_handler, processed_command,
+          event_handler_timeout, [processed_command, event_handler_timeout] {
+            engine_logger(log_event_handler | log_runtime_warning, basic)
+                << "Warning: Global host event handler command '"
+                << processed_command << "' timed out after "
+                << event_handler_timeout << " seconds";
+            events_logger->info(
+                "Warning: Global host event handler command '{}' timed out "
+                "after {} seconds",
+                processed_command, event_handler_timeout);
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute global host event handler command line '"
@@ -547,17 +567,6 @@ int run_global_host_event_handler(nagios_macros* mac,
         processed_command);
   }
 
-  /* check for a timeout in the execution of the event handler command */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Global host event handler command '" << processed_command
-        << "' timed out after " << event_handler_timeout
-        << " seconds";
-    events_logger->info(
-        "Warning: Global host event handler command '{}' timed out after {} "
-        "seconds",
-        processed_command, event_handler_timeout);
-  }
 
   return OK;
 }
@@ -568,9 +577,6 @@ int run_host_event_handler(nagios_macros* mac,
   std::string raw_command;
   std::string processed_command;
   std::string processed_logentry;
-  std::string command_output;
-  bool early_timeout = false;
-  double exectime = 0.0;
   struct timeval start_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
 
@@ -636,8 +642,18 @@ int run_host_event_handler(nagios_macros* mac,
                                            checkable::EVH_TYPE)) {
     /* run the command */
     try {
-      my_system_r(mac, processed_command, event_handler_timeout,
-                  &early_timeout, &exectime, command_output, 0);
+      run_system_command(
+          mac, commands::system_executor::event_handler, processed_command,
+          event_handler_timeout, [processed_command, event_handler_timeout] {
+            engine_logger(log_event_handler | log_runtime_warning, basic)
+                << "Warning: Host event handler command '"
+                << processed_command << "' timed out after "
+                << event_handler_timeout << " seconds";
+            events_logger->info(
+                "Warning: Host event handler command '{}' timed out after {} "
+                "seconds",
+                processed_command, event_handler_timeout);
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute host event handler command line '"
@@ -653,15 +669,5 @@ int run_host_event_handler(nagios_macros* mac,
         processed_command);
   }
 
-  /* check to see if the event handler timed out */
-  if (early_timeout) {
-    engine_logger(log_event_handler | log_runtime_warning, basic)
-        << "Warning: Host event handler command '" << processed_command
-        << "' timed out after " << event_handler_timeout
-        << " seconds";
-    events_logger->info(
-        "Warning: Host event handler command '{}' timed out after {} seconds",
-        processed_command, event_handler_timeout);
-  }
   return OK;
 }
@@ -22,6 +22,7 @@
 
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/configuration/whitelist.hh"
 #include "com/centreon/engine/deleter/listmember.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
@@ -163,6 +164,7 @@ time_t service::get_last_time_ok() const {
 
 void service::set_last_time_ok(time_t last_time) {
   _last_time_ok = last_time;
+  set_status_dirty(true);
 }
 
 time_t service::get_last_time_warning() const {
@@ -171,6 +173,7 @@ time_t service::get_last_time_warning() const {
 
 void service::set_last_time_warning(time_t last_time) {
   _last_time_warning = last_time;
+  set_status_dirty(true);
 }
 
 time_t service::get_last_time_unknown() const {
@@ -179,6 +182,7 @@ time_t service::get_last_time_unknown() const {
 
 void service::set_last_time_unknown(time_t last_time) {
   _last_time_unknown = last_time;
+  set_status_dirty(true);
 }
 
 time_t service::get_last_time_critical() const {
@@ -187,6 +191,7 @@ time_t service::get_last_time_critical() const {
 
 void service::set_last_time_critical(time_t last_time) {
   _last_time_critical = last_time;
+  set_status_dirty(true);
 }
 
 enum service::service_state service::get_current_state() const {
@@ -195,6 +200,7 @@ enum service::service_state service::get_current_state() const {
 
 void service::set_current_state(enum service::service_state current_state) {
   _current_state = current_state;
+  set_status_dirty(true);
 }
 
 enum service::service_state service::get_last_state() const {
@@ -211,6 +217,7 @@ enum service::service_state service::get_last_hard_state() const {
 
 void service::set_last_hard_state(enum service::service_state last_hard_state) {
   _last_hard_state = last_hard_state;
+  set_status_dirty(true);
 }
 
 enum service::service_state service::get_initial_state() const {
@@ -227,6 +234,7 @@ int service::get_process_performance_data(void) const {
 
 void service::set_process_performance_data(int perf_data) {
   _process_performance_data = perf_data;
+  set_status_dirty(true);
 }
 
 bool service::get_check_flapping_recovery_notification(void) const {
@@ -1065,8 +1073,7 @@ static constexpr bool state_changes_use_cached_state = true;
  * @return OK or ERROR.
  *
  */
-int service::handle_async_check_result(
-    const check_result& queued_check_result) {
+int service::handle_async_check_result(check_result& queued_check_result) {
   time_t next_service_check = 0L;
   time_t preferred_time = 0L;
   time_t next_valid_time = 0L;
@@ -1106,6 +1113,9 @@ int service::handle_async_check_result(
 
   SPDLOG_LOGGER_TRACE(functions_logger, "handle_async_service_check_result()");
 
+  /* The states are also written directly below, without their setters. */
+  set_status_dirty(true);
+
   /* get the current time */
   time_t current_time = std::time(nullptr);
 
@@ -1301,12 +1311,11 @@ int service::handle_async_check_result(
      * parse check output to get: (1) short output, (2) long output,
      * (3) perf data
      */
-    std::string output{queued_check_result.get_output()};
     std::string plugin_output;
     std::string long_plugin_output;
     std::string perf_data;
-    parse_check_output(output, plugin_output, long_plugin_output, perf_data,
-                       true, false);
+    queued_check_result.take_parsed_output(plugin_output, long_plugin_output,
+                                           perf_data);
 
     set_long_plugin_output(long_plugin_output);
     set_perf_data(perf_data);
@@ -1987,11 +1996,9 @@ int service::handle_async_check_result(
   bool need_update = false;
   /* reschedule the next service check ONLY for active, scheduled checks */
   if (reschedule_check) {
-    engine_logger(dbg_checks, more) << "Rescheduling next check of service at "
-                                    << my_ctime(&next_service_check);
-    SPDLOG_LOGGER_DEBUG(checks_logger,
-                        "Rescheduling next check of service at {}",
-                        my_ctime(&next_service_check));
+    ENGINE_LOG_DEBUG(dbg_checks, more, checks_logger,
+                     "Rescheduling next check of service at {}",
+                     my_ctime(&next_service_check));
 
     /* default is to reschedule service check unless a test below fails... */
     set_should_be_scheduled(true);
@@ -2342,8 +2349,6 @@ int service::obsessive_compulsive_service_check_processor() {
   std::string raw_command;
   std::string processed_command;
   host* temp_host{get_host_ptr()};
-  bool early_timeout = false;
-  double exectime = 0.0;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
   nagios_macros* mac(get_global_macros());
 
@@ -2415,11 +2420,27 @@ int service::obsessive_compulsive_service_check_processor() {
                       processed_command);
 
   if (command_is_allowed_by_whitelist(processed_command, OBSESS_TYPE)) {
-    /* run the command */
+    /* run the command, the timeout is checked once it is over */
     try {
-      std::string tmp;
-      my_system_r(mac, processed_command, ocsp_timeout, &early_timeout,
-                  &exectime, tmp, 0);
+      commands::system_executor::instance().run(
+          commands::system_executor::obsessive, processed_command, *mac,
+          ocsp_timeout,
+          [processed_command, service_description = name(),
+           host_name = _hostname, ocsp_timeout](const commands::result& res) {
+            if (res.exit_status == process::timeout) {
+              engine_logger(log_runtime_warning, basic)
+                  << "Warning: OCSP command '" << processed_command
+                  << "' for service '" << service_description << "' on host '"
+                  << host_name << "' timed out after " << ocsp_timeout
+                  << " seconds";
+              SPDLOG_LOGGER_WARN(
+                  runtime_logger,
+                  "Warning: OCSP command '{}' for service '{}' on host '{}' "
+                  "timed out after {} seconds",
+                  processed_command, service_description, host_name,
+                  ocsp_timeout);
+            }
+          });
     } catch (std::exception const& e) {
       engine_logger(log_runtime_error, basic)
           << "Error: can't execute compulsive service processor command line '"
@@ -2439,18 +2460,6 @@ int service::obsessive_compulsive_service_check_processor() {
 
   clear_volatile_macros_r(mac);
 
-  /* check to see if the command timed out */
-  if (early_timeout)
-    engine_logger(log_runtime_warning, basic)
-        << "Warning: OCSP command '" << processed_command << "' for service '"
-        << name() << "' on host '" << _hostname << "' timed out after "
-        << ocsp_timeout << " seconds";
-  SPDLOG_LOGGER_WARN(
-      runtime_logger,
-      "Warning: OCSP command '{}' for service '{}' on host '{}' timed out "
-      "after {} seconds",
-      processed_command, name(), _hostname, ocsp_timeout);
-
   return OK;
 }
 
@@ -2559,12 +2568,9 @@ int service::run_scheduled_check(int check_options, double latency) {
         else {
           set_next_check(next_valid_time);
           set_should_be_scheduled(true);
-          engine_logger(dbg_checks, more)
-              << "Rescheduled next service check for "
-              << my_ctime(&next_valid_time);
-          SPDLOG_LOGGER_DEBUG(checks_logger,
-                              "Rescheduled next service check for {}",
-                              my_ctime(&next_valid_time));
+          ENGINE_LOG_DEBUG(dbg_checks, more, checks_logger,
+                           "Rescheduled next service check for {}",
+                           my_ctime(&next_valid_time));
         }
       }
     }
@@ -2848,16 +2854,11 @@ int service::run_async_check_local(int check_options,
 bool service::schedule_check(time_t check_time,
                              uint32_t options,
                              bool no_update_status_now) {
-  engine_logger(dbg_functions, basic) << "schedule_service_check()";
-  SPDLOG_LOGGER_TRACE(functions_logger, "schedule_service_check()");
+  ENGINE_LOG_TRACE(dbg_functions, basic, functions_logger,
+                   "schedule_service_check()");
 
-  engine_logger(dbg_checks, basic)
-      << "Scheduling a "
-      << (options & CHECK_OPTION_FORCE_EXECUTION ? "forced" : "non-forced")
-      << ", active check of service '" << name() << "' on host '" << _hostname
-      << "' @ " << my_ctime(&check_time);
-  SPDLOG_LOGGER_TRACE(
-      checks_logger,
+  ENGINE_LOG_TRACE(
+      dbg_checks, basic, checks_logger,
       "Scheduling a {}, active check of service '{}' on host '{}' @ {}",
       options & CHECK_OPTION_FORCE_EXECUTION ? "forced" : "non-forced", name(),
       _hostname, my_ctime(&check_time));
@@ -2881,11 +2882,8 @@ bool service::schedule_check(time_t check_time,
   // the queue - what should we do?
   if (found != events::loop::instance().list_end(events::loop::low)) {
     auto& temp_event = *found;
-    engine_logger(dbg_checks, most)
-        << "Found another service check event for this service @ "
-        << my_ctime(&temp_event->run_time);
-    SPDLOG_LOGGER_DEBUG(
-        checks_logger,
+    ENGINE_LOG_DEBUG(
+        dbg_checks, most, checks_logger,
         "Found another service check event for this service @ {}",
         my_ctime(&temp_event->run_time));
 
@@ -3273,6 +3271,73 @@ void service::grab_macros_r(nagios_macros* mac) {
   grab_service_macros_r(mac, this);
 }
 
+namespace {
+/**
+ *  As for hosts, the end of each notification command and of the whole
+ *  notification is sent once the commands are over. The service and the
+ *  contact are looked up again then.
+ */
+struct service_notification_end {
+  host_serv_pair service_key;
+  std::string contact_name;
+  notifier::reason_type type;
+  std::string author;
+  std::string data;
+  int escalated;
+  timeval start_time;
+  uint32_t running = 0;
+};
+
+/**
+ *  Send the end of a notification method to the broker.
+ *
+ *  @param[in] n                  The notification.
+ *  @param[in] method_start_time  The start time of the method.
+ */
+void end_service_notification_method(const service_notification_end& n,
+                                     const timeval& method_start_time) {
+  auto svc = service::services.find(n.service_key);
+  auto cntct = contact::contacts.find(n.contact_name);
+  if (svc == service::services.end() || cntct == contact::contacts.end())
+    return;
+
+  timeval method_end_time;
+  gettimeofday(&method_end_time, nullptr);
+  broker_contact_notification_method_data(
+      NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
+      notifier::service_notification, n.type, method_start_time,
+      method_end_time, svc->second.get(), cntct->second.get(), n.author.c_str(),
+      n.data.c_str(), n.escalated, nullptr);
+}
+
+/**
+ *  Update the contact's last service notification time and send the end of
+ *  the notification to the broker.
+ *
+ *  @param[in] n  The notification.
+ */
+void end_service_notification(const service_notification_end& n) {
+  auto svc = service::services.find(n.service_key);
+  auto cntct = contact::contacts.find(n.contact_name);
+  if (svc == service::services.end() || cntct == contact::contacts.end()) {
+    notifications_logger->debug(
+        "Service '{}' on host '{}' or contact '{}' removed before the end of "
+        "their notification",
+        n.service_key.second, n.service_key.first, n.contact_name);
+    return;
+  }
+
+  timeval end_time;
+  gettimeofday(&end_time, nullptr);
+  cntct->second->set_last_service_notification(n.start_time.tv_sec);
+  broker_contact_notification_data(
+      NEBTYPE_CONTACTNOTIFICATION_END, NEBFLAG_NONE, NEBATTR_NONE,
+      notifier::service_notification, n.type, n.start_time, end_time,
+      svc->second.get(), cntct->second.get(), n.author.c_str(), n.data.c_str(),
+      n.escalated, nullptr);
+}
+}  // namespace
+
 /* notify a specific contact about a service problem or recovery */
 int service::notify_contact(nagios_macros* mac,
                             contact* cntct,
@@ -3283,8 +3348,6 @@ int service::notify_contact(nagios_macros* mac,
                             int escalated) {
   std::string raw_command;
   std::string processed_command;
-  bool early_timeout = false;
-  double exectime;
   struct timeval start_time, end_time;
   struct timeval method_start_time, method_end_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
@@ -3311,6 +3374,13 @@ int service::notify_contact(nagios_macros* mac,
   else if (NEBERROR_CALLBACKOVERRIDE == neb_result)
     return OK;
 
+  /* the end of the notification is sent once its last command is over, the
+   * loop below holds it until all the commands are given */
+  auto pending =
+      std::make_shared<service_notification_end>(service_notification_end{
+          {get_hostname(), description()}, cntct->get_name(), type, not_author,
+          not_data, escalated, start_time, 1});
+
   /* process all the notification commands this user has */
   for (std::shared_ptr<commands::command> const& cmd :
        cntct->get_service_notification_commands()) {
@@ -3400,11 +3470,34 @@ int service::notify_contact(nagios_macros* mac,
 #else
       uint32_t notification_timeout = pb_config.notification_timeout();
 #endif
+      /* the callback may be called by run() if commands are synchronous */
+      ++pending->running;
       try {
-        std::string tmp;
-        my_system_r(mac, processed_command, notification_timeout,
-                    &early_timeout, &exectime, tmp, 0);
+        commands::system_executor::instance().run(
+            commands::system_executor::notification, processed_command, *mac,
+            notification_timeout,
+            [pending, method_start_time, processed_command,
+             notification_timeout](const commands::result& res) {
+              if (res.exit_status == process::timeout) {
+                engine_logger(log_service_notification | log_runtime_warning,
+                              basic)
+                    << "Warning: Contact '" << pending->contact_name
+                    << "' service notification command '" << processed_command
+                    << "' timed out after " << notification_timeout
+                    << " seconds";
+                notifications_logger->info(
+                    "Warning: Contact '{}' service notification command '{}' "
+                    "timed out after {} seconds",
+                    pending->contact_name, processed_command,
+                    notification_timeout);
+              }
+              end_service_notification_method(*pending, method_start_time);
+              if (--pending->running == 0)
+                end_service_notification(*pending);
+            });
+        continue;
       } catch (std::exception const& e) {
+        --pending->running;
         engine_logger(log_runtime_error, basic)
             << "Error: can't execute service notification for contact '"
             << cntct->get_name() << "' : " << e.what();
@@ -3420,40 +3513,13 @@ int service::notify_contact(nagios_macros* mac,
                           cntct->get_name());
     }
 
-    /* check to see if the notification command timed out */
-    if (early_timeout) {
-      engine_logger(log_service_notification | log_runtime_warning, basic)
-          << "Warning: Contact '" << cntct->get_name()
-          << "' service notification command '" << processed_command
-          << "' timed out after " << notification_timeout << " seconds";
-      notifications_logger->info(
-          "Warning: Contact '{}' service notification command '{}' timed out "
-          "after {} seconds",
-          cntct->get_name(), processed_command, notification_timeout);
-    }
-
-    /* get end time */
-    gettimeofday(&method_end_time, nullptr);
-
-    /* send data to event broker */
-    broker_contact_notification_method_data(
-        NEBTYPE_CONTACTNOTIFICATIONMETHOD_END, NEBFLAG_NONE, NEBATTR_NONE,
-        service_notification, type, method_start_time, method_end_time,
-        (void*)this, cntct, not_author.c_str(), not_data.c_str(), escalated,
-        nullptr);
+    /* the command has not been run, its method is already over */
+    end_service_notification_method(*pending, method_start_time);
   }
 
-  /* get end time */
-  gettimeofday(&end_time, nullptr);
-
-  /* update the contact's last service notification time */
-  cntct->set_last_service_notification(start_time.tv_sec);
-
-  /* send data to event broker */
-  broker_contact_notification_data(
-      NEBTYPE_CONTACTNOTIFICATION_END, NEBFLAG_NONE, NEBATTR_NONE,
-      service_notification, type, start_time, end_time, (void*)this, cntct,
-      not_author.c_str(), not_data.c_str(), escalated, nullptr);
+  /* without running command, the notification is already over */
+  if (--pending->running == 0)
+    end_service_notification(*pending);
   return OK;
 }
 
@@ -18,7 +18,14 @@
  */
 
 #include "com/centreon/engine/statistics.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/checks/stats.hh"
+#include "com/centreon/engine/comment.hh"
+#include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/service.hh"
 
 using namespace com::centreon::engine;
 
@@ -77,3 +84,227 @@ bool statistics::get_external_command_buffer_stats(
     return false;
 }
 #endif
+
+/**
+ * @brief Fill the statistics of a set of hosts or services.
+ *
+ * @param objects host::hosts or service::services.
+ * @param now The current time.
+ * @param st The structure to fill.
+ */
+template <typename Map>
+static void compute_object_stats(const Map& objects,
+                                 time_t now,
+                                 shm_object_stats& st) {
+  memset(&st, 0, sizeof(st));
+  st.min_state_change = st.active.min_latency = st.active.min_execution_time =
+      st.active.min_state_change = st.passive.min_latency =
+          st.passive.min_execution_time = st.passive.min_state_change =
+              std::numeric_limits<double>::max();
+
+  auto min_max_sum = [](double v, double& min, double& max, double& sum) {
+    sum += v;
+    if (v < min)
+      min = v;
+    if (v > max)
+      max = v;
+  };
+  auto last_checks = [now](time_t last_check, shm_check_type_stats& s) {
+    time_t time_diff = now - last_check;
+    if (time_diff <= 60)
+      ++s.checks_last_1min;
+    if (time_diff <= 300)
+      ++s.checks_last_5min;
+    if (time_diff <= 900)
+      ++s.checks_last_15min;
+    if (time_diff <= 3600)
+      ++s.checks_last_1hour;
+  };
+
+  for (auto it = objects.begin(), end = objects.end(); it != end; ++it) {
+    const auto& obj = it->second;
+    double state_change = obj->get_percent_state_change();
+    min_max_sum(state_change, st.min_state_change, st.max_state_change,
+                st.average_state_change);
+    if (obj->has_been_checked())
+      ++st.checked;
+    if (obj->get_should_be_scheduled())
+      ++st.scheduled;
+    uint32_t state = static_cast<uint32_t>(obj->get_current_state());
+    if (state < sizeof(st.states) / sizeof(*st.states))
+      ++st.states[state];
+    if (obj->is_in_downtime())
+      ++st.downtime;
+    if (obj->get_is_flapping())
+      ++st.flapping;
+
+    shm_check_type_stats* type_stats;
+    if (obj->get_check_type() == checkable::check_active) {
+      ++st.actively_checked;
+      type_stats = &st.active;
+      min_max_sum(obj->get_execution_time(), type_stats->min_execution_time,
+                  type_stats->max_execution_time,
+                  type_stats->average_execution_time);
+    } else {
+      ++st.passively_checked;
+      type_stats = &st.passive;
+    }
+    min_max_sum(obj->get_latency(), type_stats->min_latency,
+                type_stats->max_latency, type_stats->average_latency);
+    min_max_sum(state_change, type_stats->min_state_change,
+                type_stats->max_state_change, type_stats->average_state_change);
+    last_checks(obj->get_last_check(), *type_stats);
+  }
+
+  st.count = objects.size();
+  if (st.count)
+    st.average_state_change /= st.count;
+  else
+    st.min_state_change = 0;
+
+  auto averages = [](uint32_t count, shm_check_type_stats& s) {
+    if (count) {
+      s.average_latency /= count;
+      s.average_execution_time /= count;
+      s.average_state_change /= count;
+    } else
+      s.min_latency = s.min_state_change = 0;
+    if (s.min_execution_time == std::numeric_limits<double>::max())
+      s.min_execution_time = 0;
+  };
+  averages(st.actively_checked, st.active);
+  averages(st.passively_checked, st.passive);
+}
+
+/**
+ * @brief Create the shared memory segment where statistics are published. If
+ * name is empty, statistics are no more published.
+ *
+ * @param name The segment name (as given to shm_open()).
+ */
+void statistics::open_shared_stats(const std::string& name) {
+  std::unique_lock<std::shared_mutex> lck(_shm_m);
+  if (name == _shm.name())
+    return;
+  _shm.close();
+  if (name.empty())
+    return;
+  if (!_shm.create(name))
+    runtime_logger->error(
+        "Error: Unable to create the statistics shared memory '{}': {}", name,
+        strerror(errno));
+  else
+    process_logger->info("Statistics published in shared memory '{}'", name);
+}
+
+/**
+ * @brief Remove the shared memory segment.
+ */
+void statistics::close_shared_stats() noexcept {
+  std::unique_lock<std::shared_mutex> lck(_shm_m);
+  _shm.close();
+}
+
+/**
+ * @brief Compute scheduler and checks statistics and publish them in the
+ * shared memory segment. This method must be called from the main loop.
+ */
+void statistics::publish_shared_stats() {
+  std::shared_lock<std::shared_mutex> lck(_shm_m);
+  if (!_shm.is_open())
+    return;
+
+  shm_stats_data data;
+  memset(&data, 0, sizeof(data));
+  time_t now = time(nullptr);
+  data.last_update = now;
+  data.pid = getpid();
+  data.program_start = program_start;
+  data.last_command_check = last_command_check;
+  data.last_log_rotation = last_log_rotation;
+  data.modified_host_attributes = modified_host_process_attributes;
+  data.modified_service_attributes = modified_service_process_attributes;
+#ifdef LEGACY_CONF
+  data.enable_notifications = config->enable_notifications();
+  data.active_service_checks_enabled = config->execute_service_checks();
+  data.passive_service_checks_enabled = config->accept_passive_service_checks();
+  data.active_host_checks_enabled = config->execute_host_checks();
+  data.passive_host_checks_enabled = config->accept_passive_host_checks();
+  data.enable_event_handlers = config->enable_event_handlers();
+  data.obsess_over_services = config->obsess_over_services();
+  data.obsess_over_hosts = config->obsess_over_hosts();
+  data.check_service_freshness = config->check_service_freshness();
+  data.check_host_freshness = config->check_host_freshness();
+  data.enable_flap_detection = config->enable_flap_detection();
+  data.process_performance_data = config->process_performance_data();
+  strncpy(data.global_host_event_handler,
+          config->global_host_event_handler().c_str(),
+          sizeof(data.global_host_event_handler) - 1);
+  strncpy(data.global_service_event_handler,
+          config->global_service_event_handler().c_str(),
+          sizeof(data.global_service_event_handler) - 1);
+#else
+  data.enable_notifications = pb_config.enable_notifications();
+  data.active_service_checks_enabled = pb_config.execute_service_checks();
+  data.passive_service_checks_enabled =
+      pb_config.accept_passive_service_checks();
+  data.active_host_checks_enabled = pb_config.execute_host_checks();
+  data.passive_host_checks_enabled = pb_config.accept_passive_host_checks();
+  data.enable_event_handlers = pb_config.enable_event_handlers();
+  data.obsess_over_services = pb_config.obsess_over_services();
+  data.obsess_over_hosts = pb_config.obsess_over_hosts();
+  data.check_service_freshness = pb_config.check_service_freshness();
+  data.check_host_freshness = pb_config.check_host_freshness();
+  data.enable_flap_detection = pb_config.enable_flap_detection();
+  data.process_performance_data = pb_config.process_performance_data();
+  strncpy(data.global_host_event_handler,
+          pb_config.global_host_event_handler().c_str(),
+          sizeof(data.global_host_event_handler) - 1);
+  strncpy(data.global_service_event_handler,
+          pb_config.global_service_event_handler().c_str(),
+          sizeof(data.global_service_event_handler) - 1);
+#endif
+  data.next_comment_id = comment::get_next_comment_id();
+  data.next_event_id = next_event_id;
+  data.next_problem_id = next_problem_id;
+  data.next_notification_id = notifier::get_next_notification_id();
+
+  buffer_stats buffer;
+  if (get_external_command_buffer_stats(buffer)) {
+    data.used_external_command_buffer_slots = buffer.used;
+    data.high_external_command_buffer_slots = buffer.high;
+    data.total_external_command_buffer_slots = buffer.total;
+  }
+
+  checks::checker::instance().inspect_reap_partial(
+      [&data](const std::deque<check_result::pointer>& queue) {
+        data.check_results_to_reap = queue.size();
+      });
+  data.high_priority_events =
+      events::loop::instance().event_count(events::loop::high);
+  data.low_priority_events =
+      events::loop::instance().event_count(events::loop::low);
+
+  generate_check_stats();
+  for (int i = 0; i < MAX_CHECK_STATS_TYPES; ++i)
+    for (int j = 0; j < 3; ++j)
+      data.check_stats[i][j] = check_statistics[i].minute_stats[j];
+
+  compute_object_stats(host::hosts, now, data.hosts);
+  compute_object_stats(service::services, now, data.services);
+
+  _shm.publish(data);
+}
+
+/**
+ * @brief Read the statistics published in the shared memory segment. This
+ * method does not need the main loop, it can be called from any thread.
+ *
+ * @param data The structure to fill.
+ *
+ * @return true if data has been filled.
+ */
+bool statistics::read_shared_stats(shm_stats_data& data) const noexcept {
+  std::shared_lock<std::shared_mutex> lck(_shm_m);
+  return _shm.read(data);
+}
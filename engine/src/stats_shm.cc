@@ -0,0 +1,180 @@
+/*
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/stats_shm.hh"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <type_traits>
+
+using namespace com::centreon::engine;
+
+static_assert(std::is_trivially_copyable<shm_stats_data>::value,
+              "shm_stats_data is copied in a shared memory segment");
+
+/* Number of attempts made by a reader before giving up when the writer keeps
+ * updating the segment. */
+static constexpr int max_read_attempts = 1000;
+
+stats_shm::stats_shm() : _segment{nullptr}, _owner{false} {}
+
+stats_shm::~stats_shm() noexcept {
+  close();
+}
+
+/**
+ * @brief Create (or recreate) the shared memory segment. This is done by
+ * centengine, the only writer.
+ *
+ * @param name The segment name, as given to shm_open(), it must start with a
+ * slash.
+ *
+ * @return true on success, false otherwise (errno is set).
+ */
+bool stats_shm::create(const std::string& name) {
+  close();
+  /* A segment left by a previous instance is replaced. */
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+                    S_IRUSR | S_IWUSR | S_IRGRP);
+  if (fd == -1)
+    return false;
+  if (ftruncate(fd, sizeof(segment)) == -1) {
+    int err = errno;
+    ::close(fd);
+    shm_unlink(name.c_str());
+    errno = err;
+    return false;
+  }
+  void* addr =
+      mmap(nullptr, sizeof(segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int err = errno;
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    errno = err;
+    return false;
+  }
+  _segment = new (addr) segment;
+  _segment->sequence.store(0, std::memory_order_relaxed);
+  memset(&_segment->data, 0, sizeof(_segment->data));
+  _segment->data_size = sizeof(shm_stats_data);
+  _segment->version = version;
+  std::atomic_thread_fence(std::memory_order_release);
+  /* The magic is written last, so a reader opening the segment during its
+   * initialization sees it as not ready. */
+  _segment->magic = magic;
+  _name = name;
+  _owner = true;
+  return true;
+}
+
+/**
+ * @brief Open an existing segment in read only mode. The segment is refused
+ * if it has not been written by a centengine using the same layout.
+ *
+ * @param name The segment name.
+ *
+ * @return true on success, false otherwise.
+ */
+bool stats_shm::open(const std::string& name) {
+  close();
+  int fd = shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+  if (fd == -1)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < sizeof(segment)) {
+    ::close(fd);
+    errno = EINVAL;
+    return false;
+  }
+  void* addr = mmap(nullptr, sizeof(segment), PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+  segment* seg = static_cast<segment*>(addr);
+  if (seg->magic != magic || seg->version != version ||
+      seg->data_size != sizeof(shm_stats_data)) {
+    munmap(addr, sizeof(segment));
+    errno = EPROTO;
+    return false;
+  }
+  _segment = seg;
+  _name = name;
+  _owner = false;
+  return true;
+}
+
+/**
+ * @brief Unmap the segment. If it was created by this object, it is also
+ * removed.
+ */
+void stats_shm::close() noexcept {
+  if (_segment) {
+    munmap(_segment, sizeof(segment));
+    _segment = nullptr;
+    if (_owner)
+      shm_unlink(_name.c_str());
+  }
+  _owner = false;
+  _name.clear();
+}
+
+/**
+ * @brief Update the segment with new statistics. Only one thread is allowed
+ * to call this method.
+ *
+ * @param data The statistics to publish.
+ */
+void stats_shm::publish(const shm_stats_data& data) noexcept {
+  if (!_segment || !_owner)
+    return;
+  uint64_t seq = _segment->sequence.load(std::memory_order_relaxed);
+  _segment->sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(&_segment->data, &data, sizeof(data));
+  _segment->sequence.store(seq + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Copy the last published statistics.
+ *
+ * @param data The structure to fill.
+ *
+ * @return true if a consistent copy has been made, false if the segment is
+ * not open, has never been published or is constantly being updated.
+ */
+bool stats_shm::read(shm_stats_data& data) const noexcept {
+  if (!_segment)
+    return false;
+  for (int i = 0; i < max_read_attempts; ++i) {
+    uint64_t before = _segment->sequence.load(std::memory_order_acquire);
+    if (before == 0)
+      return false;
+    if (before & 1)
+      continue;
+    memcpy(&data, &_segment->data, sizeof(data));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_segment->sequence.load(std::memory_order_relaxed) == before)
+      return true;
+  }
+  return false;
+}
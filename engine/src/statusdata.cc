@@ -22,6 +22,7 @@
 
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/statistics.hh"
 #include "com/centreon/engine/xsddefault.hh"
 
 /******************************************************************/
@@ -43,6 +44,9 @@ int update_all_status_data() {
 
   result = xsddefault_save_status_data();
 
+  /* publish statistics in shared memory */
+  com::centreon::engine::statistics::instance().publish_shared_stats();
+
   /* send data to event broker */
   broker_aggregated_status_data(NEBTYPE_AGGREGATEDSTATUS_ENDDUMP, NEBFLAG_NONE,
                                 NEBATTR_NONE, NULL);
@@ -33,6 +33,7 @@
 #include "com/centreon/engine/broker/loader.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
@@ -418,6 +419,7 @@ bool set_cloexec(int fd) {
 void cleanup() {
   // Unload modules.
   if (!test_scheduling && !verify_config) {
+    commands::system_executor::deinit();
     checks::checker::deinit();
     neb_free_callback_list();
     neb_unload_all_modules(NEBMODULE_FORCE_UNLOAD, sigshutdown
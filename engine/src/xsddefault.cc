@@ -25,6 +25,9 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
@@ -43,6 +46,218 @@ using namespace com::centreon::engine::configuration::applier;
 
 static int xsddefault_status_log_fd(-1);
 
+namespace {
+/**
+ * @brief A serialized host or service. last_update changes on each dump, so
+ * the position of its value is kept to write the current time in place of it.
+ */
+struct status_block {
+  std::string data;
+  size_t time_pos = 0;
+  size_t time_len = 0;
+
+  void set(std::string&& serialized);
+  void append_to(std::string& buffer, time_t current_time) const;
+};
+
+/**
+ * @brief Writer used when status_file_incremental is enabled.
+ *
+ * The main thread only serializes again hosts and services whose status
+ * changed since the previous dump, the other blocks are taken from a cache.
+ * The built buffer is then given to a dedicated thread that writes it in a
+ * temporary file and renames it as the status file, so readers always see a
+ * complete file and the main thread never waits for the disk.
+ *
+ * Two buffers are swapped between the main thread and the writer thread, so
+ * their capacity is kept from one dump to the next.
+ */
+class status_file_writer {
+  std::string _status_file;
+  std::string _tmp_file;
+
+  mutable std::mutex _m;
+  std::condition_variable _cv;
+  std::string _pending;
+  bool _pending_ready = false;
+  bool _exit = false;
+  std::thread _thread;
+
+  /* Serialized hosts and services, indexed by object. */
+  absl::flat_hash_map<const notifier*, status_block> _blocks;
+
+  void _run();
+  bool _write(const std::string& data);
+
+ public:
+  std::atomic<uint64_t> last_write_duration_us{0};
+
+  status_file_writer(const std::string& status_file);
+  ~status_file_writer() noexcept;
+  status_file_writer(const status_file_writer&) = delete;
+  status_file_writer& operator=(const status_file_writer&) = delete;
+
+  const status_block* block(const notifier* n) const;
+  status_block& mut_block(const notifier* n) { return _blocks[n]; }
+  void clear_blocks() { _blocks.clear(); }
+  void publish(std::string& buffer);
+};
+
+status_file_writer::status_file_writer(const std::string& status_file)
+    : _status_file{status_file},
+      _tmp_file{status_file + ".tmp"},
+      _thread{&status_file_writer::_run, this} {}
+
+status_file_writer::~status_file_writer() noexcept {
+  {
+    std::lock_guard<std::mutex> lck(_m);
+    _exit = true;
+  }
+  _cv.notify_all();
+  _thread.join();
+}
+
+/**
+ * @brief Keep a serialized host or service and locate its last_update value.
+ *
+ * @param serialized The block built by xsddefault_write_*_status().
+ */
+void status_block::set(std::string&& serialized) {
+  static constexpr std::string_view key{"\tlast_update="};
+  data = std::move(serialized);
+  size_t pos = data.find(key);
+  if (pos == std::string::npos) {
+    time_pos = data.size();
+    time_len = 0;
+  } else {
+    time_pos = pos + key.size();
+    time_len = data.find('\n', time_pos) - time_pos;
+  }
+}
+
+/**
+ * @brief Append the block to buffer with current_time as last_update.
+ *
+ * @param buffer The status file content.
+ * @param current_time The time of the dump.
+ */
+void status_block::append_to(std::string& buffer, time_t current_time) const {
+  buffer.append(data, 0, time_pos);
+  if (time_len)
+    fmt::format_to(std::back_inserter(buffer), "{}",
+                   static_cast<unsigned long>(current_time));
+  buffer.append(data, time_pos + time_len);
+}
+
+/**
+ * @brief Return the cached block of the given host or service, nullptr if it
+ * has never been serialized.
+ */
+const status_block* status_file_writer::block(const notifier* n) const {
+  auto found = _blocks.find(n);
+  if (found == _blocks.end())
+    return nullptr;
+  return &found->second;
+}
+
+/**
+ * @brief Give a new status file content to the writer thread. buffer is
+ * swapped with the previous pending buffer (or a buffer already written) so
+ * that the caller can reuse its allocated memory for the next dump.
+ *
+ * @param buffer The status file content.
+ */
+void status_file_writer::publish(std::string& buffer) {
+  {
+    std::lock_guard<std::mutex> lck(_m);
+    if (_pending_ready)
+      SPDLOG_LOGGER_DEBUG(runtime_logger,
+                          "status file writer still busy, previous status "
+                          "data dump is skipped");
+    _pending.swap(buffer);
+    _pending_ready = true;
+  }
+  _cv.notify_all();
+  buffer.clear();
+}
+
+void status_file_writer::_run() {
+  std::string data;
+  std::unique_lock<std::mutex> lck(_m);
+  for (;;) {
+    _cv.wait(lck, [this] { return _exit || _pending_ready; });
+    if (!_pending_ready)
+      break;
+    data.swap(_pending);
+    _pending_ready = false;
+    lck.unlock();
+
+    auto start = std::chrono::steady_clock::now();
+    _write(data);
+    last_write_duration_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+
+    lck.lock();
+    /* The written buffer becomes the next pending one, it is given back to
+     * the main thread on its next publish(). */
+    if (!_pending_ready)
+      _pending.swap(data);
+  }
+}
+
+/**
+ * @brief Write data in the temporary file and rename it as the status file.
+ *
+ * @param data The content to write.
+ *
+ * @return true on success.
+ */
+bool status_file_writer::_write(const std::string& data) {
+  int fd = open(_tmp_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                S_IRUSR | S_IWUSR | S_IRGRP);
+  if (fd == -1) {
+    runtime_logger->error("Error: Unable to open status data file '{}': {}",
+                          _tmp_file, strerror(errno));
+    return false;
+  }
+  const char* data_ptr = data.data();
+  size_t size = data.size();
+  while (size > 0) {
+    ssize_t wb = write(fd, data_ptr, size);
+    if (wb <= 0) {
+      runtime_logger->error("Error: Unable to update status data file '{}': {}",
+                            _tmp_file, strerror(errno));
+      close(fd);
+      unlink(_tmp_file.c_str());
+      return false;
+    }
+    data_ptr += wb;
+    size -= wb;
+  }
+  close(fd);
+  if (rename(_tmp_file.c_str(), _status_file.c_str()) == -1) {
+    runtime_logger->error("Error: Unable to rename status data file '{}': {}",
+                          _tmp_file, strerror(errno));
+    unlink(_tmp_file.c_str());
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<status_file_writer> xsddefault_writer;
+
+/* Duration of the last serialization done on the main thread. */
+uint64_t xsddefault_last_serialization_us = 0;
+/* Duration of the last write (synchronous mode). */
+uint64_t xsddefault_last_write_us = 0;
+/* Number of hosts/services serialized again during the last dump. */
+uint32_t xsddefault_last_refreshed = 0;
+/* A buffer reused from one dump to the next one by the incremental mode. */
+std::string xsddefault_buffer;
+}  // namespace
+
 /******************************************************************/
 /********************* INIT/CLEANUP FUNCTIONS *********************/
 /******************************************************************/
@@ -53,11 +268,22 @@ int xsddefault_initialize_status_data() {
   const std::string& status_file = config->status_file();
 #else
   const std::string& status_file = pb_config.status_file();
+#endif
+#ifdef LEGACY_CONF
+  bool incremental = config->status_file_incremental();
+#else
+  bool incremental = pb_config.status_file_incremental();
 #endif
   if (verify_config || status_file.empty())
     return OK;
 
-  if (xsddefault_status_log_fd == -1) {
+  if (incremental) {
+    if (!xsddefault_writer) {
+      // delete the old status log (it might not exist).
+      unlink(status_file.c_str());
+      xsddefault_writer = std::make_unique<status_file_writer>(status_file);
+    }
+  } else if (xsddefault_status_log_fd == -1) {
     // delete the old status log (it might not exist).
     unlink(status_file.c_str());
 
@@ -86,6 +312,10 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
 #else
   const std::string& status_file = pb_config.status_file();
 #endif
+  // the writer thread must not recreate the file after its removal.
+  xsddefault_writer.reset();
+  xsddefault_buffer = std::string();
+
   // delete the status log.
   if (delete_status_data && !status_file.empty()) {
     if (unlink(status_file.c_str()))
@@ -103,9 +333,377 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
 /****************** STATUS DATA OUTPUT FUNCTIONS ******************/
 /******************************************************************/
 
+/**
+ * @brief Forget all the serialized hosts and services kept by the
+ * incremental writer. It is called after a configuration reload since objects
+ * may have been modified or removed.
+ */
+void xsddefault_invalidate_status_data() {
+  if (xsddefault_writer)
+    xsddefault_writer->clear_blocks();
+}
+
+/**
+ * @brief Write the status block of a host.
+ *
+ * @param stream The output stream.
+ * @param hst The host to serialize.
+ * @param current_time The time used as last_update.
+ */
+static void xsddefault_write_host_status(std::ostream& stream,
+                                         host& hst,
+                                         time_t current_time) {
+  stream
+      << "hoststatus {\n"
+         "\thost_name="
+      << hst.name()
+      << "\n"
+         "\tmodified_attributes="
+      << hst.get_modified_attributes()
+      << "\n"
+         "\tcheck_command="
+      << hst.check_command()
+      << "\n"
+         "\tcheck_period="
+      << hst.check_period()
+      << "\n"
+         "\tnotification_period="
+      << hst.notification_period()
+      << "\n"
+         "\tcheck_interval="
+      << hst.check_interval()
+      << "\n"
+         "\tretry_interval="
+      << hst.retry_interval()
+      << "\n"
+         "\tevent_handler="
+      << hst.event_handler()
+      << "\n"
+         "\thas_been_checked="
+      << hst.has_been_checked()
+      << "\n"
+         "\tshould_be_scheduled="
+      << hst.get_should_be_scheduled()
+      << "\n"
+         "\tcheck_execution_time="
+      << std::setprecision(3) << std::fixed
+      << hst.get_execution_time()
+      << "\n"
+         "\tcheck_latency="
+      << std::setprecision(3) << std::fixed << hst.get_latency()
+      << "\n"
+         "\tcheck_type="
+      << hst.get_check_type()
+      << "\n"
+         "\tcurrent_state="
+      << hst.get_current_state()
+      << "\n"
+         "\tlast_hard_state="
+      << hst.get_last_hard_state()
+      << "\n"
+         "\tlast_event_id="
+      << hst.get_last_event_id()
+      << "\n"
+         "\tcurrent_event_id="
+      << hst.get_current_event_id()
+      << "\n"
+         "\tcurrent_problem_id="
+      << hst.get_current_problem_id()
+      << "\n"
+         "\tlast_problem_id="
+      << hst.get_last_problem_id()
+      << "\n"
+         "\tplugin_output="
+      << hst.get_plugin_output()
+      << "\n"
+         "\tlong_plugin_output="
+      << hst.get_long_plugin_output()
+      << "\n"
+         "\tperformance_data="
+      << hst.get_perf_data()
+      << "\n"
+         "\tlast_check="
+      << static_cast<unsigned long>(hst.get_last_check())
+      << "\n"
+         "\tnext_check="
+      << static_cast<unsigned long>(hst.get_next_check())
+      << "\n"
+         "\tcheck_options="
+      << hst.get_check_options()
+      << "\n"
+         "\tcurrent_attempt="
+      << hst.get_current_attempt()
+      << "\n"
+         "\tmax_attempts="
+      << hst.max_check_attempts()
+      << "\n"
+         "\tstate_type="
+      << hst.get_state_type()
+      << "\n"
+         "\tlast_state_change="
+      << static_cast<unsigned long>(hst.get_last_state_change())
+      << "\n"
+         "\tlast_hard_state_change="
+      << static_cast<unsigned long>(hst.get_last_hard_state_change())
+      << "\n"
+         "\tlast_time_up="
+      << static_cast<unsigned long>(hst.get_last_time_up())
+      << "\n"
+         "\tlast_time_down="
+      << static_cast<unsigned long>(hst.get_last_time_down())
+      << "\n"
+         "\tlast_time_unreachable="
+      << static_cast<unsigned long>(hst.get_last_time_unreachable())
+      << "\n"
+         "\tlast_notification="
+      << static_cast<unsigned long>(hst.get_last_notification())
+      << "\n"
+         "\tnext_notification="
+      << static_cast<unsigned long>(hst.get_next_notification())
+      << "\n"
+         "\tno_more_notifications="
+      << hst.get_no_more_notifications()
+      << "\n"
+         "\tcurrent_notification_number="
+      << hst.get_notification_number()
+      << "\n"
+         "\tcurrent_notification_id="
+      << hst.get_current_notification_id()
+      << "\n"
+         "\tnotifications_enabled="
+      << hst.get_notifications_enabled()
+      << "\n"
+         "\tproblem_has_been_acknowledged="
+      << hst.problem_has_been_acknowledged()
+      << "\n"
+         "\tacknowledgement_type="
+      << hst.get_acknowledgement()
+      << "\n"
+         "\tactive_checks_enabled="
+      << hst.active_checks_enabled()
+      << "\n"
+         "\tpassive_checks_enabled="
+      << hst.passive_checks_enabled()
+      << "\n"
+         "\tevent_handler_enabled="
+      << hst.event_handler_enabled()
+      << "\n"
+         "\tflap_detection_enabled="
+      << hst.flap_detection_enabled()
+      << "\n"
+         "\tprocess_performance_data="
+      << hst.get_process_performance_data()
+      << "\n"
+         "\tobsess_over_host="
+      << hst.obsess_over()
+      << "\n"
+         "\tlast_update="
+      << static_cast<unsigned long>(current_time)
+      << "\n"
+         "\tis_flapping="
+      << hst.get_is_flapping()
+      << "\n"
+         "\tpercent_state_change="
+      << std::setprecision(2) << std::fixed
+      << hst.get_percent_state_change()
+      << "\n"
+         "\tscheduled_downtime_depth="
+      << hst.get_scheduled_downtime_depth() << "\n";
+
+  // custom variables
+  for (auto const& cv : hst.custom_variables) {
+    if (!cv.first.empty())
+      stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
+             << ";" << cv.second.value() << "\n";
+  }
+  stream << "\t}\n\n";
+}
+
+/**
+ * @brief Write the status block of a service.
+ *
+ * @param stream The output stream.
+ * @param svc The service to serialize.
+ * @param current_time The time used as last_update.
+ */
+static void xsddefault_write_service_status(std::ostream& stream,
+                                            service& svc,
+                                            time_t current_time) {
+  stream << "servicestatus {\n"
+            "\thost_name="
+         << svc.get_hostname()
+         << "\n"
+            "\tservice_description="
+         << svc.description()
+         << "\n"
+            "\tmodified_attributes="
+         << svc.get_modified_attributes()
+         << "\n"
+            "\tcheck_command="
+         << svc.check_command()
+         << "\n"
+            "\tcheck_period="
+         << svc.check_period()
+         << "\n"
+            "\tnotification_period="
+         << svc.notification_period()
+         << "\n"
+            "\tcheck_interval="
+         << svc.check_interval()
+         << "\n"
+            "\tretry_interval="
+         << svc.retry_interval()
+         << "\n"
+            "\tevent_handler="
+         << svc.event_handler()
+         << "\n"
+            "\thas_been_checked="
+         << svc.has_been_checked()
+         << "\n"
+            "\tshould_be_scheduled="
+         << svc.get_should_be_scheduled()
+         << "\n"
+            "\tcheck_execution_time="
+         << std::setprecision(3) << std::fixed
+         << svc.get_execution_time()
+         << "\n"
+            "\tcheck_latency="
+         << std::setprecision(3) << std::fixed << svc.get_latency()
+         << "\n"
+            "\tcheck_type="
+         << svc.get_check_type()
+         << "\n"
+            "\tcurrent_state="
+         << svc.get_current_state()
+         << "\n"
+            "\tlast_hard_state="
+         << svc.get_last_hard_state()
+         << "\n"
+            "\tlast_event_id="
+         << svc.get_last_event_id()
+         << "\n"
+            "\tcurrent_event_id="
+         << svc.get_current_event_id()
+         << "\n"
+            "\tcurrent_problem_id="
+         << svc.get_current_problem_id()
+         << "\n"
+            "\tlast_problem_id="
+         << svc.get_last_problem_id()
+         << "\n"
+            "\tcurrent_attempt="
+         << svc.get_current_attempt()
+         << "\n"
+            "\tmax_attempts="
+         << svc.max_check_attempts()
+         << "\n"
+            "\tstate_type="
+         << svc.get_state_type()
+         << "\n"
+            "\tlast_state_change="
+         << static_cast<unsigned long>(svc.get_last_state_change())
+         << "\n"
+            "\tlast_hard_state_change="
+         << static_cast<unsigned long>(
+                svc.get_last_hard_state_change())
+         << "\n"
+            "\tlast_time_ok="
+         << static_cast<unsigned long>(svc.get_last_time_ok())
+         << "\n"
+            "\tlast_time_warning="
+         << static_cast<unsigned long>(svc.get_last_time_warning())
+         << "\n"
+            "\tlast_time_unknown="
+         << static_cast<unsigned long>(svc.get_last_time_unknown())
+         << "\n"
+            "\tlast_time_critical="
+         << static_cast<unsigned long>(svc.get_last_time_critical())
+         << "\n"
+            "\tplugin_output="
+         << svc.get_plugin_output()
+         << "\n"
+            "\tlong_plugin_output="
+         << svc.get_long_plugin_output()
+         << "\n"
+            "\tperformance_data="
+         << svc.get_perf_data()
+         << "\n"
+            "\tlast_check="
+         << static_cast<unsigned long>(svc.get_last_check())
+         << "\n"
+            "\tnext_check="
+         << static_cast<unsigned long>(svc.get_next_check())
+         << "\n"
+            "\tcheck_options="
+         << svc.get_check_options()
+         << "\n"
+            "\tcurrent_notification_number="
+         << svc.get_notification_number()
+         << "\n"
+            "\tcurrent_notification_id="
+         << svc.get_current_notification_id()
+         << "\n"
+            "\tlast_notification="
+         << static_cast<unsigned long>(svc.get_last_notification())
+         << "\n"
+            "\tnext_notification="
+         << static_cast<unsigned long>(svc.get_next_notification())
+         << "\n"
+            "\tno_more_notifications="
+         << svc.get_no_more_notifications()
+         << "\n"
+            "\tnotifications_enabled="
+         << svc.get_notifications_enabled()
+         << "\n"
+            "\tactive_checks_enabled="
+         << svc.active_checks_enabled()
+         << "\n"
+            "\tpassive_checks_enabled="
+         << svc.passive_checks_enabled()
+         << "\n"
+            "\tevent_handler_enabled="
+         << svc.event_handler_enabled()
+         << "\n"
+            "\tproblem_has_been_acknowledged="
+         << svc.problem_has_been_acknowledged()
+         << "\n"
+            "\tacknowledgement_type="
+         << svc.get_acknowledgement()
+         << "\n"
+            "\tflap_detection_enabled="
+         << svc.flap_detection_enabled()
+         << "\n"
+            "\tprocess_performance_data="
+         << svc.get_process_performance_data()
+         << "\n"
+            "\tobsess_over_service="
+         << svc.obsess_over()
+         << "\n"
+            "\tlast_update="
+         << static_cast<unsigned long>(current_time)
+         << "\n"
+            "\tis_flapping="
+         << svc.get_is_flapping()
+         << "\n"
+            "\tpercent_state_change="
+         << std::setprecision(2) << std::fixed
+         << svc.get_percent_state_change()
+         << "\n"
+            "\tscheduled_downtime_depth="
+         << svc.get_scheduled_downtime_depth() << "\n";
+
+  // custom variables
+  for (auto const& cv : svc.custom_variables) {
+    if (!cv.first.empty())
+      stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
+             << ";" << cv.second.value() << "\n";
+  }
+  stream << "\t}\n\n";
+}
+
 /* write all status data to file */
 int xsddefault_save_status_data() {
-  if (xsddefault_status_log_fd == -1)
+  if (xsddefault_status_log_fd == -1 && !xsddefault_writer)
     return OK;
 
   int used_external_command_buffer_slots(0);
@@ -160,6 +758,7 @@ int xsddefault_save_status_data() {
   // generate check statistics
   generate_check_stats();
 
+  auto serialization_start = std::chrono::steady_clock::now();
   std::ostringstream stream;
 
   time_t current_time;
@@ -327,354 +926,67 @@ int xsddefault_save_status_data() {
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[0] << ","
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[1] << ","
       << check_statistics[SERIAL_HOST_CHECK_STATS].minute_stats[2]
+      << "\n"
+         "\tstatus_data_dump_time="
+      << xsddefault_last_serialization_us << ","
+      << (xsddefault_writer ? xsddefault_writer->last_write_duration_us.load()
+                            : xsddefault_last_write_us)
+      << "\n"
+         "\tstatus_data_refreshed_objects="
+      << xsddefault_last_refreshed << ","
+      << host::hosts.size() + service::services.size()
       << "\n"
          "\t}\n\n";
 
-  /* save host status data */
-  for (host_map::iterator it(com::centreon::engine::host::hosts.begin()),
-       end(com::centreon::engine::host::hosts.end());
-       it != end; ++it) {
-    stream
-        << "hoststatus {\n"
-           "\thost_name="
-        << it->second->name()
-        << "\n"
-           "\tmodified_attributes="
-        << it->second->get_modified_attributes()
-        << "\n"
-           "\tcheck_command="
-        << it->second->check_command()
-        << "\n"
-           "\tcheck_period="
-        << it->second->check_period()
-        << "\n"
-           "\tnotification_period="
-        << it->second->notification_period()
-        << "\n"
-           "\tcheck_interval="
-        << it->second->check_interval()
-        << "\n"
-           "\tretry_interval="
-        << it->second->retry_interval()
-        << "\n"
-           "\tevent_handler="
-        << it->second->event_handler()
-        << "\n"
-           "\thas_been_checked="
-        << it->second->has_been_checked()
-        << "\n"
-           "\tshould_be_scheduled="
-        << it->second->get_should_be_scheduled()
-        << "\n"
-           "\tcheck_execution_time="
-        << std::setprecision(3) << std::fixed
-        << it->second->get_execution_time()
-        << "\n"
-           "\tcheck_latency="
-        << std::setprecision(3) << std::fixed << it->second->get_latency()
-        << "\n"
-           "\tcheck_type="
-        << it->second->get_check_type()
-        << "\n"
-           "\tcurrent_state="
-        << it->second->get_current_state()
-        << "\n"
-           "\tlast_hard_state="
-        << it->second->get_last_hard_state()
-        << "\n"
-           "\tlast_event_id="
-        << it->second->get_last_event_id()
-        << "\n"
-           "\tcurrent_event_id="
-        << it->second->get_current_event_id()
-        << "\n"
-           "\tcurrent_problem_id="
-        << it->second->get_current_problem_id()
-        << "\n"
-           "\tlast_problem_id="
-        << it->second->get_last_problem_id()
-        << "\n"
-           "\tplugin_output="
-        << it->second->get_plugin_output()
-        << "\n"
-           "\tlong_plugin_output="
-        << it->second->get_long_plugin_output()
-        << "\n"
-           "\tperformance_data="
-        << it->second->get_perf_data()
-        << "\n"
-           "\tlast_check="
-        << static_cast<unsigned long>(it->second->get_last_check())
-        << "\n"
-           "\tnext_check="
-        << static_cast<unsigned long>(it->second->get_next_check())
-        << "\n"
-           "\tcheck_options="
-        << it->second->get_check_options()
-        << "\n"
-           "\tcurrent_attempt="
-        << it->second->get_current_attempt()
-        << "\n"
-           "\tmax_attempts="
-        << it->second->max_check_attempts()
-        << "\n"
-           "\tstate_type="
-        << it->second->get_state_type()
-        << "\n"
-           "\tlast_state_change="
-        << static_cast<unsigned long>(it->second->get_last_state_change())
-        << "\n"
-           "\tlast_hard_state_change="
-        << static_cast<unsigned long>(it->second->get_last_hard_state_change())
-        << "\n"
-           "\tlast_time_up="
-        << static_cast<unsigned long>(it->second->get_last_time_up())
-        << "\n"
-           "\tlast_time_down="
-        << static_cast<unsigned long>(it->second->get_last_time_down())
-        << "\n"
-           "\tlast_time_unreachable="
-        << static_cast<unsigned long>(it->second->get_last_time_unreachable())
-        << "\n"
-           "\tlast_notification="
-        << static_cast<unsigned long>(it->second->get_last_notification())
-        << "\n"
-           "\tnext_notification="
-        << static_cast<unsigned long>(it->second->get_next_notification())
-        << "\n"
-           "\tno_more_notifications="
-        << it->second->get_no_more_notifications()
-        << "\n"
-           "\tcurrent_notification_number="
-        << it->second->get_notification_number()
-        << "\n"
-           "\tcurrent_notification_id="
-        << it->second->get_current_notification_id()
-        << "\n"
-           "\tnotifications_enabled="
-        << it->second->get_notifications_enabled()
-        << "\n"
-           "\tproblem_has_been_acknowledged="
-        << it->second->problem_has_been_acknowledged()
-        << "\n"
-           "\tacknowledgement_type="
-        << it->second->get_acknowledgement()
-        << "\n"
-           "\tactive_checks_enabled="
-        << it->second->active_checks_enabled()
-        << "\n"
-           "\tpassive_checks_enabled="
-        << it->second->passive_checks_enabled()
-        << "\n"
-           "\tevent_handler_enabled="
-        << it->second->event_handler_enabled()
-        << "\n"
-           "\tflap_detection_enabled="
-        << it->second->flap_detection_enabled()
-        << "\n"
-           "\tprocess_performance_data="
-        << it->second->get_process_performance_data()
-        << "\n"
-           "\tobsess_over_host="
-        << it->second->obsess_over()
-        << "\n"
-           "\tlast_update="
-        << static_cast<unsigned long>(current_time)
-        << "\n"
-           "\tis_flapping="
-        << it->second->get_is_flapping()
-        << "\n"
-           "\tpercent_state_change="
-        << std::setprecision(2) << std::fixed
-        << it->second->get_percent_state_change()
-        << "\n"
-           "\tscheduled_downtime_depth="
-        << it->second->get_scheduled_downtime_depth() << "\n";
-
-    // custom variables
-    for (auto const& cv : it->second->custom_variables) {
-      if (!cv.first.empty())
-        stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
-               << ";" << cv.second.value() << "\n";
+  uint32_t refreshed = 0;
+  if (xsddefault_writer) {
+    /* Incremental mode: only dirty hosts and services are serialized again,
+     * other ones are copied from the cache with a fresh last_update. */
+    xsddefault_buffer.append(stream.str());
+    /* Same format as the full dump below, whatever block is written first. */
+    std::ostringstream block_stream;
+    block_stream << std::setprecision(2) << std::fixed;
+    for (auto it = host::hosts.begin(), end = host::hosts.end(); it != end;
+         ++it) {
+      host* hst = it->second.get();
+      if (hst->get_status_dirty() || !xsddefault_writer->block(hst)) {
+        block_stream.str("");
+        xsddefault_write_host_status(block_stream, *hst, current_time);
+        xsddefault_writer->mut_block(hst).set(block_stream.str());
+        hst->set_status_dirty(false);
+        ++refreshed;
+      }
+      xsddefault_writer->block(hst)->append_to(xsddefault_buffer,
+                                               current_time);
     }
-    stream << "\t}\n\n";
-  }
-
-  // save service status data
-  for (service_map::iterator it(service::services.begin()),
-       end(service::services.end());
-       it != end; ++it) {
-    stream << "servicestatus {\n"
-              "\thost_name="
-           << it->second->get_hostname()
-           << "\n"
-              "\tservice_description="
-           << it->second->description()
-           << "\n"
-              "\tmodified_attributes="
-           << it->second->get_modified_attributes()
-           << "\n"
-              "\tcheck_command="
-           << it->second->check_command()
-           << "\n"
-              "\tcheck_period="
-           << it->second->check_period()
-           << "\n"
-              "\tnotification_period="
-           << it->second->notification_period()
-           << "\n"
-              "\tcheck_interval="
-           << it->second->check_interval()
-           << "\n"
-              "\tretry_interval="
-           << it->second->retry_interval()
-           << "\n"
-              "\tevent_handler="
-           << it->second->event_handler()
-           << "\n"
-              "\thas_been_checked="
-           << it->second->has_been_checked()
-           << "\n"
-              "\tshould_be_scheduled="
-           << it->second->get_should_be_scheduled()
-           << "\n"
-              "\tcheck_execution_time="
-           << std::setprecision(3) << std::fixed
-           << it->second->get_execution_time()
-           << "\n"
-              "\tcheck_latency="
-           << std::setprecision(3) << std::fixed << it->second->get_latency()
-           << "\n"
-              "\tcheck_type="
-           << it->second->get_check_type()
-           << "\n"
-              "\tcurrent_state="
-           << it->second->get_current_state()
-           << "\n"
-              "\tlast_hard_state="
-           << it->second->get_last_hard_state()
-           << "\n"
-              "\tlast_event_id="
-           << it->second->get_last_event_id()
-           << "\n"
-              "\tcurrent_event_id="
-           << it->second->get_current_event_id()
-           << "\n"
-              "\tcurrent_problem_id="
-           << it->second->get_current_problem_id()
-           << "\n"
-              "\tlast_problem_id="
-           << it->second->get_last_problem_id()
-           << "\n"
-              "\tcurrent_attempt="
-           << it->second->get_current_attempt()
-           << "\n"
-              "\tmax_attempts="
-           << it->second->max_check_attempts()
-           << "\n"
-              "\tstate_type="
-           << it->second->get_state_type()
-           << "\n"
-              "\tlast_state_change="
-           << static_cast<unsigned long>(it->second->get_last_state_change())
-           << "\n"
-              "\tlast_hard_state_change="
-           << static_cast<unsigned long>(
-                  it->second->get_last_hard_state_change())
-           << "\n"
-              "\tlast_time_ok="
-           << static_cast<unsigned long>(it->second->get_last_time_ok())
-           << "\n"
-              "\tlast_time_warning="
-           << static_cast<unsigned long>(it->second->get_last_time_warning())
-           << "\n"
-              "\tlast_time_unknown="
-           << static_cast<unsigned long>(it->second->get_last_time_unknown())
-           << "\n"
-              "\tlast_time_critical="
-           << static_cast<unsigned long>(it->second->get_last_time_critical())
-           << "\n"
-              "\tplugin_output="
-           << it->second->get_plugin_output()
-           << "\n"
-              "\tlong_plugin_output="
-           << it->second->get_long_plugin_output()
-           << "\n"
-              "\tperformance_data="
-           << it->second->get_perf_data()
-           << "\n"
-              "\tlast_check="
-           << static_cast<unsigned long>(it->second->get_last_check())
-           << "\n"
-              "\tnext_check="
-           << static_cast<unsigned long>(it->second->get_next_check())
-           << "\n"
-              "\tcheck_options="
-           << it->second->get_check_options()
-           << "\n"
-              "\tcurrent_notification_number="
-           << it->second->get_notification_number()
-           << "\n"
-              "\tcurrent_notification_id="
-           << it->second->get_current_notification_id()
-           << "\n"
-              "\tlast_notification="
-           << static_cast<unsigned long>(it->second->get_last_notification())
-           << "\n"
-              "\tnext_notification="
-           << static_cast<unsigned long>(it->second->get_next_notification())
-           << "\n"
-              "\tno_more_notifications="
-           << it->second->get_no_more_notifications()
-           << "\n"
-              "\tnotifications_enabled="
-           << it->second->get_notifications_enabled()
-           << "\n"
-              "\tactive_checks_enabled="
-           << it->second->active_checks_enabled()
-           << "\n"
-              "\tpassive_checks_enabled="
-           << it->second->passive_checks_enabled()
-           << "\n"
-              "\tevent_handler_enabled="
-           << it->second->event_handler_enabled()
-           << "\n"
-              "\tproblem_has_been_acknowledged="
-           << it->second->problem_has_been_acknowledged()
-           << "\n"
-              "\tacknowledgement_type="
-           << it->second->get_acknowledgement()
-           << "\n"
-              "\tflap_detection_enabled="
-           << it->second->flap_detection_enabled()
-           << "\n"
-              "\tprocess_performance_data="
-           << it->second->get_process_performance_data()
-           << "\n"
-              "\tobsess_over_service="
-           << it->second->obsess_over()
-           << "\n"
-              "\tlast_update="
-           << static_cast<unsigned long>(current_time)
-           << "\n"
-              "\tis_flapping="
-           << it->second->get_is_flapping()
-           << "\n"
-              "\tpercent_state_change="
-           << std::setprecision(2) << std::fixed
-           << it->second->get_percent_state_change()
-           << "\n"
-              "\tscheduled_downtime_depth="
-           << it->second->get_scheduled_downtime_depth() << "\n";
-
-    // custom variables
-    for (auto const& cv : it->second->custom_variables) {
-      if (!cv.first.empty())
-        stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
-               << ";" << cv.second.value() << "\n";
+    for (auto it = service::services.begin(), end = service::services.end();
+         it != end; ++it) {
+      service* svc = it->second.get();
+      if (svc->get_status_dirty() || !xsddefault_writer->block(svc)) {
+        block_stream.str("");
+        xsddefault_write_service_status(block_stream, *svc, current_time);
+        xsddefault_writer->mut_block(svc).set(block_stream.str());
+        svc->set_status_dirty(false);
+        ++refreshed;
+      }
+      xsddefault_writer->block(svc)->append_to(xsddefault_buffer,
+                                               current_time);
     }
-    stream << "\t}\n\n";
+    stream.str("");
+  } else {
+    // save host status data, the first host gets the format of the others.
+    stream << std::setprecision(2) << std::fixed;
+    for (auto it = host::hosts.begin(), end = host::hosts.end(); it != end;
+         ++it)
+      xsddefault_write_host_status(stream, *it->second, current_time);
+
+    // save service status data
+    for (auto it = service::services.begin(), end = service::services.end();
+         it != end; ++it)
+      xsddefault_write_service_status(stream, *it->second, current_time);
+    refreshed = host::hosts.size() + service::services.size();
   }
+  xsddefault_last_refreshed = refreshed;
 
   // save contact status data
   for (contact_map::const_iterator it{contact::contacts.begin()},
@@ -769,6 +1081,25 @@ int xsddefault_save_status_data() {
   // Write data in buffer.
   stream.flush();
 
+  if (xsddefault_writer) {
+    xsddefault_buffer.append(stream.str());
+    xsddefault_last_serialization_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - serialization_start)
+            .count();
+    size_t size = xsddefault_buffer.size();
+    xsddefault_writer->publish(xsddefault_buffer);
+    // Prepare the next buffer so that appends do not have to reallocate.
+    xsddefault_buffer.reserve(size + size / 8);
+    return OK;
+  }
+
+  xsddefault_last_serialization_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - serialization_start)
+          .count();
+  auto write_start = std::chrono::steady_clock::now();
+
 #ifdef LEGACY_CONF
   const std::string& status_file = config->status_file();
 #else
@@ -806,6 +1137,10 @@ int xsddefault_save_status_data() {
     data_ptr += wb;
     size -= wb;
   }
+  xsddefault_last_write_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - write_start)
+          .count();
 
   return OK;
 }
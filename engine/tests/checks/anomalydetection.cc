@@ -1002,6 +1002,44 @@ TEST_F(AnomalydetectionCheck, BadThresholdsFile) {
   ::unlink("/tmp/thresholds_status_change.json");
 }
 
+TEST_F(AnomalydetectionCheck, ThresholdsStoreParsedOnce) {
+  CreateFile("/tmp/thresholds_status_change.json",
+             "[{\n \"host_id\": \"12\",\n \"service_id\": \"9\",\n "
+             "\"metric_name\": \"metric\",\n \"sensitivity\": 1,\n "
+             "\"predict\": [{\n \"timestamp\": 50000,\n \"upper\": 84,\n "
+             "\"lower\": 74,\n \"fit\": 79\n }, {\n \"timestamp\": "
+             "100000,\n \"upper\": 10,\n \"lower\": 5,\n \"fit\": 51.5\n "
+             "}]}, {\n \"host_id\": \"12\",\n \"service_id\": \"10\",\n "
+             "\"metric_name\": \"other\",\n "
+             "\"predict\": [{\n \"timestamp\": 50000,\n \"upper\": 84,\n "
+             "\"lower\": 74,\n \"fit\": 79\n }]}]");
+  auto& store = anomalydetection::thresholds_store::instance();
+  auto idx = store.get("/tmp/thresholds_status_change.json");
+  ASSERT_TRUE(idx);
+  ASSERT_EQ(idx->size(), 2u);
+  /* The file has not changed, so it is not parsed again. */
+  ASSERT_EQ(store.get("/tmp/thresholds_status_change.json"), idx);
+
+  _ad->init_thresholds();
+  auto series = _ad->get_thresholds();
+  ASSERT_TRUE(series);
+  ASSERT_EQ(series->points.size(), 2u);
+  ASSERT_EQ(series, idx->at({12, 9, "metric"}));
+
+  /* A forced reload gives new series to the services. */
+  ASSERT_EQ(
+      anomalydetection::update_thresholds("/tmp/thresholds_status_change.json"),
+      0);
+  auto idx2 = store.get("/tmp/thresholds_status_change.json");
+  ASSERT_NE(idx2, idx);
+  ASSERT_EQ(_ad->get_thresholds(), idx2->at({12, 9, "metric"}));
+  /* The previous series is still usable by those who hold it. */
+  ASSERT_EQ(series->points.size(), 2u);
+
+  ::unlink("/tmp/thresholds_status_change.json");
+  ASSERT_FALSE(store.get("/tmp/thresholds_status_change.json"));
+}
+
 class AnomalydetectionCheckFileTooOld
     : public AnomalydetectionCheck,
       public testing::WithParamInterface<
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "../test_engine.hh"
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "helper.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+extern configuration::State pb_config;
+
+/* Enough services for the results to be prepared by the workers, since
+ * there are at least 64 results per worker. */
+static constexpr uint32_t hosts_count = 4;
+static constexpr uint32_t services_per_host = 50;
+
+class PbCheckReaper : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    pb_config.clear_contacts();
+    configuration::applier::contact ct_aply;
+    configuration::Contact ctct = new_pb_configuration_contact("admin", true);
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(pb_config);
+    configuration::error_cnt err;
+    ct_aply.resolve_object(ctct, err);
+
+    configuration::applier::host hst_aply;
+    configuration::applier::service svc_aply;
+    std::vector<configuration::Host> hosts;
+    std::vector<configuration::Service> services;
+    for (uint32_t i = 1; i <= hosts_count; ++i) {
+      hosts.push_back(new_pb_configuration_host(fmt::format("host_{}", i),
+                                                "admin", i));
+      hst_aply.add_object(hosts.back());
+      for (uint32_t j = 1; j <= services_per_host; ++j) {
+        services.push_back(new_pb_configuration_service(
+            fmt::format("host_{}", i), fmt::format("service_{}", j), "admin",
+            (i - 1) * services_per_host + j));
+        svc_aply.add_object(services.back());
+      }
+    }
+    for (auto& h : hosts)
+      hst_aply.resolve_object(h, err);
+    for (auto& s : services)
+      svc_aply.resolve_object(s, err);
+
+    for (auto& p : engine::service::services) {
+      p.second->set_current_state(engine::service::state_ok);
+      p.second->set_state_type(checkable::hard);
+      p.second->set_accept_passive_checks(true);
+      p.second->set_current_attempt(1);
+    }
+    for (auto& p : engine::host::hosts)
+      p.second->set_current_state(engine::host::state_up);
+  }
+
+  void TearDown() override {
+    pb_config.set_check_reaper_threads(0);
+    checks::checker::instance().reap();
+    deinit_config_state();
+  }
+
+ protected:
+  /**
+   * @brief Queue rounds passive results for each service, the output of each
+   * one contains its round.
+   */
+  static std::vector<check_result::pointer> _queue_results(uint32_t rounds) {
+    std::vector<check_result::pointer> results;
+    timeval tv{time(nullptr), 0};
+    for (uint32_t r = 0; r < rounds; ++r)
+      for (auto& p : engine::service::services)
+        results.push_back(std::make_shared<check_result>(
+            service_check, p.second.get(), checkable::check_passive,
+            CHECK_OPTION_NONE, false, 0.0, tv, tv, false, true,
+            service::state_ok,
+            fmt::format("round {} of {}\nlong {}|metric={}", r,
+                        p.second->service_id(), r, r)));
+    std::vector<check_result::pointer> to_reap{results};
+    checks::checker::instance().add_check_results_to_reap(to_reap);
+    return results;
+  }
+};
+
+/**
+ * With workers, results are parsed out of the main loop and applied in the
+ * reap() call, in their arrival order: the last round is the one kept.
+ */
+TEST_F(PbCheckReaper, ResultsPreparedByWorkers) {
+  set_time(60000);
+  pb_config.set_check_reaper_threads(2);
+  auto results = _queue_results(3);
+  checks::checker::instance().reap();
+
+  for (auto& p : engine::service::services) {
+    ASSERT_EQ(p.second->get_plugin_output(),
+              fmt::format("round 2 of {}", p.second->service_id()));
+    ASSERT_EQ(p.second->get_long_plugin_output(), "long 2");
+    ASSERT_EQ(p.second->get_perf_data(), "metric=2");
+  }
+  /* The parsed outputs have been moved to the services. */
+  for (auto& cr : results) {
+    ASSERT_FALSE(cr->is_output_parsed());
+    ASSERT_TRUE(cr->get_plugin_output().empty());
+  }
+  checks::checker::instance().inspect_reap_partial(
+      [](const std::deque<check_result::pointer>& queue) {
+        ASSERT_TRUE(queue.empty());
+      });
+}
+
+/**
+ * Workers and the main loop alone give the same services states.
+ */
+TEST_F(PbCheckReaper, SameAsMainLoop) {
+  set_time(60000);
+  for (uint32_t threads : {0u, 3u}) {
+    pb_config.set_check_reaper_threads(threads);
+    _queue_results(2);
+    checks::checker::instance().reap();
+    for (auto& p : engine::service::services) {
+      ASSERT_EQ(p.second->get_plugin_output(),
+                fmt::format("round 1 of {}", p.second->service_id()))
+          << threads << " threads";
+      ASSERT_EQ(p.second->get_perf_data(), "metric=1")
+          << threads << " threads";
+      p.second->set_plugin_output("");
+      p.second->set_perf_data("");
+    }
+  }
+}
+
+/**
+ * A result already prepared by parse_output() is moved once, a second call
+ * parses the raw output again.
+ */
+TEST_F(PbCheckReaper, TakeParsedOutput) {
+  check_result cr;
+  cr.set_output("short\nlong|a=1");
+  cr.parse_output();
+  std::string plugin_output, long_plugin_output, perf_data;
+  cr.take_parsed_output(plugin_output, long_plugin_output, perf_data);
+  ASSERT_EQ(plugin_output, "short");
+  ASSERT_EQ(long_plugin_output, "long");
+  ASSERT_EQ(perf_data, "a=1");
+  ASSERT_FALSE(cr.is_output_parsed());
+
+  cr.take_parsed_output(plugin_output, long_plugin_output, perf_data);
+  ASSERT_EQ(plugin_output, "short");
+  ASSERT_EQ(long_plugin_output, "long");
+  ASSERT_EQ(perf_data, "a=1");
+}
+
+/**
+ * A result taken by the main loop before its worker reached it is not parsed
+ * again by the worker.
+ */
+TEST_F(PbCheckReaper, TakenOutputIsNotParsedByWorker) {
+  check_result cr;
+  cr.set_output("short|a=1");
+  std::string plugin_output, long_plugin_output, perf_data;
+  cr.take_parsed_output(plugin_output, long_plugin_output, perf_data);
+  ASSERT_EQ(plugin_output, "short");
+  ASSERT_EQ(perf_data, "a=1");
+  ASSERT_FALSE(cr.parse_output());
+  ASSERT_FALSE(cr.is_output_parsed());
+
+  cr.set_output("other");
+  ASSERT_TRUE(cr.parse_output());
+  ASSERT_FALSE(cr.parse_output());
+  ASSERT_TRUE(cr.is_output_parsed());
+}
@@ -0,0 +1,203 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+
+#include "com/centreon/engine/commands/system_executor.hh"
+#include "helper.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::commands;
+
+class SystemExecutor : public ::testing::Test {
+ public:
+  void SetUp() override {
+    init_config_state();
+#ifdef LEGACY_CONF
+    config->max_parallel_system_commands(20);
+#else
+    pb_config.set_max_parallel_system_commands(20);
+#endif
+  }
+
+  void TearDown() override { deinit_config_state(); }
+};
+
+// Given a command
+// When it is run by the system executor
+// Then its result is given to the callback by reap().
+TEST_F(SystemExecutor, RunAndReap) {
+  nagios_macros* mac(get_global_macros());
+  std::string output;
+  int exit_code = -1;
+  system_executor::instance().run(system_executor::notification,
+                                  "/bin/echo -n hello", *mac, 5,
+                                  [&](const result& res) {
+                                    output = res.output;
+                                    exit_code = res.exit_code;
+                                  });
+  ASSERT_EQ(exit_code, -1);
+  system_executor::instance().wait_completion();
+  ASSERT_EQ(exit_code, 0);
+  ASSERT_EQ(output, "hello");
+  ASSERT_EQ(system_executor::instance().running(), 0u);
+}
+
+// Given a command longer than its timeout
+// When it is run by the system executor
+// Then the result has a timeout status.
+TEST_F(SystemExecutor, Timeout) {
+  nagios_macros* mac(get_global_macros());
+  bool timeout = false;
+  system_executor::instance().run(system_executor::event_handler,
+                                  "/bin/sleep 5", *mac, 1,
+                                  [&](const result& res) {
+                                    timeout =
+                                        res.exit_status == process::timeout;
+                                  });
+  system_executor::instance().wait_completion();
+  ASSERT_TRUE(timeout);
+}
+
+// Given a storm of 1000 notifications
+// When they are submitted to the system executor
+// Then they are queued, they are all executed and an event handler submitted
+// after them does not wait for them.
+TEST_F(SystemExecutor, NotificationStorm) {
+  constexpr uint32_t storm_size = 1000;
+  nagios_macros* mac(get_global_macros());
+  system_executor& executor = system_executor::instance();
+
+  uint32_t done = 0;
+  for (uint32_t i = 0; i < storm_size; ++i) {
+    executor.run(system_executor::notification, "/bin/true", *mac, 5,
+                 [&done](const result&) { ++done; });
+    /* The main loop reaps the finished commands from time to time. */
+    if (i % 100 == 0)
+      executor.reap();
+  }
+  ASSERT_LE(executor.running(), 20u);
+  ASSERT_GT(executor.waiting(), 0u);
+
+  bool handler_done = false;
+  uint32_t done_before_handler = 0;
+  executor.run(system_executor::event_handler, "/bin/true", *mac, 5,
+               [&](const result&) {
+                 handler_done = true;
+                 done_before_handler = done;
+               });
+  while (!handler_done) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    executor.reap();
+  }
+  ASSERT_LT(done_before_handler, storm_size);
+
+  executor.wait_completion();
+  ASSERT_EQ(done, storm_size);
+  ASSERT_EQ(executor.waiting(), 0u);
+}
+
+// Given queued commands
+// When the system executor is destroyed
+// Then they are all executed.
+TEST_F(SystemExecutor, DeinitRunsQueuedCommands) {
+#ifdef LEGACY_CONF
+  config->max_parallel_system_commands(1);
+#else
+  pb_config.set_max_parallel_system_commands(1);
+#endif
+  nagios_macros* mac(get_global_macros());
+  uint32_t done = 0;
+  for (int i = 0; i < 10; ++i)
+    system_executor::instance().run(system_executor::notification, "/bin/true",
+                                    *mac, 5,
+                                    [&done](const result&) { ++done; });
+  ASSERT_EQ(system_executor::instance().running(), 1u);
+  ASSERT_EQ(system_executor::instance().waiting(), 9u);
+  system_executor::deinit();
+  ASSERT_EQ(done, 10u);
+  system_executor::init();
+}
+
+// Given queued commands that cannot be over before the shutdown max wait
+// When the system executor is destroyed
+// Then the running command is waited for and the queued ones are dropped,
+// their callbacks getting a crash status.
+TEST_F(SystemExecutor, DeinitDropsQueuedCommandsAfterMaxWait) {
+#ifdef LEGACY_CONF
+  config->max_parallel_system_commands(1);
+#else
+  pb_config.set_max_parallel_system_commands(1);
+#endif
+  nagios_macros* mac(get_global_macros());
+  uint32_t done = 0;
+  uint32_t dropped = 0;
+  for (int i = 0; i < 10; ++i)
+    system_executor::instance().run(
+        system_executor::notification, "/bin/sleep 1", *mac, 5,
+        [&done, &dropped](const result& res) {
+          if (res.exit_status == process::crash)
+            ++dropped;
+          else
+            ++done;
+        });
+  ASSERT_EQ(system_executor::instance().waiting(), 9u);
+  system_executor::deinit(std::chrono::milliseconds(100));
+  ASSERT_EQ(done, 1u);
+  ASSERT_EQ(dropped, 9u);
+  system_executor::init();
+}
+
+// Given several obsessive commands
+// When they are run by the system executor
+// Then they are executed one at a time, in their submission order.
+TEST_F(SystemExecutor, ObsessiveCommandsInOrder) {
+  nagios_macros* mac(get_global_macros());
+  std::vector<int> order;
+  for (int i = 0; i < 5; ++i)
+    system_executor::instance().run(
+        system_executor::obsessive, "/bin/true", *mac, 5,
+        [&order, i](const result&) { order.push_back(i); });
+  ASSERT_EQ(system_executor::instance().running(), 1u);
+  ASSERT_EQ(system_executor::instance().waiting(), 4u);
+  system_executor::instance().wait_completion();
+  ASSERT_EQ(order, std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+// Given async_system_commands disabled
+// When a command is run by the system executor
+// Then it is over and its callback called when run() returns.
+TEST_F(SystemExecutor, SyncCommands) {
+#ifdef LEGACY_CONF
+  config->async_system_commands(false);
+#else
+  pb_config.set_async_system_commands(false);
+#endif
+  nagios_macros* mac(get_global_macros());
+  std::string output;
+  system_executor::instance().run(
+      system_executor::notification, "/bin/echo -n hello", *mac, 5,
+      [&output](const result& res) { output = res.output; });
+  ASSERT_EQ(output, "hello");
+  ASSERT_EQ(system_executor::instance().running(), 0u);
+  ASSERT_EQ(system_executor::instance().waiting(), 0u);
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include "com/centreon/engine/downtimes/service_downtime.hh"
+#include "helper.hh"
+#include "test_engine.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::downtimes;
+
+class DowntimeManager : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::error_cnt err;
+    configuration::applier::contact ct_aply;
+    configuration::Contact ctct{new_pb_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(pb_config);
+    ct_aply.resolve_object(ctct, err);
+
+    configuration::Host hst{new_pb_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+
+    configuration::Service svc{
+        new_pb_configuration_service("test_host", "test_svc", "admin", 8)};
+    configuration::applier::service svc_aply;
+    svc_aply.add_object(svc);
+
+    hst_aply.resolve_object(hst, err);
+    svc_aply.resolve_object(svc, err);
+
+    _svc = service::services_by_id.find({12, 8})->second;
+    downtime_manager::instance().clear_scheduled_downtimes();
+    downtime_manager::instance().initialize_downtime_data();
+  }
+
+  void TearDown() override {
+    _svc.reset();
+    downtime_manager::instance().clear_scheduled_downtimes();
+    deinit_config_state();
+  }
+
+ protected:
+  std::shared_ptr<engine::service> _svc;
+};
+
+/* Many flexible downtimes are scheduled on other services than test_svc, and
+ * check results of test_svc are processed against them: only the downtime of
+ * test_svc must be started. */
+TEST_F(DowntimeManager, ManyFlexibleDowntimes) {
+  constexpr uint64_t nb_downtimes = 10000;
+  set_time(20000);
+  time_t now = time(nullptr);
+  downtime_manager& mgr = downtime_manager::instance();
+
+  for (uint64_t i = 1; i <= nb_downtimes; ++i)
+    mgr.add_downtime(std::make_shared<service_downtime>(
+        12, 1000 + i, now, "admin", "other", now - 10 + (i % 100),
+        now + 3600 + (i % 100), false, 0, 600, i));
+  mgr.add_downtime(std::make_shared<service_downtime>(
+      12, 8, now, "admin", "test_svc", now - 10, now + 3600, false, 0, 600,
+      nb_downtimes + 1));
+  ASSERT_EQ(mgr.get_scheduled_downtimes().size(), nb_downtimes + 1);
+
+  /* check results */
+  _svc->set_current_state(engine::service::state_critical);
+  for (int i = 0; i < 100; ++i)
+    ASSERT_EQ(mgr.check_pending_flex_service_downtime(_svc.get()), OK);
+  std::shared_ptr<downtime> dt =
+      mgr.find_downtime(downtime::service_downtime, nb_downtimes + 1);
+  ASSERT_TRUE(dt);
+  ASSERT_TRUE(dt->is_in_effect());
+
+  for (uint64_t i = 1; i <= nb_downtimes; ++i) {
+    std::shared_ptr<downtime> d = mgr.find_downtime(downtime::any_downtime, i);
+    ASSERT_TRUE(d);
+    ASSERT_FALSE(d->is_in_effect());
+  }
+  ASSERT_FALSE(mgr.find_downtime(downtime::host_downtime, 1));
+
+  /* Every downtime has ended except the started one. */
+  set_time(now + 7200);
+  mgr.check_for_expired_downtime();
+  ASSERT_EQ(mgr.get_scheduled_downtimes().size(), 1u);
+  ASSERT_EQ(mgr.find_downtime(downtime::any_downtime, nb_downtimes + 1), dt);
+  ASSERT_FALSE(mgr.find_downtime(downtime::any_downtime, 1));
+}
+
+TEST_F(DowntimeManager, IndexesFollowDeletions) {
+  set_time(20000);
+  time_t now = time(nullptr);
+  downtime_manager& mgr = downtime_manager::instance();
+  for (uint64_t i = 1; i <= 10; ++i)
+    mgr.add_downtime(std::make_shared<service_downtime>(
+        12, 8, now, "admin", "test_svc", now - 10, now + 3600, false, 0, 600,
+        i));
+  for (uint64_t i = 1; i <= 10; i += 2)
+    mgr.delete_downtime(i);
+  ASSERT_EQ(mgr.get_scheduled_downtimes().size(), 5u);
+  for (uint64_t i = 1; i <= 10; ++i)
+    ASSERT_EQ(static_cast<bool>(mgr.find_downtime(downtime::any_downtime, i)),
+              i % 2 == 0);
+
+  /* The remaining ones are still found by service. */
+  _svc->set_current_state(engine::service::state_critical);
+  ASSERT_EQ(mgr.check_pending_flex_service_downtime(_svc.get()), OK);
+  for (uint64_t i = 2; i <= 10; i += 2)
+    ASSERT_TRUE(mgr.find_downtime(downtime::any_downtime, i)->is_in_effect());
+}
@@ -21,6 +21,7 @@
 #include "../timeperiod/utils.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/commands.hh"
+#include "com/centreon/engine/commands/processing.hh"
 #include "com/centreon/engine/configuration/applier/command.hh"
 #include "com/centreon/engine/configuration/applier/host.hh"
 #include "com/centreon/engine/configuration/applier/service.hh"
@@ -152,6 +153,186 @@ TEST_F(ServiceExternalCommand, AddServiceDowntimeByHostIpAddress) {
   ASSERT_NE(out.find("PASSIVE SERVICE CHECK"), std::string::npos);
 }
 
+TEST_F(ServiceExternalCommand, BatchedPassiveCheckResults) {
+  configuration::applier::host hst_aply;
+  configuration::applier::service svc_aply;
+  configuration::applier::command cmd_aply;
+  configuration::Service svc;
+  configuration::service_helper svc_hlp(&svc);
+  configuration::Host hst;
+  configuration::host_helper hst_hlp(&hst);
+  configuration::Command cmd;
+  configuration::command_helper cmd_hlp(&cmd);
+  cmd.set_command_name("cmd");
+
+  hst.set_host_name("test_host");
+  hst.set_address("127.0.0.3");
+  hst.set_host_id(1);
+
+  svc.set_host_name("test_host");
+  svc.set_service_description("test_description");
+  svc.set_service_id(3);
+
+  cmd.set_command_line("/usr/bin/echo 1");
+  cmd_aply.add_object(cmd);
+
+  hst.set_check_command("cmd");
+  svc.set_check_command("cmd");
+
+  hst_aply.add_object(hst);
+
+  // We fake here the expand_object on configuration::service
+  svc.set_host_id(1);
+
+  svc_aply.add_object(svc);
+
+  hst_aply.expand_objects(pb_config);
+  svc_aply.expand_objects(pb_config);
+
+  configuration::error_cnt err;
+  hst_aply.resolve_object(hst, err);
+  svc_aply.resolve_object(svc, err);
+
+  set_time(20000);
+  time_t now = time(nullptr);
+
+  std::string cmds = fmt::format(
+      "[{0}] PROCESS_SERVICE_CHECK_RESULT;test_host;test_description;1;warn\n"
+      "[{0}] PROCESS_SERVICE_CHECK_RESULT;127.0.0.3;test_description;2;crit\n"
+      "[{0}] PROCESS_SERVICE_CHECK_RESULT;unknown_host;test_description;0;ok\n"
+      "[{0}] PROCESS_HOST_CHECK_RESULT;test_host;0;up",
+      now);
+  std::vector<std::string_view> batch =
+      absl::StrSplit(std::string_view(cmds), '\n');
+  for (std::string_view c : batch)
+    ASSERT_TRUE(commands::processing::is_passive_check_result(c));
+  ASSERT_FALSE(commands::processing::is_passive_check_result(
+      "[1234] SCHEDULE_SVC_CHECK;test_host;test_description;1234"));
+
+  ASSERT_EQ(commands::processing::execute_passive_check_results(batch), 3u);
+
+  testing::internal::CaptureStdout();
+  checks::checker::instance().reap();
+  std::string const& out{testing::internal::GetCapturedStdout()};
+
+  ASSERT_NE(out.find("PASSIVE SERVICE CHECK"), std::string::npos);
+  ASSERT_EQ((service::services[{"test_host", "test_description"}]
+                 ->get_plugin_output()),
+            "crit");
+}
+
+/**
+ * Resolved host names are kept from a batch to the next one, until the cache
+ * is invalidated by a configuration reload.
+ */
+TEST_F(ServiceExternalCommand, PassiveCheckHostsCacheKeptUntilReload) {
+  configuration::applier::host hst_aply;
+  configuration::applier::service svc_aply;
+  configuration::applier::command cmd_aply;
+  configuration::Command cmd;
+  configuration::command_helper cmd_hlp(&cmd);
+  cmd.set_command_name("cmd");
+  cmd.set_command_line("/usr/bin/echo 1");
+  cmd_aply.add_object(cmd);
+
+  set_time(20000);
+  time_t now = time(nullptr);
+  std::string cmds = fmt::format(
+      "[{}] PROCESS_SERVICE_CHECK_RESULT;late_host;test_description;1;warn",
+      now);
+  std::vector<std::string_view> batch{cmds};
+  ASSERT_EQ(commands::processing::execute_passive_check_results(batch), 0u);
+
+  configuration::Host hst;
+  configuration::host_helper hst_hlp(&hst);
+  hst.set_host_name("late_host");
+  hst.set_address("127.0.0.4");
+  hst.set_host_id(2);
+  hst.set_check_command("cmd");
+  configuration::Service svc;
+  configuration::service_helper svc_hlp(&svc);
+  svc.set_host_name("late_host");
+  svc.set_service_description("test_description");
+  svc.set_service_id(4);
+  svc.set_check_command("cmd");
+  svc.set_host_id(2);
+  hst_aply.add_object(hst);
+  svc_aply.add_object(svc);
+  hst_aply.expand_objects(pb_config);
+  svc_aply.expand_objects(pb_config);
+  configuration::error_cnt err;
+  hst_aply.resolve_object(hst, err);
+  svc_aply.resolve_object(svc, err);
+
+  /* The host is still unknown for the cache. */
+  ASSERT_EQ(commands::processing::execute_passive_check_results(batch), 0u);
+
+  commands::processing::invalidate_passive_check_cache();
+  ASSERT_EQ(commands::processing::execute_passive_check_results(batch), 1u);
+  checks::checker::instance().reap();
+  ASSERT_EQ((service::services[{"late_host", "test_description"}]
+                 ->get_plugin_output()),
+            "warn");
+}
+
+/**
+ * A host removed while its name is in the cache must not be used anymore,
+ * even if the cache has not been invalidated yet.
+ */
+TEST_F(ServiceExternalCommand, PassiveCheckHostsCacheHostRemoved) {
+  configuration::applier::host hst_aply;
+  configuration::applier::service svc_aply;
+  configuration::applier::command cmd_aply;
+  configuration::Command cmd;
+  configuration::command_helper cmd_hlp(&cmd);
+  cmd.set_command_name("cmd");
+  cmd.set_command_line("/usr/bin/echo 1");
+  cmd_aply.add_object(cmd);
+
+  configuration::Host hst;
+  configuration::host_helper hst_hlp(&hst);
+  hst.set_host_name("gone_host");
+  hst.set_address("127.0.0.5");
+  hst.set_host_id(3);
+  hst.set_check_command("cmd");
+  configuration::Service svc;
+  configuration::service_helper svc_hlp(&svc);
+  svc.set_host_name("gone_host");
+  svc.set_service_description("test_description");
+  svc.set_service_id(5);
+  svc.set_check_command("cmd");
+  svc.set_host_id(3);
+  hst_aply.add_object(hst);
+  svc_aply.add_object(svc);
+  hst_aply.expand_objects(pb_config);
+  svc_aply.expand_objects(pb_config);
+  configuration::error_cnt err;
+  hst_aply.resolve_object(hst, err);
+  svc_aply.resolve_object(svc, err);
+
+  set_time(20000);
+  time_t now = time(nullptr);
+  std::string cmds = fmt::format(
+      "[{}] PROCESS_SERVICE_CHECK_RESULT;127.0.0.5;test_description;1;warn",
+      now);
+  std::vector<std::string_view> batch{cmds};
+  commands::processing::invalidate_passive_check_cache();
+  ASSERT_EQ(commands::processing::execute_passive_check_results(batch), 1u);
+  checks::checker::instance().reap();
+
+  /* The host disappears as during a reload, the cache still knows its name.
+   * The object is kept alive here to restore it at the end of the test. */
+  std::shared_ptr<engine::host> removed = host::hosts["gone_host"];
+  host::hosts.erase("gone_host");
+  host::hosts_by_id.erase(3);
+  ASSERT_EQ(commands::processing::execute_passive_check_results(batch), 0u);
+
+  host::hosts["gone_host"] = removed;
+  host::hosts_by_id[3] = removed;
+  ASSERT_EQ(commands::processing::execute_passive_check_results(batch), 1u);
+  checks::checker::instance().reap();
+}
+
 TEST_F(ServiceExternalCommand, AddServiceComment) {
   configuration::applier::host hst_aply;
   configuration::applier::service svc_aply;
@@ -20,6 +20,7 @@
 #include "helper.hh"
 
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/commands/system_executor.hh"
 #include "com/centreon/engine/configuration/applier/logging.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/globals.hh"
@@ -55,6 +56,7 @@ void init_config_state() {
   configuration::applier::logging::instance().apply(*config);
 
   checks::checker::init(true);
+  commands::system_executor::init();
 }
 #else
 void init_config_state() {
@@ -76,10 +78,12 @@ void init_config_state() {
   configuration::applier::logging::instance().apply(pb_config);
 
   checks::checker::init(true);
+  commands::system_executor::init();
 }
 #endif
 
 void deinit_config_state(void) {
+  commands::system_executor::deinit();
 #ifdef LEGACY_CONF
   delete config;
   config = nullptr;
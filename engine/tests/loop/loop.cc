@@ -26,6 +26,7 @@
 #include "com/centreon/engine/configuration/applier/host.hh"
 #include "com/centreon/engine/configuration/applier/service.hh"
 #include "com/centreon/engine/exceptions/error.hh"
+#include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/serviceescalation.hh"
 #ifdef LEGACY_CONF
 #include "common/engine_legacy_conf/host.hh"
@@ -36,6 +37,7 @@
 using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
+using namespace com::centreon::engine::logging;
 
 class LoopTest : public TestEngine {
  public:
@@ -169,3 +171,44 @@ TEST_F(LoopTest, ScheduledDowntime) {
    * consumed by the loop. */
   ASSERT_NO_THROW(events::loop::instance().run());
 }
+
+/* Disabled logs must not evaluate their arguments. */
+TEST_F(LoopTest, DisabledLogIsLazy) {
+  spdlog::level::level_enum previous = events_logger->level();
+  events_logger->set_level(spdlog::level::info);
+  int evaluated = 0;
+  auto expensive = [&evaluated] {
+    ++evaluated;
+    return std::string("expensive");
+  };
+  ENGINE_LOG_DEBUG(dbg_events, most, events_logger, "{}", expensive());
+  ENGINE_LOGGER_DEBUG(events_logger, "{}", expensive());
+  ASSERT_EQ(evaluated, 0);
+  ENGINE_LOG_INFO(dbg_events, most, events_logger, "{}", expensive());
+  ASSERT_EQ(evaluated, 1);
+  events_logger->set_level(previous);
+}
+
+/* Enabled logs evaluate their arguments once, even when the message goes to
+ * both logging systems. Levels compiled out by SPDLOG_ACTIVE_LEVEL never
+ * evaluate them, whatever the logger level is. */
+TEST_F(LoopTest, EnabledLogIsFormattedOnce) {
+  spdlog::level::level_enum previous = events_logger->level();
+  events_logger->set_level(spdlog::level::trace);
+  int evaluated = 0;
+  auto expensive = [&evaluated] {
+    ++evaluated;
+    return std::string("expensive");
+  };
+  int expected = 0;
+  ENGINE_LOG_DEBUG(dbg_events, most, events_logger, "{}", expensive());
+  if (SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG)
+    ++expected;
+  ASSERT_EQ(evaluated, expected);
+  ENGINE_LOG_TRACE(dbg_events, most, events_logger, "{}", expensive());
+  ENGINE_LOGGER_TRACE(events_logger, "{}", expensive());
+  if (SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE)
+    expected += 2;
+  ASSERT_EQ(evaluated, expected);
+  events_logger->set_level(previous);
+}
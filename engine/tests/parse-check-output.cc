@@ -1,3 +1,4 @@
+#include "com/centreon/engine/check_result.hh"
 #include "com/centreon/engine/utils.hh"
 #include "gtest/gtest.h"
 
@@ -181,4 +182,23 @@ TEST(ParseCheckOutput, CheckDummy) {
   ASSERT_EQ(short_output, "Fake output");
   ASSERT_EQ(long_output, "");
   ASSERT_EQ(perf_data, "v3metric1=1 v3metric2=18;1 v3metric3=12;1;2;0;");
-}
\ No newline at end of file
+}
+
+TEST(ParseCheckOutput, checkResultParseOutput) {
+  com::centreon::engine::check_result cr;
+  cr.set_output(
+      "The service is OK | a=25;50;75 b=1\nToto is a good guy\nBar is well "
+      "known");
+  ASSERT_FALSE(cr.is_output_parsed());
+
+  cr.parse_output();
+  ASSERT_TRUE(cr.is_output_parsed());
+  ASSERT_EQ(cr.get_plugin_output(), "The service is OK");
+  ASSERT_EQ(cr.get_long_plugin_output(),
+            "Toto is a good guy\\nBar is well known");
+  ASSERT_EQ(cr.get_perf_data(), "a=25;50;75 b=1");
+
+  /* A new output invalidates the parsed one. */
+  cr.set_output("The service is CRITICAL");
+  ASSERT_FALSE(cr.is_output_parsed());
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/stats_shm.hh"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include "com/centreon/engine/statistics.hh"
+
+using namespace com::centreon::engine;
+
+static std::string shm_name() {
+  return fmt::format("/centengine_test_stats_{}", getpid());
+}
+
+/**
+ * @brief Fill every published counter with the same value, so a reader can
+ * detect a torn copy.
+ */
+static void fill(shm_stats_data& data, uint64_t value) {
+  memset(&data, 0, sizeof(data));
+  data.last_update = value;
+  data.pid = value;
+  data.next_event_id = value;
+  data.next_notification_id = value;
+  data.hosts.count = value;
+  data.services.count = value;
+  data.services.passive.checks_last_1hour = value;
+}
+
+TEST(StatsShm, ReadBeforePublish) {
+  stats_shm writer;
+  ASSERT_TRUE(writer.create(shm_name()));
+  stats_shm reader;
+  ASSERT_TRUE(reader.open(shm_name()));
+  shm_stats_data data;
+  ASSERT_FALSE(reader.read(data));
+
+  shm_stats_data published;
+  fill(published, 12);
+  writer.publish(published);
+  ASSERT_TRUE(reader.read(data));
+  ASSERT_EQ(data.pid, 12u);
+  ASSERT_EQ(data.services.passive.checks_last_1hour, 12u);
+}
+
+/**
+ * Readers copy the segment while the writer keeps updating it, they must
+ * never get a mix of two publications.
+ */
+TEST(StatsShm, ConcurrentReadersGetConsistentCopies) {
+  stats_shm writer;
+  ASSERT_TRUE(writer.create(shm_name()));
+  shm_stats_data published;
+  fill(published, 1);
+  writer.publish(published);
+
+  std::atomic_bool stop{false};
+  std::atomic<uint32_t> torn{0};
+  std::atomic<uint32_t> reads{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+    readers.emplace_back([&] {
+      stats_shm reader;
+      if (!reader.open(shm_name())) {
+        ++torn;
+        return;
+      }
+      shm_stats_data data;
+      uint64_t last = 0;
+      while (!stop) {
+        if (!reader.read(data))
+          continue;
+        ++reads;
+        uint64_t v = data.last_update;
+        if (data.pid != v || data.next_event_id != v ||
+            data.next_notification_id != v || data.hosts.count != v ||
+            data.services.count != v ||
+            data.services.passive.checks_last_1hour != v || v < last)
+          ++torn;
+        last = v;
+      }
+    });
+
+  for (uint32_t i = 2; i < 200000; ++i) {
+    fill(published, i);
+    writer.publish(published);
+  }
+  stop = true;
+  for (auto& t : readers)
+    t.join();
+  ASSERT_EQ(torn, 0u);
+  ASSERT_GT(reads, 0u);
+}
+
+/**
+ * The segment is unmapped and mapped again by the main loop (reload) while
+ * other threads read it through statistics.
+ */
+TEST(StatsShm, CloseWhileReading) {
+  std::atomic_bool stop{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+    readers.emplace_back([&] {
+      shm_stats_data data;
+      while (!stop)
+        statistics::instance().read_shared_stats(data);
+    });
+
+  for (int i = 0; i < 200; ++i) {
+    statistics::instance().open_shared_stats(shm_name());
+    statistics::instance().close_shared_stats();
+  }
+  stop = true;
+  for (auto& t : readers)
+    t.join();
+  shm_stats_data data;
+  ASSERT_FALSE(statistics::instance().read_shared_stats(data));
+}
@@ -0,0 +1,188 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/xsddefault.hh"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <thread>
+#include "../test_engine.hh"
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/globals.hh"
+#ifdef LEGACY_CONF
+#include "common/engine_legacy_conf/host.hh"
+#include "common/engine_legacy_conf/service.hh"
+#endif
+#include "helper.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+
+static const std::string status_file{"/tmp/xsddefault_test_status.dat"};
+
+class XsddefaultTest : public TestEngine {
+ public:
+  void SetUp() override {
+    error_cnt err;
+    init_config_state();
+#ifdef LEGACY_CONF
+    config->status_file(status_file);
+    config->status_file_incremental(true);
+#else
+    pb_config.set_status_file(status_file);
+    pb_config.set_status_file_incremental(true);
+#endif
+
+    configuration::applier::contact ct_aply;
+#ifdef LEGACY_CONF
+    configuration::contact ctct{new_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(*config);
+#else
+    configuration::Contact ctct{new_pb_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(pb_config);
+#endif
+    ct_aply.resolve_object(ctct, err);
+
+#ifdef LEGACY_CONF
+    configuration::host hst{new_configuration_host("test_host", "admin")};
+    configuration::service svc{
+        new_configuration_service("test_host", "test_svc", "admin")};
+#else
+    configuration::Host hst{new_pb_configuration_host("test_host", "admin")};
+    configuration::Service svc{
+        new_pb_configuration_service("test_host", "test_svc", "admin")};
+#endif
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+    configuration::applier::service svc_aply;
+    svc_aply.add_object(svc);
+    hst_aply.resolve_object(hst, err);
+    svc_aply.resolve_object(svc, err);
+
+    _host = engine::host::hosts.begin()->second;
+    _svc = engine::service::services.begin()->second;
+    ASSERT_EQ(xsddefault_initialize_status_data(), OK);
+  }
+
+  void TearDown() override {
+    xsddefault_cleanup_status_data(1);
+    _host.reset();
+    _svc.reset();
+    deinit_config_state();
+  }
+
+ protected:
+  std::shared_ptr<engine::host> _host;
+  std::shared_ptr<engine::service> _svc;
+
+  /**
+   * @brief Wait for the writer thread to produce the dump created at the
+   * given time and return its content.
+   */
+  static std::string _wait_dump(time_t created) {
+    std::string expected{fmt::format("\tcreated={}\n", created)};
+    for (int i = 0; i < 100; ++i) {
+      std::ifstream ifs(status_file);
+      std::string content{std::istreambuf_iterator<char>(ifs),
+                          std::istreambuf_iterator<char>()};
+      if (content.find(expected) != std::string::npos)
+        return content;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    return {};
+  }
+};
+
+/**
+ * A host is marked as dirty by the setter of a field of its status block, so
+ * its change is visible in the next dump. Objects not changed are copied from
+ * the cache.
+ */
+TEST_F(XsddefaultTest, OnlyDirtyObjectsAreSerialized) {
+  set_time(20000);
+  _host->set_plugin_output("first output");
+  ASSERT_EQ(xsddefault_save_status_data(), OK);
+  std::string content{_wait_dump(20000)};
+  ASSERT_NE(content.find("\tplugin_output=first output\n"), std::string::npos);
+  ASSERT_FALSE(_host->get_status_dirty());
+  ASSERT_FALSE(_svc->get_status_dirty());
+
+  set_time(20010);
+  _host->set_plugin_output("second output");
+  ASSERT_TRUE(_host->get_status_dirty());
+  ASSERT_FALSE(_svc->get_status_dirty());
+  ASSERT_EQ(xsddefault_save_status_data(), OK);
+  content = _wait_dump(20010);
+  ASSERT_NE(content.find("\tplugin_output=second output\n"),
+            std::string::npos);
+
+  set_time(20020);
+  _svc->set_last_notification(20015);
+  ASSERT_TRUE(_svc->get_status_dirty());
+  ASSERT_EQ(xsddefault_save_status_data(), OK);
+  content = _wait_dump(20020);
+  ASSERT_NE(content.find("\tlast_notification=20015\n"), std::string::npos);
+  /* Only the host was refreshed during the previous dump. */
+  ASSERT_NE(content.find("\tstatus_data_refreshed_objects=1,2\n"),
+            std::string::npos);
+}
+
+/**
+ * Objects copied from the cache get the time of the current dump as
+ * last_update.
+ */
+TEST_F(XsddefaultTest, CachedObjectsHaveFreshLastUpdate) {
+  set_time(30000);
+  ASSERT_EQ(xsddefault_save_status_data(), OK);
+  std::string content{_wait_dump(30000)};
+  ASSERT_NE(content.find("\tlast_update=30000\n"), std::string::npos);
+
+  set_time(30060);
+  ASSERT_EQ(xsddefault_save_status_data(), OK);
+  content = _wait_dump(30060);
+  ASSERT_FALSE(content.empty());
+  ASSERT_EQ(content.find("\tlast_update=30000\n"), std::string::npos);
+  size_t count = 0;
+  for (size_t pos = content.find("\tlast_update=30060\n");
+       pos != std::string::npos;
+       pos = content.find("\tlast_update=30060\n", pos + 1))
+    ++count;
+  /* One host and one service */
+  ASSERT_EQ(count, 2u);
+}
+
+/**
+ * The writer thread flushes the pending dump before it is stopped.
+ */
+TEST_F(XsddefaultTest, CleanupWritesPendingDump) {
+  set_time(40000);
+  ASSERT_EQ(xsddefault_save_status_data(), OK);
+  xsddefault_cleanup_status_data(0);
+  std::ifstream ifs(status_file);
+  std::string content{std::istreambuf_iterator<char>(ifs),
+                      std::istreambuf_iterator<char>()};
+  ASSERT_NE(content.find("\tcreated=40000\n"), std::string::npos);
+  ASSERT_NE(content.find("hoststatus {\n"), std::string::npos);
+  ASSERT_NE(content.find("servicestatus {\n"), std::string::npos);
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "sampling_profiler.hh"
+
+using namespace com::centreon::malloc_trace;
+
+/**
+ * @brief cost of malloc and free without profiler
+ */
+static void BM_malloc_free(benchmark::State& state) {
+  const size_t size = state.range(0);
+  for (auto _ : state) {
+    void* p = malloc(size);
+    benchmark::DoNotOptimize(p);
+    free(p);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_malloc_free)->Arg(16)->Arg(256)->Arg(4096);
+
+/**
+ * @brief cost of malloc and free in sampling mode, the profiler calls are the
+ * ones made by our malloc and free hooks
+ */
+static void BM_malloc_free_sampled(benchmark::State& state) {
+  const size_t size = state.range(0);
+  setenv("sampling_interval", "524288", 1);
+  setenv("out_file_path", "/tmp/bench_malloc_trace.folded", 1);
+  static sampling_profiler* profiler = sampling_profiler::create_from_env();
+  for (auto _ : state) {
+    void* p = malloc(size);
+    benchmark::DoNotOptimize(p);
+    profiler->add_malloc(p, size);
+    profiler->free(p);
+    free(p);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_malloc_free_sampled)->Arg(16)->Arg(256)->Arg(4096);
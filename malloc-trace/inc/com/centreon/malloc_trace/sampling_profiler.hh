@@ -0,0 +1,142 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CMT_SAMPLING_PROFILER_HH
+#define CMT_SAMPLING_PROFILER_HH
+
+#include <com/centreon/common/node_allocator.hh>
+
+#include "funct_info_cache.hh"
+
+namespace com::centreon::malloc_trace {
+
+constexpr size_t max_sampled_backtrace_size = 32;
+
+/**
+ * @brief a call site is a backtrace with the statistics of the allocations
+ * sampled from it
+ * A free site is claimed by a compare and swap on _hash, then the claiming
+ * thread writes the backtrace and publishes it by setting _backtrace_size. So
+ * statistics are updated without any lock.
+ */
+class call_site {
+  std::atomic<uint64_t> _hash;
+  std::atomic<size_t> _backtrace_size;
+  boost::stacktrace::frame::native_frame_ptr_t
+      _backtrace[max_sampled_backtrace_size];
+  // estimated bytes allocated and not yet freed
+  std::atomic<int64_t> _live_bytes;
+  // estimated number of allocations
+  std::atomic<uint64_t> _alloc_count;
+
+  friend class sampling_profiler;
+};
+
+/**
+ * @brief a sampled allocation not yet freed
+ * we need it to decrement live bytes of its call site when it's freed
+ */
+class sampled_allocation : public boost::intrusive::set_base_hook<> {
+  const void* _allocated;
+  call_site* _site;
+  int64_t _weight;
+
+ public:
+  sampled_allocation(const void* allocated, call_site* site, int64_t weight)
+      : _allocated(allocated), _site(site), _weight(weight) {}
+
+  call_site* get_site() const { return _site; }
+  int64_t get_weight() const { return _weight; }
+
+  // key extractor used to create a map addr to sampled_allocation
+  struct address_extractor {
+    using type = const void*;
+    type operator()(const sampled_allocation& node) const {
+      return node._allocated;
+    }
+  };
+};
+
+/**
+ * @brief low overhead alternative to orphan_container
+ * Allocations are sampled with a poisson process: each thread counts down
+ * bytes allocated and an allocation is sampled when the counter goes under
+ * zero, the counter is then reset to a random value with an exponential
+ * distribution of mean _sampling_interval. So a malloc that is not sampled
+ * only costs a thread local decrement.
+ * Each sample is weighted in order to give an unbiased estimation of live
+ * bytes and allocation count of its call site.
+ * A free only costs an atomic read in a counting filter unless the address may
+ * be a sampled one.
+ * Every flush period, live bytes and allocation counts by call site are
+ * written in folded stack format, usable by flamegraph.pl.
+ */
+class sampling_profiler {
+  static constexpr size_t _call_site_table_size = 0x4000;
+  static constexpr size_t _address_filter_size = 0x40000;
+
+  const uint64_t _sampling_interval;
+
+  call_site _sites[_call_site_table_size];
+  // samples lost because _sites is full
+  std::atomic<uint64_t> _nb_lost_samples;
+
+  // counting filter of sampled addresses, a free of an address whose counter is
+  // null doesn't need to lock _protect
+  std::atomic<uint32_t> _address_filter[_address_filter_size];
+
+  using sampled_allocation_set = boost::intrusive::set<
+      sampled_allocation,
+      boost::intrusive::key_of_value<sampled_allocation::address_extractor>>;
+
+  using sampled_allocation_allocator = com::centreon::common::
+      node_allocator<sampled_allocation, std::allocator<uint8_t>, 0x10000>;
+
+  sampled_allocation_set _sampled;
+  sampled_allocation_allocator _sampled_allocator;
+  std::mutex _protect;
+
+  funct_cache_map _funct_info_cache;
+  std::chrono::system_clock::duration _flush_period;
+  std::atomic<int64_t> _next_flush;
+  std::string_view _out_file_path;
+  std::mutex _flush_protect;
+
+  sampling_profiler(uint64_t sampling_interval);
+
+  void _sample(const void* addr, size_t size);
+  call_site* _get_site(uint64_t hash,
+                       const boost::stacktrace::frame::native_frame_ptr_t* bt,
+                       size_t bt_size);
+  static size_t _filter_index(const void* addr);
+  void _flush_to_file();
+  bool _write_folded(const std::string& path, bool live_bytes);
+
+ public:
+  static sampling_profiler* create_from_env();
+
+  void add_malloc(const void* addr, size_t size);
+  void free(const void* addr);
+
+  int64_t live_bytes() const;
+  uint64_t alloc_count() const;
+};
+
+}  // namespace com::centreon::malloc_trace
+
+#endif
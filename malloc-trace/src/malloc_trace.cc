@@ -22,6 +22,7 @@
 #include "by_thread_trace_active.hh"
 #include "funct_info_cache.hh"
 #include "orphan_container.hh"
+#include "sampling_profiler.hh"
 #include "simply_allocator.hh"
 
 using namespace com::centreon::malloc_trace;
@@ -60,10 +61,18 @@ static thread_dump_active _thread_dump_active;
 static simply_allocator _first_malloc;
 
 /**
- * @brief the container that store every malloc and free
+ * @brief sampling mode, not null if sampling_interval environment variable is
+ * set
  *
  */
-static orphan_container* _orphans = new orphan_container;
+static sampling_profiler* _sampler = sampling_profiler::create_from_env();
+
+/**
+ * @brief the container that store every malloc and free, not used in sampling
+ * mode
+ *
+ */
+static orphan_container* _orphans = _sampler ? nullptr : new orphan_container;
 
 static void* first_malloc(size_t size) {
   return _first_malloc.malloc(size);
@@ -133,6 +142,11 @@ static void* malloc(size_t size, const char* funct_name) {
 
   void* p = original_malloc(size);
 
+  if (_sampler) {
+    _sampler->add_malloc(p, size);
+    return p;
+  }
+
   pid_t thread_id = m_gettid();
   bool have_to_dump = _thread_dump_active.set_dump_active(thread_id);
 
@@ -167,14 +181,29 @@ void* realloc(void* p, size_t size) {
     default:
       break;
   }
+  if (_sampler) {
+    void* new_p = original_realloc(p, size);
+    // on failure, p is still allocated and must stay sampled, so it is
+    // unregistered after the real realloc (realloc(p, 0) frees p and may
+    // return nullptr). If p has been moved, another thread may get it and
+    // sample it before this free, it only costs a misattributed sample.
+    if (new_p || !size) {
+      _sampler->free(p);
+      _sampler->add_malloc(new_p, size);
+    }
+    return new_p;
+  }
   void* new_p = original_realloc(p, size);
   pid_t thread_id = m_gettid();
   bool have_to_dump = _thread_dump_active.set_dump_active(thread_id);
   // if this thread is not yet dumping => call dump_callstack
-  if (have_to_dump) {
+  // _orphans is null during static initialization
+  if (have_to_dump && !_orphans) {
+    _thread_dump_active.reset_dump_active(thread_id);
+  } else if (have_to_dump) {
     constexpr std::string_view realloc_funct_name("realloc");
     // if pointer has changed, we record a free
-    if (new_p != p && p) {
+    if (new_p && new_p != p && p) {
       if (!_orphans->free(p)) {
         constexpr std::string_view free_funct_name("freerealloc");
         _orphans->add_free(p, thread_id, free_funct_name,
@@ -222,6 +251,12 @@ void* calloc(size_t num, size_t size) {
 void free(void* p) {
   if (_first_malloc.free(p))
     return;
+  if (_sampler) {
+    // address must be unregistered before being reused by another malloc
+    _sampler->free(p);
+    original_free(p);
+    return;
+  }
   original_free(p);
   if (!p)
     return;
@@ -230,7 +265,10 @@ void free(void* p) {
   bool have_to_dump = _thread_dump_active.set_dump_active(thread_id);
 
   // if this thread is not yet dumping => call dump_callstack
-  if (have_to_dump) {
+  // _orphans is null during static initialization
+  if (have_to_dump && !_orphans) {
+    _thread_dump_active.reset_dump_active(thread_id);
+  } else if (have_to_dump) {
     if (!_orphans->free(p)) {
       constexpr std::string_view free_funct_name("free");
       _orphans->add_free(p, thread_id, free_funct_name,
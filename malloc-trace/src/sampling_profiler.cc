@@ -0,0 +1,421 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <fmt/format.h>
+#include <boost/stacktrace.hpp>
+#include <cmath>
+
+#include "sampling_profiler.hh"
+
+using namespace com::centreon::malloc_trace;
+
+/**
+ * @brief thread local states
+ * initial-exec model avoids __tls_get_addr that may itself allocate
+ * all are zero initialized so no thread_local init function is called
+ */
+// bytes to allocate before next sample
+static thread_local int64_t _bytes_before_sample
+    __attribute__((tls_model("initial-exec")));
+// xorshift state used to draw next sample interval, 0 until first malloc
+static thread_local uint64_t _random_state
+    __attribute__((tls_model("initial-exec")));
+// true when this thread is sampling, allocations done by sampling are ignored
+static thread_local bool _sampling_active
+    __attribute__((tls_model("initial-exec")));
+
+/**
+ * @brief draw the number of bytes before next sample
+ * interval between two samples follows an exponential distribution in order
+ * to get a poisson process
+ *
+ * @param mean
+ * @return int64_t
+ */
+static int64_t next_sample_interval(uint64_t mean) {
+  if (!_random_state) {
+    _random_state = reinterpret_cast<uintptr_t>(&_random_state) ^
+                    std::chrono::steady_clock::now().time_since_epoch().count();
+    if (!_random_state) {
+      _random_state = 1;
+    }
+  }
+  _random_state ^= _random_state << 13;
+  _random_state ^= _random_state >> 7;
+  _random_state ^= _random_state << 17;
+  // uniform in ]0, 1]
+  double uniform = ((_random_state >> 11) + 1) * 0x1.0p-53;
+  return static_cast<int64_t>(-std::log(uniform) * mean) + 1;
+}
+
+/**
+ * @brief Construct a new sampling profiler::sampling profiler object
+ * flush period and output file are read from the same environment variables
+ * as orphan_container
+ *
+ * @param sampling_interval mean number of bytes allocated between two samples
+ */
+sampling_profiler::sampling_profiler(uint64_t sampling_interval)
+    : _sampling_interval(sampling_interval),
+      _nb_lost_samples(0),
+      _sampled_allocator(std::allocator<uint8_t>()) {
+  for (call_site& site : _sites) {
+    site._hash = 0;
+    site._backtrace_size = 0;
+    site._live_bytes = 0;
+    site._alloc_count = 0;
+  }
+  for (std::atomic<uint32_t>& counter : _address_filter) {
+    counter = 0;
+  }
+
+  char* env_out_file_path = getenv("out_file_path");
+  if (env_out_file_path && strlen(env_out_file_path) > 0)
+    _out_file_path = env_out_file_path;
+  else
+    _out_file_path = "/tmp/malloc-trace.folded";
+
+  char* malloc_second_peremption = getenv("malloc_second_peremption");
+  if (malloc_second_peremption && atoi(malloc_second_peremption) > 0)
+    _flush_period = std::chrono::seconds(atoi(malloc_second_peremption));
+  else
+    _flush_period = std::chrono::minutes(1);
+
+  _next_flush = (std::chrono::system_clock::now() + _flush_period)
+                    .time_since_epoch()
+                    .count();
+}
+
+/**
+ * @brief create a sampling_profiler if sampling_interval environment variable
+ * is set
+ *
+ * @return sampling_profiler* nullptr if sampling is not enabled
+ */
+sampling_profiler* sampling_profiler::create_from_env() {
+  char* env_sampling_interval = getenv("sampling_interval");
+  if (env_sampling_interval && atoll(env_sampling_interval) > 0) {
+    return new sampling_profiler(atoll(env_sampling_interval));
+  }
+  return nullptr;
+}
+
+/**
+ * @brief called on each malloc, it only decrements a thread local counter
+ * unless the allocation has to be sampled
+ *
+ * @param addr address allocated
+ * @param size size allocated
+ */
+void sampling_profiler::add_malloc(const void* addr, size_t size) {
+  if (!addr) {
+    return;
+  }
+  _bytes_before_sample -= size;
+  if (_bytes_before_sample > 0) {
+    return;
+  }
+  if (_sampling_active) {
+    // allocation done by the sampling itself
+    _bytes_before_sample = next_sample_interval(_sampling_interval);
+    return;
+  }
+  // first allocation of this thread, counter was not initialized
+  bool first = !_random_state;
+  _bytes_before_sample = next_sample_interval(_sampling_interval);
+  if (first) {
+    return;
+  }
+  _sampling_active = true;
+  _sample(addr, size);
+  _sampling_active = false;
+}
+
+/**
+ * @brief record a sampled allocation
+ * the sample is weighted by the inverse of its probability to be sampled
+ *
+ * @param addr
+ * @param size
+ */
+void sampling_profiler::_sample(const void* addr, size_t size) {
+  // safe_dump_to adds a null frame at the end
+  boost::stacktrace::frame::native_frame_ptr_t
+      backtrace[max_sampled_backtrace_size + 1];
+  // we ignore _sample, add_malloc and our malloc frames
+  size_t bt_size =
+      boost::stacktrace::safe_dump_to(3, backtrace, sizeof(backtrace));
+  if (bt_size) {
+    --bt_size;
+  }
+
+  // fnv-1a of frame addresses
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t frame_index = 0; frame_index < bt_size; ++frame_index) {
+    hash ^= reinterpret_cast<uintptr_t>(backtrace[frame_index]);
+    hash *= 0x100000001b3ULL;
+  }
+  if (!hash) {
+    hash = 1;
+  }
+
+  call_site* site = _get_site(hash, backtrace, bt_size);
+  if (!site) {
+    _nb_lost_samples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  double probability = 1.0 - std::exp(-static_cast<double>(size) /
+                                      static_cast<double>(_sampling_interval));
+  int64_t weight = std::llround(size / probability);
+  uint64_t count = std::max<int64_t>(std::llround(1.0 / probability), 1);
+  site->_live_bytes.fetch_add(weight, std::memory_order_relaxed);
+  site->_alloc_count.fetch_add(count, std::memory_order_relaxed);
+
+  {
+    std::lock_guard l(_protect);
+    sampled_allocation* new_node = _sampled_allocator.allocate();
+    new (new_node) sampled_allocation(addr, site, weight);
+    if (!_sampled.insert(*new_node).second) {
+      _sampled_allocator.deallocate(new_node);
+    } else {
+      _address_filter[_filter_index(addr)].fetch_add(1,
+                                                     std::memory_order_relaxed);
+    }
+  }
+
+  if (std::chrono::system_clock::now().time_since_epoch().count() >=
+      _next_flush.load(std::memory_order_relaxed)) {
+    _flush_to_file();
+  }
+}
+
+/**
+ * @brief find or create the call site of a backtrace
+ * open addressing, linear probing and no deletion, so it's lock free
+ *
+ * @param hash backtrace hash
+ * @param bt backtrace
+ * @param bt_size
+ * @return call_site* nullptr if table is full
+ */
+call_site* sampling_profiler::_get_site(
+    uint64_t hash,
+    const boost::stacktrace::frame::native_frame_ptr_t* bt,
+    size_t bt_size) {
+  for (size_t probe = 0; probe < _call_site_table_size; ++probe) {
+    call_site& site = _sites[(hash + probe) & (_call_site_table_size - 1)];
+    uint64_t site_hash = site._hash.load(std::memory_order_acquire);
+    if (site_hash == hash) {
+      return &site;
+    }
+    if (!site_hash) {
+      uint64_t expected = 0;
+      if (site._hash.compare_exchange_strong(expected, hash,
+                                             std::memory_order_acq_rel)) {
+        std::copy(bt, bt + bt_size, site._backtrace);
+        // backtrace is published, it may be read by _flush_to_file
+        site._backtrace_size.store(bt_size ? bt_size : 1,
+                                   std::memory_order_release);
+        return &site;
+      }
+      // another thread has claimed this slot
+      if (expected == hash) {
+        return &site;
+      }
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief index in _address_filter
+ *
+ * @param addr
+ * @return size_t
+ */
+size_t sampling_profiler::_filter_index(const void* addr) {
+  uint64_t key = reinterpret_cast<uintptr_t>(addr);
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return key & (_address_filter_size - 1);
+}
+
+/**
+ * @brief called on each free, if address has been sampled, live bytes of its
+ * call site are decremented
+ * It must be called before the real free because once freed, the address can
+ * be allocated and sampled again by another thread
+ *
+ * @param addr
+ */
+void sampling_profiler::free(const void* addr) {
+  if (!addr) {
+    return;
+  }
+  std::atomic<uint32_t>& filter_counter =
+      _address_filter[_filter_index(addr)];
+  if (!filter_counter.load(std::memory_order_relaxed)) {
+    return;
+  }
+  sampled_allocation* to_erase = nullptr;
+  {
+    std::lock_guard l(_protect);
+    auto found = _sampled.find(addr);
+    if (found == _sampled.end()) {
+      return;
+    }
+    to_erase = &*found;
+    _sampled.erase(found);
+    filter_counter.fetch_sub(1, std::memory_order_relaxed);
+    to_erase->get_site()->_live_bytes.fetch_sub(to_erase->get_weight(),
+                                                std::memory_order_relaxed);
+    _sampled_allocator.deallocate(to_erase);
+  }
+}
+
+/**
+ * @brief estimated bytes allocated and not yet freed, all call sites included
+ *
+ * @return int64_t
+ */
+int64_t sampling_profiler::live_bytes() const {
+  int64_t ret = 0;
+  for (const call_site& site : _sites) {
+    ret += site._live_bytes.load(std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+/**
+ * @brief estimated number of allocations, all call sites included
+ *
+ * @return uint64_t
+ */
+uint64_t sampling_profiler::alloc_count() const {
+  uint64_t ret = 0;
+  for (const call_site& site : _sites) {
+    ret += site._alloc_count.load(std::memory_order_relaxed);
+  }
+  return ret;
+}
+
+/**
+ * @brief write live bytes and allocation count files
+ * only one thread flushes, others go on
+ *
+ */
+void sampling_profiler::_flush_to_file() {
+  std::unique_lock l(_flush_protect, std::try_to_lock);
+  if (!l.owns_lock()) {
+    return;
+  }
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  if (now.time_since_epoch().count() < _next_flush.load()) {
+    return;
+  }
+  _next_flush = (now + _flush_period).time_since_epoch().count();
+
+  std::string path(_out_file_path);
+  _write_folded(path, true);
+  _write_folded(path + ".alloc_count", false);
+}
+
+/**
+ * @brief write a folded stack file: one line by call site
+ * frame1;frame2;...;leaf_frame value
+ * file is written in a temporary file then renamed in order to always have a
+ * complete snapshot
+ *
+ * @param path
+ * @param live_bytes if true value is live bytes, otherwise allocation count
+ * @return true file written
+ */
+bool sampling_profiler::_write_folded(const std::string& path,
+                                      bool live_bytes) {
+  std::string tmp_path = path + ".tmp";
+  int fd = open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY,
+                S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return false;
+  }
+
+  constexpr unsigned size_buff = 0x10000;
+  char buff[size_buff];
+  char* end_buff = buff + size_buff;
+
+  for (const call_site& site : _sites) {
+    size_t bt_size = site._backtrace_size.load(std::memory_order_acquire);
+    if (!bt_size) {
+      continue;
+    }
+    int64_t value = live_bytes
+                        ? site._live_bytes.load(std::memory_order_relaxed)
+                        : site._alloc_count.load(std::memory_order_relaxed);
+    if (value <= 0) {
+      continue;
+    }
+    char* work_pos = buff;
+    // folded stacks begin with the outermost frame
+    for (size_t frame_index = bt_size; frame_index-- > 0;) {
+      const boost::stacktrace::frame::native_frame_ptr_t addr =
+          site._backtrace[frame_index];
+      if (end_buff - work_pos < 1000) {
+        break;
+      }
+      funct_cache_map::const_iterator cache_entry =
+          _funct_info_cache.find(addr);
+      if (cache_entry == _funct_info_cache.end()) {
+        boost::stacktrace::frame frame(addr);
+        funct_info to_insert(frame.name(), frame.source_file(),
+                             frame.source_line());
+        cache_entry = _funct_info_cache.emplace(addr, to_insert).first;
+      }
+      char* name_begin = work_pos;
+      if (cache_entry->second.get_funct_name().empty()) {
+        work_pos = fmt::format_to_n(work_pos, end_buff - work_pos - 100,
+                                    "{}", addr)
+                       .out;
+      } else {
+        work_pos = fmt::format_to_n(work_pos, end_buff - work_pos - 100, "{}",
+                                    cache_entry->second.get_funct_name())
+                       .out;
+      }
+      // ; is the frame separator
+      std::replace(name_begin, work_pos, ';', ':');
+      *work_pos++ = ';';
+    }
+    if (work_pos == buff) {
+      continue;
+    }
+    work_pos = fmt::format_to_n(work_pos - 1, end_buff - work_pos, " {}\n",
+                                value)
+                   .out;
+    ::write(fd, buff, work_pos - buff);
+  }
+
+  uint64_t nb_lost = _nb_lost_samples.load();
+  if (nb_lost && live_bytes) {
+    char* work_pos =
+        fmt::format_to_n(buff, size_buff, "[lost_samples] {}\n", nb_lost).out;
+    ::write(fd, buff, work_pos - buff);
+  }
+  ::close(fd);
+  return !rename(tmp_path.c_str(), path.c_str());
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "sampling_profiler.hh"
+
+using namespace com::centreon::malloc_trace;
+
+/**
+ * @brief the profiler never reads the allocated memory, so allocations are
+ * simulated with fake addresses
+ */
+static const void* fake_address(uint64_t index) {
+  return reinterpret_cast<const void*>(0x100000000ULL + index * 0x10);
+}
+
+class SamplingProfiler : public ::testing::Test {
+ protected:
+  std::unique_ptr<sampling_profiler> _profiler;
+
+  void SetUp() override {
+    setenv("sampling_interval", "65536", 1);
+    setenv("out_file_path", "/tmp/ut_malloc_trace.folded", 1);
+    _profiler.reset(sampling_profiler::create_from_env());
+    // the first allocation of a thread only initializes its sampling counter,
+    // it is freed in case the counter was already initialized by another test
+    _profiler->add_malloc(reinterpret_cast<const void*>(0x10), 1);
+    _profiler->free(reinterpret_cast<const void*>(0x10));
+  }
+
+  void TearDown() override {
+    _profiler.reset();
+    unsetenv("sampling_interval");
+    unsetenv("out_file_path");
+  }
+};
+
+TEST_F(SamplingProfiler, NotEnabled) {
+  unsetenv("sampling_interval");
+  ASSERT_EQ(sampling_profiler::create_from_env(), nullptr);
+}
+
+// 200000 allocations of 1000 bytes give about 3000 samples, the estimation
+// of live bytes is expected within a few percents of the real value
+TEST_F(SamplingProfiler, SmallAllocationsEstimate) {
+  constexpr uint64_t nb_alloc = 200000;
+  constexpr int64_t alloc_size = 1000;
+  for (uint64_t index = 0; index < nb_alloc; ++index) {
+    _profiler->add_malloc(fake_address(index), alloc_size);
+  }
+  ASSERT_NEAR(_profiler->live_bytes(), nb_alloc * alloc_size,
+              nb_alloc * alloc_size / 10);
+  ASSERT_NEAR(_profiler->alloc_count(), nb_alloc, nb_alloc / 10);
+
+  // half is freed
+  for (uint64_t index = 0; index < nb_alloc; index += 2) {
+    _profiler->free(fake_address(index));
+  }
+  ASSERT_NEAR(_profiler->live_bytes(), nb_alloc * alloc_size / 2,
+              nb_alloc * alloc_size / 10);
+
+  // the weight of each freed sample is removed, nothing remains
+  for (uint64_t index = 1; index < nb_alloc; index += 2) {
+    _profiler->free(fake_address(index));
+  }
+  ASSERT_EQ(_profiler->live_bytes(), 0);
+}
+
+// an allocation far bigger than the sampling interval is always sampled with
+// a weight equal to its size
+TEST_F(SamplingProfiler, LargeAllocationsExact) {
+  constexpr uint64_t nb_alloc = 100;
+  constexpr int64_t alloc_size = 0x1000000;
+  for (uint64_t index = 0; index < nb_alloc; ++index) {
+    _profiler->add_malloc(fake_address(index), alloc_size);
+  }
+  ASSERT_EQ(_profiler->live_bytes(),
+            static_cast<int64_t>(nb_alloc) * alloc_size);
+  ASSERT_EQ(_profiler->alloc_count(), nb_alloc);
+
+  for (uint64_t index = 0; index < nb_alloc; ++index) {
+    _profiler->free(fake_address(index));
+  }
+  ASSERT_EQ(_profiler->live_bytes(), 0);
+}
+
+// a free of an address never sampled changes nothing
+TEST_F(SamplingProfiler, FreeNotSampled) {
+  constexpr int64_t alloc_size = 0x1000000;
+  _profiler->add_malloc(fake_address(0), alloc_size);
+  _profiler->free(fake_address(1));
+  _profiler->free(nullptr);
+  ASSERT_EQ(_profiler->live_bytes(), alloc_size);
+  _profiler->free(fake_address(0));
+  ASSERT_EQ(_profiler->live_bytes(), 0);
+}